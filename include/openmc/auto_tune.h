@@ -0,0 +1,29 @@
+//! \file auto_tune.h
+//! \brief Tuning of performance settings during inactive batches
+
+#ifndef OPENMC_AUTO_TUNE_H
+#define OPENMC_AUTO_TUNE_H
+
+namespace openmc {
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Plan the trial configurations of the performance settings that are tuned.
+//! Each inactive batch after the first runs with one trial configuration,
+//! first of the number of logarithmic grid bins and then, in event-based mode,
+//! of the maximum number of particles in flight. The configuration with the
+//! highest transport rate is kept.
+void init_auto_tune();
+
+//! Apply the configuration to be tried in the current batch
+void auto_tune_initialize_batch();
+
+//! Measure the transport rate of the current batch and lock in the best
+//! configuration once all trials are done
+void auto_tune_finalize_batch();
+
+} // namespace openmc
+
+#endif // OPENMC_AUTO_TUNE_H
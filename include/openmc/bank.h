@@ -1,6 +1,7 @@
 #ifndef OPENMC_BANK_H
 #define OPENMC_BANK_H
 
+#include <cstddef> // for size_t
 #include <cstdint>
 
 #include "openmc/particle.h"
@@ -10,6 +11,18 @@
 
 namespace openmc {
 
+//==============================================================================
+// Constants
+//==============================================================================
+
+// Number of surface source sites each thread collects before writing them to a
+// streamed surface source file
+constexpr std::size_t SURF_SOURCE_BUFFER_SIZE {10000};
+
+// Number of overflow chunks, each as large as its initial capacity, that the
+// fission bank may grow into when more sites are produced than expected
+constexpr int FISSION_BANK_MAX_CHUNKS {16};
+
 //==============================================================================
 // Global variables
 //==============================================================================
@@ -20,6 +33,10 @@ extern vector<SourceSite> source_bank;
 
 extern SharedArray<SourceSite> surf_source_bank;
 
+//! Surface source sites banked by each thread that haven't been written to the
+//! streamed surface source file yet
+extern vector<vector<SourceSite>> surf_source_buffers;
+
 extern SharedArray<SourceSite> fission_bank;
 
 extern vector<int64_t> progeny_per_particle;
@@ -36,6 +53,12 @@ void free_memory_bank();
 
 void init_fission_bank(int64_t max);
 
+//! Add a site to the calling thread's surface source buffer, writing the
+//! buffer to the streamed surface source file when it is full
+//
+//! \param[in] site Surface crossing to record
+void bank_surf_source_site(const SourceSite& site);
+
 } // namespace openmc
 
 #endif // OPENMC_BANK_H
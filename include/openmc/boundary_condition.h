@@ -1,6 +1,7 @@
 #ifndef OPENMC_BOUNDARY_CONDITION_H
 #define OPENMC_BOUNDARY_CONDITION_H
 
+#include "openmc/neighbor_list.h"
 #include "openmc/position.h"
 
 namespace openmc {
@@ -69,9 +70,20 @@ public:
 
   std::string type() const override { return "periodic"; }
 
+  //! Find the root universe cells that reference either surface, which are
+  //! the cells particles arrive in after crossing the other surface. This has
+  //! to be called once the cells have been read.
+  void find_partner_cells();
+
 protected:
   int i_surf_;
   int j_surf_;
+
+  //! Cells next to the first and second surfaces. Cells found by a full
+  //! search are added during transport if a surface is shared with cells that
+  //! don't reference it.
+  mutable NeighborList i_cells_;
+  mutable NeighborList j_cells_;
 };
 
 //==============================================================================
@@ -14,9 +14,17 @@ namespace openmc {
 class BremsstrahlungData {
 public:
   // Data
-  xt::xtensor<double, 2> pdf;   //!< Bremsstrahlung energy PDF
-  xt::xtensor<double, 2> cdf;   //!< Bremsstrahlung energy CDF
-  xt::xtensor<double, 1> yield; //!< Photon yield
+  xt::xtensor<double, 2> pdf;      //!< Bremsstrahlung energy PDF
+  xt::xtensor<double, 2> cdf;      //!< Bremsstrahlung energy CDF
+  xt::xtensor<double, 2> exponent; //!< Power law exponent of the CDF on each
+                                   //!< photon energy interval
+  xt::xtensor<int, 2> guide;       //!< Guide tables for searching CDF rows
+  xt::xtensor<double, 1> yield;    //!< Photon yield
+
+  // Condensed history data
+  xt::xtensor<double, 1> range; //!< Continuous slowing down range in [cm]
+  xt::xtensor<double, 2> dcs;   //!< Scaled DCS relative to its maximum at
+                                //!< each incident energy
 };
 
 class Bremsstrahlung {
@@ -24,6 +32,7 @@ public:
   // Data
   BremsstrahlungData electron;
   BremsstrahlungData positron;
+  double radiation_length; //!< Radiation length in [cm] for condensed history
 };
 
 //==============================================================================
@@ -9,6 +9,14 @@
 extern "C" {
 #endif
 
+//! Function that receives the streamed tally results after each batch. It is
+//! given the batch, the number of tallies, the ID and number of bins of each
+//! tally, the number of realizations of each tally, the mean and variance of
+//! the mean of each bin of every tally, and the user data it was set with.
+typedef void (*openmc_tally_stream_callback)(int32_t batch, int32_t n_tallies,
+  const int32_t* ids, const int64_t* sizes, const int32_t* n_realizations,
+  const double* mean, const double* variance, void* data);
+
 int openmc_calculate_volumes();
 int openmc_cell_filter_get_bins(
   int32_t index, const int32_t** cells, int32_t* n);
@@ -29,6 +37,15 @@ int openmc_cell_set_temperature(
   int32_t index, double T, const int32_t* instance, bool set_contained = false);
 int openmc_cell_set_translation(int32_t index, const double xyz[]);
 int openmc_cell_set_rotation(int32_t index, const double rot[], size_t rot_len);
+int openmc_cells_set_rotations(
+  int n, const int32_t* index, const double* rot, size_t rot_len);
+int openmc_cells_set_temperatures(
+  int n, const int32_t* index, const int32_t* instance, const double* T);
+int openmc_cells_set_translations(
+  int n, const int32_t* index, const double* xyz);
+int openmc_collapse_rates(int n_spectra, const double* temperatures,
+  const double* energy, const double* flux, int n_groups, int n_nuclides,
+  const int* nuclides, int n_reactions, const int* MTs, double* rates);
 int openmc_energy_filter_get_bins(
   int32_t index, const double** energies, size_t* n);
 int openmc_energy_filter_set_bins(
@@ -53,6 +70,14 @@ int openmc_find_cell(const double* xyz, int32_t* index, int32_t* instance);
 int openmc_cell_bounding_box(const int32_t index, double* llc, double* urc);
 int openmc_global_bounding_box(double* llc, double* urc);
 int openmc_fission_bank(void** ptr, int64_t* n);
+int openmc_flux_spectrum_collapse_rates(const double* temperatures,
+  int n_nuclides, const int* nuclides, int n_reactions, const int* MTs,
+  double* rates);
+int openmc_flux_spectrum_get_energy(
+  const double** energy, int* n_groups, int* n_materials);
+int openmc_flux_spectrum_get_flux(int index, double* flux);
+int openmc_flux_spectrum_set(int n_materials, const int32_t* materials,
+  int n_groups, double E_min, double E_max, bool sparse);
 int openmc_get_cell_index(int32_t id, int32_t* index);
 int openmc_get_filter_index(int32_t id, int32_t* index);
 void openmc_get_filter_next_id(int32_t* id);
@@ -61,6 +86,7 @@ int openmc_get_material_index(int32_t id, int32_t* index);
 int openmc_get_mesh_index(int32_t id, int32_t* index);
 int openmc_get_n_batches(int* n_batches, bool get_max_batches);
 int openmc_get_nuclide_index(const char name[], int* index);
+int openmc_get_performance_counters(int64_t counts[], double* time);
 int openmc_add_unstructured_mesh(
   const char filename[], const char library[], int* id);
 int64_t openmc_get_seed();
@@ -73,6 +99,7 @@ bool openmc_is_statepoint_batch();
 int openmc_legendre_filter_get_order(int32_t index, int* order);
 int openmc_legendre_filter_set_order(int32_t index, int order);
 int openmc_load_nuclide(const char* name, const double* temps, int n);
+int openmc_majorant_xs(int32_t id, double E, double* xs);
 int openmc_material_add_nuclide(
   int32_t index, const char name[], double density);
 int openmc_material_get_densities(
@@ -93,6 +120,10 @@ int openmc_material_filter_get_bins(
   int32_t index, const int32_t** bins, size_t* n);
 int openmc_material_filter_set_bins(
   int32_t index, size_t n, const int32_t* bins);
+int openmc_materials_set_densities(int n_materials, const int32_t* index,
+  int n_nuclides, const int* nuclides, const double* densities);
+int openmc_memory_usage(
+  int64_t current_bytes[], int64_t peak_bytes[], int64_t* resident);
 int openmc_mesh_filter_get_mesh(int32_t index, int32_t* index_mesh);
 int openmc_mesh_filter_set_mesh(int32_t index, int32_t index_mesh);
 int openmc_mesh_filter_get_translation(int32_t index, double translation[3]);
@@ -103,6 +134,7 @@ int openmc_meshsurface_filter_get_mesh(int32_t index, int32_t* index_mesh);
 int openmc_meshsurface_filter_set_mesh(int32_t index, int32_t index_mesh);
 int openmc_new_filter(const char* type, int32_t* index);
 int openmc_next_batch(int* status);
+int openmc_nuclide_memory_usage(int index, int64_t* bytes);
 int openmc_nuclide_name(int index, const char** name);
 int openmc_plot_geometry();
 int openmc_id_map(const void* slice, int32_t* data_out);
@@ -121,6 +153,7 @@ int openmc_regular_mesh_set_params(int32_t index, int n, const double* ll,
 int openmc_reset();
 int openmc_reset_timers();
 int openmc_run();
+int openmc_run_random_ray();
 int openmc_sample_external_source(size_t n, uint64_t* seed, void* sites);
 void openmc_set_seed(int64_t new_seed);
 int openmc_set_n_batches(
@@ -149,8 +182,12 @@ int openmc_tally_get_nuclides(int32_t index, int** nuclides, int* n);
 int openmc_tally_get_scores(int32_t index, int** scores, int* n);
 int openmc_tally_get_type(int32_t index, int32_t* type);
 int openmc_tally_get_writable(int32_t index, bool* writable);
+int openmc_tally_mean_std_dev(
+  int32_t index, int i_nuclide, int i_score, double* mean, double* std_dev);
 int openmc_tally_reset(int32_t index);
 int openmc_tally_results(int32_t index, double** ptr, size_t shape_[3]);
+int openmc_tally_results_slice(int32_t index, int i_nuclide, int i_score,
+  double** ptr, size_t shape_[2], size_t strides[2]);
 int openmc_tally_set_active(int32_t index, bool active);
 int openmc_tally_set_estimator(int32_t index, const char* estimator);
 int openmc_tally_set_filters(int32_t index, size_t n, const int32_t* indices);
@@ -159,6 +196,8 @@ int openmc_tally_set_nuclides(int32_t index, int n, const char** nuclides);
 int openmc_tally_set_scores(int32_t index, int n, const char** scores);
 int openmc_tally_set_type(int32_t index, const char* type);
 int openmc_tally_set_writable(int32_t index, bool writable);
+int openmc_tally_stream_set_callback(
+  openmc_tally_stream_callback callback, void* data);
 int openmc_zernike_filter_get_order(int32_t index, int* order);
 int openmc_zernike_filter_get_params(
   int32_t index, double* x, double* y, double* r);
@@ -190,7 +229,7 @@ void openmc_cmfd_reweight(const bool feedback, const double* cmfd_src);
 //! solver
 void openmc_initialize_linsolver(const int* indptr, int len_indptr,
   const int* indices, int n_elements, int dim, double spectral, const int* map,
-  bool use_all_threads);
+  bool use_all_threads, int linsolver);
 
 //! Runs a Gauss Seidel linear solver to solve CMFD matrix equations
 //! linear solver
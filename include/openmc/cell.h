@@ -35,6 +35,14 @@ constexpr int32_t OP_COMPLEMENT {std::numeric_limits<int32_t>::max() - 2};
 constexpr int32_t OP_INTERSECTION {std::numeric_limits<int32_t>::max() - 3};
 constexpr int32_t OP_UNION {std::numeric_limits<int32_t>::max() - 4};
 
+// Results of evaluating a compiled region, which are used as jump targets
+constexpr int32_t REGION_INSIDE {-1};
+constexpr int32_t REGION_OUTSIDE {-2};
+
+// Maximum number of surface tokens in a cell for its surfaces to be stored in
+// a SurfaceBlock
+constexpr int SURFACE_BLOCK_MAX {32};
+
 //==============================================================================
 // Global variables
 //==============================================================================
@@ -77,15 +85,18 @@ public:
   //! Simple cells can be evaluated with short circuit evaluation, i.e., as soon
   //! as we know that one half-space is not satisfied, we can exit. This
   //! provides a performance benefit for the common case. In
-  //! contains_complex, we evaluate the RPN expression using a stack, similar to
-  //! how a RPN calculator would work.
+  //! contains_complex, we follow the region compiled by compile_region, which
+  //! short circuits every intersection and union.
   //! \param r The 3D Cartesian coordinate to check.
   //! \param u A direction used to "break ties" the coordinates are very
   //!   close to a surface.
   //! \param on_surface The signed index of a surface that the coordinate is
   //!   known to be on.  This index takes precedence over surface sense
   //!   calculations.
-  virtual bool contains(Position r, Direction u, int32_t on_surface) const = 0;
+  //! \param cache Senses of surfaces already evaluated at this location, if
+  //!   any.  Senses evaluated by this call are added to it.
+  virtual bool contains(Position r, Direction u, int32_t on_surface,
+    SurfaceSenseCache* cache = nullptr) const = 0;
 
   //! Find the oncoming boundary of this cell.
   virtual std::pair<double, int32_t> distance(
@@ -97,17 +108,22 @@ public:
 
   virtual void to_hdf5_inner(hid_t group_id) const = 0;
 
-  //! Export physical properties to HDF5
-  //! \param[in] group  HDF5 group to read from
-  void export_properties_hdf5(hid_t group) const;
+  //! Get the region specification in terms of surface IDs, as it would appear
+  //! in the input.  Empty if the cell has no region.
+  std::string region_spec() const;
 
-  //! Import physical properties from HDF5
-  //! \param[in] group  HDF5 group to write to
+  //! Import physical properties from an HDF5 properties file written before
+  //! version 2.0 of the format
+  //! \param[in] group  HDF5 group to read from
   void import_properties_hdf5(hid_t group);
 
   //! Get the BoundingBox for this cell.
   virtual BoundingBox bounding_box() const = 0;
 
+  //! Memory held by the cell's region, per-instance properties, and neighbor
+  //! list in [bytes]
+  size_t memory_usage() const;
+
   //----------------------------------------------------------------------------
   // Accessors
 
@@ -127,6 +143,10 @@ public:
   void set_temperature(
     double T, int32_t instance = -1, bool set_contained = false);
 
+  //! Look up the index in data::cell_sqrtkT of each temperature in sqrtkT_ so
+  //! that nuclides can use their cached nearest temperature index
+  void update_temperature_indices();
+
   //! Set the rotation matrix of a cell instance
   //! \param[in] rot The rotation matrix of length 3 or 9
   void set_rotation(const vector<double>& rot);
@@ -200,6 +220,9 @@ public:
   //! T. The units are sqrt(eV).
   vector<double> sqrtkT_;
 
+  //! Index in data::cell_sqrtkT of each temperature in sqrtkT_
+  vector<int> i_sqrtkT_;
+
   //! Definition of spatial region as Boolean expression of half-spaces
   vector<std::int32_t> region_;
   //! Reverse Polish notation for region expression
@@ -219,6 +242,10 @@ public:
   //! also present at the end of the vector, making it of length 12.
   vector<double> rotation_;
 
+  //! Whether the rotation matrix differs from the identity, in which case it
+  //! must be applied when moving into the filled universe
+  bool rotated_ {false};
+
   vector<int32_t> offset_; //!< Distribcell offset table
 };
 
@@ -235,7 +262,8 @@ public:
 
   explicit CSGCell(pugi::xml_node cell_node);
 
-  bool contains(Position r, Direction u, int32_t on_surface) const override;
+  bool contains(Position r, Direction u, int32_t on_surface,
+    SurfaceSenseCache* cache = nullptr) const override;
 
   std::pair<double, int32_t> distance(
     Position r, Direction u, int32_t on_surface, Particle* p) const override;
@@ -245,8 +273,50 @@ public:
   BoundingBox bounding_box() const override;
 
 protected:
-  bool contains_simple(Position r, Direction u, int32_t on_surface) const;
-  bool contains_complex(Position r, Direction u, int32_t on_surface) const;
+  //! Coefficients of the surfaces of a cell stored as structure of arrays so
+  //! that the distances to all of them can be evaluated in one SIMD pass.
+  //! Planes are stored as A*x + B*y + C*z - D and cylinders and spheres as
+  //! the quadric |m*(r - r0)|^2 - R^2, where the mask m is zero along the
+  //! axis of a cylinder.
+  struct SurfaceBlock {
+    // Planes
+    vector<int32_t> plane_surf; //!< Surface index (1-based) of each plane
+    vector<double> A, B, C, D;
+
+    // Cylinders and spheres
+    vector<int32_t> quad_surf; //!< Surface index (1-based) of each quadric
+    vector<double> x0, y0, z0;
+    vector<double> mx, my, mz; //!< Mask, 0 along a cylinder axis and 1 else
+    vector<double> R2;         //!< Squared radius
+
+    //! Position in the combined plane/quadric distances of each surface token
+    //! of the RPN
+    vector<int> order;
+  };
+
+  //! Step of the compiled region of a complex cell.  The sense of the
+  //! particle with respect to the surface of token is tested, and evaluation
+  //! continues at the step next_true or next_false depending on whether it
+  //! matches.  REGION_INSIDE and REGION_OUTSIDE end the evaluation.
+  struct RegionOp {
+    int32_t token;
+    int32_t next_true;
+    int32_t next_false;
+  };
+
+  //! Compile the RPN of a complex cell into region_code_.  Complements are
+  //! removed using De Morgan's laws, and the jump targets skip the remaining
+  //! operands of an intersection or union once its result is known.
+  void compile_region();
+
+  //! Fill surface_block_ if all the surfaces of the cell are planes,
+  //! axis-aligned cylinders, or spheres
+  void build_surface_block();
+
+  bool contains_simple(Position r, Direction u, int32_t on_surface,
+    SurfaceSenseCache* cache) const;
+  bool contains_complex(Position r, Direction u, int32_t on_surface,
+    SurfaceSenseCache* cache) const;
   BoundingBox bounding_box_simple() const;
   static BoundingBox bounding_box_complex(vector<int32_t> rpn);
 
@@ -267,6 +337,9 @@ protected:
   //! \param rpn The rpn being searched
   static vector<int32_t>::iterator find_left_parenthesis(
     vector<int32_t>::iterator start, const vector<int32_t>& rpn);
+
+  vector<RegionOp> region_code_;           //!< Compiled region if complex
+  unique_ptr<SurfaceBlock> surface_block_; //!< Surfaces for distance()
 };
 
 //==============================================================================
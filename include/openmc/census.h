@@ -0,0 +1,61 @@
+#ifndef OPENMC_CENSUS_H
+#define OPENMC_CENSUS_H
+
+//! \file census.h
+//! \brief Banking and combing of particles at census times
+
+#include <cstdint>
+
+#include "openmc/particle.h"
+#include "openmc/shared_array.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace simulation {
+
+//! Index of the time window being transported. Window i ends at the i-th
+//! census time, and the last window has no end.
+extern int current_census;
+
+//! Particles that reached the end of the current time window
+extern SharedArray<SourceSite> census_bank;
+
+//! Combed particles that start the current time window
+extern vector<SourceSite> census_source;
+
+} // namespace simulation
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Time at which the current time window ends
+//! \return Census time in [s], or infinity in the last window
+double census_time();
+
+//! Number of the current time window counted over all generations, which
+//! identifies the random number streams of its particles
+int64_t census_generation();
+
+//! Allocate the census bank
+void init_census_bank();
+
+//! Bank a particle that has reached the census time
+//! \param p Particle, which is killed
+void bank_census_particle(Particle& p);
+
+//! Comb the census bank into the source of the next time window. The sites
+//! are combed into as many particles as a generation has on this process,
+//! each carrying an equal share of the banked weight.
+void comb_census_bank();
+
+void free_memory_census();
+
+} // namespace openmc
+
+#endif // OPENMC_CENSUS_H
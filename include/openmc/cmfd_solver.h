@@ -10,6 +10,10 @@ namespace openmc {
 // For non-accelerated regions on coarse mesh overlay
 constexpr int CMFD_NOACCEL {-1};
 
+// Linear solvers for the CMFD matrix equations
+constexpr int CMFD_SOLVER_GAUSS_SEIDEL {0};
+constexpr int CMFD_SOLVER_BICGSTAB {1};
+
 //==============================================================================
 // Non-member functions
 //==============================================================================
@@ -0,0 +1,36 @@
+#ifndef OPENMC_CONDENSED_HISTORY_H
+#define OPENMC_CONDENSED_HISTORY_H
+
+//! \file condensed_history.h
+//! \brief Condensed history transport of electrons and positrons
+
+#include "openmc/particle.h"
+
+namespace openmc {
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Length of the next condensed history step of a charged particle, which is a
+//! fraction of its continuous slowing down range
+//! \param p Electron or positron
+//! \return Step length in [cm]
+double condensed_history_step(const Particle& p);
+
+//! Reduce the energy of a charged particle after it has travelled a distance
+//! using the continuous slowing down approximation
+//! \param p Electron or positron
+//! \param distance Distance travelled in [cm]
+void continuous_slowing_down(Particle& p, double distance);
+
+//! Apply the effects of the path travelled since the last condensed history
+//! collision: create the bremsstrahlung photons emitted while slowing down,
+//! deflect the particle by multiple scattering, and absorb it once it has
+//! reached the end of its range
+//! \param p Electron or positron
+void condensed_history_collision(Particle& p);
+
+} // namespace openmc
+
+#endif // OPENMC_CONDENSED_HISTORY_H
@@ -17,6 +17,14 @@ using double_2dvec = vector<vector<double>>;
 using double_3dvec = vector<vector<vector<double>>>;
 using double_4dvec = vector<vector<vector<vector<double>>>>;
 
+// Type used to store pointwise continuous-energy cross section values. Energy
+// grids and interpolation are always carried out in double precision.
+#ifdef OPENMC_XS_SINGLE_PRECISION
+using xs_real = float;
+#else
+using xs_real = double;
+#endif
+
 // ============================================================================
 // VERSIONING NUMBERS
 
@@ -26,12 +34,13 @@ constexpr int HDF5_VERSION[] {3, 0};
 // Version numbers for binary files
 constexpr array<int, 2> VERSION_STATEPOINT {17, 0};
 constexpr array<int, 2> VERSION_PARTICLE_RESTART {2, 0};
-constexpr array<int, 2> VERSION_TRACK {3, 0};
-constexpr array<int, 2> VERSION_SUMMARY {6, 0};
+constexpr array<int, 2> VERSION_TRACK {4, 0};
+constexpr array<int, 2> VERSION_SUMMARY {6, 1};
 constexpr array<int, 2> VERSION_VOLUME {1, 0};
 constexpr array<int, 2> VERSION_VOXEL {2, 0};
 constexpr array<int, 2> VERSION_MGXS_LIBRARY {1, 0};
-constexpr array<int, 2> VERSION_PROPERTIES {1, 0};
+constexpr array<int, 2> VERSION_PROPERTIES {2, 0};
+constexpr array<int, 2> VERSION_RANDOM_RAY {1, 0};
 
 // ============================================================================
 // ADJUSTABLE PARAMETERS
@@ -45,6 +54,15 @@ constexpr double CONFIDENCE_LEVEL {0.95};
 // Used for surface current tallies
 constexpr double TINY_BIT {1e-8};
 
+// Maximum memory for the thread-private result buffers of a single tally
+constexpr double MAX_THREAD_BUFFER_BYTES {1.0e9};
+
+// Number of tally values reduced across processes at a time
+constexpr int REDUCE_CHUNK_SIZE {131072};
+
+// Number of most uncertain bins tracked for each tally trigger
+constexpr int N_TRIGGER_WORST_BINS {64};
+
 // User for precision in geometry
 constexpr double FP_PRECISION {1e-14};
 constexpr double FP_REL_PRECISION {1e-5};
@@ -237,7 +255,8 @@ enum class ResScatMethod {
 
 enum class ElectronTreatment {
   LED, // Local Energy Deposition
-  TTB  // Thick Target Bremsstrahlung
+  TTB, // Thick Target Bremsstrahlung
+  CH   // Condensed History
 };
 
 // ============================================================================
@@ -249,6 +268,10 @@ constexpr double MACROSCOPIC_AWR {-2.};
 // Number of mu bins to use when converting Legendres to tabular type
 constexpr int DEFAULT_NMU {33};
 
+// Minimum number of outgoing groups for which the outgoing group of a scatter
+// is sampled from an alias table rather than by searching its CDF
+constexpr int MIN_ALIAS_GROUPS {16};
+
 // Mgxs::get_xs enumerated types
 enum class MgxsType {
   TOTAL,
@@ -273,7 +296,7 @@ enum class MgxsType {
 
 enum class TallyResult { VALUE, SUM, SUM_SQ };
 
-enum class TallyType { VOLUME, MESH_SURFACE, SURFACE };
+enum class TallyType { VOLUME, MESH_SURFACE, SURFACE, PULSE_HEIGHT };
 
 enum class TallyEstimator { ANALOG, TRACKLENGTH, COLLISION };
 
@@ -301,7 +324,11 @@ enum TallyScore {
   SCORE_INVERSE_VELOCITY = -13,   // flux-weighted inverse velocity
   SCORE_FISS_Q_PROMPT = -14,      // prompt fission Q-value
   SCORE_FISS_Q_RECOV = -15,       // recoverable fission Q-value
-  SCORE_DECAY_RATE = -16          // delayed neutron precursor decay rate
+  SCORE_DECAY_RATE = -16,         // delayed neutron precursor decay rate
+  SCORE_PULSE_HEIGHT = -17,       // energy deposited per history
+  SCORE_IFP_TIME_NUM = -18,       // IFP generation time numerator
+  SCORE_IFP_BETA_NUM = -19,       // IFP delayed neutron fraction numerator
+  SCORE_IFP_DENOM = -20           // IFP denominator
 };
 
 // Global tally parameters
@@ -330,6 +357,18 @@ enum class RunMode {
   VOLUME
 };
 
+// Policies for choosing the next event kernel in event-based mode
+enum class EventSchedule {
+  LONGEST, // Kernel with the longest queue
+  ORDERED  // All kernels in a fixed order, skipping short queues
+};
+
+// Policies for distributing histories among threads in history-based mode
+enum class HistorySchedule {
+  LOOP,         // OpenMP loop with the runtime schedule
+  WORK_STEALING // Per-thread ranges, with idle threads stealing from others
+};
+
 //==============================================================================
 // Geometry Constants
 
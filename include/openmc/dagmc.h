@@ -44,20 +44,42 @@ public:
 
   inline void to_hdf5_inner(hid_t group_id) const override {};
 
+  //! Find the cell on the other side of the surface
+  //! \param i_cell Index of the cell on one side of the surface
+  //! \return Index of the cell on the other side, or C_NONE if it is not
+  //!   known
+  int32_t other_cell(int32_t i_cell) const
+  {
+    if (i_cell == parent_cells_[0])
+      return parent_cells_[1];
+    if (i_cell == parent_cells_[1])
+      return parent_cells_[0];
+    return C_NONE;
+  }
+
   // Accessor methods
   const std::shared_ptr<moab::DagMC>& dagmc_ptr() const { return dagmc_ptr_; }
   int32_t dag_index() const { return dag_index_; }
 
+  //! Set the indices of the two cells that the surface bounds
+  void set_parent_cells(int32_t i_cell0, int32_t i_cell1)
+  {
+    parent_cells_ = {i_cell0, i_cell1};
+  }
+
 private:
   std::shared_ptr<moab::DagMC> dagmc_ptr_; //!< Pointer to DagMC instance
   int32_t dag_index_;                      //!< DagMC index of surface
+  array<int32_t, 2> parent_cells_ {
+    C_NONE, C_NONE}; //!< Indices of the cells the surface bounds
 };
 
 class DAGCell : public Cell {
 public:
   DAGCell(std::shared_ptr<moab::DagMC> dag_ptr, int32_t dag_idx);
 
-  bool contains(Position r, Direction u, int32_t on_surface) const override;
+  bool contains(Position r, Direction u, int32_t on_surface,
+    SurfaceSenseCache* cache = nullptr) const override;
 
   std::pair<double, int32_t> distance(
     Position r, Direction u, int32_t on_surface, Particle* p) const override;
@@ -66,13 +88,28 @@ public:
 
   void to_hdf5_inner(hid_t group_id) const override;
 
+  //! Treat the volume as an axis-aligned box, so that containment and
+  //! distances are computed analytically rather than from the triangle mesh
+  //! \param lower Lower corner of the box
+  //! \param upper Upper corner of the box
+  //! \param face_surfs Surface index returned by distance() for each face in
+  //!   the order -x, +x, -y, +y, -z, +z, or C_NONE if a face is covered by
+  //!   several DAGMC surfaces and the surface hit has to be found by a ray
+  void set_box(Position lower, Position upper, array<int32_t, 6> face_surfs);
+
   // Accessor methods
   const std::shared_ptr<moab::DagMC>& dagmc_ptr() const { return dagmc_ptr_; }
   int32_t dag_index() const { return dag_index_; }
+  bool is_box() const { return is_box_; }
 
 private:
   std::shared_ptr<moab::DagMC> dagmc_ptr_; //!< Pointer to DagMC instance
   int32_t dag_index_;                      //!< DagMC index of cell
+
+  bool is_box_ {false};          //!< Is the volume an axis-aligned box?
+  Position box_lower_;           //!< Lower corner of the box
+  Position box_upper_;           //!< Upper corner of the box
+  array<int32_t, 6> face_surfs_; //!< Surface index of each face of the box
 };
 
 class DAGUniverse : public Universe {
@@ -145,10 +182,11 @@ public:
   bool has_graveyard() const { return has_graveyard_; }
 
 private:
-  void set_id();        //!< Deduce the universe id from model::universes
-  void init_dagmc();    //!< Create and initialise DAGMC pointer
-  void init_metadata(); //!< Create and initialise dagmcMetaData pointer
-  void init_geometry(); //!< Create cells and surfaces from DAGMC entities
+  void set_id();         //!< Deduce the universe id from model::universes
+  void init_dagmc();     //!< Create and initialise DAGMC pointer
+  void init_metadata();  //!< Create and initialise dagmcMetaData pointer
+  void init_geometry();  //!< Create cells and surfaces from DAGMC entities
+  void init_box_cells(); //!< Find volumes that are axis-aligned boxes
 
   std::string
     filename_; //!< Name of the DAGMC file used to create this universe
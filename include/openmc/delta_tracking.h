@@ -0,0 +1,56 @@
+//! \file delta_tracking.h
+//! \brief Woodcock delta tracking through heterogeneous universes
+
+#ifndef OPENMC_DELTA_TRACKING_H
+#define OPENMC_DELTA_TRACKING_H
+
+#include <cstdint> // for int64_t
+
+#include "openmc/majorant.h"
+#include "openmc/particle.h"
+
+namespace openmc {
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace simulation {
+
+extern vector<int> delta_majorant; //!< Index in majorants of each universe
+                                   //!< that is delta tracked or C_NONE
+extern int64_t n_majorant_violations; //!< Tentative collisions at which the
+                                      //!< total cross section exceeded the
+                                      //!< majorant
+
+} // namespace simulation
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Compute the majorants of the delta-tracked universes and switch
+//! track-length tallies to collision estimators
+void init_delta_tracking();
+
+//! Determine the coordinate level that the next step of a particle is delta
+//! tracked through
+//
+//! \param[in] p Particle whose cross sections at its location are known
+//! \return Level of the highest delta-tracked universe containing the
+//!   particle, or C_NONE if the step should use surface tracking
+int delta_tracking_level(const Particle& p);
+
+//! Move a particle to its next real collision or to the boundary of the
+//! delta-tracked universe, whichever comes first. The distance to the
+//! boundary has to have been found with distance_to_boundary(p, level).
+//
+//! \param[inout] p Particle to move
+//! \param[in] level Level of the delta-tracked universe
+void delta_track(Particle& p, int level);
+
+void free_memory_delta_tracking();
+
+} // namespace openmc
+
+#endif // OPENMC_DELTA_TRACKING_H
@@ -22,6 +22,13 @@ class Distribution {
 public:
   virtual ~Distribution() = default;
   virtual double sample(uint64_t* seed) const = 0;
+
+  //! Sample one value with each of several seeds. The values are the same as
+  //! those from calling sample() once with each seed.
+  //! \param seeds Array of 'n' pseudorandom number seeds
+  //! \param n Number of values to sample
+  //! \param x Array of 'n' sampled values
+  virtual void sample_batch(uint64_t* seeds, int n, double* x) const;
 };
 
 using UPtrDist = unique_ptr<Distribution>;
@@ -51,10 +58,13 @@ public:
   const vector<double>& p() const { return p_; }
 
 private:
-  vector<double> x_; //!< Possible outcomes
-  vector<double> p_; //!< Probability of each outcome
+  vector<double> x_;     //!< Possible outcomes
+  vector<double> p_;     //!< Probability of each outcome
+  vector<double> c_;     //!< Cumulative probability of each outcome
+  vector<int> c_guide_; //!< Guide table for searching c_
 
-  //! Normalize distribution so that probabilities sum to unity
+  //! Normalize distribution so that probabilities sum to unity and compute the
+  //! cumulative probabilities
   void normalize();
 };
 
@@ -72,6 +82,12 @@ public:
   //! \return Sampled value
   double sample(uint64_t* seed) const;
 
+  //! Sample one value with each of several seeds
+  //! \param seeds Array of 'n' pseudorandom number seeds
+  //! \param n Number of values to sample
+  //! \param x Array of 'n' sampled values
+  void sample_batch(uint64_t* seeds, int n, double* x) const override;
+
   double a() const { return a_; }
   double b() const { return b_; }
 
@@ -140,6 +156,12 @@ public:
   //! \return Sampled value
   double sample(uint64_t* seed) const;
 
+  //! Sample one value with each of several seeds
+  //! \param seeds Array of 'n' pseudorandom number seeds
+  //! \param n Number of values to sample
+  //! \param x Array of 'n' sampled values
+  void sample_batch(uint64_t* seeds, int n, double* x) const override;
+
   double a() const { return a_; }
   double b() const { return b_; }
 
@@ -226,6 +248,7 @@ private:
   vector<double> x_;     //!< tabulated independent variable
   vector<double> p_;     //!< tabulated probability density
   vector<double> c_;     //!< cumulative distribution at tabulated values
+  vector<int> c_guide_;  //!< guide table for searching c_
   Interpolation interp_; //!< interpolation rule
 
   //! Initialize tabulated probability density function
@@ -275,6 +298,7 @@ private:
 
   vector<DistPair>
     distribution_; //!< sub-distributions + cummulative probabilities
+  vector<int> c_guide_; //!< guide table for cummulative probabilities
 };
 
 
@@ -89,6 +89,7 @@ private:
     xt::xtensor<double, 1> e_out; //!< Outgoing energies in [eV]
     xt::xtensor<double, 1> p;     //!< Probability density
     xt::xtensor<double, 1> c;     //!< Cumulative distribution
+    vector<int> c_guide;          //!< Guide table for searching c
   };
 
   int n_region_;                        //!< Number of inteprolation regions
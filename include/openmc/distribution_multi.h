@@ -27,6 +27,13 @@ public:
   //! \return Direction sampled
   virtual Direction sample(uint64_t* seed) const = 0;
 
+  //! Sample one direction with each of several seeds. The directions are the
+  //! same as those from calling sample() once with each seed.
+  //! \param seeds Array of 'n' pseudorandom number seeds
+  //! \param n Number of directions to sample
+  //! \param u Array of 'n' sampled directions
+  virtual void sample_batch(uint64_t* seeds, int n, Direction* u) const;
+
   Direction u_ref_ {0.0, 0.0, 1.0}; //!< reference direction
 };
 
@@ -67,6 +74,12 @@ public:
   //! \param seed Pseudorandom number seed pointer
   //! \return Sampled direction
   Direction sample(uint64_t* seed) const;
+
+  //! Sample one direction with each of several seeds
+  //! \param seeds Array of 'n' pseudorandom number seeds
+  //! \param n Number of directions to sample
+  //! \param u Array of 'n' sampled directions
+  void sample_batch(uint64_t* seeds, int n, Direction* u) const override;
 };
 
 //==============================================================================
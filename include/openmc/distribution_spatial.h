@@ -18,6 +18,13 @@ public:
 
   //! Sample a position from the distribution
   virtual Position sample(uint64_t* seed) const = 0;
+
+  //! Sample one position with each of several seeds. The positions are the
+  //! same as those from calling sample() once with each seed.
+  //! \param seeds Array of 'n' pseudorandom number seeds
+  //! \param n Number of positions to sample
+  //! \param r Array of 'n' sampled positions
+  virtual void sample_batch(uint64_t* seeds, int n, Position* r) const;
 };
 
 //==============================================================================
@@ -33,6 +40,12 @@ public:
   //! \return Sampled position
   Position sample(uint64_t* seed) const;
 
+  //! Sample one position with each of several seeds
+  //! \param seeds Array of 'n' pseudorandom number seeds
+  //! \param n Number of positions to sample
+  //! \param r Array of 'n' sampled positions
+  void sample_batch(uint64_t* seeds, int n, Position* r) const override;
+
   // Observer pointers
   Distribution* x() const { return x_.get(); }
   Distribution* y() const { return y_.get(); }
@@ -107,6 +120,12 @@ public:
   //! \return Sampled position
   Position sample(uint64_t* seed) const;
 
+  //! Sample one position with each of several seeds
+  //! \param seeds Array of 'n' pseudorandom number seeds
+  //! \param n Number of positions to sample
+  //! \param r Array of 'n' sampled positions
+  void sample_batch(uint64_t* seeds, int n, Position* r) const override;
+
   // Properties
   bool only_fissionable() const { return only_fissionable_; }
   Position lower_left() const { return lower_left_; }
@@ -139,6 +158,45 @@ private:
   Position r_; //!< Single position at which sites are generated
 };
 
+//==============================================================================
+//! Distribution over the elements of a mesh with a given strength in each,
+//! uniform within each element
+//==============================================================================
+
+class MeshSpatial : public SpatialDistribution {
+public:
+  explicit MeshSpatial(pugi::xml_node node);
+
+  //! Sample a position from the distribution
+  //! \param seed Pseudorandom number seed pointer
+  //! \return Sampled position
+  Position sample(uint64_t* seed) const;
+
+  //! Sample a mesh element with a probability proportional to its strength
+  //! \param seed Pseudorandom number seed pointer
+  //! \return Mesh bin
+  int sample_element(uint64_t* seed) const;
+
+  //! Sample a position uniformly in a mesh element
+  //! \param bin Mesh bin
+  //! \param seed Pseudorandom number seed pointer
+  //! \return Sampled position
+  Position sample_position(int bin, uint64_t* seed) const;
+
+  // Properties
+  int32_t mesh_index() const { return mesh_index_; }
+  bool has_energy() const { return !energy_.empty(); }
+
+  //! Energy distribution of sites in a mesh element
+  const Distribution* energy(int bin) const { return energy_[bin].get(); }
+
+private:
+  int32_t mesh_index_;       //!< Index of the mesh in model::meshes
+  vector<double> alias_prob_; //!< Probability of keeping each alias bin
+  vector<int> alias_bin_;     //!< Mesh bin aliased by each alias bin
+  vector<UPtrDist> energy_;   //!< Energy distribution in each mesh bin
+};
+
 using UPtrSpace = unique_ptr<SpatialDistribution>;
 
 } // namespace openmc
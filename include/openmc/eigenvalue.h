@@ -15,6 +15,19 @@
 
 namespace openmc {
 
+//==============================================================================
+// Constants
+//==============================================================================
+
+// Largest entropy mesh that a fission matrix is tallied on, which keeps the
+// dense matrix under 128 MB
+constexpr int FISSION_MATRIX_MAX_BINS {4096};
+
+// Maximum number of power iterations and convergence tolerance used to find
+// the dominant eigenvector of the fission matrix
+constexpr int FISSION_MATRIX_MAX_ITER {1000};
+constexpr double FISSION_MATRIX_TOLERANCE {1.0e-8};
+
 //==============================================================================
 // Global variables
 //==============================================================================
@@ -25,6 +38,18 @@ extern double keff_generation; //!<  Single-generation k on each processor
 extern array<double, 2> k_sum; //!< Used to reduce sum and sum_sq
 extern vector<double> entropy; //!< Shannon entropy at each generation
 extern xt::xtensor<double, 1> source_frac; //!< Source fraction for UFS
+extern xt::xtensor<double, 2>
+  fission_matrix; //!< Weight of fission sites born in each entropy mesh bin
+                  //!< from source sites in each bin, indexed by [born][source]
+extern xt::xtensor<double, 1>
+  fission_matrix_source; //!< Weight of source sites in each entropy mesh bin
+extern double k_shift; //!< Wielandt shift eigenvalue for the current generation
+extern double
+  wielandt_weight; //!< Weight of fission neutrons transported in the
+                   //!< generation they were born on each processor
+extern double wielandt_weight_unreduced; //!< Weight of such neutrons on all
+                                         //!< processors since user tallies
+                                         //!< were last accumulated
 
 } // namespace simulation
 
@@ -32,6 +57,11 @@ extern xt::xtensor<double, 1> source_frac; //!< Source fraction for UFS
 // Non-member functions
 //==============================================================================
 
+//! Set the values of the generation that are summed over all processes in
+//! mpi::generation_sums: the tracklength keff, the weight of Wielandt-shifted
+//! fission neutrons, and the number of fission sites
+void set_generation_sums();
+
 //! Collect/normalize the tracklength keff from each process
 void calculate_generation_keff();
 
@@ -57,8 +87,30 @@ void calculate_average_keff();
 extern "C" int openmc_get_keff(double* k_combined);
 
 //! Sample/redistribute source sites from accumulated fission sites
+//!
+//! When settings::pipelined_bank is set, the sends and receives of source
+//! sites are left in flight. Chunks of the source bank are then obtained with
+//! receive_bank_chunk() as they arrive, and finish_bank_exchange() must be
+//! called before the whole source bank is read.
 void synchronize_bank();
 
+//! Check whether a pipelined source bank exchange is still in flight
+bool bank_exchange_pending();
+
+//! Get the next chunk of the source bank left in flight by synchronize_bank()
+//!
+//! Sites sampled on this process are returned first, followed by chunks from
+//! other processes in the order they arrive. Once all chunks have been
+//! returned, the exchange is completed.
+//!
+//! \param[out] i_begin Index in the source bank of the first site
+//! \param[out] i_end Index in the source bank one past the last site
+//! \return Whether a chunk was returned
+bool receive_bank_chunk(int64_t* i_begin, int64_t* i_end);
+
+//! Complete any source bank exchange left in flight by synchronize_bank()
+void finish_bank_exchange();
+
 //! Calculates the Shannon entropy of the fission source distribution to assess
 //! source convergence
 void shannon_entropy();
@@ -71,6 +123,19 @@ void ufs_count_sites();
 //! Get UFS weight corresponding to particle's location
 double ufs_get_weight(const Particle& p);
 
+//! Allocate the fission matrix on the entropy mesh
+void init_fission_matrix();
+
+//! Add the fission sites of the current generation to the fission matrix of
+//! this process. This must be called before the source bank is replaced.
+void tally_fission_matrix();
+
+//! Sum the fission matrix over processes and, every
+//! settings::fission_matrix_interval batches, reweight the source bank so that
+//! its distribution over the entropy mesh matches the dominant eigenvector of
+//! the fission matrix
+void update_fission_matrix();
+
 //! Write data related to k-eigenvalue to statepoint
 //! \param[in] group HDF5 group
 void write_eigenvalue_hdf5(hid_t group);
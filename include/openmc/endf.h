@@ -90,6 +90,16 @@ private:
   std::size_t n_pairs_;       //!< number of (x,y) pairs
   vector<double> x_;          //!< values of abscissa
   vector<double> y_;          //!< values of ordinate
+
+  //! Interpolation scheme used everywhere when there is a single region
+  Interpolation interp_ {Interpolation::lin_lin};
+  bool single_region_ {true}; //!< whether interp_ applies to all pairs
+
+  // Hash table over ln(x) bounding the search for the bin containing x. Entry
+  // b is the number of abscissas falling in hash bins below b.
+  double hash_log_min_;    //!< ln(x) at the lower edge of the table
+  double hash_inv_width_;  //!< Inverse width of a hash bin in ln(x)
+  vector<int> hash_index_; //!< Search bounds for each hash bin
 };
 
 //==============================================================================
@@ -102,12 +112,22 @@ public:
 
   double operator()(double E) const override;
 
+  //! Find the highest Bragg edge at or below an energy
+  //! \param[in] E Energy in [eV], which must not be below the first edge
+  //! \return Index of the Bragg edge, as from lower_bound_index()
+  int bragg_index(double E) const;
+
   const vector<double>& bragg_edges() const { return bragg_edges_; }
   const vector<double>& factors() const { return factors_; }
 
 private:
   vector<double> bragg_edges_; //!< Bragg edges in [eV]
   vector<double> factors_;     //!< Partial sums of structure factors [eV-b]
+
+  // Hash table over E bounding the search for the Bragg edge below E. Entry b
+  // is the number of edges falling in hash bins below b.
+  double hash_inv_width_;  //!< Inverse width of a hash bin in [1/eV]
+  vector<int> hash_index_; //!< Search bounds for each hash bin
 };
 
 //==============================================================================
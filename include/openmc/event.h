@@ -4,6 +4,7 @@
 //! \file event.h
 //! \brief Event-based data structures and methods
 
+#include "openmc/array.h"
 #include "openmc/particle.h"
 #include "openmc/shared_array.h"
 
@@ -49,6 +50,47 @@ struct EventQueueItem {
   }
 };
 
+// When secondary particles are shared between particle buffer slots, a dead
+// particle hands its secondaries to a shared queue instead of tracking them
+// itself, and they are started in whichever slots are free later on. Each
+// queued secondary carries the history state it would otherwise have
+// inherited from the particle occupying the slot. Its random number streams
+// are derived from the state of its parent's stream when it was queued, so
+// its history does not depend on which slot tracks it or when.
+struct SecondaryQueueItem {
+  SourceSite site;   //!< secondary particle
+  int64_t id;        //!< ID of the history that created the secondary
+  int64_t stream_id; //!< ID used to initialize its random number streams
+  int n_split;       //!< number of splits in the history so far
+  double ww_factor;  //!< weight window factor of the history
+};
+
+// Event kernels, used to keep statistics on how they are scheduled
+enum class EventKernel {
+  INIT,
+  CALCULATE_FUEL_XS,
+  CALCULATE_NONFUEL_XS,
+  ADVANCE_PARTICLE,
+  SURFACE_CROSSING,
+  COLLISION,
+  SECONDARY_INIT
+};
+
+constexpr int N_EVENT_KERNELS {7};
+
+// Number of times a kernel was executed and the total number of particles that
+// it processed
+struct EventKernelStats {
+  int64_t n_calls {0};
+  int64_t n_particles {0};
+
+  //! Average number of particles per call
+  double average() const
+  {
+    return n_calls > 0 ? static_cast<double>(n_particles) / n_calls : 0.0;
+  }
+};
+
 //==============================================================================
 // Global variable declarations
 //==============================================================================
@@ -65,9 +107,17 @@ extern SharedArray<EventQueueItem> advance_particle_queue;
 extern SharedArray<EventQueueItem> surface_crossing_queue;
 extern SharedArray<EventQueueItem> collision_queue;
 
+// Secondary particles waiting for a free slot and the indices of free slots in
+// the particle buffer, which are only used when secondaries are shared
+extern SharedArray<SecondaryQueueItem> secondary_queue;
+extern SharedArray<int64_t> free_particle_queue;
+
 // Particle buffer
 extern vector<Particle> particles;
 
+// Statistics for each event kernel over the whole simulation
+extern array<EventKernelStats, N_EVENT_KERNELS> event_kernel_stats;
+
 } // namespace simulation
 
 //==============================================================================
@@ -93,6 +143,55 @@ void dispatch_xs_event(int64_t buffer_idx);
 //! \param source_offset The offset index in the source bank to use
 void process_init_events(int64_t n_particles, int64_t source_offset);
 
+//! Revive a dead particle from its secondaries or, when secondaries are
+//! shared, hand them to the secondary queue and mark the particle's slot free
+//
+//! \param buffer_idx The particle's actual index in the particle buffer
+void revive_from_secondary(int64_t buffer_idx);
+
+//! Number of queued secondaries that can be started in free slots
+int64_t n_secondary_init_events();
+
+//! Execute the initialization event for queued secondaries in free slots
+void process_secondary_init_events();
+
+//! Start new particles from the source in free slots once the fraction of
+//! particles in flight drops below settings::event_refill_threshold
+//
+//! \param n_particles The number of particles in the particle buffer
+//! \param n_work The number of source particles that are left to run
+//! \param source_offset The offset index in the source bank to use
+//! \return The number of particles that were started
+int64_t process_refill_events(
+  int64_t n_particles, int64_t n_work, int64_t source_offset);
+
+//! Sort a queue by particle type, material, and energy with a parallel radix
+//! sort, unless it is shorter than settings::event_sort_threshold
+//
+//! \param queue The queue to sort
+void sort_event_queue(SharedArray<EventQueueItem>& queue);
+
+//! Execute the next event kernels chosen by settings::event_schedule
+//
+//! \return Whether any particles are still in flight
+bool process_next_events();
+
+//! Execute the calculate XS event with batched lookups
+//
+//! The queue is sorted so that particles in the same material are processed
+//! together, in runs of at most settings::event_xs_batch_size particles.
+//! \param queue A reference to the desired XS lookup queue
+void calculate_xs_batched(SharedArray<EventQueueItem>& queue);
+
+//! Execute the calculate XS event with tabulated macroscopic cross sections
+//! looked up on the offload device
+//
+//! Particles are prepared on the host, and those that can't use a table have
+//! their cross sections calculated there. Only the energies and tables of the
+//! others are copied to the device.
+//! \param queue A reference to the desired XS lookup queue
+void calculate_xs_offload(SharedArray<EventQueueItem>& queue);
+
 //! Execute the calculate XS event for all particles in this event's buffer
 //
 //! \param queue A reference to the desired XS lookup queue
@@ -101,6 +200,16 @@ void process_calculate_xs_events(SharedArray<EventQueueItem>& queue);
 //! Execute the advance particle event for all particles in this event's buffer
 void process_advance_particle_events();
 
+//! Score tallies for all particles in an advance or collision event's buffer
+//
+//! Scoring is done in a separate kernel after the event itself, with the queue
+//! sorted so that particles in the same material and energy range score
+//! together.
+//! \param queue A reference to the queue of the event that was just executed
+//! \param score The Particle method that scores tallies for the event
+void process_tally_events(
+  SharedArray<EventQueueItem>& queue, void (Particle::*score)());
+
 //! Execute the surface crossing event for all particles in this event's buffer
 void process_surface_crossing_events();
 
@@ -11,6 +11,7 @@
 namespace openmc {
 
 class BoundaryInfo;
+class NeighborList;
 class Particle;
 
 //==============================================================================
@@ -24,6 +25,10 @@ extern "C" int n_coord_levels; //!< Number of CSG coordinate levels
 
 extern vector<int64_t> overlap_check_count;
 
+//! Number of overlap checks of each cell by each thread that have not yet been
+//! added to overlap_check_count
+extern vector<vector<int64_t>> overlap_check_count_thread;
+
 } // namespace model
 
 //==============================================================================
@@ -41,6 +46,29 @@ inline bool coincident(double d1, double d2)
 
 bool check_cell_overlap(Particle& p, bool error = true);
 
+//==============================================================================
+//! Decide whether overlaps are checked at the start of a particle's event.
+//!
+//! \param p The particle
+//! \param crossed Whether the particle's cell was just found after crossing a
+//!   surface or lattice boundary, or by an exhaustive search
+//! \return Whether check_cell_overlap should be called
+//==============================================================================
+
+bool sample_overlap_check(const Particle& p, bool crossed);
+
+//==============================================================================
+//! Allocate the overlap check counts for each cell and thread.
+//==============================================================================
+
+void init_overlap_check_count();
+
+//==============================================================================
+//! Add the overlap check counts of each thread to overlap_check_count.
+//==============================================================================
+
+void reduce_overlap_check_count();
+
 //==============================================================================
 //! Get the cell instance for a particle at the specified universe level
 //!
@@ -63,6 +91,40 @@ int cell_instance_at_level(const Particle& p, int level);
 bool exhaustive_find_cell(Particle& p);
 bool neighbor_list_find_cell(Particle& p); // Only usable on surface crossings
 
+//==============================================================================
+//! Locate a particle at its top coordinate level by first searching a list of
+//! candidate cells. If none of them contain the particle, the cell found by an
+//! exhaustive search is added to the list.
+//==============================================================================
+
+bool neighbor_list_find_cell(Particle& p, NeighborList& neighbors);
+
+//==============================================================================
+//! Locate a particle that has moved a short distance since it was last located.
+//!
+//! The coordinate levels found before are kept for as long as their cells and
+//! lattice tiles still contain the particle, and only the levels below them are
+//! searched again.  This is much faster than an exhaustive search when locating
+//! many points that are close together, such as the pixels of a plot.
+//!
+//! \param p A particle that was located by a previous search and then moved by
+//!   changing its position at the top coordinate level.
+//! \return True if the particle's location could be found.
+//==============================================================================
+bool find_cell_nearby(Particle& p);
+
+//==============================================================================
+//! Locate a particle within the universe at a coordinate level.
+//!
+//! The levels above the given one are kept as they are and the cell at that
+//! level and all levels below it are searched again.
+//!
+//! \param p A particle whose position at the given level has changed
+//! \param level Coordinate level (zero indexed) to search from
+//! \return True if the particle's location could be found.
+//==============================================================================
+bool find_cell_at_level(Particle& p, int level);
+
 //==============================================================================
 //! Move a particle into a new lattice tile.
 //==============================================================================
@@ -71,9 +133,14 @@ void cross_lattice(Particle& p, const BoundaryInfo& boundary);
 
 //==============================================================================
 //! Find the next boundary a particle will intersect.
+//!
+//! \param p A particle
+//! \param delta_level Coordinate level of a universe that is delta tracked.
+//!   The cells of that universe and the levels below it are not considered,
+//!   so that only the boundary of the region the universe fills is found.
 //==============================================================================
 
-BoundaryInfo distance_to_boundary(Particle& p);
+BoundaryInfo distance_to_boundary(Particle& p, int delta_level = C_NONE);
 
 } // namespace openmc
 
@@ -14,8 +14,6 @@
 namespace openmc {
 
 namespace model {
-extern std::unordered_map<int32_t, std::unordered_map<int32_t, int32_t>>
-  universe_cell_counts;
 extern std::unordered_map<int32_t, int32_t> universe_level_counts;
 } // namespace model
 
@@ -65,6 +63,9 @@ int32_t find_root_universe();
 
 //==============================================================================
 //! Populate all data structures needed for distribcells.
+//!
+//! Distributed cells that belong to the same universe share one offset map,
+//! i.e. they have the same Cell::distribcell_index_.
 //! \param user_distribcells A set of cell indices to create distribcell data
 //!   structures for regardless of whether or not they are part of a tally
 //!   filter.
@@ -74,10 +75,11 @@ void prepare_distribcell(
   const std::vector<int32_t>* user_distribcells = nullptr);
 
 //==============================================================================
-//! Recursively search through the geometry and count cell instances.
+//! Count cell instances in the geometry.
 //!
 //! This function will update the Cell::n_instances value for each cell in the
-//! geometry.
+//! geometry. The instances of each universe are accumulated in a single pass
+//! over the universes ordered from the top of the geometry tree down.
 //! \param univ_indx The index of the universe to begin searching from (probably
 //!   the root universe).
 //==============================================================================
@@ -85,21 +87,10 @@ void prepare_distribcell(
 void count_cell_instances(int32_t univ_indx);
 
 //==============================================================================
-//! Recursively search through universes and count universe instances.
-//! \param search_univ The index of the universe to begin searching from.
-//! \param target_univ_id The ID of the universe to be counted.
-//! \param univ_count_memo Memoized counts that make this function faster for
-//!   large systems.  The first call to this function for each target_univ_id
-//!   should start with an empty memo.
-//! \return The number of instances of target_univ_id in the geometry tree under
-//!   search_univ.
-//==============================================================================
-
-int count_universe_instances(int32_t search_univ, int32_t target_univ_id,
-  std::unordered_map<int32_t, int32_t>& univ_count_memo);
-
-//==============================================================================
-//! Build a character array representing the path to a distribcell instance.
+//! Build a string representing the path to a distribcell instance.
+//!
+//! Paths are not stored; they are only built when requested, e.g. for tally
+//! output labels.
 //! \param target_cell The index of the Cell in the global Cell array.
 //! \param map The index of the distribcell mapping corresponding to the target
 //!   cell.
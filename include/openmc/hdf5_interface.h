@@ -50,13 +50,33 @@ inline hid_t create_group(hid_t parent_id, const std::stringstream& name)
   return create_group(parent_id, name.str());
 }
 
-hid_t file_open(const std::string& filename, char mode, bool parallel = false);
+//! Open or create a file
+//
+//! \param[in] filename Path to the file
+//! \param[in] mode 'r' or 'a' to open, 'w' or 'x' to create the file
+//! \param[in] parallel Whether the file is accessed collectively
+//! \param[in] page_aligned Whether large datasets of a created file start on
+//!   page boundaries, so that a source bank in it can be memory mapped
+//! \return HDF5 identifier of the file
+hid_t file_open(const std::string& filename, char mode, bool parallel = false,
+  bool page_aligned = false);
+
+//! Create a file that is only held in memory until its image is extracted
+hid_t file_open_memory(const std::string& filename, bool page_aligned = false);
+
+//! Get the contents of an open file as they would be written to disk
+vector<char> file_image(hid_t file_id);
+
 hid_t open_group(hid_t group_id, const std::string& name);
 void write_string(
   hid_t group_id, const char* name, const std::string& buffer, bool indep);
 
 vector<hsize_t> attribute_shape(hid_t obj_id, const char* name);
 vector<std::string> dataset_names(hid_t group_id);
+
+//! Get the size in memory of all datasets in a group and its subgroups
+size_t dataset_bytes(hid_t group_id);
+
 void ensure_exists(hid_t obj_id, const char* name, bool attribute = false);
 vector<std::string> group_names(hid_t group_id);
 vector<hsize_t> object_shape(hid_t obj_id);
@@ -70,6 +90,8 @@ extern "C" {
 bool attribute_exists(hid_t obj_id, const char* name);
 size_t attribute_typesize(hid_t obj_id, const char* name);
 hid_t create_group(hid_t parent_id, const char* name);
+hid_t create_tally_results(
+  hid_t group_id, hsize_t n_filter, hsize_t n_score, hsize_t n_chunk);
 void close_dataset(hid_t dataset_id);
 void close_group(hid_t group_id);
 int dataset_ndims(hid_t dset);
@@ -100,6 +122,8 @@ void read_string(
 
 void read_tally_results(
   hid_t group_id, hsize_t n_filter, hsize_t n_score, double* results);
+void read_tally_results_block(hid_t dset, hsize_t start, hsize_t n_filter,
+  hsize_t n_score, double* results);
 void write_attr_double(hid_t obj_id, int ndim, const hsize_t* dims,
   const char* name, const double* buffer);
 void write_attr_int(hid_t obj_id, int ndim, const hsize_t* dims,
@@ -115,6 +139,8 @@ void write_string(hid_t group_id, int ndim, const hsize_t* dims, size_t slen,
   const char* name, char const* buffer, bool indep);
 void write_tally_results(
   hid_t group_id, hsize_t n_filter, hsize_t n_score, const double* results);
+void write_tally_results_block(hid_t dset, hsize_t start, hsize_t n_filter,
+  hsize_t n_score, const double* results);
 } // extern "C"
 
 //==============================================================================
@@ -0,0 +1,137 @@
+#ifndef OPENMC_HUGE_PAGES_H
+#define OPENMC_HUGE_PAGES_H
+
+//! \file huge_pages.h
+//! \brief Allocation of large arrays that may be backed by huge pages
+
+#include <cstddef> // for size_t
+
+namespace openmc {
+
+//==============================================================================
+// Constants
+//==============================================================================
+
+// Size of a huge page on x86-64 and most aarch64 Linux systems. Only blocks of
+// at least this size are mapped directly from the operating system.
+constexpr size_t HUGE_PAGE_SIZE {2 * 1024 * 1024};
+
+//! Kind of data held in page allocations, which is used for reporting
+enum class PageUse { CROSS_SECTIONS, TALLIES };
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Allocate memory without touching it. Blocks of at least HUGE_PAGE_SIZE are
+//! mapped from the operating system. When settings::huge_pages is set, they are
+//! backed by explicit huge pages if enough are reserved and are otherwise
+//! marked as eligible for transparent huge pages.
+//
+//! \param nbytes Size of the block in bytes
+//! \param use Kind of data the block holds
+//! \return Start of the block
+void* allocate_pages(size_t nbytes, PageUse use);
+
+//! Free memory obtained from allocate_pages
+//
+//! \param ptr Start of the block
+//! \param nbytes Size of the block in bytes as passed to allocate_pages
+//! \param use Kind of data the block holds as passed to allocate_pages
+void free_pages(void* ptr, size_t nbytes, PageUse use);
+
+//! Write how much memory holding a kind of data is backed by huge pages
+//
+//! \param use Kind of data
+void print_huge_page_usage(PageUse use);
+
+//==============================================================================
+//! Block of memory from allocate_pages that is freed on destruction
+//==============================================================================
+
+class PageBuffer {
+public:
+  PageBuffer() = default;
+  PageBuffer(size_t nbytes, PageUse use)
+    : data_ {allocate_pages(nbytes, use)}, nbytes_ {nbytes}, use_ {use}
+  {}
+  ~PageBuffer()
+  {
+    if (data_)
+      free_pages(data_, nbytes_, use_);
+  }
+
+  PageBuffer(const PageBuffer&) = delete;
+  PageBuffer& operator=(const PageBuffer&) = delete;
+
+  PageBuffer(PageBuffer&& other) noexcept
+    : data_ {other.data_}, nbytes_ {other.nbytes_}, use_ {other.use_}
+  {
+    other.data_ = nullptr;
+    other.nbytes_ = 0;
+  }
+
+  PageBuffer& operator=(PageBuffer&& other) noexcept
+  {
+    if (this != &other) {
+      if (data_)
+        free_pages(data_, nbytes_, use_);
+      data_ = other.data_;
+      nbytes_ = other.nbytes_;
+      use_ = other.use_;
+      other.data_ = nullptr;
+      other.nbytes_ = 0;
+    }
+    return *this;
+  }
+
+  void* data() const { return data_; }
+  size_t nbytes() const { return nbytes_; }
+
+private:
+  void* data_ {nullptr};                  //!< Start of the block
+  size_t nbytes_ {0};                     //!< Size of the block in bytes
+  PageUse use_ {PageUse::CROSS_SECTIONS}; //!< Kind of data in the block
+};
+
+//==============================================================================
+//! Standard allocator drawing from allocate_pages so that large containers
+//! may be backed by huge pages
+//==============================================================================
+
+template<typename T, PageUse Use>
+class PageAllocator {
+public:
+  using value_type = T;
+
+  template<typename U>
+  struct rebind {
+    using other = PageAllocator<U, Use>;
+  };
+
+  PageAllocator() = default;
+  template<typename U>
+  PageAllocator(const PageAllocator<U, Use>&)
+  {}
+
+  T* allocate(size_t n)
+  {
+    return static_cast<T*>(allocate_pages(n * sizeof(T), Use));
+  }
+  void deallocate(T* ptr, size_t n) { free_pages(ptr, n * sizeof(T), Use); }
+
+  template<typename U>
+  bool operator==(const PageAllocator<U, Use>&) const
+  {
+    return true;
+  }
+  template<typename U>
+  bool operator!=(const PageAllocator<U, Use>&) const
+  {
+    return false;
+  }
+};
+
+} // namespace openmc
+
+#endif // OPENMC_HUGE_PAGES_H
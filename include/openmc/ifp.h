@@ -0,0 +1,80 @@
+#ifndef OPENMC_IFP_H
+#define OPENMC_IFP_H
+
+//! \file ifp.h
+//! \brief Iterated fission probability tallies of kinetics parameters
+
+#include <cstdint> // for int64_t
+
+#include "openmc/particle.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+
+//==============================================================================
+//! Ancestor of a source site, used to weight scores by the iterated fission
+//! probability of the ancestor some number of generations back
+//! NOTE: This structure's MPI type is built in initialize_mpi() of
+//! initialize.cpp.
+//==============================================================================
+
+struct IfpAncestor {
+  //! Time from the birth of the ancestor's parent until the fission that
+  //! produced the ancestor in [s]
+  float lifetime {0.0};
+  //! Delayed group the ancestor was born in, or 0 if it was born prompt
+  int delayed_group {0};
+};
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace simulation {
+
+//! Ancestors of each site of the source bank, allocated only when iterated
+//! fission probability tallies are used. Each site has
+//! settings::ifp_n_generation consecutive entries, oldest first, of which the
+//! first ifp_n_ancestors are known.
+extern vector<IfpAncestor> ifp_source_bank;
+
+//! Number of ancestors known for every source site. All sites gain one each
+//! generation until settings::ifp_n_generation are kept.
+extern int ifp_n_ancestors;
+
+} // namespace simulation
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Allocate ancestors for every site of the source bank, none of which are
+//! known yet
+void init_ifp_source_bank();
+
+//! Append the ancestors of a fission site, which are those of the source site
+//! its parent was born from followed by the fission that produced it. A
+//! fission site holds no ancestors of its own, so this must be called before
+//! the source bank is replaced by synchronize_bank().
+//
+//! \param[in] site Site of the fission bank
+//! \param[inout] ancestry Ancestors of sampled sites, to which
+//!   settings::ifp_n_generation entries are appended
+void ifp_fission_ancestry(
+  const SourceSite& site, vector<IfpAncestor>& ancestry);
+
+//! Mark the ancestors of the sites of a new source bank, appended by
+//! ifp_fission_ancestry(), as known for one more generation
+void ifp_next_generation();
+
+//! Score of an iterated fission probability tally for a collision
+//
+//! \param[in] p Particle that collided
+//! \param[in] score_bin One of SCORE_IFP_TIME_NUM, SCORE_IFP_BETA_NUM, or
+//!   SCORE_IFP_DENOM
+//! \return Score before filter weights are applied
+double score_ifp(const Particle& p, int score_bin);
+
+} // namespace openmc
+
+#endif // OPENMC_IFP_H
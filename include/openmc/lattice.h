@@ -24,6 +24,8 @@ constexpr int32_t NO_OUTER_UNIVERSE {-1};
 
 enum class LatticeType { rect, hex };
 
+class LocalCoord;
+
 //==============================================================================
 // Global variables
 //==============================================================================
@@ -73,9 +75,17 @@ public:
     offsets_.resize(n_maps * universes_.size(), C_NONE);
   }
 
+  //! Memory held by the lattice's universes and offsets in [bytes]
+  size_t memory_usage() const
+  {
+    return sizeof(int32_t) * (universes_.size() + offsets_.size());
+  }
+
   //! Populate the distribcell offset tables.
-  int32_t fill_offset_table(int32_t offset, int32_t target_univ_id, int map,
-    std::unordered_map<int32_t, int32_t>& univ_count_memo);
+  //! \param univ_counts The number of instances of the map's target universe
+  //!   contained in each universe, indexed by universe
+  int32_t fill_offset_table(
+    int32_t offset, int map, const vector<int32_t>& univ_counts);
 
   //! \brief Check lattice indices.
   //! \param i_xyz[3] The indices for a lattice tile.
@@ -213,6 +223,32 @@ public:
   std::pair<double, array<int, 3>> distance(
     Position r, Direction u, const array<int, 3>& i_xyz) const;
 
+  //! \brief Find the next lattice surface crossing like distance(), using
+  //! the per-axis distances to the next tile boundary kept in the coordinate
+  //! level.
+  //!
+  //! The distances are computed from scratch only when the direction of the
+  //! coordinate level has changed.  Otherwise they are kept up to date as the
+  //! particle moves and crosses tiles, as in a digital differential analyzer.
+  //! \param coord The coordinate level of the particle in this lattice
+  //! \return The distance to the next crossing and the lattice translation
+  std::pair<double, array<int, 3>> distance_dda(LocalCoord& coord) const;
+
+  //! Update the per-axis distances of a coordinate level after moving into
+  //! the next tile
+  //! \param coord The coordinate level of the particle in this lattice
+  //! \param translation The change in lattice indices
+  void cross_dda(LocalCoord& coord, const array<int, 3>& translation) const;
+
+  //! Get the local position in the tile entered after crossing a tile
+  //! boundary, which is the local position in the tile being left shifted by
+  //! whole pitches
+  //! \param r The local position in the tile being left
+  //! \param translation The change in lattice indices
+  //! \return The local position in the tile being entered
+  Position cross_local_position(
+    Position r, const array<int, 3>& translation) const;
+
   void get_indices(Position r, Direction u, array<int, 3>& result) const;
 
   int get_flat_index(const array<int, 3>& i_xyz) const;
@@ -278,11 +314,23 @@ private:
   //! Fill universes_ vector for 'x' orientation
   void fill_lattice_x(const vector<std::string>& univ_words);
 
+  //! Find the radial indices of the tile containing a position by rounding
+  //! its axial coordinates to those of the nearest tile center
+  //! \param r_o Position relative to the lattice center
+  //! \param result Lattice indices, of which the radial ones are set
+  //! \return Whether the position is far enough from the edges of the tile
+  //!   for the result not to depend on the direction
+  template<Orientation O>
+  bool round_indices(Position r_o, array<int, 3>& result) const;
+
   int n_rings_;             //!< Number of radial tile positions
   int n_axial_;             //!< Number of axial tile positions
   Orientation orientation_; //!< Orientation of lattice
   Position center_;         //!< Global center of lattice
   array<double, 2> pitch_;  //!< Lattice tile width and height
+
+  //! Unit normals of the beta, gamma, and delta faces of a tile
+  array<array<double, 2>, 3> face_normals_;
 };
 
 //==============================================================================
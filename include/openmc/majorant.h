@@ -0,0 +1,66 @@
+//! \file majorant.h
+//! \brief Upper bounds on the total cross sections of groups of materials
+
+#ifndef OPENMC_MAJORANT_H
+#define OPENMC_MAJORANT_H
+
+#include <cstdint> // for int32_t
+#include <utility> // for move
+
+#include "openmc/vector.h"
+
+namespace openmc {
+
+//==============================================================================
+//! Upper bound on the total macroscopic cross section of a group of materials.
+//! The bound is stored for each bin of the logarithmic energy grid used for
+//! nuclide energy searches.
+//==============================================================================
+
+class Majorant {
+public:
+  //! \param[in] xs Bound in [1/cm] in each bin of the logarithmic grid
+  explicit Majorant(vector<double> xs) : xs_ {std::move(xs)} {}
+
+  //! Evaluate the majorant cross section
+  //! \param[in] E Neutron energy in [eV]
+  //! \return Majorant cross section in [1/cm]
+  double operator()(double E) const;
+
+private:
+  vector<double> xs_; //!< Bound in [1/cm] in each bin of the logarithmic grid
+};
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace simulation {
+
+extern vector<Majorant> majorants; //!< Distinct majorants computed so far
+extern vector<int> universe_majorant; //!< Index in majorants of each universe
+                                      //!< or C_NONE if it has none yet
+extern int global_majorant; //!< Index in majorants of the bound over all
+                            //!< materials or C_NONE if it has none yet
+
+} // namespace simulation
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Compute the majorants of universes that don't have one yet. Universes
+//! containing the same materials share a majorant.
+//
+//! \param[in] universes Indices of the universes
+void compute_majorants(const vector<int32_t>& universes);
+
+//! Compute the majorant over all materials if it hasn't been computed yet
+void compute_global_majorant();
+
+//! Discard all majorants and the nuclide and material bounds they came from
+void free_memory_majorant();
+
+} // namespace openmc
+
+#endif // OPENMC_MAJORANT_H
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <utility> // for pair
 
 #include "pugixml.hpp"
 #include "xtensor/xtensor.hpp"
@@ -44,6 +45,31 @@ public:
     double fraction;   //!< How often to use table
   };
 
+  //! Union of the energy grids of all nuclides in the material
+  struct UnionGrid {
+    vector<double> energy;  //!< Unionized energy points in [eV]
+    vector<int> grid_index; //!< Union grid index on the logarithmic grid
+    vector<vector<vector<int>>>
+      nuclide_index; //!< Nuclide grid index at each union point, indexed by
+                     //!< [nuclide][temperature][union point]
+  };
+
+  //! Union of the photon energy grids of all elements in the material
+  struct PhotonUnionGrid {
+    vector<double> energy; //!< Unionized log energy points
+    vector<vector<int>>
+      element_index; //!< Element grid index at each union point, indexed by
+                     //!< [nuclide][union point]
+  };
+
+  //! Macroscopic cross sections tabulated on the unionized energy grid at a
+  //! single temperature
+  struct MacroXSTable {
+    vector<int> i_temp;        //!< Temperature index of each nuclide
+    xt::xtensor<double, 2> xs; //!< Total, absorption, fission, and nu-fission
+                               //!< cross sections at each union point
+  };
+
   //----------------------------------------------------------------------------
   // Constructors, destructors, factory functions
   Material() {};
@@ -53,7 +79,35 @@ public:
   //----------------------------------------------------------------------------
   // Methods
 
-  void calculate_xs(Particle& p) const;
+  //! Calculate macroscopic cross sections at the particle's energy
+  //
+  //! \param[in] p Particle
+  //! \param[in] tabulated Whether precomputed macroscopic cross sections may
+  //!   be used, in which case microscopic cross sections are not updated
+  void calculate_xs(Particle& p, bool tabulated = true) const;
+
+  //! Calculate neutron cross sections for a batch of particles in the material
+  //
+  //! Nuclides are processed in the outer loop so that each nuclide's data is
+  //! streamed once for the whole batch.
+  //! \param[in,out] particles Neutrons located in this material. The span
+  //!   may be reordered.
+  void calculate_xs(gsl::span<Particle*> particles) const;
+
+  //! Calculate the microscopic cross sections of one nuclide in the material
+  //! at the particle's energy unless they are already current. This is needed
+  //! when macroscopic cross sections came from a table.
+  //
+  //! \param[in] p Particle
+  //! \param[in] i Index in nuclide_
+  void calculate_nuclide_xs(Particle& p, int i) const;
+
+  //! Find the tabulated macroscopic cross sections that apply to a particle
+  //
+  //! \param[in] p Particle in this material
+  //! \return Index in macro_xs_tables_, or C_NONE if no table applies to the
+  //!   particle's energy and temperature or tables can't be used
+  int macro_xs_table(const Particle& p) const;
 
   //! Assign thermal scattering tables to specific nuclides within the material
   //! so the code knows when to apply bound thermal scattering data
@@ -62,17 +116,32 @@ public:
   //! Set up mapping between global nuclides vector and indices in nuclide_
   void init_nuclide_index();
 
+  //! Build unionized energy grid and per-nuclide index maps
+  //! \return Memory used by the unionized grid in [bytes]
+  size_t init_union_grid();
+
+  //! Build unionized photon energy grid and per-element index maps
+  //! \return Memory used by the unionized grid in [bytes]
+  size_t init_photon_union_grid();
+
+  //! Tabulate macroscopic cross sections on the unionized energy grid for
+  //! each temperature of cells containing the material
+  //! \return Memory used by the tables in [bytes]
+  size_t init_macro_xs_tables();
+
+  //! Memory held by the unionized energy grids and macroscopic cross section
+  //! tables
+  //! \return Memory in [bytes]
+  size_t memory_usage() const;
+
   //! Finalize the material, assigning tables, normalize density, etc.
   void finalize();
 
   //! Write material data to HDF5
   void to_hdf5(hid_t group) const;
 
-  //! Export physical properties to HDF5
-  //! \param[in] group  HDF5 group to write to
-  void export_properties_hdf5(hid_t group) const;
-
-  //! Import physical properties from HDF5
+  //! Import physical properties from an HDF5 properties file written before
+  //! version 2.0 of the format
   //! \param[in] group  HDF5 group to read from
   void import_properties_hdf5(hid_t group);
 
@@ -89,6 +158,17 @@ public:
   void set_densities(
     const vector<std::string>& name, const vector<double>& density);
 
+  //! Overwrite atom densities of nuclides already in the material
+  //
+  //! Nuclides in the material that are not given are set to zero density. The
+  //! nuclides, thermal tables, and unionized grids are kept as they are.
+  //! \param[in] nuclide Index in data::nuclides of each nuclide
+  //! \param[in] density Density of each nuclide in [atom/b-cm]
+  //! \return Whether the densities were updated, which requires every nuclide
+  //!   with nonzero density to be in the material already
+  bool update_densities(
+    gsl::span<const int> nuclide, gsl::span<const double> density);
+
   //----------------------------------------------------------------------------
   // Accessors
 
@@ -164,6 +244,7 @@ public:
   bool fissionable_ {
     false};                 //!< Does this material contain fissionable nuclides
   bool depletable_ {false}; //!< Is the material depletable?
+  bool tabulate_xs_ {false}; //!< Tabulate macroscopic cross sections?
   vector<bool> p0_;         //!< Indicate which nuclides are to be treated with
                             //!< iso-in-lab scattering
 
@@ -176,6 +257,20 @@ public:
   // Thermal scattering tables
   vector<ThermalTable> thermal_tables_;
 
+  // Unionized energy grid (only allocated when settings::union_grid is on or
+  // macroscopic cross sections are tabulated)
+  UnionGrid union_grid_;
+
+  // Unionized photon energy grid (only allocated for photon transport)
+  PhotonUnionGrid photon_union_grid_;
+
+  // Tabulated macroscopic cross sections and the energy ranges over which they
+  // cannot be used (S(a,b), probability tables, windowed multipole)
+  vector<MacroXSTable> macro_xs_tables_;
+  vector<int> macro_xs_table_index_; //!< Table for each temperature in
+                                     //!< data::cell_sqrtkT, or C_NONE
+  vector<std::pair<double, double>> macro_xs_excluded_;
+
   unique_ptr<Bremsstrahlung> ttb_;
 
 private:
@@ -188,10 +283,42 @@ private:
   //! Initialize bremsstrahlung data
   void init_bremsstrahlung();
 
+  //! Initialize condensed history data, which requires normalized densities
+  void init_condensed_history();
+
   //! Normalize density
   void normalize_density();
 
-  void calculate_neutron_xs(Particle& p) const;
+  //! Set up the unionized energy grids again after the nuclides have changed
+  //! so that a simulation that set them up keeps using them
+  //
+  //! \param[in] neutron Whether the neutron grid had been set up
+  //! \param[in] photon Whether the photon grid had been set up
+  void rebuild_union_grids(bool neutron, bool photon);
+
+  void calculate_neutron_xs(Particle& p, bool tabulated) const;
+
+  //! Calculate microscopic cross sections of a nuclide unless they are current
+  //
+  //! \param[in] p Particle
+  //! \param[in] i Index in nuclide_
+  //! \param[in] i_sab Index in data::thermal_scatt or C_NONE
+  //! \param[in] sab_frac Fraction of the nuclide bound by the S(a,b) table
+  //! \param[in] i_grid Index on the logarithmic energy grid
+  //! \param[in] i_union Index on the unionized grid or C_NONE
+  void update_nuclide_xs(Particle& p, int i, int i_sab, double sab_frac,
+    int i_grid, int i_union) const;
+
+  //! Look up tabulated macroscopic cross sections
+  //! \return Whether a table applied to the particle's energy and temperature
+  bool calculate_tabulated_xs(Particle& p) const;
+
+  //! Determine index of an energy on the unionized energy grid
+  //
+  //! \param[in] E Energy in [eV]
+  //! \param[in] i_log_union Index on the logarithmic energy grid
+  //! \return Index of the union grid interval containing E
+  int union_grid_index(double E, int i_log_union) const;
   void calculate_photon_xs(Particle& p) const;
 
   //----------------------------------------------------------------------------
@@ -218,6 +345,17 @@ double density_effect(const vector<double>& f, const vector<double>& e_b_sq,
   double e_p_sq, double n_conduction, double rho, double E, double tol,
   int max_iter);
 
+//! Calculate the ratio of the radiative stopping powers of positrons and
+//! electrons
+//! \param E Kinetic energy of the charged particle in [eV]
+//! \param Z_eq_sq Square of the equivalent atomic number of the material
+double positron_radiative_ratio(double E, double Z_eq_sq);
+
+//! Calculate the contribution of an element to the inverse radiation length
+//! from Tsai's formula, in units of 4 alpha r_e^2 per atom
+//! \param Z Atomic number
+double radiation_length_factor(int Z);
+
 //! Read material data from materials.xml
 void read_materials_xml();
 
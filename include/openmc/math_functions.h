@@ -44,6 +44,29 @@ extern "C" double t_percentile(double p, int df);
 
 extern "C" void calc_pn_c(int n, double x, double pnx[]);
 
+//==============================================================================
+//! Calculate the Legendre polynomials up to a fixed order at the value of x.
+//!
+//! Since the order is known at compile time, the recursion is fully unrolled.
+//!
+//! \tparam N The maximum order requested
+//! \param x   The value to evaluate at; x is expected to be within [-1,1]
+//! \param pnx The requested Legendre polynomials of order 0 to N (inclusive)
+//!   evaluated at x.
+//==============================================================================
+
+template<int N>
+inline void calc_pn(double x, double pnx[])
+{
+  pnx[0] = 1.;
+  if (N >= 1) {
+    pnx[1] = x;
+  }
+  for (int l = 1; l < N; l++) {
+    pnx[l + 1] = ((2 * l + 1) * x * pnx[l] - l * pnx[l - 1]) / (l + 1);
+  }
+}
+
 //==============================================================================
 //! Find the value of f(x) given a set of Legendre coefficients and the value
 //! of x.
@@ -0,0 +1,67 @@
+#ifndef OPENMC_MEMORY_USAGE_H
+#define OPENMC_MEMORY_USAGE_H
+
+//! \file memory_usage.h
+//! \brief Accounting of the memory held by each subsystem
+
+#include <cstddef> // for size_t
+
+namespace openmc {
+
+//==============================================================================
+// Constants
+//==============================================================================
+
+// Subsystems whose memory is accounted for. The order matches the values
+// returned by openmc_memory_usage().
+enum class MemoryUse {
+  NUCLIDES,  //!< Nuclide cross sections, energy grids, and resonance data
+  THERMAL,   //!< Thermal scattering tables
+  MATERIALS, //!< Unionized energy grids and tabulated macroscopic data
+  GEOMETRY,  //!< Cells, universes, lattices, and neighbor lists
+  TALLIES,   //!< Tally results, including thread-private and sparse results
+  BANKS,     //!< Source, fission, and surface source banks
+  PARTICLES  //!< Particles in flight and their cross section caches
+};
+
+constexpr int N_MEMORY_USES {7};
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Measure the memory held by each subsystem on this process and raise the
+//! high-water mark of any subsystem that has grown since the last measurement.
+//! Each subsystem reports the size of the containers that it owns, so memory
+//! held by the allocator or by libraries is not included.
+void update_memory_usage();
+
+//! Memory held by a subsystem as of the last call to update_memory_usage()
+//
+//! \param[in] use Subsystem
+//! \return Memory in [bytes]
+size_t memory_usage(MemoryUse use);
+
+//! Largest memory held by a subsystem in any call to update_memory_usage()
+//
+//! \param[in] use Subsystem
+//! \return Memory in [bytes]
+size_t peak_memory_usage(MemoryUse use);
+
+//! Largest resident set size of this process since it started, as reported
+//! by the operating system, or zero where it is not available
+//
+//! \return Memory in [bytes]
+size_t peak_resident_memory();
+
+//! Display the memory held by each subsystem on the process that uses the
+//! most of it, along with the memory of each nuclide at each temperature at
+//! high verbosity. This must be called on all processes.
+void print_memory_usage();
+
+//! Clear the memory measured for each subsystem and its high-water mark
+void reset_memory_usage();
+
+} // namespace openmc
+
+#endif // OPENMC_MEMORY_USAGE_H
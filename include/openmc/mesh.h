@@ -4,15 +4,18 @@
 #ifndef OPENMC_MESH_H
 #define OPENMC_MESH_H
 
+#include <array>
 #include <unordered_map>
 
 #include "hdf5.h"
 #include "pugixml.hpp"
 #include "xtensor/xtensor.hpp"
+#include <gsl/gsl-lite.hpp>
 
 #include "openmc/memory.h" // for unique_ptr
 #include "openmc/particle.h"
 #include "openmc/position.h"
+#include "openmc/tallies/bin_lookup.h"
 #include "openmc/vector.h"
 
 #ifdef DAGMC
@@ -96,6 +99,13 @@ public:
   //! Get the number of mesh cells.
   virtual int n_bins() const = 0;
 
+  //! Sample a position uniformly in a mesh element
+  //
+  //! \param[in] bin Mesh bin to sample in
+  //! \param[inout] seed Pseudorandom seed pointer
+  //! \return Sampled position
+  virtual Position sample_element(int bin, uint64_t* seed) const;
+
   //! Get the number of mesh cell surfaces.
   virtual int n_surface_bins() const = 0;
 
@@ -175,6 +185,14 @@ public:
   void raytrace_mesh(
     Position r0, Position r1, const Direction& u, T tally) const;
 
+  //! Get the distance to the next boundary of the mesh bin that contains a
+  //! position, or to where a position outside the mesh may enter it
+  //
+  //! \param[in] r Position
+  //! \param[in] u Direction of flight
+  //! \return Distance along the direction, or INFTY if no boundary is crossed
+  double distance_to_bin_boundary(Position r, const Direction& u) const;
+
   //! Count number of bank sites in each mesh bin / energy bin
   //
   //! \param[in] Pointer to bank sites
@@ -236,6 +254,14 @@ public:
   std::array<int, 3> shape_; //!< Number of mesh elements in each dimension
 
 protected:
+  //! Determine whether a track starts and ends in the same mesh element. For
+  //! meshes whose elements are convex, such a track crosses no surfaces.
+  //
+  //! \param[in] r0 Previous position of the particle
+  //! \param[in] r1 Current position of the particle
+  //! \param[in] u Particle direction
+  //! \return Whether both ends of the track are in the same element
+  bool within_element(Position r0, Position r1, const Direction& u) const;
 };
 
 //==============================================================================
@@ -249,6 +275,8 @@ public:
   RegularMesh(pugi::xml_node node);
 
   // Overridden methods
+  Position sample_element(int bin, uint64_t* seed) const override;
+
   int get_index_in_direction(double r, int i) const override;
 
   virtual std::string get_mesh_type() const override;
@@ -258,6 +286,20 @@ public:
   MeshDistance distance_to_grid_boundary(const MeshIndex& ijk, int i,
     const Position& r0, const Direction& u, double l) const override;
 
+  //! Determine which bins were crossed by a particle.
+  //
+  //! Since the mesh spacing is constant along each axis, the distances to
+  //! the next grid plane are computed directly rather than through the
+  //! general mesh raytracing, and tracks that stay within a single bin are
+  //! handled without any distance calculations.
+  void bins_crossed(Position r0, Position r1, const Direction& u,
+    vector<int>& bins, vector<double>& lengths) const override;
+
+  //! Determine which surface bins were crossed by a particle, skipping the
+  //! raytracing for tracks that stay within a single element
+  void surface_bins_crossed(Position r0, Position r1, const Direction& u,
+    vector<int>& bins) const override;
+
   std::pair<vector<double>, vector<double>> plot(
     Position plot_ll, Position plot_ur) const override;
 
@@ -296,6 +338,8 @@ public:
   RectilinearMesh(pugi::xml_node node);
 
   // Overridden methods
+  Position sample_element(int bin, uint64_t* seed) const override;
+
   int get_index_in_direction(double r, int i) const override;
 
   virtual std::string get_mesh_type() const override;
@@ -305,6 +349,11 @@ public:
   MeshDistance distance_to_grid_boundary(const MeshIndex& ijk, int i,
     const Position& r0, const Direction& u, double l) const override;
 
+  //! Determine which surface bins were crossed by a particle, skipping the
+  //! raytracing for tracks that stay within a single element
+  void surface_bins_crossed(Position r0, Position r1, const Direction& u,
+    vector<int>& bins) const override;
+
   std::pair<vector<double>, vector<double>> plot(
     Position plot_ll, Position plot_ur) const override;
 
@@ -335,6 +384,8 @@ public:
   CylindricalMesh(pugi::xml_node node);
 
   // Overridden methods
+  Position sample_element(int bin, uint64_t* seed) const override;
+
   virtual MeshIndex get_indices(Position r, bool& in_mesh) const override;
 
   int get_index_in_direction(double r, int i) const override;
@@ -365,6 +416,13 @@ private:
 
   bool full_phi_ {false};
 
+  // Tables derived from the grids by set_grid() so that the indices of a point
+  // are found without inverse trigonometric functions
+  array<BinLookup, 3> lookup_; //!< Direct lookup of equally spaced r and z
+  vector<double> phi_key_;     //!< azimuthal_key() of each phi grid value
+  vector<double> phi_cos_;     //!< Cosine of each phi grid value
+  vector<double> phi_sin_;     //!< Sine of each phi grid value
+
   constexpr inline int sanitize_angular_index(int idx, bool full, int N) const
   {
     if ((idx > 0) and (idx <= N)) {
@@ -389,6 +447,8 @@ public:
   SphericalMesh(pugi::xml_node node);
 
   // Overridden methods
+  Position sample_element(int bin, uint64_t* seed) const override;
+
   virtual MeshIndex get_indices(Position r, bool& in_mesh) const override;
 
   int get_index_in_direction(double r, int i) const override;
@@ -420,6 +480,15 @@ private:
   bool full_theta_ {false};
   bool full_phi_ {false};
 
+  // Tables derived from the grids by set_grid() so that the indices of a point
+  // are found without inverse trigonometric functions
+  array<BinLookup, 3> lookup_; //!< Direct lookup of equally spaced r
+  vector<double> theta_key_;   //!< 1 - cos(theta) of each theta grid value
+  vector<double> theta_cos_;   //!< Cosine of each theta grid value
+  vector<double> phi_key_;     //!< azimuthal_key() of each phi grid value
+  vector<double> phi_cos_;     //!< Cosine of each phi grid value
+  vector<double> phi_sin_;     //!< Sine of each phi grid value
+
   constexpr inline int sanitize_angular_index(int idx, bool full, int N) const
   {
     if ((idx > 0) and (idx <= N)) {
@@ -469,10 +538,15 @@ public:
   //! Remove tally data from the instance
   virtual void remove_scores() = 0;
 
-  //! Set the value of a bin for a variable on the internal
-  //  mesh instance
-  virtual void set_score_data(const std::string& var_name,
-    const vector<double>& values, const vector<double>& std_dev) = 0;
+  //! Set the values of a variable for a contiguous range of bins on the
+  //! internal mesh instance
+  //
+  //! \param[in] var_name Name of the variable
+  //! \param[in] offset Index of the first bin in the range
+  //! \param[in] values Values for each bin in the range
+  //! \param[in] std_dev Standard deviations for each bin in the range
+  virtual void set_score_data(const std::string& var_name, int offset,
+    gsl::span<const double> values, gsl::span<const double> std_dev) = 0;
 
   //! Write the unstructured mesh to file
   //
@@ -548,9 +622,9 @@ public:
   //! Remove all scores from the mesh instance
   void remove_scores() override;
 
-  //! Set data for a score
-  void set_score_data(const std::string& score, const vector<double>& values,
-    const vector<double>& std_dev) override;
+  //! Set data for a score over a range of bins
+  void set_score_data(const std::string& score, int offset,
+    gsl::span<const double> values, gsl::span<const double> std_dev) override;
 
   //! Write the mesh with any current tally data
   void write(const std::string& base_filename) const override;
@@ -608,6 +682,22 @@ private:
   //! \param[in] tets MOAB Range of tetrahedral elements
   void compute_barycentric_data(const moab::Range& tets);
 
+  //! Find the neighbor of each tetrahedron across the face opposite each of
+  //! its vertices.
+  //
+  //! \param[in] tets MOAB Range of tetrahedral elements
+  void compute_neighbors(const moab::Range& tets);
+
+  //! Walk through neighboring tetrahedra toward a position, moving across the
+  //! face with the most negative barycentric coordinate at each step.
+  //
+  //! \param[in] r Position to find
+  //! \param[in] tet MOAB tetrahedron to start from
+  //! \return MOAB EntityHandle of the tet containing r, or 0 if it was not
+  //!   found within MAX_WALK_STEPS steps or the walk left the mesh
+  moab::EntityHandle walk_to_tet(
+    const moab::CartVect& r, moab::EntityHandle tet) const;
+
   //! Translate a MOAB EntityHandle to its corresponding bin.
   //
   //! \param[in] eh MOAB EntityHandle to translate
@@ -661,6 +751,17 @@ private:
   unique_ptr<moab::AdaptiveKDTree> kdtree_; //!< MOAB KDTree instance
   vector<moab::Matrix3> baryc_data_;        //!< Barycentric data for tetrahedra
   vector<std::string> tag_names_; //!< Names of score tags added to the mesh
+
+  //! Bin of the neighbor across the face opposite each vertex of each
+  //! tetrahedron, or -1 on the mesh boundary
+  vector<std::array<int, 4>> tet_neighbors_;
+
+  //! Last tetrahedron found by each thread, or 0 if there is none
+  mutable vector<moab::EntityHandle> last_tet_;
+
+  //! Maximum number of tetrahedra visited when walking from the last
+  //! tetrahedron found before falling back to the KDTree
+  static constexpr int MAX_WALK_STEPS {8};
 };
 
 #endif
@@ -694,8 +795,8 @@ public:
 
   void remove_scores() override;
 
-  void set_score_data(const std::string& var_name, const vector<double>& values,
-    const vector<double>& std_dev) override;
+  void set_score_data(const std::string& var_name, int offset,
+    gsl::span<const double> values, gsl::span<const double> std_dev) override;
 
   void write(const std::string& base_filename) const override;
 
@@ -718,6 +819,8 @@ private:
   unique_ptr<libMesh::Mesh> m_; //!< pointer to the libMesh mesh instance
   vector<unique_ptr<libMesh::PointLocatorBase>>
     pl_; //!< per-thread point locators
+  mutable vector<const libMesh::Elem*>
+    last_elem_; //!< last element found by each thread
   unique_ptr<libMesh::EquationSystems>
     equation_systems_; //!< pointer to the equation systems of the mesh
   std::string
@@ -746,6 +849,15 @@ void read_meshes(pugi::xml_node root);
 //! \param[in] group HDF5 group
 void meshes_to_hdf5(hid_t group);
 
+//! Get the bin of a mesh that contains a position, reusing the last bin found
+//! for a particle if it was for the same mesh and position
+//
+//! \param[in] p Particle whose mesh bin cache is used
+//! \param[in] i_mesh Index of the mesh
+//! \param[in] r Position in the mesh
+//! \return Bin of the mesh, or -1 if the position is outside of it
+int get_mesh_bin(const Particle& p, int32_t i_mesh, Position r);
+
 void free_memory_mesh();
 
 } // namespace openmc
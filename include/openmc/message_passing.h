@@ -5,18 +5,84 @@
 #include <mpi.h>
 #endif
 
+#include "openmc/vector.h"
+
 namespace openmc {
 namespace mpi {
 
 extern int rank;
 extern int n_procs;
 extern bool master;
+extern int node_rank;   //!< Rank among the processes on this node
+extern int n_procs_node; //!< Number of processes on this node
+extern bool thread_multiple; //!< Can any thread make MPI calls?
 
 #ifdef OPENMC_MPI
 extern MPI_Datatype source_site;
+extern MPI_Datatype compact_source_site;
+extern MPI_Datatype ifp_ancestry;
 extern MPI_Comm intracomm;
+extern MPI_Comm node_intracomm; //!< Processes that share memory on this node
+extern MPI_Comm
+  leader_intracomm; //!< Lowest-ranked process on each node, null elsewhere
+
+//! Sum values over all processes in place.
+//!
+//! Values are first combined among the processes on each node through shared
+//! memory and then across nodes by the node leaders, so the number of
+//! messages between nodes scales with the number of nodes rather than the
+//! number of processes.
+//! \param[inout] buffer Values to sum
+//! \param count Number of elements of the given type in the buffer
+//! \param type Datatype of the elements, which must be made up of doubles
+//! \param all Whether all processes receive the sum, or only the master. On
+//!   other processes the buffer is left with partial sums.
+void reduce_sum(void* buffer, int count, MPI_Datatype type, bool all);
 #endif
 
+//==============================================================================
+//! Values summed over all processes at the end of each generation in a single
+//! non-blocking reduction, rather than in one collective per value.
+//!
+//! A subsystem adds its values once and sets them each generation before the
+//! reduction is started. The sums are available on all processes once the
+//! reduction completes, which get() waits for.
+//==============================================================================
+
+class GenerationSums {
+public:
+  //! Add a value to the sums
+  //! \return Index of the value
+  int add();
+
+  //! Set the value on this process for the next reduction
+  void set(int i, double value) { local_[i] = value; }
+
+  //! Start summing the values over all processes
+  void start();
+
+  //! Get the sum of a value over all processes, waiting for the reduction
+  double get(int i);
+
+private:
+  vector<double> local_; //!< Values on this process
+  vector<double> sum_;   //!< Values summed over all processes
+#ifdef OPENMC_MPI
+  MPI_Request request_ {MPI_REQUEST_NULL}; //!< Request of the reduction
+#endif
+};
+
+extern GenerationSums generation_sums;
+
+//! Start a thread that makes MPI progress on the non-blocking communication
+//! in flight while the other threads transport particles. The thread probes
+//! for messages at a fixed interval, which drives the progress engine of most
+//! MPI implementations. It requires MPI_THREAD_MULTIPLE.
+void start_progress_thread();
+
+//! Stop the thread started by start_progress_thread(), if any
+void stop_progress_thread();
+
 } // namespace mpi
 } // namespace openmc
 
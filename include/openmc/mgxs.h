@@ -30,6 +30,16 @@ struct CacheData {
   double w;
 };
 
+//==============================================================================
+// Cross sections needed for tracking in a single group
+//==============================================================================
+
+struct TrackingXs {
+  double total;
+  double absorption;
+  double nu_fission; // zero if the data is not fissionable
+};
+
 //==============================================================================
 // MGXS contains the mgxs data for a nuclide/material
 //==============================================================================
@@ -48,6 +58,10 @@ private:
   int n_azi;
   vector<double> polar;
   vector<double> azimuthal;
+  // Total, absorption, and nu-fission cross sections for each temperature,
+  // angle, and group, flattened so that a lookup reads one contiguous entry
+  vector<TrackingXs> tracking_xs;
+  int n_tracking_angles; // number of angles in tracking_xs
 
   //! \brief Initializes the Mgxs object metadata
   //!
@@ -95,6 +109,10 @@ private:
   //! @return True if they can be combined, False otherwise.
   bool equiv(const Mgxs& that);
 
+  //! \brief Fills the flattened table of cross sections used for tracking
+  //!   from the XsData for each temperature.
+  void build_tracking_xs();
+
 public:
   std::string name;        // name of dataset, e.g., UO2
   double awr;              // atomic weight ratio
@@ -4,7 +4,10 @@
 #ifndef OPENMC_MGXS_INTERFACE_H
 #define OPENMC_MGXS_INTERFACE_H
 
+#include <mutex> // for call_once, once_flag
+
 #include "openmc/hdf5_interface.h"
+#include "openmc/memory.h"
 #include "openmc/mgxs.h"
 #include "openmc/vector.h"
 
@@ -40,9 +43,20 @@ public:
   // min & max energies as well as the available XS
   void read_header(const std::string& path_cross_sections);
 
-  // Calculate microscopic cross sections from nuclide macro XS
+  // Calculate microscopic cross sections from nuclide macro XS. Unless
+  // nuclide temperatures are loaded lazily, those of every material are
+  // built here in parallel; otherwise each is built on first use.
   void create_macro_xs();
 
+  // Get the macroscopic cross sections of a material, building them if they
+  // have not been built yet. This is safe to call from multiple threads.
+  Mgxs& macro_xs(int i_mat)
+  {
+    std::call_once(
+      macro_init_[i_mat], [this, i_mat] { this->build_macro_xs(i_mat); });
+    return macro_xs_[i_mat];
+  }
+
   // Get the kT values which are used in the OpenMC model
   vector<vector<double>> get_mat_kTs();
 
@@ -58,6 +72,13 @@ public:
   vector<double> energy_bin_avg_;
   vector<double> rev_energy_bins_;
   vector<vector<double>> nuc_temps_; // all available temperatures
+
+private:
+  // Combine the nuclide data of a material into its macroscopic data
+  void build_macro_xs(int i_mat);
+
+  vector<vector<double>> mat_kTs_;         // temperatures of each material
+  unique_ptr<std::once_flag[]> macro_init_; // whether macro_xs_ is built
 };
 
 namespace data {
@@ -1,64 +1,162 @@
 #ifndef OPENMC_NEIGHBOR_LIST_H
 #define OPENMC_NEIGHBOR_LIST_H
 
-#include <algorithm>
+#include <atomic>
+#include <cstddef> // for size_t
 #include <cstdint>
-#include <forward_list>
-#include <mutex>
 
-#include "openmc/openmp_interface.h"
+#include "openmc/constants.h"
 
 namespace openmc {
 
 //==============================================================================
 //! A threadsafe, dynamic container for listing neighboring cells.
 //
-//! This container is a reduced interface for a linked list with an added OpenMP
-//! lock for write operations.  It allows for threadsafe dynamic growth; any
-//! number of threads can safely read data without locks or reference counting.
+//! Elements are stored in fixed-size chunks of atomic slots.  The first chunk
+//! lives inside the list itself, and further chunks are chained on as the list
+//! grows.  Each slot is written exactly once, by a compare-and-swap that claims
+//! the first empty slot, so elements can be appended without locks and any
+//! number of threads can safely read data while others append.
 //==============================================================================
 
 class NeighborList {
 public:
   using value_type = int32_t;
-  using const_iterator = std::forward_list<value_type>::const_iterator;
 
-  // Attempt to add an element.
+  //! Number of elements per chunk
+  static constexpr int CHUNK_SIZE {8};
+
+private:
+  struct Chunk {
+    Chunk()
+    {
+      for (auto& slot : slots)
+        slot.store(C_NONE, std::memory_order_relaxed);
+    }
+
+    std::atomic<value_type> slots[CHUNK_SIZE]; //!< Elements, C_NONE if empty
+    std::atomic<Chunk*> next {nullptr};        //!< Next chunk, if any
+  };
+
+public:
+  //! Iterator over the elements in the order they were added
+  class const_iterator {
+  public:
+    const_iterator() = default;
+    const_iterator(const Chunk* chunk, int i) : chunk_ {chunk}, i_ {i}
+    {
+      this->check_end();
+    }
+
+    value_type operator*() const { return value_; }
+
+    const_iterator& operator++()
+    {
+      if (++i_ == CHUNK_SIZE) {
+        chunk_ = chunk_->next.load(std::memory_order_acquire);
+        i_ = 0;
+      }
+      this->check_end();
+      return *this;
+    }
+
+    bool operator==(const const_iterator& other) const
+    {
+      return chunk_ == other.chunk_ && i_ == other.i_;
+    }
+
+    bool operator!=(const const_iterator& other) const
+    {
+      return !(*this == other);
+    }
+
+  private:
+    //! Read the current element, becoming the end iterator if there is none
+    void check_end()
+    {
+      if (chunk_) {
+        value_ = chunk_->slots[i_].load(std::memory_order_acquire);
+        if (value_ != C_NONE)
+          return;
+      }
+      chunk_ = nullptr;
+      i_ = 0;
+    }
+
+    const Chunk* chunk_ {nullptr};
+    int i_ {0};
+    value_type value_ {C_NONE};
+  };
+
+  NeighborList() = default;
+
+  ~NeighborList()
+  {
+    Chunk* chunk = head_.next.load(std::memory_order_relaxed);
+    while (chunk) {
+      Chunk* next = chunk->next.load(std::memory_order_relaxed);
+      delete chunk;
+      chunk = next;
+    }
+  }
+
+  // The list owns its overflow chunks, so it cannot be copied.
+  NeighborList(const NeighborList&) = delete;
+  NeighborList& operator=(const NeighborList&) = delete;
+
+  //! Add an element unless it is already in the list.
   //
-  // If the relevant OpenMP lock is currently owned by another thread, this
-  // function will return without actually modifying the data.  It has been
-  // found that returning the transport calculation and possibly re-adding the
-  // element later is slightly faster than waiting on the lock to be released.
-  void push_back(int new_elem)
+  //! It is possible another thread already added this element to the list
+  //! while this thread was searching for a cell, so the existing elements are
+  //! checked before each empty slot is claimed.
+  void push_back(value_type new_elem)
   {
-    // Try to acquire the lock.
-    std::unique_lock<OpenMPMutex> lock(mutex_, std::try_to_lock);
-    if (lock) {
-      // It is possible another thread already added this element to the list
-      // while this thread was searching for a cell so make sure the given
-      // element isn't a duplicate before adding it.
-      if (std::find(list_.cbegin(), list_.cend(), new_elem) == list_.cend()) {
-        // Find the end of the list and add the the new element there.
-        if (!list_.empty()) {
-          auto it1 = list_.cbegin();
-          auto it2 = ++list_.cbegin();
-          while (it2 != list_.cend())
-            it1 = it2++;
-          list_.insert_after(it1, new_elem);
+    Chunk* chunk = &head_;
+    while (true) {
+      for (auto& slot : chunk->slots) {
+        value_type elem = slot.load(std::memory_order_acquire);
+        if (elem == C_NONE) {
+          // Claim the empty slot.  If another thread claimed it first, elem
+          // is updated to the value that thread stored.
+          if (slot.compare_exchange_strong(elem, new_elem,
+                std::memory_order_acq_rel, std::memory_order_acquire))
+            return;
+        }
+        if (elem == new_elem)
+          return;
+      }
+
+      // This chunk is full, so move on to the next one, adding it if needed
+      Chunk* next = chunk->next.load(std::memory_order_acquire);
+      if (!next) {
+        Chunk* new_chunk = new Chunk;
+        if (chunk->next.compare_exchange_strong(next, new_chunk,
+              std::memory_order_acq_rel, std::memory_order_acquire)) {
+          next = new_chunk;
         } else {
-          list_.push_front(new_elem);
+          delete new_chunk;
         }
       }
+      chunk = next;
     }
   }
 
-  const_iterator cbegin() const { return list_.cbegin(); }
+  const_iterator cbegin() const { return {&head_, 0}; }
+
+  const_iterator cend() const { return {}; }
 
-  const_iterator cend() const { return list_.cend(); }
+  //! Memory held by the overflow chunks in [bytes]
+  size_t nbytes() const
+  {
+    size_t bytes = 0;
+    for (const Chunk* chunk = head_.next.load(std::memory_order_acquire); chunk;
+         chunk = chunk->next.load(std::memory_order_acquire))
+      bytes += sizeof(Chunk);
+    return bytes;
+  }
 
 private:
-  std::forward_list<value_type> list_;
-  OpenMPMutex mutex_;
+  Chunk head_; //!< First chunk of elements
 };
 
 } // namespace openmc
@@ -0,0 +1,217 @@
+#ifndef OPENMC_NODE_SHARED_H
+#define OPENMC_NODE_SHARED_H
+
+//! \file node_shared.h
+//! \brief Read-only arrays that can be shared by all processes on a node
+
+#include <algorithm> // for min
+#include <cstddef>   // for size_t
+#include <cstdint>   // for int64_t
+#include <cstring>   // for memcpy
+
+#include "openmc/huge_pages.h"
+#include "openmc/memory.h"
+#include "openmc/message_passing.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+
+//==============================================================================
+// Class declarations
+//==============================================================================
+
+//! Block of memory that is allocated once per node and mapped into every
+//! process on that node. Construction and destruction are collective over the
+//! processes within the node, so segments must be created and destroyed in the
+//! same order on every process.
+class NodeSharedSegment {
+public:
+  //! Allocate a segment. Only the writer process provides the memory.
+  //
+  //! \param nbytes Size of the segment in bytes
+  explicit NodeSharedSegment(size_t nbytes);
+  ~NodeSharedSegment();
+
+  NodeSharedSegment(const NodeSharedSegment&) = delete;
+  NodeSharedSegment& operator=(const NodeSharedSegment&) = delete;
+
+  //! Make the values stored by the writer visible to all processes on the
+  //! node. This is collective over the processes within the node.
+  void sync();
+
+  //! Whether this process is responsible for filling the segment
+  bool writer() const { return mpi::node_rank == 0; }
+
+  char* data() { return data_; }
+
+private:
+  char* data_ {nullptr}; //!< Start of the segment in this process
+#ifdef OPENMC_MPI
+  MPI_Win win_ {MPI_WIN_NULL};
+#else
+  vector<char> local_; //!< Storage when running without MPI
+#endif
+};
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Copy values such that the pages of the destination are first touched by all
+//! threads in equal contiguous blocks. When threads are bound to cores, the
+//! pages are then spread over the NUMA domains the threads run on.
+//
+//! \param dest Destination, whose pages should not have been touched yet
+//! \param src Values to copy
+//! \param n Number of values
+template<typename T>
+void first_touch_copy(T* dest, const T* src, size_t n)
+{
+  // Copy whole 4 kB pages at a time
+  constexpr size_t block = std::max<size_t>(4096 / sizeof(T), 1);
+  int64_t n_blocks = (n + block - 1) / block;
+#pragma omp parallel for schedule(static)
+  for (int64_t i = 0; i < n_blocks; ++i) {
+    size_t first = i * block;
+    size_t count = std::min(block, n - first);
+    std::memcpy(dest + first, src + first, count * sizeof(T));
+  }
+}
+
+//==============================================================================
+//! Contiguous read-only array whose values are either owned by this process or
+//! held in a NodeSharedSegment. Values may also be viewed as a row-major
+//! two-dimensional array with a fixed number of columns.
+//==============================================================================
+
+template<typename T>
+class NodeSharedArray {
+public:
+  //==========================================================================
+  // Constructors
+
+  NodeSharedArray() = default;
+
+  //! Take ownership of values held by this process
+  //
+  //! \param values Values to hold
+  //! \param n_cols Number of columns when viewed as a two-dimensional array
+  explicit NodeSharedArray(vector<T>&& values, size_t n_cols = 1)
+    : local_(std::move(values)), data_ {local_.data()}, size_ {local_.size()},
+      n_cols_ {n_cols}
+  {}
+
+  NodeSharedArray(const NodeSharedArray& other)
+    : segment_(other.segment_), size_ {other.size_}, n_cols_ {other.n_cols_}
+  {
+    if (!segment_)
+      local_.assign(other.begin(), other.end());
+    data_ = segment_ ? other.data_ : local_.data();
+  }
+
+  NodeSharedArray(NodeSharedArray&&) = default;
+
+  NodeSharedArray& operator=(const NodeSharedArray& other)
+  {
+    if (this != &other) {
+      local_.clear();
+      if (!other.segment_)
+        local_.assign(other.begin(), other.end());
+      pages_ = PageBuffer();
+      segment_ = other.segment_;
+      size_ = other.size_;
+      n_cols_ = other.n_cols_;
+      data_ = segment_ ? other.data_ : local_.data();
+    }
+    return *this;
+  }
+
+  NodeSharedArray& operator=(NodeSharedArray&&) = default;
+
+  //==========================================================================
+  // Methods and Accessors
+
+  const T& operator[](size_t i) const { return data_[i]; }
+  const T& operator()(size_t i, size_t j) const
+  {
+    return data_[i * n_cols_ + j];
+  }
+
+  const T& front() const { return data_[0]; }
+  const T& back() const { return data_[size_ - 1]; }
+
+  const T* begin() const { return data_; }
+  const T* end() const { return data_ + size_; }
+  const T* cbegin() const { return data_; }
+  const T* cend() const { return data_ + size_; }
+
+  const T* data() const { return data_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  //! Size of the values in bytes
+  size_t nbytes() const { return size_ * sizeof(T); }
+
+  //! Move the values into a node-shared segment. The writer process copies
+  //! its values into the segment; all processes then release their own copy.
+  //
+  //! \param segment Segment to hold the values
+  //! \param offset Offset in bytes of the values within the segment
+  //! \param spread Whether the writer copies the values with all threads to
+  //!   spread the pages of the segment over NUMA domains
+  void attach(
+    std::shared_ptr<NodeSharedSegment> segment, size_t offset, bool spread)
+  {
+    char* dest = segment->data() + offset;
+    if (segment->writer() && size_ > 0) {
+      if (spread) {
+        first_touch_copy(reinterpret_cast<T*>(dest), data_, size_);
+      } else {
+        std::memcpy(dest, data_, this->nbytes());
+      }
+    }
+    segment_ = std::move(segment);
+    data_ = reinterpret_cast<const T*>(dest);
+    local_ = vector<T>();
+    pages_ = PageBuffer();
+  }
+
+  //! Move values owned by this process into memory from allocate_pages, which
+  //! is backed by huge pages when they are requested and available. Values
+  //! held in a segment are left in place.
+  //
+  //! \param use Kind of data the values are
+  //! \param spread Whether the values are copied with all threads so that the
+  //!   pages are spread over NUMA domains
+  void move_to_pages(PageUse use, bool spread)
+  {
+    if (segment_ || size_ == 0)
+      return;
+    // Pages from allocate_pages are untouched until the values are copied
+    PageBuffer pages(this->nbytes(), use);
+    T* dest = static_cast<T*>(pages.data());
+    if (spread) {
+      first_touch_copy(dest, data_, size_);
+    } else {
+      std::memcpy(dest, data_, this->nbytes());
+    }
+    pages_ = std::move(pages);
+    data_ = dest;
+    local_ = vector<T>();
+  }
+
+private:
+  //==========================================================================
+  // Data members
+
+  vector<T> local_; //!< Values owned by this process, if not shared
+  PageBuffer pages_; //!< Values owned by this process in page allocations
+  std::shared_ptr<NodeSharedSegment> segment_; //!< Segment holding values
+  const T* data_ {nullptr};                    //!< Start of values
+  size_t size_ {0};                            //!< Number of values
+  size_t n_cols_ {1}; //!< Number of columns in two-dimensional view
+};
+
+} // namespace openmc
+
+#endif // OPENMC_NODE_SHARED_H
@@ -4,6 +4,8 @@
 #ifndef OPENMC_NUCLIDE_H
 #define OPENMC_NUCLIDE_H
 
+#include <atomic>
+#include <mutex> // for once_flag
 #include <unordered_map>
 #include <utility> // for pair
 
@@ -14,6 +16,7 @@
 #include "openmc/constants.h"
 #include "openmc/endf.h"
 #include "openmc/memory.h" // for unique_ptr
+#include "openmc/node_shared.h"
 #include "openmc/particle.h"
 #include "openmc/reaction.h"
 #include "openmc/reaction_product.h"
@@ -33,28 +36,151 @@ public:
   using EmissionMode = ReactionProduct::EmissionMode;
   struct EnergyGrid {
     vector<int> grid_index;
-    vector<double> energy;
+    NodeSharedArray<double> energy;
+    vector<int> hash_offset; //!< Start of each logarithmic bin's sub-bins in
+                             //!< hash_index (hash grid mode only)
+    vector<int> hash_index;  //!< Grid index at each sub-bin boundary
+  };
+
+  //! Location of an energy on a material's unionized energy grid
+  struct UnionIndex {
+    const vector<vector<int>>* map; //!< Nuclide grid index at each union
+                                    //!< point, per temperature
+    int i_union;                    //!< Index on the unionized grid
   };
 
   // Constructors/destructors
-  Nuclide(hid_t group, const vector<double>& temperature);
+  //! \param[in] group HDF5 group containing the nuclide data
+  //! \param[in] temperature Temperatures in [K] to load
+  //! \param[in] derive Whether to compute derived cross sections now rather
+  //!   than with a later call to derive_xs()
+  Nuclide(
+    hid_t group, const vector<double>& temperature, bool derive = true);
   ~Nuclide();
 
+  //! Make sure data at a temperature has been read, reading it from the
+  //! library if it was deferred. This is safe to call from multiple threads.
+  //
+  //! \param[in] i_temp Index in kTs_
+  void ensure_temperature(int i_temp)
+  {
+    std::call_once(temperature_init_[i_temp],
+      [this, i_temp] { this->load_temperature(i_temp); });
+  }
+
+  //! Whether any temperature has yet to be read from the library
+  bool has_deferred_temperatures() const;
+
+  //! Compute the derived total, absorption, fission, nu-fission, and photon
+  //! production cross sections in xs_, reading them from the cross section
+  //! cache when possible. This does not touch HDF5 and may be called
+  //! concurrently for different nuclides.
+  void derive_xs();
+
+  //! Move energy grids and cross sections into memory shared by all
+  //! processes on this node. This is collective over the node.
+  //! \return Memory held in the node-shared segment in [bytes]
+  size_t share_data();
+
+  //! Move energy grids and cross sections that are not shared between
+  //! processes into page allocations, which are backed by huge pages and
+  //! spread over NUMA domains as requested in the settings
+  void place_data();
+
   //! Initialize logarithmic grid for energy searches
-  void init_grid();
+  //! \return Memory used by hash grids in [bytes]
+  size_t init_grid();
 
-  void calculate_xs(int i_sab, int i_log_union, double sab_frac, Particle& p);
+  //! Memory held by the energy grid and cross sections at a temperature,
+  //! which is zero for a temperature that has not been read
+  //
+  //! \param[in] i_temp Index in kTs_
+  //! \return Memory in [bytes]
+  size_t memory_usage(int i_temp) const;
+
+  //! Memory held by the data at all temperatures and by the temperature
+  //! independent 0K elastic, URR, and multipole data. Secondary angle and
+  //! energy distributions are not included.
+  //
+  //! \return Memory in [bytes]
+  size_t memory_usage() const;
+
+  //! Calculate microscopic cross sections at the particle's energy
+  //
+  //! \param[in] i_sab Index in data::thermal_scatt or C_NONE
+  //! \param[in] i_log_union Index on the logarithmic energy grid
+  //! \param[in] sab_frac Fraction of the nuclide bound by the S(a,b) table
+  //! \param[in] p Particle
+  //! \param[in] u If given, location on a unionized energy grid that is used
+  //!   in place of the logarithmic grid search
+  //! \param[in] mp_xs If given, elastic, absorption, and fission cross sections
+  //!   already evaluated from multipole data at the particle's energy
+  void calculate_xs(int i_sab, int i_log_union, double sab_frac, Particle& p,
+    const UnionIndex* u = nullptr, const array<double, 3>* mp_xs = nullptr);
 
   void calculate_sab_xs(int i_sab, double sab_frac, Particle& p);
 
+  //! Find the inelastic scattering reaction at which the cumulative inelastic
+  //! scattering cross section first reaches a value
+  //
+  //! \param[in] micro Microscopic cross sections at the particle's energy
+  //! \param[in] cutoff Value of the cumulative cross section to reach
+  //! \return Index in reactions_, or C_NONE if the cumulative cross sections
+  //!   aren't stored at the energy or never reach the value
+  int sample_inelastic_scatter(
+    const NuclideMicroXS& micro, double cutoff) const;
+
+  //! Determine index of the temperature nearest to a given temperature
+  //
+  //! \param[in] kT Temperature in [eV]
+  //! \return Index in kTs_
+  int nearest_temperature(double kT) const;
+
+  //! Cache the nearest temperature index for any cell temperatures in
+  //! data::cell_sqrtkT that have not been seen yet
+  void update_cell_temperatures();
+
+  //! Interpolate total, absorption, fission, and nu-fission cross sections
+  //
+  //! \param[in] i_temp Temperature index
+  //! \param[in] i_grid Index on the energy grid at the given temperature
+  //! \param[in] E Energy in [eV]
+  //! \return Total, absorption, fission, and nu-fission cross sections in [b]
+  array<double, 4> interpolate_xs(int i_temp, int i_grid, double E) const;
+
+  //! Determine an upper bound on the total cross section in each bin of the
+  //! logarithmic energy grid that holds at every temperature, including
+  //! within the range of the URR probability tables. Temperatures that were
+  //! deferred are read.
+  //
+  //! \return Bound in [b] in each bin
+  vector<double> total_xs_bound();
+
   // Methods
   double nu(double E, EmissionMode mode, int group = 0) const;
+
+  //! Evaluate the neutron yield from fission, reusing the value stored in the
+  //! microscopic cross section cache if it was evaluated at the same energy
+  //
+  //! \param[in] E Incident energy in [eV]
+  //! \param[in] mode Total, prompt, or delayed (summed over groups) yield
+  //! \param[inout] micro Microscopic cross sections of this nuclide
+  //! \return Neutron yield
+  double nu(double E, EmissionMode mode, NuclideMicroXS& micro) const;
   void calculate_elastic_xs(Particle& p) const;
 
   //! Determines the microscopic 0K elastic cross section at a trial relative
   //! energy used in resonance scattering
   double elastic_xs_0K(double E) const;
 
+  //! Determines the maximum 0K elastic cross section over a range of points
+  //! on the 0K energy grid
+  //
+  //! \param[in] i_begin Index of the first point
+  //! \param[in] i_end Index one past the last point
+  //! \return Maximum cross section in [b]
+  double elastic_xs_0K_max(int i_begin, int i_end) const;
+
   //! \brief Determines cross sections in the unresolved resonance range
   //! from probability tables.
   void calculate_urr_xs(int i_temp, Particle& p) const;
@@ -69,6 +195,29 @@ public:
   double collapse_rate(int MT, double temperature,
     gsl::span<const double> energy, gsl::span<const double> flux) const;
 
+  //! \brief Calculate rates of several reactions based on group-wise flux
+  //! distribution, locating the group boundaries on the energy grid once
+  //
+  //! \param[in] MTs ENDF MT values of the desired reactions
+  //! \param[in] temperature Temperature in [K]
+  //! \param[in] energy Energy group boundaries in [eV]
+  //! \param[in] flux Flux in each energy group (not normalized per eV)
+  //! \param[in] i_log Index of each group boundary on the logarithmic grid,
+  //!   as found by log_grid_indices()
+  //! \param[out] rates Reaction rate of each reaction
+  void collapse_rates(gsl::span<const int> MTs, double temperature,
+    gsl::span<const double> energy, gsl::span<const double> flux,
+    gsl::span<const int> i_log, double* rates) const;
+
+  //! \brief Find the energy grid intervals that contain a set of energies
+  //
+  //! \param[in] i_temp Temperature index
+  //! \param[in] energy Energies in [eV] in ascending order
+  //! \param[in] i_log Index of each energy on the logarithmic grid
+  //! \param[out] indices Index of the grid interval containing each energy
+  void grid_indices(gsl::index i_temp, gsl::span<const double> energy,
+    gsl::span<const int> i_log, vector<int>& indices) const;
+
   // Data members
   std::string name_; //!< Name of nuclide, e.g. "U235"
   int Z_;            //!< Atomic number
@@ -79,8 +228,18 @@ public:
 
   // Temperature dependent cross section data
   vector<double> kTs_;                //!< temperatures in eV (k*T)
+  vector<int> temperatures_;          //!< temperatures in [K] matching kTs_
+  std::string library_path_;          //!< path to the library file
+  unique_ptr<std::once_flag[]> temperature_init_; //!< whether the data at
+                                                  //!< each temperature is read
+  unique_ptr<std::atomic<bool>[]> temperature_loaded_; //!< whether reading the
+                                                       //!< data has finished
   vector<EnergyGrid> grid_;           //!< Energy grid at each temperature
-  vector<xt::xtensor<double, 2>> xs_; //!< Cross sections at each temperature
+  std::string xs_cache_key_; //!< Key for derived cross sections in the cache
+  vector<NodeSharedArray<xs_real>> xs_; //!< Cross sections at each
+                                       //!< temperature, [energy][XS_*]
+  vector<int> cell_temp_index_; //!< Index in kTs_ nearest to each temperature
+                                //!< in data::cell_sqrtkT
 
   // Multipole data
   unique_ptr<WindowedMultipole> multipole_;
@@ -89,6 +248,9 @@ public:
   bool fissionable_ {false};         //!< Whether nuclide is fissionable
   bool has_partial_fission_ {false}; //!< has partial fission reactions?
   vector<Reaction*> fission_rx_;     //!< Fission reactions
+  //! Reaction and product indices of each photon product, in the order that
+  //! they are sampled
+  vector<array<int, 2>> photon_products_;
   int n_precursor_ {0};              //!< Number of delayed neutron precursors
   unique_ptr<Function1D> total_nu_;  //!< Total neutron yield
   unique_ptr<Function1D> fission_q_prompt_; //!< Prompt fission energy release
@@ -104,6 +266,7 @@ public:
   vector<double> energy_0K_;
   vector<double> elastic_0K_;
   vector<double> xs_cdf_;
+  vector<double> elastic_0K_max_; //!< Maximum 0K elastic xs in each block
 
   // Unresolved resonance range information
   bool urr_present_ {false};
@@ -114,9 +277,58 @@ public:
   array<size_t, 902> reaction_index_;      //!< Index of each reaction
   vector<int> index_inelastic_scatter_;
 
+  //! Cumulative cross sections of the inelastic scattering reactions in
+  //! index_inelastic_scatter_ at one temperature
+  struct InelasticCDF {
+    int threshold {0}; //!< First energy grid interval stored
+    //! Sums at the lower and upper end of each grid interval,
+    //! [interval][lower/upper][reaction]. Reactions whose threshold is above
+    //! the interval are left out of both, as in Reaction::xs().
+    vector<xs_real> value;
+  };
+  vector<InelasticCDF> inelastic_cdf_; //!< Cumulative inelastic cross
+                                       //!< sections at each temperature
+
 private:
-  void create_derived(
-    const Function1D* prompt_photons, const Function1D* delayed_photons);
+  void create_derived(hid_t group);
+
+  //! Read the energy grid and reaction cross sections at a temperature whose
+  //! reading was deferred, then derive cross sections and grid indices for it
+  //
+  //! \param[in] i_temp Index in kTs_
+  void load_temperature(int i_temp);
+
+  //! Sum the inelastic scattering cross sections at a temperature into
+  //! inelastic_cdf_ if the nuclide has enough reactions to benefit
+  //
+  //! \param[in] i_temp Index in kTs_
+  void build_inelastic_cdf(int i_temp);
+
+  //! Initialize the logarithmic (and hash) grid at a single temperature
+  //
+  //! \param[in] i_temp Index in kTs_
+  //! \return Memory used by hash grids in [bytes]
+  size_t init_grid(int i_temp);
+
+  //! Sum reaction cross sections into the derived total, absorption,
+  //! fission, nu-fission, and photon production cross sections
+  //
+  //! \param[in] i_temp Temperature index
+  //! \return Derived cross sections, [energy][XS_*]
+  NodeSharedArray<xs_real> sum_reaction_xs(int i_temp) const;
+
+  //! Read derived cross sections from a cache file
+  //
+  //! \param[in] path Path to the cache file
+  //! \param[in] key Key identifying the library, nuclide, and temperatures
+  //! \return Whether the cache file existed and matched the key
+  bool read_xs_cache(const std::string& path, const std::string& key);
+
+  //! Write derived cross sections to a cache file
+  //
+  //! \param[in] path Path to the cache file
+  //! \param[in] key Key identifying the library, nuclide, and temperatures
+  void write_xs_cache(const std::string& path, const std::string& key) const;
 
   //! Determine temperature index and interpolation factor
   //
@@ -144,6 +356,9 @@ bool multipole_in_range(const Nuclide& nuc, double E);
 // Global variables
 //==============================================================================
 
+//! Whether pointwise cross sections are stored in single precision
+extern "C" const bool XS_SINGLE_PRECISION;
+
 namespace data {
 
 // Minimum/maximum transport energy for each particle type. Order corresponds to
@@ -160,6 +375,11 @@ extern double temperature_max;
 extern std::unordered_map<std::string, int> nuclide_map;
 extern vector<unique_ptr<Nuclide>> nuclides;
 
+//! Distinct temperatures, sqrt(k_Boltzmann * temperature) in [eV^1/2],
+//! assigned to cells
+extern vector<double> cell_sqrtkT;
+extern std::unordered_map<double, int> cell_sqrtkT_map;
+
 } // namespace data
 
 //==============================================================================
@@ -168,6 +388,54 @@ extern vector<unique_ptr<Nuclide>> nuclides;
 
 void nuclides_clear();
 
+//! Find the index of a cell temperature in data::cell_sqrtkT, adding it (and
+//! the corresponding nearest temperature index on each nuclide) if needed
+//
+//! \param[in] sqrtkT sqrt(k_Boltzmann * temperature) in [eV^1/2]
+//! \param[in] update_nuclides Whether to extend the indices on each nuclide
+//!   now. When adding many temperatures, this can be done once afterward with
+//!   Nuclide::update_cell_temperatures().
+//! \return Index in data::cell_sqrtkT
+int cell_temperature_index(double sqrtkT, bool update_nuclides = true);
+
+//! Find the index on the logarithmic energy grid of each of a set of energies
+//
+//! \param[in] energy Energies in [eV]
+//! \return Index of each energy on the logarithmic grid, or -1 for energies
+//!   outside of it
+vector<int> log_grid_indices(gsl::span<const double> energy);
+
+//! Read a nuclide and, if needed, its photon interaction data from HDF5
+//
+//! \param[in] name Name of the nuclide
+//! \param[in] temps Temperatures in [K] to load
+//! \param[in] n Number of temperatures
+//! \param[in] derive Whether to compute derived cross sections and share data
+//!   within the node immediately
+//! \return Error code
+int load_nuclide(const char* name, const double* temps, int n, bool derive);
+
+//! Move a nuclide's data into node-shared memory and report its size
+//
+//! \param[in] nuc Nuclide whose derived cross sections have been computed
+void share_nuclide_data(Nuclide& nuc);
+
+//! Determine the path of the file containing an HDF5 object
+//
+//! \param[in] group HDF5 object
+//! \return Path to the file
+std::string library_path(hid_t group);
+
+//! Build the key identifying derived cross sections in a cache file
+//
+//! \param[in] path Path to the library file containing the nuclide
+//! \param[in] name Name of the nuclide
+//! \param[in] kTs Temperatures in [eV] that were loaded
+//! \return Key covering the library file, nuclide, temperatures, and settings
+//!   that affect the derived cross sections
+std::string xs_cache_key(const std::string& path, const std::string& name,
+  const vector<double>& kTs);
+
 } // namespace openmc
 
 #endif // OPENMC_NUCLIDE_H
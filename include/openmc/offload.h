@@ -0,0 +1,110 @@
+#ifndef OPENMC_OFFLOAD_H
+#define OPENMC_OFFLOAD_H
+
+//! \file offload.h
+//! \brief Offloading of event-based cross section lookups to an accelerator
+//! with OpenMP target directives
+
+#include <cstdint> // for int64_t
+
+namespace openmc {
+
+//==============================================================================
+// Tabulated cross section lookup, compiled for both the host and the device
+//==============================================================================
+
+#ifdef OPENMC_OFFLOAD
+#pragma omp declare target
+#endif
+
+//! Determine index of an energy on a unionized energy grid
+//
+//! \param[in] energy Unionized energy points in [eV]
+//! \param[in] n_energy Number of points on the grid
+//! \param[in] grid_index Union grid index on the logarithmic grid
+//! \param[in] E Energy in [eV]
+//! \param[in] i_log_union Index on the logarithmic energy grid
+//! \return Index of the union grid interval containing E
+inline int union_grid_interval(const double* energy, int n_energy,
+  const int* grid_index, double E, int i_log_union)
+{
+  if (E < energy[0])
+    return 0;
+  if (E >= energy[n_energy - 1])
+    return n_energy - 2;
+
+  // Find the first point above E within the bounds from the logarithmic grid
+  int lo = grid_index[i_log_union];
+  int hi = grid_index[i_log_union + 1] + 1;
+  while (lo < hi) {
+    int mid = lo + (hi - lo) / 2;
+    if (energy[mid] <= E) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo - 1;
+}
+
+//! Interpolate tabulated macroscopic cross sections
+//
+//! \param[in] energy Unionized energy points in [eV]
+//! \param[in] table Total, absorption, fission, and nu-fission cross sections
+//!   at each union point
+//! \param[in] i Index of the union grid interval containing E
+//! \param[in] E Energy in [eV]
+//! \param[out] xs Total, absorption, fission, and nu-fission cross sections
+inline void interpolate_macro_xs(
+  const double* energy, const double* table, int i, double E, double* xs)
+{
+  double f = (E - energy[i]) / (energy[i + 1] - energy[i]);
+  for (int k = 0; k < 4; ++k) {
+    xs[k] = (1.0 - f) * table[4 * i + k] + f * table[4 * (i + 1) + k];
+  }
+}
+
+#ifdef OPENMC_OFFLOAD
+#pragma omp end declare target
+#endif
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Map the unionized energy grids and tabulated macroscopic cross sections of
+//! all materials to the device assigned to this process. Nothing is done
+//! unless OpenMC was built with OPENMC_USE_OFFLOAD, a device is available, and
+//! some material tabulates its cross sections.
+//
+//! \param n_particles The number of particles in the event-based particle
+//!   buffer, which bounds the number of lookups done at once
+void offload_init(int64_t n_particles);
+
+//! Release the device memory mapped by offload_init
+void offload_free();
+
+//! Whether tabulated cross section lookups are done on the device
+bool offload_active();
+
+//! Look up tabulated macroscopic cross sections on the device
+//
+//! \param[in] n Number of lookups, at most the number of particles passed to
+//!   offload_init
+//! \param[in] table Index of the table for each lookup, counting the tables
+//!   of all materials in order, as given by offload_table_index
+//! \param[in] E Energy in [eV] for each lookup
+//! \param[out] xs Total, absorption, fission, and nu-fission cross sections
+//!   for each lookup, with length 4 * n
+void offload_tabulated_xs(
+  int64_t n, const int* table, const double* E, double* xs);
+
+//! Index of a material's table among the tables of all materials
+//
+//! \param[in] i_material Index in model::materials
+//! \param[in] i_table Index in the material's macro_xs_tables_
+int offload_table_index(int i_material, int i_table);
+
+} // namespace openmc
+
+#endif // OPENMC_OFFLOAD_H
@@ -34,6 +34,9 @@ void print_plot();
 //! Display information regarding cell overlap checking.
 void print_overlap_check();
 
+//! Display the surfaces on which particles missed neighbor lists most often.
+void print_crossing_recovery();
+
 //! Display information about command line usage of OpenMC
 void print_usage();
 
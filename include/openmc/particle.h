@@ -4,6 +4,7 @@
 //! \file particle.h
 //! \brief Particle type
 
+#include <algorithm> // for min
 #include <cstdint>
 #include <sstream>
 #include <string>
@@ -19,8 +20,25 @@
 namespace openmc {
 
 // Forward declare the Surface class for use in Particle::cross_vacuum_bc, etc.
+class NeighborList;
 class Surface;
 
+//==============================================================================
+// Constants
+//==============================================================================
+
+//! Optional features checked by the particle events. The templated events are
+//! instantiated for sets of these, and the checks for features that are not in
+//! a set are removed at compile time.
+enum TransportFeature : unsigned {
+  FEATURE_DELTA_TRACKING = 1 << 0, //!< Delta tracking through universes
+  FEATURE_WEIGHT_WINDOWS = 1 << 1, //!< Stopping at weight window boundaries
+  FEATURE_CENSUS = 1 << 2,         //!< Banking particles at census times
+  FEATURE_TRACKS = 1 << 3,         //!< Writing particle tracks
+  FEATURE_DERIVATIVES = 1 << 4,    //!< Differential tally accumulators
+  FEATURE_ALL = (1 << 5) - 1
+};
+
 /*
  * The Particle class encompasses data and methods for transporting particles
  * through their lifecycle. Its base class defines particle data layout in
@@ -55,14 +73,46 @@ public:
   //! \param src Source site data
   void from_source(const SourceSite* src);
 
-  // Coarse-grained particle events
+  // Coarse-grained particle events. Events templated on a set of
+  // TransportFeature flags only check for the features in the set.
   void event_calculate_xs();
+  template<unsigned Features = FEATURE_ALL>
   void event_advance();
+  template<unsigned Features = FEATURE_ALL>
+  void event_tally_advance();
   void event_cross_surface();
   void event_collide();
+  template<unsigned Features = FEATURE_ALL>
+  void event_tally_collision();
+  template<unsigned Features = FEATURE_ALL>
   void event_revive_from_secondary();
+  template<unsigned Features = FEATURE_ALL>
   void event_death();
 
+  //! Prepare for a cross section lookup
+  //
+  //! Stores the pre-collision state, locates the particle if its cell is not
+  //! known and writes track and overlap information. This is the part of
+  //! event_calculate_xs() that precedes the lookup itself.
+  //! \return Whether cross sections need to be calculated
+  bool prepare_calculate_xs();
+
+  //! Length of the track from the most recent advance event
+  double track_distance() const
+  {
+    return std::min(boundary().distance, collision_distance());
+  }
+
+  //! Advance the particle along its direction at every coordinate level
+  //! \param distance Distance to move in [cm]
+  void move(double distance);
+
+  //! Reduce the energy of a charged particle with condensed history by the
+  //! energy lost over the track from the most recent advance event. This is
+  //! deferred to the event that ends the track so that the track is scored at
+  //! the energy it started with.
+  void slow_down();
+
   //! Cross a surface and handle boundary conditions
   void cross_surface();
 
@@ -87,8 +137,17 @@ public:
   //! \param new_u The direction of the particle after translation/rotation.
   //! \param new_surface The signed index of the surface that the particle will
   //!   reside on after translation/rotation.
-  void cross_periodic_bc(
-    const Surface& surf, Position new_r, Direction new_u, int new_surface);
+  //! \param partners Root universe cells next to the new surface, which are
+  //!   searched before all other cells
+  void cross_periodic_bc(const Surface& surf, Position new_r, Direction new_u,
+    int new_surface, NeighborList& partners);
+
+  //! Add energy to the deposits of this history in the pulse-height cells
+  //! that the particle is in
+  //
+  //! \param E Energy in [eV], which is negative for energy carried away from
+  //!   the cells by a secondary particle
+  void deposit_energy(double E);
 
   //! mark a particle as lost and create a particle restart file
   //! \param message A warning message to display
@@ -1,6 +1,8 @@
 #ifndef OPENMC_PARTICLE_DATA_H
 #define OPENMC_PARTICLE_DATA_H
 
+#include <algorithm> // for fill
+
 #include "openmc/array.h"
 #include "openmc/constants.h"
 #include "openmc/position.h"
@@ -56,6 +58,30 @@ struct SourceSite {
   int64_t progeny_id;
 };
 
+//! Banked state of a particle with a single precision direction and the
+//! particle type and delayed group packed together, used to exchange source
+//! sites between processes when settings::compact_bank is set
+//! NOTE: This structure's MPI type is built in initialize_mpi() of
+//! initialize.cpp.
+struct CompactSourceSite {
+  CompactSourceSite() = default;
+  explicit CompactSourceSite(const SourceSite& site);
+
+  //! Convert back to a full source site, renormalizing the direction
+  SourceSite expand() const;
+
+  Position r;
+  double E;
+  double time;
+  double wgt;
+  int64_t parent_id;
+  int64_t progeny_id;
+  float u[3];
+  int32_t surf_id;
+  int16_t particle;
+  int16_t delayed_group;
+};
+
 //! State of a particle used for particle track files
 struct TrackState {
   Position r;           //!< Position in [cm]
@@ -81,6 +107,12 @@ struct NuBank {
   int delayed_group; //!< particle delayed group
 };
 
+//! Energy deposited in a cell of a pulse-height tally during a history
+struct EnergyDeposit {
+  int cell; //!< index of the cell
+  double E; //!< deposited energy in [eV]
+};
+
 class LocalCoord {
 public:
   void rotate(const vector<double>& rotation);
@@ -95,6 +127,19 @@ public:
   int lattice {-1};
   array<int, 3> lattice_i {{-1, -1, -1}};
   bool rotated {false}; //!< Is the level rotated?
+
+  //! Distances along u to the next tile boundary on each axis of a
+  //! rectangular lattice, which are valid if lattice_u is equal to u
+  array<double, 3> lattice_dist;
+  Direction lattice_u {0.0, 0.0, 0.0}; //!< Direction of lattice_dist
+
+  //! Distribcell instance of the cell at this level, cached by
+  //! cell_instance_at_level.  It is valid if instance_cell and
+  //! instance_lattice_i match cell and lattice_i; levels above this one
+  //! cannot change without this level being reset.
+  mutable int instance;
+  mutable int instance_cell {C_NONE};
+  mutable array<int, 3> instance_lattice_i;
 };
 
 //==============================================================================
@@ -128,11 +173,36 @@ struct NuclideMicroXS {
   double sab_frac;      //!< Fraction of atoms affected by S(a,b)
   bool use_ptable;      //!< In URR range with probability tables?
 
+  // Probability table location found on the last lookup in the unresolved
+  // resonance range, reused while the energy stays within the same bracket
+  int urr_index_temp {-1}; //!< Temperature index of the probability table
+  int urr_index_energy;    //!< Index on the probability table energy grid
+  double urr_prn;          //!< Random number used to sample the bands
+  int urr_band_low;        //!< Band at the lower energy of the bracket
+  int urr_band_up;         //!< Band at the upper energy of the bracket
+
   // Energy and temperature last used to evaluate these cross sections.  If
   // these values have changed, then the cross sections must be re-evaluated.
   double last_E {0.0};      //!< Last evaluated energy
   double last_sqrtkT {0.0}; //!< Last temperature in sqrt(Boltzmann constant
                             //!< * temperature (eV))
+
+  // Temperature derivatives of the multipole cross sections, which are only
+  // evaluated when needed by differential tallies.  They are kept until the
+  // energy or temperature they were evaluated at changes.
+  double deriv_E {-1.0};   //!< Energy the derivatives were evaluated at
+  double deriv_sqrtkT;     //!< Temperature the derivatives were evaluated at
+  double deriv_scatter;    //!< d(scattering) / dT
+  double deriv_absorption; //!< d(absorption) / dT
+  double deriv_fission;    //!< d(fission) / dT
+
+  // Total, prompt, and delayed neutron yields from fission, each evaluated
+  // when first needed and kept until the energy they were evaluated at changes.
+  // A negative yield has not been evaluated.
+  double nu_E {-1.0};       //!< Energy the yields were evaluated at
+  double nu_total {-1.0};   //!< Total neutron yield
+  double nu_prompt {-1.0};  //!< Prompt neutron yield
+  double nu_delayed {-1.0}; //!< Delayed neutron yield summed over groups
 };
 
 //==============================================================================
@@ -170,6 +240,92 @@ struct MacroXS {
   double pair_production; //!< macroscopic pair production xs
 };
 
+#ifdef OPENMC_PARTICLE_SOA
+//==============================================================================
+//! Storage for the most frequently accessed particle data, kept in separate
+//! arrays indexed by particle slot rather than within each particle.
+//
+//! Slots are handed out in blocks of BLOCK_SIZE consecutive particles, and each
+//! quantity in a block is a contiguous, cache-line aligned array. Particles in
+//! the event-based buffer are constructed together and so occupy consecutive
+//! slots, which lets a kernel working through a queue touch only the arrays it
+//! needs. Blocks never move once allocated, so a thread can use its particles
+//! while others claim new slots.
+//==============================================================================
+
+class ParticleSoA {
+public:
+  static constexpr int BLOCK_BITS {12};
+  static constexpr int64_t BLOCK_SIZE {int64_t(1) << BLOCK_BITS};
+  static constexpr int MAX_BLOCKS {1 << 16};
+
+  //! Claim a slot with default values, reusing released slots first
+  static int64_t acquire();
+
+  //! Return a slot so that it can be given to another particle
+  static void release(int64_t slot);
+
+  //! Copy all values from one slot to another
+  static void copy(int64_t from, int64_t to);
+
+  static double& E(int64_t slot) { return block(slot).E[slot & MASK]; }
+  static double& wgt(int64_t slot) { return block(slot).wgt[slot & MASK]; }
+  static double& sqrtkT(int64_t slot)
+  {
+    return block(slot).sqrtkT[slot & MASK];
+  }
+  static int& material(int64_t slot)
+  {
+    return block(slot).material[slot & MASK];
+  }
+  static MacroXS& macro_xs(int64_t slot)
+  {
+    return block(slot).macro_xs[slot & MASK];
+  }
+
+private:
+  static constexpr int64_t MASK {BLOCK_SIZE - 1};
+
+  struct Block {
+    alignas(64) double E[BLOCK_SIZE];
+    alignas(64) double wgt[BLOCK_SIZE];
+    alignas(64) double sqrtkT[BLOCK_SIZE];
+    alignas(64) int material[BLOCK_SIZE];
+    alignas(64) MacroXS macro_xs[BLOCK_SIZE];
+  };
+
+  static Block& block(int64_t slot) { return *blocks_[slot >> BLOCK_BITS]; }
+
+  static Block* blocks_[MAX_BLOCKS]; //!< Allocated blocks
+};
+
+//==============================================================================
+//! Owner of a slot in ParticleSoA that claims a new slot when copied and
+//! returns it when destroyed
+//==============================================================================
+
+class ParticleSlot {
+public:
+  ParticleSlot() : index_ {ParticleSoA::acquire()} {}
+  ParticleSlot(const ParticleSlot& other) : ParticleSlot()
+  {
+    ParticleSoA::copy(other.index_, index_);
+  }
+  ParticleSlot& operator=(const ParticleSlot& other)
+  {
+    if (this != &other)
+      ParticleSoA::copy(other.index_, index_);
+    return *this;
+  }
+  ~ParticleSlot() { ParticleSoA::release(index_); }
+
+  int64_t index() const { return index_; }
+
+private:
+  int64_t index_; //!< Slot in ParticleSoA
+};
+#endif
+
 //==============================================================================
 // Information about nearest boundary crossing
 //==============================================================================
@@ -180,6 +336,200 @@ struct BoundaryInfo {
   int coord_level;       //!< coordinate level after crossing boundary
   array<int, 3>
     lattice_translation {}; //!< which way lattice indices will change
+  bool weight_window {false}; //!< is boundary a weight window mesh boundary?
+  bool census {false};        //!< is boundary the census time?
+};
+
+//==============================================================================
+//! Senses of surfaces at the location of a cell search, so that a surface
+//! shared by several candidate cells is only evaluated once
+//==============================================================================
+
+class SurfaceSenseCache {
+public:
+  //! Set the location that senses are looked up for, forgetting all cached
+  //! senses if it differs from the previous location
+  void set_location(Position r, Direction u)
+  {
+    if (r != r_ || u != u_) {
+      r_ = r;
+      u_ = u;
+      ++stamp_;
+    }
+  }
+
+  //! Look up the sense of a surface at the current location
+  //! \param[in] i_surf Index of the surface
+  //! \param[out] sense Sense of the surface, if it was cached
+  //! \return Whether the sense was cached
+  bool find(int32_t i_surf, bool& sense) const
+  {
+    const auto& e {entries_[i_surf % SIZE]};
+    if (e.surface != i_surf || e.stamp != stamp_)
+      return false;
+    sense = e.sense;
+    return true;
+  }
+
+  //! Store the sense of a surface at the current location
+  void insert(int32_t i_surf, bool sense)
+  {
+    entries_[i_surf % SIZE] = {i_surf, stamp_, sense};
+  }
+
+private:
+  static constexpr int SIZE {16}; //!< Number of entries, indexed by surface
+
+  struct Entry {
+    int32_t surface {C_NONE};
+    uint64_t stamp {0};
+    bool sense;
+  };
+
+  array<Entry, SIZE> entries_; //!< Direct-mapped senses
+  Position r_ {INFINITY, INFINITY, INFINITY}; //!< Current location
+  Direction u_;                               //!< Current direction
+  uint64_t stamp_ {0}; //!< Incremented when the location changes
+};
+
+//==============================================================================
+//! Terms of the distances to the surfaces of recently visited cells that
+//! depend only on the location. A collision changes the direction of a
+//! particle but not its location, so the distance calculation that follows it
+//! can reuse the terms evaluated before the collision.
+//==============================================================================
+
+class SurfaceDistanceCache {
+public:
+  //! Look up the terms of a cell at a location, claiming an entry for them if
+  //! they aren't cached
+  //! \param[in] cell Cell the terms belong to
+  //! \param[in] r Location in the local coordinates of the cell
+  //! \param[in] n Number of terms
+  //! \param[out] found Whether the terms were cached
+  //! \return Pointer to the n terms, which the caller has to fill if they
+  //!   weren't cached
+  double* find(const void* cell, Position r, int n, bool& found)
+  {
+    for (auto& e : entries_) {
+      if (e.cell == cell && e.r == r) {
+        found = true;
+        return e.terms.data();
+      }
+    }
+    auto& e {entries_[next_]};
+    next_ = (next_ + 1) % SIZE;
+    e.cell = cell;
+    e.r = r;
+    e.terms.resize(n);
+    found = false;
+    return e.terms.data();
+  }
+
+  //! Forget all cached terms
+  void clear()
+  {
+    for (auto& e : entries_)
+      e.cell = nullptr;
+  }
+
+private:
+  static constexpr int SIZE {4}; //!< Number of cells that terms are kept for
+
+  struct Entry {
+    const void* cell {nullptr};
+    Position r;
+    vector<double> terms;
+  };
+
+  array<Entry, SIZE> entries_; //!< Terms of the most recently visited cells
+  int next_ {0};               //!< Entry to replace next
+};
+
+//==============================================================================
+//! Mesh bin found at a position, so that the weight windows and the collision
+//! tallies looking up the same mesh at a collision share one search
+//==============================================================================
+
+class MeshBinCache {
+public:
+  //! Look up the bin of a mesh at a position
+  //! \param[in] i_mesh Index of the mesh
+  //! \param[in] r Position in the mesh
+  //! \param[out] bin Bin of the mesh, if it was cached
+  //! \return Whether the bin was cached
+  bool find(int32_t i_mesh, Position r, int& bin) const
+  {
+    if (i_mesh != mesh_ || r != r_)
+      return false;
+    bin = bin_;
+    return true;
+  }
+
+  //! Store the bin of a mesh at a position
+  void insert(int32_t i_mesh, Position r, int bin)
+  {
+    mesh_ = i_mesh;
+    r_ = r;
+    bin_ = bin;
+  }
+
+private:
+  int32_t mesh_ {C_NONE}; //!< Index of the mesh
+  Position r_;            //!< Position the bin was found at
+  int bin_;               //!< Bin of the mesh
+};
+
+//==============================================================================
+//! Boundary found by the last ray fired in a DAGMC cell, so that the distance
+//! to the boundary from a later point on the same ray is found without firing
+//! another ray
+//==============================================================================
+
+class DAGRayCache {
+public:
+  //! Look up the distance to the boundary of a cell along a ray
+  //! \param[in] i_cell Index of the cell
+  //! \param[in] r Starting point of the ray
+  //! \param[in] u Direction of the ray
+  //! \param[out] dist Distance to the boundary, if it was cached
+  //! \param[out] i_surf Index of the surface hit, if it was cached
+  //! \return Whether the distance was cached
+  bool find(int32_t i_cell, Position r, Direction u, double& dist,
+    int32_t& i_surf) const
+  {
+    if (i_cell != cell_ || u != u_)
+      return false;
+
+    // The point has to lie on the cached ray before the boundary
+    Position d = r - r_;
+    double t = d.dot(u);
+    if (t < 0.0 || t >= dist_)
+      return false;
+    if ((d - t * u).norm() > FP_COINCIDENT * std::max(1.0, r.norm()))
+      return false;
+    dist = dist_ - t;
+    i_surf = surf_;
+    return true;
+  }
+
+  //! Store the boundary found by a ray
+  void insert(int32_t i_cell, Position r, Direction u, double dist,
+    int32_t i_surf)
+  {
+    cell_ = i_cell;
+    r_ = r;
+    u_ = u;
+    dist_ = dist;
+    surf_ = i_surf;
+  }
+
+private:
+  int32_t cell_ {C_NONE}; //!< Index of the cell
+  Position r_;            //!< Origin of the ray
+  Direction u_;           //!< Direction of the ray
+  double dist_;           //!< Distance from the origin to the boundary
+  int32_t surf_;          //!< Index of the surface hit
 };
 
 //============================================================================
@@ -222,36 +572,66 @@ class ParticleData {
 public:
   ParticleData();
 
+  //! Memory held by the particle, including its microscopic cross section
+  //! caches and banks, in [bytes]
+  size_t memory_usage() const;
+
 private:
   //==========================================================================
   // Data members (accessor methods are below)
 
-  // Cross section caches
+  // Transport state used on every event, grouped so that it spans as few
+  // cache lines as possible. The scalars come first and fill one line.
+#ifdef OPENMC_PARTICLE_SOA
+  ParticleSlot slot_; //!< Slot holding energy, weight, material, temperature
+                      //!< and macroscopic cross sections
+#else
+  double E_;             //!< post-collision energy in eV
+  double wgt_ {1.0};     //!< particle weight
+  double sqrtkT_ {-1.0}; //!< sqrt(k_Boltzmann * temperature) in eV
+  int material_ {-1};    //!< index for current material
+#endif
+  ParticleType type_ {ParticleType::neutron}; //!< Particle type (n, p, e, etc.)
+  int n_coord_ {1};           //!< number of current coordinate levels
+  int cell_instance_;         //!< offset for distributed properties
+  int stream_;                //!< current RNG stream
+  double time_ {0.0};         //!< time in [s]
+  double collision_distance_; //!< distance to next closest collision
+  uint64_t seeds_[N_STREAMS]; //!< current seeds
+
+  vector<LocalCoord> coord_;          //!< coordinates for all levels
   vector<NuclideMicroXS> neutron_xs_; //!< Microscopic neutron cross sections
-  vector<ElementMicroXS> photon_xs_;  //!< Microscopic photon cross sections
-  MacroXS macro_xs_;                  //!< Macroscopic cross sections
+  BoundaryInfo boundary_;             //!< Nearest boundary crossing
+#ifndef OPENMC_PARTICLE_SOA
+  MacroXS macro_xs_; //!< Macroscopic cross sections
+#endif
 
-  int64_t id_;                                //!< Unique ID
-  ParticleType type_ {ParticleType::neutron}; //!< Particle type (n, p, e, etc.)
+  // State that is used less often, such as for tallies, secondary particles
+  // or track output, follows the hot state
 
-  int n_coord_ {1};          //!< number of current coordinate levels
-  int cell_instance_;        //!< offset for distributed properties
-  vector<LocalCoord> coord_; //!< coordinates for all levels
+  // Cross section caches
+  vector<int> neutron_xs_nuclide_;   //!< Nuclide held in each entry of
+                                     //!< neutron_xs_ when compact
+  int neutron_xs_material_ {C_NONE}; //!< Material of the compact cache
+  vector<ElementMicroXS> photon_xs_; //!< Microscopic photon cross sections
+  vector<double> xs_cdf_; //!< Cumulative macroscopic total cross section over
+                          //!< the nuclides of the material, empty if not
+                          //!< stored by the last cross section lookup
+
+  int64_t id_;                 //!< Unique ID
+  int64_t geometry_state_ {0}; //!< incremented when the cell is searched for
 
   // Particle coordinates before crossing a surface
   int n_coord_last_ {1};  //!< number of current coordinates
   vector<int> cell_last_; //!< coordinates for all levels
 
   // Energy data
-  double E_;      //!< post-collision energy in eV
   double E_last_; //!< pre-collision energy in eV
   int g_ {0};     //!< post-collision energy group (MG only)
   int g_last_;    //!< pre-collision energy group (MG only)
 
   // Other physical data
-  double wgt_ {1.0};       //!< particle weight
   double mu_;              //!< angle of scatter
-  double time_ {0.0};      //!< time in [s]
   double time_last_ {0.0}; //!< previous time in [s]
 
   // Other physical data
@@ -279,26 +659,30 @@ private:
   // Indices for various arrays
   int surface_ {0};        //!< index for surface particle is on
   int cell_born_ {-1};     //!< index for cell particle was born in
-  int material_ {-1};      //!< index for current material
   int material_last_ {-1}; //!< index for last material
 
-  // Boundary information
-  BoundaryInfo boundary_;
+  // Surface senses at the location of the last cell search
+  SurfaceSenseCache sense_cache_;
+
+  // Location-dependent terms of the surface distances of recent cells
+  SurfaceDistanceCache distance_cache_;
+
+  // Last mesh bin found, which lookups through a const particle may update
+  mutable MeshBinCache mesh_bin_cache_;
 
   // Temperature of current cell
-  double sqrtkT_ {-1.0};     //!< sqrt(k_Boltzmann * temperature) in eV
   double sqrtkT_last_ {0.0}; //!< last temperature
+  int i_sqrtkT_ {-1};        //!< index in data::cell_sqrtkT of temperature
 
   // Statistical data
   int n_collision_ {0}; //!< number of collisions
 
+  // Whether the most recent advance was delta tracked
+  bool delta_tracked_ {false};
+
   // Track output
   bool write_track_ {false};
 
-  // Current PRNG state
-  uint64_t seeds_[N_STREAMS]; // current seeds
-  int stream_;                // current RNG stream
-
   // Secondary particle bank
   vector<SourceSite> secondary_bank_;
 
@@ -312,6 +696,10 @@ private:
 
   vector<NuBank> nu_bank_; // bank of most recently fissioned particles
 
+  // Energy deposited in pulse-height cells by this history, with one entry
+  // per cell that was deposited in
+  vector<EnergyDeposit> energy_deposits_;
+
   // Global tally accumulators
   double keff_tally_absorption_ {0.0};
   double keff_tally_collision_ {0.0};
@@ -320,32 +708,58 @@ private:
 
   bool trace_ {false}; //!< flag to show debug information
 
-  double collision_distance_; // distance to particle's next closest collision
-
   int n_event_ {0}; // number of events executed in this particle's history
 
   // Weight window information
   int n_split_ {0}; // Number of times this particle has been split
   double ww_factor_ {
     0.0}; // Particle-specific factor for on-the-fly weight window adjustment
+  int ww_energy_bin_ {C_NONE}; // Last weight window energy group
 
 // DagMC state variables
 #ifdef DAGMC
   moab::DagMC::RayHistory history_;
   Direction last_dir_;
+  DAGRayCache ray_cache_;
 #endif
 
   int64_t n_progeny_ {0}; // Number of progeny produced by this particle
 
+  //! Find the entry of the compact cache holding a nuclide, claiming an empty
+  //! entry if the nuclide is not present
+  int neutron_xs_slot(int i_nuclide);
+
+  //! Find the entry of the compact cache holding a nuclide without modifying
+  //! the cache. Nuclides that are not present are given zero cross sections.
+  const NuclideMicroXS& find_neutron_xs(int i_nuclide) const;
+
 public:
   //==========================================================================
   // Methods and accessors
 
-  NuclideMicroXS& neutron_xs(int i) { return neutron_xs_[i]; }
-  const NuclideMicroXS& neutron_xs(int i) const { return neutron_xs_[i]; }
+  NuclideMicroXS& neutron_xs(int i)
+  {
+    return neutron_xs_nuclide_.empty() ? neutron_xs_[i]
+                                       : neutron_xs_[this->neutron_xs_slot(i)];
+  }
+  const NuclideMicroXS& neutron_xs(int i) const
+  {
+    return neutron_xs_nuclide_.empty() ? neutron_xs_[i]
+                                       : this->find_neutron_xs(i);
+  }
   ElementMicroXS& photon_xs(int i) { return photon_xs_[i]; }
+  vector<double>& xs_cdf() { return xs_cdf_; }
+  const vector<double>& xs_cdf() const { return xs_cdf_; }
+#ifdef OPENMC_PARTICLE_SOA
+  MacroXS& macro_xs() { return ParticleSoA::macro_xs(slot_.index()); }
+  const MacroXS& macro_xs() const
+  {
+    return ParticleSoA::macro_xs(slot_.index());
+  }
+#else
   MacroXS& macro_xs() { return macro_xs_; }
   const MacroXS& macro_xs() const { return macro_xs_; }
+#endif
 
   int64_t& id() { return id_; }
   const int64_t& id() const { return id_; }
@@ -356,6 +770,8 @@ public:
   const int& n_coord() const { return n_coord_; }
   int& cell_instance() { return cell_instance_; }
   const int& cell_instance() const { return cell_instance_; }
+  int64_t& geometry_state() { return geometry_state_; }
+  const int64_t& geometry_state() const { return geometry_state_; }
   LocalCoord& coord(int i) { return coord_[i]; }
   const LocalCoord& coord(int i) const { return coord_[i]; }
   const vector<LocalCoord>& coord() const { return coord_; }
@@ -368,8 +784,13 @@ public:
   int& cell_last(int i) { return cell_last_[i]; }
   const int& cell_last(int i) const { return cell_last_[i]; }
 
+#ifdef OPENMC_PARTICLE_SOA
+  double& E() { return ParticleSoA::E(slot_.index()); }
+  const double& E() const { return ParticleSoA::E(slot_.index()); }
+#else
   double& E() { return E_; }
   const double& E() const { return E_; }
+#endif
   double& E_last() { return E_last_; }
   const double& E_last() const { return E_last_; }
   int& g() { return g_; }
@@ -377,15 +798,20 @@ public:
   int& g_last() { return g_last_; }
   const int& g_last() const { return g_last_; }
 
+#ifdef OPENMC_PARTICLE_SOA
+  double& wgt() { return ParticleSoA::wgt(slot_.index()); }
+  double wgt() const { return ParticleSoA::wgt(slot_.index()); }
+#else
   double& wgt() { return wgt_; }
   double wgt() const { return wgt_; }
+#endif
   double& mu() { return mu_; }
   const double& mu() const { return mu_; }
   double& time() { return time_; }
   const double& time() const { return time_; }
   double& time_last() { return time_last_; }
   const double& time_last() const { return time_last_; }
-  bool alive() const { return wgt_ != 0.0; }
+  bool alive() const { return wgt() != 0.0; }
 
   Position& r_last_current() { return r_last_current_; }
   const Position& r_last_current() const { return r_last_current_; }
@@ -414,21 +840,42 @@ public:
   const int& surface() const { return surface_; }
   int& cell_born() { return cell_born_; }
   const int& cell_born() const { return cell_born_; }
+#ifdef OPENMC_PARTICLE_SOA
+  int& material() { return ParticleSoA::material(slot_.index()); }
+  const int& material() const { return ParticleSoA::material(slot_.index()); }
+#else
   int& material() { return material_; }
   const int& material() const { return material_; }
+#endif
   int& material_last() { return material_last_; }
 
   BoundaryInfo& boundary() { return boundary_; }
+  const BoundaryInfo& boundary() const { return boundary_; }
+
+  SurfaceSenseCache& sense_cache() { return sense_cache_; }
+  SurfaceDistanceCache& distance_cache() { return distance_cache_; }
+  MeshBinCache& mesh_bin_cache() const { return mesh_bin_cache_; }
 
+#ifdef OPENMC_PARTICLE_SOA
+  double& sqrtkT() { return ParticleSoA::sqrtkT(slot_.index()); }
+  const double& sqrtkT() const { return ParticleSoA::sqrtkT(slot_.index()); }
+#else
   double& sqrtkT() { return sqrtkT_; }
   const double& sqrtkT() const { return sqrtkT_; }
+#endif
   double& sqrtkT_last() { return sqrtkT_last_; }
+  int& i_sqrtkT() { return i_sqrtkT_; }
+  const int& i_sqrtkT() const { return i_sqrtkT_; }
 
   int& n_collision() { return n_collision_; }
   const int& n_collision() const { return n_collision_; }
 
+  bool& delta_tracked() { return delta_tracked_; }
+  const bool& delta_tracked() const { return delta_tracked_; }
+
   bool& write_track() { return write_track_; }
   uint64_t& seeds(int i) { return seeds_[i]; }
+  const uint64_t& seeds(int i) const { return seeds_[i]; }
   uint64_t* seeds() { return seeds_; }
   int& stream() { return stream_; }
 
@@ -443,6 +890,7 @@ public:
   decltype(tracks_)& tracks() { return tracks_; }
   decltype(nu_bank_)& nu_bank() { return nu_bank_; }
   NuBank& nu_bank(int i) { return nu_bank_[i]; }
+  decltype(energy_deposits_)& energy_deposits() { return energy_deposits_; }
 
   double& keff_tally_absorption() { return keff_tally_absorption_; }
   double& keff_tally_collision() { return keff_tally_collision_; }
@@ -451,6 +899,7 @@ public:
 
   bool& trace() { return trace_; }
   double& collision_distance() { return collision_distance_; }
+  const double& collision_distance() const { return collision_distance_; }
   int& n_event() { return n_event_; }
 
   int n_split() const { return n_split_; }
@@ -459,9 +908,12 @@ public:
   double ww_factor() const { return ww_factor_; }
   double& ww_factor() { return ww_factor_; }
 
+  int& ww_energy_bin() { return ww_energy_bin_; }
+
 #ifdef DAGMC
   moab::DagMC::RayHistory& history() { return history_; }
   Direction& last_dir() { return last_dir_; }
+  DAGRayCache& ray_cache() { return ray_cache_; }
 #endif
 
   int64_t& n_progeny() { return n_progeny_; }
@@ -491,6 +943,19 @@ public:
   {
     for (auto& micro : neutron_xs_)
       micro.last_E = 0.0;
+    neutron_xs_material_ = C_NONE;
+  }
+
+  //! Drop microscopic neutron cross sections held in the compact cache when
+  //! the particle has entered a different material
+  //
+  //! \param i_material Index of the material the particle is in
+  void enter_material_neutron_xs(int i_material)
+  {
+    if (!neutron_xs_nuclide_.empty() && i_material != neutron_xs_material_) {
+      std::fill(neutron_xs_nuclide_.begin(), neutron_xs_nuclide_.end(), C_NONE);
+      neutron_xs_material_ = i_material;
+    }
   }
 
   //! resets all coordinate levels for the particle
@@ -519,6 +984,16 @@ public:
   }
 };
 
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Determine the number of entries needed in the compact microscopic cross
+//! section cache
+//
+//! \return Number of entries, or zero if the full cache would be no larger
+int compact_micro_xs_size();
+
 } // namespace openmc
 
 #endif // OPENMC_PARTICLE_DATA_H
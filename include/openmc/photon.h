@@ -10,6 +10,7 @@
 #include <gsl/gsl-lite.hpp>
 #include <hdf5.h>
 
+#include <functional> // for function
 #include <string>
 #include <unordered_map>
 #include <utility> // for pair
@@ -37,6 +38,54 @@ public:
   double n_electrons;
   double binding_energy;
   vector<Transition> transitions;
+  vector<double> transition_cdf; //!< Cumulative transition probabilities
+  vector<int> transition_guide;  //!< Guide table for transition_cdf
+  bool below_cutoff {false}; //!< Do vacancies here only yield particles below
+                             //!< the energy cutoffs?
+};
+
+//==============================================================================
+//! Inverse cumulative distributions of the cosine of a photon scattering
+//! angle on a logarithmic grid of incident energies
+//
+//! The variable tabulated is v = (1 - mu)/2, at equally spaced values of the
+//! cumulative probability. A cosine is sampled with a single random number by
+//! interpolating between the two grid energies around the incident energy at
+//! the same probability, so no rejection is needed.
+//==============================================================================
+
+class ScatteringTable {
+public:
+  //! Number of cumulative probabilities tabulated at each energy
+  static constexpr int N_LEVELS {129};
+
+  //! Number of energies in the grid
+  static constexpr int N_ALPHA {200};
+
+  //! Build the table from the unnormalized distribution of v
+  //
+  //! \param alpha_min Lowest photon energy over electron rest mass
+  //! \param alpha_max Highest photon energy over electron rest mass
+  //! \param integral Integral of the distribution of v between two values of
+  //!   v at a given alpha, as integral(alpha, v0, v1)
+  void build(double alpha_min, double alpha_max,
+    const std::function<double(double, double, double)>& integral);
+
+  //! Whether the table has been built
+  bool empty() const { return v_.empty(); }
+
+  //! Sample the cosine of the scattering angle
+  //
+  //! \param alpha Photon energy over electron rest mass
+  //! \param seed Pseudorandom seed pointer
+  //! 
+eturn Cosine of the scattering angle
+  double sample(double alpha, uint64_t* seed) const;
+
+private:
+  double log_alpha_min_; //!< Logarithm of the lowest energy on the grid
+  double inv_spacing_;   //!< Inverse spacing of the grid in log(alpha)
+  vector<double> v_;     //!< Values of v at each energy and probability
 };
 
 class PhotonInteraction {
@@ -48,6 +97,13 @@ public:
   // Methods
   void calculate_xs(Particle& p) const;
 
+  //! Calculate microscopic cross sections on a known energy grid interval
+  //
+  //! \param p Particle whose cached cross sections are updated
+  //! \param log_E Natural logarithm of the particle energy
+  //! \param i_grid Index of the interval on energy_ containing log_E
+  void calculate_xs(Particle& p, double log_E, int i_grid) const;
+
   void compton_scatter(double alpha, bool doppler, double* alpha_out,
     double* mu, int* i_shell, uint64_t* seed) const;
 
@@ -90,6 +146,9 @@ public:
   xt::xtensor<double, 2> profile_cdf_;
   xt::xtensor<double, 1> binding_energy_;
   xt::xtensor<double, 1> electron_pdf_;
+  vector<double> electron_cdf_;       //!< Cumulative sums of electron_pdf_
+  vector<int> electron_guide_;        //!< Guide table for electron_cdf_
+  vector<vector<int>> profile_guide_; //!< Guide tables for profile_cdf_ rows
 
   // Stopping power data
   double I_; // mean excitation energy
@@ -100,6 +159,11 @@ public:
   // Bremsstrahlung scaled DCS
   xt::xtensor<double, 2> dcs_;
 
+  // Tabulated angular distributions for coherent scattering and for
+  // incoherent scattering including the incoherent form factor
+  ScatteringTable coherent_table_;
+  ScatteringTable incoherent_table_;
+
   // Constant data
   static constexpr int MAX_STACK_SIZE =
     7; //!< maximum possible size of atomic relaxation stack
@@ -107,6 +171,10 @@ private:
   void compton_doppler(
     double alpha, double mu, double* E_out, int* i_shell, uint64_t* seed) const;
 
+  //! Build the tabulated angular distributions for coherent and incoherent
+  //! scattering over the energies at which photons are transported
+  void build_scattering_tables();
+
   //! Calculate the maximum size of the vacancy stack in atomic relaxation
   //
   //! These helper functions use the subshell transition data to calculate the
@@ -115,6 +183,15 @@ private:
   //! in atomic relaxation.
   int calc_max_stack_size() const;
   int calc_helper(std::unordered_map<int, int>& visited, int i_shell) const;
+
+  //! Determine whether every particle emitted in the cascade started by a
+  //! vacancy in a subshell is below the energy cutoffs, storing the result in
+  //! ElectronSubshell::below_cutoff for that subshell and the ones it visits
+  //
+  //! \param visited Subshells whose result has already been determined
+  //! \param i_shell Index in shells_ of the initial vacancy
+  //! \return Whether the cascade only emits particles below the cutoffs
+  bool calc_below_cutoff(vector<bool>& visited, int i_shell);
 };
 
 //==============================================================================
@@ -35,7 +35,9 @@ void sample_photon_reaction(Particle& p);
 //! Terminates the particle and either deposits all energy locally
 //! (electron_treatment = ElectronTreatment::LED) or creates secondary
 //! bremsstrahlung photons from electron deflections with charged particles
-//! (electron_treatment = ElectronTreatment::TTB).
+//! (electron_treatment = ElectronTreatment::TTB). With condensed history
+//! (electron_treatment = ElectronTreatment::CH), the electron continues unless
+//! it has reached the end of its range.
 void sample_electron_reaction(Particle& p);
 
 //! Terminates the particle and either deposits all energy locally
@@ -43,7 +45,9 @@ void sample_electron_reaction(Particle& p);
 //! bremsstrahlung photons from electron deflections with charged particles
 //! (electron_treatment = ElectronTreatment::TTB). Two annihilation photons of
 //! energy MASS_ELECTRON_EV (0.511 MeV) are created and travel in opposite
-//! directions.
+//! directions. With condensed history (electron_treatment =
+//! ElectronTreatment::CH), the positron annihilates only once it has reached
+//! the end of its range.
 void sample_positron_reaction(Particle& p);
 
 //! Sample a nuclide based on their total cross sections and densities within
@@ -61,8 +65,27 @@ int sample_element(Particle& p);
 
 Reaction& sample_fission(int i_nuclide, Particle& p);
 
-void sample_photon_product(
-  int i_nuclide, Particle& p, int* i_rx, int* i_product);
+//! Find the cumulative photon production cross section over the photon
+//! products of a nuclide at the energy of a particle
+//
+//! \param[in] i_nuclide Index of the nuclide
+//! \param[in] p Particle
+//! \param[out] cdf Cumulative cross section at each of the nuclide's
+//!   photon_products_
+//! \return Index in cdf of the last product whose reaction has a nonzero
+//!   cross section, or C_NONE
+int photon_product_cdf(int i_nuclide, Particle& p, vector<double>& cdf);
+
+//! Sample the reaction and product that produce a secondary photon
+//
+//! \param[in] i_nuclide Index of the nuclide
+//! \param[in] p Particle
+//! \param[in] cdf Cumulative cross section from photon_product_cdf()
+//! \param[in] i_last Index returned by photon_product_cdf()
+//! \param[out] i_rx Index of the sampled reaction
+//! \param[out] i_product Index of the sampled product of the reaction
+void sample_photon_product(int i_nuclide, Particle& p,
+  const vector<double>& cdf, int i_last, int* i_rx, int* i_product);
 
 void absorption(Particle& p, int i_nuclide);
 
@@ -73,6 +96,11 @@ void elastic_scatter(int i_nuclide, const Reaction& rx, double kT, Particle& p);
 
 void sab_scatter(int i_nuclide, int i_sab, Particle& p);
 
+//! records one resonance scattering target velocity sample and the number of
+//! rejection sampling trials it took, for the acceptance statistics reported
+//! at the end of the simulation
+void count_res_scat_sample(int64_t n_trial);
+
 //! samples the target velocity. The constant cross section free gas model is
 //! the default method. Methods for correctly accounting for the energy
 //! dependence of cross sections in treating resonance elastic scattering such
@@ -87,8 +115,8 @@ Direction sample_target_velocity(const Nuclide& nuc, double E, Direction u,
 Direction sample_cxs_target_velocity(
   double awr, double E, Direction u, double kT, uint64_t* seed);
 
-void sample_fission_neutron(int i_nuclide, const Reaction& rx, double E_in,
-  SourceSite* site, uint64_t* seed);
+void sample_fission_neutron(
+  int i_nuclide, const Reaction& rx, SourceSite* site, Particle& p);
 
 //! handles all reactions with a single secondary neutron (other than fission),
 //! i.e. level scattering, (n,np), (n,na), etc.
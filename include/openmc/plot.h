@@ -1,6 +1,8 @@
 #ifndef OPENMC_PLOT_H
 #define OPENMC_PLOT_H
 
+#include <algorithm> // for min, none_of
+#include <cmath>     // for ceil
 #include <sstream>
 #include <unordered_map>
 
@@ -15,6 +17,7 @@
 #include "openmc/particle.h"
 #include "openmc/position.h"
 #include "openmc/random_lcg.h"
+#include "openmc/universe.h"
 #include "openmc/xml_interface.h"
 
 namespace openmc {
@@ -155,8 +158,21 @@ T PlotBase::get_map() const
   xyz[in_i] = origin_[in_i] - width_[0] / 2. + in_pixel / 2.;
   xyz[out_i] = origin_[out_i] + width_[1] / 2. - out_pixel / 2.;
 
-  // arbitrary direction
+  // Fill the pixels of a row up to the next boundary at once, unless every
+  // pixel has to be checked for overlaps or the geometry uses DAGMC, where
+  // locating a point depends on the direction
+  bool march = !color_overlaps_ &&
+               std::none_of(model::universes.begin(), model::universes.end(),
+                 [](const unique_ptr<Universe>& u) {
+                   return u->geom_type() == GeometryType::DAG;
+                 });
+
+  // arbitrary direction, or along the rows when marching
   Direction dir = {0.7071, 0.7071, 0.0};
+  if (march) {
+    dir = {0.0, 0.0, 0.0};
+    dir[in_i] = 1.0;
+  }
 
 #pragma omp parallel
   {
@@ -167,14 +183,21 @@ T PlotBase::get_map() const
     int level = level_;
     int j {};
 
-#pragma omp for
+    // Scanlines take very different times to trace, so hand them out in turn
+#pragma omp for schedule(dynamic)
     for (int y = 0; y < height; y++) {
       p.r()[out_i] = xyz[out_i] - out_pixel * y;
+      bool found_cell = false;
       for (int x = 0; x < width; x++) {
         p.r()[in_i] = xyz[in_i] + in_pixel * x;
-        p.n_coord() = 1;
-        // local variables
-        bool found_cell = exhaustive_find_cell(p);
+        // Neighboring pixels are usually in the same cells and lattice tiles,
+        // so start from where the last pixel was found
+        if (found_cell) {
+          found_cell = find_cell_nearby(p);
+        } else {
+          p.n_coord() = 1;
+          found_cell = exhaustive_find_cell(p);
+        }
         j = p.n_coord() - 1;
         if (level >= 0) {
           j = level;
@@ -185,6 +208,17 @@ T PlotBase::get_map() const
         if (color_overlaps_ && check_cell_overlap(p, false)) {
           data.set_overlap(y, x);
         }
+
+        // Pixels closer than the next boundary along the row are in the same
+        // cell, so they do not need to be located
+        if (march && found_cell) {
+          double d = distance_to_boundary(p).distance;
+          double n_fill =
+            std::min(std::ceil(d / in_pixel) - 1., width - 1. - x);
+          for (int x_end = x + static_cast<int>(n_fill); x < x_end;) {
+            data.set_value(y, ++x, p, j);
+          }
+        }
       } // inner for
     }   // outer for
   }     // omp parallel
@@ -258,6 +292,13 @@ void output_png(Plot const& pl, const ImageData& data);
 void voxel_init(hid_t file_id, const hsize_t* dims, hid_t* dspace, hid_t* dset,
   hid_t* memspace);
 
+//! Open the voxel data in a file that already has it
+//! \param[in] id of an open hdf5 file
+//! \param[out] dataspace pointer to voxel data
+//! \param[out] dataset pointer to voxel data
+//! \param[out] pointer to memory space of voxel data
+void voxel_open(hid_t file_id, hid_t* dspace, hid_t* dset, hid_t* memspace);
+
 //! Write a section of the voxel data to hdf5
 //! \param[in] voxel slice
 //! \param[out] dataspace pointer to voxel data
@@ -0,0 +1,203 @@
+#ifndef OPENMC_PROFILE_H
+#define OPENMC_PROFILE_H
+
+//! \file profile.h
+//! \brief Counters of transport events and opt-in measurement of the time
+//! spent in parts of transport
+
+#include <chrono>
+#include <cstdint>
+
+#include "hdf5.h"
+
+#include "openmc/array.h"
+#include "openmc/constants.h"
+#include "openmc/settings.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+
+//==============================================================================
+// Constants and structs
+//==============================================================================
+
+// Parts of transport whose time is measured when profiling is enabled
+enum class ProfileRegion {
+  CALCULATE_XS,
+  DISTANCE_TO_BOUNDARY,
+  FIND_CELL,
+  COLLISION,
+  TALLY
+};
+
+constexpr int N_PROFILE_REGIONS {5};
+
+// Number of times a profiled region was entered and the time spent in it. The
+// total time includes the time spent in other profiled regions entered from
+// it, which is left out of the self time.
+struct ProfileCounter {
+  int64_t n_calls {0};
+  double total {0.0}; //!< Time in [s] including nested regions
+  double self {0.0};  //!< Time in [s] excluding nested regions
+};
+
+using ProfileCounters = array<ProfileCounter, N_PROFILE_REGIONS>;
+
+// Kinds of model domains that time is attributed to when profiling by domain:
+// cross section lookups and collisions by material, distance to boundary
+// calculations by cell, and scoring by tally
+enum class ProfileDomain { MATERIAL, CELL, TALLY };
+
+constexpr int N_PROFILE_DOMAINS {3};
+
+// Number of times time was attributed to a domain and the total time
+struct DomainCounter {
+  int64_t n_calls {0};
+  double time {0.0}; //!< Time in [s]
+};
+
+using DomainCounters = array<vector<DomainCounter>, N_PROFILE_DOMAINS>;
+
+// Transport events that are always counted. The order matches the counts
+// returned by openmc_get_performance_counters().
+enum class TransportEvent {
+  COLLISION,
+  XS_LOOKUP,
+  SURFACE_CROSSING,
+  LATTICE_CROSSING,
+  LOST_PARTICLE,
+  NEIGHBOR_LIST_HIT,
+  EXHAUSTIVE_SEARCH,
+  TALLY_SCORE
+};
+
+constexpr int N_TRANSPORT_EVENTS {8};
+
+//==============================================================================
+// Global variable declarations
+//==============================================================================
+
+namespace simulation {
+
+// Profile counters summed over all threads and processes, as of the last call
+// to reduce_profile()
+extern ProfileCounters profile_totals;
+
+// Counters of each material, cell, and tally summed over all threads and
+// processes, as of the last call to reduce_profile()
+extern DomainCounters profile_domain_totals;
+
+} // namespace simulation
+
+//==============================================================================
+//! Measures the time spent in a profiled region while it is in scope.
+//
+//! Scopes on a thread form a stack, so the time of a region entered from
+//! another one is subtracted from the self time of the outer region. A region
+//! entered again from within itself is only counted once.
+//==============================================================================
+
+class ProfileScope {
+public:
+  using clock = std::chrono::steady_clock;
+
+  explicit ProfileScope(ProfileRegion region)
+  {
+    if (settings::profile)
+      start(region);
+  }
+
+  ~ProfileScope()
+  {
+    if (active_)
+      stop();
+  }
+
+  // Scopes are linked to each other by address
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+  void start(ProfileRegion region);
+  void stop();
+
+  bool active_ {false};
+  ProfileRegion region_;
+  ProfileScope* parent_;    //!< Scope this one was entered from
+  clock::time_point start_; //!< Time the region was entered
+  double child_time_ {0.0}; //!< Time in [s] in regions entered from this one
+};
+
+//==============================================================================
+//! Attributes the time spent while it is in scope to a material, cell, or
+//! tally, or splits it equally between several tallies
+//==============================================================================
+
+class DomainScope {
+public:
+  using clock = std::chrono::steady_clock;
+
+  DomainScope(ProfileDomain domain, int32_t index)
+  {
+    if (settings::profile_domains && index >= 0)
+      start(domain, index, nullptr);
+  }
+
+  DomainScope(ProfileDomain domain, const vector<int>& indices)
+  {
+    if (settings::profile_domains)
+      start(domain, C_NONE, &indices);
+  }
+
+  ~DomainScope()
+  {
+    if (active_)
+      stop();
+  }
+
+  DomainScope(const DomainScope&) = delete;
+  DomainScope& operator=(const DomainScope&) = delete;
+
+private:
+  void start(
+    ProfileDomain domain, int32_t index, const vector<int>* indices);
+  void stop();
+
+  bool active_ {false};
+  ProfileDomain domain_;
+  int32_t index_;              //!< Index of the domain
+  const vector<int>* indices_; //!< Indices of domains sharing the time
+  clock::time_point start_;    //!< Time the domain was entered
+};
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Allocate and zero the event and profile counters of each thread, including
+//! the counters of each material, cell, and tally when profiling by domain
+void reset_profile();
+
+//! Count a transport event on the calling thread. Events outside of a
+//! simulation are not counted.
+//
+//! \param[in] event  Kind of event
+//! \param[in] n      Number of events
+void count_event(TransportEvent event, int64_t n = 1);
+
+//! Sum the profile counters of all threads and processes into
+//! simulation::profile_totals and simulation::profile_domain_totals. This must
+//! be called on all processes.
+void reduce_profile();
+
+//! Display the summed profile counters and the most expensive domains
+void print_profile();
+
+//! Write the summed profile counters to an HDF5 group
+//
+//! \param[in] group_id  HDF5 group to write to
+void write_profile(hid_t group_id);
+
+} // namespace openmc
+
+#endif // OPENMC_PROFILE_H
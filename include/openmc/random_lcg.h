@@ -17,13 +17,38 @@ constexpr int STREAM_VOLUME {3};
 constexpr int64_t DEFAULT_SEED {1};
 
 //==============================================================================
-//! Generate a pseudo-random number using a linear congruential generator.
+//! Generate a pseudo-random number using a linear congruential generator, or
+//! the Philox counter-based generator if built with OPENMC_RNG_PHILOX.
 //! @param seed Pseudorandom number seed pointer
 //! @return A random number between 0 and 1
 //==============================================================================
 
 double prn(uint64_t* seed);
 
+//==============================================================================
+//! Generate several pseudo-random numbers at once.
+//!
+//! The numbers are the same as those from calling `prn()` 'n' times. With the
+//! counter-based generator they are computed independently in SIMD lanes.
+//! @param seed Pseudorandom number seed pointer
+//! @param n The number of random numbers to generate
+//! @param values Array of 'n' random numbers between 0 and 1
+//==============================================================================
+
+void prn_batch(uint64_t* seed, int n, double* values);
+
+//==============================================================================
+//! Generate one pseudo-random number from each of several seeds.
+//!
+//! The numbers are the same as those from calling `prn()` once on each seed.
+//! Seeds are advanced independently, so the loop is computed in SIMD lanes.
+//! @param seeds Array of 'n' pseudorandom number seeds
+//! @param n The number of seeds
+//! @param values Array of 'n' random numbers between 0 and 1
+//==============================================================================
+
+void prn_lanes(uint64_t* seeds, int n, double* values);
+
 //==============================================================================
 //! Generate a random number which is 'n' times ahead from the current seed.
 //!
@@ -0,0 +1,57 @@
+//! \file random_ray.h
+//! \brief Random ray solver for multigroup problems with flat sources
+
+#ifndef OPENMC_RANDOM_RAY_H
+#define OPENMC_RANDOM_RAY_H
+
+#include <cstdint> // for int64_t
+
+#include "openmc/particle.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace simulation {
+
+//! First source region of each cell, or C_NONE if the cell isn't filled with a
+//! material. Each instance of a material cell is its own source region.
+extern vector<int64_t> source_region_offsets;
+
+extern int64_t n_source_regions; //!< Number of source regions
+
+//! Estimated volume of each source region in [cm^3]
+extern vector<double> source_region_volumes;
+
+//! Scalar flux of each source region averaged over active batches, indexed by
+//! region * number of groups + group. Fixed source fluxes are per source
+//! particle in [1/cm^2].
+extern vector<double> source_region_flux;
+
+//! Adjoint scalar flux of each source region for FW-CADIS weight window
+//! generation, indexed like source_region_flux
+extern vector<double> source_region_adjoint_flux;
+
+extern double random_ray_keff;     //!< Mean eigenvalue over active batches
+extern double random_ray_keff_std; //!< Standard deviation of the mean
+
+} // namespace simulation
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Find the source region that a located particle is in
+//
+//! \param p Particle whose cell and cell instance are known
+//! \return Index of the source region
+int64_t source_region(const Particle& p);
+
+void free_memory_random_ray();
+
+} // namespace openmc
+
+#endif // OPENMC_RANDOM_RAY_H
@@ -9,6 +9,8 @@
 #include "hdf5.h"
 #include <gsl/gsl-lite.hpp>
 
+#include "openmc/constants.h"
+#include "openmc/node_shared.h"
 #include "openmc/particle_data.h"
 #include "openmc/reaction_product.h"
 #include "openmc/vector.h"
@@ -26,7 +28,10 @@ public:
   //! Construct reaction from HDF5 data
   //! \param[in] group HDF5 group containing reaction data
   //! \param[in] temperatures Desired temperatures for cross sections
-  explicit Reaction(hid_t group, const vector<int>& temperatures);
+  //! \param[in] deferred Whether reading the cross section at each temperature
+  //!   is deferred until read_xs() is called. If empty, all are read.
+  explicit Reaction(hid_t group, const vector<int>& temperatures,
+    const vector<bool>& deferred = {});
 
   //! Calculate cross section given temperautre/grid index, interpolation factor
   //
@@ -46,16 +51,26 @@ public:
   //! \param[in] energy Energy group boundaries in [eV]
   //! \param[in] flux Flux in each energy group (not normalized per eV)
   //! \param[in] grid Nuclide energy grid
+  //! \param[in] indices Index of the grid interval containing each group
+  //!   boundary, as found by Nuclide::grid_indices()
   //! \return Reaction rate
   double collapse_rate(gsl::index i_temp, gsl::span<const double> energy,
-    gsl::span<const double> flux, const vector<double>& grid) const;
+    gsl::span<const double> flux, const NodeSharedArray<double>& grid,
+    gsl::span<const int> indices) const;
 
   //! Cross section at a single temperature
   struct TemperatureXS {
     int threshold;
-    vector<double> value;
+    NodeSharedArray<xs_real> value;
   };
 
+  //! Read the cross section at a single temperature
+  //
+  //! \param[in] group HDF5 group containing reaction data
+  //! \param[in] T Temperature in [K]
+  //! \return Cross section at the given temperature
+  static TemperatureXS read_xs(hid_t group, int T);
+
   int mt_;                           //!< ENDF MT value
   double q_value_;                   //!< Reaction Q value in [eV]
   bool scatter_in_cm_;               //!< scattering system in center-of-mass?
@@ -36,6 +36,13 @@ protected:
     xt::xtensor<int, 1>& in_gmin, xt::xtensor<int, 1>& in_gmax,
     double_2dvec& sparse_mult, double_3dvec& sparse_scatter);
 
+  //! \brief Builds the alias tables for sampling the outgoing group of each
+  //!   incoming group with at least MIN_ALIAS_GROUPS outgoing groups.
+  void build_alias_tables();
+
+  double_2dvec alias_prob;        // Probability of keeping each alias bin
+  vector<vector<int>> alias_bin;  // Outgoing group index aliased by each bin
+
 public:
   double_2dvec energy;            // Normalized p0 matrix for sampling Eout
   double_2dvec mult;              // nu-scatter multiplication (nu-scatt/scatt)
@@ -4,7 +4,10 @@
 #ifndef OPENMC_SEARCH_H
 #define OPENMC_SEARCH_H
 
-#include <algorithm> // for lower_bound, upper_bound
+#include <algorithm> // for lower_bound, upper_bound, min, max
+#include <cstddef>   // for size_t
+
+#include "openmc/vector.h"
 
 namespace openmc {
 
@@ -26,6 +29,46 @@ typename std::iterator_traits<It>::difference_type upper_bound_index(
   return std::upper_bound(first, last, value) - first - 1;
 }
 
+//! Build a guide table for searching a sorted array of values in [0, 1), such
+//! as a cumulative distribution. Entry g gives the number of values less than
+//! g / n_guide, limited to the last index, so a search for a value in the
+//! interval [g / n_guide, (g + 1) / n_guide) can start near its result.
+
+template<class It>
+vector<int> guide_table(It first, It last, std::size_t n_guide)
+{
+  vector<int> guide(n_guide);
+  int n = last - first;
+  int i = 0;
+  for (std::size_t g = 0; g < n_guide; ++g) {
+    double value = static_cast<double>(g) / n_guide;
+    while (i < n && first[i] < value)
+      ++i;
+    guide[g] = std::min(i, n - 1);
+  }
+  return guide;
+}
+
+//! Find the first index in [lo, hi] of a sorted array whose value is greater
+//! than xi, starting from the entry of a guide table built by guide_table().
+//! Returns hi + 1 if no value in the range is greater than xi.
+
+template<class It>
+int guide_search(It first, const vector<int>& guide, double xi, int lo, int hi)
+{
+  int i = lo;
+  if (!guide.empty()) {
+    std::size_t g = std::min(
+      static_cast<std::size_t>(xi * guide.size()), guide.size() - 1);
+    i = std::max(lo, std::min(guide[g], hi + 1));
+  }
+  while (i > lo && xi < first[i - 1])
+    --i;
+  while (i <= hi && xi >= first[i])
+    ++i;
+  return i;
+}
+
 } // namespace openmc
 
 #endif // OPENMC_SEARCH_H
@@ -28,6 +28,7 @@ public:
     xt::xtensor<double, 1> e_out;      //!< Outgoing energies [eV]
     xt::xtensor<double, 1> p;          //!< Probability density
     xt::xtensor<double, 1> c;          //!< Cumulative distribution
+    vector<int> c_guide;               //!< Guide table for searching c
     vector<unique_ptr<Tabular>> angle; //!< Angle distribution
   };
 
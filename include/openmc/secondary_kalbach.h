@@ -40,6 +40,7 @@ private:
     xt::xtensor<double, 1> e_out; //!< Outgoing energies [eV]
     xt::xtensor<double, 1> p;     //!< Probability density
     xt::xtensor<double, 1> c;     //!< Cumulative distribution
+    vector<int> c_guide;          //!< Guide table for searching c
     xt::xtensor<double, 1> r;     //!< Pre-compound fraction
     xt::xtensor<double, 1> a;     //!< Parameterized function
   };
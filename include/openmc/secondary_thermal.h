@@ -143,6 +143,8 @@ private:
     xt::xtensor<double, 1> e_out_pdf; //!< Probability density function
     xt::xtensor<double, 1> e_out_cdf; //!< Cumulative distribution function
     xt::xtensor<double, 2> mu; //!< Equiprobable angles at each outgoing energy
+    vector<int> cdf_guide; //!< Guide table of e_out_cdf over equal intervals
+                           //!< of the CDF built by guide_table()
   };
 
   vector<double> energy_;              //!< Incident energies
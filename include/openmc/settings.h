@@ -12,6 +12,7 @@
 
 #include "openmc/array.h"
 #include "openmc/constants.h"
+#include "openmc/position.h"
 #include "openmc/vector.h"
 
 namespace openmc {
@@ -24,40 +25,77 @@ namespace settings {
 
 // Boolean flags
 extern bool assume_separate;      //!< assume tallies are spatially separate?
+extern bool async_statepoint;     //!< write state points in the background?
+extern bool auto_tune;            //!< tune performance in inactive batches?
 extern bool check_overlaps;       //!< check overlaps in geometry?
 extern bool confidence_intervals; //!< use confidence intervals for results?
 extern bool
   create_fission_neutrons; //!< create fission neutrons (fixed source)?
 extern "C" bool cmfd_run;  //!< is a CMFD run?
+extern bool compact_bank; //!< exchange source sites in compact form?
+extern bool compact_micro_xs; //!< size micro xs caches by material?
+extern bool condense_relaxation; //!< skip relaxation below energy cutoffs?
+extern bool crossing_recovery; //!< nudge particles missing neighbor lists?
 extern bool
   delayed_photon_scaling;   //!< Scale fission photon yield to include delayed
+extern bool delta_tracking;          //!< use delta tracking in universes?
 extern "C" bool entropy_on; //!< calculate Shannon entropy?
 extern "C" bool
   event_based; //!< use event-based mode (instead of history-based)
+extern bool event_secondary_queue; //!< share secondaries between slots?
+extern bool fission_matrix_on; //!< tally fission matrix on entropy mesh?
+extern bool fw_cadis; //!< generate weight windows with FW-CADIS?
+extern bool huge_pages; //!< back large arrays with huge pages?
+extern bool lattice_dda; //!< update rect lattice distances incrementally?
 extern bool legendre_to_tabular; //!< convert Legendre distributions to tabular?
 extern bool material_cell_offsets; //!< create material cells offsets?
+extern bool mmap_source_files;     //!< sample source files from memory maps?
+extern bool mpi_progress_thread; //!< make MPI progress on a separate thread?
+extern bool numa_first_touch; //!< touch shared data with all threads first?
 extern "C" bool output_summary;    //!< write summary.h5?
 extern bool output_tallies;        //!< write tallies.out?
 extern bool particle_restart_run;  //!< particle restart run?
+extern bool partition_source_files; //!< read a slice of source files per rank?
+extern bool photon_scattering_tables; //!< tabulate photon scattering angles?
 extern "C" bool photon_transport;  //!< photon transport turned on?
+extern bool pipelined_bank;        //!< overlap bank exchange with transport?
+extern bool precompute_neighbors;  //!< fill neighbor lists before transport?
+extern bool profile;               //!< time parts of transport?
+extern bool profile_domains; //!< attribute time to materials/cells/tallies?
+extern bool random_ray; //!< solve with the random ray method?
 extern "C" bool reduce_tallies;    //!< reduce tallies at end of batch?
 extern bool res_scat_on;           //!< use resonance upscattering method?
 extern "C" bool restart_run;       //!< restart run?
 extern "C" bool run_CE;            //!< run with continuous-energy data?
 extern bool source_latest;         //!< write latest source at each batch?
 extern bool source_separate;       //!< write source to separate file?
+extern bool source_single_precision; //!< store source sites as floats?
 extern bool source_write;          //!< write source in HDF5 files?
+extern bool shared_cross_sections; //!< share nuclide data within a node?
 extern bool surf_source_write;     //!< write surface source file?
+extern bool surf_source_stream; //!< write surface sources as they're banked?
 extern bool surf_source_read;      //!< read surface source file?
+extern bool summary_compact;       //!< write summary geometry as tables?
+extern bool summary_reuse; //!< keep summary.h5 written from the same input?
 extern bool survival_biasing;      //!< use survival biasing?
+extern bool tally_rank_files;      //!< write tallies from each process?
+extern bool tally_stream;          //!< publish tally results each batch?
+extern bool temperature_lazy;      //!< load nuclide temperatures on use?
 extern bool temperature_multipole; //!< use multipole data?
+extern bool temperature_multipole_quadrature; //!< approximate far poles?
+extern bool track_delta_positions; //!< store track positions as differences?
+extern bool track_single_precision; //!< store track states as floats?
+extern bool track_writer_thread;   //!< write tracks from a background thread?
 extern "C" bool trigger_on;        //!< tally triggers enabled?
 extern bool trigger_predict;       //!< predict batches for triggers?
 extern bool ufs_on;                //!< uniform fission site method on?
+extern bool union_grid;            //!< use unionized material energy grids?
 extern bool urr_ptables_on;        //!< use unresolved resonance prob. tables?
+extern bool weight_window_mesh_crossings; //!< weight windows at mesh bins?
 extern bool weight_windows_on;     //!< are weight windows are enabled?
 extern bool write_all_tracks;      //!< write track files for every particle?
 extern bool write_initial_source;  //!< write out initial source file?
+extern bool xs_cdf; //!< store cumulative xs for nuclide sampling?
 
 // Paths to various files
 extern std::string path_cross_sections; //!< path to cross_sections.xml
@@ -66,6 +104,9 @@ extern std::string path_output; //!< directory where output files are written
 extern std::string path_particle_restart; //!< path to a particle restart file
 extern std::string path_sourcepoint;      //!< path to a source file
 extern "C" std::string path_statepoint;   //!< path to a statepoint file
+extern std::string path_xs_cache; //!< directory for cross section cache files
+extern std::string
+  tally_stream_path; //!< file that tally results stream to, if not default
 
 extern "C" int32_t n_inactive;         //!< number of inactive batches
 extern "C" int32_t max_lost_particles; //!< maximum number of lost particles
@@ -77,24 +118,68 @@ extern "C" int64_t n_particles;   //!< number of particles per generation
 
 extern int64_t
   max_particles_in_flight; //!< Max num. event-based particles in flight
+extern int64_t
+  event_xs_batch_size; //!< Max particles per batched event-based XS lookup
+extern EventSchedule event_schedule; //!< Order of event-based kernels
+extern int64_t
+  event_sort_threshold; //!< Min event queue size that is sorted
+extern int64_t
+  event_min_queue_size; //!< Min queue size for ordered event kernels
+extern double
+  event_refill_threshold; //!< In-flight fraction that triggers source refill
+extern HistorySchedule
+  history_schedule; //!< Distribution of histories among threads
+extern int64_t
+  work_chunk_size; //!< Fixed source histories claimed at once by a process
+extern int64_t io_stripe_size; //!< File system stripe size for parallel I/O
+extern int64_t
+  tallies_out_max_bins; //!< Max results per tally written to tallies.out
 
+extern vector<double>
+  census_times; //!< Times in [s] at which particles are banked and combed
+extern int
+  fission_matrix_interval; //!< Inactive batches between source corrections
+extern double
+  crossing_recovery_distance; //!< Distance in [cm] particles are nudged
+extern double delta_tracking_max_ratio; //!< Max ratio of majorant to total
+                                       //!< xs at which to delta track
+extern vector<int32_t>
+  delta_tracking_universes; //!< IDs of delta-tracked universes (all if empty)
 extern ElectronTreatment
   electron_treatment; //!< how to treat secondary electrons
+extern double
+  electron_step_fraction; //!< Condensed history step as fraction of range
 extern array<double, 4>
   energy_cutoff; //!< Energy cutoff in [eV] for each particle type
 extern int
   legendre_to_tabular_points; //!< number of points to convert Legendres
 extern int max_order;         //!< Maximum Legendre order for multigroup data
 extern int n_log_bins;        //!< number of bins for logarithmic energy grid
+extern int hash_grid_points_per_bin; //!< target grid points per hash bin
+extern int
+  ifp_n_generation; //!< Generations of ancestors for IFP tallies, 0 if off
 extern int n_batches;         //!< number of (inactive+active) batches
 extern int n_max_batches;     //!< Maximum number of batches
 extern int max_tracks; //!< Maximum number of particle tracks written to file
+extern bool
+  overlap_check_crossings; //!< check overlaps only after boundary crossings?
+extern double
+  overlap_check_fraction; //!< Fraction of events at which overlaps are checked
+extern double
+  random_ray_distance_active; //!< Ray length in [cm] that is tallied
+extern double random_ray_distance_inactive; //!< Dead zone length in [cm]
+extern Position
+  random_ray_lower_left; //!< Lower-left corner of ray starting box
+extern Position
+  random_ray_upper_right; //!< Upper-right corner of ray starting box
 extern ResScatMethod res_scat_method; //!< resonance upscattering method
 extern double res_scat_energy_min; //!< Min energy in [eV] for res. upscattering
 extern double res_scat_energy_max; //!< Max energy in [eV] for res. upscattering
 extern vector<std::string>
   res_scat_nuclides;     //!< Nuclides using res. upscattering treatment
 extern RunMode run_mode; //!< Run mode (eigenvalue, fixed src, etc.)
+extern int64_t secondary_bank_capacity; //!< Secondary sites kept per thread
+extern int source_compression; //!< Deflate level for source banks in files
 extern std::unordered_set<int>
   sourcepoint_batch; //!< Batches when source should be written
 extern std::unordered_set<int>
@@ -104,6 +189,9 @@ extern std::unordered_set<int>
 extern int max_splits; //!< maximum number of particle splits for weight windows
 extern int64_t max_surface_particles; //!< maximum number of particles to be
                                       //!< banked on surfaces per process
+extern int tally_reduce_interval; //!< Batches between tally reductions
+extern vector<int>
+  tally_stream_tallies; //!< IDs of the tallies to stream, or all if empty
 extern TemperatureMethod
   temperature_method; //!< method for choosing temperatures
 extern double
@@ -114,12 +202,17 @@ extern array<double, 2>
 extern int trace_batch;        //!< Batch to trace particle on
 extern int trace_gen;          //!< Generation to trace particle on
 extern int64_t trace_particle; //!< Particle ID to enable trace on
+extern int track_compression;      //!< Deflate level for track datasets
+extern double track_fraction;      //!< Fraction of particles to write tracks
 extern vector<array<int, 3>>
   track_identifiers;               //!< Particle numbers for writing tracks
+extern vector<double>
+  track_region; //!< Lower-left/upper-right corners of region for tracks
 extern int trigger_batch_interval; //!< Batch interval for triggers
 extern "C" int verbosity;          //!< How verbose to make output
 extern double weight_cutoff;       //!< Weight cutoff for Russian roulette
 extern double weight_survive;      //!< Survival weight after Russian roulette
+extern double wielandt_shift;      //!< Wielandt shift of the eigenvalue
 } // namespace settings
 
 //==============================================================================
@@ -4,6 +4,11 @@
 //! \file shared_array.h
 //! \brief Shared array data structure
 
+#include <algorithm> // for copy
+#include <atomic>
+#include <cstddef> // for size_t
+#include <cstdint> // for int64_t
+
 #include "openmc/memory.h"
 
 namespace openmc {
@@ -20,6 +25,15 @@ namespace openmc {
 // call the thread_safe_append() function concurrently and store data to the
 // object at the index returned from thread_safe_append() safely, but no other
 // operations are protected.
+//
+// The container can optionally grow past its capacity into a limited number of
+// overflow chunks, each as large as the reserved capacity. A chunk is
+// allocated exactly once, by the first thread to append into it, while other
+// threads overflowing into the same chunk wait for it, so appends never wait
+// on a reallocation of the whole array. Elements in the chunks can't be
+// accessed until consolidate() is called after appending is finished, which
+// moves all elements into one array. Once they are no longer needed,
+// restore_capacity() returns to the reserved capacity.
 template<typename T>
 class SharedArray {
 
@@ -35,11 +49,16 @@ public:
   //
   //! \param capacity The number of elements for the container to allocate
   //! space for
-  SharedArray(int64_t capacity) : capacity_(capacity)
+  SharedArray(int64_t capacity) : capacity_(capacity), reserved_(capacity)
   {
     data_ = make_unique<T[]>(capacity);
   }
 
+  SharedArray(SharedArray&&) = default;
+  SharedArray& operator=(SharedArray&&) = default;
+
+  ~SharedArray() { this->free_chunks(); }
+
   //==========================================================================
   // Methods and Accessors
 
@@ -52,10 +71,21 @@ public:
   //! reserve() does not change the size of the container.
   //
   //! \param capacity The number of elements to allocate in the container
-  void reserve(int64_t capacity)
+  //! \param max_chunks The number of overflow chunks of capacity elements
+  //! that the container may grow into
+  void reserve(int64_t capacity, int max_chunks = 0)
   {
+    this->free_chunks();
     data_ = make_unique<T[]>(capacity);
     capacity_ = capacity;
+    reserved_ = capacity;
+    max_chunks_ = max_chunks;
+    if (max_chunks > 0) {
+      chunks_ = make_unique<std::atomic<T*>[]>(max_chunks);
+      for (int i = 0; i < max_chunks; ++i) {
+        chunks_[i] = nullptr;
+      }
+    }
   }
 
   //! Increase the size of the container by one and append value to the
@@ -77,9 +107,30 @@ public:
 
     // Check that we haven't written off the end of the array
     if (idx >= capacity_) {
+      int64_t limit = capacity_ + reserved_ * max_chunks_;
+      if (idx >= limit) {
 #pragma omp atomic write seq_cst
-      size_ = capacity_;
-      return -1;
+        size_ = limit;
+        return -1;
+      }
+
+      // Store the element in an overflow chunk. The first thread to overflow
+      // into the chunk allocates it while any others wait for it.
+      int64_t offset = idx - capacity_;
+      int i_chunk = offset / reserved_;
+      T* chunk = chunks_[i_chunk].load(std::memory_order_acquire);
+      if (!chunk) {
+#pragma omp critical(SharedArrayChunk)
+        {
+          chunk = chunks_[i_chunk].load(std::memory_order_relaxed);
+          if (!chunk) {
+            chunk = new T[reserved_];
+            chunks_[i_chunk].store(chunk, std::memory_order_release);
+          }
+        }
+      }
+      chunk[offset % reserved_] = value;
+      return idx;
     }
 
     // Copy element value to the array
@@ -88,13 +139,55 @@ public:
     return idx;
   }
 
+  //! Move elements stored in overflow chunks into the main array, growing
+  //! its capacity to hold them. This must not be called while other threads
+  //! are appending to the container.
+  void consolidate()
+  {
+    if (size_ <= capacity_)
+      return;
+
+    int n_chunks = (size_ - capacity_ - 1) / reserved_ + 1;
+    int64_t capacity = capacity_ + reserved_ * n_chunks;
+    auto data = make_unique<T[]>(capacity);
+    std::copy(data_.get(), data_.get() + capacity_, data.get());
+    for (int i = 0; i < n_chunks; ++i) {
+      int64_t start = capacity_ + reserved_ * i;
+      int64_t n = std::min(size_ - start, reserved_);
+      T* chunk = chunks_[i].load();
+      std::copy(chunk, chunk + n, data.get() + start);
+    }
+    this->free_chunks();
+    data_ = std::move(data);
+    capacity_ = capacity;
+  }
+
+  //! Shrink the container back to the capacity it was reserved with after
+  //! consolidate() has grown it. Elements up to the reserved capacity are
+  //! kept, so this must only be called once the size is no larger than it.
+  void restore_capacity()
+  {
+    if (capacity_ <= reserved_)
+      return;
+
+    auto data = make_unique<T[]>(reserved_);
+    std::copy(data_.get(), data_.get() + std::min(size_, reserved_),
+      data.get());
+    data_ = std::move(data);
+    capacity_ = reserved_;
+  }
+
   //! Free any space that was allocated for the container. Set the
   //! container's size and capacity to 0.
   void clear()
   {
+    this->free_chunks();
     data_.reset();
+    chunks_.reset();
     size_ = 0;
     capacity_ = 0;
+    reserved_ = 0;
+    max_chunks_ = 0;
   }
 
   //! Return the number of elements in the container
@@ -111,17 +204,43 @@ public:
   //! space for.
   int64_t capacity() { return capacity_; }
 
+  //! Return the memory allocated for elements in bytes, including the
+  //! overflow chunks that have been allocated
+  size_t nbytes() const
+  {
+    int64_t n = capacity_;
+    for (int i = 0; i < max_chunks_; ++i) {
+      if (chunks_[i].load())
+        n += reserved_;
+    }
+    return n * sizeof(T);
+  }
+
   //! Return pointer to the underlying array serving as element storage.
   T* data() { return data_.get(); }
   const T* data() const { return data_.get(); }
 
 private:
+  //! Free the overflow chunks that have been allocated
+  void free_chunks()
+  {
+    if (!chunks_)
+      return;
+    for (int i = 0; i < max_chunks_; ++i) {
+      delete[] chunks_[i].exchange(nullptr);
+    }
+  }
+
   //==========================================================================
   // Data members
 
   unique_ptr<T[]> data_; //!< An RAII handle to the elements
   int64_t size_ {0};     //!< The current number of elements
   int64_t capacity_ {0}; //!< The total space allocated for elements
+  int64_t reserved_ {0}; //!< Capacity requested by reserve()
+  int max_chunks_ {0};   //!< Number of overflow chunks allowed
+  unique_ptr<std::atomic<T*>[]> chunks_; //!< Overflow chunks of reserved_
+                                         //!< elements
 };
 
 } // namespace openmc
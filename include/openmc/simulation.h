@@ -5,6 +5,7 @@
 #define OPENMC_SIMULATION_H
 
 #include "openmc/mesh.h"
+#include "openmc/message_passing.h"
 #include "openmc/particle.h"
 #include "openmc/vector.h"
 
@@ -40,13 +41,22 @@ extern "C" bool satisfy_triggers;  //!< have tally triggers been satisfied?
 extern "C" int total_gen;          //!< total number of generations simulated
 extern double total_weight;        //!< Total source weight in a batch
 extern int64_t work_per_rank;      //!< number of particles per MPI rank
+extern int n_micro_xs_compact;     //!< entries in compact micro xs cache
+extern int64_t n_res_scat_samples; //!< resonance scattering velocity samples
+extern int64_t n_res_scat_trials;  //!< rejection trials for those samples
 
 extern const RegularMesh* entropy_mesh;
 extern const RegularMesh* ufs_mesh;
 
 extern vector<double> k_generation;
+extern vector<double>
+  log_grid_energy; //!< Energies in [eV] at logarithmic grid boundaries
 extern vector<int64_t> work_index;
 
+#ifdef OPENMC_MPI
+extern MPI_Win work_counter; //!< Histories claimed by all processes
+#endif
+
 } // namespace simulation
 
 //==============================================================================
@@ -59,6 +69,26 @@ void allocate_banks();
 //! Determine number of particles to transport per process
 void calculate_work();
 
+//! Whether fixed source histories are claimed in chunks by each process rather
+//! than divided evenly among processes
+bool dynamic_work();
+
+//! Create the counter of histories claimed by all processes
+void create_work_counter();
+
+//! Free the counter of histories claimed by all processes
+void free_work_counter();
+
+//! Set the counter of claimed histories to zero at the start of a generation
+void reset_work_counter();
+
+//! Claim the next chunk of histories in the current generation
+//! \param[out] i_begin Index of the first history, relative to the first
+//!   history given to this process by calculate_work()
+//! \param[out] i_end Index one past the last history
+//! \return Whether any histories were left to claim
+bool claim_work_chunk(int64_t* i_begin, int64_t* i_end);
+
 //! Initialize nuclear data before a simulation
 void initialize_data();
 
@@ -69,7 +99,14 @@ void initialize_batch();
 void initialize_generation();
 
 //! Full initialization of a particle history
-void initialize_history(Particle& p, int64_t index_source);
+//! \param p Particle to initialize
+//! \param index_source Index of the history in this generation, starting at 1
+//! \param site Source site of a fixed source history, or nullptr to sample it
+void initialize_history(
+  Particle& p, int64_t index_source, const SourceSite* site = nullptr);
+
+//! ID of a fixed source history, which seeds the sampling of its source site
+int64_t fixed_source_id(int64_t index_source);
 
 //! Finalize a batch
 //!
@@ -90,6 +127,10 @@ void broadcast_results();
 
 void free_memory_simulation();
 
+//! Pick the history-based transport loop instantiated for the optional
+//! features (see TransportFeature) that the model uses
+void select_transport_features();
+
 //! Simulate a single particle history (and all generated secondary particles,
 //!  if enabled), from birth to death
 void transport_history_based_single_particle(Particle& p);
@@ -97,6 +138,11 @@ void transport_history_based_single_particle(Particle& p);
 //! Simulate all particle histories using history-based parallelism
 void transport_history_based();
 
+//! Simulate a range of particle histories using history-based parallelism
+//! \param[in] i_begin Index in the source bank of the first particle
+//! \param[in] i_end Index in the source bank one past the last particle
+void transport_history_based(int64_t i_begin, int64_t i_end);
+
 //! Simulate all particle histories using event-based parallelism
 void transport_event_based();
 
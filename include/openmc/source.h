@@ -4,6 +4,7 @@
 #ifndef OPENMC_SOURCE_H
 #define OPENMC_SOURCE_H
 
+#include "hdf5.h"
 #include "pugixml.hpp"
 
 #include "openmc/distribution_multi.h"
@@ -23,6 +24,19 @@ namespace openmc {
 constexpr int EXTSRC_REJECT_THRESHOLD {10000};
 constexpr double EXTSRC_REJECT_FRACTION {0.05};
 
+// Number of source sites sampled together by sample_external_sources()
+constexpr int EXTSRC_BATCH_SIZE {256};
+
+// Number of source sites sampled to normalize the weights of a biased source
+constexpr int EXTSRC_BIAS_SAMPLES {100000};
+
+// Box sources whose fraction of accepted positions is below this are sampled
+// from a grid of the voxels where positions can be accepted
+constexpr double EXTSRC_GRID_ACCEPT_FRACTION {0.1};
+constexpr int EXTSRC_GRID_SAMPLES {10000}; // Positions sampled to decide
+constexpr int EXTSRC_GRID_DIM {32};        // Voxels along each axis of the box
+constexpr int EXTSRC_GRID_VOXEL_SAMPLES {8}; // Positions sampled per voxel
+
 //==============================================================================
 // Global variables
 //==============================================================================
@@ -47,6 +61,13 @@ public:
   virtual SourceSite sample(uint64_t* seed) const = 0;
 
   // Methods that can be overridden
+
+  //! Sample one site with each of several seeds. The sites are the same as
+  //! those from calling sample() once with each seed.
+  //! \param[inout] seeds Array of 'n' pseudorandom seeds
+  //! \param[in] n Number of sites to sample
+  //! \param[out] sites Array of 'n' sampled sites
+  virtual void sample_batch(uint64_t* seeds, int n, SourceSite* sites) const;
   virtual double strength() const { return 1.0; }
 };
 
@@ -65,9 +86,32 @@ public:
   //! \return Sampled site
   SourceSite sample(uint64_t* seed) const override;
 
+  //! Sample from the external source distribution with several seeds
+  //! \param[inout] seeds Array of 'n' pseudorandom seeds
+  //! \param[in] n Number of sites to sample
+  //! \param[out] sites Array of 'n' sampled sites
+  void sample_batch(uint64_t* seeds, int n, SourceSite* sites) const override;
+
+  //! Bias the source by an importance map. Sites are sampled with a density
+  //! proportional to the source times their importance and given weights
+  //! inversely proportional to it, normalized to a mean of one.
+  //! \param[in] mesh_idx Index of the mesh in model::meshes
+  //! \param[in] energy_bounds Energy group boundaries in [eV]
+  //! \param[in] importance Importance in each mesh bin within each energy
+  //!   group, zero where it is unknown
+  void set_importance(int32_t mesh_idx, const vector<double>& energy_bounds,
+    const vector<double>& importance);
+
+  //! Find the voxels of a box source where positions can be accepted if few
+  //! positions in the box are, so that positions are only sampled in them.
+  //! Voxels are found by sampling positions in each, so a region much smaller
+  //! than a voxel can be missed.
+  void build_domain_grid();
+
   // Properties
   ParticleType particle_type() const { return particle_; }
   double strength() const override { return strength_; }
+  double mean_importance() const { return bias_mean_; }
 
   // Make observing pointers available
   SpatialDistribution* space() const { return space_.get(); }
@@ -76,12 +120,57 @@ public:
   Distribution* time() const { return time_.get(); }
 
 private:
+  //! Sample a site from the source distributions without any biasing
+  //! \param[inout] seed Pseudorandom seed pointer
+  //! \return Sampled site
+  SourceSite sample_unbiased(uint64_t* seed) const;
+
+  //! Find the importance of a site, which is the smallest importance in the
+  //! map where it is unknown
+  double importance(const SourceSite& site) const;
+
+  //! Sample a position uniformly in the voxels of the domain grid
+  //! \param[inout] seed Pseudorandom seed pointer
+  //! \return Sampled position
+  Position sample_domain_grid(uint64_t* seed) const;
+
+  //! Check whether a position is in the geometry and, if the source is
+  //! restricted to fissionable material, in a fissionable material
+  bool accept_position(Position r) const;
+
+  //! Stop if too large a fraction of sampled positions has been rejected
+  //! \param[in] n_reject Number of rejections for the current site
+  static void reject_position(int n_reject);
+
+  //! Stop if a discrete energy is outside the range of the cross sections
+  void check_energy_range() const;
+
+  //! Check whether an energy is within the range of the cross sections
+  bool accept_energy(double E) const;
+
+  static int64_t n_accept_; //!< Number of accepted source positions
+
   ParticleType particle_ {ParticleType::neutron}; //!< Type of particle emitted
   double strength_ {1.0};                         //!< Source strength
   UPtrSpace space_;                               //!< Spatial distribution
   UPtrAngle angle_;                               //!< Angular distribution
   UPtrDist energy_;                               //!< Energy distribution
   UPtrDist time_;                                 //!< Time distribution
+
+  //! Mesh spatial distribution, if it has an energy distribution per element
+  const MeshSpatial* mesh_space_ {nullptr};
+
+  // Importance biasing
+  int32_t bias_mesh_ {C_NONE};  //!< Index of the importance mesh
+  vector<double> bias_energy_;  //!< Importance energy group boundaries [eV]
+  vector<double> bias_importance_; //!< Importance in each bin and group
+  double bias_floor_ {0.0};     //!< Importance where it is unknown
+  double bias_max_ {0.0};       //!< Largest importance of sampled sites
+  double bias_mean_ {1.0};      //!< Mean importance of unbiased sites
+
+  // Domain grid of a box source
+  vector<int> grid_voxels_; //!< Voxels where positions can be accepted
+  Position grid_width_;     //!< Width of each voxel
 };
 
 //==============================================================================
@@ -90,14 +179,42 @@ private:
 
 class FileSource : public Source {
 public:
-  // Constructors
+  // Constructors, destructors
   explicit FileSource(std::string path);
+  ~FileSource();
+
+  // A memory-mapped file is unmapped when the source is destroyed, so the
+  // source cannot be copied
+  FileSource(const FileSource&) = delete;
+  FileSource& operator=(const FileSource&) = delete;
 
   // Methods
   SourceSite sample(uint64_t* seed) const override;
 
+  //! Read the sites into memory instead of sampling them from a memory map if
+  //! the simulation writes to the source file
+  void unmap_if_written();
+
 private:
+  //! Read the source bank in a file into memory
+  //
+  //! \param[in] file_id HDF5 identifier of the open source file
+  void read_sites(hid_t file_id);
+
+  //! Map the source bank in a file to memory if it is stored contiguously
+  //! with the same layout as source sites in memory
+  //
+  //! \param[in] path Path to the source file
+  //! \param[in] file_id HDF5 identifier of the open source file
+  //! \return Whether the source bank was mapped
+  bool map_sites(const std::string& path, hid_t file_id);
+
+  std::string path_;         //!< Path to the source file
   vector<SourceSite> sites_; //!< Source sites from a file
+  const SourceSite* mapped_sites_ {nullptr}; //!< Sites in a mapped file
+  size_t n_mapped_sites_ {0};                //!< Number of mapped sites
+  void* mapping_ {nullptr};                  //!< Start of mapped pages
+  size_t mapping_size_ {0};                  //!< Size of mapped pages
 };
 
 //==============================================================================
@@ -116,6 +233,11 @@ public:
     return custom_source_->sample(seed);
   }
 
+  void sample_batch(uint64_t* seeds, int n, SourceSite* sites) const override
+  {
+    custom_source_->sample_batch(seeds, n, sites);
+  }
+
   double strength() const override { return custom_source_->strength(); }
 
 private:
@@ -138,6 +260,15 @@ extern "C" void initialize_source();
 //! \return Sampled source site
 SourceSite sample_external_source(uint64_t* seed);
 
+//! Sample sites from all external source distributions for a contiguous range
+//! of source IDs. Each site is the same as the one from calling
+//! sample_external_source() with the source stream seed of its ID, but the
+//! distributions are sampled for many sites at once.
+//! \param[in] id_begin Source ID of the first site
+//! \param[in] n Number of sites to sample
+//! \param[out] sites Array of 'n' sampled sites
+void sample_external_sources(int64_t id_begin, int64_t n, SourceSite* sites);
+
 void free_memory_source();
 
 } // namespace openmc
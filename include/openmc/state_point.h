@@ -2,6 +2,7 @@
 #define OPENMC_STATE_POINT_H
 
 #include <cstdint>
+#include <string>
 
 #include "hdf5.h"
 
@@ -11,14 +12,78 @@
 
 namespace openmc {
 
+//==============================================================================
+// Constants
+//==============================================================================
+
+// Number of unstructured mesh elements whose tally results are computed and
+// passed to the mesh at once
+constexpr int UMESH_RESULTS_CHUNK_SIZE {65536};
+
 void load_state_point();
+
+//! HDF5 datatype of source sites in memory
+hid_t h5banktype();
+
+//! HDF5 datatype of source sites stored with single precision positions and
+//! directions
+hid_t h5banktype_single();
+
+//! Dataset creation property list for a source bank, which is chunked and
+//! compressed when requested
+hid_t source_bank_dcpl(hid_t filetype, hsize_t n_sites);
+
 vector<int64_t> calculate_surf_source_size();
+
+//! Create the file that surface source sites are streamed to as they are
+//! banked, surface_source.h5 or, with several processes, one
+//! surface_source.<rank>.h5 per process
+void open_surf_source_stream();
+
+//! Append surface source sites to the streamed file. Only one thread may call
+//! this at a time.
+//
+//! \param[in] sites Sites to write
+void write_surf_source_stream(const vector<SourceSite>& sites);
+
+//! Write the sites remaining in the thread buffers and close the streamed file
+void close_surf_source_stream();
 void write_source_point(const char* filename, bool surf_source_bank = false);
+
+//! Close an in-memory file and write its image to disk in the background
+void file_close_async(hid_t file_id, const std::string& filename);
+
+//! Wait for a file being written in the background to be complete
+void finish_async_writes();
+
 void write_source_bank(hid_t group_id, bool surf_source_bank);
 void read_source_bank(
   hid_t group_id, vector<SourceSite>& sites, bool distribute);
+
+//! Open the source bank dataset in a group, making sure that its members
+//! match those of the source bank datatype
+hid_t open_source_bank(hid_t group_id, hid_t banktype);
+
+//! Read the slice of the source bank in a group that belongs to this process
+void read_source_bank_partition(hid_t group_id, vector<SourceSite>& sites);
 void write_tally_results_nr(hid_t file_id);
+void write_tally_results_rank(const std::string& filename);
+void write_tally_results_parallel(hid_t file_id);
+
+//! Read the sums and sums of squares of a tally written by
+//! write_tally_results_parallel, with each process reading a range of filter
+//! bins collectively. The results are gathered on the master process.
+void read_tally_results_parallel(
+  hid_t group_id, hsize_t n_filter, hsize_t n_score, double* results);
+
+//! Read the tally results that this process wrote with
+//! write_tally_results_rank, along with the number of realizations of each
+//! tally in the state point
+void read_tally_results_rank(hid_t file_id, const std::string& filename);
 void restart_set_keff();
+
+//! Write tally results on unstructured meshes to files in the mesh library's
+//! format, one per tally
 void write_unstructured_mesh_results();
 
 } // namespace openmc
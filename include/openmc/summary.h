@@ -1,6 +1,8 @@
 #ifndef OPENMC_SUMMARY_H
 #define OPENMC_SUMMARY_H
 
+#include <string>
+
 #include <hdf5.h>
 
 namespace openmc {
@@ -11,6 +13,26 @@ void write_nuclides(hid_t file);
 void write_geometry(hid_t file);
 void write_materials(hid_t file);
 
+//! Write all cells as one table of datasets rather than a group per cell
+void write_cells_compact(hid_t cells_group);
+
+//! Write all universes as one table of datasets rather than a group per
+//! universe
+void write_universes_compact(hid_t universes_group);
+
+//! Hash the inputs that determine the contents of the summary file
+std::string summary_input_hash();
+
+//! Check whether a summary file exists that was written from the same inputs
+bool summary_is_current(const std::string& filename, const std::string& hash);
+
+//! Set cell temperatures from the datasets of a properties file
+int import_cell_temperatures(hid_t cells_group, const std::string& filename);
+
+//! Set material densities from the datasets of a properties file
+int import_material_densities(
+  hid_t materials_group, const std::string& filename);
+
 } // namespace openmc
 
 #endif // OPENMC_SUMMARY_H
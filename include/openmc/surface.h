@@ -1,6 +1,7 @@
 #ifndef OPENMC_SURFACE_H
 #define OPENMC_SURFACE_H
 
+#include <cstdint>
 #include <limits> // For numeric_limits
 #include <string>
 #include <unordered_map>
@@ -11,6 +12,7 @@
 #include "openmc/boundary_condition.h"
 #include "openmc/constants.h"
 #include "openmc/memory.h" // for unique_ptr
+#include "openmc/neighbor_list.h"
 #include "openmc/particle.h"
 #include "openmc/position.h"
 #include "openmc/vector.h"
@@ -22,10 +24,12 @@ namespace openmc {
 //==============================================================================
 
 class Surface;
+class SurfaceStore;
 
 namespace model {
 extern std::unordered_map<int, int> surface_map;
 extern vector<unique_ptr<Surface>> surfaces;
+extern SurfaceStore surface_store;
 } // namespace model
 
 //==============================================================================
@@ -89,6 +93,12 @@ public:
   GeometryType geom_type_;   //!< Geometry type indicator (CSG or DAGMC)
   bool surf_source_ {false}; //!< Activate source banking for the surface?
 
+  //! Cells in which particles crossing the surface were found after missing
+  //! the neighbor list of the cell they left, tried first when recovering
+  NeighborList neighbors_;
+  int64_t n_search_failures_ {0}; //!< Neighbor list misses after crossing
+  int64_t n_recoveries_ {0};      //!< Misses recovered without a search
+
   explicit Surface(pugi::xml_node surf_node);
   Surface();
 
@@ -422,6 +432,59 @@ public:
   double x0_, y0_, z0_, A_, B_, C_;
 };
 
+//==============================================================================
+//! Contiguous copy of the CSG surfaces used during transport.
+//!
+//! The coefficients of all CSG surfaces are packed into one array and tagged
+//! with the surface type, so evaluating a surface is a switch rather than a
+//! virtual call on a separately allocated object. Surfaces of any other type,
+//! e.g. DAGMC surfaces, are forwarded to their polymorphic interface. The
+//! functions below give the same results as those of Surface and take the
+//! index of the surface in model::surfaces.
+//==============================================================================
+
+class SurfaceStore {
+public:
+  //! Pack the coefficients of all surfaces in model::surfaces
+  void build();
+
+  void clear();
+
+  double evaluate(int32_t i_surf, Position r) const;
+  double distance(
+    int32_t i_surf, Position r, Direction u, bool coincident) const;
+  Direction normal(int32_t i_surf, Position r) const;
+  bool sense(int32_t i_surf, Position r, Direction u) const;
+
+private:
+  enum class Kind : uint8_t {
+    X_PLANE,
+    Y_PLANE,
+    Z_PLANE,
+    PLANE,
+    X_CYLINDER,
+    Y_CYLINDER,
+    Z_CYLINDER,
+    SPHERE,
+    X_CONE,
+    Y_CONE,
+    Z_CONE,
+    QUADRIC,
+    X_TORUS,
+    Y_TORUS,
+    Z_TORUS,
+    OTHER
+  };
+
+  struct Entry {
+    Kind kind;      //!< Type of the surface
+    int32_t offset; //!< Index of the first coefficient in coeffs_
+  };
+
+  vector<Entry> entries_; //!< One entry per surface in model::surfaces
+  vector<double> coeffs_; //!< Packed surface coefficients
+};
+
 //==============================================================================
 // Non-member functions
 //==============================================================================
@@ -0,0 +1,81 @@
+#ifndef OPENMC_TALLIES_BIN_LOOKUP_H
+#define OPENMC_TALLIES_BIN_LOOKUP_H
+
+#include <cstdint>
+#include <unordered_map>
+
+#include <gsl/gsl-lite.hpp>
+
+#include "openmc/vector.h"
+
+namespace openmc {
+
+//==============================================================================
+//! Finds the bin of a value among the increasing edges of a filter. When the
+//! edges are equally spaced, the bin is computed directly instead of being
+//! found by binary search.
+//==============================================================================
+
+class BinLookup {
+public:
+  //! Check whether bin edges are equally spaced
+  //
+  //! \param edges Strictly increasing bin edges
+  void set_edges(gsl::span<const double> edges);
+
+  //! Find the bin containing a value, with the same result as
+  //! lower_bound_index(), so a value equal to an interior edge is put in the
+  //! lower bin
+  //
+  //! \param edges Bin edges passed to set_edges()
+  //! \param x Value within the first and last edges
+  //! \return Index of the bin
+  int find(gsl::span<const double> edges, double x) const;
+
+  bool uniform() const { return uniform_; }
+
+  //! Width of each bin if the edges are equally spaced
+  double width() const { return width_; }
+
+private:
+  bool uniform_ {false}; //!< Whether the edges are equally spaced
+  double start_;         //!< First edge
+  double width_;         //!< Width of each bin
+  double inv_width_;     //!< Inverse of the width of each bin
+};
+
+//==============================================================================
+//! Maps the indices of domains such as cells or materials to filter bins. When
+//! the number of domains is reasonable, the bins are stored in an array indexed
+//! by domain so that no hashing is needed to find them.
+//==============================================================================
+
+class IndexBinMap {
+public:
+  //! Set the domain binned by each bin
+  //
+  //! \param indices Index of the domain for each bin
+  //! \param n_domains Number of domains of this kind in the model
+  void set(gsl::span<const int32_t> indices, int32_t n_domains);
+
+  //! Find the bin of a domain
+  //
+  //! \param index Index of the domain
+  //! eturn Index of the bin, or -1 if the domain is not binned
+  int find(int32_t index) const
+  {
+    if (dense_) {
+      return (index >= 0 && index < bins_.size()) ? bins_[index] : -1;
+    }
+    auto search = map_.find(index);
+    return search != map_.end() ? search->second : -1;
+  }
+
+private:
+  bool dense_ {false};                   //!< Whether bins_ is used
+  vector<int> bins_;                     //!< Bin of each domain, or -1
+  std::unordered_map<int32_t, int> map_; //!< Bin of each binned domain
+};
+
+} // namespace openmc
+#endif // OPENMC_TALLIES_BIN_LOOKUP_H
@@ -82,6 +82,11 @@ public:
   //! "Incoming Energy [0.625E-6, 20.0)".
   virtual std::string text_label(int bin) const = 0;
 
+  //! Whether the matching bins depend only on the cells and material the
+  //! particle is in, in which case they stay valid until the particle's cell
+  //! is searched for again
+  virtual bool geometric() const { return false; }
+
   //----------------------------------------------------------------------------
   // Accessors
 
@@ -119,6 +124,10 @@ namespace model {
 extern "C" int32_t n_filters;
 extern std::unordered_map<int, int> filter_map;
 extern vector<unique_ptr<Filter>> tally_filters;
+
+//! For each filter, the index of an earlier filter that always matches the
+//! same bins, whose matches are reused, or C_NONE
+extern vector<int32_t> filter_shared_match;
 } // namespace model
 
 //==============================================================================
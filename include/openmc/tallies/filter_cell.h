@@ -2,10 +2,10 @@
 #define OPENMC_TALLIES_FILTER_CELL_H
 
 #include <cstdint>
-#include <unordered_map>
 
 #include <gsl/gsl-lite.hpp>
 
+#include "openmc/tallies/bin_lookup.h"
 #include "openmc/tallies/filter.h"
 #include "openmc/vector.h"
 
@@ -36,6 +36,8 @@ public:
 
   std::string text_label(int bin) const override;
 
+  bool geometric() const override { return true; }
+
   //----------------------------------------------------------------------------
   // Accessors
 
@@ -43,6 +45,12 @@ public:
 
   void set_cells(gsl::span<int32_t> cells);
 
+  //! Find the bin of a cell
+  //
+  //! \param cell Index of the cell in the global cells vector
+  //! \return Index of the bin, or -1 if the cell is not binned
+  int search(int32_t cell) const;
+
 protected:
   //----------------------------------------------------------------------------
   // Data members
@@ -51,7 +59,10 @@ protected:
   vector<int32_t> cells_;
 
   //! A map from cell indices to filter bin indices.
-  std::unordered_map<int32_t, int> map_;
+  IndexBinMap map_;
+
+  //! Whether each universe contains any of the binned cells
+  vector<bool> universe_binned_;
 };
 
 } // namespace openmc
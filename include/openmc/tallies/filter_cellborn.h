@@ -22,6 +22,8 @@ public:
     FilterMatch& match) const override;
 
   std::string text_label(int bin) const override;
+
+  bool geometric() const override { return false; }
 };
 
 } // namespace openmc
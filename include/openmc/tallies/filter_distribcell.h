@@ -32,6 +32,8 @@ public:
 
   std::string text_label(int bin) const override;
 
+  bool geometric() const override { return true; }
+
   //----------------------------------------------------------------------------
   // Accessors
 
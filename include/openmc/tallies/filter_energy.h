@@ -41,7 +41,24 @@ public:
 
   bool matches_transport_groups() const { return matches_transport_groups_; }
 
+  //! Find the bin containing an energy
+  //
+  //! \param E Energy in [eV]
+  //! \return Index of the bin, or -1 if the energy is outside of the bins
+  int search(double E) const;
+
 protected:
+  //----------------------------------------------------------------------------
+  // Types
+
+  //! How the bin of an energy is found
+  enum class BinSearch {
+    BINARY,      //!< Binary search over the bin edges
+    LINEAR,      //!< Computed directly for equal-width bins
+    LOGARITHMIC, //!< Computed directly for equal-lethargy bins
+    HASH         //!< Binary search within a cell of a lethargy hash grid
+  };
+
   //----------------------------------------------------------------------------
   // Data members
 
@@ -49,6 +66,22 @@ protected:
 
   //! True if transport group number can be used directly to get bin number
   bool matches_transport_groups_ {false};
+
+  BinSearch search_ {BinSearch::BINARY}; //!< Method used to find bins
+
+  //! Lower edge of the uniform grid (energy or log of energy) used to compute
+  //! bins or hash cells and the inverse width of its intervals
+  double grid_start_;
+  double grid_inv_width_;
+
+  //! Bin containing the lower edge of each hash cell
+  vector<int> hash_bins_;
+
+  //! Minimum number of bins for which bins are not found by binary search
+  static constexpr int MIN_DIRECT_BINS {16};
+
+  //! Number of hash cells per bin
+  static constexpr int HASH_CELLS_PER_BIN {4};
 };
 
 //==============================================================================
@@ -1,6 +1,8 @@
 #ifndef OPENMC_TALLIES_FILTERMATCH_H
 #define OPENMC_TALLIES_FILTERMATCH_H
 
+#include <cstdint> // for int64_t
+
 namespace openmc {
 
 //==============================================================================
@@ -13,6 +15,9 @@ public:
   vector<double> weights_;
   int i_bin_;
   bool bins_present_ {false};
+  int64_t geometry_state_ {-1}; //!< Particle geometry state the bins were
+                                //!< found for, or -1 if only valid for the
+                                //!< current event
 };
 
 } // namespace openmc
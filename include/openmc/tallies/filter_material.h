@@ -2,10 +2,10 @@
 #define OPENMC_TALLIES_FILTER_MATERIAL_H
 
 #include <cstdint>
-#include <unordered_map>
 
 #include <gsl/gsl-lite.hpp>
 
+#include "openmc/tallies/bin_lookup.h"
 #include "openmc/tallies/filter.h"
 #include "openmc/vector.h"
 
@@ -36,6 +36,8 @@ public:
 
   std::string text_label(int bin) const override;
 
+  bool geometric() const override { return true; }
+
   //----------------------------------------------------------------------------
   // Accessors
 
@@ -53,7 +55,7 @@ private:
   vector<int32_t> materials_;
 
   //! A map from material indices to filter bin indices.
-  std::unordered_map<int32_t, int> map_;
+  IndexBinMap map_;
 };
 
 } // namespace openmc
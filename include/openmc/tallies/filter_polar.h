@@ -5,6 +5,7 @@
 
 #include <gsl/gsl-lite.hpp>
 
+#include "openmc/tallies/bin_lookup.h"
 #include "openmc/tallies/filter.h"
 #include "openmc/vector.h"
 
@@ -45,6 +46,7 @@ private:
   // Data members
 
   vector<double> bins_;
+  BinLookup lookup_; //!< Finds the bin of a value among bins_
 };
 
 } // namespace openmc
@@ -0,0 +1,163 @@
+#ifndef OPENMC_TALLIES_FLUX_SPECTRUM_H
+#define OPENMC_TALLIES_FLUX_SPECTRUM_H
+
+#include <algorithm> // for min
+#include <atomic>
+#include <cmath> // for log
+#include <cstdint>
+
+#include <gsl/gsl-lite.hpp>
+
+#include "openmc/memory.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+
+//==============================================================================
+//! Fine-group flux spectrum in each of a set of materials, used to collapse
+//! reaction rates for depletion.
+//
+//! The groups are equally spaced in lethargy, so the group of an energy is
+//! computed directly rather than searched for. Track-length estimates of the
+//! flux are accumulated in single precision to halve the memory needed for
+//! tens of thousands of groups in thousands of materials. When the spectrum is
+//! sparse, the groups of each material are stored in blocks that are only
+//! allocated once a group in the block has been scored, as for
+//! SparseTallyResults.
+//==============================================================================
+
+class FluxSpectrum {
+public:
+  //! Number of groups per block of a sparse spectrum
+  static constexpr int BLOCK_SIZE {256};
+
+  //----------------------------------------------------------------------------
+  // Constructors, destructors
+
+  FluxSpectrum() = default;
+  ~FluxSpectrum() { this->free_blocks(); }
+
+  // The spectrum owns its blocks, so it cannot be copied.
+  FluxSpectrum(const FluxSpectrum&) = delete;
+  FluxSpectrum& operator=(const FluxSpectrum&) = delete;
+
+  //----------------------------------------------------------------------------
+  // Accessors
+
+  //! Whether a spectrum has been requested
+  bool on() const { return n_groups_ > 0; }
+
+  //! Whether the spectrum is being scored, i.e. during active batches
+  bool active() const { return active_; }
+
+  void set_active(bool active) { active_ = active && this->on(); }
+
+  int n_groups() const { return n_groups_; }
+
+  const vector<int32_t>& materials() const { return materials_; }
+
+  //! Group boundaries in [eV]
+  const vector<double>& energy() const { return energy_; }
+
+  //----------------------------------------------------------------------------
+  // Methods
+
+  //! Set the materials and groups of the spectrum, discarding any results
+  //
+  //! \param materials Indices of the materials in the global materials vector
+  //! \param n_groups Number of groups, or zero to turn the spectrum off
+  //! \param E_min Lower boundary of the lowest group in [eV]
+  //! \param E_max Upper boundary of the highest group in [eV]
+  //! \param sparse Whether to allocate the groups only once they are scored
+  void set(gsl::span<const int32_t> materials, int n_groups, double E_min,
+    double E_max, bool sparse);
+
+  //! Turn the spectrum off and free its memory
+  void clear();
+
+  //! Add a track-length estimate of the flux
+  //
+  //! \param material Index of the material in the global materials vector
+  //! \param E Energy of the particle in [eV]
+  //! \param flux Weight times track length
+  void score(int32_t material, double E, double flux)
+  {
+    if (material < 0 || material >= material_index_.size())
+      return;
+    int i = material_index_[material];
+    if (i < 0 || E < E_min_ || E >= E_max_)
+      return;
+
+    int g = std::min(
+      static_cast<int>(std::log(E / E_min_) * inv_width_), n_groups_ - 1);
+    float* x;
+    if (sparse_) {
+      size_t i_block = static_cast<size_t>(i) * n_blocks_ + g / BLOCK_SIZE;
+      x = this->allocate(i_block) + g % BLOCK_SIZE;
+    } else {
+      x = &values_[static_cast<size_t>(i) * n_groups_ + g];
+    }
+#pragma omp atomic
+    *x += static_cast<float>(flux);
+  }
+
+  //! Add the starting weight of the particles of an active batch
+  void add_weight(double weight) { weight_ += weight; }
+
+  //! Zero the spectrum while keeping its memory
+  void reset();
+
+  //! Sum the spectrum over all processes, leaving the result on every process
+  void reduce();
+
+  //! Get the flux of one material per unit source weight
+  //
+  //! \param i Index of the material in materials()
+  //! \param flux Flux in each group
+  void get(int i, double* flux) const;
+
+private:
+  //! Values in a block of a sparse spectrum, allocating it first if needed
+  float* allocate(size_t i_block)
+  {
+    float* x = blocks_[i_block].load(std::memory_order_acquire);
+    if (x)
+      return x;
+    float* new_block = new float[BLOCK_SIZE]();
+    if (blocks_[i_block].compare_exchange_strong(
+          x, new_block, std::memory_order_acq_rel, std::memory_order_acquire))
+      return new_block;
+    delete[] new_block;
+    return x;
+  }
+
+  //! Free the blocks of a sparse spectrum
+  void free_blocks();
+
+  bool active_ {false};          //!< Whether the spectrum is being scored
+  bool sparse_ {false};          //!< Whether values are stored in blocks
+  int n_groups_ {0};             //!< Number of groups
+  int n_blocks_ {0};             //!< Number of blocks per material
+  double E_min_;                 //!< Lower boundary of the lowest group
+  double E_max_;                 //!< Upper boundary of the highest group
+  double inv_width_;             //!< Inverse lethargy width of each group
+  double weight_ {0.0};          //!< Source weight of the scored batches
+  vector<int32_t> materials_;    //!< Indices of the materials
+  vector<int> material_index_;   //!< Index in materials_ of each material
+  vector<double> energy_;        //!< Group boundaries
+  vector<float> values_;         //!< Flux of each material and group
+  unique_ptr<std::atomic<float*>[]> blocks_; //!< Blocks of a sparse spectrum
+  size_t n_blocks_total_ {0};                //!< Number of blocks
+};
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace model {
+extern FluxSpectrum flux_spectrum;
+} // namespace model
+
+} // namespace openmc
+
+#endif // OPENMC_TALLIES_FLUX_SPECTRUM_H
@@ -0,0 +1,163 @@
+#ifndef OPENMC_TALLIES_SPARSE_RESULTS_H
+#define OPENMC_TALLIES_SPARSE_RESULTS_H
+
+#include <algorithm> // for min
+#include <atomic>
+#include <cstddef> // for size_t
+
+#include "hdf5.h"
+
+#include "openmc/constants.h"
+#include "openmc/memory.h"
+
+namespace openmc {
+
+//==============================================================================
+//! Tally results stored in blocks of filter bins that are only allocated once
+//! a bin in the block has been scored.
+//
+//! Each block holds the results for BLOCK_SIZE consecutive filter bins laid
+//! out the same way as the dense (filter bin, score, result) array, so a block
+//! can be handed to any code that works on a slice of dense results.  Blocks
+//! are claimed with a compare-and-swap, so threads can score concurrently
+//! without locks.  Bins in unallocated blocks have all results equal to zero.
+//==============================================================================
+
+class SparseTallyResults {
+public:
+  //! Number of filter bins per block
+  static constexpr int BLOCK_SIZE {64};
+
+  SparseTallyResults(int n_filter_bins, int n_scores)
+    : n_filter_bins_ {n_filter_bins}, n_scores_ {n_scores},
+      blocks_ {make_unique<std::atomic<double*>[]>(this->n_blocks())}
+  {
+    for (int i = 0; i < this->n_blocks(); ++i)
+      blocks_[i].store(nullptr, std::memory_order_relaxed);
+  }
+
+  ~SparseTallyResults()
+  {
+    for (int i = 0; i < this->n_blocks(); ++i)
+      delete[] blocks_[i].load(std::memory_order_relaxed);
+  }
+
+  // The results own their blocks, so they cannot be copied.
+  SparseTallyResults(const SparseTallyResults&) = delete;
+  SparseTallyResults& operator=(const SparseTallyResults&) = delete;
+
+  //----------------------------------------------------------------------------
+  // Accessors
+
+  int n_filter_bins() const { return n_filter_bins_; }
+  int n_scores() const { return n_scores_; }
+  int n_blocks() const
+  {
+    return (n_filter_bins_ + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  }
+
+  //! Number of filter bins in a block, which is less than BLOCK_SIZE only for
+  //! the last block
+  int block_bins(int i_block) const
+  {
+    return std::min(BLOCK_SIZE, n_filter_bins_ - i_block * BLOCK_SIZE);
+  }
+
+  //! Number of values stored in a block
+  size_t block_size(int i_block) const
+  {
+    return static_cast<size_t>(this->block_bins(i_block)) * n_scores_ * 3;
+  }
+
+  //! Values in a block, or nullptr if the block has not been allocated
+  double* block(int i_block) const
+  {
+    return blocks_[i_block].load(std::memory_order_acquire);
+  }
+
+  //! Get a single result, which is zero if the block has not been allocated
+  double operator()(int filter_index, int score_index, TallyResult r) const
+  {
+    const double* x = this->block(filter_index / BLOCK_SIZE);
+    if (!x)
+      return 0.0;
+    return x[this->offset(filter_index, score_index, r)];
+  }
+
+  //----------------------------------------------------------------------------
+  // Methods
+
+  //! Values in a block, allocating it first if needed
+  double* allocate(int i_block)
+  {
+    double* x = this->block(i_block);
+    if (x)
+      return x;
+
+    // Another thread may allocate the same block in the meantime, in which
+    // case its block is used and this one is discarded
+    double* new_block = new double[this->block_size(i_block)]();
+    if (blocks_[i_block].compare_exchange_strong(
+          x, new_block, std::memory_order_acq_rel, std::memory_order_acquire))
+      return new_block;
+    delete[] new_block;
+    return x;
+  }
+
+  //! Add a score to the value of a single bin
+  void add(int filter_index, int score_index, double score)
+  {
+    double* x = this->allocate(filter_index / BLOCK_SIZE);
+#pragma omp atomic
+    x[this->offset(filter_index, score_index, TallyResult::VALUE)] += score;
+  }
+
+  //! Memory held by the allocated blocks and the table of blocks in [bytes]
+  size_t nbytes() const
+  {
+    size_t n = 0;
+    for (int i = 0; i < this->n_blocks(); ++i) {
+      if (this->block(i))
+        n += this->block_size(i);
+    }
+    return sizeof(double) * n + sizeof(std::atomic<double*>) * this->n_blocks();
+  }
+
+  //! Zero all results while keeping the allocated blocks
+  void reset();
+
+  //! Add the values from all processes in the master process and zero them
+  //! on the others
+  void reduce();
+
+  //! Copy the results on the master process to all other processes
+  void broadcast();
+
+  //! Write the sums and sums of squares to a "results" dataset in a group.
+  //
+  //! The dataset has the same shape as the one for dense results, but it is
+  //! chunked by block so that unallocated blocks take no space in the file.
+  void write(hid_t group_id) const;
+
+  //! Read the sums and sums of squares from the "results" dataset in a group,
+  //! allocating only blocks that have nonzero values
+  void read(hid_t group_id);
+
+private:
+  //! Position of a result within its block
+  size_t offset(int filter_index, int score_index, TallyResult r) const
+  {
+    return (static_cast<size_t>(filter_index % BLOCK_SIZE) * n_scores_ +
+             score_index) *
+             3 +
+           static_cast<int>(r);
+  }
+
+  int n_filter_bins_;                          //!< Number of filter bins
+  int n_scores_;                               //!< Number of scores
+  unique_ptr<std::atomic<double*>[]> blocks_; //!< Values in each block
+};
+
+} // namespace openmc
+
+#endif // OPENMC_TALLIES_SPARSE_RESULTS_H
@@ -2,8 +2,11 @@
 #define OPENMC_TALLIES_TALLY_H
 
 #include "openmc/constants.h"
+#include "openmc/huge_pages.h"
 #include "openmc/memory.h" // for unique_ptr
+#include "openmc/openmp_interface.h"
 #include "openmc/tallies/filter.h"
+#include "openmc/tallies/sparse_results.h"
 #include "openmc/tallies/trigger.h"
 #include "openmc/vector.h"
 
@@ -17,6 +20,18 @@
 
 namespace openmc {
 
+class Particle;
+
+//! Function computing a score for a tracklength or collision estimator.
+//! Returns false if the particle cannot contribute to the score.
+using ScoreKernel = bool (*)(
+  Particle& p, int i_nuclide, double atom_density, double flux, double& score);
+
+//! Dense tally values, which may be backed by huge pages
+template<std::size_t N>
+using TallyArray = xt::xtensor<double, N, XTENSOR_DEFAULT_LAYOUT,
+  PageAllocator<double, PageUse::TALLIES>>;
+
 //==============================================================================
 //! A user-specified flux-weighted (or current) measurement.
 //==============================================================================
@@ -56,6 +71,14 @@ public:
   //! Given already-set filters, set the stride lengths
   void set_strides();
 
+  //! Given already-set filters, set the order in which they are evaluated and
+  //! the particle types and energies that can contribute to the tally
+  void set_filter_plan();
+
+  //! Filter indices in the order they are evaluated, with cheap and selective
+  //! filters first so that events they reject are found quickly
+  const vector<int32_t>& filter_order() const { return filter_order_; }
+
   int32_t strides(int i) const { return strides_[i]; }
 
   int32_t n_filter_bins() const { return n_filter_bins_; }
@@ -71,9 +94,86 @@ public:
 
   void init_results();
 
+  //! Memory held by the results, including thread-private and sparse results,
+  //! in [bytes]
+  size_t memory_usage() const;
+
   void reset();
 
-  void accumulate();
+  //! Accumulate the values scored since the last call into the sums
+  //! \param n_batches Number of batches that the values were scored over
+  void accumulate(int n_batches = 1);
+
+  //! Add a score to the value of a single bin of the results
+  //! \param filter_index Index of the filter combination
+  //! \param score_index Index of the score
+  //! \param score Value to add
+  void add_score(int filter_index, int score_index, double score)
+  {
+    if (sparse_results_) {
+      sparse_results_->add(filter_index, score_index, score);
+    } else if (!thread_results_.empty()) {
+#ifdef _OPENMP
+      int tid = omp_get_thread_num();
+#else
+      int tid = 0;
+#endif
+      thread_results_[tid](filter_index, score_index) += score;
+    } else {
+#pragma omp atomic
+      results_(filter_index, score_index, TallyResult::VALUE) += score;
+    }
+  }
+
+  //! Add scores to consecutive score bins of a single filter bin
+  //! \param filter_index Index of the filter combination
+  //! \param score_index Index of the first score
+  //! \param scores Values to add
+  //! \param n Number of values
+  void add_scores(
+    int filter_index, int score_index, const double* scores, int n)
+  {
+    if (sparse_results_) {
+      for (int i = 0; i < n; ++i) {
+        if (scores[i] != 0.0)
+          sparse_results_->add(filter_index, score_index + i, scores[i]);
+      }
+    } else if (!thread_results_.empty()) {
+#ifdef _OPENMP
+      int tid = omp_get_thread_num();
+#else
+      int tid = 0;
+#endif
+      double* row = &thread_results_[tid](filter_index, score_index);
+#pragma omp simd
+      for (int i = 0; i < n; ++i)
+        row[i] += scores[i];
+    } else {
+      for (int i = 0; i < n; ++i) {
+        if (scores[i] != 0.0) {
+#pragma omp atomic
+          results_(filter_index, score_index + i, TallyResult::VALUE) +=
+            scores[i];
+        }
+      }
+    }
+  }
+
+  //! Check whether the tally only scores reaction rates that are precalculated
+  //! for depletion, so that all of its nuclides can be scored in one pass
+  void init_depletion_rates();
+
+  //! Add the values scored in thread-private buffers to results_ and clear
+  //! the buffers
+  void reduce_thread_results();
+
+  //! Get a single result from either the dense or the sparse results
+  double result(int filter_index, int score_index, TallyResult r) const
+  {
+    if (sparse_results_)
+      return (*sparse_results_)(filter_index, score_index, r);
+    return results_(filter_index, score_index, static_cast<int>(r));
+  }
 
   //! A string representing the i-th score on this tally
   std::string score_name(int score_idx) const;
@@ -93,6 +193,9 @@ public:
   //! Event type that contributes to this tally
   TallyEstimator estimator_ {TallyEstimator::TRACKLENGTH};
 
+  //! Whether the estimator was chosen by the user rather than by default
+  bool estimator_specified_ {false};
+
   //! Whether this tally is currently being updated
   bool active_ {false};
 
@@ -101,18 +204,42 @@ public:
 
   vector<int> scores_; //!< Filter integrands (e.g. flux, fission)
 
+  //! Kernel for each score used by continuous-energy tracklength and
+  //! collision estimators, or nullptr if the score has no kernel
+  vector<ScoreKernel> score_kernels_;
+
   //! Index of each nuclide to be tallied.  -1 indicates total material.
   vector<int> nuclides_ {-1};
 
+  //! True if all nuclides and reactions of the tally are scored in one pass
+  //! from the reaction rates precalculated for depletion
+  bool depletion_rates_ {false};
+
+  //! For each score of a depletion rate tally, the index in
+  //! NuclideMicroXS::reaction of its cross section, or DEPLETION_RX.size() for
+  //! fission
+  vector<int> depletion_rx_;
+
   //! Results for each bin -- the first dimension of the array is for the
   //! combination of filters (e.g. specific cell, specific energy group, etc.)
   //! and the second dimension of the array is for scores (e.g. flux, total
   //! reaction rate, fission reaction rate, etc.)
-  xt::xtensor<double, 3> results_;
+  TallyArray<3> results_;
 
   //! True if this tally should be written to statepoint files
   bool writable_ {true};
 
+  //! True if scores should be accumulated in a private buffer for each thread
+  //! rather than added to results_ atomically
+  bool thread_buffers_ {false};
+
+  //! True if results should be stored in blocks that are only allocated once
+  //! they are scored rather than in results_
+  bool sparse_ {false};
+
+  //! Results stored by block when sparse_ is set; results_ is left empty
+  unique_ptr<SparseTallyResults> sparse_results_;
+
   //----------------------------------------------------------------------------
   // Miscellaneous public members.
 
@@ -122,6 +249,13 @@ public:
   int energyout_filter_ {C_NONE};
   int delayedgroup_filter_ {C_NONE};
 
+  //! Bit for each particle type that can contribute to the tally
+  unsigned particle_mask_ {~0u};
+
+  //! Range of incoming energies that can contribute to the tally
+  double energy_min_ {0.0};
+  double energy_max_ {INFTY};
+
   vector<Trigger> triggers_;
 
   int deriv_ {C_NONE}; //!< Index of a TallyDerivative object for diff tallies.
@@ -132,11 +266,17 @@ private:
 
   vector<int32_t> filters_; //!< Filter indices in global filters array
 
+  vector<int32_t> filter_order_; //!< Filter indices in evaluation order
+
   //! Index strides assigned to each filter to support 1D indexing.
   vector<int32_t> strides_;
 
   int32_t n_filter_bins_ {0};
 
+  //! Values of each bin scored by each thread if thread_buffers_ is set and
+  //! the buffers fit in memory
+  vector<TallyArray<2>> thread_results_;
+
   gsl::index index_;
 };
 
@@ -153,6 +293,17 @@ extern vector<int> active_tracklength_tallies;
 extern vector<int> active_collision_tallies;
 extern vector<int> active_meshsurf_tallies;
 extern vector<int> active_surface_tallies;
+extern vector<int> active_pulse_height_tallies;
+
+//! Whether each cell is binned by a cell filter of an active pulse-height
+//! tally, and hence whether energy deposited in it is recorded
+extern vector<bool> pulse_height_cells;
+
+//! Active track-length and collision tallies grouped so that all tallies in
+//! a group have the same filters and nuclides and can share the iteration
+//! over filter bin combinations
+extern vector<vector<int>> active_tracklength_groups;
+extern vector<vector<int>> active_collision_groups;
 } // namespace model
 
 namespace simulation {
@@ -162,6 +313,15 @@ extern xt::xtensor_fixed<double, xt::xshape<N_GLOBAL_TALLIES, 3>>
 
 //! Number of realizations for global tallies
 extern "C" int32_t n_realizations;
+
+//! Number of batches whose scores to user tallies have not been reduced and
+//! accumulated yet
+extern int n_unreduced_batches;
+
+//! Whether reducing the results of user tallies may be deferred to a later
+//! batch, which is only the case while openmc_run() drives the batches so that
+//! no results are read in between
+extern bool tally_results_deferrable;
 } // namespace simulation
 
 extern double global_tally_absorption;
@@ -190,8 +350,8 @@ using adaptor_type =
   xt::xtensor_adaptor<xt::xbuffer_adaptor<double*&, xt::no_ownership>, N>;
 
 #ifdef OPENMC_MPI
-//! Collect all tally results onto master process
-void reduce_tally_results();
+//! Collect global tally results onto master process
+void reduce_global_tallies();
 #endif
 
 void free_memory_tally();
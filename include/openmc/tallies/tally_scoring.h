@@ -91,12 +91,29 @@ void score_analog_tally_mg(Particle& p);
 //! \param distance The distance in [cm] traveled by the particle
 void score_tracklength_tally(Particle& p, double distance);
 
+//! Get the kernel that computes a score for continuous-energy tracklength and
+//! collision estimators.
+//
+//! \param score_bin The score type
+//! \return The kernel, or nullptr if the score must be computed by the general
+//!   scoring function
+ScoreKernel get_score_kernel(int score_bin);
+
 //! Score surface or mesh-surface tallies for particle currents.
 //
 //! \param p The particle being tracked
 //! \param tallies A vector of tallies to score to
 void score_surface_tally(Particle& p, const vector<int>& tallies);
 
+//! Score pulse-height tallies with the energy deposited by a history.
+//
+//! This is triggered when a history and all of its secondaries have been
+//! tracked.  Only the cells that the history deposited energy in are visited,
+//! so the cost does not grow with the number of cells binned by the tallies.
+//
+//! \param p The particle being tracked
+void score_pulse_height_tally(Particle& p);
+
 } // namespace openmc
 
 #endif // OPENMC_TALLIES_TALLY_SCORING_H
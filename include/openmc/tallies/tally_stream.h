@@ -0,0 +1,83 @@
+#ifndef OPENMC_TALLIES_TALLY_STREAM_H
+#define OPENMC_TALLIES_TALLY_STREAM_H
+
+//! \file tally_stream.h
+//! \brief Publishing tally results to an external consumer after each batch
+
+#include <cstdint> // for int32_t, int64_t
+
+#include "openmc/memory.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+
+//==============================================================================
+// Constants
+//==============================================================================
+
+// Identifies a file written by the tally stream's shared memory transport
+constexpr int64_t TALLY_STREAM_MAGIC {0x4d525453434d4f}; // "OMCSTRM"
+
+//==============================================================================
+//! Results of the streamed tallies after one batch
+//==============================================================================
+
+struct TallyStreamFrame {
+  int32_t batch {0};              //!< Batch whose results are included
+  vector<int32_t> n_realizations; //!< Number of realizations of each tally
+  vector<double> mean;            //!< Mean of each bin of every tally
+  vector<double> variance;        //!< Variance of the mean of each bin
+};
+
+//==============================================================================
+//! Destination that streamed tally results are published to. Frames are
+//! published from a background thread, so a transport that is slow to send
+//! a frame causes frames to be skipped rather than delaying transport.
+//==============================================================================
+
+class TallyStreamTransport {
+public:
+  virtual ~TallyStreamTransport() = default;
+
+  //! Send the results of one batch
+  //
+  //! \param[in] frame Results of the streamed tallies
+  virtual void publish(const TallyStreamFrame& frame) = 0;
+};
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace simulation {
+
+extern vector<int32_t> tally_stream_ids; //!< IDs of the streamed tallies
+extern vector<int64_t>
+  tally_stream_sizes; //!< Number of bins (filter bins * scores) of each tally
+
+} // namespace simulation
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Select the tallies to stream, open the transport, and start the thread
+//! that publishes frames. Only the master process publishes results.
+void start_tally_stream();
+
+//! Hand the results accumulated in the current batch to the publishing
+//! thread without waiting for earlier frames to be sent
+void publish_tally_stream();
+
+//! Send the last frame and stop the publishing thread
+void stop_tally_stream();
+
+//! Use a transport other than the built-in ones for the next simulation
+//
+//! \param[in] transport Transport to publish frames to, or nullptr to use
+//!   the shared memory transport given in the settings
+void set_tally_stream_transport(unique_ptr<TallyStreamTransport> transport);
+
+} // namespace openmc
+
+#endif // OPENMC_TALLIES_TALLY_STREAM_H
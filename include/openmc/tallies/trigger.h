@@ -2,11 +2,16 @@
 #define OPENMC_TALLIES_TRIGGER_H
 
 #include <string>
+#include <utility> // for pair
 
 #include "pugixml.hpp"
 
+#include "openmc/vector.h"
+
 namespace openmc {
 
+class Tally;
+
 //==============================================================================
 // Type definitions
 //==============================================================================
@@ -24,6 +29,15 @@ struct Trigger {
   TriggerMetric metric; //!< The type of uncertainty (e.g. std dev) measured
   double threshold;     //!< Uncertainty value below which trigger is satisfied
   int score_index;      //!< Index of the relevant score in the tally's arrays
+
+  //! Largest uncertainty/threshold ratio over the bins evaluated at the last
+  //! update
+  double ratio {0.};
+
+  //! (filter index, score index) of the most uncertain bins found the last
+  //! time all bins were evaluated, most uncertain first. Later updates only
+  //! evaluate these bins as long as one of them is above the threshold.
+  vector<std::pair<int, int>> worst_bins;
 };
 
 //! Stops the simulation early if a desired k-effective uncertainty is reached.
@@ -48,5 +62,11 @@ extern KTrigger keff_trigger;
 
 void check_triggers();
 
+//! Determine whether triggers are checked at the end of the current batch
+bool is_trigger_batch();
+
+//! Update the uncertainty/threshold ratios of the triggers on a tally
+void update_tally_triggers(Tally& tally);
+
 } // namespace openmc
 #endif // OPENMC_TALLIES_TRIGGER_H
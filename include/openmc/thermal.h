@@ -85,12 +85,17 @@ public:
   //!
   //! \param[in] E incoming energy in [eV]
   //! \param[in] sqrtkT square-root of temperature multipled by Boltzmann's
-  //! constant \param[out] i_temp corresponding temperature index \param[out]
-  //! elastic Thermal elastic scattering cross section \param[out] inelastic
-  //! Thermal inelastic scattering cross section \param[inout] seed Pseudorandom
-  //! seed pointer
-  void calculate_xs(double E, double sqrtkT, int* i_temp, double* elastic,
-    double* inelastic, uint64_t* seed) const;
+  //! constant \param[in] i_sqrtkT index of the temperature in
+  //! data::cell_sqrtkT, or -1 if it did not come from a cell \param[out]
+  //! i_temp corresponding temperature index \param[out] elastic Thermal
+  //! elastic scattering cross section \param[out] inelastic Thermal inelastic
+  //! scattering cross section \param[inout] seed Pseudorandom seed pointer
+  void calculate_xs(double E, double sqrtkT, int i_sqrtkT, int* i_temp,
+    double* elastic, double* inelastic, uint64_t* seed) const;
+
+  //! Cache the temperature selection for any cell temperatures in
+  //! data::cell_sqrtkT that have not been seen yet
+  void update_cell_temperatures();
 
   //! Determine whether table applies to a particular nuclide
   //!
@@ -98,6 +103,15 @@ public:
   //! \return Whether table applies to the nuclide
   bool has_nuclide(const char* name) const;
 
+  //! Memory held by the table, estimated from the size of the datasets read
+  //! for each temperature since the distributions are of many kinds
+  //
+  //! \return Memory in [bytes]
+  size_t memory_usage() const
+  {
+    return nbytes_ + sizeof(TemperatureChoice) * cell_temp_.size();
+  }
+
   // Sample an outgoing energy and angle
   void sample(
     const NuclideMicroXS& micro_xs, double E_in, double* E_out, double* mu);
@@ -110,6 +124,24 @@ public:
 
   //! cross sections and distributions at each temperature
   vector<ThermalData> data_;
+
+private:
+  //! Temperature index, and the probability of using the next temperature
+  //! instead when temperatures are interpolated
+  struct TemperatureChoice {
+    int index;
+    double f;
+  };
+
+  //! Select the temperatures to use for a given temperature
+  //! \param[in] kT Temperature in [eV]
+  //! \return Temperature index and interpolation probability
+  TemperatureChoice select_temperature(double kT) const;
+
+  //! Temperature selection for each temperature in data::cell_sqrtkT
+  vector<TemperatureChoice> cell_temp_;
+
+  size_t nbytes_ {0}; //!< Size of the datasets read at all temperatures
 };
 
 void free_memory_thermal();
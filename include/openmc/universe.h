@@ -10,6 +10,7 @@ class DAGUniverse;
 #endif
 
 class Universe;
+class UniverseBVH;
 class UniversePartitioner;
 
 namespace model {
@@ -39,7 +40,11 @@ public:
   const GeometryType& geom_type() const { return geom_type_; }
   GeometryType& geom_type() { return geom_type_; }
 
+  //! Memory held by the universe and its search structures in [bytes]
+  size_t memory_usage() const;
+
   unique_ptr<UniversePartitioner> partitioner_;
+  unique_ptr<UniverseBVH> bvh_;
 
 private:
   GeometryType geom_type_ = GeometryType::CSG;
@@ -48,9 +53,11 @@ private:
 //==============================================================================
 //! Speeds up geometry searches by grouping cells in a search tree.
 //
-//! Currently this object only works with universes that are divided up by a
-//! bunch of z-planes.  It could be generalized to other planes, cylinders,
-//! and spheres.
+//! The tree is built kd-tree style from x-, y- and z-planes and z-cylinders
+//! in the universe.  Each interior node divides space by the sense of one of
+//! these surfaces, chosen to balance the number of cells on either side, and
+//! each leaf lists the cells that could lie within its region.  Cells that
+//! straddle a dividing surface are listed on both sides.
 //==============================================================================
 
 class UniversePartitioner {
@@ -60,19 +67,93 @@ public:
   //! Return the list of cells that could contain the given coordinates.
   const vector<int32_t>& get_cells(Position r, Direction u) const;
 
+  //! Return the number of partitions the universe was divided into.
+  int n_partitions() const { return partitions_.size(); }
+
+  //! Check whether a surface can be used to divide a universe
+  static bool is_partition_surface(const Surface& surf);
+
+  //! Memory held by the search tree in [bytes]
+  size_t memory_usage() const;
+
 private:
-  //! A sorted vector of indices to surfaces that partition the universe
-  vector<int32_t> surfs_;
+  struct Node {
+    int32_t surf; //!< Index of the dividing surface, C_NONE for a leaf
+    int32_t neg;  //!< Child on the negative side, or partition of a leaf
+    int32_t pos;  //!< Child on the positive side
+  };
 
-  //! Vectors listing the indices of the cells that lie within each partition
+  //! Append the node dividing the given cells and its children
   //
-  //! There are n+1 partitions with n surfaces.  `partitions_.front()` gives the
-  //! cells that lie on the negative side of `surfs_.front()`.
-  //! `partitions_.back()` gives the cells that lie on the positive side of
-  //! `surfs_.back()`.  Otherwise, `partitions_[i]` gives cells sandwiched
-  //! between `surfs_[i-1]` and `surfs_[i]`.
+  //! \param univ The universe being partitioned
+  //! \param boxes Bounding box of each cell in the universe
+  //! \param cells Positions of the cells in the universe's list of cells
+  //! \param depth Depth of the node in the tree
+  //! \return Index of the node
+  int32_t build(const Universe& univ, const vector<BoundingBox>& boxes,
+    const vector<int32_t>& cells, int depth);
+
+  vector<int32_t> surfs_; //!< Candidate dividing surfaces
+  vector<Node> nodes_;    //!< Tree nodes, root first
+
+  //! Vectors listing the indices of the cells that lie within each partition
   vector<vector<int32_t>> partitions_;
 };
 
+//==============================================================================
+//! Speeds up geometry searches with a bounding volume hierarchy (BVH) built
+//! over the bounding boxes of a universe's cells.
+//
+//! Each leaf of the tree holds a few cells and each node holds the union of
+//! the bounding boxes of the cells below it, so only cells whose bounding
+//! boxes contain the point are tested.  Unlike UniversePartitioner, this works
+//! for cells bounded by surfaces of any orientation, although cells with
+//! infinite bounding boxes are tested on every search.
+//==============================================================================
+
+class UniverseBVH {
+public:
+  //! Build the tree over some of the cells of a universe
+  //! \param cells Indices of the cells, which must belong to one universe
+  explicit UniverseBVH(const vector<int32_t>& cells);
+
+  //! Find the cell that contains the particle on its lowest coordinate level.
+  //! \param p Particle whose coordinates are searched
+  //! \return Whether a cell was found
+  bool find_cell(Particle& p) const;
+
+  //! Find the cells whose bounding boxes contain a position.
+  //! \param r Position in the coordinates of the universe
+  //! \param cells Vector to which the indices of the cells are appended
+  void find_candidates(Position r, vector<int32_t>& cells) const;
+
+  //! Find the cells whose bounding boxes overlap a box.
+  //! \param box Box in the coordinates of the universe
+  //! \param cells Vector to which the indices of the cells are appended
+  void find_overlapping(const BoundingBox& box, vector<int32_t>& cells) const;
+
+  //! Memory held by the tree in [bytes]
+  size_t memory_usage() const
+  {
+    return sizeof(Node) * nodes_.size() + sizeof(int32_t) * cells_.size() +
+           sizeof(BoundingBox) * boxes_.size();
+  }
+
+private:
+  struct Node {
+    BoundingBox bbox; //!< Union of the bounding boxes of all cells below
+    int32_t index;    //!< First entry of cells_ (leaf) or right child node
+    int32_t n_cells;  //!< Number of cells in a leaf, zero for interior nodes
+  };
+
+  //! Append the nodes for the items order[begin:end] in depth-first order
+  void build(vector<int32_t>& order, const vector<BoundingBox>& boxes,
+    const vector<Position>& centers, int32_t begin, int32_t end);
+
+  vector<Node> nodes_;        //!< Nodes in depth-first order
+  vector<int32_t> cells_;     //!< Indices of cells in leaf order
+  vector<BoundingBox> boxes_; //!< Bounding box of each entry of cells_
+};
+
 } // namespace openmc
 #endif // OPENMC_UNIVERSE_H
@@ -10,10 +10,15 @@
 #include "xtensor/xtensor.hpp"
 
 #include <gsl/gsl-lite.hpp>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <utility> // for pair
 
 namespace openmc {
 
+class Particle;
+
 //==============================================================================
 // Volume calculation class
 //==============================================================================
@@ -52,8 +57,12 @@ public:
   // Tally filter and map types
   enum class TallyDomain { UNIVERSE, MATERIAL, CELL };
 
+  // Ways of sampling the bounding box
+  enum class Estimator { POINT, RAY };
+
   // Data members
   TallyDomain domain_type_; //!< Type of domain (cell, material, etc.)
+  Estimator estimator_ {Estimator::POINT}; //!< Points or rays as samples
   size_t n_samples_;        //!< Number of samples to use
   double threshold_ {-1.0}; //!< Error threshold for domain volumes
   TriggerMetric trigger_type_ {
@@ -63,13 +72,52 @@ public:
   vector<int> domain_ids_;      //!< IDs of domains to find volumes of
 
 private:
-  //! \brief Check whether a material has already been hit for a given domain.
-  //! If not, add new entries to the vectors
+  //! Fractions of a single sample in materials of domains, keyed by
+  //! hit_key(i_domain, i_material)
+  using SampleHits = vector<std::pair<int64_t, double>>;
+
+  //! Sums of the fractions of samples and of their squares, keyed by
+  //! hit_key(i_domain, i_material)
+  using HitSums = std::unordered_map<int64_t, array<double, 2>>;
+
+  //! \brief Key for a material within a domain
+  //
+  //! \param[in] i_domain Index in domain_ids_
+  //! \param[in] i_material Index in global materials vector, or MATERIAL_VOID
+  int64_t hit_key(int i_domain, int i_material) const;
+
+  //! \brief Add a fraction of a sample to the domains a particle is in
+  //
+  //! \param[in] p Particle whose cell has been found
+  //! \param[in] fraction Fraction of the sample at the particle's location
+  //! \param[in] domain_index Index in domain_ids_ of each domain ID
+  //! \param[in,out] sample Fractions of the sample in each domain
+  void score_domains(const Particle& p, double fraction,
+    const std::unordered_map<int, int>& domain_index,
+    SampleHits& sample) const;
+
+  //! \brief Sample a point in the bounding box
+  void sample_point(uint64_t* seed, Particle& p,
+    const std::unordered_map<int, int>& domain_index,
+    SampleHits& sample) const;
+
+  //! \brief Sample a chord of the bounding box along a random line and track
+  //! it through the geometry. The length in each domain is divided by the
+  //! length of the chord, which gives an unbiased estimate of the fraction of
+  //! the box the domain fills.
+  void sample_ray(uint64_t* seed, Particle& p,
+    const std::unordered_map<int, int>& domain_index,
+    SampleHits& sample) const;
+
+  //! \brief Add the fractions of a sample to the sums for each domain and for
+  //! each material within each domain, and clear the sample
   //
-  //! \param[in] i_material Index in global materials vector
-  //! \param[in,out] indices Vector of material indices
-  //! \param[in,out] hits Number of hits corresponding to each material
-  void check_hit(int i_material, vector<int>& indices, vector<int>& hits) const;
+  //! \param[in,out] sample Fractions of the sample in each domain
+  //! \param[in,out] volume_sums Sums for each domain, flattened as
+  //!   (domain, sum or sum of squares)
+  //! \param[in,out] material_sums Sums for each material within each domain
+  void add_sample(SampleHits& sample, vector<double>& volume_sums,
+    HitSums& material_sums) const;
 };
 
 //==============================================================================
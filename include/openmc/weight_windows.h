@@ -21,6 +21,8 @@ namespace openmc {
 
 constexpr double DEFAULT_WEIGHT_CUTOFF {1.0e-38}; // default low weight cutoff
 
+enum class WeightWindowMethod { MAGIC, FW_CADIS };
+
 //==============================================================================
 // Non-member functions
 //==============================================================================
@@ -29,19 +31,34 @@ constexpr double DEFAULT_WEIGHT_CUTOFF {1.0e-38}; // default low weight cutoff
 //! \param[in] p  Particle to apply weight windows to
 void apply_weight_windows(Particle& p);
 
+//! Get the distance to the next bin boundary of the weight window meshes for a
+//! particle, which only structured meshes can provide
+//! \param[in] p  Particle to get the distance for
+//! \return Distance along the particle's direction, or INFTY if there is none
+double distance_to_weight_window_boundary(const Particle& p);
+
 //! Free memory associated with weight windows
 void free_memory_weight_windows();
 
+//! Create the tallies that weight window generators accumulate the flux in
+void create_weight_windows_generator_tallies();
+
+//! Update the weight windows of each generator whose update interval ends with
+//! the current batch
+void update_weight_windows();
+
 //==============================================================================
 // Global variables
 //==============================================================================
 
 class WeightWindows;
+class WeightWindowsGenerator;
 
 namespace variance_reduction {
 
 extern std::unordered_map<int32_t, int32_t> ww_map;
 extern vector<unique_ptr<WeightWindows>> weight_windows;
+extern vector<unique_ptr<WeightWindowsGenerator>> generators;
 
 } // namespace variance_reduction
 
@@ -78,31 +95,46 @@ public:
   WeightWindows();
   WeightWindows(pugi::xml_node node);
 
+  //! Create weight windows whose bounds are all invalid until they are set
+  //! \param[in] mesh_idx  Index of the mesh in model::meshes
+  //! \param[in] type  Particle type to apply weight windows to
+  //! \param[in] energy_bounds  Energy boundaries [eV]
+  WeightWindows(
+    int32_t mesh_idx, ParticleType type, vector<double> energy_bounds);
+
   // Methods
 
   //! Set the weight window ID
   void set_id(int32_t id = -1);
 
-  // NOTE: This is unused for now but may be used in the future
   //! Write weight window settings to an HDF5 file
   //! \param[in] group  HDF5 group to write to
   void to_hdf5(hid_t group) const;
 
   //! Retrieve the weight window for a particle
-  //! \param[in] p  Particle to get weight window for
-  WeightWindow get_weight_window(const Particle& p) const;
+  //! \param[in] p  Particle to get weight window for, whose cached mesh bin
+  //!   and energy group are reused if they still apply
+  WeightWindow get_weight_window(Particle& p) const;
+
+  //! Replace the lower and upper weight window bounds
+  //! \param[in] lower  Lower bounds for each mesh bin within each energy group
+  //! \param[in] upper  Upper bounds, which must have the same size
+  void set_bounds(vector<float> lower, vector<float> upper);
 
   // Accessors
   int32_t id() const { return id_; }
+  ParticleType particle_type() const { return particle_type_; }
   const Mesh& mesh() const { return *model::meshes[mesh_idx_]; }
+  int32_t mesh_idx() const { return mesh_idx_; }
+  const vector<double>& energy_bounds() const { return energy_bounds_; }
 
 private:
   // Data members
-  int32_t id_;                     //!< Unique ID
+  int32_t id_ {C_NONE};            //!< Unique ID
   ParticleType particle_type_;     //!< Particle type to apply weight windows to
   vector<double> energy_bounds_;   //!< Energy boundaries [eV]
-  vector<double> lower_ww_;        //!< Lower weight window bounds
-  vector<double> upper_ww_;        //!< Upper weight window bounds
+  vector<float> lower_ww_;         //!< Lower weight window bounds
+  vector<float> upper_ww_;         //!< Upper weight window bounds
   double survival_ratio_ {3.0};    //!< Survival weight ratio
   double max_lb_ratio_ {1.0}; //!< Maximum lower bound to particle weight ratio
   double weight_cutoff_ {DEFAULT_WEIGHT_CUTOFF}; //!< Weight cutoff
@@ -110,5 +142,58 @@ private:
   int32_t mesh_idx_;               //!< index in meshes vector
 };
 
+//==============================================================================
+//! Generator of weight windows from the flux tallied during a simulation.
+//
+//! Every update_interval batches, the weight windows are set with the MAGIC
+//! method: the lower bound in each mesh bin is proportional to the flux
+//! accumulated so far, normalized so that it is one half in the bin with the
+//! largest flux in each energy group, and the upper bound is a constant ratio
+//! times the lower bound. Bins without any flux are left without a window.
+//
+//! With the FW-CADIS method, the weight windows are instead set once from the
+//! adjoint flux computed by the random ray solver, and the independent sources
+//! are biased toward important regions so that particles are born within
+//! their windows.
+//==============================================================================
+
+class WeightWindowsGenerator {
+public:
+  // Constructors
+  WeightWindowsGenerator(pugi::xml_node node);
+
+  // Methods
+
+  //! Create the tally that the flux is accumulated in
+  void create_tally();
+
+  //! Set the weight windows from the flux accumulated so far
+  void update();
+
+  //! Set the weight windows and bias the independent sources with CADIS. The
+  //! lower bound in each bin is the ratio of the total source importance to
+  //! the importance of the bin, scaled so that the window is centered on it.
+  //
+  //! \param[in] importance Adjoint flux in each mesh bin within each energy
+  //!   group, zero where it is unknown
+  void set_importance(const vector<double>& importance);
+
+  // Accessors
+  WeightWindowMethod method() const { return method_; }
+  int update_interval() const { return update_interval_; }
+  const WeightWindows& weight_windows() const
+  {
+    return *variance_reduction::weight_windows[ww_idx_];
+  }
+
+private:
+  // Data members
+  int32_t ww_idx_;             //!< Index in weight windows vector
+  int32_t tally_idx_ {C_NONE}; //!< Index in tallies vector
+  int update_interval_ {1};    //!< Number of batches between updates
+  double ratio_ {5.0};         //!< Upper to lower weight window ratio
+  WeightWindowMethod method_ {WeightWindowMethod::MAGIC}; //!< Generation method
+};
+
 } // namespace openmc
 #endif // OPENMC_WEIGHT_WINDOWS_H
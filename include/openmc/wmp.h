@@ -3,6 +3,7 @@
 
 #include "hdf5.h"
 #include "xtensor/xtensor.hpp"
+#include <gsl/gsl-lite.hpp>
 
 #include <complex>
 #include <string>
@@ -58,6 +59,19 @@ public:
   //! sections in [b]
   std::tuple<double, double, double> evaluate(double E, double sqrtkT) const;
 
+  //! \brief Evaluate the windowed multipole equations for a batch of energies
+  //!
+  //! Energies that fall in the same window are evaluated together so that
+  //! each pole of the window is read once for the whole group.
+  //!
+  //! \param E Incident neutron energies in [eV]
+  //! \param sqrtkT Square root of temperature times Boltzmann constant for
+  //!   each energy
+  //! \param xs Elastic scattering, absorption, and fission cross sections in
+  //!   [b] for each energy
+  void evaluate(gsl::span<const double> E, gsl::span<const double> sqrtkT,
+    gsl::span<array<double, 3>> xs) const;
+
   //! \brief Evaluates the windowed multipole equations for the derivative of
   //! cross sections in the resolved resonance regions with respect to
   //! temperature.
@@ -80,11 +94,30 @@ public:
   vector<WindowInfo> window_info_; // Information about a window
   xt::xtensor<double, 3>
     curvefit_; // Curve fit coefficients (window, poly order, reaction)
-  xt::xtensor<std::complex<double>, 2> data_; //!< Poles and residues
+  xt::xtensor<double, 2> data_re_; //!< Real part of poles and residues
+                                   //!< (value type, pole)
+  xt::xtensor<double, 2> data_im_; //!< Imaginary part of poles and residues
+                                   //!< (value type, pole)
 
   // Constant data
   static constexpr int MAX_POLY_COEFFICIENTS =
     11; //!< Max order of polynomial fit plus one
+
+private:
+  //! Determine the window containing an energy
+  //!
+  //! \param sqrtE Square root of incident neutron energy in [eV]
+  //! \return Index in window_info_
+  int window_index(double sqrtE) const;
+
+  //! Evaluate the curvefit polynomial of a window
+  //!
+  //! \param i_window Index in window_info_
+  //! \param E Incident neutron energy in [eV]
+  //! \param sqrtkT Square root of temperature times Boltzmann constant
+  //! \return Elastic scattering, absorption, and fission cross sections in [b]
+  array<double, 3> evaluate_curvefit(
+    int i_window, double E, double sqrtkT) const;
 };
 
 //========================================================================
@@ -323,11 +323,17 @@ class FluxCollapseHelper(ReactionRateHelper):
         # Build nucname: density mapping to enable O(1) lookup in loop below
         densities = dict(zip(mat.nuclides, mat.densities))
 
-        for name, i_nuc in zip(self.nuclides, nuc_index):
+        # Use flux to collapse reaction rates (per N) of all nuclides and
+        # reactions in a single call
+        collapsed = openmc.lib.collapse_rates(
+            self.nuclides, self._mts, [mat.temperature], self._energies,
+            flux)[0]
+
+        for j, (name, i_nuc) in enumerate(zip(self.nuclides, nuc_index)):
             # Determine density of nuclide
             density = densities[name]
 
-            for mt, score, i_rx in zip(self._mts, self._scores, react_index):
+            for k, (score, i_rx) in enumerate(zip(self._scores, react_index)):
                 if score in self._reactions_direct and name in nuclides_direct:
                     # Determine index in rx_rates
                     i_rx_direct = self._reactions_direct.index(score)
@@ -336,13 +342,8 @@ class FluxCollapseHelper(ReactionRateHelper):
                     # Get reaction rate from tally
                     self._results_cache[i_nuc, i_rx] = rx_rates[i_nuc_direct, i_rx_direct]
                 else:
-                    # Use flux to collapse reaction rate (per N)
-                    nuc = openmc.lib.nuclides[name]
-                    rate_per_nuc = nuc.collapse_rate(
-                        mt, mat.temperature, self._energies, flux)
-
                     # Multiply by density to get absolute reaction rate
-                    self._results_cache[i_nuc, i_rx] = rate_per_nuc * density
+                    self._results_cache[i_nuc, i_rx] = collapsed[j, k] * density
 
         return self._results_cache
 
@@ -611,38 +611,38 @@ class Operator(TransportOperator):
         for rank in range(comm.size):
             number_i = comm.bcast(self.number, root=rank)
 
-            for mat in number_i.materials:
-                nuclides = []
-                densities = []
-                for nuc in number_i.nuclides:
-                    if nuc in self.nuclides_with_data:
-                        val = 1.0e-24 * number_i.get_atom_density(mat, nuc)
-
-                        # If nuclide is zero, do not add to the problem.
-                        if val > 0.0:
-                            if self.round_number:
-                                val_magnitude = np.floor(np.log10(val))
-                                val_scaled = val / 10**val_magnitude
-                                val_round = round(val_scaled, 8)
-
-                                val = val_round * 10**val_magnitude
-
-                            nuclides.append(nuc)
-                            densities.append(val)
-                        else:
-                            # Only output warnings if values are significantly
-                            # negative. CRAM does not guarantee positive values.
-                            if val < -1.0e-21:
-                                print("WARNING: nuclide ", nuc, " in material ", mat,
-                                      " is negative (density = ", val, " at/barn-cm)")
-                            number_i[mat, nuc] = 0.0
-
-                # Update densities on C API side
-                mat_internal = openmc.lib.materials[int(mat)]
-                mat_internal.set_densities(nuclides, densities)
-
-                #TODO Update densities on the Python side, otherwise the
-                # summary.h5 file contains densities at the first time step
+            nuclides = [nuc for nuc in number_i.nuclides
+                        if nuc in self.nuclides_with_data]
+            densities = np.zeros((len(number_i.materials), len(nuclides)))
+            for i, mat in enumerate(number_i.materials):
+                for j, nuc in enumerate(nuclides):
+                    val = 1.0e-24 * number_i.get_atom_density(mat, nuc)
+
+                    # If nuclide is zero, do not add to the problem.
+                    if val > 0.0:
+                        if self.round_number:
+                            val_magnitude = np.floor(np.log10(val))
+                            val_scaled = val / 10**val_magnitude
+                            val_round = round(val_scaled, 8)
+
+                            val = val_round * 10**val_magnitude
+
+                        densities[i, j] = val
+                    else:
+                        # Only output warnings if values are significantly
+                        # negative. CRAM does not guarantee positive values.
+                        if val < -1.0e-21:
+                            print("WARNING: nuclide ", nuc, " in material ", mat,
+                                  " is negative (density = ", val, " at/barn-cm)")
+                        number_i[mat, nuc] = 0.0
+
+            # Update densities on C API side. Materials whose nuclides are
+            # unchanged are updated in place without rebuilding their tables.
+            mats = [openmc.lib.materials[int(mat)] for mat in number_i.materials]
+            openmc.lib.set_material_densities(mats, nuclides, densities)
+
+            #TODO Update densities on the Python side, otherwise the
+            # summary.h5 file contains densities at the first time step
 
     def _generate_materials_xml(self):
         """Creates materials.xml from self.number.
@@ -48,6 +48,9 @@ def _coord_levels():
 def _libmesh_enabled():
     return c_bool.in_dll(_dll, "LIBMESH_ENABLED").value
 
+def _xs_single_precision():
+    return c_bool.in_dll(_dll, "XS_SINGLE_PRECISION").value
+
 from .error import *
 from .core import *
 from .nuclide import *
@@ -5,6 +5,7 @@ from ctypes import c_int, c_int32, c_double, c_char_p, POINTER, c_bool, c_size_t
 from weakref import WeakValueDictionary
 
 import numpy as np
+from numpy.ctypeslib import ndpointer
 
 from ..exceptions import AllocationError, InvalidIDError
 from . import _dll
@@ -12,7 +13,8 @@ from .core import _FortranObjectWithID
 from .error import _error_handler
 from .material import Material
 
-__all__ = ['Cell', 'cells']
+__all__ = ['Cell', 'cells', 'set_cell_rotations', 'set_cell_temperatures',
+           'set_cell_translations']
 
 # Cell functions
 _dll.openmc_extend_cells.argtypes = [c_int32, POINTER(c_int32), POINTER(c_int32)]
@@ -56,6 +58,20 @@ _dll.openmc_cell_set_temperature.argtypes = [
     c_int32, c_double, POINTER(c_int32), c_bool]
 _dll.openmc_cell_set_temperature.restype = c_int
 _dll.openmc_cell_set_temperature.errcheck = _error_handler
+_array_1d_int32 = ndpointer(dtype=np.int32, ndim=1, flags='CONTIGUOUS')
+_array_1d_dble = ndpointer(dtype=np.double, ndim=1, flags='CONTIGUOUS')
+_dll.openmc_cells_set_temperatures.argtypes = [
+    c_int, _array_1d_int32, _array_1d_int32, _array_1d_dble]
+_dll.openmc_cells_set_temperatures.restype = c_int
+_dll.openmc_cells_set_temperatures.errcheck = _error_handler
+_dll.openmc_cells_set_translations.argtypes = [
+    c_int, _array_1d_int32, _array_1d_dble]
+_dll.openmc_cells_set_translations.restype = c_int
+_dll.openmc_cells_set_translations.errcheck = _error_handler
+_dll.openmc_cells_set_rotations.argtypes = [
+    c_int, _array_1d_int32, _array_1d_dble, c_size_t]
+_dll.openmc_cells_set_rotations.restype = c_int
+_dll.openmc_cells_set_rotations.errcheck = _error_handler
 _dll.openmc_cell_set_translation.argtypes = [c_int32, POINTER(c_double)]
 _dll.openmc_cell_set_translation.restype = c_int
 _dll.openmc_cell_set_translation.errcheck = _error_handler
@@ -292,6 +308,90 @@ class Cell(_FortranObjectWithID):
         return llc, urc
 
 
+def set_cell_temperatures(cells, temperatures, instances=None):
+    """Set the temperatures of many material-filled cell instances at once
+
+    This is equivalent to calling :meth:`Cell.set_temperature` for each cell,
+    but all cells and temperatures are checked up front and the temperatures
+    are set in parallel, which is much faster for a large number of instances,
+    e.g. in multiphysics coupling.
+
+    .. versionadded:: 0.13.1
+
+    Parameters
+    ----------
+    cells : iterable of openmc.lib.Cell
+        Cell to set the temperature of for each temperature. Each cell instance
+        should appear at most once.
+    temperatures : iterable of float
+        Temperatures in [K]
+    instances : iterable of int or None
+        Instance of the cell for each temperature. An instance of -1 or
+        ``None`` sets the temperature of all instances of the cell.
+
+    """
+    indices = np.array([c._index for c in cells], dtype=np.int32)
+    T = np.array(temperatures, dtype=float)
+    if instances is None:
+        instances = np.full(len(indices), -1, dtype=np.int32)
+    else:
+        instances = np.array(instances, dtype=np.int32)
+    _dll.openmc_cells_set_temperatures(len(indices), indices, instances, T)
+
+
+def set_cell_translations(cells, translations):
+    """Set the translations of many universe-filled cells at once
+
+    This is equivalent to setting :attr:`Cell.translation` for each cell, but
+    all cells are checked up front and moved in a single call, which is useful
+    for moving many components of a model between simulations.
+
+    .. versionadded:: 0.13.1
+
+    Parameters
+    ----------
+    cells : iterable of openmc.lib.Cell
+        Cells to translate
+    translations : iterable of 3-tuples of float
+        Translation vector for each cell in [cm]
+
+    """
+    indices = np.array([c._index for c in cells], dtype=np.int32)
+    xyz = np.array(translations, dtype=float).flatten()
+    if xyz.size != 3*len(indices):
+        raise ValueError('A translation vector must be given for each cell.')
+    _dll.openmc_cells_set_translations(len(indices), indices, xyz)
+
+
+def set_cell_rotations(cells, rotations):
+    """Set the rotations of many universe-filled cells at once
+
+    This is equivalent to setting :attr:`Cell.rotation` for each cell, but all
+    cells are checked up front and rotated in a single call.
+
+    .. versionadded:: 0.13.1
+
+    Parameters
+    ----------
+    cells : iterable of openmc.lib.Cell
+        Cells to rotate
+    rotations : iterable of 3-tuples of float or iterable of 3x3 arrays
+        Rotation of each cell, given either as angles in degrees about the x,
+        y, and z axes or as a rotation matrix. All cells must use the same form.
+
+    """
+    indices = np.array([c._index for c in cells], dtype=np.int32)
+    rot = np.array(rotations, dtype=float)
+    if len(indices) == 0:
+        return
+    rot_len = rot.size // len(indices)
+    if rot_len not in (3, 9) or rot.size != rot_len*len(indices):
+        raise ValueError('Rotations must be given as 3 angles or a 3x3 matrix '
+                         'for each cell.')
+    _dll.openmc_cells_set_rotations(
+        len(indices), indices, rot.flatten(), rot_len)
+
+
 class _CellMapping(Mapping):
     def __getitem__(self, key):
         index = c_int32()
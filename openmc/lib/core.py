@@ -50,6 +50,9 @@ _dll.openmc_hard_reset.errcheck = _error_handler
 _dll.openmc_init.argtypes = [c_int, POINTER(POINTER(c_char)), c_void_p]
 _dll.openmc_init.restype = c_int
 _dll.openmc_init.errcheck = _error_handler
+_dll.openmc_majorant_xs.argtypes = [c_int32, c_double, POINTER(c_double)]
+_dll.openmc_majorant_xs.restype = c_int
+_dll.openmc_majorant_xs.errcheck = _error_handler
 _dll.openmc_get_keff.argtypes = [POINTER(c_double*2)]
 _dll.openmc_get_keff.restype = c_int
 _dll.openmc_get_keff.errcheck = _error_handler
@@ -58,11 +61,19 @@ _dll.openmc_initialize_mesh_egrid.argtypes = [
 ]
 _dll.openmc_initialize_mesh_egrid.restype = None
 _init_linsolver_argtypes = [_array_1d_int, c_int, _array_1d_int, c_int, c_int,
-                            c_double, _array_1d_int, c_bool]
+                            c_double, _array_1d_int, c_bool, c_int]
 _dll.openmc_initialize_linsolver.argtypes = _init_linsolver_argtypes
 _dll.openmc_initialize_linsolver.restype = None
 _dll.openmc_is_statepoint_batch.restype = c_bool
 _dll.openmc_master.restype = c_bool
+_dll.openmc_get_performance_counters.argtypes = [
+    POINTER(c_int64*8), POINTER(c_double)]
+_dll.openmc_get_performance_counters.restype = c_int
+_dll.openmc_get_performance_counters.errcheck = _error_handler
+_dll.openmc_memory_usage.argtypes = [
+    POINTER(c_int64*7), POINTER(c_int64*7), POINTER(c_int64)]
+_dll.openmc_memory_usage.restype = c_int
+_dll.openmc_memory_usage.errcheck = _error_handler
 _dll.openmc_next_batch.argtypes = [POINTER(c_int)]
 _dll.openmc_next_batch.restype = c_int
 _dll.openmc_next_batch.errcheck = _error_handler
@@ -82,6 +93,8 @@ _dll.openmc_reset_timers.restype = c_int
 _dll.openmc_reset_timers.errcheck = _error_handler
 _run_linsolver_argtypes = [_array_1d_dble, _array_1d_dble, _array_1d_dble,
                            c_double]
+_dll.openmc_run_random_ray.restype = c_int
+_dll.openmc_run_random_ray.errcheck = _error_handler
 _dll.openmc_run_linsolver.argtypes = _run_linsolver_argtypes
 _dll.openmc_run_linsolver.restype = c_int
 _dll.openmc_source_bank.argtypes = [POINTER(POINTER(_SourceSite)), POINTER(c_int64)]
@@ -352,6 +365,35 @@ def keff():
     return tuple(k)
 
 
+def majorant_xs(E, universe=None):
+    """Return an upper bound on the total macroscopic cross section.
+
+    The bound is computed from the tabulated cross sections of the materials in
+    a universe at every temperature when it is first requested. The simulation
+    must have been initialized.
+
+    .. versionadded:: 0.13.1
+
+    Parameters
+    ----------
+    E : float
+        Neutron energy in [eV]
+    universe : int, optional
+        ID of the universe. If not given, the bound over all materials is
+        returned.
+
+    Returns
+    -------
+    float
+        Majorant cross section in [1/cm]
+
+    """
+    xs = c_double()
+    uid = -1 if universe is None else universe
+    _dll.openmc_majorant_xs(uid, E, xs)
+    return xs.value
+
+
 def master():
     """Return whether processor is master processor or not.
 
@@ -379,6 +421,76 @@ def next_batch():
     return status.value
 
 
+_PERFORMANCE_COUNTERS = (
+    'collisions', 'xs_lookups', 'surface_crossings', 'lattice_crossings',
+    'lost_particles', 'neighbor_list_hits', 'exhaustive_searches',
+    'tally_scores'
+)
+
+
+def performance_counters():
+    """Return the number of transport events on this process.
+
+    The counts and the transport time are accumulated from the time the
+    simulation was initialized, so rates of events during a batch can be found
+    from the differences between calls made before and after
+    :func:`next_batch`.
+
+    .. versionadded:: 0.13.1
+
+    Returns
+    -------
+    counts : dict
+        Number of each kind of event, keyed by 'collisions', 'xs_lookups',
+        'surface_crossings', 'lattice_crossings', 'lost_particles',
+        'neighbor_list_hits', 'exhaustive_searches', and 'tally_scores'
+    time : float
+        Time spent in transport in [s]
+
+    """
+    counts = (c_int64*8)()
+    time = c_double()
+    _dll.openmc_get_performance_counters(counts, time)
+    return dict(zip(_PERFORMANCE_COUNTERS, counts)), time.value
+
+
+_MEMORY_USES = (
+    'nuclides', 'thermal', 'materials', 'geometry', 'tallies', 'banks',
+    'particles'
+)
+
+
+def memory_usage():
+    """Return the memory held by each subsystem on this process.
+
+    Each subsystem reports the size of the containers it owns, so memory kept
+    by the allocator or by libraries is not included. The high-water marks are
+    the largest memory measured at the end of any batch or by a call to this
+    function.
+
+    .. versionadded:: 0.13.1
+
+    Returns
+    -------
+    current : dict
+        Memory in [bytes] currently held by each subsystem, keyed by
+        'nuclides', 'thermal', 'materials', 'geometry', 'tallies', 'banks',
+        and 'particles'
+    peak : dict
+        High-water mark in [bytes] of each subsystem, with the same keys
+    resident : int
+        Peak resident set size of the process in [bytes], or 0 where the
+        operating system doesn't report it
+
+    """
+    current = (c_int64*7)()
+    peak = (c_int64*7)()
+    resident = c_int64()
+    _dll.openmc_memory_usage(current, peak, resident)
+    return (dict(zip(_MEMORY_USES, current)), dict(zip(_MEMORY_USES, peak)),
+            resident.value)
+
+
 def plot_geometry(output=True):
     """Plot geometry
 
@@ -421,6 +533,21 @@ def run(output=True):
         _dll.openmc_run()
 
 
+def run_random_ray(output=True):
+    """Solve for the multigroup flux with the random ray method
+
+    .. versionadded:: 0.13.1
+
+    Parameters
+    ----------
+    output : bool, optional
+        Whether or not to show output. Defaults to showing output
+    """
+
+    with quiet_dll(output):
+        _dll.openmc_run_random_ray()
+
+
 def sample_external_source(n_samples=1, prn_seed=None):
     """Sample external source
 
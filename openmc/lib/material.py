@@ -1,17 +1,19 @@
 from collections.abc import Mapping
 from ctypes import c_int, c_int32, c_double, c_char_p, POINTER, c_size_t
+from itertools import compress
 from weakref import WeakValueDictionary
 
 import numpy as np
-from numpy.ctypeslib import as_array
+from numpy.ctypeslib import as_array, ndpointer
 
 from openmc.exceptions import AllocationError, InvalidIDError, OpenMCError
 from . import _dll, Nuclide
+from .nuclide import _NuclideMapping, load_nuclide
 from .core import _FortranObjectWithID
 from .error import _error_handler
 
 
-__all__ = ['Material', 'materials']
+__all__ = ['Material', 'materials', 'set_material_densities']
 
 # Material functions
 _dll.openmc_extend_materials.argtypes = [c_int32, POINTER(c_int32), POINTER(c_int32)]
@@ -48,6 +50,13 @@ _dll.openmc_material_set_densities.argtypes = [
     c_int32, c_int, POINTER(c_char_p), POINTER(c_double)]
 _dll.openmc_material_set_densities.restype = c_int
 _dll.openmc_material_set_densities.errcheck = _error_handler
+_array_1d_int32 = ndpointer(dtype=np.int32, ndim=1, flags='CONTIGUOUS')
+_array_1d_int = ndpointer(dtype=np.intc, ndim=1, flags='CONTIGUOUS')
+_array_1d_dble = ndpointer(dtype=np.double, ndim=1, flags='CONTIGUOUS')
+_dll.openmc_materials_set_densities.argtypes = [
+    c_int, _array_1d_int32, c_int, _array_1d_int, _array_1d_dble]
+_dll.openmc_materials_set_densities.restype = c_int
+_dll.openmc_materials_set_densities.errcheck = _error_handler
 _dll.openmc_material_set_id.argtypes = [c_int32, c_int32]
 _dll.openmc_material_set_id.restype = c_int
 _dll.openmc_material_set_id.errcheck = _error_handler
@@ -272,6 +281,45 @@ class Material(_FortranObjectWithID):
         _dll.openmc_material_set_densities(self._index, len(nuclides), nucs, dp)
 
 
+def set_material_densities(materials, nuclides, densities):
+    """Set the densities of a list of nuclides in many materials at once
+
+    This is equivalent to calling :meth:`Material.set_densities` for each
+    material with the nuclides whose densities are nonzero. Materials that
+    already contain those nuclides, e.g. between depletion steps, are updated
+    in place and in parallel.
+
+    .. versionadded:: 0.13.1
+
+    Parameters
+    ----------
+    materials : iterable of openmc.lib.Material
+        Materials to update
+    nuclides : iterable of str
+        Nuclide names
+    densities : numpy.ndarray
+        Densities in [atom/b-cm] with shape ``(n_materials, n_nuclides)``
+
+    """
+    mats = np.array([m._index for m in materials], dtype=np.int32)
+    nuclides = list(nuclides)
+    densities = np.asarray(densities, dtype=float).reshape(
+        len(mats), len(nuclides))
+
+    # Nuclides with zero density in every material need not be loaded
+    present = np.any(densities > 0.0, axis=0)
+    mapping = _NuclideMapping()
+    for name in compress(nuclides, present):
+        if name not in mapping:
+            load_nuclide(name)
+    indices = np.array([mapping[name]._index
+                        for name in compress(nuclides, present)],
+                       dtype=np.intc)
+    d = np.ascontiguousarray(densities[:, present])
+    _dll.openmc_materials_set_densities(len(mats), mats, len(indices), indices,
+                                        d.ravel())
+
+
 class _MaterialMapping(Mapping):
     def __getitem__(self, key):
         index = c_int32()
@@ -1,5 +1,5 @@
 from collections.abc import Mapping
-from ctypes import c_int, c_double, c_char_p, POINTER, c_size_t
+from ctypes import c_int, c_int64, c_double, c_char_p, POINTER, c_size_t
 from weakref import WeakValueDictionary
 
 from numpy.ctypeslib import ndpointer
@@ -11,7 +11,7 @@ from .core import _FortranObject
 from .error import _error_handler
 
 
-__all__ = ['Nuclide', 'nuclides', 'load_nuclide']
+__all__ = ['Nuclide', 'nuclides', 'load_nuclide', 'collapse_rates']
 
 _array_1d_dble = ndpointer(dtype=np.double, ndim=1, flags='CONTIGUOUS')
 
@@ -22,6 +22,9 @@ _dll.openmc_get_nuclide_index.errcheck = _error_handler
 _dll.openmc_load_nuclide.argtypes = [c_char_p, POINTER(c_double), c_int]
 _dll.openmc_load_nuclide.restype = c_int
 _dll.openmc_load_nuclide.errcheck = _error_handler
+_dll.openmc_nuclide_memory_usage.argtypes = [c_int, POINTER(c_int64)]
+_dll.openmc_nuclide_memory_usage.restype = c_int
+_dll.openmc_nuclide_memory_usage.errcheck = _error_handler
 _dll.openmc_nuclide_name.argtypes = [c_int, POINTER(c_char_p)]
 _dll.openmc_nuclide_name.restype = c_int
 _dll.openmc_nuclide_name.errcheck = _error_handler
@@ -29,6 +32,12 @@ _dll.openmc_nuclide_collapse_rate.argtypes = [c_int, c_int, c_double,
     _array_1d_dble, _array_1d_dble, c_int, POINTER(c_double)]
 _dll.openmc_nuclide_collapse_rate.restype = c_int
 _dll.openmc_nuclide_collapse_rate.errcheck = _error_handler
+_array_1d_int = ndpointer(dtype=np.intc, ndim=1, flags='CONTIGUOUS')
+_dll.openmc_collapse_rates.argtypes = [c_int, _array_1d_dble, _array_1d_dble,
+    _array_1d_dble, c_int, c_int, _array_1d_int, c_int, _array_1d_int,
+    _array_1d_dble]
+_dll.openmc_collapse_rates.restype = c_int
+_dll.openmc_collapse_rates.errcheck = _error_handler
 _dll.nuclides_size.restype = c_size_t
 
 
@@ -44,6 +53,52 @@ def load_nuclide(name):
     _dll.openmc_load_nuclide(name.encode(), None, 0)
 
 
+def collapse_rates(nuclides, MTs, temperatures, energy, flux):
+    """Calculate reaction rates of many nuclides and reactions based on
+    group-wise flux distributions
+
+    This is equivalent to calling :meth:`Nuclide.collapse_rate` for every
+    combination of flux spectrum, nuclide, and reaction, but the rates are
+    found in a single call in which spectra are collapsed in parallel.
+
+    .. versionadded:: 0.13.1
+
+    Parameters
+    ----------
+    nuclides : iterable of str
+        Names of the nuclides
+    MTs : iterable of int
+        ENDF MT values of the desired reactions
+    temperatures : iterable of float
+        Temperature in [K] at which to evaluate cross sections for each
+        spectrum
+    energy : iterable of float
+        Energy group boundaries in [eV]
+    flux : numpy.ndarray
+        Flux in each energy group (not normalized per eV) with shape
+        ``(n_spectra, n_groups)``
+
+    Returns
+    -------
+    numpy.ndarray
+        Reaction rates with shape ``(n_spectra, n_nuclides, n_MTs)``
+
+    """
+    mapping = _NuclideMapping()
+    indices = np.array([mapping[name]._index for name in nuclides],
+                       dtype=np.intc)
+    MTs = np.asarray(MTs, dtype=np.intc)
+    temperatures = np.asarray(temperatures, dtype=float)
+    energy = np.asarray(energy, dtype=float)
+    flux = np.ascontiguousarray(flux, dtype=float).reshape(
+        len(temperatures), len(energy) - 1)
+    rates = np.zeros(len(temperatures)*len(indices)*len(MTs))
+    _dll.openmc_collapse_rates(len(temperatures), temperatures, energy,
+                               flux.ravel(), len(energy) - 1, len(indices),
+                               indices, len(MTs), MTs, rates)
+    return rates.reshape(len(temperatures), len(indices), len(MTs))
+
+
 class Nuclide(_FortranObject):
     """Nuclide stored internally.
 
@@ -60,6 +115,11 @@ class Nuclide(_FortranObject):
     ----------
     name : str
         Name of the nuclide, e.g. 'U235'
+    memory_usage : int
+        Memory in [bytes] held by the cross sections, energy grids, and
+        resonance data of the nuclide at all temperatures that have been read
+
+        .. versionadded:: 0.13.1
 
     """
     __instances = WeakValueDictionary()
@@ -79,6 +139,12 @@ class Nuclide(_FortranObject):
         _dll.openmc_nuclide_name(self._index, name)
         return name.value.decode()
 
+    @property
+    def memory_usage(self):
+        nbytes = c_int64()
+        _dll.openmc_nuclide_memory_usage(self._index, nbytes)
+        return nbytes.value
+
     def collapse_rate(self, MT, temperature, energy, flux):
         """Calculate reaction rate based on group-wise flux distribution
 
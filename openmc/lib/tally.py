@@ -3,7 +3,7 @@ from ctypes import c_int, c_int32, c_size_t, c_double, c_char_p, c_bool, POINTER
 from weakref import WeakValueDictionary
 
 import numpy as np
-from numpy.ctypeslib import as_array
+from numpy.ctypeslib import as_array, ndpointer
 import scipy.stats
 
 from openmc.exceptions import AllocationError, InvalidIDError
@@ -12,9 +12,11 @@ from . import _dll, Nuclide
 from .core import _FortranObjectWithID
 from .error import _error_handler
 from .filter import _get_filter
+from .nuclide import nuclides as _nuclides
 
 
-__all__ = ['Tally', 'tallies', 'global_tallies', 'num_realizations']
+__all__ = ['Tally', 'tallies', 'global_tallies', 'num_realizations',
+           'set_flux_spectrum', 'flux_spectrum', 'flux_spectrum_collapse_rates']
 
 # Tally functions
 _dll.openmc_extend_tallies.argtypes = [c_int32, POINTER(c_int32), POINTER(c_int32)]
@@ -56,6 +58,10 @@ _dll.openmc_tally_get_type.errcheck = _error_handler
 _dll.openmc_tally_get_writable.argtypes = [c_int32, POINTER(c_bool)]
 _dll.openmc_tally_get_writable.restype = c_int
 _dll.openmc_tally_get_writable.errcheck = _error_handler
+_dll.openmc_tally_mean_std_dev.argtypes = [
+    c_int32, c_int, c_int, POINTER(c_double), POINTER(c_double)]
+_dll.openmc_tally_mean_std_dev.restype = c_int
+_dll.openmc_tally_mean_std_dev.errcheck = _error_handler
 _dll.openmc_tally_reset.argtypes = [c_int32]
 _dll.openmc_tally_reset.restype = c_int
 _dll.openmc_tally_reset.errcheck = _error_handler
@@ -88,6 +94,24 @@ _dll.openmc_tally_set_writable.argtypes = [c_int32, c_bool]
 _dll.openmc_tally_set_writable.restype = c_int
 _dll.openmc_tally_set_writable.errcheck = _error_handler
 _dll.tallies_size.restype = c_size_t
+_array_1d_int32 = ndpointer(dtype=np.int32, ndim=1, flags='CONTIGUOUS')
+_array_1d_int = ndpointer(dtype=np.intc, ndim=1, flags='CONTIGUOUS')
+_array_1d_dble = ndpointer(dtype=np.double, ndim=1, flags='CONTIGUOUS')
+_dll.openmc_flux_spectrum_set.argtypes = [
+    c_int, _array_1d_int32, c_int, c_double, c_double, c_bool]
+_dll.openmc_flux_spectrum_set.restype = c_int
+_dll.openmc_flux_spectrum_set.errcheck = _error_handler
+_dll.openmc_flux_spectrum_get_energy.argtypes = [
+    POINTER(POINTER(c_double)), POINTER(c_int), POINTER(c_int)]
+_dll.openmc_flux_spectrum_get_energy.restype = c_int
+_dll.openmc_flux_spectrum_get_energy.errcheck = _error_handler
+_dll.openmc_flux_spectrum_get_flux.argtypes = [c_int, _array_1d_dble]
+_dll.openmc_flux_spectrum_get_flux.restype = c_int
+_dll.openmc_flux_spectrum_get_flux.errcheck = _error_handler
+_dll.openmc_flux_spectrum_collapse_rates.argtypes = [
+    _array_1d_dble, c_int, _array_1d_int, c_int, _array_1d_int, _array_1d_dble]
+_dll.openmc_flux_spectrum_collapse_rates.restype = c_int
+_dll.openmc_flux_spectrum_collapse_rates.errcheck = _error_handler
 
 
 _SCORES = {
@@ -95,13 +119,15 @@ _SCORES = {
     -5: 'absorption', -6: 'fission', -7: 'nu-fission', -8: 'kappa-fission',
     -9: 'current', -10: 'events', -11: 'delayed-nu-fission',
     -12: 'prompt-nu-fission', -13: 'inverse-velocity', -14: 'fission-q-prompt',
-    -15: 'fission-q-recoverable', -16: 'decay-rate'
+    -15: 'fission-q-recoverable', -16: 'decay-rate', -17: 'pulse-height',
+    -18: 'ifp-time-numerator', -19: 'ifp-beta-numerator',
+    -20: 'ifp-denominator'
 }
 _ESTIMATORS = {
     0: 'analog', 1: 'tracklength', 2: 'collision'
 }
 _TALLY_TYPES = {
-    0: 'volume', 1: 'mesh-surface', 2: 'surface'
+    0: 'volume', 1: 'mesh-surface', 2: 'surface', 3: 'pulse-height'
 }
 
 
@@ -144,6 +170,111 @@ def num_realizations():
     return c_int32.in_dll(_dll, 'n_realizations').value
 
 
+def set_flux_spectrum(materials, n_groups, energy_min=1.0e-5,
+                      energy_max=20.0e6, sparse=False):
+    """Tally a fine-group neutron flux spectrum in each of a set of materials
+
+    The spectrum is tallied with a track-length estimator during active
+    batches, in groups equally spaced in lethargy. It takes much less memory
+    and time than a tally with a material filter and an energy filter with the
+    same groups, since the group of each track is computed directly and the
+    flux is accumulated in single precision. Calling this discards any
+    spectrum tallied before.
+
+    .. versionadded:: 0.13.1
+
+    Parameters
+    ----------
+    materials : iterable of openmc.lib.Material
+        Materials to tally the spectrum in
+    n_groups : int
+        Number of groups, or 0 to stop tallying the spectrum
+    energy_min : float
+        Lower boundary of the lowest group in [eV]
+    energy_max : float
+        Upper boundary of the highest group in [eV]
+    sparse : bool
+        Whether to only allocate memory for groups once they are scored, which
+        saves memory when most materials only see part of the spectrum
+
+    """
+    indices = np.array([m._index for m in materials], dtype=np.int32)
+    _dll.openmc_flux_spectrum_set(len(indices), indices, n_groups, energy_min,
+                                  energy_max, sparse)
+
+
+def flux_spectrum():
+    """Group boundaries and flux of the fine-group flux spectrum
+
+    The flux is complete once the simulation has been finalized.
+
+    .. versionadded:: 0.13.1
+
+    Returns
+    -------
+    energy : numpy.ndarray
+        Group boundaries in [eV]
+    flux : numpy.ndarray
+        Flux per source particle with shape ``(n_materials, n_groups)``, in
+        the order of the materials passed to :func:`set_flux_spectrum`
+
+    """
+    ptr = POINTER(c_double)()
+    n_groups = c_int()
+    n_materials = c_int()
+    _dll.openmc_flux_spectrum_get_energy(ptr, n_groups, n_materials)
+    if n_groups.value == 0:
+        return np.array([]), np.zeros((0, 0))
+    energy = as_array(ptr, (n_groups.value + 1,)).copy()
+
+    flux = np.zeros((n_materials.value, n_groups.value))
+    for i in range(n_materials.value):
+        _dll.openmc_flux_spectrum_get_flux(i, flux[i])
+    return energy, flux
+
+
+def flux_spectrum_collapse_rates(nuclides, MTs, temperatures):
+    """Collapse reaction rates with the fine-group flux spectrum
+
+    This gives the same rates as :func:`openmc.lib.collapse_rates` with the
+    spectrum of each material, but the spectra are used where they are stored
+    rather than copied out first.
+
+    .. versionadded:: 0.13.1
+
+    Parameters
+    ----------
+    nuclides : iterable of str
+        Names of the nuclides
+    MTs : iterable of int
+        ENDF MT values of the desired reactions
+    temperatures : iterable of float
+        Temperature in [K] at which to evaluate cross sections for each
+        material of the spectrum
+
+    Returns
+    -------
+    numpy.ndarray
+        Reaction rates per source particle and unit atom density with shape
+        ``(n_materials, n_nuclides, n_MTs)``
+
+    """
+    indices = np.array([_nuclides[name]._index for name in nuclides],
+                       dtype=np.intc)
+    MTs = np.asarray(MTs, dtype=np.intc)
+    temperatures = np.asarray(temperatures, dtype=float)
+    n_materials = c_int()
+    _dll.openmc_flux_spectrum_get_energy(
+        POINTER(c_double)(), c_int(), n_materials)
+    if len(temperatures) != n_materials.value:
+        raise ValueError('A temperature must be given for each material of '
+                         'the flux spectrum.')
+    rates = np.zeros(len(temperatures)*len(indices)*len(MTs))
+    _dll.openmc_flux_spectrum_collapse_rates(
+        temperatures, len(indices), indices, len(MTs), MTs, rates)
+    return rates.reshape(len(temperatures), len(indices), len(MTs))
+
+
 class Tally(_FortranObjectWithID):
     """Tally stored internally.
 
@@ -269,12 +400,10 @@ class Tally(_FortranObjectWithID):
 
     @property
     def mean(self):
-        n = self.num_realizations
-        sum_ = self.results[:, :, 1]
-        if n > 0:
-            return sum_ / n
-        else:
-            return sum_.copy()
+        mean = np.empty(self.results.shape[:2])
+        _dll.openmc_tally_mean_std_dev(
+            self._index, -1, 0, mean.ctypes.data_as(POINTER(c_double)), None)
+        return mean
 
     @property
     def nuclides(self):
@@ -330,24 +459,9 @@ class Tally(_FortranObjectWithID):
 
     @property
     def std_dev(self):
-        results = self.results
-        std_dev = np.empty(results.shape[:2])
-        std_dev.fill(np.inf)
-
-        n = self.num_realizations
-        if n > 1:
-            # Get sum and sum-of-squares from results
-            sum_ = results[:, :, 1]
-            sum_sq = results[:, :, 2]
-
-            # Determine non-zero entries
-            mean = sum_ / n
-            nonzero = np.abs(mean) > 0
-
-            # Calculate sample standard deviation of the mean
-            std_dev[nonzero] = np.sqrt(
-                (sum_sq[nonzero]/n - mean[nonzero]**2)/(n - 1))
-
+        std_dev = np.empty(self.results.shape[:2])
+        _dll.openmc_tally_mean_std_dev(
+            self._index, -1, 0, None, std_dev.ctypes.data_as(POINTER(c_double)))
         return std_dev
 
     @property
@@ -63,6 +63,12 @@ class Material(IDManagerMixin):
         applies in the case of a multi-group calculation.
     depletable : bool
         Indicate whether the material is depletable.
+    tabulate_xs : bool
+        Indicate whether macroscopic cross sections for the material should be
+        tabulated at initialization. This is only appropriate for materials
+        whose composition does not change during a simulation.
+
+        .. versionadded:: 0.13.1
     nuclides : list of namedtuple
         List in which each item is a namedtuple consisting of a nuclide string,
         the percent density, and the percent type ('ao' or 'wo'). The namedtuple
@@ -106,6 +112,7 @@ class Material(IDManagerMixin):
         self._density = None
         self._density_units = 'sum'
         self._depletable = False
+        self._tabulate_xs = False
         self._paths = None
         self._num_instances = None
         self._volume = None
@@ -173,6 +180,10 @@ class Material(IDManagerMixin):
     def depletable(self):
         return self._depletable
 
+    @property
+    def tabulate_xs(self):
+        return self._tabulate_xs
+
     @property
     def paths(self):
         if self._paths is None:
@@ -238,6 +249,12 @@ class Material(IDManagerMixin):
                       depletable, bool)
         self._depletable = depletable
 
+    @tabulate_xs.setter
+    def tabulate_xs(self, tabulate_xs: bool):
+        cv.check_type(f'Tabulate cross sections flag for Material ID="{self._id}"',
+                      tabulate_xs, bool)
+        self._tabulate_xs = tabulate_xs
+
     @volume.setter
     def volume(self, volume: Real):
         if volume is not None:
@@ -1021,6 +1038,9 @@ class Material(IDManagerMixin):
         if self._depletable:
             element.set("depletable", "true")
 
+        if self._tabulate_xs:
+            element.set("tabulate_xs", "true")
+
         if self._volume:
             element.set("volume", str(self._volume))
 
@@ -1185,6 +1205,7 @@ class Material(IDManagerMixin):
         if 'volume' in elem.attrib:
             mat.volume = float(elem.get('volume'))
         mat.depletable = bool(elem.get('depletable'))
+        mat.tabulate_xs = elem.get('tabulate_xs') in ('true', '1')
 
         # Get each nuclide
         for nuclide in elem.findall('nuclide'):
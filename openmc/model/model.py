@@ -462,15 +462,24 @@ class Model:
                 raise ValueError("Number of cells in properties file doesn't "
                                  "match current model.")
 
+            # Files written before version 2.0 of the format have one group
+            # per cell and per material
+            if 'temperature' in cells_group:
+                offset = cells_group['temperature_offset'][()]
+                temperatures = cells_group['temperature'][()]
+                cell_temperatures = (
+                    (cell_id, temperatures[offset[i]:offset[i + 1]])
+                    for i, cell_id in enumerate(cells_group['id'][()]))
+            else:
+                cell_temperatures = (
+                    (int(name.split()[1]), group['temperature'][()])
+                    for name, group in cells_group.items())
+
             # Update temperatures for cells filled with materials
-            for name, group in cells_group.items():
-                cell_id = int(name.split()[1])
+            for cell_id, temperature in cell_temperatures:
                 cell = cells[cell_id]
                 if cell.fill_type in ('material', 'distribmat'):
-                    cell.temperature = group['temperature'][()]
-                    if self.is_initialized:
-                        lib_cell = openmc.lib.cells[cell_id]
-                        lib_cell.set_temperature(group['temperature'][()])
+                    cell.temperature = temperature
 
             # Make sure number of materials matches
             mats_group = fh['materials']
@@ -479,14 +488,21 @@ class Model:
                 raise ValueError("Number of materials in properties file "
                                  "doesn't match current model.")
 
+            if 'atom_density' in mats_group:
+                mat_densities = zip(mats_group['id'][()],
+                                    mats_group['atom_density'][()])
+            else:
+                mat_densities = (
+                    (int(name.split()[1]), group.attrs['atom_density'])
+                    for name, group in mats_group.items())
+
             # Update material densities
-            for name, group in mats_group.items():
-                mat_id = int(name.split()[1])
-                atom_density = group.attrs['atom_density']
+            for mat_id, atom_density in mat_densities:
                 materials[mat_id].set_density('atom/b-cm', atom_density)
-                if self.is_initialized:
-                    C_mat = openmc.lib.materials[mat_id]
-                    C_mat.set_density(atom_density, 'atom/b-cm')
+
+        # Update the values loaded in memory all at once
+        if self.is_initialized:
+            openmc.lib.import_properties(filename)
 
     def run(self, particles=None, threads=None, geometry_debug=False,
             restart_file=None, tracks=False, output=True, cwd='.',
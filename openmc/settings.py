@@ -11,8 +11,10 @@ from xml.etree import ElementTree as ET
 
 import openmc.checkvalue as cv
 
-from . import RegularMesh, Source, VolumeCalculation, WeightWindows
+from . import (MeshBase, RegularMesh, Source, VolumeCalculation,
+               WeightWindows, WeightWindowGenerator)
 from ._xml import clean_indentation, get_text, reorder_attributes
+from .stats import MeshSpatial
 
 
 class RunMode(Enum):
@@ -31,8 +33,42 @@ class Settings:
 
     Attributes
     ----------
+    async_statepoint : bool
+        Whether to write state point and source files in the background while
+        the following batches are simulated. The summary file is also written
+        in the background.
+
+        .. versionadded:: 0.13.1
+    auto_tune : bool
+        Whether to tune the number of logarithmic grid bins and, in
+        event-based mode, the maximum number of particles in flight during
+        the inactive batches of an eigenvalue simulation
+
+        .. versionadded:: 0.13.1
     batches : int
         Number of batches to simulate
+    census_times : Iterable of float
+        Times in [s] at which all particles in a fixed source simulation are
+        banked. The banked particles are combed back to the number of particles
+        per batch before transport continues to the next census time.
+
+        .. versionadded:: 0.13.1
+    compact_bank : bool
+        Whether source sites exchanged between MPI processes are stored with a
+        single precision direction to reduce memory and communication
+
+        .. versionadded:: 0.13.1
+    compact_micro_xs : bool
+        Whether to size each particle's cache of microscopic cross sections by
+        the largest number of nuclides in any material rather than by the
+        number of nuclides in the problem
+
+        .. versionadded:: 0.13.1
+    condense_relaxation : bool
+        Whether atomic relaxation skips vacancy cascades that can only emit
+        particles below the energy cutoffs
+
+        .. versionadded:: 0.13.1
     confidence_intervals : bool
         If True, uncertainties on tally results will be reported as the
         half-width of the 95% two-sided confidence interval. If False,
@@ -40,6 +76,19 @@ class Settings:
         deviation.
     create_fission_neutrons : bool
         Indicate whether fission neutrons should be created or not.
+    crossing_recovery : dict
+        Settings for recovering particles that are not in any neighbor of the
+        cell they left after crossing a surface. Accepted keys are 'enable'
+        (bool) and 'distance' (float). The particle is moved 'distance' [cm]
+        past the surface and the neighbor lists are tried again before all
+        cells are searched. Misses are counted for each surface.
+
+        .. versionadded:: 0.13.1
+    cross_sections_cache : str
+        Directory in which derived nuclide cross sections are cached between
+        runs. The directory must already exist.
+
+        .. versionadded:: 0.13.1
     cutoff : dict
         Dictionary defining weight cutoff and energy cutoff. The dictionary may
         have six keys, 'weight', 'weight_avg', 'energy_neutron', 'energy_photon',
@@ -55,9 +104,22 @@ class Settings:
         release of delayed photons.
 
         .. versionadded:: 0.12
-    electron_treatment : {'led', 'ttb'}
-        Whether to deposit all energy from electrons locally ('led') or create
-        secondary bremsstrahlung photons ('ttb').
+    delta_tracking : dict
+        Settings for delta (Woodcock) tracking of neutrons through universes.
+        Accepted keys are 'enable' (bool), 'universes' (list of int), and
+        'max_ratio' (float). The 'universes' list gives the IDs of the
+        universes to delta track; in its absence, every universe other than
+        the root universe is delta tracked. Surface tracking is used instead
+        where the majorant cross section exceeds the total cross section by
+        more than 'max_ratio' (default 10). Tallies without an explicit
+        estimator use collision estimators when delta tracking is enabled,
+        and explicit track-length estimators are not supported.
+
+        .. versionadded:: 0.13.1
+    electron_treatment : {'led', 'ttb', 'ch'}
+        Whether to deposit all energy from electrons locally ('led'), create
+        secondary bremsstrahlung photons ('ttb'), or transport electrons and
+        positrons with condensed history steps ('ch').
     energy_mode : {'continuous-energy', 'multi-group'}
         Set whether the calculation should be continuous-energy or multi-group.
     entropy_mesh : openmc.RegularMesh
@@ -69,8 +131,76 @@ class Settings:
         history-based parallelism.
 
         .. versionadded:: 0.12
+    event_min_queue_size : int
+        Minimum number of particles in a queue for its kernel to be executed
+        with the 'ordered' event schedule.
+
+        .. versionadded:: 0.13.1
+    event_refill_threshold : float
+        Fraction of the particle buffer in event-based mode below which new
+        source particles are started in the slots of dead particles. A value
+        of zero disables refilling.
+
+        .. versionadded:: 0.13.1
+    event_schedule : {'longest', 'ordered'}
+        How the next kernel is chosen in event-based mode: the kernel with the
+        longest queue, or each kernel in a fixed order.
+
+        .. versionadded:: 0.13.1
+    event_secondary_queue : bool
+        Whether secondary particles are shared between the slots of the
+        particle buffer in event-based fixed source calculations, so that free
+        slots are refilled with queued secondaries.
+
+        .. versionadded:: 0.13.1
+    event_sort_threshold : int
+        Minimum number of particles in an event-based queue for it to be
+        sorted by particle type, material, and energy.
+
+        .. versionadded:: 0.13.1
+    event_xs_batch_size : int
+        Maximum number of particles in the same material whose cross sections
+        are looked up together in event-based mode. A value of zero disables
+        batched lookups.
+
+        .. versionadded:: 0.13.1
+    fission_matrix : dict
+        Settings for a fission matrix tallied on the entropy mesh during
+        inactive batches. Accepted keys are 'enable' (bool) and 'interval'
+        (int). Every 'interval' inactive batches, the source is reweighted so
+        that its distribution over the mesh matches the dominant eigenvector of
+        the fission matrix. An interval of zero (the default) only tallies the
+        matrix, which is written to statepoint files.
+
+        .. versionadded:: 0.13.1
     generations_per_batch : int
         Number of generations per batch
+    hash_grid_points_per_bin : int
+        Target number of energy grid points per bin for the hash energy grid
+        search. Logarithmic bins containing more points are subdivided for each
+        nuclide. A value of zero disables the hash grid.
+
+        .. versionadded:: 0.13.1
+    history_schedule : {'loop', 'work_stealing'}
+        How histories are distributed among threads in history-based mode: an
+        OpenMP loop with the runtime schedule, or per-thread ranges with idle
+        threads stealing work from others.
+
+        .. versionadded:: 0.13.1
+    huge_pages : bool
+        Whether large nuclide cross section and tally arrays are backed by
+        huge pages when the operating system provides them.
+
+        .. versionadded:: 0.13.1
+    ifp_n_generation : int
+        Number of generations of ancestors kept for each source site in an
+        eigenvalue calculation, which is needed for the 'ifp-time-numerator',
+        'ifp-beta-numerator', and 'ifp-denominator' tally scores. These scores
+        weight each fission by the iterated fission probability of its
+        ancestor this many generations back, giving adjoint-weighted kinetics
+        parameters.
+
+        .. versionadded:: 0.13.1
     max_lost_particles : int
         Maximum number of lost particles
 
@@ -81,12 +211,22 @@ class Settings:
         .. versionadded:: 0.12
     inactive : int
         Number of inactive batches
+    io_stripe_size : int
+        Stripe size in bytes of the file system that files are written to in
+        parallel, used to align and chunk the data in them.
+
+        .. versionadded:: 0.13.1
     keff_trigger : dict
         Dictionary defining a trigger on eigenvalue. The dictionary must have
         two keys, 'type' and 'threshold'. Acceptable values corresponding to
         type are 'variance', 'std_dev', and 'rel_err'. The threshold value
         should be a float indicating the variance, standard deviation, or
         relative error used.
+    lattice_dda : bool
+        Whether distances to the tile boundaries of rectangular lattices are
+        updated incrementally as particles move rather than recomputed
+
+        .. versionadded:: 0.13.1
     log_grid_bins : int
         Number of bins for logarithmic energy grid search
     material_cell_offsets : bool
@@ -108,23 +248,100 @@ class Settings:
     max_tracks : int
         Maximum number of tracks written to a track file (per MPI process).
 
+        .. versionadded:: 0.13.1
+    mmap_source_files : bool
+        Whether to sample sites in source files from a memory map of the file
+        when its layout allows it, instead of reading them into memory.
+
+        .. versionadded:: 0.13.1
+    mpi_progress_thread : bool
+        Whether each process starts a thread that makes progress on
+        non-blocking MPI communication while particles are transported
+
         .. versionadded:: 0.13.1
     no_reduce : bool
         Indicate that all user-defined and global tallies should not be reduced
         across processes in a parallel calculation.
+    numa_first_touch : bool
+        Whether nuclide cross sections, tally results, and event-based particle
+        buffers are first touched by all threads so that their memory is spread
+        over the NUMA domains of the threads.
+
+        .. versionadded:: 0.13.1
     output : dict
         Dictionary indicating what files to output. Acceptable keys are:
 
         :path: String indicating a directory where output files should be
                written
         :summary: Whether the 'summary.h5' file should be written (bool)
+        :summary_compact: Whether cells and universes in 'summary.h5' are
+                          written as tables rather than one group per object
+                          (bool)
+        :summary_reuse: Whether an existing 'summary.h5' written from the same
+                        input files is kept rather than rewritten (bool)
         :tallies: Whether the 'tallies.out' file should be written (bool)
+        :tallies_max_bins: Maximum number of results a tally may have to be
+                           written to 'tallies.out'; larger tallies are only
+                           written to the statepoint (int)
+    overlap_checks : dict
+        Settings for checking for overlapping cells during transport. Accepted
+        keys are 'enable' (bool), 'fraction' (float) and 'crossings_only'
+        (bool). Overlaps are checked at the given fraction of events, and only
+        after a particle crosses a surface or lattice boundary if
+        'crossings_only' is True.
+
+        .. versionadded:: 0.13.1
     particles : int
         Number of particles per generation
+    partition_source_files : bool
+        Whether each process reads and samples only its own slice of the sites
+        in source files.
+
+        .. versionadded:: 0.13.1
+    photon_scattering_tables : bool
+        Whether coherent and incoherent photon scattering angles are sampled
+        from tabulated inverse cumulative distributions rather than by
+        rejection
+
+        .. versionadded:: 0.13.1
     photon_transport : bool
         Whether to use photon transport.
+    pipelined_bank : bool
+        Whether the exchange of source sites between MPI processes overlaps
+        with transport of the next generation
+
+        .. versionadded:: 0.13.1
+    precompute_neighbors : bool
+        Whether the neighbor lists of cells are filled from the surfaces they
+        share before any particles are transported
+
+        .. versionadded:: 0.13.1
+    profile : bool
+        Whether the time spent in cross section lookups, distance to boundary
+        calculations, cell searches, collisions, and tally scoring is measured
+        and reported in the output and statepoint files
+
+        .. versionadded:: 0.13.1
+    profile_domains : bool
+        Whether the time spent in cross section lookups and collisions is
+        attributed to materials, the time spent in distance to boundary
+        calculations to cells, and the time spent scoring to tallies. This
+        enables profiling.
+
+        .. versionadded:: 0.13.1
     ptables : bool
         Determine whether probability tables are used.
+    random_ray : dict
+        Settings for solving multigroup problems with the random ray method
+        instead of Monte Carlo. Accepted keys are 'distance_active' (float),
+        the length in [cm] over which each ray tallies the flux,
+        'distance_inactive' (float), the length in [cm] a ray travels first to
+        forget its starting flux, and 'lower_left' and 'upper_right' (iterable
+        of float), the corners of the box in which rays start. Each material
+        cell instance is a flat source region. The fluxes and volumes of the
+        regions are written to random_ray.h5.
+
+        .. versionadded:: 0.13.1
     resonance_scattering : dict
         Settings for resonance elastic scattering. Accepted keys are 'enable'
         (bool), 'method' (str), 'energy_min' (float), 'energy_max' (float), and
@@ -140,8 +357,29 @@ class Settings:
         The type of calculation to perform (default is 'eigenvalue')
     seed : int
         Seed for the linear congruential pseudorandom number generator
+    secondary_bank_capacity : int
+        Number of secondary particles that room is reserved for in the
+        secondary bank of each thread. Weight windows do not split particles
+        beyond this capacity.
+
+        .. versionadded:: 0.13.1
+    shared_cross_sections : bool
+        Whether processes on the same node share a single copy of nuclide
+        energy grids and cross sections. Requires MPI-3 shared memory support.
+
+        .. versionadded:: 0.13.1
     source : Iterable of openmc.Source
         Distribution of source sites in space, angle, and energy
+    source_compression : int
+        Deflate compression level from 0 to 9 for source banks written to
+        files. A value of zero stores source banks uncompressed.
+
+        .. versionadded:: 0.13.1
+    source_precision : {'double', 'single'}
+        Precision of positions and directions of source sites written to
+        files.
+
+        .. versionadded:: 0.13.1
     sourcepoint : dict
         Options for writing source points. Acceptable keys are:
 
@@ -165,6 +403,12 @@ class Settings:
                    banked (int)
         :max_particles: Maximum number of particles to be banked on
                    surfaces per process (int)
+        :stream: Whether to write banked particles to the file as they are
+                 collected rather than holding them in memory until the end
+                 of the simulation (bool)
+
+        .. versionadded:: 0.13.1
+           The *stream* key
     survival_biasing : bool
         Indicate whether survival biasing is to be used
     tabular_legendre : dict
@@ -174,19 +418,48 @@ class Settings:
         'enable' is a bool stating whether the conversion to tabular is
         performed; the value for 'num_points' sets the number of points to use
         in the tabular distribution, should 'enable' be True.
+    tally_rank_files : bool
+        Whether each process writes its tally results to a separate file at
+        each state point when tallies are not reduced. The files can be merged
+        into the state point with the ``openmc-merge-tallies`` script.
+
+        .. versionadded:: 0.13.1
+    tally_reduce_interval : int
+        Number of batches between reductions of tally results across MPI
+        processes. Scores from the batches in between are combined into a
+        single realization.
+
+        .. versionadded:: 0.13.1
+    tally_stream : dict
+        Options for publishing the mean and variance of tally results after
+        each active batch to a memory-mapped file. Acceptable keys are:
+
+        :path: Path to the file that results are written to (str)
+        :tallies: IDs of the tallies to publish, all tallies if not given
+                  (list of int)
+
+        .. versionadded:: 0.13.1
     temperature : dict
         Defines a default temperature and method for treating intermediate
         temperatures at which nuclear data doesn't exist. Accepted keys are
-        'default', 'method', 'range', 'tolerance', and 'multipole'. The value
-        for 'default' should be a float representing the default temperature in
-        Kelvin. The value for 'method' should be 'nearest' or 'interpolation'.
+        'default', 'method', 'range', 'tolerance', 'multipole',
+        'multipole_quadrature', and 'lazy'. The
+        value for 'default' should be a float representing the default
+        temperature in Kelvin. The value for 'method' should be 'nearest' or 'interpolation'.
         If the method is 'nearest', 'tolerance' indicates a range of temperature
         within which cross sections may be used. The value for 'range' should be
         a pair a minimum and maximum temperatures which are used to indicate
         that cross sections be loaded at all temperatures within the
         range. 'multipole' is a boolean indicating whether or not the windowed
         multipole method should be used to evaluate resolved resonance cross
-        sections.
+        sections. 'multipole_quadrature' is a boolean indicating whether the
+        Faddeeva function should be approximated by quadrature for poles far
+        from the energy, which is faster but changes cross sections by about
+        1e-6 relative. 'lazy' is a boolean indicating whether temperatures
+        that are loaded only because they fall within 'range' should be read
+        the first time a cross section lookup needs them. In multigroup mode, it
+        indicates whether the macroscopic cross sections of each material
+        should be built the first time they are needed.
     trace : tuple or list
         Show detailed information about a single particle, indicated by three
         integers: the batch number, generation number, and particle number
@@ -194,6 +467,38 @@ class Settings:
         Specify particles for which track files should be written. Each particle
         is identified by a tuple with the batch number, generation number, and
         particle number.
+    track_compression : int
+        Deflate compression level from 0 to 9 for particle track files. A value
+        of zero stores tracks uncompressed.
+
+        .. versionadded:: 0.13.1
+    track_delta_positions : bool
+        Whether each position in a particle track after the first is stored as
+        the displacement from the previous position. :class:`openmc.Tracks`
+        restores the absolute positions when reading the file.
+
+        .. versionadded:: 0.13.1
+    track_fraction : float
+        Fraction of particles, chosen at random, for which tracks are written
+        when tracks are written for all particles
+
+        .. versionadded:: 0.13.1
+    track_precision : {'double', 'single'}
+        Precision of positions and directions of track states written to
+        particle track files
+
+        .. versionadded:: 0.13.1
+    track_region : tuple
+        Lower-left and upper-right corners of a box. Only primary/secondary
+        particles with at least one track state in the box are written to
+        particle track files.
+
+        .. versionadded:: 0.13.1
+    track_writer_thread : bool
+        Whether buffered particle tracks are written to the track file from a
+        background thread. This requires a thread-safe build of HDF5.
+
+        .. versionadded:: 0.13.1
     trigger_active : bool
         Indicate whether tally triggers are used
     trigger_batch_interval : int
@@ -205,11 +510,27 @@ class Settings:
     ufs_mesh : openmc.RegularMesh
         Mesh to be used for redistributing source sites via the uniform fission
         site (UFS) method.
+    union_grid : bool
+        Whether to build a unionized energy grid for each material so that a
+        single energy search per material replaces the per-nuclide searches.
+        This increases memory use.
+
+        .. versionadded:: 0.13.1
     verbosity : int
         Verbosity during simulation between 1 and 10. Verbosity levels are
         described in :ref:`verbosity`.
     volume_calculations : VolumeCalculation or iterable of VolumeCalculation
         Stochastic volume calculation specifications
+    weight_window_generators : WeightWindowGenerator or iterable of WeightWindowGenerator
+        Generators that set weight windows from the flux tallied during the
+        simulation
+
+        .. versionadded:: 0.13.1
+    weight_window_mesh_crossings : bool
+        Whether to apply weight windows whenever a particle crosses a bin
+        boundary of a weight window mesh, in addition to at collisions
+
+        .. versionadded:: 0.13.1
     weight_windows : WeightWindows iterable of WeightWindows
         Weight windows to use for variance reduction
 
@@ -218,8 +539,28 @@ class Settings:
         Whether weight windows are enabled
 
         .. versionadded:: 0.13
+    work_chunk_size : int
+        Number of histories that each MPI process claims at a time in fixed
+        source calculations with history-based parallelism. A value of zero
+        divides the histories evenly among processes.
+
+        .. versionadded:: 0.13.1
+    wielandt_shift : float
+        Amount by which the eigenvalue is shifted for Wielandt acceleration in
+        eigenvalue calculations. Part of the fission neutrons are transported
+        in the generation they were born in, which reduces the dominance ratio
+        of the iteration. A value of zero disables the shift.
+
+        .. versionadded:: 0.13.1
     write_initial_source : bool
         Indicate whether to write the initial source distribution to file
+    xs_cdf : bool
+        Whether each particle stores the cumulative macroscopic total cross
+        section over the nuclides of its material when cross sections are
+        looked up, so that the nuclide of a collision is sampled with a binary
+        search
+
+        .. versionadded:: 0.13.1
     """
 
     def __init__(self):
@@ -241,6 +582,8 @@ class Settings:
 
         self._confidence_intervals = None
         self._electron_treatment = None
+        self._electron_step_fraction = None
+        self._photon_scattering_tables = None
         self._photon_transport = None
         self._ptables = None
         self._seed = None
@@ -285,7 +628,12 @@ class Settings:
             VolumeCalculation, 'volume calculations')
 
         self._create_fission_neutrons = None
+        self._crossing_recovery = {}
         self._delayed_photon_scaling = None
+        self._delta_tracking = {}
+        self._fission_matrix = {}
+        self._overlap_checks = {}
+        self._random_ray = {}
         self._material_cell_offsets = None
         self._log_grid_bins = None
 
@@ -296,6 +644,53 @@ class Settings:
         self._weight_windows_on = None
         self._max_splits = None
         self._max_tracks = None
+        self._union_grid = None
+        self._event_xs_batch_size = None
+        self._hash_grid_points_per_bin = None
+        self._shared_cross_sections = None
+        self._numa_first_touch = None
+        self._huge_pages = None
+        self._cross_sections_cache = None
+        self._census_times = None
+        self._compact_bank = None
+        self._compact_micro_xs = None
+        self._xs_cdf = None
+        self._condense_relaxation = None
+        self._pipelined_bank = None
+        self._precompute_neighbors = None
+        self._profile = None
+        self._profile_domains = None
+        self._lattice_dda = None
+        self._tally_reduce_interval = None
+        self._tally_rank_files = None
+        self._tally_stream = {}
+        self._io_stripe_size = None
+        self._async_statepoint = None
+        self._auto_tune = None
+        self._source_compression = None
+        self._source_precision = None
+        self._partition_source_files = None
+        self._mmap_source_files = None
+        self._mpi_progress_thread = None
+        self._weight_window_mesh_crossings = None
+        self._weight_window_generators = cv.CheckedList(
+            WeightWindowGenerator, 'weight window generators')
+        self._secondary_bank_capacity = None
+        self._event_secondary_queue = None
+        self._event_schedule = None
+        self._event_min_queue_size = None
+        self._event_refill_threshold = None
+        self._event_sort_threshold = None
+        self._history_schedule = None
+        self._work_chunk_size = None
+        self._track_writer_thread = None
+        self._track_fraction = None
+        self._track_region = None
+        self._track_compression = None
+        self._track_precision = None
+        self._track_delta_positions = None
+        self._wielandt_shift = None
+        self._ifp_n_generation = None
 
     @property
     def run_mode(self) -> str:
@@ -349,10 +744,18 @@ class Settings:
     def electron_treatment(self) -> str:
         return self._electron_treatment
 
+    @property
+    def electron_step_fraction(self) -> float:
+        return self._electron_step_fraction
+
     @property
     def ptables(self) -> bool:
         return self._ptables
 
+    @property
+    def photon_scattering_tables(self) -> bool:
+        return self._photon_scattering_tables
+
     @property
     def photon_transport(self) -> bool:
         return self._photon_transport
@@ -445,10 +848,30 @@ class Settings:
     def create_fission_neutrons(self) -> bool:
         return self._create_fission_neutrons
 
+    @property
+    def crossing_recovery(self) -> dict:
+        return self._crossing_recovery
+
     @property
     def delayed_photon_scaling(self) -> bool:
         return self._delayed_photon_scaling
 
+    @property
+    def delta_tracking(self) -> dict:
+        return self._delta_tracking
+
+    @property
+    def fission_matrix(self) -> dict:
+        return self._fission_matrix
+
+    @property
+    def overlap_checks(self) -> dict:
+        return self._overlap_checks
+
+    @property
+    def random_ray(self) -> dict:
+        return self._random_ray
+
     @property
     def material_cell_offsets(self) -> bool:
         return self._material_cell_offsets
@@ -485,6 +908,190 @@ class Settings:
     def max_tracks(self) -> int:
         return self._max_tracks
 
+    @property
+    def union_grid(self) -> bool:
+        return self._union_grid
+
+    @property
+    def event_xs_batch_size(self) -> int:
+        return self._event_xs_batch_size
+
+    @property
+    def hash_grid_points_per_bin(self) -> int:
+        return self._hash_grid_points_per_bin
+
+    @property
+    def shared_cross_sections(self) -> bool:
+        return self._shared_cross_sections
+
+    @property
+    def numa_first_touch(self) -> bool:
+        return self._numa_first_touch
+
+    @property
+    def huge_pages(self) -> bool:
+        return self._huge_pages
+
+    @property
+    def cross_sections_cache(self) -> str:
+        return self._cross_sections_cache
+
+    @property
+    def census_times(self) -> typing.Iterable[Real]:
+        return self._census_times
+
+    @property
+    def compact_bank(self) -> bool:
+        return self._compact_bank
+
+    @property
+    def compact_micro_xs(self) -> bool:
+        return self._compact_micro_xs
+
+    @property
+    def xs_cdf(self) -> bool:
+        return self._xs_cdf
+
+    @property
+    def condense_relaxation(self) -> bool:
+        return self._condense_relaxation
+
+    @property
+    def pipelined_bank(self) -> bool:
+        return self._pipelined_bank
+
+    @property
+    def precompute_neighbors(self) -> bool:
+        return self._precompute_neighbors
+
+    @property
+    def profile(self) -> bool:
+        return self._profile
+
+    @property
+    def profile_domains(self) -> bool:
+        return self._profile_domains
+
+    @property
+    def lattice_dda(self) -> bool:
+        return self._lattice_dda
+
+    @property
+    def tally_reduce_interval(self) -> int:
+        return self._tally_reduce_interval
+
+    @property
+    def tally_rank_files(self) -> bool:
+        return self._tally_rank_files
+
+    @property
+    def tally_stream(self) -> dict:
+        return self._tally_stream
+
+    @property
+    def io_stripe_size(self) -> int:
+        return self._io_stripe_size
+
+    @property
+    def async_statepoint(self) -> bool:
+        return self._async_statepoint
+
+    @property
+    def auto_tune(self) -> bool:
+        return self._auto_tune
+
+    @property
+    def source_compression(self) -> int:
+        return self._source_compression
+
+    @property
+    def source_precision(self) -> str:
+        return self._source_precision
+
+    @property
+    def partition_source_files(self) -> bool:
+        return self._partition_source_files
+
+    @property
+    def mmap_source_files(self) -> bool:
+        return self._mmap_source_files
+
+    @property
+    def mpi_progress_thread(self) -> bool:
+        return self._mpi_progress_thread
+
+    @property
+    def weight_window_mesh_crossings(self) -> bool:
+        return self._weight_window_mesh_crossings
+
+    @property
+    def weight_window_generators(self) -> typing.List[WeightWindowGenerator]:
+        return self._weight_window_generators
+
+    @property
+    def secondary_bank_capacity(self) -> int:
+        return self._secondary_bank_capacity
+
+    @property
+    def event_secondary_queue(self) -> bool:
+        return self._event_secondary_queue
+
+    @property
+    def event_schedule(self) -> str:
+        return self._event_schedule
+
+    @property
+    def event_min_queue_size(self) -> int:
+        return self._event_min_queue_size
+
+    @property
+    def event_refill_threshold(self) -> float:
+        return self._event_refill_threshold
+
+    @property
+    def event_sort_threshold(self) -> int:
+        return self._event_sort_threshold
+
+    @property
+    def history_schedule(self) -> str:
+        return self._history_schedule
+
+    @property
+    def work_chunk_size(self) -> int:
+        return self._work_chunk_size
+
+    @property
+    def track_writer_thread(self) -> bool:
+        return self._track_writer_thread
+
+    @property
+    def track_fraction(self) -> float:
+        return self._track_fraction
+
+    @property
+    def track_region(self) -> tuple:
+        return self._track_region
+
+    @property
+    def track_compression(self) -> int:
+        return self._track_compression
+
+    @property
+    def track_precision(self) -> str:
+        return self._track_precision
+
+    @property
+    def track_delta_positions(self) -> bool:
+        return self._track_delta_positions
+
+    @property
+    def wielandt_shift(self) -> float:
+        return self._wielandt_shift
+
+    @property
+    def ifp_n_generation(self) -> int:
+        return self._ifp_n_generation
+
     @run_mode.setter
     def run_mode(self, run_mode: str):
         cv.check_value('run mode', run_mode, {x.value for x in RunMode})
@@ -582,11 +1189,16 @@ class Settings:
     def output(self, output: dict):
         cv.check_type('output', output, Mapping)
         for key, value in output.items():
-            cv.check_value('output key', key, ('summary', 'tallies', 'path'))
-            if key in ('summary', 'tallies'):
-                cv.check_type(f"output['{key}']", value, bool)
-            else:
+            cv.check_value('output key', key, ('summary', 'summary_compact',
+                           'summary_reuse', 'tallies', 'tallies_max_bins',
+                           'path'))
+            if key == 'path':
                 cv.check_type("output['path']", value, str)
+            elif key == 'tallies_max_bins':
+                cv.check_type(f"output['{key}']", value, Integral)
+                cv.check_greater_than(f"output['{key}']", value, 0, True)
+            else:
+                cv.check_type(f"output['{key}']", value, bool)
         self._output = output
 
     @verbosity.setter
@@ -643,7 +1255,7 @@ class Settings:
         cv.check_type('surface source writing options', surf_source_write, Mapping)
         for key, value in surf_source_write.items():
             cv.check_value('surface source writing key', key,
-                           ('surface_ids', 'max_particles'))
+                           ('surface_ids', 'max_particles', 'stream'))
             if key == 'surface_ids':
                 cv.check_type('surface ids for source banking', value,
                               Iterable, Integral)
@@ -655,6 +1267,8 @@ class Settings:
                               value, Integral)
                 cv.check_greater_than('maximum particle banks on surfaces per process',
                                       value, 0)
+            elif key == 'stream':
+                cv.check_type('stream surface source sites', value, bool)
         self._surf_source_write = surf_source_write
 
     @confidence_intervals.setter
@@ -664,9 +1278,22 @@ class Settings:
 
     @electron_treatment.setter
     def electron_treatment(self, electron_treatment: str):
-        cv.check_value('electron treatment', electron_treatment, ['led', 'ttb'])
+        cv.check_value('electron treatment', electron_treatment,
+                       ['led', 'ttb', 'ch'])
         self._electron_treatment = electron_treatment
 
+    @electron_step_fraction.setter
+    def electron_step_fraction(self, value: float):
+        cv.check_type('electron step fraction', value, Real)
+        cv.check_greater_than('electron step fraction', value, 0.0)
+        cv.check_less_than('electron step fraction', value, 1.0, True)
+        self._electron_step_fraction = value
+
+    @photon_scattering_tables.setter
+    def photon_scattering_tables(self, value: bool):
+        cv.check_type('photon scattering tables', value, bool)
+        self._photon_scattering_tables = value
+
     @photon_transport.setter
     def photon_transport(self, photon_transport: bool):
         cv.check_type('photon transport', photon_transport, bool)
@@ -759,7 +1386,7 @@ class Settings:
         for key, value in temperature.items():
             cv.check_value('temperature key', key,
                            ['default', 'method', 'tolerance', 'multipole',
-                            'range'])
+                            'multipole_quadrature', 'range', 'lazy'])
             if key == 'default':
                 cv.check_type('default temperature', value, Real)
             elif key == 'method':
@@ -769,6 +1396,10 @@ class Settings:
                 cv.check_type('temperature tolerance', value, Real)
             elif key == 'multipole':
                 cv.check_type('temperature multipole', value, bool)
+            elif key == 'multipole_quadrature':
+                cv.check_type('temperature multipole quadrature', value, bool)
+            elif key == 'lazy':
+                cv.check_type('temperature lazy', value, bool)
             elif key == 'range':
                 cv.check_length('temperature range', value, 2)
                 for T in value:
@@ -847,11 +1478,90 @@ class Settings:
                       create_fission_neutrons, bool)
         self._create_fission_neutrons = create_fission_neutrons
 
+    @crossing_recovery.setter
+    def crossing_recovery(self, crossing_recovery: dict):
+        cv.check_type('crossing recovery settings', crossing_recovery, Mapping)
+        for key, value in crossing_recovery.items():
+            cv.check_value('crossing recovery dictionary key', key,
+                           ('enable', 'distance'))
+            if key == 'enable':
+                cv.check_type('crossing recovery enable', value, bool)
+            elif key == 'distance':
+                cv.check_type('crossing recovery distance', value, Real)
+                cv.check_greater_than('crossing recovery distance', value, 0.0)
+        self._crossing_recovery = crossing_recovery
+
     @delayed_photon_scaling.setter
     def delayed_photon_scaling(self, value: bool):
         cv.check_type('delayed photon scaling', value, bool)
         self._delayed_photon_scaling = value
 
+    @delta_tracking.setter
+    def delta_tracking(self, delta: dict):
+        cv.check_type('delta tracking settings', delta, Mapping)
+        keys = ('enable', 'universes', 'max_ratio')
+        for key, value in delta.items():
+            cv.check_value('delta tracking dictionary key', key, keys)
+            if key == 'enable':
+                cv.check_type('delta tracking enable', value, bool)
+            elif key == 'universes':
+                cv.check_type('delta tracking universes', value,
+                              Iterable, Integral)
+            elif key == 'max_ratio':
+                name = 'delta tracking maximum majorant ratio'
+                cv.check_type(name, value, Real)
+                cv.check_greater_than(name, value, 1.0, equality=True)
+        self._delta_tracking = delta
+
+    @fission_matrix.setter
+    def fission_matrix(self, fission_matrix: dict):
+        cv.check_type('fission matrix settings', fission_matrix, Mapping)
+        for key, value in fission_matrix.items():
+            cv.check_value('fission matrix dictionary key', key,
+                           ('enable', 'interval'))
+            if key == 'enable':
+                cv.check_type('fission matrix enable', value, bool)
+            elif key == 'interval':
+                cv.check_type('fission matrix interval', value, Integral)
+                cv.check_greater_than('fission matrix interval', value, 0,
+                                      equality=True)
+        self._fission_matrix = fission_matrix
+
+    @overlap_checks.setter
+    def overlap_checks(self, overlap_checks: dict):
+        cv.check_type('overlap check settings', overlap_checks, Mapping)
+        for key, value in overlap_checks.items():
+            cv.check_value('overlap checks dictionary key', key,
+                           ('enable', 'fraction', 'crossings_only'))
+            if key == 'fraction':
+                cv.check_type('overlap check fraction', value, Real)
+                cv.check_greater_than('overlap check fraction', value, 0.0)
+                cv.check_less_than('overlap check fraction', value, 1.0,
+                                   equality=True)
+            else:
+                cv.check_type(f'overlap checks {key}', value, bool)
+        self._overlap_checks = overlap_checks
+
+    @random_ray.setter
+    def random_ray(self, random_ray: dict):
+        cv.check_type('random ray settings', random_ray, Mapping)
+        keys = ('distance_active', 'distance_inactive', 'lower_left',
+                'upper_right')
+        for key, value in random_ray.items():
+            cv.check_value('random ray dictionary key', key, keys)
+            if key == 'distance_active':
+                cv.check_type('random ray active distance', value, Real)
+                cv.check_greater_than('random ray active distance', value, 0.0)
+            elif key == 'distance_inactive':
+                cv.check_type('random ray inactive distance', value, Real)
+                cv.check_greater_than('random ray inactive distance', value,
+                                      0.0, equality=True)
+            elif key in ('lower_left', 'upper_right'):
+                name = f'random ray {key.replace("_", "-")} corner'
+                cv.check_type(name, value, Iterable, Real)
+                cv.check_length(name, value, 3)
+        self._random_ray = random_ray
+
     @event_based.setter
     def event_based(self, value: bool):
         cv.check_type('event based', value, bool)
@@ -902,6 +1612,276 @@ class Settings:
         cv.check_greater_than('maximum particle tracks', value, 0, True)
         self._max_tracks = value
 
+    @union_grid.setter
+    def union_grid(self, value: bool):
+        cv.check_type('union grid', value, bool)
+        self._union_grid = value
+
+    @event_xs_batch_size.setter
+    def event_xs_batch_size(self, value: int):
+        cv.check_type('event xs batch size', value, Integral)
+        cv.check_greater_than('event xs batch size', value, 0, True)
+        self._event_xs_batch_size = value
+
+    @hash_grid_points_per_bin.setter
+    def hash_grid_points_per_bin(self, value: int):
+        cv.check_type('hash grid points per bin', value, Integral)
+        cv.check_greater_than('hash grid points per bin', value, 0, True)
+        self._hash_grid_points_per_bin = value
+
+    @shared_cross_sections.setter
+    def shared_cross_sections(self, value: bool):
+        cv.check_type('shared cross sections', value, bool)
+        self._shared_cross_sections = value
+
+    @numa_first_touch.setter
+    def numa_first_touch(self, value: bool):
+        cv.check_type('NUMA first touch', value, bool)
+        self._numa_first_touch = value
+
+    @huge_pages.setter
+    def huge_pages(self, value: bool):
+        cv.check_type('huge pages', value, bool)
+        self._huge_pages = value
+
+    @cross_sections_cache.setter
+    def cross_sections_cache(self, value: str):
+        cv.check_type('cross sections cache', value, str)
+        self._cross_sections_cache = value
+
+    @census_times.setter
+    def census_times(self, times: typing.Iterable[Real]):
+        cv.check_type('census times', times, Iterable, Real)
+        times = list(times)
+        for t in times:
+            cv.check_greater_than('census time', t, 0.0)
+        if any(t1 <= t0 for t0, t1 in zip(times, times[1:])):
+            raise ValueError('Census times must be strictly increasing.')
+        self._census_times = times
+
+    @compact_bank.setter
+    def compact_bank(self, value: bool):
+        cv.check_type('compact bank', value, bool)
+        self._compact_bank = value
+
+    @compact_micro_xs.setter
+    def compact_micro_xs(self, value: bool):
+        cv.check_type('compact micro xs', value, bool)
+        self._compact_micro_xs = value
+
+    @xs_cdf.setter
+    def xs_cdf(self, value: bool):
+        cv.check_type('xs cdf', value, bool)
+        self._xs_cdf = value
+
+    @condense_relaxation.setter
+    def condense_relaxation(self, value: bool):
+        cv.check_type('condense relaxation', value, bool)
+        self._condense_relaxation = value
+
+    @pipelined_bank.setter
+    def pipelined_bank(self, value: bool):
+        cv.check_type('pipelined bank', value, bool)
+        self._pipelined_bank = value
+
+    @precompute_neighbors.setter
+    def precompute_neighbors(self, value: bool):
+        cv.check_type('precompute neighbors', value, bool)
+        self._precompute_neighbors = value
+
+    @profile.setter
+    def profile(self, value: bool):
+        cv.check_type('profile', value, bool)
+        self._profile = value
+
+    @profile_domains.setter
+    def profile_domains(self, value: bool):
+        cv.check_type('profile domains', value, bool)
+        self._profile_domains = value
+
+    @lattice_dda.setter
+    def lattice_dda(self, value: bool):
+        cv.check_type('lattice DDA', value, bool)
+        self._lattice_dda = value
+
+    @tally_reduce_interval.setter
+    def tally_reduce_interval(self, value: int):
+        cv.check_type('tally reduce interval', value, Integral)
+        cv.check_greater_than('tally reduce interval', value, 0)
+        self._tally_reduce_interval = value
+
+    @tally_rank_files.setter
+    def tally_rank_files(self, value: bool):
+        cv.check_type('tally rank files', value, bool)
+        self._tally_rank_files = value
+
+    @tally_stream.setter
+    def tally_stream(self, tally_stream: dict):
+        cv.check_type('tally stream options', tally_stream, Mapping)
+        for key, value in tally_stream.items():
+            cv.check_value('tally stream key', key, ('path', 'tallies'))
+            if key == 'path':
+                cv.check_type('tally stream path', value, str)
+            elif key == 'tallies':
+                cv.check_type('tally stream tallies', value, Iterable,
+                              Integral)
+                for tally_id in value:
+                    cv.check_greater_than('tally stream tally id',
+                                          tally_id, 0)
+        self._tally_stream = tally_stream
+
+    @io_stripe_size.setter
+    def io_stripe_size(self, value: int):
+        cv.check_type('I/O stripe size', value, Integral)
+        cv.check_greater_than('I/O stripe size', value, 0, True)
+        self._io_stripe_size = value
+
+    @async_statepoint.setter
+    def async_statepoint(self, value: bool):
+        cv.check_type('asynchronous state point', value, bool)
+        self._async_statepoint = value
+
+    @auto_tune.setter
+    def auto_tune(self, value: bool):
+        cv.check_type('auto-tune', value, bool)
+        self._auto_tune = value
+
+    @source_compression.setter
+    def source_compression(self, value: int):
+        cv.check_type('source compression level', value, Integral)
+        cv.check_greater_than('source compression level', value, 0, True)
+        cv.check_less_than('source compression level', value, 9, True)
+        self._source_compression = value
+
+    @source_precision.setter
+    def source_precision(self, value: str):
+        cv.check_value('source precision', value, ('double', 'single'))
+        self._source_precision = value
+
+    @partition_source_files.setter
+    def partition_source_files(self, value: bool):
+        cv.check_type('partition source files', value, bool)
+        self._partition_source_files = value
+
+    @mmap_source_files.setter
+    def mmap_source_files(self, value: bool):
+        cv.check_type('memory map source files', value, bool)
+        self._mmap_source_files = value
+
+    @mpi_progress_thread.setter
+    def mpi_progress_thread(self, value: bool):
+        cv.check_type('MPI progress thread', value, bool)
+        self._mpi_progress_thread = value
+
+    @weight_window_mesh_crossings.setter
+    def weight_window_mesh_crossings(self, value: bool):
+        cv.check_type('weight window mesh crossings', value, bool)
+        self._weight_window_mesh_crossings = value
+
+    @weight_window_generators.setter
+    def weight_window_generators(self, value):
+        if not isinstance(value, MutableSequence):
+            value = [value]
+        self._weight_window_generators = cv.CheckedList(
+            WeightWindowGenerator, 'weight window generators', value)
+
+    @secondary_bank_capacity.setter
+    def secondary_bank_capacity(self, value: int):
+        cv.check_type('secondary bank capacity', value, Integral)
+        cv.check_greater_than('secondary bank capacity', value, 0)
+        self._secondary_bank_capacity = value
+
+    @event_secondary_queue.setter
+    def event_secondary_queue(self, value: bool):
+        cv.check_type('event secondary queue', value, bool)
+        self._event_secondary_queue = value
+
+    @event_schedule.setter
+    def event_schedule(self, value: str):
+        cv.check_value('event schedule', value, ('longest', 'ordered'))
+        self._event_schedule = value
+
+    @event_min_queue_size.setter
+    def event_min_queue_size(self, value: int):
+        cv.check_type('event minimum queue size', value, Integral)
+        cv.check_greater_than('event minimum queue size', value, 0, True)
+        self._event_min_queue_size = value
+
+    @event_refill_threshold.setter
+    def event_refill_threshold(self, value: float):
+        cv.check_type('event refill threshold', value, Real)
+        cv.check_greater_than('event refill threshold', value, 0.0, True)
+        cv.check_less_than('event refill threshold', value, 1.0, True)
+        self._event_refill_threshold = value
+
+    @event_sort_threshold.setter
+    def event_sort_threshold(self, value: int):
+        cv.check_type('event sort threshold', value, Integral)
+        cv.check_greater_than('event sort threshold', value, 0, True)
+        self._event_sort_threshold = value
+
+    @history_schedule.setter
+    def history_schedule(self, value: str):
+        cv.check_value('history schedule', value, ('loop', 'work_stealing'))
+        self._history_schedule = value
+
+    @work_chunk_size.setter
+    def work_chunk_size(self, value: int):
+        cv.check_type('work chunk size', value, Integral)
+        cv.check_greater_than('work chunk size', value, 0, True)
+        self._work_chunk_size = value
+
+    @track_writer_thread.setter
+    def track_writer_thread(self, value: bool):
+        cv.check_type('track writer thread', value, bool)
+        self._track_writer_thread = value
+
+    @track_fraction.setter
+    def track_fraction(self, value: float):
+        cv.check_type('track fraction', value, Real)
+        cv.check_greater_than('track fraction', value, 0.0)
+        cv.check_less_than('track fraction', value, 1.0, True)
+        self._track_fraction = value
+
+    @track_region.setter
+    def track_region(self, value: typing.Iterable[typing.Iterable[float]]):
+        cv.check_length('track region', value, 2)
+        lower_left, upper_right = value
+        cv.check_type('track region lower-left', lower_left, Iterable, Real)
+        cv.check_length('track region lower-left', lower_left, 3)
+        cv.check_type('track region upper-right', upper_right, Iterable, Real)
+        cv.check_length('track region upper-right', upper_right, 3)
+        self._track_region = (tuple(lower_left), tuple(upper_right))
+
+    @track_compression.setter
+    def track_compression(self, value: int):
+        cv.check_type('track compression level', value, Integral)
+        cv.check_greater_than('track compression level', value, 0, True)
+        cv.check_less_than('track compression level', value, 9, True)
+        self._track_compression = value
+
+    @track_precision.setter
+    def track_precision(self, value: str):
+        cv.check_value('track precision', value, ('double', 'single'))
+        self._track_precision = value
+
+    @track_delta_positions.setter
+    def track_delta_positions(self, value: bool):
+        cv.check_type('track delta positions', value, bool)
+        self._track_delta_positions = value
+
+    @wielandt_shift.setter
+    def wielandt_shift(self, value: float):
+        cv.check_type('Wielandt shift', value, Real)
+        cv.check_greater_than('Wielandt shift', value, 0.0, True)
+        self._wielandt_shift = value
+
+    @ifp_n_generation.setter
+    def ifp_n_generation(self, value: int):
+        cv.check_type('IFP number of generations', value, Integral)
+        cv.check_greater_than('IFP number of generations', value, 0)
+        self._ifp_n_generation = value
+
     def _create_run_mode_subelement(self, root):
         elem = ET.SubElement(root, "run_mode")
         elem.text = self._run_mode.value
@@ -957,6 +1937,12 @@ class Settings:
         for source in self.source:
             root.append(source.to_xml_element())
 
+            # Add the mesh of a mesh spatial distribution if not already there
+            if isinstance(source.space, MeshSpatial):
+                path = f"./mesh[@id='{source.space.mesh.id}']"
+                if root.find(path) is None:
+                    root.append(source.space.mesh.to_xml_element())
+
     def _create_volume_calcs_subelement(self, root):
         for calc in self.volume_calculations:
             root.append(calc.to_xml_element())
@@ -966,10 +1952,10 @@ class Settings:
             element = ET.SubElement(root, "output")
             for key, value in sorted(self._output.items()):
                 subelement = ET.SubElement(element, key)
-                if key in ('summary', 'tallies'):
-                    subelement.text = str(value).lower()
-                else:
+                if key == 'path':
                     subelement.text = value
+                else:
+                    subelement.text = str(value).lower()
 
     def _create_verbosity_subelement(self, root):
         if self._verbosity is not None:
@@ -1023,6 +2009,9 @@ class Settings:
             if 'max_particles' in self._surf_source_write:
                 subelement = ET.SubElement(element, "max_particles")
                 subelement.text = str(self._surf_source_write['max_particles'])
+            if 'stream' in self._surf_source_write:
+                subelement = ET.SubElement(element, "stream")
+                subelement.text = str(self._surf_source_write['stream']).lower()
 
     def _create_confidence_intervals(self, root):
         if self._confidence_intervals is not None:
@@ -1034,6 +2023,16 @@ class Settings:
             element = ET.SubElement(root, "electron_treatment")
             element.text = str(self._electron_treatment)
 
+    def _create_electron_step_fraction_subelement(self, root):
+        if self._electron_step_fraction is not None:
+            element = ET.SubElement(root, "electron_step_fraction")
+            element.text = str(self._electron_step_fraction)
+
+    def _create_photon_scattering_tables_subelement(self, root):
+        if self._photon_scattering_tables is not None:
+            element = ET.SubElement(root, "photon_scattering_tables")
+            element.text = str(self._photon_scattering_tables).lower()
+
     def _create_photon_transport_subelement(self, root):
         if self._photon_transport is not None:
             element = ET.SubElement(root, "photon_transport")
@@ -1165,11 +2164,70 @@ class Settings:
             elem = ET.SubElement(root, "create_fission_neutrons")
             elem.text = str(self._create_fission_neutrons).lower()
 
+    def _create_crossing_recovery_subelement(self, root):
+        if self.crossing_recovery:
+            elem = ET.SubElement(root, 'crossing_recovery')
+            if 'enable' in self.crossing_recovery:
+                subelem = ET.SubElement(elem, 'enable')
+                subelem.text = str(self.crossing_recovery['enable']).lower()
+            if 'distance' in self.crossing_recovery:
+                subelem = ET.SubElement(elem, 'distance')
+                subelem.text = str(self.crossing_recovery['distance'])
+
     def _create_delayed_photon_scaling_subelement(self, root):
         if self._delayed_photon_scaling is not None:
             elem = ET.SubElement(root, "delayed_photon_scaling")
             elem.text = str(self._delayed_photon_scaling).lower()
 
+    def _create_delta_tracking_subelement(self, root):
+        delta = self.delta_tracking
+        if delta:
+            elem = ET.SubElement(root, 'delta_tracking')
+            if 'enable' in delta:
+                subelem = ET.SubElement(elem, 'enable')
+                subelem.text = str(delta['enable']).lower()
+            if 'universes' in delta:
+                subelem = ET.SubElement(elem, 'universes')
+                subelem.text = ' '.join(str(u) for u in delta['universes'])
+            if 'max_ratio' in delta:
+                subelem = ET.SubElement(elem, 'max_ratio')
+                subelem.text = str(delta['max_ratio'])
+
+    def _create_fission_matrix_subelement(self, root):
+        if self.fission_matrix:
+            elem = ET.SubElement(root, 'fission_matrix')
+            if 'enable' in self.fission_matrix:
+                subelem = ET.SubElement(elem, 'enable')
+                subelem.text = str(self.fission_matrix['enable']).lower()
+            if 'interval' in self.fission_matrix:
+                subelem = ET.SubElement(elem, 'interval')
+                subelem.text = str(self.fission_matrix['interval'])
+
+    def _create_overlap_checks_subelement(self, root):
+        if self.overlap_checks:
+            elem = ET.SubElement(root, 'overlap_checks')
+            for key in ('enable', 'fraction', 'crossings_only'):
+                if key in self.overlap_checks:
+                    subelem = ET.SubElement(elem, key)
+                    value = self.overlap_checks[key]
+                    if key == 'fraction':
+                        subelem.text = str(value)
+                    else:
+                        subelem.text = str(value).lower()
+
+    def _create_random_ray_subelement(self, root):
+        if self.random_ray:
+            elem = ET.SubElement(root, 'random_ray')
+            for key in ('distance_active', 'distance_inactive'):
+                if key in self.random_ray:
+                    subelem = ET.SubElement(elem, key)
+                    subelem.text = str(self.random_ray[key])
+            for key in ('lower_left', 'upper_right'):
+                if key in self.random_ray:
+                    subelem = ET.SubElement(elem, key)
+                    subelem.text = ' '.join(
+                        str(x) for x in self.random_ray[key])
+
     def _create_event_based_subelement(self, root):
         if self._event_based is not None:
             elem = ET.SubElement(root, "event_based")
@@ -1219,6 +2277,246 @@ class Settings:
             elem = ET.SubElement(root, "max_tracks")
             elem.text = str(self._max_tracks)
 
+    def _create_union_grid_subelement(self, root):
+        if self._union_grid is not None:
+            elem = ET.SubElement(root, "union_grid")
+            elem.text = str(self._union_grid).lower()
+
+    def _create_event_xs_batch_size_subelement(self, root):
+        if self._event_xs_batch_size is not None:
+            elem = ET.SubElement(root, "event_xs_batch_size")
+            elem.text = str(self._event_xs_batch_size)
+
+    def _create_hash_grid_points_per_bin_subelement(self, root):
+        if self._hash_grid_points_per_bin is not None:
+            elem = ET.SubElement(root, "hash_grid_points_per_bin")
+            elem.text = str(self._hash_grid_points_per_bin)
+
+    def _create_shared_cross_sections_subelement(self, root):
+        if self._shared_cross_sections is not None:
+            elem = ET.SubElement(root, "shared_cross_sections")
+            elem.text = str(self._shared_cross_sections).lower()
+
+    def _create_numa_first_touch_subelement(self, root):
+        if self._numa_first_touch is not None:
+            elem = ET.SubElement(root, "numa_first_touch")
+            elem.text = str(self._numa_first_touch).lower()
+
+    def _create_huge_pages_subelement(self, root):
+        if self._huge_pages is not None:
+            elem = ET.SubElement(root, "huge_pages")
+            elem.text = str(self._huge_pages).lower()
+
+    def _create_cross_sections_cache_subelement(self, root):
+        if self._cross_sections_cache is not None:
+            elem = ET.SubElement(root, "cross_sections_cache")
+            elem.text = str(self._cross_sections_cache)
+
+    def _create_census_times_subelement(self, root):
+        if self._census_times is not None:
+            elem = ET.SubElement(root, "census_times")
+            elem.text = ' '.join(str(t) for t in self._census_times)
+
+    def _create_compact_bank_subelement(self, root):
+        if self._compact_bank is not None:
+            elem = ET.SubElement(root, "compact_bank")
+            elem.text = str(self._compact_bank).lower()
+
+    def _create_compact_micro_xs_subelement(self, root):
+        if self._compact_micro_xs is not None:
+            elem = ET.SubElement(root, "compact_micro_xs")
+            elem.text = str(self._compact_micro_xs).lower()
+
+    def _create_xs_cdf_subelement(self, root):
+        if self._xs_cdf is not None:
+            elem = ET.SubElement(root, "xs_cdf")
+            elem.text = str(self._xs_cdf).lower()
+
+    def _create_condense_relaxation_subelement(self, root):
+        if self._condense_relaxation is not None:
+            elem = ET.SubElement(root, "condense_relaxation")
+            elem.text = str(self._condense_relaxation).lower()
+
+    def _create_pipelined_bank_subelement(self, root):
+        if self._pipelined_bank is not None:
+            elem = ET.SubElement(root, "pipelined_bank")
+            elem.text = str(self._pipelined_bank).lower()
+
+    def _create_precompute_neighbors_subelement(self, root):
+        if self._precompute_neighbors is not None:
+            elem = ET.SubElement(root, "precompute_neighbors")
+            elem.text = str(self._precompute_neighbors).lower()
+
+    def _create_profile_subelement(self, root):
+        if self._profile is not None:
+            elem = ET.SubElement(root, "profile")
+            elem.text = str(self._profile).lower()
+
+    def _create_profile_domains_subelement(self, root):
+        if self._profile_domains is not None:
+            elem = ET.SubElement(root, "profile_domains")
+            elem.text = str(self._profile_domains).lower()
+
+    def _create_lattice_dda_subelement(self, root):
+        if self._lattice_dda is not None:
+            elem = ET.SubElement(root, "lattice_dda")
+            elem.text = str(self._lattice_dda).lower()
+
+    def _create_tally_reduce_interval_subelement(self, root):
+        if self._tally_reduce_interval is not None:
+            elem = ET.SubElement(root, "tally_reduce_interval")
+            elem.text = str(self._tally_reduce_interval)
+
+    def _create_tally_rank_files_subelement(self, root):
+        if self._tally_rank_files is not None:
+            elem = ET.SubElement(root, "tally_rank_files")
+            elem.text = str(self._tally_rank_files).lower()
+
+    def _create_tally_stream_subelement(self, root):
+        if self._tally_stream:
+            element = ET.SubElement(root, "tally_stream")
+            if 'path' in self._tally_stream:
+                subelement = ET.SubElement(element, "path")
+                subelement.text = self._tally_stream['path']
+            if 'tallies' in self._tally_stream:
+                subelement = ET.SubElement(element, "tallies")
+                subelement.text = ' '.join(
+                    str(x) for x in self._tally_stream['tallies'])
+
+    def _create_io_stripe_size_subelement(self, root):
+        if self._io_stripe_size is not None:
+            elem = ET.SubElement(root, "io_stripe_size")
+            elem.text = str(self._io_stripe_size)
+
+    def _create_async_statepoint_subelement(self, root):
+        if self._async_statepoint is not None:
+            elem = ET.SubElement(root, "async_statepoint")
+            elem.text = str(self._async_statepoint).lower()
+
+    def _create_auto_tune_subelement(self, root):
+        if self._auto_tune is not None:
+            elem = ET.SubElement(root, "auto_tune")
+            elem.text = str(self._auto_tune).lower()
+
+    def _create_source_compression_subelement(self, root):
+        if self._source_compression is not None:
+            elem = ET.SubElement(root, "source_compression")
+            elem.text = str(self._source_compression)
+
+    def _create_source_precision_subelement(self, root):
+        if self._source_precision is not None:
+            elem = ET.SubElement(root, "source_precision")
+            elem.text = self._source_precision
+
+    def _create_partition_source_files_subelement(self, root):
+        if self._partition_source_files is not None:
+            elem = ET.SubElement(root, "partition_source_files")
+            elem.text = str(self._partition_source_files).lower()
+
+    def _create_mmap_source_files_subelement(self, root):
+        if self._mmap_source_files is not None:
+            elem = ET.SubElement(root, "mmap_source_files")
+            elem.text = str(self._mmap_source_files).lower()
+
+    def _create_mpi_progress_thread_subelement(self, root):
+        if self._mpi_progress_thread is not None:
+            elem = ET.SubElement(root, "mpi_progress_thread")
+            elem.text = str(self._mpi_progress_thread).lower()
+
+    def _create_weight_window_mesh_crossings_subelement(self, root):
+        if self._weight_window_mesh_crossings is not None:
+            elem = ET.SubElement(root, "weight_window_mesh_crossings")
+            elem.text = str(self._weight_window_mesh_crossings).lower()
+
+    def _create_weight_window_generators_subelement(self, root):
+        for wwg in self._weight_window_generators:
+            root.append(wwg.to_xml_element())
+
+            # See if a <mesh> element already exists -- if not, add it
+            path = f"./mesh[@id='{wwg.mesh.id}']"
+            if root.find(path) is None:
+                root.append(wwg.mesh.to_xml_element())
+
+    def _create_secondary_bank_capacity_subelement(self, root):
+        if self._secondary_bank_capacity is not None:
+            elem = ET.SubElement(root, "secondary_bank_capacity")
+            elem.text = str(self._secondary_bank_capacity)
+
+    def _create_event_secondary_queue_subelement(self, root):
+        if self._event_secondary_queue is not None:
+            elem = ET.SubElement(root, "event_secondary_queue")
+            elem.text = str(self._event_secondary_queue).lower()
+
+    def _create_event_schedule_subelement(self, root):
+        if self._event_schedule is not None:
+            elem = ET.SubElement(root, "event_schedule")
+            elem.text = self._event_schedule
+
+    def _create_event_min_queue_size_subelement(self, root):
+        if self._event_min_queue_size is not None:
+            elem = ET.SubElement(root, "event_min_queue_size")
+            elem.text = str(self._event_min_queue_size)
+
+    def _create_event_refill_threshold_subelement(self, root):
+        if self._event_refill_threshold is not None:
+            elem = ET.SubElement(root, "event_refill_threshold")
+            elem.text = str(self._event_refill_threshold)
+
+    def _create_event_sort_threshold_subelement(self, root):
+        if self._event_sort_threshold is not None:
+            elem = ET.SubElement(root, "event_sort_threshold")
+            elem.text = str(self._event_sort_threshold)
+
+    def _create_history_schedule_subelement(self, root):
+        if self._history_schedule is not None:
+            elem = ET.SubElement(root, "history_schedule")
+            elem.text = self._history_schedule
+
+    def _create_work_chunk_size_subelement(self, root):
+        if self._work_chunk_size is not None:
+            elem = ET.SubElement(root, "work_chunk_size")
+            elem.text = str(self._work_chunk_size)
+
+    def _create_track_writer_thread_subelement(self, root):
+        if self._track_writer_thread is not None:
+            elem = ET.SubElement(root, "track_writer_thread")
+            elem.text = str(self._track_writer_thread).lower()
+
+    def _create_track_fraction_subelement(self, root):
+        if self._track_fraction is not None:
+            elem = ET.SubElement(root, "track_fraction")
+            elem.text = str(self._track_fraction)
+
+    def _create_track_region_subelement(self, root):
+        if self._track_region is not None:
+            elem = ET.SubElement(root, "track_region")
+            elem.text = ' '.join(map(str, itertools.chain(*self._track_region)))
+
+    def _create_track_compression_subelement(self, root):
+        if self._track_compression is not None:
+            elem = ET.SubElement(root, "track_compression")
+            elem.text = str(self._track_compression)
+
+    def _create_track_precision_subelement(self, root):
+        if self._track_precision is not None:
+            elem = ET.SubElement(root, "track_precision")
+            elem.text = self._track_precision
+
+    def _create_track_delta_positions_subelement(self, root):
+        if self._track_delta_positions is not None:
+            elem = ET.SubElement(root, "track_delta_positions")
+            elem.text = str(self._track_delta_positions).lower()
+
+    def _create_wielandt_shift_subelement(self, root):
+        if self._wielandt_shift is not None:
+            elem = ET.SubElement(root, "wielandt_shift")
+            elem.text = str(self._wielandt_shift)
+
+    def _create_ifp_n_generation_subelement(self, root):
+        if self._ifp_n_generation is not None:
+            elem = ET.SubElement(root, "ifp_n_generation")
+            elem.text = str(self._ifp_n_generation)
+
     def _eigenvalue_from_xml_element(self, root):
         elem = root.find('eigenvalue')
         if elem is not None:
@@ -1273,8 +2571,15 @@ class Settings:
             self.keff_trigger = {'type': trigger, 'threshold': threshold}
 
     def _source_from_xml_element(self, root):
+        # Read the meshes of mesh spatial distributions
+        meshes = {}
+        for elem in root.findall("source/space[@type='mesh']"):
+            mesh_id = int(get_text(elem, 'mesh_id'))
+            mesh_elem = root.find(f"./mesh[@id='{mesh_id}']")
+            if mesh_id not in meshes and mesh_elem is not None:
+                meshes[mesh_id] = MeshBase.from_xml_element(mesh_elem)
         for elem in root.findall('source'):
-            self.source.append(Source.from_xml_element(elem))
+            self.source.append(Source.from_xml_element(elem, meshes))
 
     def _volume_calcs_from_xml_element(self, root):
         volume_elems = root.findall("volume_calc")
@@ -1286,10 +2591,13 @@ class Settings:
         elem = root.find('output')
         if elem is not None:
             self.output = {}
-            for key in ('summary', 'tallies', 'path'):
+            for key in ('summary', 'summary_compact', 'summary_reuse',
+                        'tallies', 'tallies_max_bins', 'path'):
                 value = get_text(elem, key)
                 if value is not None:
-                    if key in ('summary', 'tallies'):
+                    if key == 'tallies_max_bins':
+                        value = int(value)
+                    elif key != 'path':
                         value = value in ('true', '1')
                     self.output[key] = value
 
@@ -1325,13 +2633,15 @@ class Settings:
     def _surf_source_write_from_xml_element(self, root):
         elem = root.find('surf_source_write')
         if elem is not None:
-            for key in ('surface_ids', 'max_particles'):
+            for key in ('surface_ids', 'max_particles', 'stream'):
                 value = get_text(elem, key)
                 if value is not None:
                     if key == 'surface_ids':
                         value = [int(x) for x in value.split()]
                     elif key in ('max_particles'):
                         value = int(value)
+                    elif key == 'stream':
+                        value = value in ('true', '1')
                     self.surf_source_write[key] = value
 
     def _confidence_intervals_from_xml_element(self, root):
@@ -1344,6 +2654,11 @@ class Settings:
         if text is not None:
             self.electron_treatment = text
 
+    def _electron_step_fraction_from_xml_element(self, root):
+        text = get_text(root, 'electron_step_fraction')
+        if text is not None:
+            self.electron_step_fraction = float(text)
+
     def _energy_mode_from_xml_element(self, root):
         text = get_text(root, 'energy_mode')
         if text is not None:
@@ -1354,6 +2669,11 @@ class Settings:
         if text is not None:
             self.max_order = int(text)
 
+    def _photon_scattering_tables_from_xml_element(self, root):
+        text = get_text(root, 'photon_scattering_tables')
+        if text is not None:
+            self.photon_scattering_tables = text in ('true', '1')
+
     def _photon_transport_from_xml_element(self, root):
         text = get_text(root, 'photon_transport')
         if text is not None:
@@ -1438,6 +2758,12 @@ class Settings:
         text = get_text(root, 'temperature_multipole')
         if text is not None:
             self.temperature['multipole'] = text in ('true', '1')
+        text = get_text(root, 'temperature_multipole_quadrature')
+        if text is not None:
+            self.temperature['multipole_quadrature'] = text in ('true', '1')
+        text = get_text(root, 'temperature_lazy')
+        if text is not None:
+            self.temperature['lazy'] = text in ('true', '1')
 
     def _trace_from_xml_element(self, root):
         text = get_text(root, 'trace')
@@ -1478,11 +2804,68 @@ class Settings:
         if text is not None:
             self.create_fission_neutrons = text in ('true', '1')
 
+    def _crossing_recovery_from_xml_element(self, root):
+        elem = root.find('crossing_recovery')
+        if elem is not None:
+            value = get_text(elem, 'enable')
+            if value is not None:
+                self.crossing_recovery['enable'] = value in ('true', '1')
+            value = get_text(elem, 'distance')
+            if value is not None:
+                self.crossing_recovery['distance'] = float(value)
+
     def _delayed_photon_scaling_from_xml_element(self, root):
         text = get_text(root, 'delayed_photon_scaling')
         if text is not None:
             self.delayed_photon_scaling = text in ('true', '1')
 
+    def _delta_tracking_from_xml_element(self, root):
+        elem = root.find('delta_tracking')
+        if elem is not None:
+            for key in ('enable', 'universes', 'max_ratio'):
+                value = get_text(elem, key)
+                if value is not None:
+                    if key == 'enable':
+                        value = value in ('true', '1')
+                    elif key == 'universes':
+                        value = [int(x) for x in value.split()]
+                    elif key == 'max_ratio':
+                        value = float(value)
+                    self.delta_tracking[key] = value
+
+    def _fission_matrix_from_xml_element(self, root):
+        elem = root.find('fission_matrix')
+        if elem is not None:
+            value = get_text(elem, 'enable')
+            if value is not None:
+                self.fission_matrix['enable'] = value in ('true', '1')
+            value = get_text(elem, 'interval')
+            if value is not None:
+                self.fission_matrix['interval'] = int(value)
+
+    def _overlap_checks_from_xml_element(self, root):
+        elem = root.find('overlap_checks')
+        if elem is not None:
+            for key in ('enable', 'fraction', 'crossings_only'):
+                value = get_text(elem, key)
+                if value is not None:
+                    if key == 'fraction':
+                        self.overlap_checks[key] = float(value)
+                    else:
+                        self.overlap_checks[key] = value in ('true', '1')
+
+    def _random_ray_from_xml_element(self, root):
+        elem = root.find('random_ray')
+        if elem is not None:
+            for key in ('distance_active', 'distance_inactive'):
+                value = get_text(elem, key)
+                if value is not None:
+                    self.random_ray[key] = float(value)
+            for key in ('lower_left', 'upper_right'):
+                value = get_text(elem, key)
+                if value is not None:
+                    self.random_ray[key] = [float(x) for x in value.split()]
+
     def _event_based_from_xml_element(self, root):
         text = get_text(root, 'event_based')
         if text is not None:
@@ -1527,6 +2910,242 @@ class Settings:
         if text is not None:
             self.max_tracks = int(text)
 
+    def _union_grid_from_xml_element(self, root):
+        text = get_text(root, 'union_grid')
+        if text is not None:
+            self.union_grid = text in ('true', '1')
+
+    def _event_xs_batch_size_from_xml_element(self, root):
+        text = get_text(root, 'event_xs_batch_size')
+        if text is not None:
+            self.event_xs_batch_size = int(text)
+
+    def _hash_grid_points_per_bin_from_xml_element(self, root):
+        text = get_text(root, 'hash_grid_points_per_bin')
+        if text is not None:
+            self.hash_grid_points_per_bin = int(text)
+
+    def _shared_cross_sections_from_xml_element(self, root):
+        text = get_text(root, 'shared_cross_sections')
+        if text is not None:
+            self.shared_cross_sections = text in ('true', '1')
+
+    def _numa_first_touch_from_xml_element(self, root):
+        text = get_text(root, 'numa_first_touch')
+        if text is not None:
+            self.numa_first_touch = text in ('true', '1')
+
+    def _huge_pages_from_xml_element(self, root):
+        text = get_text(root, 'huge_pages')
+        if text is not None:
+            self.huge_pages = text in ('true', '1')
+
+    def _cross_sections_cache_from_xml_element(self, root):
+        text = get_text(root, 'cross_sections_cache')
+        if text is not None:
+            self.cross_sections_cache = text
+
+    def _census_times_from_xml_element(self, root):
+        text = get_text(root, 'census_times')
+        if text is not None:
+            self.census_times = [float(x) for x in text.split()]
+
+    def _compact_bank_from_xml_element(self, root):
+        text = get_text(root, 'compact_bank')
+        if text is not None:
+            self.compact_bank = text in ('true', '1')
+
+    def _compact_micro_xs_from_xml_element(self, root):
+        text = get_text(root, 'compact_micro_xs')
+        if text is not None:
+            self.compact_micro_xs = text in ('true', '1')
+
+    def _xs_cdf_from_xml_element(self, root):
+        text = get_text(root, 'xs_cdf')
+        if text is not None:
+            self.xs_cdf = text in ('true', '1')
+
+    def _condense_relaxation_from_xml_element(self, root):
+        text = get_text(root, 'condense_relaxation')
+        if text is not None:
+            self.condense_relaxation = text in ('true', '1')
+
+    def _pipelined_bank_from_xml_element(self, root):
+        text = get_text(root, 'pipelined_bank')
+        if text is not None:
+            self.pipelined_bank = text in ('true', '1')
+
+    def _precompute_neighbors_from_xml_element(self, root):
+        text = get_text(root, 'precompute_neighbors')
+        if text is not None:
+            self.precompute_neighbors = text in ('true', '1')
+
+    def _profile_from_xml_element(self, root):
+        text = get_text(root, 'profile')
+        if text is not None:
+            self.profile = text in ('true', '1')
+
+    def _profile_domains_from_xml_element(self, root):
+        text = get_text(root, 'profile_domains')
+        if text is not None:
+            self.profile_domains = text in ('true', '1')
+
+    def _lattice_dda_from_xml_element(self, root):
+        text = get_text(root, 'lattice_dda')
+        if text is not None:
+            self.lattice_dda = text in ('true', '1')
+
+    def _tally_reduce_interval_from_xml_element(self, root):
+        text = get_text(root, 'tally_reduce_interval')
+        if text is not None:
+            self.tally_reduce_interval = int(text)
+
+    def _tally_rank_files_from_xml_element(self, root):
+        text = get_text(root, 'tally_rank_files')
+        if text is not None:
+            self.tally_rank_files = text in ('true', '1')
+
+    def _tally_stream_from_xml_element(self, root):
+        elem = root.find('tally_stream')
+        if elem is not None:
+            value = get_text(elem, 'path')
+            if value is not None:
+                self.tally_stream['path'] = value
+            value = get_text(elem, 'tallies')
+            if value is not None:
+                self.tally_stream['tallies'] = [int(x) for x in value.split()]
+
+    def _io_stripe_size_from_xml_element(self, root):
+        text = get_text(root, 'io_stripe_size')
+        if text is not None:
+            self.io_stripe_size = int(text)
+
+    def _async_statepoint_from_xml_element(self, root):
+        text = get_text(root, 'async_statepoint')
+        if text is not None:
+            self.async_statepoint = text in ('true', '1')
+
+    def _auto_tune_from_xml_element(self, root):
+        text = get_text(root, 'auto_tune')
+        if text is not None:
+            self.auto_tune = text in ('true', '1')
+
+    def _source_compression_from_xml_element(self, root):
+        text = get_text(root, 'source_compression')
+        if text is not None:
+            self.source_compression = int(text)
+
+    def _source_precision_from_xml_element(self, root):
+        text = get_text(root, 'source_precision')
+        if text is not None:
+            self.source_precision = text
+
+    def _partition_source_files_from_xml_element(self, root):
+        text = get_text(root, 'partition_source_files')
+        if text is not None:
+            self.partition_source_files = text in ('true', '1')
+
+    def _mmap_source_files_from_xml_element(self, root):
+        text = get_text(root, 'mmap_source_files')
+        if text is not None:
+            self.mmap_source_files = text in ('true', '1')
+
+    def _mpi_progress_thread_from_xml_element(self, root):
+        text = get_text(root, 'mpi_progress_thread')
+        if text is not None:
+            self.mpi_progress_thread = text in ('true', '1')
+
+    def _weight_window_mesh_crossings_from_xml_element(self, root):
+        text = get_text(root, 'weight_window_mesh_crossings')
+        if text is not None:
+            self.weight_window_mesh_crossings = text in ('true', '1')
+
+    def _weight_window_generators_from_xml_element(self, root):
+        for elem in root.findall('weight_window_generator'):
+            wwg = WeightWindowGenerator.from_xml_element(elem, root)
+            self.weight_window_generators.append(wwg)
+
+    def _secondary_bank_capacity_from_xml_element(self, root):
+        text = get_text(root, 'secondary_bank_capacity')
+        if text is not None:
+            self.secondary_bank_capacity = int(text)
+
+    def _event_secondary_queue_from_xml_element(self, root):
+        text = get_text(root, 'event_secondary_queue')
+        if text is not None:
+            self.event_secondary_queue = text in ('true', '1')
+
+    def _event_schedule_from_xml_element(self, root):
+        text = get_text(root, 'event_schedule')
+        if text is not None:
+            self.event_schedule = text
+
+    def _event_min_queue_size_from_xml_element(self, root):
+        text = get_text(root, 'event_min_queue_size')
+        if text is not None:
+            self.event_min_queue_size = int(text)
+
+    def _event_refill_threshold_from_xml_element(self, root):
+        text = get_text(root, 'event_refill_threshold')
+        if text is not None:
+            self.event_refill_threshold = float(text)
+
+    def _event_sort_threshold_from_xml_element(self, root):
+        text = get_text(root, 'event_sort_threshold')
+        if text is not None:
+            self.event_sort_threshold = int(text)
+
+    def _history_schedule_from_xml_element(self, root):
+        text = get_text(root, 'history_schedule')
+        if text is not None:
+            self.history_schedule = text
+
+    def _work_chunk_size_from_xml_element(self, root):
+        text = get_text(root, 'work_chunk_size')
+        if text is not None:
+            self.work_chunk_size = int(text)
+
+    def _track_writer_thread_from_xml_element(self, root):
+        text = get_text(root, 'track_writer_thread')
+        if text is not None:
+            self.track_writer_thread = text in ('true', '1')
+
+    def _track_fraction_from_xml_element(self, root):
+        text = get_text(root, 'track_fraction')
+        if text is not None:
+            self.track_fraction = float(text)
+
+    def _track_region_from_xml_element(self, root):
+        text = get_text(root, 'track_region')
+        if text is not None:
+            values = [float(x) for x in text.split()]
+            self.track_region = (values[:3], values[3:])
+
+    def _track_compression_from_xml_element(self, root):
+        text = get_text(root, 'track_compression')
+        if text is not None:
+            self.track_compression = int(text)
+
+    def _track_precision_from_xml_element(self, root):
+        text = get_text(root, 'track_precision')
+        if text is not None:
+            self.track_precision = text
+
+    def _track_delta_positions_from_xml_element(self, root):
+        text = get_text(root, 'track_delta_positions')
+        if text is not None:
+            self.track_delta_positions = text in ('true', '1')
+
+    def _wielandt_shift_from_xml_element(self, root):
+        text = get_text(root, 'wielandt_shift')
+        if text is not None:
+            self.wielandt_shift = float(text)
+
+    def _ifp_n_generation_from_xml_element(self, root):
+        text = get_text(root, 'ifp_n_generation')
+        if text is not None:
+            self.ifp_n_generation = int(text)
+
     def export_to_xml(self, path: Union[str, os.PathLike] = 'settings.xml'):
         """Export simulation settings to an XML file.
 
@@ -1556,8 +3175,10 @@ class Settings:
         self._create_surf_source_write_subelement(root_element)
         self._create_confidence_intervals(root_element)
         self._create_electron_treatment_subelement(root_element)
+        self._create_electron_step_fraction_subelement(root_element)
         self._create_energy_mode_subelement(root_element)
         self._create_max_order_subelement(root_element)
+        self._create_photon_scattering_tables_subelement(root_element)
         self._create_photon_transport_subelement(root_element)
         self._create_ptables_subelement(root_element)
         self._create_seed_subelement(root_element)
@@ -1575,7 +3196,12 @@ class Settings:
         self._create_resonance_scattering_subelement(root_element)
         self._create_volume_calcs_subelement(root_element)
         self._create_create_fission_neutrons_subelement(root_element)
+        self._create_crossing_recovery_subelement(root_element)
         self._create_delayed_photon_scaling_subelement(root_element)
+        self._create_delta_tracking_subelement(root_element)
+        self._create_fission_matrix_subelement(root_element)
+        self._create_overlap_checks_subelement(root_element)
+        self._create_random_ray_subelement(root_element)
         self._create_event_based_subelement(root_element)
         self._create_max_particles_in_flight_subelement(root_element)
         self._create_material_cell_offsets_subelement(root_element)
@@ -1584,6 +3210,52 @@ class Settings:
         self._create_weight_windows_subelement(root_element)
         self._create_max_splits_subelement(root_element)
         self._create_max_tracks_subelement(root_element)
+        self._create_union_grid_subelement(root_element)
+        self._create_event_xs_batch_size_subelement(root_element)
+        self._create_hash_grid_points_per_bin_subelement(root_element)
+        self._create_shared_cross_sections_subelement(root_element)
+        self._create_numa_first_touch_subelement(root_element)
+        self._create_huge_pages_subelement(root_element)
+        self._create_cross_sections_cache_subelement(root_element)
+        self._create_census_times_subelement(root_element)
+        self._create_compact_bank_subelement(root_element)
+        self._create_compact_micro_xs_subelement(root_element)
+        self._create_xs_cdf_subelement(root_element)
+        self._create_condense_relaxation_subelement(root_element)
+        self._create_pipelined_bank_subelement(root_element)
+        self._create_precompute_neighbors_subelement(root_element)
+        self._create_profile_subelement(root_element)
+        self._create_profile_domains_subelement(root_element)
+        self._create_lattice_dda_subelement(root_element)
+        self._create_tally_reduce_interval_subelement(root_element)
+        self._create_tally_rank_files_subelement(root_element)
+        self._create_tally_stream_subelement(root_element)
+        self._create_io_stripe_size_subelement(root_element)
+        self._create_async_statepoint_subelement(root_element)
+        self._create_auto_tune_subelement(root_element)
+        self._create_source_compression_subelement(root_element)
+        self._create_source_precision_subelement(root_element)
+        self._create_partition_source_files_subelement(root_element)
+        self._create_mmap_source_files_subelement(root_element)
+        self._create_mpi_progress_thread_subelement(root_element)
+        self._create_weight_window_mesh_crossings_subelement(root_element)
+        self._create_weight_window_generators_subelement(root_element)
+        self._create_secondary_bank_capacity_subelement(root_element)
+        self._create_event_secondary_queue_subelement(root_element)
+        self._create_event_schedule_subelement(root_element)
+        self._create_event_min_queue_size_subelement(root_element)
+        self._create_event_refill_threshold_subelement(root_element)
+        self._create_event_sort_threshold_subelement(root_element)
+        self._create_history_schedule_subelement(root_element)
+        self._create_work_chunk_size_subelement(root_element)
+        self._create_track_writer_thread_subelement(root_element)
+        self._create_track_fraction_subelement(root_element)
+        self._create_track_region_subelement(root_element)
+        self._create_track_compression_subelement(root_element)
+        self._create_track_precision_subelement(root_element)
+        self._create_track_delta_positions_subelement(root_element)
+        self._create_wielandt_shift_subelement(root_element)
+        self._create_ifp_n_generation_subelement(root_element)
 
         # Clean the indentation in the file to be user-readable
         clean_indentation(root_element)
@@ -1637,8 +3309,10 @@ class Settings:
         settings._surf_source_write_from_xml_element(root)
         settings._confidence_intervals_from_xml_element(root)
         settings._electron_treatment_from_xml_element(root)
+        settings._electron_step_fraction_from_xml_element(root)
         settings._energy_mode_from_xml_element(root)
         settings._max_order_from_xml_element(root)
+        settings._photon_scattering_tables_from_xml_element(root)
         settings._photon_transport_from_xml_element(root)
         settings._ptables_from_xml_element(root)
         settings._seed_from_xml_element(root)
@@ -1655,7 +3329,12 @@ class Settings:
         settings._ufs_mesh_from_xml_element(root)
         settings._resonance_scattering_from_xml_element(root)
         settings._create_fission_neutrons_from_xml_element(root)
+        settings._crossing_recovery_from_xml_element(root)
         settings._delayed_photon_scaling_from_xml_element(root)
+        settings._delta_tracking_from_xml_element(root)
+        settings._fission_matrix_from_xml_element(root)
+        settings._overlap_checks_from_xml_element(root)
+        settings._random_ray_from_xml_element(root)
         settings._event_based_from_xml_element(root)
         settings._max_particles_in_flight_from_xml_element(root)
         settings._material_cell_offsets_from_xml_element(root)
@@ -1664,6 +3343,52 @@ class Settings:
         settings._weight_windows_from_xml_element(root)
         settings._max_splits_from_xml_element(root)
         settings._max_tracks_from_xml_element(root)
+        settings._union_grid_from_xml_element(root)
+        settings._event_xs_batch_size_from_xml_element(root)
+        settings._hash_grid_points_per_bin_from_xml_element(root)
+        settings._shared_cross_sections_from_xml_element(root)
+        settings._numa_first_touch_from_xml_element(root)
+        settings._huge_pages_from_xml_element(root)
+        settings._cross_sections_cache_from_xml_element(root)
+        settings._census_times_from_xml_element(root)
+        settings._compact_bank_from_xml_element(root)
+        settings._compact_micro_xs_from_xml_element(root)
+        settings._xs_cdf_from_xml_element(root)
+        settings._condense_relaxation_from_xml_element(root)
+        settings._pipelined_bank_from_xml_element(root)
+        settings._precompute_neighbors_from_xml_element(root)
+        settings._profile_from_xml_element(root)
+        settings._profile_domains_from_xml_element(root)
+        settings._lattice_dda_from_xml_element(root)
+        settings._tally_reduce_interval_from_xml_element(root)
+        settings._tally_rank_files_from_xml_element(root)
+        settings._tally_stream_from_xml_element(root)
+        settings._io_stripe_size_from_xml_element(root)
+        settings._async_statepoint_from_xml_element(root)
+        settings._auto_tune_from_xml_element(root)
+        settings._source_compression_from_xml_element(root)
+        settings._source_precision_from_xml_element(root)
+        settings._partition_source_files_from_xml_element(root)
+        settings._mmap_source_files_from_xml_element(root)
+        settings._mpi_progress_thread_from_xml_element(root)
+        settings._weight_window_mesh_crossings_from_xml_element(root)
+        settings._weight_window_generators_from_xml_element(root)
+        settings._secondary_bank_capacity_from_xml_element(root)
+        settings._event_secondary_queue_from_xml_element(root)
+        settings._event_schedule_from_xml_element(root)
+        settings._event_min_queue_size_from_xml_element(root)
+        settings._event_refill_threshold_from_xml_element(root)
+        settings._event_sort_threshold_from_xml_element(root)
+        settings._history_schedule_from_xml_element(root)
+        settings._work_chunk_size_from_xml_element(root)
+        settings._track_writer_thread_from_xml_element(root)
+        settings._track_fraction_from_xml_element(root)
+        settings._track_region_from_xml_element(root)
+        settings._track_compression_from_xml_element(root)
+        settings._track_precision_from_xml_element(root)
+        settings._track_delta_positions_from_xml_element(root)
+        settings._wielandt_shift_from_xml_element(root)
+        settings._ifp_n_generation_from_xml_element(root)
 
         # TODO: Get volume calculations
 
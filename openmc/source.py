@@ -199,13 +199,16 @@ class Source:
         return element
 
     @classmethod
-    def from_xml_element(cls, elem):
+    def from_xml_element(cls, elem, meshes=None):
         """Generate source from an XML element
 
         Parameters
         ----------
         elem : xml.etree.ElementTree.Element
             XML element
+        meshes : dict, optional
+            Dictionary mapping IDs to :class:`openmc.MeshBase` instances, used
+            by a mesh spatial distribution
 
         Returns
         -------
@@ -237,7 +240,7 @@ class Source:
 
         space = elem.find('space')
         if space is not None:
-            source.space = Spatial.from_xml_element(space)
+            source.space = Spatial.from_xml_element(space, meshes)
 
         angle = elem.find('angle')
         if angle is not None:
@@ -56,6 +56,17 @@ class StatePoint:
     filters : dict
         Dictionary whose keys are filter IDs and whose values are Filter
         objects
+    fission_matrix : numpy.ndarray or None
+        Fission sites born in each entropy mesh bin per unit source weight in
+        each bin, indexed by [born, source]. The ratio of its second largest to
+        largest eigenvalue estimates the dominance ratio.
+
+        .. versionadded:: 0.13.1
+    fission_matrix_source : numpy.ndarray or None
+        Source weight in each entropy mesh bin over the generations in which
+        the fission matrix was tallied
+
+        .. versionadded:: 0.13.1
     generations_per_batch : int
         Number of fission generations per batch
     global_tallies : numpy.ndarray of compound datatype
@@ -91,6 +102,13 @@ class StatePoint:
         Working directory for simulation
     photon_transport : bool
         Indicate whether photon transport is active
+    profile : dict or None
+        Dictionary whose keys are the names of profiled regions of transport
+        and whose values are dictionaries with the number of 'calls' and the
+        'total' and 'self' time in seconds, summed over threads and processes.
+        When profiling by domain, the 'materials', 'cells', and 'tallies' keys
+        give dictionaries of arrays of 'ids', 'calls', and 'time'. None if
+        profiling was not enabled.
     run_mode : str
         Simulation run mode, e.g. 'eigenvalue'
     runtime : dict
@@ -223,6 +241,20 @@ class StatePoint:
 
         return self._filters
 
+    @property
+    def fission_matrix(self):
+        if 'fission_matrix' in self._f:
+            return self._f['fission_matrix'][()]
+        else:
+            return None
+
+    @property
+    def fission_matrix_source(self):
+        if 'fission_matrix_source' in self._f:
+            return self._f['fission_matrix_source'][()]
+        else:
+            return None
+
     @property
     def generations_per_batch(self):
         if self.run_mode == 'eigenvalue':
@@ -342,6 +374,13 @@ class StatePoint:
     def photon_transport(self):
         return self._f.attrs['photon_transport'] > 0
 
+    @property
+    def profile(self):
+        if 'profile' not in self._f:
+            return None
+        return {name: {key: dset[()] for key, dset in group.items()}
+                for name, group in self._f['profile'].items()}
+
     @property
     def run_mode(self):
         return self._f['run_mode'][()].decode()
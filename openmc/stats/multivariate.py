@@ -8,6 +8,7 @@ import numpy as np
 
 import openmc.checkvalue as cv
 from .._xml import get_text
+from ..mesh import MeshBase
 from .univariate import Univariate, Uniform, PowerLaw
 
 
@@ -261,7 +262,7 @@ class Spatial(ABC):
 
     @classmethod
     @abstractmethod
-    def from_xml_element(cls, elem):
+    def from_xml_element(cls, elem, meshes=None):
         distribution = get_text(elem, 'type')
         if distribution == 'cartesian':
             return CartesianIndependent.from_xml_element(elem)
@@ -273,6 +274,8 @@ class Spatial(ABC):
             return Box.from_xml_element(elem)
         elif distribution == 'point':
             return Point.from_xml_element(elem)
+        elif distribution == 'mesh':
+            return MeshSpatial.from_xml_element(elem, meshes)
 
 
 class CartesianIndependent(Spatial):
@@ -779,6 +782,114 @@ class Point(Spatial):
         return cls(xyz)
 
 
+class MeshSpatial(Spatial):
+    """Distribution over the elements of a mesh.
+
+    A mesh element is sampled with a probability proportional to its strength
+    and coordinates are sampled uniformly within the element.
+
+    .. versionadded:: 0.13.1
+
+    Parameters
+    ----------
+    mesh : openmc.MeshBase
+        Mesh whose elements are sampled. Regular meshes must be
+        three-dimensional, and unstructured meshes are not supported.
+    strengths : Iterable of float
+        Relative strength of each mesh element
+    energy : Iterable of openmc.stats.Univariate, optional
+        Energy distribution of source sites in each mesh element. If not
+        given, the energy distribution of the source is used.
+
+    Attributes
+    ----------
+    mesh : openmc.MeshBase
+        Mesh whose elements are sampled
+    strengths : numpy.ndarray
+        Relative strength of each mesh element
+    energy : list of openmc.stats.Univariate or None
+        Energy distribution of source sites in each mesh element
+
+    """
+
+    def __init__(self, mesh, strengths, energy=None):
+        self.mesh = mesh
+        self.strengths = strengths
+        self.energy = energy
+
+    @property
+    def mesh(self):
+        return self._mesh
+
+    @property
+    def strengths(self):
+        return self._strengths
+
+    @property
+    def energy(self):
+        return self._energy
+
+    @mesh.setter
+    def mesh(self, mesh):
+        cv.check_type('mesh', mesh, MeshBase)
+        self._mesh = mesh
+
+    @strengths.setter
+    def strengths(self, strengths):
+        cv.check_type('mesh strengths', strengths, Iterable, Real)
+        self._strengths = np.asarray(strengths, dtype=float).ravel()
+
+    @energy.setter
+    def energy(self, energy):
+        if energy is not None:
+            cv.check_type('mesh energy distributions', energy, Iterable,
+                          Univariate)
+            energy = list(energy)
+        self._energy = energy
+
+    def to_xml_element(self):
+        """Return XML representation of the mesh distribution
+
+        Returns
+        -------
+        element : xml.etree.ElementTree.Element
+            XML element containing mesh distribution data
+
+        """
+        element = ET.Element('space')
+        element.set('type', 'mesh')
+        element.set('mesh_id', str(self.mesh.id))
+        strengths = ET.SubElement(element, 'strengths')
+        strengths.text = ' '.join(map(str, self.strengths))
+        if self.energy is not None:
+            for dist in self.energy:
+                element.append(dist.to_xml_element('energy'))
+        return element
+
+    @classmethod
+    def from_xml_element(cls, elem, meshes):
+        """Generate mesh distribution from an XML element
+
+        Parameters
+        ----------
+        elem : xml.etree.ElementTree.Element
+            XML element
+        meshes : dict
+            Dictionary mapping IDs to :class:`openmc.MeshBase` instances
+
+        Returns
+        -------
+        openmc.stats.MeshSpatial
+            Mesh distribution generated from XML element
+
+        """
+        mesh = meshes[int(get_text(elem, 'mesh_id'))]
+        strengths = [float(x) for x in get_text(elem, 'strengths').split()]
+        energy = [Univariate.from_xml_element(e)
+                  for e in elem.findall('energy')]
+        return cls(mesh, strengths, energy if energy else None)
+
+
 def spherical_uniform(r_outer, r_inner=0.0, thetas=(0., pi), phis=(0., 2*pi),
                       origin=(0., 0., 0.)):
     """Return a uniform spatial distribution over a spherical shell.
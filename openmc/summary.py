@@ -128,6 +128,8 @@ class Summary:
                 self._fast_surfaces[surface.id] = surface
 
     def _read_cells(self):
+        if 'id' in self._f['geometry/cells']:
+            return self._read_cells_compact()
 
         # Initialize dictionary for each Cell's fill
         cell_fills = {}
@@ -176,7 +178,60 @@ class Summary:
 
         return cell_fills
 
+    def _read_cells_compact(self):
+        group = self._f['geometry/cells']
+        ids = group['id'][()]
+        names = group['name'][()]
+        fill_types = group['fill_type'][()]
+        fills = group['fill'][()]
+        regions = group['region'][()]
+        materials = group['material'][()]
+        material_offset = group['material_offset'][()]
+        temperatures = group['temperature'][()]
+        temperature_offset = group['temperature_offset'][()]
+        translations = dict(zip(group['translation_index'][()],
+                                group['translation'][()]))
+        rotations = dict(zip(group['rotation_index'][()],
+                             group['rotation'][()]))
+
+        cell_fills = {}
+        for i, cell_id in enumerate(ids):
+            cell = openmc.Cell(cell_id=int(cell_id), name=names[i].decode())
+            fill_type = fill_types[i].decode()
+
+            if fill_type == 'material':
+                mats = materials[material_offset[i]:material_offset[i + 1]]
+                fill_id = mats[0] if mats.size == 1 else mats
+                cell.temperature = temperatures[
+                    temperature_offset[i]:temperature_offset[i + 1]]
+            else:
+                fill_id = fills[i]
+                if i in translations:
+                    cell.translation = translations[i]
+                if i in rotations:
+                    cell.rotation = rotations[i].reshape(3, 3)
+            cell_fills[cell.id] = (fill_type, fill_id)
+
+            region = regions[i].decode()
+            if region:
+                cell.region = Region.from_expression(region, self._fast_surfaces)
+
+            self._fast_cells[cell.id] = cell
+
+        return cell_fills
+
     def _read_universes(self):
+        group = self._f['geometry/universes']
+        if 'id' in group:
+            offsets = group['cell_offset'][()]
+            cell_ids = group['cells'][()]
+            for i, universe_id in enumerate(group['id'][()]):
+                universe = openmc.Universe(int(universe_id))
+                for cell_id in cell_ids[offsets[i]:offsets[i + 1]]:
+                    universe.add_cell(self._fast_cells[cell_id])
+                self._fast_universes[universe.id] = universe
+            return
+
         for group in self._f['geometry/universes'].values():
             geom_type = group.get('geom_type')
             if geom_type and geom_type[()].decode() == 'dagmc':
@@ -95,6 +95,18 @@ class Tally(IDManagerMixin):
         compressed data storage
     derivative : openmc.TallyDerivative
         A material perturbation derivative to apply to all scores in the tally.
+    thread_buffers : bool
+        Whether scores are accumulated in a private buffer for each thread
+        rather than with atomic updates
+
+        .. versionadded:: 0.13.1
+    sparse_results : bool
+        Whether results are stored in blocks of filter bins that are only
+        allocated once they are scored during the simulation. This is
+        independent of :attr:`Tally.sparse`, which controls the storage of
+        results loaded in Python.
+
+        .. versionadded:: 0.13.1
 
     """
 
@@ -111,6 +123,8 @@ class Tally(IDManagerMixin):
         self._estimator = None
         self._triggers = cv.CheckedList(openmc.Trigger, 'tally triggers')
         self._derivative = None
+        self._thread_buffers = None
+        self._sparse_results = None
 
         self._num_realizations = 0
         self._with_summary = False
@@ -307,6 +321,14 @@ class Tally(IDManagerMixin):
     def sparse(self):
         return self._sparse
 
+    @property
+    def thread_buffers(self):
+        return self._thread_buffers
+
+    @property
+    def sparse_results(self):
+        return self._sparse_results
+
     @estimator.setter
     def estimator(self, estimator):
         cv.check_value('estimator', estimator, ESTIMATOR_TYPES)
@@ -329,6 +351,18 @@ class Tally(IDManagerMixin):
                       none_ok=True)
         self._derivative = deriv
 
+    @thread_buffers.setter
+    def thread_buffers(self, thread_buffers):
+        cv.check_type('tally thread buffers', thread_buffers, bool,
+                      none_ok=True)
+        self._thread_buffers = thread_buffers
+
+    @sparse_results.setter
+    def sparse_results(self, sparse_results):
+        cv.check_type('tally sparse results', sparse_results, bool,
+                      none_ok=True)
+        self._sparse_results = sparse_results
+
     @filters.setter
     def filters(self, filters):
         cv.check_type('tally filters', filters, MutableSequence)
@@ -862,6 +896,16 @@ class Tally(IDManagerMixin):
             subelement = ET.SubElement(element, "derivative")
             subelement.text = str(self.derivative.id)
 
+        # Optional thread-private accumulation buffers
+        if self.thread_buffers is not None:
+            subelement = ET.SubElement(element, "thread_buffers")
+            subelement.text = str(self.thread_buffers).lower()
+
+        # Optional sparse storage of results
+        if self.sparse_results is not None:
+            subelement = ET.SubElement(element, "sparse_results")
+            subelement.text = str(self.sparse_results).lower()
+
         return element
 
     @classmethod
@@ -918,6 +962,16 @@ class Tally(IDManagerMixin):
             deriv_id = int(deriv_elem.text)
             tally.derivative = kwargs['derivatives'][deriv_id]
 
+        # Read thread buffer option
+        buffers_elem = elem.find('thread_buffers')
+        if buffers_elem is not None:
+            tally.thread_buffers = buffers_elem.text in ('true', '1')
+
+        # Read sparse results option
+        sparse_elem = elem.find('sparse_results')
+        if sparse_elem is not None:
+            tally.sparse_results = sparse_elem.text in ('true', '1')
+
         return tally
 
     def contains_filter(self, filter_type):
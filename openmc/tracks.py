@@ -2,6 +2,7 @@ from collections import namedtuple
 from collections.abc import Sequence
 
 import h5py
+import numpy as np
 
 from .checkvalue import check_filetype_version
 from .source import SourceParticle, ParticleType
@@ -29,13 +30,34 @@ def _particle_track_repr(self):
 ParticleTrack.__repr__ = _particle_track_repr
 
 
-_VERSION_TRACK = 3
+_VERSION_TRACK = 4
 
 
-def _identifier(dset_name):
-    """Return (batch, gen, particle) tuple given dataset name"""
-    _, batch, gen, particle = dset_name.split('_')
-    return (int(batch), int(gen), int(particle))
+def _absolute_positions(states, offsets):
+    """Return track states with positions stored as displacements converted to
+    absolute positions in double precision
+
+    Parameters
+    ----------
+    states : numpy.ndarray
+        Structured array of track states
+    offsets : numpy.ndarray
+        Index of the first state of each primary/secondary particle followed by
+        the total number of states
+
+    """
+    # Sum displacements in double precision even if they were stored as floats
+    fields = [(name, states.dtype[name]) for name in states.dtype.names]
+    for i, (name, dtype) in enumerate(fields):
+        if dtype.names is not None:
+            fields[i] = (name, [(x, float) for x in dtype.names])
+    states = states.astype(fields)
+
+    for start, end in zip(offsets[:-1], offsets[1:]):
+        for x in 'xyz':
+            r = states['r'][x]
+            r[start:end] = np.cumsum(r[start:end])
+    return states
 
 
 class Track(Sequence):
@@ -48,8 +70,11 @@ class Track(Sequence):
 
     Parameters
     ----------
-    dset : h5py.Dataset
-        Dataset to read track data from
+    identifier : tuple
+        Tuple of (batch, generation, particle number)
+    particle_tracks : list
+        List of :class:`openmc.ParticleTrack` for each primary/secondary
+        particle
 
     Attributes
     ----------
@@ -63,18 +88,9 @@ class Track(Sequence):
 
     """
 
-    def __init__(self, dset):
-        tracks = dset[()]
-        offsets = dset.attrs['offsets']
-        particles = dset.attrs['particles']
-        self.identifier = _identifier(dset.name)
-
-        # Construct list of track histories
-        tracks_list = []
-        for particle, start, end in zip(particles, offsets[:-1], offsets[1:]):
-            ptype = ParticleType(particle)
-            tracks_list.append(ParticleTrack(ptype, tracks[start:end]))
-        self.particle_tracks = tracks_list
+    def __init__(self, identifier, particle_tracks):
+        self.identifier = identifier
+        self.particle_tracks = particle_tracks
 
     def __repr__(self):
         return f'<Track {self.identifier}: {len(self.particle_tracks)} particles>'
@@ -212,10 +228,31 @@ class Tracks(list):
         with h5py.File(filepath, 'r') as fh:
             # Check filetype and version
             check_filetype_version(fh, 'track', _VERSION_TRACK)
-
-            for dset_name in sorted(fh, key=_identifier):
-                dset = fh[dset_name]
-                self.append(Track(dset))
+            histories = fh['histories'][()]
+            particles = fh['particles'][()]
+            states = fh['states'][()]
+            delta_positions = bool(fh.attrs.get('delta_positions', 0))
+
+        # Histories are written in the order they finish, so determine where
+        # the particles and states of each one start from the running counts
+        particle_offsets = np.concatenate(
+            ([0], np.cumsum(histories['n_particles'])))
+        state_offsets = np.concatenate(([0], np.cumsum(particles['n_states'])))
+        if delta_positions:
+            states = _absolute_positions(states, state_offsets)
+
+        tracks = []
+        for i, history in enumerate(histories):
+            identifier = (int(history['batch']), int(history['generation']),
+                          int(history['particle_id']))
+            particle_tracks = []
+            for j in range(particle_offsets[i], particle_offsets[i + 1]):
+                start, end = state_offsets[j], state_offsets[j + 1]
+                ptype = ParticleType(particles['particle'][j])
+                particle_tracks.append(ParticleTrack(ptype, states[start:end]))
+            tracks.append(Track(identifier, particle_tracks))
+
+        self.extend(sorted(tracks, key=lambda t: t.identifier))
 
     def filter(self, particle=None, state_filter=None):
         """Filter tracks by given criteria
@@ -278,6 +315,8 @@ class Tracks(list):
             Path of combined track file to create
 
         """
+        names = ('histories', 'particles', 'states')
+        arrays = {name: [] for name in names}
         with h5py.File(path, 'w') as h5_out:
             for i, fname in enumerate(track_files):
                 with h5py.File(fname, 'r') as h5_in:
@@ -286,6 +325,11 @@ class Tracks(list):
                         h5_out.attrs['filetype'] = h5_in.attrs['filetype']
                         h5_out.attrs['version'] = h5_in.attrs['version']
 
-                    # Copy each 'track_*' dataset from input file
-                    for dset in h5_in:
-                        h5_in.copy(dset, h5_out)
+                    for name in names:
+                        arrays[name].append(h5_in[name][()])
+
+            # Histories refer to particles and states by running counts, so
+            # concatenating each dataset keeps them consistent
+            for name in names:
+                h5_out.create_dataset(name, data=np.concatenate(arrays[name]),
+                                      maxshape=(None,))
@@ -67,6 +67,12 @@ class VolumeCalculation:
         Number of iterations over samples (for calculations with a trigger).
 
         .. versionadded:: 0.12
+    estimator : {'point', 'ray'}
+        Whether volumes are estimated from random points in the bounding box or
+        from the lengths of random rays through it, in which case each sample
+        is a ray.
+
+        .. versionadded:: 0.13.1
 
     """
     def __init__(self, domains, samples, lower_left=None, upper_right=None):
@@ -75,6 +81,7 @@ class VolumeCalculation:
         self._threshold = None
         self._trigger_type = None
         self._iterations = None
+        self._estimator = 'point'
 
         cv.check_type('domains', domains, Iterable,
                       (openmc.Cell, openmc.Material, openmc.Universe))
@@ -150,6 +157,10 @@ class VolumeCalculation:
     def iterations(self):
         return self._iterations
 
+    @property
+    def estimator(self):
+        return self._estimator
+
     @property
     def domain_type(self):
         return self._domain_type
@@ -217,6 +228,11 @@ class VolumeCalculation:
         cv.check_greater_than(name, iterations, 0)
         self._iterations = iterations
 
+    @estimator.setter
+    def estimator(self, estimator):
+        cv.check_value('volume estimator', estimator, ('point', 'ray'))
+        self._estimator = estimator
+
     @volumes.setter
     def volumes(self, volumes):
         cv.check_type('volumes', volumes, Mapping)
@@ -348,6 +364,9 @@ class VolumeCalculation:
         ll_elem.text = ' '.join(str(x) for x in self.lower_left)
         ur_elem = ET.SubElement(element, "upper_right")
         ur_elem.text = ' '.join(str(x) for x in self.upper_right)
+        if self.estimator != 'point':
+            estimator_elem = ET.SubElement(element, "estimator")
+            estimator_elem.text = self.estimator
         if self.threshold:
             trigger_elem = ET.SubElement(element, "threshold")
             trigger_elem.set("type", self.trigger_type)
@@ -400,4 +419,8 @@ class VolumeCalculation:
             threshold = float(get_text(trigger_elem, "threshold"))
             vol.set_trigger(threshold, trigger_type)
 
+        estimator = get_text(elem, "estimator")
+        if estimator is not None:
+            vol.estimator = estimator
+
         return vol
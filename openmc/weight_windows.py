@@ -574,3 +574,213 @@ def wwinp_to_wws(path):
         wws.append(ww)
 
     return wws
+
+
+class WeightWindowGenerator:
+    """Generator of weight windows from the flux tallied during a simulation
+
+    Every `update_interval` batches, the weight windows on the mesh are set
+    with the MAGIC method from the flux accumulated so far: the lower bound in
+    each mesh bin is proportional to the flux, normalized to one half in the
+    bin with the largest flux in each energy group, and the upper bound is
+    `ratio` times the lower bound. An iterable of
+    :class:`WeightWindowGenerator` instances can be assigned to the
+    :attr:`openmc.Settings.weight_window_generators` attribute.
+
+    .. versionadded:: 0.13.1
+
+    Parameters
+    ----------
+    mesh : openmc.MeshBase
+        Mesh for the weight windows
+    energy_bounds : Iterable of Real, optional
+        A list of values for which each successive pair constitutes a range of
+        energies in [eV] for a single bin. By default, a single bin covers all
+        energies.
+    particle_type : {'neutron', 'photon'}
+        Particle type the weight windows apply to
+    update_interval : int
+        Number of batches between updates of the weight windows
+    ratio : float
+        Ratio of the upper to lower weight window bounds
+    method : {'magic', 'fw_cadis'}
+        Method used to generate the weight windows. With 'fw_cadis', the
+        windows are set once from the adjoint flux computed by the random ray
+        solver, and the independent sources are biased accordingly.
+
+    Attributes
+    ----------
+    mesh : openmc.MeshBase
+        Mesh for the weight windows
+    energy_bounds : Iterable of Real or None
+        A list of values for which each successive pair constitutes a range of
+        energies in [eV] for a single bin
+    particle_type : {'neutron', 'photon'}
+        Particle type the weight windows apply to
+    update_interval : int
+        Number of batches between updates of the weight windows
+    ratio : float
+        Ratio of the upper to lower weight window bounds
+    method : {'magic', 'fw_cadis'}
+        Method used to generate the weight windows
+
+    See Also
+    --------
+    openmc.Settings
+
+    """
+
+    def __init__(self, mesh, energy_bounds=None, particle_type='neutron',
+                 update_interval=1, ratio=5.0, method='magic'):
+        self.mesh = mesh
+        self.energy_bounds = energy_bounds
+        self.particle_type = particle_type
+        self.update_interval = update_interval
+        self.ratio = ratio
+        self.method = method
+
+    def __repr__(self):
+        string = type(self).__name__ + '\n'
+        string += '{: <16}=\t{}\n'.format('\tMesh', self.mesh.id)
+        string += '{: <16}=\t{}\n'.format('\tParticle Type',
+                                          self.particle_type)
+        string += '{: <16}=\t{}\n'.format('\tEnergy Bounds',
+                                          self.energy_bounds)
+        string += '{: <16}=\t{}\n'.format('\tUpdate Interval',
+                                          self.update_interval)
+        string += '{: <16}=\t{}\n'.format('\tRatio', self.ratio)
+        string += '{: <16}=\t{}\n'.format('\tMethod', self.method)
+        return string
+
+    @property
+    def mesh(self):
+        return self._mesh
+
+    @mesh.setter
+    def mesh(self, mesh):
+        cv.check_type('Weight window generator mesh', mesh, MeshBase)
+        self._mesh = mesh
+
+    @property
+    def energy_bounds(self):
+        return self._energy_bounds
+
+    @energy_bounds.setter
+    def energy_bounds(self, bounds):
+        if bounds is not None:
+            cv.check_type('Energy bounds', bounds, Iterable, Real)
+            cv.check_length('Energy bounds', bounds, 2)
+            cv.check_increasing('Energy bounds', bounds)
+            bounds = np.asarray(bounds)
+        self._energy_bounds = bounds
+
+    @property
+    def particle_type(self):
+        return self._particle_type
+
+    @particle_type.setter
+    def particle_type(self, pt):
+        cv.check_value('Particle type', pt, _PARTICLES)
+        self._particle_type = pt
+
+    @property
+    def update_interval(self):
+        return self._update_interval
+
+    @update_interval.setter
+    def update_interval(self, interval):
+        cv.check_type('Update interval', interval, Integral)
+        cv.check_greater_than('Update interval', interval, 0)
+        self._update_interval = interval
+
+    @property
+    def ratio(self):
+        return self._ratio
+
+    @ratio.setter
+    def ratio(self, ratio):
+        cv.check_type('Upper to lower bound ratio', ratio, Real)
+        cv.check_greater_than('Upper to lower bound ratio', ratio, 1.0)
+        self._ratio = ratio
+
+    @property
+    def method(self):
+        return self._method
+
+    @method.setter
+    def method(self, method):
+        cv.check_value('Weight window generation method', method,
+                       ('magic', 'fw_cadis'))
+        self._method = method
+
+    def to_xml_element(self):
+        """Return an XML representation of the weight window generator
+
+        Returns
+        -------
+        element : xml.etree.ElementTree.Element
+            XML element containing the weight window generator information
+        """
+        element = ET.Element('weight_window_generator')
+
+        subelement = ET.SubElement(element, 'mesh')
+        subelement.text = str(self.mesh.id)
+
+        subelement = ET.SubElement(element, 'particle_type')
+        subelement.text = self.particle_type
+
+        if self.energy_bounds is not None:
+            subelement = ET.SubElement(element, 'energy_bounds')
+            subelement.text = ' '.join(str(e) for e in self.energy_bounds)
+
+        subelement = ET.SubElement(element, 'update_interval')
+        subelement.text = str(self.update_interval)
+
+        subelement = ET.SubElement(element, 'ratio')
+        subelement.text = str(self.ratio)
+
+        subelement = ET.SubElement(element, 'method')
+        subelement.text = self.method
+
+        return element
+
+    @classmethod
+    def from_xml_element(cls, elem, root):
+        """Generate a weight window generator from an XML element
+
+        Parameters
+        ----------
+        elem : xml.etree.ElementTree.Element
+            XML element
+        root : xml.etree.ElementTree.Element
+            Root element for the file where meshes can be found
+
+        Returns
+        -------
+        openmc.WeightWindowGenerator
+            Weight window generator object
+        """
+        mesh_id = int(get_text(elem, 'mesh'))
+        mesh_elem = root.find(f"./mesh[@id='{mesh_id}']")
+        mesh = MeshBase.from_xml_element(mesh_elem)
+
+        energy_bounds = None
+        text = get_text(elem, 'energy_bounds')
+        if text is not None:
+            energy_bounds = [float(b) for b in text.split()]
+
+        kwargs = {}
+        text = get_text(elem, 'particle_type')
+        if text is not None:
+            kwargs['particle_type'] = text
+        text = get_text(elem, 'update_interval')
+        if text is not None:
+            kwargs['update_interval'] = int(text)
+        text = get_text(elem, 'ratio')
+        if text is not None:
+            kwargs['ratio'] = float(text)
+        text = get_text(elem, 'method')
+        if text is not None:
+            kwargs['method'] = text
+
+        return cls(mesh, energy_bounds, **kwargs)
@@ -0,0 +1,177 @@
+#include "openmc/auto_tune.h"
+
+#include <algorithm> // for find_if, min, max
+#include <cstdint>   // for int64_t
+
+#include "openmc/constants.h"
+#include "openmc/delta_tracking.h"
+#include "openmc/error.h"
+#include "openmc/event.h"
+#include "openmc/message_passing.h"
+#include "openmc/offload.h"
+#include "openmc/settings.h"
+#include "openmc/simulation.h"
+#include "openmc/timer.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+
+namespace {
+
+//==============================================================================
+// Tuning state
+//==============================================================================
+
+enum class Tuned { LOG_GRID_BINS, PARTICLES_IN_FLIGHT };
+
+//! A value of a setting tried in one batch
+struct Trial {
+  Tuned setting;
+  int64_t value;
+};
+
+vector<Trial> trials;      //!< Trials in the order they are run
+int64_t best_log_bins;     //!< Fastest number of logarithmic grid bins
+int64_t best_in_flight;    //!< Fastest maximum number of particles in flight
+double best_time[2];       //!< Transport time of the fastest trial of each
+double time_start;         //!< Transport time before the current batch
+
+//! Index of the trial run in the current batch, or -1. The first batch warms
+//! up caches and is not timed.
+int current_trial()
+{
+  int i = simulation::current_batch - 2;
+  return (i >= 0 && i < trials.size()) ? i : -1;
+}
+
+//! Add trials of multiples of a setting's value, skipping duplicates
+void add_trials(Tuned setting, int64_t value, int64_t max_value)
+{
+  for (double f : {1.0, 0.25, 0.5, 2.0, 4.0}) {
+    int64_t x = std::min(std::max<int64_t>(f * value, 1), max_value);
+    auto it = std::find_if(trials.begin(), trials.end(),
+      [&](const Trial& t) { return t.setting == setting && t.value == x; });
+    if (it == trials.end())
+      trials.push_back({setting, x});
+  }
+}
+
+//! Set the tuned settings, rebuilding whatever depends on them
+void apply(int64_t n_log_bins, int64_t in_flight)
+{
+  bool changed = false;
+  if (n_log_bins != settings::n_log_bins) {
+    settings::n_log_bins = n_log_bins;
+    initialize_data();
+    init_delta_tracking();
+    changed = true;
+  }
+  if (in_flight != settings::max_particles_in_flight) {
+    settings::max_particles_in_flight = in_flight;
+    int64_t length = std::min(simulation::work_per_rank, in_flight);
+    init_event_queues(length);
+    changed = true;
+  }
+
+  // The device copies of the union grids depend on the logarithmic grid and
+  // the lookup buffers on the number of particles in flight
+  if (changed && offload_active()) {
+    offload_init(
+      std::min(simulation::work_per_rank, settings::max_particles_in_flight));
+  }
+}
+
+} // namespace
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+void init_auto_tune()
+{
+  trials.clear();
+  if (!settings::auto_tune)
+    return;
+  if (settings::run_mode != RunMode::EIGENVALUE || settings::restart_run ||
+      settings::n_inactive < 2) {
+    warning("Performance settings are only auto-tuned in eigenvalue "
+            "simulations with at least two inactive batches that are not "
+            "restarted.");
+    return;
+  }
+
+  best_log_bins = settings::n_log_bins;
+  best_in_flight = settings::max_particles_in_flight;
+  best_time[0] = INFTY;
+  best_time[1] = INFTY;
+  if (settings::run_CE)
+    add_trials(Tuned::LOG_GRID_BINS, settings::n_log_bins, INT32_MAX);
+  if (settings::event_based) {
+    add_trials(Tuned::PARTICLES_IN_FLIGHT,
+      std::min(simulation::work_per_rank, settings::max_particles_in_flight),
+      simulation::work_per_rank);
+  }
+
+  // Only as many trials as there are inactive batches to time are run
+  int n_trials = settings::n_inactive - 1;
+  if (trials.size() > n_trials)
+    trials.resize(n_trials);
+}
+
+void auto_tune_initialize_batch()
+{
+  int i = current_trial();
+  if (i < 0)
+    return;
+
+  // The number of particles in flight is tried with the fastest grid
+  const auto& t = trials[i];
+  if (t.setting == Tuned::LOG_GRID_BINS) {
+    apply(t.value, best_in_flight);
+  } else {
+    apply(best_log_bins, t.value);
+  }
+  time_start = simulation::time_transport.elapsed();
+}
+
+void auto_tune_finalize_batch()
+{
+  int i = current_trial();
+  if (i < 0)
+    return;
+
+  // Every process must choose the same configuration, so the batch takes as
+  // long as its slowest process
+  double time = simulation::time_transport.elapsed() - time_start;
+#ifdef OPENMC_MPI
+  MPI_Allreduce(MPI_IN_PLACE, &time, 1, MPI_DOUBLE, MPI_MAX, mpi::intracomm);
+#endif
+
+  const auto& t = trials[i];
+  bool log_bins = t.setting == Tuned::LOG_GRID_BINS;
+  write_message(7, "Auto-tuning {} = {}: {:.4e} particles/second",
+    log_bins ? "log_grid_bins" : "max_particles_in_flight", t.value,
+    simulation::work_per_rank * mpi::n_procs * settings::gen_per_batch /
+      time);
+  int k = log_bins ? 0 : 1;
+  if (time < best_time[k]) {
+    best_time[k] = time;
+    (log_bins ? best_log_bins : best_in_flight) = t.value;
+  }
+
+  // Lock in the fastest configuration after the last trial
+  if (i == trials.size() - 1) {
+    apply(best_log_bins, best_in_flight);
+    if (settings::event_based) {
+      write_message(5,
+        "Auto-tuning chose log_grid_bins = {} and max_particles_in_flight = "
+        "{}",
+        settings::n_log_bins, settings::max_particles_in_flight);
+    } else {
+      write_message(
+        5, "Auto-tuning chose log_grid_bins = {}", settings::n_log_bins);
+    }
+  }
+}
+
+} // namespace openmc
@@ -1,10 +1,17 @@
 #include "openmc/bank.h"
 #include "openmc/capi.h"
+#include "openmc/eigenvalue.h"
 #include "openmc/error.h"
+#include "openmc/ifp.h"
 #include "openmc/message_passing.h"
 #include "openmc/simulation.h"
+#include "openmc/state_point.h"
 #include "openmc/vector.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <cstdint>
 
 namespace openmc {
@@ -19,11 +26,13 @@ vector<SourceSite> source_bank;
 
 SharedArray<SourceSite> surf_source_bank;
 
+vector<vector<SourceSite>> surf_source_buffers;
+
 // The fission bank is allocated as a SharedArray, rather than a vector, as it
-// will be shared by all threads in the simulation. It will be allocated to a
-// fixed maximum capacity in the init_fission_bank() function. Then, Elements
+// will be shared by all threads in the simulation. It will be allocated to an
+// initial capacity in the init_fission_bank() function. Then, Elements
 // will be added to it by using SharedArray's special thread_safe_append()
-// function.
+// function, which spills into overflow chunks when the capacity is exceeded.
 SharedArray<SourceSite> fission_bank;
 
 // Each entry in this vector corresponds to the number of progeny produced
@@ -41,16 +50,38 @@ void free_memory_bank()
 {
   simulation::source_bank.clear();
   simulation::surf_source_bank.clear();
+  simulation::surf_source_buffers.clear();
   simulation::fission_bank.clear();
   simulation::progeny_per_particle.clear();
+  simulation::ifp_source_bank.clear();
+  simulation::ifp_n_ancestors = 0;
 }
 
 void init_fission_bank(int64_t max)
 {
-  simulation::fission_bank.reserve(max);
+  // A bank left from a previous simulation is kept if it is large enough
+  if (simulation::fission_bank.capacity() < max)
+    simulation::fission_bank.reserve(max, FISSION_BANK_MAX_CHUNKS);
   simulation::progeny_per_particle.resize(simulation::work_per_rank);
 }
 
+void bank_surf_source_site(const SourceSite& site)
+{
+  int i_thread = 0;
+#ifdef _OPENMP
+  i_thread = omp_get_thread_num();
+#endif
+  auto& buffer = simulation::surf_source_buffers[i_thread];
+  buffer.push_back(site);
+  if (buffer.size() < SURF_SOURCE_BUFFER_SIZE)
+    return;
+
+  // Only one thread writes to the file at a time
+#pragma omp critical(SurfSourceStream)
+  write_surf_source_stream(buffer);
+  buffer.clear();
+}
+
 // Performs an O(n) sort on the fission bank, by leveraging
 // the parent_id and progeny_id fields of banked particles. See the following
 // paper for more details:
@@ -65,17 +96,46 @@ void sort_fission_bank()
   }
 
   // Perform exclusive scan summation to determine starting indices in fission
-  // bank for each parent particle id
-  int64_t tmp = simulation::progeny_per_particle[0];
-  simulation::progeny_per_particle[0] = 0;
-  for (int64_t i = 1; i < simulation::progeny_per_particle.size(); i++) {
-    int64_t value = simulation::progeny_per_particle[i - 1] + tmp;
-    tmp = simulation::progeny_per_particle[i];
-    simulation::progeny_per_particle[i] = value;
-  }
+  // bank for each parent particle id. Each thread sums a contiguous chunk of
+  // particles, the chunk totals are scanned, and each thread then scans its
+  // own chunk starting from the total of the chunks before it.
+  auto& progeny = simulation::progeny_per_particle;
+  int64_t n_particles = progeny.size();
+  vector<int64_t> chunk_start;
+#pragma omp parallel
+  {
+#ifdef _OPENMP
+    int n_threads = omp_get_num_threads();
+    int tid = omp_get_thread_num();
+#else
+    int n_threads = 1;
+    int tid = 0;
+#endif
+
+#pragma omp single
+    chunk_start.resize(n_threads + 1);
+
+    int64_t i_begin = n_particles * tid / n_threads;
+    int64_t i_end = n_particles * (tid + 1) / n_threads;
+    int64_t sum = 0;
+    for (int64_t i = i_begin; i < i_end; i++) {
+      sum += progeny[i];
+    }
+    chunk_start[tid + 1] = sum;
 
-  // TODO: C++17 introduces the exclusive_scan() function which could be
-  // used to replace everything above this point in this function.
+#pragma omp barrier
+#pragma omp single
+    for (int t = 0; t < n_threads; ++t) {
+      chunk_start[t + 1] += chunk_start[t];
+    }
+
+    int64_t start = chunk_start[tid];
+    for (int64_t i = i_begin; i < i_end; i++) {
+      int64_t value = progeny[i];
+      progeny[i] = start;
+      start += value;
+    }
+  }
 
   // We need a scratch vector to make permutation of the fission bank into
   // sorted order easy. Under normal usage conditions, the fission bank is
@@ -92,21 +152,31 @@ void sort_fission_bank()
     sorted_bank = &simulation::fission_bank[simulation::fission_bank.size()];
   }
 
-  // Use parent and progeny indices to sort fission bank
-  for (int64_t i = 0; i < simulation::fission_bank.size(); i++) {
+  // Use parent and progeny indices to sort fission bank. Each site has its
+  // own position in the sorted bank, so the sites can be placed in parallel.
+  int64_t n_sites = simulation::fission_bank.size();
+  bool mismatch = false;
+#pragma omp parallel for reduction(|| : mismatch)
+  for (int64_t i = 0; i < n_sites; i++) {
     const auto& site = simulation::fission_bank[i];
     int64_t offset = site.parent_id - 1 - simulation::work_index[mpi::rank];
-    int64_t idx = simulation::progeny_per_particle[offset] + site.progeny_id;
-    if (idx >= simulation::fission_bank.size()) {
-      fatal_error("Mismatch detected between sum of all particle progeny and "
-                  "shared fission bank size.");
+    int64_t idx = progeny[offset] + site.progeny_id;
+    if (idx >= n_sites) {
+      mismatch = true;
+    } else {
+      sorted_bank[idx] = site;
     }
-    sorted_bank[idx] = site;
+  }
+  if (mismatch) {
+    fatal_error("Mismatch detected between sum of all particle progeny and "
+                "shared fission bank size.");
   }
 
   // Copy sorted bank into the fission bank
-  std::copy(sorted_bank, sorted_bank + simulation::fission_bank.size(),
-    simulation::fission_bank.data());
+#pragma omp parallel for
+  for (int64_t i = 0; i < n_sites; i++) {
+    simulation::fission_bank[i] = sorted_bank[i];
+  }
 }
 
 //==============================================================================
@@ -124,6 +194,7 @@ extern "C" int openmc_source_bank(void** ptr, int64_t* n)
     set_errmsg("Source bank has not been allocated.");
     return OPENMC_E_ALLOCATE;
   } else {
+    finish_bank_exchange();
     *ptr = simulation::source_bank.data();
     *n = simulation::source_bank.size();
     return 0;
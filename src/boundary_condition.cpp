@@ -4,8 +4,10 @@
 
 #include <fmt/core.h>
 
+#include "openmc/cell.h"
 #include "openmc/constants.h"
 #include "openmc/error.h"
+#include "openmc/geometry.h"
 #include "openmc/surface.h"
 
 namespace openmc {
@@ -43,6 +45,28 @@ void WhiteBC::handle_particle(Particle& p, const Surface& surf) const
   p.cross_reflective_bc(surf, u);
 }
 
+//==============================================================================
+// PeriodicBC implementation
+//==============================================================================
+
+void PeriodicBC::find_partner_cells()
+{
+  for (int32_t i = 0; i < model::cells.size(); ++i) {
+    const Cell& c {*model::cells[i]};
+    if (c.universe_ != model::root_universe)
+      continue;
+    for (auto token : c.rpn_) {
+      if (token >= OP_UNION)
+        continue;
+      int i_surf = std::abs(token) - 1;
+      if (i_surf == i_surf_)
+        i_cells_.push_back(i);
+      if (i_surf == j_surf_)
+        j_cells_.push_back(i);
+    }
+  }
+}
+
 //==============================================================================
 // TranslationalPeriodicBC implementation
 //==============================================================================
@@ -118,12 +142,15 @@ void TranslationalPeriodicBC::handle_particle(
   // particle's new location and surface.
   Position new_r;
   int new_surface;
+  NeighborList* partners;
   if (i_particle_surf == i_surf_) {
     new_r = p.r() + translation_;
     new_surface = p.surface() > 0 ? j_surf_ + 1 : -(j_surf_ + 1);
+    partners = &j_cells_;
   } else if (i_particle_surf == j_surf_) {
     new_r = p.r() - translation_;
     new_surface = p.surface() > 0 ? i_surf_ + 1 : -(i_surf_ + 1);
+    partners = &i_cells_;
   } else {
     throw std::runtime_error(
       "Called BoundaryCondition::handle_particle after "
@@ -131,7 +158,7 @@ void TranslationalPeriodicBC::handle_particle(
   }
 
   // Pass the new location and surface to the particle.
-  p.cross_periodic_bc(surf, new_r, p.u(), new_surface);
+  p.cross_periodic_bc(surf, new_r, p.u(), new_surface, *partners);
 }
 
 //==============================================================================
@@ -242,12 +269,15 @@ void RotationalPeriodicBC::handle_particle(
   // the particle's new surface.
   double theta;
   int new_surface;
+  NeighborList* partners;
   if (i_particle_surf == i_surf_) {
     theta = angle_;
     new_surface = p.surface() > 0 ? -(j_surf_ + 1) : j_surf_ + 1;
+    partners = &j_cells_;
   } else if (i_particle_surf == j_surf_) {
     theta = -angle_;
     new_surface = p.surface() > 0 ? -(i_surf_ + 1) : i_surf_ + 1;
+    partners = &i_cells_;
   } else {
     throw std::runtime_error(
       "Called BoundaryCondition::handle_particle after "
@@ -265,7 +295,7 @@ void RotationalPeriodicBC::handle_particle(
     cos_theta * u.x - sin_theta * u.y, sin_theta * u.x + cos_theta * u.y, u.z};
 
   // Pass the new location, direction, and surface to the particle.
-  p.cross_periodic_bc(surf, new_r, new_u, new_surface);
+  p.cross_periodic_bc(surf, new_r, new_u, new_surface, *partners);
 }
 
 } // namespace openmc
@@ -1,5 +1,7 @@
 #include "openmc/bremsstrahlung.h"
 
+#include <algorithm> // for min
+
 #include "openmc/constants.h"
 #include "openmc/material.h"
 #include "openmc/random_lcg.h"
@@ -83,9 +85,8 @@ void thick_target_bremsstrahlung(Particle& p, double* E_lost)
     // Interpolate the maximum value of the CDF at the incoming particle
     // energy on a log-log scale
     double p_l = mat->pdf(i_e, i_e - 1);
-    double p_r = mat->pdf(i_e, i_e);
     double c_l = mat->cdf(i_e, i_e - 1);
-    double a = std::log(p_r / p_l) / (e_r - e_l) + 1.0;
+    double a = mat->exponent(i_e, i_e - 1);
     c_max = c_l + std::exp(e_l) * p_l / a * (std::exp(a * (e - e_l)) - 1.0);
   } else {
     i_e = j;
@@ -95,19 +96,24 @@ void thick_target_bremsstrahlung(Particle& p, double* E_lost)
   }
 
   // Sample the energies of the emitted photons
+  double c_end = mat->cdf(i_e, i_e);
   for (int i = 0; i < n; ++i) {
     // Generate a random number r and determine the index i for which
-    // cdf(i) <= r*cdf,max <= cdf(i+1)
+    // cdf(i) <= r*cdf,max <= cdf(i+1), starting from the guide table and
+    // moving to the last CDF value below r*cdf,max
     double c = prn(p.current_seed()) * c_max;
-    int i_w = lower_bound_index(&mat->cdf(i_e, 0), &mat->cdf(i_e, 0) + i_e, c);
+    int g = c_end > 0.0 ? std::min<int>(c / c_end * i_e, i_e - 1) : 0;
+    int i_w = mat->guide(i_e, g);
+    while (i_w > 0 && mat->cdf(i_e, i_w) >= c)
+      --i_w;
+    while (i_w + 1 < i_e && mat->cdf(i_e, i_w + 1) < c)
+      ++i_w;
 
     // Sample the photon energy
     double w_l = data::ttb_e_grid(i_w);
-    double w_r = data::ttb_e_grid(i_w + 1);
     double p_l = mat->pdf(i_e, i_w);
-    double p_r = mat->pdf(i_e, i_w + 1);
     double c_l = mat->cdf(i_e, i_w);
-    double a = std::log(p_r / p_l) / (w_r - w_l) + 1.0;
+    double a = mat->exponent(i_e, i_w);
     double w = std::exp(w_l) *
                std::pow(a * (c - c_l) / (std::exp(w_l) * p_l) + 1.0, 1.0 / a);
 
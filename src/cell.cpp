@@ -22,6 +22,7 @@
 #include "openmc/material.h"
 #include "openmc/nuclide.h"
 #include "openmc/settings.h"
+#include "openmc/thermal.h"
 #include "openmc/xml_interface.h"
 
 namespace openmc {
@@ -36,6 +37,23 @@ vector<unique_ptr<Cell>> cells;
 
 } // namespace model
 
+//==============================================================================
+//! Evaluate the sense of a location with respect to a surface, reusing the
+//! sense from the cache if it was already evaluated there.
+//==============================================================================
+
+inline bool surface_sense(
+  int32_t i_surf, Position r, Direction u, SurfaceSenseCache* cache)
+{
+  bool sense;
+  if (cache && cache->find(i_surf, sense))
+    return sense;
+  sense = model::surface_store.sense(i_surf, r, u);
+  if (cache)
+    cache->insert(i_surf, sense);
+  return sense;
+}
+
 //==============================================================================
 //! Convert region specification string to integer tokens.
 //!
@@ -45,65 +63,71 @@ vector<unique_ptr<Cell>> cells;
 
 vector<int32_t> tokenize(const std::string region_spec)
 {
-  // Check for an empty region_spec first.
   vector<int32_t> tokens;
-  if (region_spec.empty()) {
-    return tokens;
-  }
+
+  // Add a token, preceded by an intersection operator where one is needed
+  // between it and the previous token
+  auto push = [&tokens](int32_t token) {
+    if (!tokens.empty()) {
+      int32_t prev = tokens.back();
+      bool left_compat {(prev < OP_UNION) || (prev == OP_RIGHT_PAREN)};
+      bool right_compat {(token < OP_UNION) || (token == OP_LEFT_PAREN) ||
+                         (token == OP_COMPLEMENT)};
+      if (left_compat && right_compat) {
+        tokens.push_back(OP_INTERSECTION);
+      }
+    }
+    tokens.push_back(token);
+  };
 
   // Parse all halfspaces and operators except for intersection (whitespace).
   for (int i = 0; i < region_spec.size();) {
-    if (region_spec[i] == '(') {
-      tokens.push_back(OP_LEFT_PAREN);
+    char c = region_spec[i];
+    if (c == '(') {
+      push(OP_LEFT_PAREN);
       i++;
 
-    } else if (region_spec[i] == ')') {
-      tokens.push_back(OP_RIGHT_PAREN);
+    } else if (c == ')') {
+      push(OP_RIGHT_PAREN);
       i++;
 
-    } else if (region_spec[i] == '|') {
-      tokens.push_back(OP_UNION);
+    } else if (c == '|') {
+      push(OP_UNION);
       i++;
 
-    } else if (region_spec[i] == '~') {
-      tokens.push_back(OP_COMPLEMENT);
+    } else if (c == '~') {
+      push(OP_COMPLEMENT);
       i++;
 
-    } else if (region_spec[i] == '-' || region_spec[i] == '+' ||
-               std::isdigit(region_spec[i])) {
-      // This is the start of a halfspace specification.  Iterate j until we
-      // find the end, then push-back everything between i and j.
-      int j = i + 1;
+    } else if (c == '-' || c == '+' || std::isdigit(c)) {
+      // This is the start of a halfspace specification. Accumulate the digits
+      // in place rather than copying them out to convert them.
+      int sign = (c == '-') ? -1 : 1;
+      int j = std::isdigit(c) ? i : i + 1;
+      int32_t value = 0;
+      int j_start = j;
       while (j < region_spec.size() && std::isdigit(region_spec[j])) {
+        value = 10 * value + (region_spec[j] - '0');
         j++;
       }
-      tokens.push_back(std::stoi(region_spec.substr(i, j - i)));
+      if (j == j_start) {
+        fatal_error(fmt::format(
+          "Region specification contains a sign without a surface ID, \"{}\"",
+          region_spec));
+      }
+      push(sign * value);
       i = j;
 
-    } else if (std::isspace(region_spec[i])) {
+    } else if (std::isspace(c)) {
       i++;
 
     } else {
-      auto err_msg =
-        fmt::format("Region specification contains invalid character, \"{}\"",
-          region_spec[i]);
+      auto err_msg = fmt::format(
+        "Region specification contains invalid character, \"{}\"", c);
       fatal_error(err_msg);
     }
   }
 
-  // Add in intersection operators where a missing operator is needed.
-  int i = 0;
-  while (i < tokens.size() - 1) {
-    bool left_compat {(tokens[i] < OP_UNION) || (tokens[i] == OP_RIGHT_PAREN)};
-    bool right_compat {(tokens[i + 1] < OP_UNION) ||
-                       (tokens[i + 1] == OP_LEFT_PAREN) ||
-                       (tokens[i + 1] == OP_COMPLEMENT)};
-    if (left_compat && right_compat) {
-      tokens.insert(tokens.begin() + i + 1, OP_INTERSECTION);
-    }
-    i++;
-  }
-
   return tokens;
 }
 
@@ -228,6 +252,13 @@ void Cell::set_rotation(const vector<double>& rot)
   } else {
     std::copy(rot.begin(), rot.end(), std::back_inserter(rotation_));
   }
+
+  // A rotation by zero angles is kept for output but is not applied
+  rotated_ = false;
+  for (int i = 0; i < 9; ++i) {
+    if (rotation_[i] != (i % 4 == 0 ? 1.0 : 0.0))
+      rotated_ = true;
+  }
 }
 
 double Cell::temperature(int32_t instance) const
@@ -244,6 +275,14 @@ double Cell::temperature(int32_t instance) const
   }
 }
 
+void Cell::update_temperature_indices()
+{
+  i_sqrtkT_.resize(sqrtkT_.size());
+  for (int i = 0; i < sqrtkT_.size(); ++i) {
+    i_sqrtkT_[i] = cell_temperature_index(sqrtkT_[i]);
+  }
+}
+
 void Cell::set_temperature(double T, int32_t instance, bool set_contained)
 {
   if (settings::temperature_method == TemperatureMethod::INTERPOLATION) {
@@ -261,14 +300,18 @@ void Cell::set_temperature(double T, int32_t instance, bool set_contained)
       // If temperature vector is not big enough, resize it first
       if (sqrtkT_.size() != n_instances_)
         sqrtkT_.resize(n_instances_, sqrtkT_[0]);
+      if (i_sqrtkT_.size() != sqrtkT_.size())
+        this->update_temperature_indices();
 
       // Set temperature for the corresponding instance
       sqrtkT_.at(instance) = std::sqrt(K_BOLTZMANN * T);
+      i_sqrtkT_.at(instance) = cell_temperature_index(sqrtkT_[instance]);
     } else {
       // Set temperature for all instances
       for (auto& T_ : sqrtkT_) {
         T_ = std::sqrt(K_BOLTZMANN * T);
       }
+      this->update_temperature_indices();
     }
   } else {
     if (!set_contained) {
@@ -290,20 +333,6 @@ void Cell::set_temperature(double T, int32_t instance, bool set_contained)
   }
 }
 
-void Cell::export_properties_hdf5(hid_t group) const
-{
-  // Create a group for this cell.
-  auto cell_group = create_group(group, fmt::format("cell {}", id_));
-
-  // Write temperature in [K] for one or more cell instances
-  vector<double> temps;
-  for (auto sqrtkT_val : sqrtkT_)
-    temps.push_back(sqrtkT_val * sqrtkT_val / K_BOLTZMANN);
-  write_dataset(cell_group, "temperature", temps);
-
-  close_group(cell_group);
-}
-
 void Cell::import_properties_hdf5(hid_t group)
 {
   auto cell_group = open_group(group, fmt::format("cell {}", id_));
@@ -389,6 +418,37 @@ void Cell::to_hdf5(hid_t cell_group) const
   close_group(group);
 }
 
+std::string Cell::region_spec() const
+{
+  std::stringstream spec;
+  for (int32_t token : region_) {
+    if (token == OP_LEFT_PAREN) {
+      spec << " (";
+    } else if (token == OP_RIGHT_PAREN) {
+      spec << " )";
+    } else if (token == OP_COMPLEMENT) {
+      spec << " ~";
+    } else if (token == OP_INTERSECTION) {
+    } else if (token == OP_UNION) {
+      spec << " |";
+    } else {
+      // Note the off-by-one indexing
+      auto surf_id = model::surfaces[abs(token) - 1]->id_;
+      spec << " " << ((token > 0) ? surf_id : -surf_id);
+    }
+  }
+  return spec.str();
+}
+
+size_t Cell::memory_usage() const
+{
+  return sizeof(Cell) +
+         sizeof(int32_t) *
+           (material_.size() + region_.size() + rpn_.size() + offset_.size()) +
+         sizeof(double) * (sqrtkT_.size() + rotation_.size()) +
+         sizeof(int) * i_sqrtkT_.size() + neighbors_.nbytes();
+}
+
 //==============================================================================
 // CSGCell implementation
 //==============================================================================
@@ -541,6 +601,10 @@ CSGCell::CSGCell(pugi::xml_node cell_node)
   }
   rpn_.shrink_to_fit();
 
+  if (!simple_)
+    compile_region();
+  build_surface_block();
+
   // Read the translation vector.
   if (check_for_node(cell_node, "translation")) {
     if (fill_ == C_NONE) {
@@ -566,23 +630,180 @@ CSGCell::CSGCell(pugi::xml_node cell_node)
 
 //==============================================================================
 
-bool CSGCell::contains(Position r, Direction u, int32_t on_surface) const
+bool CSGCell::contains(Position r, Direction u, int32_t on_surface,
+  SurfaceSenseCache* cache) const
 {
+  if (cache)
+    cache->set_location(r, u);
+
   if (simple_) {
-    return contains_simple(r, u, on_surface);
+    return contains_simple(r, u, on_surface, cache);
   } else {
-    return contains_complex(r, u, on_surface);
+    return contains_complex(r, u, on_surface, cache);
   }
 }
 
 //==============================================================================
 
+void CSGCell::build_surface_block()
+{
+  auto block = make_unique<SurfaceBlock>();
+  int n_token = 0;
+  for (int32_t token : rpn_) {
+    if (token >= OP_UNION)
+      continue;
+    if (++n_token > SURFACE_BLOCK_MAX)
+      return;
+
+    int32_t i_surf = std::abs(token);
+    const Surface* surf = model::surfaces[i_surf - 1].get();
+    auto add_plane = [&](double A, double B, double C, double D) {
+      block->order.push_back(-1 - static_cast<int>(block->plane_surf.size()));
+      block->plane_surf.push_back(i_surf);
+      block->A.push_back(A);
+      block->B.push_back(B);
+      block->C.push_back(C);
+      block->D.push_back(D);
+    };
+    auto add_quadric = [&](Position r0, Position m, double R) {
+      block->order.push_back(block->quad_surf.size());
+      block->quad_surf.push_back(i_surf);
+      block->x0.push_back(r0.x);
+      block->y0.push_back(r0.y);
+      block->z0.push_back(r0.z);
+      block->mx.push_back(m.x);
+      block->my.push_back(m.y);
+      block->mz.push_back(m.z);
+      block->R2.push_back(R * R);
+    };
+
+    if (auto s = dynamic_cast<const SurfaceXPlane*>(surf)) {
+      add_plane(1.0, 0.0, 0.0, s->x0_);
+    } else if (auto s = dynamic_cast<const SurfaceYPlane*>(surf)) {
+      add_plane(0.0, 1.0, 0.0, s->y0_);
+    } else if (auto s = dynamic_cast<const SurfaceZPlane*>(surf)) {
+      add_plane(0.0, 0.0, 1.0, s->z0_);
+    } else if (auto s = dynamic_cast<const SurfacePlane*>(surf)) {
+      add_plane(s->A_, s->B_, s->C_, s->D_);
+    } else if (auto s = dynamic_cast<const SurfaceXCylinder*>(surf)) {
+      add_quadric({0.0, s->y0_, s->z0_}, {0.0, 1.0, 1.0}, s->radius_);
+    } else if (auto s = dynamic_cast<const SurfaceYCylinder*>(surf)) {
+      add_quadric({s->x0_, 0.0, s->z0_}, {1.0, 0.0, 1.0}, s->radius_);
+    } else if (auto s = dynamic_cast<const SurfaceZCylinder*>(surf)) {
+      add_quadric({s->x0_, s->y0_, 0.0}, {1.0, 1.0, 0.0}, s->radius_);
+    } else if (auto s = dynamic_cast<const SurfaceSphere*>(surf)) {
+      add_quadric({s->x0_, s->y0_, s->z0_}, {1.0, 1.0, 1.0}, s->radius_);
+    } else {
+      return;
+    }
+  }
+
+  // Distances to planes are stored after those to quadrics
+  int n_quad = block->quad_surf.size();
+  for (auto& i : block->order) {
+    if (i < 0)
+      i = n_quad - 1 - i;
+  }
+  surface_block_ = std::move(block);
+}
+
+//==============================================================================
+
 std::pair<double, int32_t> CSGCell::distance(
   Position r, Direction u, int32_t on_surface, Particle* p) const
 {
   double min_dist {INFTY};
   int32_t i_surf {std::numeric_limits<int32_t>::max()};
 
+  if (surface_block_) {
+    // Evaluate the distances to all surfaces without virtual calls.  These
+    // follow Surface::distance for each surface type exactly, but with the
+    // branches replaced by selects so that the loops vectorize.
+    const auto& b {*surface_block_};
+    int32_t i_on = std::abs(on_surface);
+    int n_quad = b.quad_surf.size();
+    int n_plane = b.plane_surf.size();
+    double dist[SURFACE_BLOCK_MAX];
+
+    // The terms that only depend on the location are reused if the particle
+    // hasn't moved since the last distance calculation in this cell, e.g.
+    // after a collision
+    double local_terms[4 * SURFACE_BLOCK_MAX];
+    int n_terms = 4 * n_quad + n_plane;
+    bool found = false;
+    double* terms = p ? p->distance_cache().find(this, r, n_terms, found)
+                      : local_terms;
+    double* tx = terms;
+    double* ty = tx + n_quad;
+    double* tz = ty + n_quad;
+    double* tc = tz + n_quad;
+    double* tf = tc + n_quad;
+    if (!found) {
+#pragma omp simd
+      for (int i = 0; i < n_quad; ++i) {
+        const double x = (r.x - b.x0[i]) * b.mx[i];
+        const double y = (r.y - b.y0[i]) * b.my[i];
+        const double z = (r.z - b.z0[i]) * b.mz[i];
+        tx[i] = x;
+        ty[i] = y;
+        tz[i] = z;
+        tc[i] = x * x + y * y + z * z - b.R2[i];
+      }
+
+#pragma omp simd
+      for (int i = 0; i < n_plane; ++i) {
+        tf[i] = b.A[i] * r.x + b.B[i] * r.y + b.C[i] * r.z - b.D[i];
+      }
+    }
+
+#pragma omp simd
+    for (int i = 0; i < n_quad; ++i) {
+      const double x = tx[i];
+      const double y = ty[i];
+      const double z = tz[i];
+      const double a = 1.0 - (u.x * u.x * (1.0 - b.mx[i]) +
+                               u.y * u.y * (1.0 - b.my[i]) +
+                               u.z * u.z * (1.0 - b.mz[i]));
+      const double k = x * u.x + y * u.y + z * u.z;
+      const double c = tc[i];
+      const double quad = k * k - a * c;
+      const double sqrt_quad = std::sqrt(quad < 0.0 ? 0.0 : quad);
+      const bool on = b.quad_surf[i] == i_on || std::abs(c) < FP_COINCIDENT;
+      const double d_far = (-k + sqrt_quad) / a;
+      const double d_near = (-k - sqrt_quad) / a;
+      const bool miss = a == 0.0 || quad < 0.0 || (on && k >= 0.0) ||
+                        (!on && c >= 0.0 && d_near < 0.0);
+      dist[i] = miss ? INFTY : ((on || c < 0.0) ? d_far : d_near);
+    }
+
+#pragma omp simd
+    for (int i = 0; i < n_plane; ++i) {
+      const double f = tf[i];
+      const double projection = b.A[i] * u.x + b.B[i] * u.y + b.C[i] * u.z;
+      const double d = -f / projection;
+      const bool miss = b.plane_surf[i] == i_on ||
+                        std::abs(f) < FP_COINCIDENT || projection == 0.0 ||
+                        d < 0.0;
+      dist[n_quad + i] = miss ? INFTY : d;
+    }
+
+    // Select the nearest surface in RPN order so that near ties are resolved
+    // as in the general case below
+    int j = 0;
+    for (int32_t token : rpn_) {
+      if (token >= OP_UNION)
+        continue;
+      double d = dist[b.order[j++]];
+      if (d < min_dist) {
+        if (min_dist - d >= FP_PRECISION * min_dist) {
+          min_dist = d;
+          i_surf = -token;
+        }
+      }
+    }
+    return {min_dist, i_surf};
+  }
+
   for (int32_t token : rpn_) {
     // Ignore this token if it corresponds to an operator rather than a region.
     if (token >= OP_UNION)
@@ -591,7 +812,8 @@ std::pair<double, int32_t> CSGCell::distance(
     // Calculate the distance to this surface.
     // Note the off-by-one indexing
     bool coincident {std::abs(token) == std::abs(on_surface)};
-    double d {model::surfaces[abs(token) - 1]->distance(r, u, coincident)};
+    double d {
+      model::surface_store.distance(abs(token) - 1, r, u, coincident)};
 
     // Check if this distance is the new minimum.
     if (d < min_dist) {
@@ -614,24 +836,7 @@ void CSGCell::to_hdf5_inner(hid_t group_id) const
 
   // Write the region specification.
   if (!region_.empty()) {
-    std::stringstream region_spec {};
-    for (int32_t token : region_) {
-      if (token == OP_LEFT_PAREN) {
-        region_spec << " (";
-      } else if (token == OP_RIGHT_PAREN) {
-        region_spec << " )";
-      } else if (token == OP_COMPLEMENT) {
-        region_spec << " ~";
-      } else if (token == OP_INTERSECTION) {
-      } else if (token == OP_UNION) {
-        region_spec << " |";
-      } else {
-        // Note the off-by-one indexing
-        auto surf_id = model::surfaces[abs(token) - 1]->id_;
-        region_spec << " " << ((token > 0) ? surf_id : -surf_id);
-      }
-    }
-    write_string(group_id, "region", region_spec.str(), false);
+    write_string(group_id, "region", region_spec(), false);
   }
 }
 
@@ -742,7 +947,8 @@ BoundingBox CSGCell::bounding_box() const
 
 //==============================================================================
 
-bool CSGCell::contains_simple(Position r, Direction u, int32_t on_surface) const
+bool CSGCell::contains_simple(Position r, Direction u, int32_t on_surface,
+  SurfaceSenseCache* cache) const
 {
   for (int32_t token : rpn_) {
     // Assume that no tokens are operators. Evaluate the sense of particle with
@@ -754,7 +960,7 @@ bool CSGCell::contains_simple(Position r, Direction u, int32_t on_surface) const
       return false;
     } else {
       // Note the off-by-one indexing
-      bool sense = model::surfaces[abs(token) - 1]->sense(r, u);
+      bool sense = surface_sense(abs(token) - 1, r, u, cache);
       if (sense != (token > 0)) {
         return false;
       }
@@ -765,52 +971,110 @@ bool CSGCell::contains_simple(Position r, Direction u, int32_t on_surface) const
 
 //==============================================================================
 
-bool CSGCell::contains_complex(
-  Position r, Direction u, int32_t on_surface) const
+bool CSGCell::contains_complex(Position r, Direction u, int32_t on_surface,
+  SurfaceSenseCache* cache) const
 {
-  // Make a stack of booleans.  We don't know how big it needs to be, but we do
-  // know that rpn.size() is an upper-bound.
-  vector<bool> stack(rpn_.size());
-  int i_stack = -1;
+  // There is no region specification, so the cell is everywhere
+  if (region_code_.empty())
+    return true;
+
+  int32_t i = 0;
+  while (i >= 0) {
+    // Evaluate the sense of particle with respect to the surface and see if
+    // the token matches the sense. If the particle's surface attribute is set
+    // and matches the token, that overrides the determination based on
+    // sense().
+    const auto& op {region_code_[i]};
+    bool match;
+    if (op.token == on_surface) {
+      match = true;
+    } else if (-op.token == on_surface) {
+      match = false;
+    } else {
+      // Note the off-by-one indexing
+      bool sense = surface_sense(abs(op.token) - 1, r, u, cache);
+      match = (sense == (op.token > 0));
+    }
+    i = match ? op.next_true : op.next_false;
+  }
+  return i == REGION_INSIDE;
+}
 
+//==============================================================================
+
+void CSGCell::compile_region()
+{
+  // Build an expression tree from the RPN.  Each node comes after its
+  // children, and complements are recorded as a flag on the node they apply
+  // to.
+  struct Node {
+    int32_t token;
+    int left;
+    int right;
+    bool complement;
+  };
+  vector<Node> nodes;
+  vector<int> stack;
   for (int32_t token : rpn_) {
-    // If the token is a binary operator (intersection/union), apply it to
-    // the last two items on the stack. If the token is a unary operator
-    // (complement), apply it to the last item on the stack.
-    if (token == OP_UNION) {
-      stack[i_stack - 1] = stack[i_stack - 1] || stack[i_stack];
-      i_stack--;
-    } else if (token == OP_INTERSECTION) {
-      stack[i_stack - 1] = stack[i_stack - 1] && stack[i_stack];
-      i_stack--;
+    if (token == OP_UNION || token == OP_INTERSECTION) {
+      int right = stack.back();
+      stack.pop_back();
+      nodes.push_back({token, stack.back(), right, false});
+      stack.back() = nodes.size() - 1;
     } else if (token == OP_COMPLEMENT) {
-      stack[i_stack] = !stack[i_stack];
+      nodes[stack.back()].complement = !nodes[stack.back()].complement;
     } else {
-      // If the token is not an operator, evaluate the sense of particle with
-      // respect to the surface and see if the token matches the sense. If the
-      // particle's surface attribute is set and matches the token, that
-      // overrides the determination based on sense().
-      i_stack++;
-      if (token == on_surface) {
-        stack[i_stack] = true;
-      } else if (-token == on_surface) {
-        stack[i_stack] = false;
-      } else {
-        // Note the off-by-one indexing
-        bool sense = model::surfaces[abs(token) - 1]->sense(r, u);
-        stack[i_stack] = (sense == (token > 0));
-      }
+      nodes.push_back({token, -1, -1, false});
+      stack.push_back(nodes.size() - 1);
     }
   }
+  if (stack.size() != 1)
+    return;
+
+  // Count the surface tokens under each node, which is the number of steps
+  // the node compiles to
+  vector<int> n_steps(nodes.size());
+  for (int i = 0; i < nodes.size(); ++i) {
+    const auto& n {nodes[i]};
+    n_steps[i] = (n.left < 0) ? 1 : n_steps[n.left] + n_steps[n.right];
+  }
+
+  // Lay out the steps of each node in order, starting from the root.  The
+  // right operand of a node starts right after the steps of its left operand.
+  struct Item {
+    int node;
+    int32_t start;
+    bool complement;
+    int32_t next_true;
+    int32_t next_false;
+  };
+  region_code_.resize(n_steps[stack[0]]);
+  vector<Item> items {
+    {stack[0], 0, nodes[stack[0]].complement, REGION_INSIDE, REGION_OUTSIDE}};
+  while (!items.empty()) {
+    Item item = items.back();
+    items.pop_back();
+    const auto& n {nodes[item.node]};
+    if (n.left < 0) {
+      int32_t token = item.complement ? -n.token : n.token;
+      region_code_[item.start] = {token, item.next_true, item.next_false};
+      continue;
+    }
 
-  if (i_stack == 0) {
-    // The one remaining bool on the stack indicates whether the particle is
-    // in the cell.
-    return stack[i_stack];
-  } else {
-    // This case occurs if there is no region specification since i_stack will
-    // still be -1.
-    return true;
+    // Apply De Morgan's laws to a complemented intersection or union
+    bool is_union = (n.token == OP_UNION) != item.complement;
+    int32_t right_start = item.start + n_steps[n.left];
+    Item left {n.left, item.start, item.complement != nodes[n.left].complement,
+      item.next_true, item.next_false};
+    if (is_union) {
+      left.next_false = right_start;
+    } else {
+      left.next_true = right_start;
+    }
+    items.push_back(left);
+    items.push_back({n.right, right_start,
+      item.complement != nodes[n.right].complement, item.next_true,
+      item.next_false});
   }
 }
 
@@ -820,16 +1084,33 @@ bool CSGCell::contains_complex(
 
 void read_cells(pugi::xml_node node)
 {
-  // Count the number of cells.
-  int n_cells = 0;
+  // Collect the XML cell elements
+  vector<pugi::xml_node> cell_nodes;
   for (pugi::xml_node cell_node : node.children("cell")) {
-    n_cells++;
+    cell_nodes.push_back(cell_node);
+  }
+
+  // Build the cells in parallel, since constructing them only reads the XML
+  // document and the surfaces. If any cells are invalid, the error for the
+  // first of them is reported.
+  auto n_existing = model::cells.size();
+  model::cells.resize(n_existing + cell_nodes.size());
+  int i_error = cell_nodes.size();
+  std::string error;
+#pragma omp parallel for schedule(dynamic, 64)
+  for (int i = 0; i < cell_nodes.size(); i++) {
+    try {
+      model::cells[n_existing + i] = make_unique<CSGCell>(cell_nodes[i]);
+    } catch (const std::exception& e) {
+#pragma omp critical(ReadCells)
+      if (i < i_error) {
+        i_error = i;
+        error = e.what();
+      }
+    }
   }
-
-  // Loop over XML cell elements and populate the array.
-  model::cells.reserve(n_cells);
-  for (pugi::xml_node cell_node : node.children("cell")) {
-    model::cells.push_back(make_unique<CSGCell>(cell_node));
+  if (i_error < cell_nodes.size()) {
+    throw std::runtime_error {error};
   }
 
   // Fill the cell map.
@@ -850,7 +1131,7 @@ void read_cells(pugi::xml_node node)
 
   // Allocate the cell overlap count if necessary.
   if (settings::check_overlaps) {
-    model::overlap_check_count.resize(model::cells.size(), 0);
+    init_overlap_check_count();
   }
 
   if (model::cells.size() == 0) {
@@ -951,6 +1232,86 @@ extern "C" int openmc_cell_set_temperature(
   return 0;
 }
 
+extern "C" int openmc_cells_set_temperatures(
+  int n, const int32_t* index, const int32_t* instance, const double* T)
+{
+  // Check all cells and temperatures before changing any of them
+  double T_min = INFTY;
+  double T_max = -INFTY;
+  for (int i = 0; i < n; ++i) {
+    if (index[i] < 0 || index[i] >= model::cells.size()) {
+      set_errmsg("Index in cells array is out of bounds.");
+      return OPENMC_E_OUT_OF_BOUNDS;
+    }
+    const auto& c {*model::cells[index[i]]};
+    if (c.type_ != Fill::MATERIAL) {
+      set_errmsg(fmt::format("Attempted to set the temperature of cell {} "
+                             "which is not filled by a material.",
+        c.id_));
+      return OPENMC_E_INVALID_TYPE;
+    }
+    if (instance[i] < -1 || instance[i] >= c.n_instances_) {
+      set_errmsg(fmt::format(
+        "Instance {} of cell {} is out of bounds.", instance[i], c.id_));
+      return OPENMC_E_OUT_OF_BOUNDS;
+    }
+    T_min = std::min(T_min, T[i]);
+    T_max = std::max(T_max, T[i]);
+  }
+  if (n > 0 &&
+      settings::temperature_method == TemperatureMethod::INTERPOLATION) {
+    if (T_min < data::temperature_min) {
+      set_errmsg("Temperature is below minimum temperature at which data is "
+                 "available.");
+      return OPENMC_E_INVALID_ARGUMENT;
+    } else if (T_max > data::temperature_max) {
+      set_errmsg("Temperature is above maximum temperature at which data is "
+                 "available.");
+      return OPENMC_E_INVALID_ARGUMENT;
+    }
+  }
+
+  // Give every cell that has an instance set one temperature per instance
+  for (int i = 0; i < n; ++i) {
+    auto& c {*model::cells[index[i]]};
+    if (instance[i] >= 0 && c.sqrtkT_.size() != c.n_instances_)
+      c.sqrtkT_.resize(c.n_instances_, c.sqrtkT_[0]);
+    if (c.i_sqrtkT_.size() != c.sqrtkT_.size())
+      c.update_temperature_indices();
+  }
+
+#pragma omp parallel for
+  for (int i = 0; i < n; ++i) {
+    auto& c {*model::cells[index[i]]};
+    double sqrtkT = std::sqrt(K_BOLTZMANN * T[i]);
+    if (instance[i] >= 0) {
+      c.sqrtkT_[instance[i]] = sqrtkT;
+    } else {
+      std::fill(c.sqrtkT_.begin(), c.sqrtkT_.end(), sqrtkT);
+    }
+  }
+
+  // Look up the index of each temperature. Nuclides extend their cached
+  // temperature indices once for all temperatures not seen before.
+  for (int i = 0; i < n; ++i) {
+    auto& c {*model::cells[index[i]]};
+    if (instance[i] >= 0) {
+      c.i_sqrtkT_[instance[i]] =
+        cell_temperature_index(c.sqrtkT_[instance[i]], false);
+    } else {
+      std::fill(c.i_sqrtkT_.begin(), c.i_sqrtkT_.end(),
+        cell_temperature_index(c.sqrtkT_[0], false));
+    }
+  }
+  for (auto& nuc : data::nuclides) {
+    nuc->update_cell_temperatures();
+  }
+  for (auto& sab : data::thermal_scatt) {
+    sab->update_cell_temperatures();
+  }
+  return 0;
+}
+
 extern "C" int openmc_cell_get_temperature(
   int32_t index, const int32_t* instance, double* T)
 {
@@ -1431,6 +1792,68 @@ extern "C" int openmc_cell_set_rotation(
   }
 }
 
+namespace {
+
+//! Check that the cells of a bulk translation or rotation can be moved
+int check_movable_cells(int n, const int32_t* index, const char* what)
+{
+  for (int i = 0; i < n; ++i) {
+    if (index[i] < 0 || index[i] >= model::cells.size()) {
+      set_errmsg("Index in cells array is out of bounds.");
+      return OPENMC_E_OUT_OF_BOUNDS;
+    }
+    const auto& c {*model::cells[index[i]]};
+    if (c.fill_ == C_NONE) {
+      set_errmsg(fmt::format("Cannot apply a {} to cell {}"
+                             " because it is not filled with another universe",
+        what, c.id_));
+      return OPENMC_E_GEOMETRY;
+    }
+  }
+  return 0;
+}
+
+} // namespace
+
+// Moving a fill cell only changes the transformation applied when entering its
+// fill. Neighbor lists, universe partitioners, and bounding boxes are all built
+// in the local coordinates of a universe, so none of them need to be rebuilt.
+
+//! Set the translation vectors of many cells at once
+extern "C" int openmc_cells_set_translations(
+  int n, const int32_t* index, const double* xyz)
+{
+  int err = check_movable_cells(n, index, "translation");
+  if (err)
+    return err;
+
+#pragma omp parallel for
+  for (int i = 0; i < n; ++i) {
+    model::cells[index[i]]->translation_ = Position(xyz + 3 * i);
+  }
+  return 0;
+}
+
+//! Set the flattened rotation matrices of many cells at once
+extern "C" int openmc_cells_set_rotations(
+  int n, const int32_t* index, const double* rot, size_t rot_len)
+{
+  int err = check_movable_cells(n, index, "rotation");
+  if (err)
+    return err;
+  if (rot_len != 3 && rot_len != 9) {
+    set_errmsg("Rotations must be given as 3 angles or a 3x3 matrix.");
+    return OPENMC_E_INVALID_ARGUMENT;
+  }
+
+#pragma omp parallel for
+  for (int i = 0; i < n; ++i) {
+    vector<double> vec_rot(rot + rot_len * i, rot + rot_len * (i + 1));
+    model::cells[index[i]]->set_rotation(vec_rot);
+  }
+  return 0;
+}
+
 //! Get the number of instances of the requested cell
 extern "C" int openmc_cell_get_num_instances(
   int32_t index, int32_t* num_instances)
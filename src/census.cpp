@@ -0,0 +1,119 @@
+#include "openmc/census.h"
+
+#include <algorithm> // for sort
+#include <cmath>     // for INFINITY
+
+#include "openmc/error.h"
+#include "openmc/message_passing.h"
+#include "openmc/random_lcg.h"
+#include "openmc/settings.h"
+#include "openmc/simulation.h"
+
+namespace openmc {
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace simulation {
+
+int current_census {0};
+SharedArray<SourceSite> census_bank;
+vector<SourceSite> census_source;
+
+} // namespace simulation
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+double census_time()
+{
+  if (simulation::current_census < settings::census_times.size()) {
+    return settings::census_times[simulation::current_census];
+  }
+  return INFINITY;
+}
+
+int64_t census_generation()
+{
+  int64_t n_windows = settings::census_times.size() + 1;
+  return (simulation::total_gen + overall_generation() - 1) * n_windows +
+         simulation::current_census;
+}
+
+void init_census_bank()
+{
+  simulation::census_bank.reserve(3 * simulation::work_per_rank);
+}
+
+void bank_census_particle(Particle& p)
+{
+  SourceSite site;
+  site.r = p.r();
+  site.u = p.u();
+  site.E = settings::run_CE ? p.E() : static_cast<double>(p.g());
+  site.time = p.time();
+  site.wgt = p.wgt();
+  site.particle = p.type();
+  site.parent_id = p.id();
+  site.progeny_id = p.n_progeny()++;
+
+  if (simulation::census_bank.thread_safe_append(site) == -1) {
+    warning("The census bank is full. Particles reaching the census time are "
+            "lost, which biases later time windows.");
+  }
+
+  // The history continues in the next time window
+  p.wgt() = 0.0;
+}
+
+void comb_census_bank()
+{
+  auto& bank = simulation::census_bank;
+  auto& source = simulation::census_source;
+  source.clear();
+  int64_t n = bank.size();
+  if (n == 0)
+    return;
+
+  // Order the sites independently of the thread that banked them
+  std::sort(bank.data(), bank.data() + n,
+    [](const SourceSite& a, const SourceSite& b) {
+      return a.parent_id < b.parent_id ||
+             (a.parent_id == b.parent_id && a.progeny_id < b.progeny_id);
+    });
+
+  double total = 0.0;
+  for (int64_t i = 0; i < n; ++i) {
+    total += bank[i].wgt;
+  }
+
+  // Place evenly spaced teeth with a random offset along the cumulative
+  // weight of the sites, and start one particle for each tooth that falls on
+  // a site
+  size_t n_comb = std::max<int64_t>(simulation::work_per_rank, 1);
+  double wgt = total / n_comb;
+  uint64_t seed = init_seed(
+    census_generation() * mpi::n_procs + mpi::rank, STREAM_SOURCE);
+  double tooth = prn(&seed) * wgt;
+  double cumulative = 0.0;
+  source.reserve(n_comb);
+  for (int64_t i = 0; i < n; ++i) {
+    cumulative += bank[i].wgt;
+    while (tooth < cumulative && source.size() < n_comb) {
+      source.push_back(bank[i]);
+      source.back().wgt = wgt;
+      tooth += wgt;
+    }
+  }
+  bank.resize(0);
+}
+
+void free_memory_census()
+{
+  simulation::census_bank.clear();
+  simulation::census_source.clear();
+}
+
+} // namespace openmc
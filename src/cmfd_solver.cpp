@@ -10,6 +10,7 @@
 #include "openmc/bank.h"
 #include "openmc/capi.h"
 #include "openmc/constants.h"
+#include "openmc/eigenvalue.h"
 #include "openmc/error.h"
 #include "openmc/mesh.h"
 #include "openmc/message_passing.h"
@@ -40,6 +41,10 @@ xt::xtensor<int, 2> indexmap;
 
 int use_all_threads;
 
+int linsolver;
+
+vector<double> diag_inv;
+
 StructuredMesh* mesh;
 
 vector<double> egrid;
@@ -90,27 +95,56 @@ xt::xtensor<double, 1> count_bank_sites(
   xt::xarray<double> cnt {cnt_shape, 0.0};
   bool outside_ = false;
 
+  // Each thread counts sites in its own array. The arrays are summed in order
+  // of thread afterwards so that the counts do not depend on timing.
+#ifdef _OPENMP
+  int n_threads = omp_get_max_threads();
+#else
+  int n_threads = 1;
+#endif
+  vector<vector<double>> cnt_thread(n_threads);
+
   auto bank_size = simulation::source_bank.size();
-  for (int i = 0; i < bank_size; i++) {
-    const auto& site = simulation::source_bank[i];
+#pragma omp parallel
+  {
+#ifdef _OPENMP
+    auto& cnt_local = cnt_thread[omp_get_thread_num()];
+#else
+    auto& cnt_local = cnt_thread[0];
+#endif
+    cnt_local.resize(cnt_size, 0.0);
 
-    // determine scoring bin for CMFD mesh
-    int mesh_bin = cmfd::mesh->get_bin(site.r);
+#pragma omp for schedule(static) reduction(|| : outside_)
+    for (int64_t i = 0; i < bank_size; i++) {
+      const auto& site = simulation::source_bank[i];
 
-    // if outside mesh, skip particle
-    if (mesh_bin < 0) {
-      outside_ = true;
-      continue;
-    }
+      // determine scoring bin for CMFD mesh
+      int mesh_bin = cmfd::mesh->get_bin(site.r);
+
+      // if outside mesh, skip particle
+      if (mesh_bin < 0) {
+        outside_ = true;
+        continue;
+      }
 
-    // determine scoring bin for CMFD energy
-    int energy_bin = get_cmfd_energy_bin(site.E);
+      // determine scoring bin for CMFD energy
+      int energy_bin = get_cmfd_energy_bin(site.E);
 
-    // add to appropriate bin
-    cnt(mesh_bin * cmfd::ng + energy_bin) += site.wgt;
+      // add to appropriate bin
+      cnt_local[mesh_bin * cmfd::ng + energy_bin] += site.wgt;
 
-    // store bin index which is used again when updating weights
-    bins[i] = mesh_bin * cmfd::ng + energy_bin;
+      // store bin index which is used again when updating weights
+      bins[i] = mesh_bin * cmfd::ng + energy_bin;
+    }
+  }
+
+  // Sum the counts from each thread
+#pragma omp parallel for
+  for (std::size_t j = 0; j < cnt_size; j++) {
+    for (const auto& cnt_local : cnt_thread) {
+      if (!cnt_local.empty())
+        cnt(j) += cnt_local[j];
+    }
   }
 
   // Create copy of count data. Since ownership will be acquired by xtensor,
@@ -146,6 +180,9 @@ xt::xtensor<double, 1> count_bank_sites(
 extern "C" void openmc_cmfd_reweight(
   const bool feedback, const double* cmfd_src)
 {
+  // Make sure the whole source bank has arrived
+  finish_bank_exchange();
+
   // Get size of source bank and cmfd_src
   auto bank_size = simulation::source_bank.size();
   std::size_t src_size = cmfd::nx * cmfd::ny * cmfd::nz * cmfd::ng;
@@ -180,6 +217,7 @@ extern "C" void openmc_cmfd_reweight(
 #endif
 
   // Iterate through fission bank and update particle weights
+#pragma omp parallel for
   for (int64_t i = 0; i < bank_size; i++) {
     auto& site = simulation::source_bank[i];
     site.wgt *= weightfactors(bank_bins(i));
@@ -465,27 +503,45 @@ int cmfd_linsolver_ng(
     // Copy over x vector
     vector<double> tmpx {x, x + cmfd::dim};
 
-    // Loop around matrix rows
-    for (int irow = 0; irow < cmfd::dim; irow++) {
-      // Get index of diagonal for current row
-      int didx = get_diagonal_index(irow);
+    // Perform red/black Gauss-Seidel iterations over cells. Cells of one color
+    // only couple to cells of the other, so they can be swept in parallel,
+    // while the groups within a cell are swept in order.
+    for (int irb = 0; irb < 2; irb++) {
+
+// Loop around cells
+#pragma omp parallel for reduction(+ : err) if (cmfd::use_all_threads)
+      for (int icell = 0; icell < cmfd::dim / cmfd::ng; icell++) {
+        int g, i, j, k;
+        matrix_to_indices(icell * cmfd::ng, g, i, j, k);
 
-      // Perform temporary sums, first do left of diag, then right of diag
-      double tmp1 = 0.0;
-      for (int icol = cmfd::indptr[irow]; icol < didx; icol++)
-        tmp1 += A_data[icol] * x[cmfd::indices[icol]];
-      for (int icol = didx + 1; icol < cmfd::indptr[irow + 1]; icol++)
-        tmp1 += A_data[icol] * x[cmfd::indices[icol]];
+        // Filter out black cells
+        if ((i + j + k) % 2 != irb)
+          continue;
+
+        // Loop around the rows of each group in the cell
+        for (int irow = icell * cmfd::ng; irow < (icell + 1) * cmfd::ng;
+             irow++) {
+          // Get index of diagonal for current row
+          int didx = get_diagonal_index(irow);
 
-      // Solve for new x
-      double x1 = (b[irow] - tmp1) / A_data[didx];
+          // Perform temporary sums, first do left of diag, then right of diag
+          double tmp1 = 0.0;
+          for (int icol = cmfd::indptr[irow]; icol < didx; icol++)
+            tmp1 += A_data[icol] * x[cmfd::indices[icol]];
+          for (int icol = didx + 1; icol < cmfd::indptr[irow + 1]; icol++)
+            tmp1 += A_data[icol] * x[cmfd::indices[icol]];
 
-      // Perform overrelaxation
-      x[irow] = (1.0 - w) * x[irow] + w * x1;
+          // Solve for new x
+          double x1 = (b[irow] - tmp1) / A_data[didx];
 
-      // Compute residual and update error
-      double res = (tmpx[irow] - x[irow]) / tmpx[irow];
-      err += res * res;
+          // Perform overrelaxation
+          x[irow] = (1.0 - w) * x[irow] + w * x1;
+
+          // Compute residual and update error
+          double res = (tmpx[irow] - x[irow]) / tmpx[irow];
+          err += res * res;
+        }
+      }
     }
 
     // Check convergence
@@ -504,6 +560,136 @@ int cmfd_linsolver_ng(
   return -1;
 }
 
+//==============================================================================
+// CMFD_MATVEC multiplies the CMFD matrix by a vector
+//==============================================================================
+
+void cmfd_matvec(const double* A_data, const double* x, double* y)
+{
+#pragma omp parallel for if (cmfd::use_all_threads)
+  for (int irow = 0; irow < cmfd::dim; irow++) {
+    double sum = 0.0;
+    for (int icol = cmfd::indptr[irow]; icol < cmfd::indptr[irow + 1]; icol++)
+      sum += A_data[icol] * x[cmfd::indices[icol]];
+    y[irow] = sum;
+  }
+}
+
+//==============================================================================
+// CMFD_DOT returns the inner product of two vectors of the CMFD dimension
+//==============================================================================
+
+double cmfd_dot(const double* x, const double* y)
+{
+  double sum = 0.0;
+#pragma omp parallel for reduction(+ : sum) if (cmfd::use_all_threads)
+  for (int irow = 0; irow < cmfd::dim; irow++)
+    sum += x[irow] * y[irow];
+  return sum;
+}
+
+//==============================================================================
+// CMFD_PRECONDITION applies the Jacobi preconditioner to a vector
+//==============================================================================
+
+void cmfd_precondition(const double* x, double* y)
+{
+#pragma omp parallel for if (cmfd::use_all_threads)
+  for (int irow = 0; irow < cmfd::dim; irow++)
+    y[irow] = cmfd::diag_inv[irow] * x[irow];
+}
+
+//==============================================================================
+// CMFD_LINSOLVER_BICGSTAB solves a CMFD linear system for any number of groups
+// with the Jacobi-preconditioned biconjugate gradient stabilized method
+//==============================================================================
+
+int cmfd_linsolver_bicgstab(
+  const double* A_data, const double* b, double* x, double tol)
+{
+  int n = cmfd::dim;
+
+  // The matrix changes between calls, so the preconditioner is rebuilt
+  cmfd::diag_inv.resize(n);
+#pragma omp parallel for if (cmfd::use_all_threads)
+  for (int irow = 0; irow < n; irow++)
+    cmfd::diag_inv[irow] = 1.0 / A_data[get_diagonal_index(irow)];
+
+  // Compute the initial residual, which is also the shadow residual
+  vector<double> r(n);
+  cmfd_matvec(A_data, x, r.data());
+  for (int irow = 0; irow < n; irow++)
+    r[irow] = b[irow] - r[irow];
+  vector<double> r0 {r};
+
+  // Converge the residual relative to the right-hand side
+  double b_norm = std::sqrt(cmfd_dot(b, b));
+  if (b_norm == 0.0)
+    b_norm = 1.0;
+  if (std::sqrt(cmfd_dot(r.data(), r.data())) < tol * b_norm)
+    return 0;
+
+  vector<double> p(n, 0.0);
+  vector<double> v(n, 0.0);
+  vector<double> s(n);
+  vector<double> t(n);
+  vector<double> y(n);
+  vector<double> z(n);
+  double rho = 1.0;
+  double alpha = 1.0;
+  double omega = 1.0;
+
+  for (int it = 1; it <= 10000; it++) {
+    double rho_new = cmfd_dot(r0.data(), r.data());
+    if (rho_new == 0.0 || omega == 0.0)
+      fatal_error("BiCGSTAB solver for CMFD broke down.");
+
+    // Update the search direction
+    double beta = (rho_new / rho) * (alpha / omega);
+#pragma omp parallel for if (cmfd::use_all_threads)
+    for (int irow = 0; irow < n; irow++)
+      p[irow] = r[irow] + beta * (p[irow] - omega * v[irow]);
+    cmfd_precondition(p.data(), y.data());
+    cmfd_matvec(A_data, y.data(), v.data());
+    alpha = rho_new / cmfd_dot(r0.data(), v.data());
+
+#pragma omp parallel for if (cmfd::use_all_threads)
+    for (int irow = 0; irow < n; irow++)
+      s[irow] = r[irow] - alpha * v[irow];
+
+    // Stop early if the half step has converged
+    if (std::sqrt(cmfd_dot(s.data(), s.data())) < tol * b_norm) {
+#pragma omp parallel for if (cmfd::use_all_threads)
+      for (int irow = 0; irow < n; irow++)
+        x[irow] += alpha * y[irow];
+      return it;
+    }
+
+    // Stabilize with a minimum residual step
+    cmfd_precondition(s.data(), z.data());
+    cmfd_matvec(A_data, z.data(), t.data());
+    omega = cmfd_dot(t.data(), s.data()) / cmfd_dot(t.data(), t.data());
+
+#pragma omp parallel for if (cmfd::use_all_threads)
+    for (int irow = 0; irow < n; irow++) {
+      x[irow] += alpha * y[irow] + omega * z[irow];
+      r[irow] = s[irow] - omega * t[irow];
+    }
+
+    // Check convergence
+    if (std::sqrt(cmfd_dot(r.data(), r.data())) < tol * b_norm)
+      return it;
+
+    rho = rho_new;
+  }
+
+  // Throw error, as max iterations met
+  fatal_error("Maximum BiCGSTAB iterations encountered.");
+
+  // Return -1 by default, although error thrown before reaching this point
+  return -1;
+}
+
 //==============================================================================
 // OPENMC_INITIALIZE_LINSOLVER sets the fixed variables that are used for the
 // linear solver
@@ -511,7 +697,7 @@ int cmfd_linsolver_ng(
 
 extern "C" void openmc_initialize_linsolver(const int* indptr, int len_indptr,
   const int* indices, int n_elements, int dim, double spectral, const int* map,
-  bool use_all_threads)
+  bool use_all_threads, int linsolver)
 {
   // Store elements of indptr
   for (int i = 0; i < len_indptr; i++)
@@ -525,25 +711,29 @@ extern "C" void openmc_initialize_linsolver(const int* indptr, int len_indptr,
   cmfd::dim = dim;
   cmfd::spectral = spectral;
 
-  // Set indexmap if 1 or 2 group problem
-  if (cmfd::ng == 1 || cmfd::ng == 2) {
-    // Resize indexmap and set its elements
-    cmfd::indexmap.resize({static_cast<size_t>(dim), 3});
-    set_indexmap(map);
-  }
+  // Set indexmap, which gives the color of each cell for red/black
+  // Gauss-Seidel iterations
+  cmfd::indexmap.resize({static_cast<size_t>(dim), 3});
+  set_indexmap(map);
 
   // Use all threads allocated to OpenMC simulation to run CMFD solver
   cmfd::use_all_threads = use_all_threads;
+
+  // Set the linear solver
+  cmfd::linsolver = linsolver;
 }
 
 //==============================================================================
-// OPENMC_RUN_LINSOLVER runs a Gauss Seidel linear solver to solve CMFD matrix
-// equations
+// OPENMC_RUN_LINSOLVER runs a Gauss Seidel or BiCGSTAB linear solver to
+// solve CMFD matrix equations
 //==============================================================================
 
 extern "C" int openmc_run_linsolver(
   const double* A_data, const double* b, double* x, double tol)
 {
+  if (cmfd::linsolver == CMFD_SOLVER_BICGSTAB)
+    return cmfd_linsolver_bicgstab(A_data, b, x, tol);
+
   switch (cmfd::ng) {
   case 1:
     return cmfd_linsolver_1g(A_data, b, x, tol);
@@ -560,6 +750,7 @@ void free_memory_cmfd()
   cmfd::indptr.clear();
   cmfd::indices.clear();
   cmfd::egrid.clear();
+  cmfd::diag_inv.clear();
 
   // Resize xtensors to be empty
   cmfd::indexmap.resize({0});
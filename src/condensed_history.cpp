@@ -0,0 +1,220 @@
+#include "openmc/condensed_history.h"
+
+#include <algorithm> // for max, min
+#include <cmath>     // for cos, exp, log, sqrt
+
+#include "openmc/bremsstrahlung.h"
+#include "openmc/constants.h"
+#include "openmc/distribution_multi.h"
+#include "openmc/material.h"
+#include "openmc/math_functions.h"
+#include "openmc/random_lcg.h"
+#include "openmc/search.h"
+#include "openmc/settings.h"
+
+namespace openmc {
+
+namespace {
+
+//==============================================================================
+// Helper functions
+//==============================================================================
+
+//! Slowing down data for the material a charged particle is in
+const BremsstrahlungData& charged_data(const Particle& p)
+{
+  const auto& ttb = model::materials[p.material()]->ttb_;
+  return (p.type() == ParticleType::positron) ? ttb->positron : ttb->electron;
+}
+
+//! Index of the interval of the incident energy grid containing a log energy
+int energy_index(double e)
+{
+  int n_e = data::ttb_e_grid.size();
+  int j =
+    lower_bound_index(data::ttb_e_grid.cbegin(), data::ttb_e_grid.cend(), e);
+  return std::min(j, n_e - 2);
+}
+
+//! Continuous slowing down range interpolated linearly in log energy
+double csda_range(const BremsstrahlungData& data, double e)
+{
+  if (e <= data::ttb_e_grid(0))
+    return 0.0;
+  int j = energy_index(e);
+  double e_l = data::ttb_e_grid(j);
+  double e_r = data::ttb_e_grid(j + 1);
+  return data.range(j) +
+         (e - e_l) / (e_r - e_l) * (data.range(j + 1) - data.range(j));
+}
+
+//! Energy at which the continuous slowing down range is equal to a distance,
+//! which is the inverse of csda_range()
+double csda_energy(const BremsstrahlungData& data, double range)
+{
+  if (range <= 0.0)
+    return std::exp(data::ttb_e_grid(0));
+  int n_e = data.range.size();
+  int j = std::min<int>(
+    lower_bound_index(data.range.cbegin(), data.range.cend(), range), n_e - 2);
+  double r_l = data.range(j);
+  double r_r = data.range(j + 1);
+  double e_l = data::ttb_e_grid(j);
+  double e_r = data::ttb_e_grid(j + 1);
+  return std::exp(e_l + (range - r_l) / (r_r - r_l) * (e_r - e_l));
+}
+
+//! Number of bremsstrahlung photons emitted while slowing down from an energy,
+//! interpolated on a log-log scale as in thick_target_bremsstrahlung()
+double photon_yield(const BremsstrahlungData& data, double E)
+{
+  double e = std::log(E);
+  if (e <= data::ttb_e_grid(0))
+    return 0.0;
+  int j = energy_index(e);
+  double e_l = data::ttb_e_grid(j);
+  double e_r = data::ttb_e_grid(j + 1);
+  double f = (e - e_l) / (e_r - e_l);
+  return std::exp(data.yield(j) + (data.yield(j + 1) - data.yield(j)) * f);
+}
+
+//! Energy at which a charged particle is stopped, below which its remaining
+//! energy is deposited locally
+double stop_energy(const Particle& p)
+{
+  int type = static_cast<int>(p.type());
+  return std::max(settings::energy_cutoff[type], std::exp(data::ttb_e_grid(0)));
+}
+
+//! Sample the energy of a bremsstrahlung photon emitted by a charged particle
+//! from the DCS at its incident energy, interpolated in log energy by choosing
+//! one of the bounding tabulated energies
+double sample_photon_energy(
+  const BremsstrahlungData& data, double E, uint64_t* seed)
+{
+  double e = std::log(E);
+  int j = energy_index(e);
+  double e_l = data::ttb_e_grid(j);
+  double e_r = data::ttb_e_grid(j + 1);
+  double f = (e - e_l) / (e_r - e_l);
+  int i_e = (prn(seed) <= f || j == 0) ? j + 1 : j;
+
+  // Sample the reduced photon energy from 1/k between the lowest photon energy
+  // in the data and the particle energy and accept it with the probability of
+  // the scaled DCS relative to its maximum
+  const auto& k_grid = data::ttb_k_grid;
+  int n_k = k_grid.size();
+  double log_k_min = std::log(std::max(k_grid(0), std::exp(e_l) / E));
+  while (true) {
+    double k = std::exp(log_k_min * (1.0 - prn(seed)));
+    int i_k =
+      std::min<int>(lower_bound_index(k_grid.cbegin(), k_grid.cend(), k),
+        n_k - 2);
+    double x_l = data.dcs(i_e, i_k);
+    double x_r = data.dcs(i_e, i_k + 1);
+    double x =
+      x_l + (k - k_grid(i_k)) * (x_r - x_l) / (k_grid(i_k + 1) - k_grid(i_k));
+    if (prn(seed) <= x)
+      return k * E;
+  }
+}
+
+} // namespace
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+double condensed_history_step(const Particle& p)
+{
+  if (p.material() == MATERIAL_VOID)
+    return INFINITY;
+
+  const auto& data = charged_data(p);
+  double range = csda_range(data, std::log(p.E()));
+  double range_stop = csda_range(data, std::log(stop_energy(p)));
+  double distance = settings::electron_step_fraction * range;
+
+  // The range is not resolved below the first interval of the energy grid, so
+  // a particle close to the end of its range travels the rest of it at once
+  if (range - distance <= std::max(range_stop, data.range(1)))
+    distance = range - range_stop;
+  return std::max(distance, 0.0);
+}
+
+void continuous_slowing_down(Particle& p, double distance)
+{
+  if (p.material() == MATERIAL_VOID)
+    return;
+
+  const auto& data = charged_data(p);
+  double E_stop = stop_energy(p);
+  double range = csda_range(data, std::log(p.E())) - distance;
+  if (range <= csda_range(data, std::log(E_stop))) {
+    p.E() = std::min(p.E(), E_stop);
+  } else {
+    p.E() = std::min(p.E(), csda_energy(data, range));
+  }
+}
+
+void condensed_history_collision(Particle& p)
+{
+  const auto& data = charged_data(p);
+  double E_last = p.E_last();
+  double E = p.E();
+
+  // Create the bremsstrahlung photons emitted while slowing down, whose mean
+  // number is the difference of the thick-target photon yields. The energy
+  // they carry away is already part of the total stopping power.
+  int photon = static_cast<int>(ParticleType::photon);
+  if (E_last > E && E_last > settings::energy_cutoff[photon]) {
+    int n = photon_yield(data, E_last) - photon_yield(data, E) +
+            prn(p.current_seed());
+    for (int i = 0; i < n; ++i) {
+      double w = sample_photon_energy(data, E_last, p.current_seed());
+      if (w > settings::energy_cutoff[photon]) {
+        p.create_secondary(p.wgt(), p.u(), w, ParticleType::photon);
+      }
+    }
+  }
+
+  // Absorb the particle at the end of its range
+  if (E <= stop_energy(p)) {
+    if (p.type() == ParticleType::positron) {
+      // Create annihilation photon pair traveling in opposite directions
+      Direction u = isotropic_direction(p.current_seed());
+      p.create_secondary(p.wgt(), u, MASS_ELECTRON_EV, ParticleType::photon);
+      p.create_secondary(p.wgt(), -u, MASS_ELECTRON_EV, ParticleType::photon);
+    }
+
+    p.E() = 0.0;
+    p.wgt() = 0.0;
+    p.event() = TallyEvent::ABSORB;
+    return;
+  }
+
+  // Deflect the particle by the Highland approximation to the width of the
+  // multiple scattering angle distribution at the mean energy of the path.
+  // Source: G. R. Lynch and O. I. Dahl, "Approximations to multiple Coulomb
+  // scattering," Nucl. Instr. Meth. B, 58, 6 (1991).
+  double path =
+    csda_range(data, std::log(E_last)) - csda_range(data, std::log(E));
+  if (path > 0.0) {
+    double x = path / model::materials[p.material()]->ttb_->radiation_length;
+    double E_mean = 0.5 * (E_last + E);
+    double pv = E_mean * (E_mean + 2.0 * MASS_ELECTRON_EV) /
+                (E_mean + MASS_ELECTRON_EV);
+    double theta_0 =
+      13.6e6 / pv * std::sqrt(x) * std::max(0.0, 1.0 + 0.038 * std::log(x));
+
+    // The projected angles are Gaussian, so the polar angle follows a
+    // Rayleigh distribution
+    double theta = theta_0 * std::sqrt(-2.0 * std::log(prn(p.current_seed())));
+    double mu = std::cos(std::min(theta, PI));
+    p.u() = rotate_angle(p.u(), mu, nullptr, p.current_seed());
+  }
+
+  p.event() = TallyEvent::SCATTER;
+}
+
+} // namespace openmc
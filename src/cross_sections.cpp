@@ -7,6 +7,7 @@
 #include "openmc/file_utils.h"
 #include "openmc/geometry_aux.h"
 #include "openmc/hdf5_interface.h"
+#include "openmc/huge_pages.h"
 #include "openmc/material.h"
 #include "openmc/message_passing.h"
 #include "openmc/mgxs_interface.h"
@@ -190,7 +191,11 @@ void read_ce_cross_sections(const vector<vector<double>>& nuc_temps,
     thermal_names[kv.second] = kv.first;
   }
 
-  // Read cross sections
+  // Read cross sections. Reading from HDF5 is done serially; derived cross
+  // sections are computed afterwards in parallel.
+  Timer timer_read;
+  timer_read.start();
+  int i_first = data::nuclides.size();
   for (const auto& mat : model::materials) {
     for (int i_nuc : mat->nuclide_) {
       // Find name of corresponding nuclide. Because we haven't actually loaded
@@ -203,13 +208,48 @@ void read_ce_cross_sections(const vector<vector<double>>& nuc_temps,
         continue;
 
       const auto& temps = nuc_temps[i_nuc];
-      int err = openmc_load_nuclide(name.c_str(), temps.data(), temps.size());
+      int err = load_nuclide(name.c_str(), temps.data(), temps.size(), false);
       if (err < 0)
         throw std::runtime_error {openmc_err_msg};
 
       already_read.insert(name);
     }
   }
+  timer_read.stop();
+
+  Timer timer_derive;
+  timer_derive.start();
+  int n_nuclides = data::nuclides.size();
+#pragma omp parallel for schedule(dynamic)
+  for (int i = i_first; i < n_nuclides; ++i) {
+    data::nuclides[i]->derive_xs();
+  }
+  timer_derive.stop();
+
+  // Sharing is collective over the node, so it is done in a fixed order
+  if (settings::shared_cross_sections) {
+    for (int i = i_first; i < n_nuclides; ++i) {
+      share_nuclide_data(*data::nuclides[i]);
+    }
+  }
+
+  // Arrays that are not shared are copied so that their pages are spread over
+  // the NUMA domains of all threads rather than placed where they were read,
+  // and so that large ones can be backed by huge pages
+  if (settings::numa_first_touch || settings::huge_pages) {
+    for (int i = i_first; i < n_nuclides; ++i) {
+      data::nuclides[i]->place_data();
+    }
+    print_huge_page_usage(PageUse::CROSS_SECTIONS);
+  }
+
+  write_message(
+    6, "Time reading nuclide data: {:.3f} s", timer_read.elapsed());
+  write_message(
+    6, "Time deriving cross sections: {:.3f} s", timer_derive.elapsed());
+
+  Timer timer_thermal;
+  timer_thermal.start();
 
   // Perform final tasks -- reading S(a,b) tables, normalizing densities
   for (auto& mat : model::materials) {
@@ -244,9 +284,12 @@ void read_ce_cross_sections(const vector<vector<double>>& nuc_temps,
     // Finish setting up materials (normalizing densities, etc.)
     mat->finalize();
   } // materials
+  timer_thermal.stop();
+  write_message(6, "Time reading thermal scattering data: {:.3f} s",
+    timer_thermal.elapsed());
 
   if (settings::photon_transport &&
-      settings::electron_treatment == ElectronTreatment::TTB) {
+      settings::electron_treatment != ElectronTreatment::LED) {
     // Take logarithm of energies since they are log-log interpolated
     data::ttb_e_grid = xt::log(data::ttb_e_grid);
   }
@@ -17,6 +17,7 @@
 #include <fmt/core.h>
 
 #include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <sstream>
 #include <string>
@@ -254,7 +255,7 @@ void DAGUniverse::init_geometry()
 
   // allocate the cell overlap count if necessary
   if (settings::check_overlaps) {
-    model::overlap_check_count.resize(model::cells.size(), 0);
+    init_overlap_check_count();
   }
 
   has_graveyard_ = graveyard;
@@ -310,6 +311,16 @@ void DAGUniverse::init_geometry()
       s->bc_ = std::make_shared<VacuumBC>();
     }
 
+    // store the cells on either side of the surface so that the next cell of
+    // a crossing does not have to be looked up in DAGMC
+    if (parent_vols.size() == 2) {
+      auto cell_index = [this](moab::EntityHandle vol) {
+        return cell_idx_offset_ + dagmc_instance_->index_by_handle(vol) - 1;
+      };
+      s->set_parent_cells(
+        cell_index(parent_vols[0]), cell_index(parent_vols[1]));
+    }
+
     // add to global array and map
 
     auto in_map = model::surface_map.find(s->id_);
@@ -324,6 +335,108 @@ void DAGUniverse::init_geometry()
 
     model::surfaces.emplace_back(std::move(s));
   } // end surface loop
+
+  init_box_cells();
+
+  // Build a BVH over the bounding boxes of the volumes so that finding the
+  // volume containing a point only tests volumes whose boxes contain it. The
+  // implicit complement is left out since it surrounds all other volumes and
+  // is tested last.
+  bvh_.reset();
+  if (n_cells > 10) {
+    int32_t i_ic = implicit_complement_idx();
+    vector<int32_t> cells;
+    for (int32_t i = 0; i < n_cells; ++i) {
+      if (cell_idx_offset_ + i != i_ic)
+        cells.push_back(cell_idx_offset_ + i);
+    }
+    bvh_ = make_unique<UniverseBVH>(cells);
+  }
+}
+
+void DAGUniverse::init_box_cells()
+{
+  moab::Interface* mbi = dagmc_instance_->moab_instance();
+  moab::ErrorCode rval;
+
+  // Two coordinates are the same if they differ by roundoff
+  auto coincident = [](double a, double b) {
+    return std::abs(a - b) <= FP_COINCIDENT * std::max(1.0, std::abs(a));
+  };
+
+  int n_cells = dagmc_instance_->num_entities(3);
+  for (int i = 0; i < n_cells; i++) {
+    moab::EntityHandle vol = dagmc_instance_->entity_by_index(3, i + 1);
+    if (dagmc_instance_->is_implicit_complement(vol))
+      continue;
+
+    moab::Range surfs;
+    rval = mbi->get_child_meshsets(vol, surfs);
+    MB_CHK_ERR_CONT(rval);
+
+    // Collect the corners of the triangles of each surface and find the
+    // bounding box of the volume
+    vector<vector<Position>> corners(surfs.size());
+    Position lower {INFTY, INFTY, INFTY};
+    Position upper {-INFTY, -INFTY, -INFTY};
+    for (int j = 0; j < surfs.size(); ++j) {
+      moab::Range tris;
+      rval = mbi->get_entities_by_type(surfs[j], moab::MBTRI, tris);
+      MB_CHK_ERR_CONT(rval);
+      for (auto tri : tris) {
+        const moab::EntityHandle* conn;
+        int n_conn;
+        double xyz[9];
+        rval = mbi->get_connectivity(tri, conn, n_conn);
+        MB_CHK_ERR_CONT(rval);
+        rval = mbi->get_coords(conn, 3, xyz);
+        MB_CHK_ERR_CONT(rval);
+        for (int k = 0; k < 3; ++k) {
+          Position r {xyz[3 * k], xyz[3 * k + 1], xyz[3 * k + 2]};
+          corners[j].push_back(r);
+          for (int l = 0; l < 3; ++l) {
+            lower[l] = std::min(lower[l], r[l]);
+            upper[l] = std::max(upper[l], r[l]);
+          }
+        }
+      }
+    }
+
+    // The volume is its bounding box if every triangle lies in one of the
+    // faces of the box. Find which surfaces cover each face, where zero marks
+    // a face that no triangle lies in.
+    array<int32_t, 6> face_surfs;
+    face_surfs.fill(0);
+    bool is_box = true;
+    for (int j = 0; j < surfs.size() && is_box; ++j) {
+      int32_t surf_idx =
+        surf_idx_offset_ + dagmc_instance_->index_by_handle(surfs[j]);
+      for (int k = 0; k < corners[j].size() && is_box; k += 3) {
+        int face = -1;
+        for (int f = 0; f < 6 && face < 0; ++f) {
+          int axis = f / 2;
+          double bound = f % 2 == 0 ? lower[axis] : upper[axis];
+          if (coincident(corners[j][k][axis], bound) &&
+              coincident(corners[j][k + 1][axis], bound) &&
+              coincident(corners[j][k + 2][axis], bound))
+            face = f;
+        }
+        if (face < 0) {
+          is_box = false;
+        } else if (face_surfs[face] == 0) {
+          face_surfs[face] = surf_idx;
+        } else if (face_surfs[face] != surf_idx) {
+          face_surfs[face] = C_NONE;
+        }
+      }
+    }
+    if (!is_box ||
+        std::find(face_surfs.begin(), face_surfs.end(), 0) != face_surfs.end())
+      continue;
+
+    auto& c = dynamic_cast<DAGCell&>(*model::cells[cell_idx_offset_ + i]);
+    c.set_box(lower, upper, face_surfs);
+  }
 }
 
 std::string DAGUniverse::dagmc_ids_for_dim(int dim) const
@@ -389,9 +502,28 @@ int32_t DAGUniverse::implicit_complement_idx() const
 
 bool DAGUniverse::find_cell(Particle& p) const
 {
+  bool found;
+  if (bvh_) {
+    // Only the volumes whose bounding boxes contain the particle are tested,
+    // followed by the implicit complement, which is not in the BVH.  Every
+    // volume is tested if neither contains the particle.
+    found = bvh_->find_cell(p);
+    if (!found && model::universe_map[this->id_] == model::root_universe) {
+      int32_t i_ic = implicit_complement_idx();
+      const auto& ic = *model::cells[i_ic];
+      if (ic.contains(p.r_local(), p.u_local(), p.surface())) {
+        p.coord(p.n_coord() - 1).cell = i_ic;
+        found = true;
+      } else {
+        found = Universe::find_cell(p);
+      }
+    }
+  } else {
+    found = Universe::find_cell(p);
+  }
+
   // if the particle isn't in any of the other DagMC
   // cells, place it in the implicit complement
-  bool found = Universe::find_cell(p);
   if (!found && model::universe_map[this->id_] != model::root_universe) {
     p.coord(p.n_coord() - 1).cell = implicit_complement_idx();
     found = true;
@@ -558,10 +690,52 @@ DAGCell::DAGCell(std::shared_ptr<moab::DagMC> dag_ptr, int32_t dag_idx)
   simple_ = true;
 };
 
+void DAGCell::set_box(
+  Position lower, Position upper, array<int32_t, 6> face_surfs)
+{
+  is_box_ = true;
+  box_lower_ = lower;
+  box_upper_ = upper;
+  face_surfs_ = face_surfs;
+}
+
 std::pair<double, int32_t> DAGCell::distance(
   Position r, Direction u, int32_t on_surface, Particle* p) const
 {
   Expects(p);
+
+  // For a box, the particle leaves through the face it reaches first. If
+  // that face is covered by a single surface, no ray has to be fired. The ray
+  // history is cleared since it no longer ends at the current position.
+  if (is_box_) {
+    double dist = INFTY;
+    int face = 0;
+    for (int i = 0; i < 3; ++i) {
+      if (u[i] == 0.0)
+        continue;
+      double d = ((u[i] > 0.0 ? box_upper_[i] : box_lower_[i]) - r[i]) / u[i];
+      if (d < dist) {
+        dist = d;
+        face = 2 * i + (u[i] > 0.0);
+      }
+    }
+    if (face_surfs_[face] != C_NONE) {
+      p->history().reset();
+      p->last_dir() = u;
+      return {std::max(dist, 0.0), face_surfs_[face]};
+    }
+  }
+
+  // Firing a ray is expensive, so if the particle is still on the last ray
+  // fired in this cell, e.g. after crossing a weight window mesh boundary, the
+  // boundary found by that ray is reused. The ray history is left as it was
+  // after that ray was fired.
+  double dist;
+  int32_t surf_idx;
+  int32_t i_cell = p->coord(p->n_coord() - 1).cell;
+  if (p->ray_cache().find(i_cell, r, u, dist, surf_idx))
+    return {dist, surf_idx};
+
   // if we've changed direction or we're not on a surface,
   // reset the history and update last direction
   if (u != p->last_dir()) {
@@ -581,15 +755,14 @@ std::pair<double, int32_t> DAGCell::distance(
   moab::ErrorCode rval;
   moab::EntityHandle vol = dagmc_ptr_->entity_by_index(3, dag_index_);
   moab::EntityHandle hit_surf;
-  double dist;
   double pnt[3] = {r.x, r.y, r.z};
   double dir[3] = {u.x, u.y, u.z};
   rval = dagmc_ptr_->ray_fire(vol, pnt, dir, hit_surf, dist, &p->history());
   MB_CHK_ERR_CONT(rval);
-  int surf_idx;
   if (hit_surf != 0) {
     surf_idx =
       dag_univ->surf_idx_offset_ + dagmc_ptr_->index_by_handle(hit_surf);
+    p->ray_cache().insert(i_cell, r, u, dist, surf_idx);
   } else {
     // indicate that particle is lost
     surf_idx = -1;
@@ -608,8 +781,24 @@ std::pair<double, int32_t> DAGCell::distance(
   return {dist, surf_idx};
 }
 
-bool DAGCell::contains(Position r, Direction u, int32_t on_surface) const
+bool DAGCell::contains(Position r, Direction u, int32_t on_surface,
+  SurfaceSenseCache* cache) const
 {
+  // A point on a face of a box is inside if it is moving into the box
+  if (is_box_) {
+    for (int i = 0; i < 3; ++i) {
+      double lower = r[i] - box_lower_[i];
+      double upper = box_upper_[i] - r[i];
+      if (lower < -FP_COINCIDENT || upper < -FP_COINCIDENT)
+        return false;
+      if (lower < FP_COINCIDENT && u[i] <= 0.0)
+        return false;
+      if (upper < FP_COINCIDENT && u[i] >= 0.0)
+        return false;
+    }
+    return true;
+  }
+
   moab::ErrorCode rval;
   moab::EntityHandle vol = dagmc_ptr_->entity_by_index(3, dag_index_);
 
@@ -628,6 +817,11 @@ void DAGCell::to_hdf5_inner(hid_t group_id) const
 
 BoundingBox DAGCell::bounding_box() const
 {
+  if (is_box_) {
+    return {box_lower_.x, box_upper_.x, box_lower_.y, box_upper_.y,
+      box_lower_.z, box_upper_.z};
+  }
+
   moab::ErrorCode rval;
   moab::EntityHandle vol = dagmc_ptr_->entity_by_index(3, dag_index_);
   double min[3], max[3];
@@ -722,6 +916,13 @@ void check_dagmc_root_univ()
 int32_t next_cell(
   DAGUniverse* dag_univ, DAGCell* cur_cell, DAGSurface* surf_xed)
 {
+  // The cells on either side of most surfaces are found when the geometry is
+  // initialized
+  int32_t i_next = surf_xed->other_cell(
+    dag_univ->cell_idx_offset_ + cur_cell->dag_index() - 1);
+  if (i_next != C_NONE)
+    return i_next + 1;
+
   moab::EntityHandle surf =
     surf_xed->dagmc_ptr()->entity_by_index(2, surf_xed->dag_index());
   moab::EntityHandle vol =
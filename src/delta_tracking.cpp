@@ -0,0 +1,203 @@
+#include "openmc/delta_tracking.h"
+
+#include <cmath> // for log
+#include <string>
+
+#include "openmc/constants.h"
+#include "openmc/error.h"
+#include "openmc/geometry.h"
+#include "openmc/material.h"
+#include "openmc/message_passing.h"
+#include "openmc/profile.h"
+#include "openmc/random_lcg.h"
+#include "openmc/settings.h"
+#include "openmc/simulation.h"
+#include "openmc/tallies/tally.h"
+#include "openmc/universe.h"
+
+#include <fmt/core.h>
+
+namespace openmc {
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace simulation {
+
+vector<int> delta_majorant;
+int64_t n_majorant_violations {0};
+
+} // namespace simulation
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+void init_delta_tracking()
+{
+  // Majorants depend on the logarithmic grid, which may have changed since
+  // they were last computed
+  free_memory_majorant();
+  simulation::delta_majorant.assign(model::universes.size(), C_NONE);
+  simulation::n_majorant_violations = 0;
+  if (!settings::delta_tracking)
+    return;
+
+  if (!settings::run_CE) {
+    fatal_error("Delta tracking requires continuous-energy cross sections.");
+  }
+
+  // Determine which universes are delta tracked. The root universe has no
+  // boundary to stop at, so it is always surface tracked.
+  vector<int32_t> universes;
+  if (settings::delta_tracking_universes.empty()) {
+    for (int32_t i = 0; i < model::universes.size(); ++i) {
+      if (i != model::root_universe)
+        universes.push_back(i);
+    }
+  } else {
+    for (auto id : settings::delta_tracking_universes) {
+      auto it = model::universe_map.find(id);
+      if (it == model::universe_map.end()) {
+        fatal_error(fmt::format(
+          "Could not find universe {} specified for delta tracking.", id));
+      }
+      if (it->second == model::root_universe) {
+        if (mpi::master) {
+          warning(
+            fmt::format("The root universe {} can't be delta tracked.", id));
+        }
+        continue;
+      }
+      universes.push_back(it->second);
+    }
+  }
+
+  // Particles have no tracks within delta-tracked universes, so tallies that
+  // default to track-length estimators are switched to collision estimators.
+  // Tallies that explicitly ask for track-length estimators can't be scored.
+  std::string converted;
+  for (auto& t : model::tallies) {
+    if (t->deriv_ != C_NONE) {
+      fatal_error(fmt::format(
+        "Tally {} has a derivative, which delta tracking does not support.",
+        t->id_));
+    }
+    if (t->estimator_ == TallyEstimator::TRACKLENGTH) {
+      if (t->estimator_specified_) {
+        fatal_error(fmt::format("Tally {} uses a track-length estimator, "
+                                "which delta tracking does not support.",
+          t->id_));
+      }
+      t->estimator_ = TallyEstimator::COLLISION;
+      converted += (converted.empty() ? "" : ", ") + std::to_string(t->id_);
+    }
+  }
+  if (!converted.empty() && mpi::master) {
+    warning("Tallies " + converted +
+            " use collision estimators since track-length estimators are not "
+            "available with delta tracking.");
+  }
+  if (settings::run_mode == RunMode::EIGENVALUE && mpi::master) {
+    warning("The track-length estimate of k-effective is replaced by a "
+            "pseudo-collision estimate within delta-tracked universes.");
+  }
+
+  compute_majorants(universes);
+  for (auto i_univ : universes) {
+    simulation::delta_majorant[i_univ] = simulation::universe_majorant[i_univ];
+  }
+}
+
+int delta_tracking_level(const Particle& p)
+{
+  if (!settings::delta_tracking || p.type() != ParticleType::neutron)
+    return C_NONE;
+
+  for (int j = 0; j < p.n_coord(); ++j) {
+    int i_majorant = simulation::delta_majorant[p.coord(j).universe];
+    if (i_majorant == C_NONE)
+      continue;
+
+    // Where the majorant far exceeds the local cross section, most tentative
+    // collisions would be rejected and surface tracking is cheaper
+    const auto& majorant {simulation::majorants[i_majorant]};
+    if (p.macro_xs().total * settings::delta_tracking_max_ratio <
+        majorant(p.E()))
+      return C_NONE;
+    return j;
+  }
+  return C_NONE;
+}
+
+void delta_track(Particle& p, int level)
+{
+  int i_majorant = simulation::delta_majorant[p.coord(level).universe];
+  const auto& majorant {simulation::majorants[i_majorant]};
+  double xs_majorant = majorant(p.E());
+  double d_boundary = p.boundary().distance;
+
+  while (true) {
+    // Sample the distance to the next tentative collision
+    double d = -std::log(prn(p.current_seed())) / xs_majorant;
+    if (d >= d_boundary) {
+      // The particle leaves the region filled by the universe
+      p.move(d_boundary);
+      p.collision_distance() = INFINITY;
+      return;
+    }
+    p.move(d);
+    d_boundary -= d;
+    p.surface() = 0;
+
+    // Locate the particle within the universe
+    if (!find_cell_at_level(p, level)) {
+      p.mark_as_lost(fmt::format(
+        "Could not locate particle {} during delta tracking", p.id()));
+      p.collision_distance() = INFINITY;
+      return;
+    }
+
+    // Determine the total cross section at the tentative collision, which
+    // only has to be calculated again if the material or temperature changed
+    if (p.material() == MATERIAL_VOID) {
+      p.macro_xs().total = 0.0;
+      p.macro_xs().absorption = 0.0;
+      p.macro_xs().fission = 0.0;
+      p.macro_xs().nu_fission = 0.0;
+    } else if (p.material() != p.material_last() ||
+               p.sqrtkT() != p.sqrtkT_last()) {
+      count_event(TransportEvent::XS_LOOKUP);
+      model::materials[p.material()]->calculate_xs(p);
+    }
+    double xs_total = p.macro_xs().total;
+
+    // Score the pseudo-collision estimate of keff in place of the track-length
+    // estimate
+    if (settings::run_mode == RunMode::EIGENVALUE) {
+      p.keff_tally_tracklength() +=
+        p.wgt() * p.macro_xs().nu_fission / xs_majorant;
+    }
+
+    if (xs_total > xs_majorant) {
+#pragma omp atomic
+      simulation::n_majorant_violations += 1;
+    }
+
+    // Accept the tentative collision as a real one with probability equal to
+    // the ratio of the total cross section to the majorant
+    if (prn(p.current_seed()) * xs_majorant < xs_total) {
+      p.collision_distance() = 0.0;
+      p.boundary().distance = d_boundary;
+      return;
+    }
+  }
+}
+
+void free_memory_delta_tracking()
+{
+  simulation::delta_majorant.clear();
+}
+
+} // namespace openmc
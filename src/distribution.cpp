@@ -13,10 +13,22 @@
 #include "openmc/math_functions.h"
 #include "openmc/random_dist.h"
 #include "openmc/random_lcg.h"
+#include "openmc/search.h"
 #include "openmc/xml_interface.h"
 
 namespace openmc {
 
+//==============================================================================
+// Distribution implementation
+//==============================================================================
+
+void Distribution::sample_batch(uint64_t* seeds, int n, double* x) const
+{
+  for (int i = 0; i < n; ++i) {
+    x[i] = this->sample(seeds + i);
+  }
+}
+
 //==============================================================================
 // Discrete implementation
 //==============================================================================
@@ -42,14 +54,18 @@ double Discrete::sample(uint64_t* seed) const
 {
   int n = x_.size();
   if (n > 1) {
+    // Find the first outcome whose cumulative probability is above the
+    // sampled value, starting from the guide table
     double xi = prn(seed);
-    double c = 0.0;
-    for (int i = 0; i < n; ++i) {
-      c += p_[i];
-      if (xi < c)
-        return x_[i];
-    }
-    throw std::runtime_error {"Error when sampling probability mass function."};
+    int i = c_guide_[static_cast<std::size_t>(xi * c_guide_.size())];
+    while (i > 0 && xi < c_[i - 1])
+      --i;
+    while (i < n && xi >= c_[i])
+      ++i;
+    if (i == n)
+      throw std::runtime_error {
+        "Error when sampling probability mass function."};
+    return x_[i];
   } else {
     return x_[0];
   }
@@ -62,6 +78,15 @@ void Discrete::normalize()
   for (auto& p_i : p_) {
     p_i /= norm;
   }
+
+  // Cumulative probabilities, summed in order
+  c_.resize(p_.size());
+  double c = 0.0;
+  for (int i = 0; i < p_.size(); ++i) {
+    c += p_[i];
+    c_[i] = c;
+  }
+  c_guide_ = guide_table(c_.begin(), c_.end(), c_.size());
 }
 
 //==============================================================================
@@ -85,6 +110,15 @@ double Uniform::sample(uint64_t* seed) const
   return a_ + prn(seed) * (b_ - a_);
 }
 
+void Uniform::sample_batch(uint64_t* seeds, int n, double* x) const
+{
+  prn_lanes(seeds, n, x);
+#pragma omp simd
+  for (int i = 0; i < n; ++i) {
+    x[i] = a_ + x[i] * (b_ - a_);
+  }
+}
+
 //==============================================================================
 // PowerLaw implementation
 //==============================================================================
@@ -145,6 +179,28 @@ double Watt::sample(uint64_t* seed) const
   return watt_spectrum(a_, b_, seed);
 }
 
+void Watt::sample_batch(uint64_t* seeds, int n, double* x) const
+{
+  // Draw the random numbers in the same order as watt_spectrum() so that each
+  // value matches the one sampled with its seed alone
+  vector<double> r1(n), r2(n), r3(n);
+  prn_lanes(seeds, n, r1.data());
+  prn_lanes(seeds, n, r2.data());
+  prn_lanes(seeds, n, r3.data());
+  prn_lanes(seeds, n, x);
+
+#pragma omp simd
+  for (int i = 0; i < n; ++i) {
+    // Sample Maxwellian with temperature a
+    double c = std::cos(PI / 2. * r3[i]);
+    double w = -a_ * (std::log(r1[i]) + std::log(r2[i]) * c * c);
+
+    // Shift by a uniform variate on [-1, 1)
+    double mu = -1. + 2. * x[i];
+    x[i] = w + 0.25 * a_ * a_ * b_ + mu * std::sqrt(a_ * a_ * b_ * w);
+  }
+}
+
 //==============================================================================
 // Normal implementation
 //==============================================================================
@@ -255,6 +311,8 @@ void Tabular::init(
     p_[i] = p_[i] / c_[n - 1];
     c_[i] = c_[i] / c_[n - 1];
   }
+
+  c_guide_ = guide_table(c_.begin(), c_.end(), n);
 }
 
 double Tabular::sample(uint64_t* seed) const
@@ -262,15 +320,15 @@ double Tabular::sample(uint64_t* seed) const
   // Sample value of CDF
   double c = prn(seed);
 
-  // Find first CDF bin which is above the sampled value
-  double c_i = c_[0];
-  int i;
-  std::size_t n = c_.size();
-  for (i = 0; i < n - 1; ++i) {
-    if (c <= c_[i + 1])
-      break;
-    c_i = c_[i + 1];
-  }
+  // Find first CDF bin which is above the sampled value, starting from the
+  // guide table
+  int n = c_.size();
+  int i = c_guide_[static_cast<std::size_t>(c * c_guide_.size())];
+  while (i > 0 && c <= c_[i])
+    --i;
+  while (i < n - 1 && c > c_[i + 1])
+    ++i;
+  double c_i = c_[i];
 
   // Determine bounding PDF values
   double x_i = x_[i];
@@ -336,9 +394,12 @@ Mixture::Mixture(pugi::xml_node node)
   }
 
   // Normalize cummulative probabilities to 1
+  vector<double> c;
   for (auto& pair : distribution_) {
     pair.first /= cumsum;
+    c.push_back(pair.first);
   }
+  c_guide_ = guide_table(c.begin(), c.end(), c.size());
 }
 
 double Mixture::sample(uint64_t* seed) const
@@ -346,15 +407,20 @@ double Mixture::sample(uint64_t* seed) const
   // Sample value of CDF
   const double p = prn(seed);
 
-  // find matching distribution
-  const auto it = std::lower_bound(distribution_.cbegin(), distribution_.cend(),
-    p, [](const DistPair& pair, double p) { return pair.first < p; });
+  // Find the first distribution whose cummulative probability is not below the
+  // sampled value, starting from the guide table
+  int n = distribution_.size();
+  int i = c_guide_[static_cast<std::size_t>(p * c_guide_.size())];
+  while (i > 0 && distribution_[i - 1].first >= p)
+    --i;
+  while (i < n && distribution_[i].first < p)
+    ++i;
 
   // This should not happen. Catch it
-  Ensures(it != distribution_.cend());
+  Ensures(i < n);
 
   // Sample the chosen distribution
-  return it->second->sample(seed);
+  return distribution_[i].second->sample(seed);
 }
 
 //==============================================================================
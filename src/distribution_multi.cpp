@@ -28,6 +28,14 @@ UnitSphereDistribution::UnitSphereDistribution(pugi::xml_node node)
   }
 }
 
+void UnitSphereDistribution::sample_batch(
+  uint64_t* seeds, int n, Direction* u) const
+{
+  for (int i = 0; i < n; ++i) {
+    u[i] = this->sample(seeds + i);
+  }
+}
+
 //==============================================================================
 // PolarAzimuthal implementation
 //==============================================================================
@@ -84,6 +92,22 @@ Direction Isotropic::sample(uint64_t* seed) const
   return isotropic_direction(seed);
 }
 
+void Isotropic::sample_batch(uint64_t* seeds, int n, Direction* u) const
+{
+  // Draw the random numbers in the same order as isotropic_direction()
+  vector<double> phi(n), mu(n);
+  prn_lanes(seeds, n, phi.data());
+  prn_lanes(seeds, n, mu.data());
+
+#pragma omp simd
+  for (int i = 0; i < n; ++i) {
+    phi[i] = 2.0 * PI * phi[i];
+    mu[i] = -1. + 2. * mu[i];
+    double s = std::sqrt(1.0 - mu[i] * mu[i]);
+    u[i] = {mu[i], s * std::cos(phi[i]), s * std::sin(phi[i])};
+  }
+}
+
 //==============================================================================
 // Monodirectional implementation
 //==============================================================================
@@ -1,11 +1,29 @@
 #include "openmc/distribution_spatial.h"
 
+#include <algorithm> // for min
+#include <numeric>   // for accumulate
+
+#include <fmt/core.h>
+
 #include "openmc/error.h"
+#include "openmc/mesh.h"
 #include "openmc/random_lcg.h"
 #include "openmc/xml_interface.h"
 
 namespace openmc {
 
+//==============================================================================
+// SpatialDistribution implementation
+//==============================================================================
+
+void SpatialDistribution::sample_batch(
+  uint64_t* seeds, int n, Position* r) const
+{
+  for (int i = 0; i < n; ++i) {
+    r[i] = this->sample(seeds + i);
+  }
+}
+
 //==============================================================================
 // CartesianIndependent implementation
 //==============================================================================
@@ -51,6 +69,19 @@ Position CartesianIndependent::sample(uint64_t* seed) const
   return {x_->sample(seed), y_->sample(seed), z_->sample(seed)};
 }
 
+void CartesianIndependent::sample_batch(
+  uint64_t* seeds, int n, Position* r) const
+{
+  // Each seed is used for x, then y, then z, as in sample()
+  vector<double> x(n), y(n), z(n);
+  x_->sample_batch(seeds, n, x.data());
+  y_->sample_batch(seeds, n, y.data());
+  z_->sample_batch(seeds, n, z.data());
+  for (int i = 0; i < n; ++i) {
+    r[i] = {x[i], y[i], z[i]};
+  }
+}
+
 //==============================================================================
 // CylindricalIndependent implementation
 //==============================================================================
@@ -203,6 +234,22 @@ Position SpatialBox::sample(uint64_t* seed) const
   return lower_left_ + xi * (upper_right_ - lower_left_);
 }
 
+void SpatialBox::sample_batch(uint64_t* seeds, int n, Position* r) const
+{
+  vector<double> xi_x(n), xi_y(n), xi_z(n);
+  prn_lanes(seeds, n, xi_x.data());
+  prn_lanes(seeds, n, xi_y.data());
+  prn_lanes(seeds, n, xi_z.data());
+
+  Position width = upper_right_ - lower_left_;
+#pragma omp simd
+  for (int i = 0; i < n; ++i) {
+    r[i].x = lower_left_.x + xi_x[i] * width.x;
+    r[i].y = lower_left_.y + xi_y[i] * width.y;
+    r[i].z = lower_left_.z + xi_z[i] * width.z;
+  }
+}
+
 //==============================================================================
 // SpatialPoint implementation
 //==============================================================================
@@ -224,4 +271,95 @@ Position SpatialPoint::sample(uint64_t* seed) const
   return r_;
 }
 
+//==============================================================================
+// MeshSpatial implementation
+//==============================================================================
+
+MeshSpatial::MeshSpatial(pugi::xml_node node)
+{
+  // Find the mesh
+  int32_t mesh_id = std::stoi(get_node_value(node, "mesh_id"));
+  auto it = model::mesh_map.find(mesh_id);
+  if (it == model::mesh_map.end()) {
+    fatal_error(fmt::format(
+      "Mesh {} specified for a mesh spatial source does not exist.", mesh_id));
+  }
+  mesh_index_ = it->second;
+  int n = model::meshes[mesh_index_]->n_bins();
+
+  // Read the strength of each element
+  auto strengths = get_node_array<double>(node, "strengths");
+  if (strengths.size() != n) {
+    fatal_error(fmt::format("Mesh spatial source has {} strengths but mesh {} "
+                            "has {} elements.",
+      strengths.size(), mesh_id, n));
+  }
+  double norm = std::accumulate(strengths.begin(), strengths.end(), 0.0);
+  if (norm <= 0.0) {
+    fatal_error("Strengths of a mesh spatial source must sum to a positive "
+                "value.");
+  }
+
+  // Build the alias table with Vose's method, as for the outgoing groups of
+  // multigroup scattering
+  alias_prob_.resize(n);
+  alias_bin_.resize(n);
+  vector<int> small;
+  vector<int> large;
+  for (int i = 0; i < n; ++i) {
+    alias_prob_[i] = strengths[i] * n / norm;
+    alias_bin_[i] = i;
+    if (alias_prob_[i] < 1.0) {
+      small.push_back(i);
+    } else {
+      large.push_back(i);
+    }
+  }
+  while (!small.empty() && !large.empty()) {
+    int s = small.back();
+    small.pop_back();
+    int l = large.back();
+    alias_bin_[s] = l;
+    alias_prob_[l] -= 1.0 - alias_prob_[s];
+    if (alias_prob_[l] < 1.0) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+
+  // Remaining bins are full up to round-off
+  for (int i : small)
+    alias_prob_[i] = 1.0;
+  for (int i : large)
+    alias_prob_[i] = 1.0;
+
+  // Read the energy distribution of each element, if given
+  for (auto node_dist : node.children("energy")) {
+    energy_.push_back(distribution_from_xml(node_dist));
+  }
+  if (!energy_.empty() && energy_.size() != n) {
+    fatal_error(fmt::format("Mesh spatial source has {} energy distributions "
+                            "but mesh {} has {} elements.",
+      energy_.size(), mesh_id, n));
+  }
+}
+
+int MeshSpatial::sample_element(uint64_t* seed) const
+{
+  int n = alias_prob_.size();
+  double x = prn(seed) * n;
+  int i = std::min(static_cast<int>(x), n - 1);
+  return x - i < alias_prob_[i] ? i : alias_bin_[i];
+}
+
+Position MeshSpatial::sample_position(int bin, uint64_t* seed) const
+{
+  return model::meshes[mesh_index_]->sample_element(bin, seed);
+}
+
+Position MeshSpatial::sample(uint64_t* seed) const
+{
+  return this->sample_position(this->sample_element(seed), seed);
+}
+
 } // namespace openmc
@@ -4,6 +4,7 @@
 #include "xtensor/xmath.hpp"
 #include "xtensor/xtensor.hpp"
 #include "xtensor/xview.hpp"
+#include <fmt/core.h>
 
 #include "openmc/array.h"
 #include "openmc/bank.h"
@@ -11,6 +12,7 @@
 #include "openmc/constants.h"
 #include "openmc/error.h"
 #include "openmc/hdf5_interface.h"
+#include "openmc/ifp.h"
 #include "openmc/math_functions.h"
 #include "openmc/mesh.h"
 #include "openmc/message_passing.h"
@@ -21,10 +23,11 @@
 #include "openmc/tallies/tally.h"
 #include "openmc/timer.h"
 
-#include <algorithm> // for min
+#include <algorithm> // for min, swap
 #include <cmath>     // for sqrt, abs, pow
 #include <iterator>  // for back_inserter
 #include <limits>    //for infinity
+#include <new>       // for placement new
 #include <string>
 
 namespace openmc {
@@ -39,14 +42,151 @@ double keff_generation;
 array<double, 2> k_sum;
 vector<double> entropy;
 xt::xtensor<double, 1> source_frac;
+xt::xtensor<double, 2> fission_matrix;
+xt::xtensor<double, 1> fission_matrix_source;
+double k_shift;
+double wielandt_weight;
+double wielandt_weight_unreduced;
+
+#ifdef OPENMC_MPI
+// Source bank exchange left in flight by synchronize_bank() when the bank is
+// pipelined
+vector<SourceSite> bank_send_sites;     //!< Sampled sites being sent
+vector<MPI_Request> bank_send_requests; //!< Requests for sent sites
+vector<MPI_Request> bank_recv_requests; //!< Requests for received sites
+vector<int64_t> bank_recv_start; //!< Source bank index of each receive
+vector<int64_t> bank_recv_n;     //!< Number of sites in each receive
+int64_t bank_local_start {0};    //!< Source bank index of local sites
+int64_t bank_local_n {0};        //!< Number of local sites not yet returned
+
+// Ancestors of the sites sent and requests for those received, in the same
+// order as bank_recv_requests, when iterated fission probability is used
+vector<IfpAncestor> bank_send_ancestry; //!< Ancestors of sites being sent
+vector<MPI_Request> bank_recv_ifp_requests; //!< Requests for ancestors
+#endif
 
 } // namespace simulation
 
+namespace {
+
+// Fission matrix tallied on this process since it was last summed over
+// processes
+xt::xtensor<double, 2> fission_matrix_local;
+xt::xtensor<double, 1> fission_matrix_source_local;
+
+//! Fission matrix normalized per unit source weight in each bin
+xt::xtensor<double, 2> normalized_fission_matrix()
+{
+  xt::xtensor<double, 2> m = simulation::fission_matrix;
+  const auto& source {simulation::fission_matrix_source};
+  int n = source.size();
+  for (int j = 0; j < n; ++j) {
+    for (int i = 0; i < n; ++i) {
+      m(j, i) = source(i) > 0.0 ? m(j, i) / source(i) : 0.0;
+    }
+  }
+  return m;
+}
+
+//! Find the dominant eigenvector of the fission matrix by power iteration,
+//! starting from the accumulated source distribution
+xt::xtensor<double, 1> fission_matrix_eigenvector()
+{
+  auto m = normalized_fission_matrix();
+  int n = m.shape()[0];
+  xt::xtensor<double, 1> x = simulation::fission_matrix_source;
+  double total = xt::sum(x)();
+  if (total == 0.0)
+    return x;
+  x /= total;
+  xt::xtensor<double, 1> y = xt::zeros<double>({n});
+
+  for (int iter = 0; iter < FISSION_MATRIX_MAX_ITER; ++iter) {
+#pragma omp parallel for
+    for (int j = 0; j < n; ++j) {
+      double sum = 0.0;
+      for (int i = 0; i < n; ++i) {
+        sum += m(j, i) * x(i);
+      }
+      y(j) = sum;
+    }
+    double k = xt::sum(y)();
+    if (k == 0.0)
+      break;
+    y /= k;
+    double change = xt::amax(xt::abs(y - x))();
+    std::swap(x, y);
+    if (change < FISSION_MATRIX_TOLERANCE)
+      break;
+  }
+  return x;
+}
+
+//! Indices of the values of eigenvalue calculations in mpi::generation_sums
+struct EigenvalueSums {
+  int keff;
+  int wielandt_weight;
+  int n_bank;
+};
+
+const EigenvalueSums& eigenvalue_sums()
+{
+  static EigenvalueSums sums {mpi::generation_sums.add(),
+    mpi::generation_sums.add(), mpi::generation_sums.add()};
+  return sums;
+}
+
+} // namespace
+
+#ifdef OPENMC_MPI
+namespace {
+
+// Compact sites are packed into the storage of the source sites they're
+// converted from or to, which is only possible since they're no larger
+static_assert(sizeof(CompactSourceSite) <= sizeof(SourceSite),
+  "Compact source sites must fit in the space of source sites");
+static_assert(alignof(CompactSourceSite) <= alignof(SourceSite),
+  "Compact source sites must be aligned like source sites");
+
+//! View the storage of source sites as an array of compact sites
+CompactSourceSite* compact_sites(SourceSite* sites)
+{
+  return reinterpret_cast<CompactSourceSite*>(sites);
+}
+
+//! Convert source sites to compact sites packed at the start of their own
+//! storage. Going from the front, each compact site only overlaps the site it
+//! was converted from and those before it.
+void compact_in_place(SourceSite* sites, int64_t n)
+{
+  auto compact = compact_sites(sites);
+  for (int64_t i = 0; i < n; ++i) {
+    SourceSite site = sites[i];
+    new (&compact[i]) CompactSourceSite(site);
+  }
+}
+
+//! Convert compact sites received at the start of a range of the source bank
+//! back to source sites in place. Going from the back, each source site only
+//! overlaps the compact site it's converted from and those after it.
+void expand_received_sites(int64_t start, int64_t n)
+{
+  SourceSite* sites = &simulation::source_bank[start];
+  auto compact = compact_sites(sites);
+  for (int64_t i = n - 1; i >= 0; --i) {
+    CompactSourceSite site = compact[i];
+    sites[i] = site.expand();
+  }
+}
+
+} // namespace
+#endif
+
 //==============================================================================
 // Non-member functions
 //==============================================================================
 
-void calculate_generation_keff()
+void set_generation_sums()
 {
   const auto& gt = simulation::global_tallies;
 
@@ -55,23 +195,34 @@ void calculate_generation_keff()
     gt(GlobalTally::K_TRACKLENGTH, TallyResult::VALUE) -
     simulation::keff_generation;
 
-  double keff_reduced;
-#ifdef OPENMC_MPI
-  // Combine values across all processors
-  MPI_Allreduce(&simulation::keff_generation, &keff_reduced, 1, MPI_DOUBLE,
-    MPI_SUM, mpi::intracomm);
-#else
-  keff_reduced = simulation::keff_generation;
-#endif
+  const auto& i = eigenvalue_sums();
+  mpi::generation_sums.set(i.keff, simulation::keff_generation);
+  mpi::generation_sums.set(i.wielandt_weight, simulation::wielandt_weight);
+  mpi::generation_sums.set(i.n_bank, simulation::fission_bank.size());
+}
+
+void calculate_generation_keff()
+{
+  // Get the values summed across all processors
+  const auto& i = eigenvalue_sums();
+  double keff = mpi::generation_sums.get(i.keff);
+  double weight = mpi::generation_sums.get(i.wielandt_weight);
+
+  // Fission neutrons transported in the generation they were born in with a
+  // Wielandt shift start histories just like source neutrons do
+  simulation::wielandt_weight_unreduced += weight;
 
   // Normalize single batch estimate of k
   // TODO: This should be normalized by total_weight, not by n_particles
-  keff_reduced /= settings::n_particles;
+  double keff_reduced = keff / (settings::n_particles + weight);
   simulation::k_generation.push_back(keff_reduced);
 }
 
 void synchronize_bank()
 {
+  // Make sure the previous exchange is complete before its buffers are reused
+  finish_bank_exchange();
+
   simulation::time_bank.start();
 
   // In order to properly understand the fission bank algorithm, you need to
@@ -94,9 +245,9 @@ void synchronize_bank()
   if (mpi::rank == 0)
     start = 0;
 
+  // The total was summed with the other values of the generation
   int64_t finish = start + simulation::fission_bank.size();
-  int64_t total = finish;
-  MPI_Bcast(&total, 1, MPI_INT64_T, mpi::n_procs - 1, mpi::intracomm);
+  int64_t total = mpi::generation_sums.get(eigenvalue_sums().n_bank);
 
 #else
   int64_t start = 0;
@@ -143,6 +294,16 @@ void synchronize_bank()
   int64_t index_temp = 0;
   vector<SourceSite> temp_sites(3 * simulation::work_per_rank);
 
+  // Fission sites don't carry their ancestors, which are instead found for
+  // the sampled sites from those of the source sites their parents were born
+  // from, before the source bank is replaced. Each sampled site has
+  // settings::ifp_n_generation ancestors appended in the order it's sampled.
+  bool ifp = settings::ifp_n_generation > 0;
+  int64_t n_gen = settings::ifp_n_generation;
+  vector<IfpAncestor> temp_ancestry;
+  if (ifp)
+    temp_ancestry.reserve(simulation::work_per_rank * n_gen);
+
   for (int64_t i = 0; i < simulation::fission_bank.size(); i++) {
     const auto& site = simulation::fission_bank[i];
 
@@ -153,6 +314,8 @@ void synchronize_bank()
     if (total < settings::n_particles) {
       for (int64_t j = 1; j <= settings::n_particles / total; ++j) {
         temp_sites[index_temp] = site;
+        if (ifp)
+          ifp_fission_ancestry(site, temp_ancestry);
         ++index_temp;
       }
     }
@@ -160,6 +323,8 @@ void synchronize_bank()
     // Randomly sample sites needed
     if (prn(&seed) < p_sample) {
       temp_sites[index_temp] = site;
+      if (ifp)
+        ifp_fission_ancestry(site, temp_ancestry);
       ++index_temp;
     }
   }
@@ -202,6 +367,8 @@ void synchronize_bank()
       for (int i = 0; i < sites_needed; ++i) {
         int i_bank = simulation::fission_bank.size() - sites_needed + i;
         temp_sites[index_temp] = simulation::fission_bank[i_bank];
+        if (ifp)
+          ifp_fission_ancestry(simulation::fission_bank[i_bank], temp_ancestry);
         ++index_temp;
       }
     }
@@ -210,6 +377,21 @@ void synchronize_bank()
     finish = simulation::work_index[mpi::rank + 1];
   }
 
+  // Convert the sampled sites to compact form, packed into the space of the
+  // sampled sites themselves and received straight into the source bank, so
+  // no extra buffers are needed. Sites that stay on this process go through
+  // the conversion too so that results don't depend on the number of
+  // processes.
+  if (settings::compact_bank) {
+#ifdef OPENMC_MPI
+    compact_in_place(temp_sites.data(), index_temp);
+#else
+    for (int64_t i = 0; i < index_temp; ++i) {
+      temp_sites[i] = CompactSourceSite(temp_sites[i]).expand();
+    }
+#endif
+  }
+
   simulation::time_bank_sample.stop();
   simulation::time_bank_sendrecv.start();
 
@@ -219,6 +401,10 @@ void synchronize_bank()
 
   int64_t index_local = 0;
   vector<MPI_Request> requests;
+  vector<MPI_Request> recv_requests;
+  vector<MPI_Request> ifp_requests;
+  vector<int64_t> recv_start;
+  vector<int64_t> recv_n;
 
   if (start < settings::n_particles) {
     // Determine the index of the processor which has the first part of the
@@ -235,9 +421,24 @@ void synchronize_bank()
       // process
       if (neighbor != mpi::rank) {
         requests.emplace_back();
-        MPI_Isend(&temp_sites[index_local], static_cast<int>(n),
-          mpi::source_site, neighbor, mpi::rank, mpi::intracomm,
-          &requests.back());
+        if (settings::compact_bank) {
+          MPI_Isend(&compact_sites(temp_sites.data())[index_local],
+            static_cast<int>(n), mpi::compact_source_site, neighbor, mpi::rank,
+            mpi::intracomm, &requests.back());
+        } else {
+          MPI_Isend(&temp_sites[index_local], static_cast<int>(n),
+            mpi::source_site, neighbor, mpi::rank, mpi::intracomm,
+            &requests.back());
+        }
+
+        // Messages with the same tag are received in the order they're sent,
+        // so the ancestors follow the sites they belong to
+        if (ifp) {
+          requests.emplace_back();
+          MPI_Isend(&temp_ancestry[index_local * n_gen],
+            static_cast<int>(n * n_gen), mpi::ifp_ancestry, neighbor,
+            mpi::rank, mpi::intracomm, &requests.back());
+        }
       }
 
       // Increment all indices
@@ -285,17 +486,46 @@ void synchronize_bank()
       // If the source sites are not on this processor, initiate an
       // asynchronous receive for the source sites
 
-      requests.emplace_back();
-      MPI_Irecv(&simulation::source_bank[index_local], static_cast<int>(n),
-        mpi::source_site, neighbor, neighbor, mpi::intracomm, &requests.back());
+      recv_requests.emplace_back();
+      recv_start.push_back(index_local);
+      recv_n.push_back(n);
+      if (settings::compact_bank) {
+        MPI_Irecv(compact_sites(&simulation::source_bank[index_local]),
+          static_cast<int>(n), mpi::compact_source_site, neighbor, neighbor,
+          mpi::intracomm, &recv_requests.back());
+      } else {
+        MPI_Irecv(&simulation::source_bank[index_local], static_cast<int>(n),
+          mpi::source_site, neighbor, neighbor, mpi::intracomm,
+          &recv_requests.back());
+      }
+      if (ifp) {
+        ifp_requests.emplace_back();
+        MPI_Irecv(&simulation::ifp_source_bank[index_local * n_gen],
+          static_cast<int>(n * n_gen), mpi::ifp_ancestry, neighbor, neighbor,
+          mpi::intracomm, &ifp_requests.back());
+      }
 
     } else {
       // If the source sites are on this procesor, we can simply copy them
       // from the temp_sites bank
 
       index_temp = start - bank_position[mpi::rank];
-      std::copy(&temp_sites[index_temp], &temp_sites[index_temp + n],
-        &simulation::source_bank[index_local]);
+      if (settings::compact_bank) {
+        for (int64_t i = 0; i < n; ++i) {
+          simulation::source_bank[index_local + i] =
+            compact_sites(temp_sites.data())[index_temp + i].expand();
+        }
+      } else {
+        std::copy(&temp_sites[index_temp], &temp_sites[index_temp + n],
+          &simulation::source_bank[index_local]);
+      }
+      if (ifp) {
+        std::copy(temp_ancestry.data() + index_temp * n_gen,
+          temp_ancestry.data() + (index_temp + n) * n_gen,
+          simulation::ifp_source_bank.data() + index_local * n_gen);
+      }
+      simulation::bank_local_start = index_local;
+      simulation::bank_local_n = n;
     }
 
     // Increment all indices
@@ -304,18 +534,47 @@ void synchronize_bank()
     ++neighbor;
   }
 
-  // Since we initiated a series of asynchronous ISENDs and IRECVs, now we have
-  // to ensure that the data has actually been communicated before moving on to
-  // the next generation
-
-  int n_request = requests.size();
-  MPI_Waitall(n_request, requests.data(), MPI_STATUSES_IGNORE);
+  if (settings::pipelined_bank) {
+    // Leave the ISENDs and IRECVs in flight so that transport can start on the
+    // local sites while the remote ones are still arriving. The sent sites are
+    // moved rather than copied so that the send buffers stay where they are.
+    simulation::bank_send_sites = std::move(temp_sites);
+    simulation::bank_send_ancestry = std::move(temp_ancestry);
+    simulation::bank_send_requests = std::move(requests);
+    simulation::bank_recv_requests = std::move(recv_requests);
+    simulation::bank_recv_ifp_requests = std::move(ifp_requests);
+    simulation::bank_recv_start = std::move(recv_start);
+    simulation::bank_recv_n = std::move(recv_n);
+  } else {
+    // Since we initiated a series of asynchronous ISENDs and IRECVs, now we
+    // have to ensure that the data has actually been communicated before
+    // moving on to the next generation
+    simulation::bank_local_n = 0;
+    MPI_Waitall(
+      recv_requests.size(), recv_requests.data(), MPI_STATUSES_IGNORE);
+    MPI_Waitall(ifp_requests.size(), ifp_requests.data(), MPI_STATUSES_IGNORE);
+    MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+    if (settings::compact_bank) {
+      for (int i = 0; i < recv_start.size(); ++i) {
+        expand_received_sites(recv_start[i], recv_n[i]);
+      }
+    }
+  }
 
 #else
   std::copy(temp_sites.data(), temp_sites.data() + settings::n_particles,
     simulation::source_bank.begin());
+  if (ifp) {
+    std::copy(temp_ancestry.data(),
+      temp_ancestry.data() + settings::n_particles * n_gen,
+      simulation::ifp_source_bank.begin());
+  }
 #endif
 
+  // Every site of the new source bank has one more generation of ancestors
+  if (ifp)
+    ifp_next_generation();
+
   simulation::time_bank_sendrecv.stop();
   simulation::time_bank.stop();
 }
@@ -521,6 +780,100 @@ int openmc_get_keff(double* k_combined)
   return 0;
 }
 
+bool bank_exchange_pending()
+{
+#ifdef OPENMC_MPI
+  return simulation::bank_local_n > 0 ||
+         !simulation::bank_recv_requests.empty() ||
+         !simulation::bank_send_requests.empty();
+#else
+  return false;
+#endif
+}
+
+bool receive_bank_chunk(int64_t* i_begin, int64_t* i_end)
+{
+#ifdef OPENMC_MPI
+  // Sites sampled on this process were copied into place by synchronize_bank()
+  if (simulation::bank_local_n > 0) {
+    *i_begin = simulation::bank_local_start;
+    *i_end = simulation::bank_local_start + simulation::bank_local_n;
+    simulation::bank_local_n = 0;
+    return true;
+  }
+
+  // Otherwise, wait for whichever remote chunk arrives first. Completed
+  // requests are set to MPI_REQUEST_NULL, and MPI_UNDEFINED is returned once
+  // all chunks have arrived.
+  auto& requests = simulation::bank_recv_requests;
+  if (!requests.empty()) {
+    simulation::time_bank.start();
+    simulation::time_bank_sendrecv.start();
+    int i;
+    MPI_Waitany(requests.size(), requests.data(), &i, MPI_STATUS_IGNORE);
+
+    // The ancestors of the chunk are needed as soon as its sites are
+    auto& ifp_requests = simulation::bank_recv_ifp_requests;
+    if (i != MPI_UNDEFINED && !ifp_requests.empty())
+      MPI_Wait(&ifp_requests[i], MPI_STATUS_IGNORE);
+    simulation::time_bank_sendrecv.stop();
+    simulation::time_bank.stop();
+    if (i != MPI_UNDEFINED) {
+      *i_begin = simulation::bank_recv_start[i];
+      *i_end = simulation::bank_recv_start[i] + simulation::bank_recv_n[i];
+
+      // Compact sites are converted as they're returned. The chunk is then
+      // marked empty so that finish_bank_exchange() doesn't convert it again.
+      if (settings::compact_bank) {
+        expand_received_sites(*i_begin, simulation::bank_recv_n[i]);
+        simulation::bank_recv_n[i] = 0;
+      }
+      return true;
+    }
+  }
+
+  finish_bank_exchange();
+#endif
+  return false;
+}
+
+void finish_bank_exchange()
+{
+#ifdef OPENMC_MPI
+  if (!bank_exchange_pending())
+    return;
+
+  simulation::time_bank.start();
+  simulation::time_bank_sendrecv.start();
+  auto& recv = simulation::bank_recv_requests;
+  auto& recv_ifp = simulation::bank_recv_ifp_requests;
+  auto& send = simulation::bank_send_requests;
+  MPI_Waitall(recv.size(), recv.data(), MPI_STATUSES_IGNORE);
+  MPI_Waitall(recv_ifp.size(), recv_ifp.data(), MPI_STATUSES_IGNORE);
+  MPI_Waitall(send.size(), send.data(), MPI_STATUSES_IGNORE);
+  simulation::time_bank_sendrecv.stop();
+  simulation::time_bank.stop();
+
+  if (settings::compact_bank) {
+    for (int i = 0; i < simulation::bank_recv_start.size(); ++i) {
+      expand_received_sites(
+        simulation::bank_recv_start[i], simulation::bank_recv_n[i]);
+    }
+  }
+
+  recv.clear();
+  recv_ifp.clear();
+  send.clear();
+  simulation::bank_recv_start.clear();
+  simulation::bank_recv_n.clear();
+  simulation::bank_local_n = 0;
+  simulation::bank_send_sites.clear();
+  simulation::bank_send_sites.shrink_to_fit();
+  simulation::bank_send_ancestry.clear();
+  simulation::bank_send_ancestry.shrink_to_fit();
+#endif
+}
+
 void shannon_entropy()
 {
   // Get source weight in each mesh bin
@@ -565,6 +918,7 @@ void ufs_count_sites()
 
   } else {
     // count number of source sites in each ufs mesh cell
+    finish_bank_exchange();
     bool sites_outside;
     simulation::source_frac =
       simulation::ufs_mesh->count_sites(simulation::source_bank.data(),
@@ -611,6 +965,131 @@ double ufs_get_weight(const Particle& p)
   }
 }
 
+void init_fission_matrix()
+{
+  int n = simulation::entropy_mesh->n_bins();
+  if (n > FISSION_MATRIX_MAX_BINS) {
+    fatal_error(fmt::format("The entropy mesh has {} bins, but a fission "
+                            "matrix can be tallied on at most {} bins.",
+      n, FISSION_MATRIX_MAX_BINS));
+  }
+
+  simulation::fission_matrix = xt::zeros<double>({n, n});
+  simulation::fission_matrix_source = xt::zeros<double>({n});
+  fission_matrix_local = xt::zeros<double>({n, n});
+  fission_matrix_source_local = xt::zeros<double>({n});
+}
+
+void tally_fission_matrix()
+{
+  const auto* mesh = simulation::entropy_mesh;
+
+  // Find the mesh bin of each source site
+  int64_t n_source = simulation::work_per_rank;
+  vector<int> source_bin(n_source);
+#pragma omp parallel for
+  for (int64_t i = 0; i < n_source; ++i) {
+    source_bin[i] = mesh->get_bin(simulation::source_bank[i].r);
+  }
+  for (int64_t i = 0; i < n_source; ++i) {
+    if (source_bin[i] >= 0)
+      fission_matrix_source_local(source_bin[i]) +=
+        simulation::source_bank[i].wgt;
+  }
+
+  // The parent of each fission site is the source site of the same history,
+  // as in sort_fission_bank()
+  int64_t n_sites = simulation::fission_bank.size();
+#pragma omp parallel for
+  for (int64_t k = 0; k < n_sites; ++k) {
+    const auto& site = simulation::fission_bank[k];
+    int64_t offset = site.parent_id - 1 - simulation::work_index[mpi::rank];
+    int i = source_bin[offset];
+    int j = mesh->get_bin(site.r);
+    if (i >= 0 && j >= 0) {
+#pragma omp atomic
+      fission_matrix_local(j, i) += site.wgt;
+    }
+  }
+}
+
+void update_fission_matrix()
+{
+  // Sum the fission matrix over processes onto the master process
+#ifdef OPENMC_MPI
+  int n_matrix = fission_matrix_local.size();
+  int n_source = fission_matrix_source_local.size();
+  if (mpi::master) {
+    MPI_Reduce(MPI_IN_PLACE, fission_matrix_local.data(), n_matrix, MPI_DOUBLE,
+      MPI_SUM, 0, mpi::intracomm);
+    MPI_Reduce(MPI_IN_PLACE, fission_matrix_source_local.data(), n_source,
+      MPI_DOUBLE, MPI_SUM, 0, mpi::intracomm);
+  } else {
+    MPI_Reduce(fission_matrix_local.data(), nullptr, n_matrix, MPI_DOUBLE,
+      MPI_SUM, 0, mpi::intracomm);
+    MPI_Reduce(fission_matrix_source_local.data(), nullptr, n_source,
+      MPI_DOUBLE, MPI_SUM, 0, mpi::intracomm);
+  }
+#endif
+  if (mpi::master) {
+    simulation::fission_matrix += fission_matrix_local;
+    simulation::fission_matrix_source += fission_matrix_source_local;
+  }
+  fission_matrix_local.fill(0.0);
+  fission_matrix_source_local.fill(0.0);
+
+  if (settings::fission_matrix_interval == 0 ||
+      simulation::current_batch % settings::fission_matrix_interval != 0)
+    return;
+
+  // Get the weight of the new source in each mesh bin
+  finish_bank_exchange();
+  const auto* mesh = simulation::entropy_mesh;
+  int n = mesh->n_bins();
+  bool sites_outside;
+  xt::xtensor<double, 1> w = mesh->count_sites(
+    simulation::source_bank.data(), simulation::work_per_rank, &sites_outside);
+
+  // Determine the factor by which the weight of sites in each bin is changed.
+  // Only bins that hold source sites can be reweighted, so the eigenvector is
+  // normalized over those, and bins where the eigenvector is zero for lack of
+  // statistics are left as they are. The total weight is unchanged.
+  xt::xtensor<double, 1> factor = xt::ones<double>({n});
+  if (mpi::master) {
+    auto x = fission_matrix_eigenvector();
+    double w_total = 0.0;
+    double w_fixed = 0.0;
+    double x_total = 0.0;
+    for (int i = 0; i < n; ++i) {
+      if (w(i) <= 0.0)
+        continue;
+      w_total += w(i);
+      if (x(i) > 0.0) {
+        x_total += x(i);
+      } else {
+        w_fixed += w(i);
+      }
+    }
+    if (x_total > 0.0) {
+      for (int i = 0; i < n; ++i) {
+        if (w(i) > 0.0 && x(i) > 0.0)
+          factor(i) = x(i) / x_total * (w_total - w_fixed) / w(i);
+      }
+    }
+  }
+#ifdef OPENMC_MPI
+  MPI_Bcast(factor.data(), n, MPI_DOUBLE, 0, mpi::intracomm);
+#endif
+
+#pragma omp parallel for
+  for (int64_t i = 0; i < simulation::work_per_rank; ++i) {
+    auto& site = simulation::source_bank[i];
+    int bin = mesh->get_bin(site.r);
+    if (bin >= 0)
+      site.wgt *= factor(bin);
+  }
+}
+
 void write_eigenvalue_hdf5(hid_t group)
 {
   write_dataset(group, "n_inactive", settings::n_inactive);
@@ -625,6 +1104,11 @@ void write_eigenvalue_hdf5(hid_t group)
   array<double, 2> k_combined;
   openmc_get_keff(k_combined.data());
   write_dataset(group, "k_combined", k_combined);
+  if (settings::fission_matrix_on) {
+    write_dataset(group, "fission_matrix", normalized_fission_matrix());
+    write_dataset(
+      group, "fission_matrix_source", simulation::fission_matrix_source);
+  }
 }
 
 void read_eigenvalue_hdf5(hid_t group)
@@ -639,6 +1123,20 @@ void read_eigenvalue_hdf5(hid_t group)
   read_dataset(group, "k_col_abs", simulation::k_col_abs);
   read_dataset(group, "k_col_tra", simulation::k_col_tra);
   read_dataset(group, "k_abs_tra", simulation::k_abs_tra);
+  if (settings::fission_matrix_on && object_exists(group, "fission_matrix")) {
+    read_dataset(group, "fission_matrix", simulation::fission_matrix);
+    read_dataset(
+      group, "fission_matrix_source", simulation::fission_matrix_source);
+
+    // Undo the normalization per unit source weight
+    auto& m {simulation::fission_matrix};
+    const auto& source {simulation::fission_matrix_source};
+    for (int j = 0; j < source.size(); ++j) {
+      for (int i = 0; i < source.size(); ++i) {
+        m(j, i) *= source(i);
+      }
+    }
+  }
 }
 
 } // namespace openmc
@@ -1,6 +1,6 @@
 #include "openmc/endf.h"
 
-#include <algorithm> // for copy
+#include <algorithm> // for copy, lower_bound, min, max
 #include <cmath>     // for log, exp
 #include <iterator>  // for back_inserter
 #include <stdexcept> // for runtime_error
@@ -15,6 +15,13 @@
 
 namespace openmc {
 
+//==============================================================================
+// Constants
+//==============================================================================
+
+// Fewest pairs in a Tabulated1D for which a hash table is built
+constexpr std::size_t TABULATED_HASH_MIN_PAIRS {32};
+
 //==============================================================================
 // Functions
 //==============================================================================
@@ -160,6 +167,32 @@ Tabulated1D::Tabulated1D(hid_t dset)
   std::copy(xs.begin(), xs.end(), std::back_inserter(x_));
   std::copy(ys.begin(), ys.end(), std::back_inserter(y_));
   n_pairs_ = x_.size();
+
+  // A table with one region (or none, meaning lin-lin) doesn't need to look up
+  // the region of each bin
+  if (n_regions_ > 1) {
+    single_region_ = false;
+  } else if (n_regions_ == 1) {
+    interp_ = int_[0];
+  }
+
+  // Hash the abscissas on a logarithmic grid so that evaluating the function
+  // only searches the few pairs sharing the hash bin of x
+  if (n_pairs_ >= TABULATED_HASH_MIN_PAIRS && x_[0] > 0.0 &&
+      x_[n_pairs_ - 1] > x_[0]) {
+    std::size_t n_hash = n_pairs_;
+    hash_log_min_ = std::log(x_[0]);
+    hash_inv_width_ = n_hash / (std::log(x_[n_pairs_ - 1]) - hash_log_min_);
+    hash_index_.assign(n_hash + 1, 0);
+    for (std::size_t j = 0; j < n_pairs_; ++j) {
+      int b = (std::log(x_[j]) - hash_log_min_) * hash_inv_width_;
+      b = std::min(std::max(b, 0), static_cast<int>(n_hash) - 1);
+      ++hash_index_[b + 1];
+    }
+    for (std::size_t b = 0; b < n_hash; ++b) {
+      hash_index_[b + 1] += hash_index_[b];
+    }
+  }
 }
 
 double Tabulated1D::operator()(double x) const
@@ -172,14 +205,23 @@ double Tabulated1D::operator()(double x) const
     return y_[0];
   } else if (x > x_[n_pairs_ - 1]) {
     return y_[n_pairs_ - 1];
+  } else if (!hash_index_.empty()) {
+    // Abscissas in lower hash bins are below x and those in higher bins are
+    // above it, so only the pairs in the hash bin of x need to be searched
+    int b = (std::log(x) - hash_log_min_) * hash_inv_width_;
+    b = std::min(std::max(b, 0), static_cast<int>(hash_index_.size()) - 2);
+    int lo = std::max(hash_index_[b] - 1, 0);
+    auto it = std::lower_bound(
+      x_.begin() + lo, x_.begin() + hash_index_[b + 1], x);
+    i = std::max(static_cast<int>(it - x_.begin()) - 1, 0);
   } else {
     i = lower_bound_index(x_.begin(), x_.end(), x);
   }
 
   // determine interpolation scheme
   Interpolation interp;
-  if (n_regions_ == 0) {
-    interp = Interpolation::lin_lin;
+  if (single_region_) {
+    interp = interp_;
   } else {
     interp = int_[0];
     for (int j = 0; j < n_regions_; ++j) {
@@ -237,6 +279,39 @@ CoherentElasticXS::CoherentElasticXS(hid_t dset)
   // Copy Bragg edges and partial sums of structure factors
   std::copy(E.begin(), E.end(), std::back_inserter(bragg_edges_));
   std::copy(s.begin(), s.end(), std::back_inserter(factors_));
+
+  // Hash the Bragg edges on a grid that is uniform in energy, since the
+  // number of edges below E grows as E^(3/2) and so they are spread far more
+  // evenly in energy than in its logarithm
+  std::size_t n = bragg_edges_.size();
+  double width = bragg_edges_.back() - bragg_edges_.front();
+  if (n >= TABULATED_HASH_MIN_PAIRS && width > 0.0) {
+    hash_inv_width_ = n / width;
+    hash_index_.assign(n + 1, 0);
+    for (std::size_t j = 0; j < n; ++j) {
+      int b = (bragg_edges_[j] - bragg_edges_[0]) * hash_inv_width_;
+      b = std::min(std::max(b, 0), static_cast<int>(n) - 1);
+      ++hash_index_[b + 1];
+    }
+    for (std::size_t b = 0; b < n; ++b) {
+      hash_index_[b + 1] += hash_index_[b];
+    }
+  }
+}
+
+int CoherentElasticXS::bragg_index(double E) const
+{
+  if (hash_index_.empty())
+    return lower_bound_index(bragg_edges_.begin(), bragg_edges_.end(), E);
+
+  // Edges in lower hash bins are below E and those in higher bins are above
+  // it, so only the edges sharing the hash bin of E need to be searched
+  int b = (E - bragg_edges_[0]) * hash_inv_width_;
+  b = std::min(std::max(b, 0), static_cast<int>(hash_index_.size()) - 2);
+  int lo = std::max(hash_index_[b] - 1, 0);
+  auto it = std::lower_bound(
+    bragg_edges_.begin() + lo, bragg_edges_.begin() + hash_index_[b + 1], E);
+  return std::max(static_cast<int>(it - bragg_edges_.begin()) - 1, 0);
 }
 
 double CoherentElasticXS::operator()(double E) const
@@ -246,9 +321,7 @@ double CoherentElasticXS::operator()(double E) const
     // section will be zero
     return 0.0;
   } else {
-    auto i_grid =
-      lower_bound_index(bragg_edges_.begin(), bragg_edges_.end(), E);
-    return factors_[i_grid] / E;
+    return factors_[this->bragg_index(E)] / E;
   }
 }
 
@@ -1,6 +1,26 @@
 #include "openmc/event.h"
+
+#include <algorithm> // for fill, max, min, swap
+#include <cstring>   // for memcpy
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "openmc/census.h"
+#include "openmc/geometry.h"
 #include "openmc/material.h"
+#include "openmc/message_passing.h"
+#include "openmc/nuclide.h"
+#include "openmc/offload.h"
+#include "openmc/photon.h"
+#include "openmc/random_lcg.h"
+#include "openmc/settings.h"
 #include "openmc/simulation.h"
+#include "openmc/source.h"
+#include "openmc/tallies/derivative.h"
+#include "openmc/tallies/filter.h"
+#include "openmc/tallies/tally.h"
 #include "openmc/timer.h"
 
 namespace openmc {
@@ -16,24 +36,93 @@ SharedArray<EventQueueItem> calculate_nonfuel_xs_queue;
 SharedArray<EventQueueItem> advance_particle_queue;
 SharedArray<EventQueueItem> surface_crossing_queue;
 SharedArray<EventQueueItem> collision_queue;
+SharedArray<SecondaryQueueItem> secondary_queue;
+SharedArray<int64_t> free_particle_queue;
 
 vector<Particle> particles;
 
+array<EventKernelStats, N_EVENT_KERNELS> event_kernel_stats;
+
 } // namespace simulation
 
+namespace {
+
+// Sizes of the data that the particles in the buffer were constructed with
+array<size_t, 6> particle_sizes;
+
+//! Sizes of the data that a particle constructed now would hold
+array<size_t, 6> current_particle_sizes()
+{
+  size_t n_compact =
+    settings::compact_micro_xs ? simulation::n_micro_xs_compact : 0;
+  return {static_cast<size_t>(model::n_coord_levels),
+    model::tally_filters.size(), model::tally_derivs.size(), n_compact,
+    data::nuclides.size(), data::elements.size()};
+}
+
+//! Allocate a queue unless it already has room for n items
+template<typename T>
+void reserve_queue(SharedArray<T>& queue, int64_t n)
+{
+  if (queue.capacity() < n)
+    queue.reserve(n);
+  queue.resize(0);
+}
+
+} // namespace
+
 //==============================================================================
 // Non-member functions
 //==============================================================================
 
+//! Count a call of an event kernel and the particles it processes
+void record_event_kernel(EventKernel kernel, int64_t n)
+{
+  auto& stats = simulation::event_kernel_stats[static_cast<int>(kernel)];
+  ++stats.n_calls;
+  stats.n_particles += n;
+}
+
 void init_event_queues(int64_t n_particles)
 {
-  simulation::calculate_fuel_xs_queue.reserve(n_particles);
-  simulation::calculate_nonfuel_xs_queue.reserve(n_particles);
-  simulation::advance_particle_queue.reserve(n_particles);
-  simulation::surface_crossing_queue.reserve(n_particles);
-  simulation::collision_queue.reserve(n_particles);
+  // Queues and particles left from a previous simulation are reused
+  reserve_queue(simulation::calculate_fuel_xs_queue, n_particles);
+  reserve_queue(simulation::calculate_nonfuel_xs_queue, n_particles);
+  reserve_queue(simulation::advance_particle_queue, n_particles);
+  reserve_queue(simulation::surface_crossing_queue, n_particles);
+  reserve_queue(simulation::collision_queue, n_particles);
+
+  // Free slots are tracked when they can be refilled by queued secondaries or
+  // by new source particles
+  bool share_secondaries = settings::event_secondary_queue &&
+                           settings::run_mode == RunMode::FIXED_SOURCE;
+  if (share_secondaries) {
+    reserve_queue(simulation::secondary_queue, n_particles);
+  }
+  if (share_secondaries || settings::event_refill_threshold > 0.0) {
+    reserve_queue(simulation::free_particle_queue, n_particles);
+  }
+
+  simulation::event_kernel_stats = {};
 
+  // Particles are constructed again only if the data they hold has changed
+  // size, e.g. when tally filters or nuclides have been added
+  auto sizes = current_particle_sizes();
+  if (simulation::particles.size() == n_particles && sizes == particle_sizes)
+    return;
+  particle_sizes = sizes;
+  simulation::particles.clear();
   simulation::particles.resize(n_particles);
+
+  // Construct each particle again on the thread that owns its slot under a
+  // static schedule, so that its cross section caches and other heap-allocated
+  // data are placed in that thread's NUMA domain
+  if (settings::numa_first_touch) {
+#pragma omp parallel for schedule(static)
+    for (int64_t i = 0; i < n_particles; ++i) {
+      simulation::particles[i] = Particle();
+    }
+  }
 }
 
 void free_event_queues(void)
@@ -43,6 +132,8 @@ void free_event_queues(void)
   simulation::advance_particle_queue.clear();
   simulation::surface_crossing_queue.clear();
   simulation::collision_queue.clear();
+  simulation::secondary_queue.clear();
+  simulation::free_particle_queue.clear();
 
   simulation::particles.clear();
 }
@@ -61,38 +152,485 @@ void dispatch_xs_event(int64_t buffer_idx)
 void process_init_events(int64_t n_particles, int64_t source_offset)
 {
   simulation::time_event_init.start();
+  record_event_kernel(EventKernel::INIT, n_particles);
+  if (settings::run_mode == RunMode::FIXED_SOURCE &&
+      simulation::current_census == 0) {
+    // Source sites are sampled for a batch of particles at a time so that the
+    // source distributions are sampled in SIMD lanes
+#pragma omp parallel
+    {
+      vector<SourceSite> sites(EXTSRC_BATCH_SIZE);
+#pragma omp for schedule(runtime)
+      for (int64_t i = 0; i < n_particles; i += EXTSRC_BATCH_SIZE) {
+        int64_t n = std::min<int64_t>(EXTSRC_BATCH_SIZE, n_particles - i);
+        sample_external_sources(
+          fixed_source_id(source_offset + i + 1), n, sites.data());
+        for (int64_t j = 0; j < n; ++j) {
+          initialize_history(
+            simulation::particles[i + j], source_offset + i + j + 1, &sites[j]);
+          dispatch_xs_event(i + j);
+        }
+      }
+    }
+  } else {
 #pragma omp parallel for schedule(runtime)
-  for (int64_t i = 0; i < n_particles; i++) {
-    initialize_history(simulation::particles[i], source_offset + i + 1);
-    dispatch_xs_event(i);
+    for (int64_t i = 0; i < n_particles; i++) {
+      initialize_history(simulation::particles[i], source_offset + i + 1);
+      dispatch_xs_event(i);
+    }
   }
   simulation::time_event_init.stop();
 }
 
+void revive_from_secondary(int64_t buffer_idx)
+{
+  Particle& p = simulation::particles[buffer_idx];
+
+  // Queue the secondaries of a dead particle, except when its track is being
+  // written since the track should contain them or when pulse-height tallies
+  // need the energy deposited by the whole history in one slot. If the queue
+  // is full, the remaining secondaries are tracked in this slot.
+  if (simulation::secondary_queue.capacity() > 0 && !p.alive() &&
+      !p.write_track() && model::active_pulse_height_tallies.empty()) {
+    auto& bank = p.secondary_bank();
+    while (!bank.empty()) {
+      SecondaryQueueItem item;
+      item.site = bank.back();
+      item.id = p.id();
+      item.stream_id =
+        future_seed(bank.size(), p.seeds(STREAM_TRACKING)) >> 1;
+      item.n_split = p.n_split();
+      item.ww_factor = p.ww_factor();
+      if (simulation::secondary_queue.thread_safe_append(item) < 0)
+        break;
+      bank.pop_back();
+    }
+  }
+
+  p.event_revive_from_secondary();
+  if (p.alive()) {
+    dispatch_xs_event(buffer_idx);
+  } else if (simulation::free_particle_queue.capacity() > 0) {
+    simulation::free_particle_queue.thread_safe_append(buffer_idx);
+  }
+}
+
+int64_t n_secondary_init_events()
+{
+  return std::min(simulation::secondary_queue.size(),
+    simulation::free_particle_queue.size());
+}
+
+void process_secondary_init_events()
+{
+  simulation::time_event_init.start();
+
+  // Take secondaries and slots from the ends of their queues
+  int64_t n = n_secondary_init_events();
+  int64_t n_queued = simulation::secondary_queue.size() - n;
+  int64_t n_free = simulation::free_particle_queue.size() - n;
+  record_event_kernel(EventKernel::SECONDARY_INIT, n);
+
+#pragma omp parallel for schedule(runtime)
+  for (int64_t i = 0; i < n; i++) {
+    const auto& item = simulation::secondary_queue[n_queued + i];
+    int64_t buffer_idx = simulation::free_particle_queue[n_free + i];
+    Particle& p = simulation::particles[buffer_idx];
+
+    // Finish the history that occupied the slot before reusing it
+    p.event_death();
+
+    p.from_source(&item.site);
+    p.id() = item.id;
+    p.current_work() = item.id - simulation::work_index[mpi::rank];
+    init_particle_seeds(item.stream_id, p.seeds());
+    p.stream() = STREAM_TRACKING;
+    p.n_split() = item.n_split;
+    p.ww_factor() = item.ww_factor;
+    p.n_event() = 0;
+    p.write_track() = false;
+    dispatch_xs_event(buffer_idx);
+  }
+
+  simulation::secondary_queue.resize(n_queued);
+  simulation::free_particle_queue.resize(n_free);
+
+  simulation::time_event_init.stop();
+}
+
+int64_t process_refill_events(
+  int64_t n_particles, int64_t n_work, int64_t source_offset)
+{
+  if (settings::event_refill_threshold <= 0.0)
+    return 0;
+
+  // Only refill once enough of the buffer is free
+  int64_t n_free = simulation::free_particle_queue.size();
+  if (n_particles - n_free >= settings::event_refill_threshold * n_particles)
+    return 0;
+
+  // Queued secondaries take free slots before new source particles
+  int64_t n = std::min(
+    n_work, std::max<int64_t>(n_free - simulation::secondary_queue.size(), 0));
+  if (n == 0)
+    return 0;
+  n_free -= n;
+
+  simulation::time_event_init.start();
+  record_event_kernel(EventKernel::INIT, n);
+
+#pragma omp parallel for schedule(runtime)
+  for (int64_t i = 0; i < n; i++) {
+    int64_t buffer_idx = simulation::free_particle_queue[n_free + i];
+    Particle& p = simulation::particles[buffer_idx];
+
+    // Finish the history that occupied the slot before reusing it
+    p.event_death();
+
+    initialize_history(p, source_offset + i + 1);
+    dispatch_xs_event(buffer_idx);
+  }
+
+  simulation::free_particle_queue.resize(n_free);
+
+  simulation::time_event_init.stop();
+  return n;
+}
+
+//! Length of the longest event queue
+int64_t max_event_queue_size()
+{
+  return std::max({simulation::calculate_fuel_xs_queue.size(),
+    simulation::calculate_nonfuel_xs_queue.size(),
+    simulation::advance_particle_queue.size(),
+    simulation::surface_crossing_queue.size(),
+    simulation::collision_queue.size(), n_secondary_init_events()});
+}
+
+//! Execute the kernel with the longest queue
+bool process_longest_event()
+{
+  int64_t max = max_event_queue_size();
+  if (max == 0) {
+    return false;
+  } else if (max == simulation::calculate_fuel_xs_queue.size()) {
+    process_calculate_xs_events(simulation::calculate_fuel_xs_queue);
+  } else if (max == simulation::calculate_nonfuel_xs_queue.size()) {
+    process_calculate_xs_events(simulation::calculate_nonfuel_xs_queue);
+  } else if (max == simulation::advance_particle_queue.size()) {
+    process_advance_particle_events();
+  } else if (max == simulation::surface_crossing_queue.size()) {
+    process_surface_crossing_events();
+  } else if (max == simulation::collision_queue.size()) {
+    process_collision_events();
+  } else if (max == n_secondary_init_events()) {
+    process_secondary_init_events();
+  }
+  return true;
+}
+
+//! Execute each kernel in the order that particles move through them, skipping
+//! kernels whose queues are shorter than settings::event_min_queue_size. The
+//! two cross section queues are processed together.
+bool process_ordered_events()
+{
+  int64_t max = max_event_queue_size();
+  if (max == 0)
+    return false;
+
+  // Once no queue is long enough, the few particles left in flight are
+  // finished regardless of the queue sizes
+  int64_t min_size = std::max<int64_t>(settings::event_min_queue_size, 1);
+  if (max < min_size)
+    min_size = 1;
+
+  auto& fuel_queue = simulation::calculate_fuel_xs_queue;
+  auto& nonfuel_queue = simulation::calculate_nonfuel_xs_queue;
+  if (fuel_queue.size() + nonfuel_queue.size() >= min_size) {
+    if (fuel_queue.size() > 0)
+      process_calculate_xs_events(fuel_queue);
+    if (nonfuel_queue.size() > 0)
+      process_calculate_xs_events(nonfuel_queue);
+  }
+  if (simulation::advance_particle_queue.size() >= min_size)
+    process_advance_particle_events();
+  if (simulation::surface_crossing_queue.size() >= min_size)
+    process_surface_crossing_events();
+  if (simulation::collision_queue.size() >= min_size)
+    process_collision_events();
+  if (n_secondary_init_events() >= min_size)
+    process_secondary_init_events();
+  return true;
+}
+
+//! Key that orders queue items like EventQueueItem::operator<, except that
+//! energies are only compared to about six significant digits. Energies are
+//! positive, so the upper half of their bit patterns orders them the same way
+//! as their values. Material indices, shifted so that void is zero, are
+//! assumed to fit in 24 bits.
+uint64_t event_sort_key(const EventQueueItem& item)
+{
+  uint64_t energy_bits;
+  std::memcpy(&energy_bits, &item.E, sizeof(double));
+  return (static_cast<uint64_t>(item.type) << 56) |
+         (static_cast<uint64_t>(item.material + 1) << 32) |
+         (energy_bits >> 32);
+}
+
+void sort_event_queue(SharedArray<EventQueueItem>& queue)
+{
+  int64_t n = queue.size();
+  if (n < 2 || n < settings::event_sort_threshold)
+    return;
+
+  simulation::time_event_sort.start();
+
+  vector<uint64_t> keys(n);
+  vector<uint64_t> keys_out(n);
+  vector<EventQueueItem> items_out(n);
+  uint64_t* k_in = keys.data();
+  uint64_t* k_out = keys_out.data();
+  EventQueueItem* in = queue.data();
+  EventQueueItem* out = items_out.data();
+
+  // Number of items with each digit in each thread's chunk, which is turned
+  // into the position where the thread writes the next item with that digit
+  constexpr int N_DIGITS {256};
+  vector<int64_t> offsets;
+  bool skip_pass;
+
+#pragma omp parallel
+  {
+#ifdef _OPENMP
+    int n_threads = omp_get_num_threads();
+    int tid = omp_get_thread_num();
+#else
+    int n_threads = 1;
+    int tid = 0;
+#endif
+
+#pragma omp single
+    offsets.resize(n_threads * N_DIGITS);
+
+    int64_t i_begin = n * tid / n_threads;
+    int64_t i_end = n * (tid + 1) / n_threads;
+    for (int64_t i = i_begin; i < i_end; i++) {
+      k_in[i] = event_sort_key(in[i]);
+    }
+
+    // Least significant digit radix sort, one byte at a time. Each thread
+    // keeps the same chunk in every pass, which keeps the sort stable.
+    for (int shift = 0; shift < 64; shift += 8) {
+      int64_t* offset = &offsets[tid * N_DIGITS];
+      std::fill(offset, offset + N_DIGITS, 0);
+      for (int64_t i = i_begin; i < i_end; i++) {
+        ++offset[(k_in[i] >> shift) & 0xff];
+      }
+
+#pragma omp barrier
+#pragma omp single
+      {
+        // Items are ordered by digit, then by thread. A pass where all items
+        // have the same digit, such as the particle type in most problems,
+        // would not move any items.
+        skip_pass = false;
+        int64_t total = 0;
+        for (int d = 0; d < N_DIGITS; d++) {
+          int64_t start = total;
+          for (int t = 0; t < n_threads; t++) {
+            int64_t count = offsets[t * N_DIGITS + d];
+            offsets[t * N_DIGITS + d] = total;
+            total += count;
+          }
+          if (total - start == n)
+            skip_pass = true;
+        }
+      }
+
+      if (!skip_pass) {
+        for (int64_t i = i_begin; i < i_end; i++) {
+          int64_t j = offset[(k_in[i] >> shift) & 0xff]++;
+          k_out[j] = k_in[i];
+          out[j] = in[i];
+        }
+
+#pragma omp barrier
+#pragma omp single
+        {
+          std::swap(k_in, k_out);
+          std::swap(in, out);
+        }
+      }
+    }
+
+    // Copy the items back if the last pass that moved them wrote them to
+    // the temporary array
+    if (in != queue.data()) {
+      for (int64_t i = i_begin; i < i_end; i++) {
+        queue[i] = in[i];
+      }
+    }
+  }
+
+  simulation::time_event_sort.stop();
+}
+
+bool process_next_events()
+{
+  switch (settings::event_schedule) {
+  case EventSchedule::ORDERED:
+    return process_ordered_events();
+  default:
+    return process_longest_event();
+  }
+}
+
+void calculate_xs_batched(SharedArray<EventQueueItem>& queue)
+{
+  int64_t n = queue.size();
+
+  // Locating a particle may change its material, so queue items are refreshed
+  // after preparing each particle. Particles that don't need a lookup are
+  // marked as being in void.
+#pragma omp parallel for schedule(runtime)
+  for (int64_t i = 0; i < n; i++) {
+    int64_t buffer_idx = queue[i].idx;
+    Particle& p = simulation::particles[buffer_idx];
+    bool lookup = p.prepare_calculate_xs();
+    queue[i] = {p, buffer_idx};
+    if (!lookup)
+      queue[i].material = MATERIAL_VOID;
+  }
+
+  // Sort by particle type, material, and energy so that runs of particles in
+  // the same material are contiguous. Unsorted queues just have shorter runs.
+  sort_event_queue(queue);
+
+  // Split the queue into runs of the same particle type and material
+  vector<int64_t> run_start;
+  for (int64_t i = 0; i < n; i++) {
+    if (i == 0 || queue[i].type != queue[i - 1].type ||
+        queue[i].material != queue[i - 1].material ||
+        i - run_start.back() == settings::event_xs_batch_size) {
+      run_start.push_back(i);
+    }
+  }
+  run_start.push_back(n);
+  int64_t n_runs = run_start.size() - 1;
+
+#pragma omp parallel
+  {
+    vector<Particle*> batch;
+
+#pragma omp for schedule(runtime)
+    for (int64_t r = 0; r < n_runs; r++) {
+      const auto& first = queue[run_start[r]];
+      if (first.material == MATERIAL_VOID)
+        continue;
+
+      batch.clear();
+      for (int64_t i = run_start[r]; i < run_start[r + 1]; i++) {
+        batch.push_back(&simulation::particles[queue[i].idx]);
+      }
+
+      const auto& mat {model::materials[first.material]};
+      if (first.type == ParticleType::neutron) {
+        mat->calculate_xs(batch);
+      } else {
+        for (auto* p : batch) {
+          mat->calculate_xs(*p);
+        }
+      }
+    }
+  }
+}
+
+void calculate_xs_offload(SharedArray<EventQueueItem>& queue)
+{
+  int64_t n = queue.size();
+  vector<int> table(n);
+
+  // Prepare particles on the host and find which can use tabulated cross
+  // sections. The others, e.g. photons or neutrons at energies with S(a,b) or
+  // probability table data, are handled on the host right away.
+#pragma omp parallel for schedule(runtime)
+  for (int64_t i = 0; i < n; i++) {
+    Particle& p = simulation::particles[queue[i].idx];
+    table[i] = C_NONE;
+    if (!p.prepare_calculate_xs())
+      continue;
+
+    const auto& mat {model::materials[p.material()]};
+    int i_table = C_NONE;
+    if (p.type() == ParticleType::neutron)
+      i_table = mat->macro_xs_table(p);
+    if (i_table == C_NONE) {
+      mat->calculate_xs(p);
+      continue;
+    }
+
+    p.enter_material_neutron_xs(p.material());
+    p.xs_cdf().clear();
+    table[i] = offload_table_index(p.material(), i_table);
+  }
+
+  // Only the particles using a table are sent to the device
+  vector<int64_t> lookup;
+  vector<int> lookup_table;
+  vector<double> lookup_E;
+  for (int64_t i = 0; i < n; i++) {
+    if (table[i] == C_NONE)
+      continue;
+    lookup.push_back(queue[i].idx);
+    lookup_table.push_back(table[i]);
+    lookup_E.push_back(simulation::particles[queue[i].idx].E());
+  }
+  int64_t m = lookup.size();
+  vector<double> xs(4 * m);
+  offload_tabulated_xs(m, lookup_table.data(), lookup_E.data(), xs.data());
+
+#pragma omp parallel for schedule(runtime)
+  for (int64_t i = 0; i < m; i++) {
+    Particle& p = simulation::particles[lookup[i]];
+    p.macro_xs().total = xs[4 * i];
+    p.macro_xs().absorption = xs[4 * i + 1];
+    p.macro_xs().fission = xs[4 * i + 2];
+    p.macro_xs().nu_fission = xs[4 * i + 3];
+  }
+}
+
 void process_calculate_xs_events(SharedArray<EventQueueItem>& queue)
 {
   simulation::time_event_calculate_xs.start();
-
-  // TODO: If using C++17, perform a parallel sort of the queue
-  // by particle type, material type, and then energy, in order to
-  // improve cache locality and reduce thread divergence on GPU. Prior
-  // to C++17, std::sort is a serial only operation, which in this case
-  // makes it too slow to be practical for most test problems.
-  //
-  // std::sort(std::execution::par_unseq, queue.data(), queue.data() +
-  // queue.size());
+  record_event_kernel(&queue == &simulation::calculate_fuel_xs_queue
+                        ? EventKernel::CALCULATE_FUEL_XS
+                        : EventKernel::CALCULATE_NONFUEL_XS,
+    queue.size());
 
   int64_t offset = simulation::advance_particle_queue.size();
-  ;
+
+  if (offload_active()) {
+    calculate_xs_offload(queue);
+  } else if (settings::event_xs_batch_size > 0 && settings::run_CE) {
+    calculate_xs_batched(queue);
+  } else {
+    // Sorting by particle type, material, and energy improves the cache
+    // locality of the lookups, which is worth it for long queues only
+    if (settings::event_sort_threshold > 0)
+      sort_event_queue(queue);
 
 #pragma omp parallel for schedule(runtime)
-  for (int64_t i = 0; i < queue.size(); i++) {
-    Particle* p = &simulation::particles[queue[i].idx];
-    p->event_calculate_xs();
+    for (int64_t i = 0; i < queue.size(); i++) {
+      Particle* p = &simulation::particles[queue[i].idx];
+      p->event_calculate_xs();
+    }
+  }
 
-    // After executing a calculate_xs event, particles will
-    // always require an advance event. Therefore, we don't need to use
-    // the protected enqueuing function.
+  // After executing a calculate_xs event, particles will always require an
+  // advance event. Therefore, we don't need to use the protected enqueuing
+  // function.
+#pragma omp parallel for schedule(runtime)
+  for (int64_t i = 0; i < queue.size(); i++) {
     simulation::advance_particle_queue[offset + i] = queue[i];
   }
 
@@ -106,6 +644,8 @@ void process_calculate_xs_events(SharedArray<EventQueueItem>& queue)
 void process_advance_particle_events()
 {
   simulation::time_event_advance_particle.start();
+  record_event_kernel(
+    EventKernel::ADVANCE_PARTICLE, simulation::advance_particle_queue.size());
 
 #pragma omp parallel for schedule(runtime)
   for (int64_t i = 0; i < simulation::advance_particle_queue.size(); i++) {
@@ -119,23 +659,57 @@ void process_advance_particle_events()
     }
   }
 
+  simulation::time_event_advance_particle.stop();
+
+  process_tally_events(simulation::advance_particle_queue,
+    &Particle::event_tally_advance<FEATURE_ALL>);
+
   simulation::advance_particle_queue.resize(0);
+}
 
-  simulation::time_event_advance_particle.stop();
+void process_tally_events(
+  SharedArray<EventQueueItem>& queue, void (Particle::*score)())
+{
+  simulation::time_event_tally.start();
+
+  int64_t n = queue.size();
+
+  // Sort by particle type, material, and energy so that particles scoring to
+  // the same filter bins are next to each other. Queue items are refreshed
+  // first since a collision changes the particle's energy.
+  if (!model::active_tallies.empty()) {
+#pragma omp parallel for schedule(runtime)
+    for (int64_t i = 0; i < n; i++) {
+      int64_t buffer_idx = queue[i].idx;
+      queue[i] = {simulation::particles[buffer_idx], buffer_idx};
+    }
+    sort_event_queue(queue);
+  }
+
+  // A static schedule gives each thread a contiguous range of the sorted
+  // queue, so threads mostly score to different bins and the atomic updates
+  // of the tally results rarely contend
+#pragma omp parallel for schedule(static)
+  for (int64_t i = 0; i < n; i++) {
+    Particle& p = simulation::particles[queue[i].idx];
+    (p.*score)();
+  }
+
+  simulation::time_event_tally.stop();
 }
 
 void process_surface_crossing_events()
 {
   simulation::time_event_surface_crossing.start();
+  record_event_kernel(
+    EventKernel::SURFACE_CROSSING, simulation::surface_crossing_queue.size());
 
 #pragma omp parallel for schedule(runtime)
   for (int64_t i = 0; i < simulation::surface_crossing_queue.size(); i++) {
     int64_t buffer_idx = simulation::surface_crossing_queue[i].idx;
     Particle& p = simulation::particles[buffer_idx];
     p.event_cross_surface();
-    p.event_revive_from_secondary();
-    if (p.alive())
-      dispatch_xs_event(buffer_idx);
+    revive_from_secondary(buffer_idx);
   }
 
   simulation::surface_crossing_queue.resize(0);
@@ -146,15 +720,27 @@ void process_surface_crossing_events()
 void process_collision_events()
 {
   simulation::time_event_collision.start();
+  record_event_kernel(
+    EventKernel::COLLISION, simulation::collision_queue.size());
 
 #pragma omp parallel for schedule(runtime)
   for (int64_t i = 0; i < simulation::collision_queue.size(); i++) {
     int64_t buffer_idx = simulation::collision_queue[i].idx;
     Particle& p = simulation::particles[buffer_idx];
     p.event_collide();
-    p.event_revive_from_secondary();
-    if (p.alive())
-      dispatch_xs_event(buffer_idx);
+  }
+
+  simulation::time_event_collision.stop();
+
+  process_tally_events(
+    simulation::collision_queue, &Particle::event_tally_collision<FEATURE_ALL>);
+
+  simulation::time_event_collision.start();
+
+#pragma omp parallel for schedule(runtime)
+  for (int64_t i = 0; i < simulation::collision_queue.size(); i++) {
+    int64_t buffer_idx = simulation::collision_queue[i].idx;
+    revive_from_secondary(buffer_idx);
   }
 
   simulation::collision_queue.resize(0);
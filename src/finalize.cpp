@@ -2,25 +2,32 @@
 
 #include "openmc/bank.h"
 #include "openmc/capi.h"
+#include "openmc/census.h"
 #include "openmc/cmfd_solver.h"
 #include "openmc/constants.h"
 #include "openmc/cross_sections.h"
 #include "openmc/dagmc.h"
+#include "openmc/delta_tracking.h"
 #include "openmc/eigenvalue.h"
 #include "openmc/event.h"
 #include "openmc/geometry.h"
 #include "openmc/geometry_aux.h"
+#include "openmc/majorant.h"
 #include "openmc/material.h"
+#include "openmc/memory_usage.h"
 #include "openmc/mesh.h"
 #include "openmc/message_passing.h"
 #include "openmc/nuclide.h"
 #include "openmc/photon.h"
 #include "openmc/plot.h"
 #include "openmc/random_lcg.h"
+#include "openmc/random_ray.h"
 #include "openmc/settings.h"
 #include "openmc/simulation.h"
 #include "openmc/source.h"
+#include "openmc/state_point.h"
 #include "openmc/surface.h"
+#include "openmc/tallies/flux_spectrum.h"
 #include "openmc/tallies/tally.h"
 #include "openmc/thermal.h"
 #include "openmc/timer.h"
@@ -38,6 +45,9 @@ void free_memory()
   free_memory_material();
   free_memory_volume();
   free_memory_simulation();
+  free_memory_census();
+  free_memory_delta_tracking();
+  free_memory_majorant();
   free_memory_photon();
   free_memory_settings();
   free_memory_thermal();
@@ -48,6 +58,7 @@ void free_memory()
   free_memory_tally();
   free_memory_bank();
   free_memory_plot();
+  free_memory_random_ray();
   free_memory_weight_windows();
   if (mpi::master) {
     free_memory_cmfd();
@@ -63,35 +74,70 @@ using namespace openmc;
 
 int openmc_finalize()
 {
+  // Make sure no file is still being written in the background
+  finish_async_writes();
+
   // Clear results
   openmc_reset();
 
-  // Reset timers
+  // Reset timers and memory accounting
   reset_timers();
+  reset_memory_usage();
 
   // Reset global variables
   settings::assume_separate = false;
+  settings::async_statepoint = false;
+  settings::auto_tune = false;
   settings::check_overlaps = false;
+  settings::condense_relaxation = false;
   settings::confidence_intervals = false;
   settings::create_fission_neutrons = true;
+  settings::crossing_recovery = false;
+  settings::crossing_recovery_distance = 1.0e-6;
   settings::electron_treatment = ElectronTreatment::LED;
+  settings::electron_step_fraction = 0.2;
   settings::delayed_photon_scaling = true;
+  settings::delta_tracking = false;
+  settings::delta_tracking_max_ratio = 10.0;
   settings::energy_cutoff = {0.0, 1000.0, 0.0, 0.0};
   settings::entropy_on = false;
   settings::event_based = false;
+  settings::event_min_queue_size = 0;
+  settings::event_refill_threshold = 0.0;
+  settings::event_schedule = EventSchedule::LONGEST;
+  settings::event_secondary_queue = false;
+  settings::event_sort_threshold = 0;
+  settings::fission_matrix_interval = 0;
+  settings::fission_matrix_on = false;
   settings::gen_per_batch = 1;
+  settings::history_schedule = HistorySchedule::LOOP;
+  settings::huge_pages = false;
+  settings::ifp_n_generation = 0;
+  settings::lattice_dda = false;
+  settings::io_stripe_size = 0;
   settings::legendre_to_tabular = true;
   settings::legendre_to_tabular_points = -1;
   settings::material_cell_offsets = true;
+  settings::mmap_source_files = false;
+  settings::mpi_progress_thread = false;
+  settings::numa_first_touch = false;
   settings::max_particles_in_flight = 100000;
   settings::max_splits = 1000;
   settings::max_tracks = 1000;
   settings::n_inactive = 0;
   settings::n_particles = -1;
   settings::output_summary = true;
+  settings::overlap_check_crossings = false;
+  settings::overlap_check_fraction = 1.0;
   settings::output_tallies = true;
   settings::particle_restart_run = false;
+  settings::partition_source_files = false;
+  settings::photon_scattering_tables = false;
   settings::photon_transport = false;
+  settings::pipelined_bank = false;
+  settings::precompute_neighbors = false;
+  settings::profile = false;
+  settings::profile_domains = false;
   settings::reduce_tallies = true;
   settings::res_scat_on = false;
   settings::res_scat_method = ResScatMethod::rvs;
@@ -100,15 +146,32 @@ int openmc_finalize()
   settings::restart_run = false;
   settings::run_CE = true;
   settings::run_mode = RunMode::UNSET;
+  settings::secondary_bank_capacity = 1000;
+  settings::source_compression = 0;
   settings::source_latest = false;
   settings::source_separate = false;
+  settings::source_single_precision = false;
   settings::source_write = true;
+  settings::summary_compact = false;
+  settings::summary_reuse = false;
   settings::survival_biasing = false;
+  settings::tallies_out_max_bins = 0;
+  settings::tally_rank_files = false;
+  settings::tally_reduce_interval = 1;
+  settings::tally_stream = false;
+  settings::tally_stream_path.clear();
+  settings::tally_stream_tallies.clear();
   settings::temperature_default = 293.6;
   settings::temperature_method = TemperatureMethod::NEAREST;
   settings::temperature_multipole = false;
+  settings::temperature_multipole_quadrature = false;
   settings::temperature_range = {0.0, 0.0};
   settings::temperature_tolerance = 10.0;
+  settings::track_compression = 0;
+  settings::track_delta_positions = false;
+  settings::track_fraction = 1.0;
+  settings::track_single_precision = false;
+  settings::track_writer_thread = false;
   settings::trigger_on = false;
   settings::trigger_predict = false;
   settings::trigger_batch_interval = 1;
@@ -117,7 +180,10 @@ int openmc_finalize()
   settings::verbosity = 7;
   settings::weight_cutoff = 0.25;
   settings::weight_survive = 1.0;
+  settings::weight_window_mesh_crossings = false;
   settings::weight_windows_on = false;
+  settings::wielandt_shift = 0.0;
+  settings::work_chunk_size = 0;
   settings::write_all_tracks = false;
   settings::write_initial_source = false;
 
@@ -147,6 +213,14 @@ int openmc_finalize()
 #ifdef OPENMC_MPI
   if (mpi::source_site != MPI_DATATYPE_NULL)
     MPI_Type_free(&mpi::source_site);
+  if (mpi::compact_source_site != MPI_DATATYPE_NULL)
+    MPI_Type_free(&mpi::compact_source_site);
+  if (mpi::ifp_ancestry != MPI_DATATYPE_NULL)
+    MPI_Type_free(&mpi::ifp_ancestry);
+  if (mpi::node_intracomm != MPI_COMM_NULL)
+    MPI_Comm_free(&mpi::node_intracomm);
+  if (mpi::leader_intracomm != MPI_COMM_NULL)
+    MPI_Comm_free(&mpi::leader_intracomm);
 #endif
 
   return 0;
@@ -155,15 +229,17 @@ int openmc_finalize()
 int openmc_reset()
 {
 
-  model::universe_cell_counts.clear();
   model::universe_level_counts.clear();
 
   for (auto& t : model::tallies) {
     t->reset();
   }
+  model::flux_spectrum.reset();
 
   // Reset global tallies
   simulation::n_realizations = 0;
+  simulation::n_unreduced_batches = 0;
+  simulation::wielandt_weight_unreduced = 0.0;
   xt::view(simulation::global_tallies, xt::all()) = 0.0;
 
   simulation::k_col_abs = 0.0;
@@ -175,6 +251,9 @@ int openmc_reset()
   settings::cmfd_run = false;
 
   simulation::n_lost_particles = 0;
+  simulation::n_res_scat_samples = 0;
+  simulation::n_res_scat_trials = 0;
+  simulation::n_majorant_violations = 0;
 
   return 0;
 }
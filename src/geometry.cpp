@@ -1,5 +1,11 @@
 #include "openmc/geometry.h"
 
+#include <algorithm> // for fill
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <fmt/core.h>
 #include <fmt/ostream.h>
 
@@ -8,10 +14,12 @@
 #include "openmc/constants.h"
 #include "openmc/error.h"
 #include "openmc/lattice.h"
+#include "openmc/profile.h"
 #include "openmc/settings.h"
 #include "openmc/simulation.h"
 #include "openmc/string_utils.h"
 #include "openmc/surface.h"
+#include "openmc/universe.h"
 
 namespace openmc {
 
@@ -25,6 +33,7 @@ int root_universe {-1};
 int n_coord_levels;
 
 vector<int64_t> overlap_check_count;
+vector<vector<int64_t>> overlap_check_count_thread;
 
 } // namespace model
 
@@ -36,12 +45,33 @@ bool check_cell_overlap(Particle& p, bool error)
 {
   int n_coord = p.n_coord();
 
+  // Counts are kept per thread and added up at the end of each batch rather
+  // than incremented atomically in the shared vector
+#ifdef _OPENMP
+  auto& count = model::overlap_check_count_thread[omp_get_thread_num()];
+#else
+  auto& count = model::overlap_check_count_thread[0];
+#endif
+
+  // Cells whose bounding boxes contain the particle in a universe with a BVH
+  thread_local vector<int32_t> candidates;
+
   // Loop through each coordinate level
   for (int j = 0; j < n_coord; j++) {
     Universe& univ = *model::universes[p.coord(j).universe];
 
+    // Only cells whose bounding boxes contain the particle can overlap it. The
+    // BVH of a DAGMC universe leaves out the implicit complement, so every
+    // cell is checked there.
+    const vector<int32_t>* cells = &univ.cells_;
+    if (univ.bvh_ && univ.geom_type() == GeometryType::CSG) {
+      candidates.clear();
+      univ.bvh_->find_candidates(p.coord(j).r, candidates);
+      cells = &candidates;
+    }
+
     // Loop through each cell on this level
-    for (auto index_cell : univ.cells_) {
+    for (auto index_cell : *cells) {
       Cell& c = *model::cells[index_cell];
       if (c.contains(p.coord(j).r, p.coord(j).u, p.surface())) {
         if (index_cell != p.coord(j).cell) {
@@ -52,8 +82,7 @@ bool check_cell_overlap(Particle& p, bool error)
           }
           return true;
         }
-#pragma omp atomic
-        ++model::overlap_check_count[index_cell];
+        ++count[index_cell];
       }
     }
   }
@@ -61,6 +90,48 @@ bool check_cell_overlap(Particle& p, bool error)
   return false;
 }
 
+bool sample_overlap_check(const Particle& p, bool crossed)
+{
+  if (settings::overlap_check_crossings && !crossed)
+    return false;
+  if (settings::overlap_check_fraction >= 1.0)
+    return true;
+
+  // Hash the particle ID and event number instead of sampling a random number
+  // so that the particle's random number streams are the same whether or not
+  // overlaps are checked
+  uint64_t x = static_cast<uint64_t>(p.id()) * 0x9e3779b97f4a7c15ULL +
+               static_cast<uint64_t>(p.n_event());
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return (x >> 11) * (1.0 / 9007199254740992.0) <
+         settings::overlap_check_fraction;
+}
+
+void init_overlap_check_count()
+{
+#ifdef _OPENMP
+  int n_threads = omp_get_max_threads();
+#else
+  int n_threads = 1;
+#endif
+  model::overlap_check_count.resize(model::cells.size(), 0);
+  if (model::overlap_check_count_thread.size() < n_threads)
+    model::overlap_check_count_thread.resize(n_threads);
+  for (auto& count : model::overlap_check_count_thread)
+    count.resize(model::cells.size(), 0);
+}
+
+void reduce_overlap_check_count()
+{
+  for (auto& count : model::overlap_check_count_thread) {
+    for (int i = 0; i < count.size(); ++i)
+      model::overlap_check_count[i] += count[i];
+    std::fill(count.begin(), count.end(), 0);
+  }
+}
+
 //==============================================================================
 
 int cell_instance_at_level(const Particle& p, int level)
@@ -73,12 +144,18 @@ int cell_instance_at_level(const Particle& p, int level)
   }
 
   // determine the cell instance
-  Cell& c {*model::cells[p.coord(level).cell]};
+  const auto& coord {p.coord(level)};
+  Cell& c {*model::cells[coord.cell]};
 
   // quick exit if this cell doesn't have distribcell instances
   if (c.distribcell_index_ == C_NONE)
     return C_NONE;
 
+  // use the instance computed earlier at this location if there is one
+  if (coord.instance_cell == coord.cell &&
+      coord.instance_lattice_i == coord.lattice_i)
+    return coord.instance;
+
   // compute the cell's instance
   int instance = 0;
   for (int i = 0; i < level; i++) {
@@ -94,6 +171,10 @@ int cell_instance_at_level(const Particle& p, int level)
       }
     }
   }
+
+  coord.instance = instance;
+  coord.instance_cell = coord.cell;
+  coord.instance_lattice_i = coord.lattice_i;
   return instance;
 }
 
@@ -101,6 +182,9 @@ int cell_instance_at_level(const Particle& p, int level)
 
 bool find_cell_inner(Particle& p, const NeighborList* neighbor_list)
 {
+  // Tally filter bins that depend on the particle's cells are no longer valid
+  ++p.geometry_state();
+
   // Find which cell of this universe the particle is in.  Use the neighbor list
   // to shorten the search if one was provided.
   bool found = false;
@@ -118,7 +202,7 @@ bool find_cell_inner(Particle& p, const NeighborList* neighbor_list)
       Position r {p.r_local()};
       Direction u {p.u_local()};
       auto surf = p.surface();
-      if (model::cells[i_cell]->contains(r, u, surf)) {
+      if (model::cells[i_cell]->contains(r, u, surf, &p.sense_cache())) {
         p.coord(p.n_coord() - 1).cell = i_cell;
         found = true;
         break;
@@ -181,8 +265,10 @@ bool find_cell_inner(Particle& p, const NeighborList* neighbor_list)
       p.sqrtkT_last() = p.sqrtkT();
       if (c.sqrtkT_.size() > 1) {
         p.sqrtkT() = c.sqrtkT_[p.cell_instance()];
+        p.i_sqrtkT() = c.i_sqrtkT_[p.cell_instance()];
       } else {
         p.sqrtkT() = c.sqrtkT_[0];
+        p.i_sqrtkT() = c.i_sqrtkT_[0];
       }
 
       return true;
@@ -203,7 +289,7 @@ bool find_cell_inner(Particle& p, const NeighborList* neighbor_list)
       coord.r -= c.translation_;
 
       // Apply rotation.
-      if (!c.rotation_.empty()) {
+      if (c.rotated_) {
         coord.rotate(c.rotation_);
       }
 
@@ -222,7 +308,7 @@ bool find_cell_inner(Particle& p, const NeighborList* neighbor_list)
       coord.r -= c.translation_;
 
       // Apply rotation.
-      if (!c.rotation_.empty()) {
+      if (c.rotated_) {
         coord.rotate(c.rotation_);
       }
 
@@ -261,34 +347,102 @@ bool find_cell_inner(Particle& p, const NeighborList* neighbor_list)
 
 bool neighbor_list_find_cell(Particle& p)
 {
+  // Search the neighbor list of the cell this particle was in previously
+  auto i_cell = p.coord(p.n_coord() - 1).cell;
+  return neighbor_list_find_cell(p, model::cells[i_cell]->neighbors_);
+}
+
+namespace {
+
+//! Look for a particle that missed the neighbor list of its previous cell
+//! after crossing a surface by moving it slightly further past the surface.
+bool recover_find_cell(Particle& p, NeighborList& neighbors, Surface& surf)
+{
+  // Move the particle a short distance past the surface, so that it is out of
+  // any crack between cells that do not quite meet at the surface. This goes
+  // through Particle::move so that the distances to lattice edges kept at
+  // each coordinate level stay in step with the position.
+  int n_coord = p.n_coord();
+  double d = settings::crossing_recovery_distance;
+  p.move(d);
+
+  // Retry the neighbor list of the previous cell, and then the cells that
+  // particles crossing this surface were found in before
+  if (find_cell_inner(p, &neighbors))
+    return true;
+  for (int i = n_coord; i < model::n_coord_levels; i++) {
+    p.coord(i).reset();
+  }
+  p.n_coord() = n_coord;
+  if (find_cell_inner(p, &surf.neighbors_))
+    return true;
+
+  // Put the particle back where it was so that it can be searched for
+  for (int i = n_coord; i < model::n_coord_levels; i++) {
+    p.coord(i).reset();
+  }
+  p.n_coord() = n_coord;
+  p.move(-d);
+  return false;
+}
+
+} // namespace
+
+bool neighbor_list_find_cell(Particle& p, NeighborList& neighbors)
+{
+  ProfileScope profile(ProfileRegion::FIND_CELL);
 
   // Reset all the deeper coordinate levels.
   for (int i = p.n_coord(); i < model::n_coord_levels; i++) {
     p.coord(i).reset();
   }
 
-  // Get the cell this particle was in previously.
+  // Search for the particle in the neighbor list.  Return if we found the
+  // particle.
   auto coord_lvl = p.n_coord() - 1;
-  auto i_cell = p.coord(coord_lvl).cell;
-  Cell& c {*model::cells[i_cell]};
-
-  // Search for the particle in that cell's neighbor list.  Return if we
-  // found the particle.
-  bool found = find_cell_inner(p, &c.neighbors_);
-  if (found)
+  bool found = find_cell_inner(p, &neighbors);
+  if (found) {
+    count_event(TransportEvent::NEIGHBOR_LIST_HIT);
     return found;
+  }
+
+  // After a surface crossing, try nudging the particle past the surface before
+  // resorting to a search.  Misses are counted for each surface so that
+  // cracks in the geometry can be located.
+  Surface* surf = nullptr;
+  if (settings::crossing_recovery && p.surface() != 0) {
+    surf = model::surfaces[std::abs(p.surface()) - 1].get();
+#pragma omp atomic
+    ++surf->n_search_failures_;
+    for (int i = p.n_coord(); i < model::n_coord_levels; i++) {
+      p.coord(i).reset();
+    }
+    p.n_coord() = coord_lvl + 1;
+    if (recover_find_cell(p, neighbors, *surf)) {
+#pragma omp atomic
+      ++surf->n_recoveries_;
+      count_event(TransportEvent::NEIGHBOR_LIST_HIT);
+      return true;
+    }
+  }
 
   // The particle could not be found in the neighbor list.  Try searching all
   // cells in this universe, and update the neighbor list if we find a new
   // neighboring cell.
+  count_event(TransportEvent::EXHAUSTIVE_SEARCH);
+  p.n_coord() = coord_lvl + 1;
   found = find_cell_inner(p, nullptr);
-  if (found)
-    c.neighbors_.push_back(p.coord(coord_lvl).cell);
+  if (found) {
+    neighbors.push_back(p.coord(coord_lvl).cell);
+    if (surf)
+      surf->neighbors_.push_back(p.coord(coord_lvl).cell);
+  }
   return found;
 }
 
 bool exhaustive_find_cell(Particle& p)
 {
+  ProfileScope profile(ProfileRegion::FIND_CELL);
   int i_universe = p.coord(p.n_coord() - 1).universe;
   if (i_universe == C_NONE) {
     p.coord(0).universe = model::root_universe;
@@ -299,6 +453,68 @@ bool exhaustive_find_cell(Particle& p)
   for (int i = p.n_coord(); i < model::n_coord_levels; i++) {
     p.coord(i).reset();
   }
+  count_event(TransportEvent::EXHAUSTIVE_SEARCH);
+  return find_cell_inner(p, nullptr);
+}
+
+bool find_cell_nearby(Particle& p)
+{
+  ProfileScope profile(ProfileRegion::FIND_CELL);
+
+  // Follow the coordinate levels that were found before for as long as their
+  // cells and lattice tiles still contain the particle
+  int n_coord = p.n_coord();
+  int j = 0;
+  for (; j < n_coord; ++j) {
+    auto& coord {p.coord(j)};
+    Cell& c {*model::cells[coord.cell]};
+    if (!c.contains(coord.r, coord.u, p.surface()))
+      break;
+
+    // The particle is still in the same material cell, so its material and
+    // temperature have not changed either
+    if (j == n_coord - 1) {
+      ++p.geometry_state();
+      return true;
+    }
+
+    // Update the position at the next level the same way as find_cell_inner
+    auto& next {p.coord(j + 1)};
+    next.r = coord.r - c.translation_;
+    next.u = coord.u;
+    if (c.rotated_) {
+      next.rotate(c.rotation_);
+    }
+    if (c.type_ == Fill::LATTICE) {
+      Lattice& lat {*model::lattices[c.fill_]};
+      array<int, 3> i_xyz;
+      lat.get_indices(next.r, next.u, i_xyz);
+      if (i_xyz != next.lattice_i)
+        break;
+      next.r = lat.get_local_position(next.r, i_xyz);
+
+      // The distances to the tile edges were found at the old position
+      next.lattice_u = {0.0, 0.0, 0.0};
+    }
+  }
+
+  // Search again from the first level where the particle has left its cell or
+  // lattice tile
+  p.n_coord() = j + 1;
+  for (int i = p.n_coord(); i < model::n_coord_levels; i++) {
+    p.coord(i).reset();
+  }
+  return find_cell_inner(p, nullptr);
+}
+
+bool find_cell_at_level(Particle& p, int level)
+{
+  ProfileScope profile(ProfileRegion::FIND_CELL);
+  p.n_coord() = level + 1;
+  for (int i = p.n_coord(); i < model::n_coord_levels; i++) {
+    p.coord(i).reset();
+  }
+  count_event(TransportEvent::EXHAUSTIVE_SEARCH);
   return find_cell_inner(p, nullptr);
 }
 
@@ -321,16 +537,27 @@ void cross_lattice(Particle& p, const BoundaryInfo& boundary)
   coord.lattice_i[0] += boundary.lattice_translation[0];
   coord.lattice_i[1] += boundary.lattice_translation[1];
   coord.lattice_i[2] += boundary.lattice_translation[2];
+  if (settings::lattice_dda && lat.type_ == LatticeType::rect) {
+    static_cast<RectLattice&>(lat).cross_dda(
+      coord, boundary.lattice_translation);
+  }
 
-  // Set the new coordinate position.
-  const auto& upper_coord {p.coord(p.n_coord() - 2)};
-  const auto& cell {model::cells[upper_coord.cell]};
-  Position r = upper_coord.r;
-  r -= cell->translation_;
-  if (!cell->rotation_.empty()) {
-    r = r.rotate(cell->rotation_);
+  // Set the new coordinate position. Moving into the neighboring tile of a
+  // rectangular lattice only shifts the local position by whole pitches, so
+  // the transforms of the levels above do not need to be applied again.
+  if (lat.type_ == LatticeType::rect) {
+    p.r_local() = static_cast<RectLattice&>(lat).cross_local_position(
+      coord.r, boundary.lattice_translation);
+  } else {
+    const auto& upper_coord {p.coord(p.n_coord() - 2)};
+    const auto& cell {model::cells[upper_coord.cell]};
+    Position r = upper_coord.r;
+    r -= cell->translation_;
+    if (cell->rotated_) {
+      r = r.rotate(cell->rotation_);
+    }
+    p.r_local() = lat.get_local_position(r, coord.lattice_i);
   }
-  p.r_local() = lat.get_local_position(r, coord.lattice_i);
 
   if (!lat.are_valid_indices(coord.lattice_i)) {
     // The particle is outside the lattice.  Search for it from the base coords.
@@ -363,25 +590,34 @@ void cross_lattice(Particle& p, const BoundaryInfo& boundary)
 
 //==============================================================================
 
-BoundaryInfo distance_to_boundary(Particle& p)
+BoundaryInfo distance_to_boundary(Particle& p, int delta_level)
 {
+  ProfileScope profile(ProfileRegion::DISTANCE_TO_BOUNDARY);
+  DomainScope profile_cell(ProfileDomain::CELL, p.lowest_coord().cell);
   BoundaryInfo info;
   double d_lat = INFINITY;
   double d_surf = INFINITY;
   int32_t level_surf_cross;
   array<int, 3> level_lat_trans {};
 
-  // Loop over each coordinate level.
-  for (int i = 0; i < p.n_coord(); i++) {
+  // Loop over each coordinate level. Below a delta-tracked universe, only the
+  // lattice tile it fills bounds the step.
+  int n_coord = delta_level == C_NONE ? p.n_coord() : delta_level + 1;
+  for (int i = 0; i < n_coord; i++) {
     const auto& coord {p.coord(i)};
     const Position& r {coord.r};
     const Direction& u {coord.u};
     Cell& c {*model::cells[coord.cell]};
 
     // Find the oncoming surface in this cell and the distance to it.
-    auto surface_distance = c.distance(r, u, p.surface(), &p);
-    d_surf = surface_distance.first;
-    level_surf_cross = surface_distance.second;
+    if (i == delta_level) {
+      d_surf = INFINITY;
+      level_surf_cross = 0;
+    } else {
+      auto surface_distance = c.distance(r, u, p.surface(), &p);
+      d_surf = surface_distance.first;
+      level_surf_cross = surface_distance.second;
+    }
 
     // Find the distance to the next lattice tile crossing.
     if (coord.lattice != C_NONE) {
@@ -391,7 +627,12 @@ BoundaryInfo distance_to_boundary(Particle& p)
       std::pair<double, array<int, 3>> lattice_distance;
       switch (lat.type_) {
       case LatticeType::rect:
-        lattice_distance = lat.distance(r, u, coord.lattice_i);
+        if (settings::lattice_dda) {
+          lattice_distance =
+            static_cast<RectLattice&>(lat).distance_dda(p.coord(i));
+        } else {
+          lattice_distance = lat.distance(r, u, coord.lattice_i);
+        }
         break;
       case LatticeType::hex:
         auto& cell_above {model::cells[p.coord(i - 1).cell]};
@@ -429,8 +670,8 @@ BoundaryInfo distance_to_boundary(Particle& p)
           info.surface_index = level_surf_cross;
         } else {
           Position r_hit = r + d_surf * u;
-          Surface& surf {*model::surfaces[std::abs(level_surf_cross) - 1]};
-          Direction norm = surf.normal(r_hit);
+          Direction norm = model::surface_store.normal(
+            std::abs(level_surf_cross) - 1, r_hit);
           if (u.dot(norm) > 0) {
             info.surface_index = std::abs(level_surf_cross);
           } else {
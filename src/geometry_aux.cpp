@@ -1,7 +1,7 @@
 #include "openmc/geometry_aux.h"
 
 #include <algorithm> // for std::max
-#include <sstream>
+#include <cmath>     // for std::abs
 #include <unordered_set>
 
 #include <fmt/core.h>
@@ -25,19 +25,30 @@
 namespace openmc {
 
 namespace model {
-std::unordered_map<int32_t, std::unordered_map<int32_t, int32_t>>
-  universe_cell_counts;
 std::unordered_map<int32_t, int32_t> universe_level_counts;
 } // namespace model
 
-// adds the cell counts of universe b to universe a
-void update_universe_cell_count(int32_t a, int32_t b)
+//! Append the universes contained in univ_indx (including itself) to order
+//! such that each universe comes after every universe it contains.
+void universe_post_order(
+  int32_t univ_indx, vector<char>& visited, vector<int32_t>& order)
 {
-  auto& universe_a_counts = model::universe_cell_counts[a];
-  const auto& universe_b_counts = model::universe_cell_counts[b];
-  for (const auto& it : universe_b_counts) {
-    universe_a_counts[it.first] += it.second;
+  if (visited[univ_indx])
+    return;
+  visited[univ_indx] = true;
+
+  for (int32_t cell_indx : model::universes[univ_indx]->cells_) {
+    Cell& c = *model::cells[cell_indx];
+    if (c.type_ == Fill::UNIVERSE) {
+      universe_post_order(c.fill_, visited, order);
+    } else if (c.type_ == Fill::LATTICE) {
+      Lattice& lat = *model::lattices[c.fill_];
+      for (auto it = lat.begin(); it != lat.end(); ++it) {
+        universe_post_order(*it, visited, order);
+      }
+    }
   }
+  order.push_back(univ_indx);
 }
 
 void read_geometry_xml()
@@ -143,7 +154,9 @@ void adjust_indices()
 }
 
 //==============================================================================
-//! Partition some universes with many z-planes for faster find_cell searches.
+//! Partition some universes with many axis-aligned planes and z-cylinders, or
+//! build a BVH over the cells of other large universes, for faster find_cell
+//! searches.
 
 void partition_universes()
 {
@@ -160,14 +173,111 @@ void partition_universes()
         }
       }
 
-      // Partition the universe if there are more than 5 z-planes.  (Fewer than
-      // 5 is likely not worth it.)
-      int n_zplanes = 0;
+      // Partition the universe if there are more than 5 axis-aligned planes
+      // and z-cylinders.  (Fewer than 5 is likely not worth it.)  Discard the
+      // partitioner if none of those surfaces divide the cells.
+      int n_partition_surfs = 0;
       for (auto i_surf : surf_inds) {
-        if (dynamic_cast<const SurfaceZPlane*>(model::surfaces[i_surf].get())) {
-          ++n_zplanes;
-          if (n_zplanes > 5) {
+        const auto& surf = *model::surfaces[i_surf];
+        if (UniversePartitioner::is_partition_surface(surf)) {
+          ++n_partition_surfs;
+          if (n_partition_surfs > 5) {
             univ->partitioner_ = make_unique<UniversePartitioner>(*univ);
+            if (univ->partitioner_->n_partitions() == 1)
+              univ->partitioner_.reset();
+            break;
+          }
+        }
+      }
+
+      // Otherwise, build a BVH over the bounding boxes of the cells if at
+      // least half of them are bounded in some direction.
+      if (!univ->partitioner_ && univ->geom_type() == GeometryType::CSG) {
+        int n_bounded = 0;
+        for (auto i_cell : univ->cells_) {
+          auto b = model::cells[i_cell]->bounding_box();
+          if (b.xmin > -INFTY || b.xmax < INFTY || b.ymin > -INFTY ||
+              b.ymax < INFTY || b.zmin > -INFTY || b.zmax < INFTY)
+            ++n_bounded;
+        }
+        if (2 * n_bounded >= static_cast<int>(univ->cells_.size()))
+          univ->bvh_ = make_unique<UniverseBVH>(univ->cells_);
+      }
+    }
+  }
+}
+
+//==============================================================================
+
+void build_neighbor_lists()
+{
+  // Pad bounding boxes so that cells which just touch are not ruled out
+  auto pad = [](BoundingBox b) {
+    auto lower = [](double x) {
+      return x - FP_COINCIDENT * std::max(1.0, std::abs(x));
+    };
+    auto upper = [](double x) {
+      return x + FP_COINCIDENT * std::max(1.0, std::abs(x));
+    };
+    return BoundingBox {lower(b.xmin), upper(b.xmax), lower(b.ymin),
+      upper(b.ymax), lower(b.zmin), upper(b.zmax)};
+  };
+
+  vector<int32_t> candidates;
+  for (const auto& univ : model::universes) {
+    if (univ->geom_type() != GeometryType::CSG)
+      continue;
+
+    // Two cells can only be neighbors if their bounding boxes overlap.  Those
+    // cells are found with the universe's BVH, or a temporary one if it has
+    // none, so that large universes are not searched in quadratic time.
+    const auto& cells {univ->cells_};
+    const UniverseBVH* bvh = univ->bvh_.get();
+    unique_ptr<UniverseBVH> temp_bvh;
+    if (!bvh && cells.size() > 10) {
+      temp_bvh = make_unique<UniverseBVH>(cells);
+      bvh = temp_bvh.get();
+    }
+    vector<BoundingBox> boxes;
+    if (!bvh) {
+      for (auto i_cell : cells)
+        boxes.push_back(pad(model::cells[i_cell]->bounding_box()));
+    }
+
+    for (int32_t j = 0; j < cells.size(); ++j) {
+      Cell& c1 {*model::cells[cells[j]]};
+      BoundingBox box = pad(c1.bounding_box());
+      candidates.clear();
+      if (bvh) {
+        bvh->find_overlapping(box, candidates);
+      } else {
+        for (int32_t k = 0; k < cells.size(); ++k) {
+          const auto& b {boxes[k]};
+          if (box.xmin <= b.xmax && b.xmin <= box.xmax && box.ymin <= b.ymax &&
+              b.ymin <= box.ymax && box.zmin <= b.zmax && b.zmin <= box.zmax)
+            candidates.push_back(cells[k]);
+        }
+      }
+
+      // A particle leaving a cell through one of its surfaces enters a cell
+      // on the other side of that surface.  For cells made only of
+      // intersections that is a cell referencing the surface with the
+      // opposite sense; complements and unions can flip the sense, so
+      // otherwise any cell referencing the surface is a candidate.
+      std::unordered_set<int32_t> tokens;
+      for (auto token : c1.rpn_) {
+        if (token < OP_UNION)
+          tokens.insert(token);
+      }
+      for (auto i2 : candidates) {
+        const Cell& c2 {*model::cells[i2]};
+        if (&c2 == &c1)
+          continue;
+        bool opposite = c1.simple_ && c2.simple_;
+        for (auto token : c2.rpn_) {
+          if (token < OP_UNION &&
+              (tokens.count(-token) || (!opposite && tokens.count(token)))) {
+            c1.neighbors_.push_back(i2);
             break;
           }
         }
@@ -198,6 +308,12 @@ void assign_temperatures()
       }
     }
   }
+
+  // Register each distinct cell temperature so that nuclides can cache the
+  // index of their nearest temperature rather than searching on every lookup
+  for (auto& c : model::cells) {
+    c->update_temperature_indices();
+  }
 }
 
 //==============================================================================
@@ -258,9 +374,22 @@ void finalize_geometry()
 {
   // Perform some final operations to set up the geometry
   adjust_indices();
+  model::surface_store.build();
   count_cell_instances(model::root_universe);
   partition_universes();
 
+  // Fill the neighbor lists of cells before transport if requested
+  if (settings::precompute_neighbors)
+    build_neighbor_lists();
+
+  // Find the cells that particles enter through periodic boundaries. Both
+  // surfaces of a pair share their boundary condition, whose lists ignore
+  // cells that were already added.
+  for (const auto& s : model::surfaces) {
+    if (auto bc = dynamic_cast<PeriodicBC*>(s->bc_.get()))
+      bc->find_partner_cells();
+  }
+
   // Assign temperatures to cells that don't have temperatures already assigned
   assign_temperatures();
 
@@ -371,21 +500,24 @@ void prepare_distribcell(const std::vector<int32_t>* user_distribcells)
     }
   }
 
-  // Search through universes for material cells and assign each one a
-  // unique distribcell array index.
-  int distribcell_index = 0;
-  vector<int32_t> target_univ_ids;
-  for (const auto& u : model::universes) {
+  // Search through universes for distributed cells. Every distributed cell
+  // in a universe has the same instances as the universe itself, so one
+  // offset map is shared by all distributed cells of a given universe.
+  vector<int32_t> target_univs;
+  for (int32_t i = 0; i < model::universes.size(); ++i) {
+    const auto& u = model::universes[i];
+    int map = target_univs.size();
     for (auto idx : u->cells_) {
       if (distribcells.find(idx) != distribcells.end()) {
-        model::cells[idx]->distribcell_index_ = distribcell_index++;
-        target_univ_ids.push_back(u->id_);
+        model::cells[idx]->distribcell_index_ = map;
+        if (target_univs.size() == map)
+          target_univs.push_back(i);
       }
     }
   }
 
   // Allocate the cell and lattice offset tables.
-  int n_maps = target_univ_ids.size();
+  int n_maps = target_univs.size();
   for (auto& c : model::cells) {
     if (c->type_ != Fill::MATERIAL) {
       c->offset_.resize(n_maps, C_NONE);
@@ -395,11 +527,41 @@ void prepare_distribcell(const std::vector<int32_t>* user_distribcells)
     lat->allocate_offset_table(n_maps);
   }
 
+  // Order all universes so that each one comes after the universes it
+  // contains. Counts of a target universe can then be accumulated bottom-up
+  // in a single pass.
+  vector<char> visited(model::universes.size(), false);
+  vector<int32_t> order;
+  order.reserve(model::universes.size());
+  for (int32_t i = 0; i < model::universes.size(); ++i) {
+    universe_post_order(i, visited, order);
+  }
+
 // Fill the cell and lattice offset tables.
 #pragma omp parallel for
-  for (int map = 0; map < target_univ_ids.size(); map++) {
-    auto target_univ_id = target_univ_ids[map];
-    std::unordered_map<int32_t, int32_t> univ_count_memo;
+  for (int map = 0; map < n_maps; map++) {
+    // Count the instances of the target universe contained in each universe
+    vector<int32_t> univ_counts(model::universes.size(), 0);
+    for (int32_t i_univ : order) {
+      if (i_univ == target_univs[map]) {
+        univ_counts[i_univ] = 1;
+        continue;
+      }
+      int32_t count = 0;
+      for (int32_t cell_indx : model::universes[i_univ]->cells_) {
+        Cell& c = *model::cells[cell_indx];
+        if (c.type_ == Fill::UNIVERSE) {
+          count += univ_counts[c.fill_];
+        } else if (c.type_ == Fill::LATTICE) {
+          Lattice& lat = *model::lattices[c.fill_];
+          for (auto it = lat.begin(); it != lat.end(); ++it) {
+            count += univ_counts[*it];
+          }
+        }
+      }
+      univ_counts[i_univ] = count;
+    }
+
     for (const auto& univ : model::universes) {
       int32_t offset = 0;
       for (int32_t cell_indx : univ->cells_) {
@@ -407,15 +569,12 @@ void prepare_distribcell(const std::vector<int32_t>* user_distribcells)
 
         if (c.type_ == Fill::UNIVERSE) {
           c.offset_[map] = offset;
-          int32_t search_univ = c.fill_;
-          offset += count_universe_instances(
-            search_univ, target_univ_id, univ_count_memo);
+          offset += univ_counts[c.fill_];
 
         } else if (c.type_ == Fill::LATTICE) {
           c.offset_[map] = offset;
           Lattice& lat = *model::lattices[c.fill_];
-          offset +=
-            lat.fill_offset_table(offset, target_univ_id, map, univ_count_memo);
+          offset += lat.fill_offset_table(offset, map, univ_counts);
         }
       }
     }
@@ -426,27 +585,28 @@ void prepare_distribcell(const std::vector<int32_t>* user_distribcells)
 
 void count_cell_instances(int32_t univ_indx)
 {
-  const auto univ_counts = model::universe_cell_counts.find(univ_indx);
-  if (univ_counts != model::universe_cell_counts.end()) {
-    for (const auto& it : univ_counts->second) {
-      model::cells[it.first]->n_instances_ += it.second;
-    }
-  } else {
-    for (int32_t cell_indx : model::universes[univ_indx]->cells_) {
+  // Visiting universes in reverse post-order puts each one before every
+  // universe it contains, so all of its instances are known when reached.
+  vector<char> visited(model::universes.size(), false);
+  vector<int32_t> order;
+  universe_post_order(univ_indx, visited, order);
+
+  // Push the number of instances of each universe down to its cells and the
+  // universes they are filled with.
+  vector<int32_t> univ_instances(model::universes.size(), 0);
+  univ_instances[univ_indx] = 1;
+  for (auto i = order.rbegin(); i != order.rend(); ++i) {
+    int32_t n = univ_instances[*i];
+    for (int32_t cell_indx : model::universes[*i]->cells_) {
       Cell& c = *model::cells[cell_indx];
-      ++c.n_instances_;
-      model::universe_cell_counts[univ_indx][cell_indx] += 1;
+      c.n_instances_ += n;
 
       if (c.type_ == Fill::UNIVERSE) {
-        // This cell contains another universe.  Recurse into that universe.
-        count_cell_instances(c.fill_);
-        update_universe_cell_count(univ_indx, c.fill_);
+        univ_instances[c.fill_] += n;
       } else if (c.type_ == Fill::LATTICE) {
-        // This cell contains a lattice.  Recurse into the lattice universes.
         Lattice& lat = *model::lattices[c.fill_];
         for (auto it = lat.begin(); it != lat.end(); ++it) {
-          count_cell_instances(*it);
-          update_universe_cell_count(univ_indx, *it);
+          univ_instances[*it] += n;
         }
       }
     }
@@ -455,61 +615,19 @@ void count_cell_instances(int32_t univ_indx)
 
 //==============================================================================
 
-int count_universe_instances(int32_t search_univ, int32_t target_univ_id,
-  std::unordered_map<int32_t, int32_t>& univ_count_memo)
+void distribcell_path_inner(int32_t target_cell, int32_t map,
+  int32_t target_offset, const Universe& search_univ, int32_t offset,
+  std::string& path)
 {
-  // If this is the target, it can't contain itself.
-  if (model::universes[search_univ]->id_ == target_univ_id) {
-    return 1;
-  }
-
-  // If we have already counted the number of instances, reuse that value.
-  auto search = univ_count_memo.find(search_univ);
-  if (search != univ_count_memo.end()) {
-    return search->second;
-  }
-
-  int count {0};
-  for (int32_t cell_indx : model::universes[search_univ]->cells_) {
-    Cell& c = *model::cells[cell_indx];
-
-    if (c.type_ == Fill::UNIVERSE) {
-      int32_t next_univ = c.fill_;
-      count +=
-        count_universe_instances(next_univ, target_univ_id, univ_count_memo);
-
-    } else if (c.type_ == Fill::LATTICE) {
-      Lattice& lat = *model::lattices[c.fill_];
-      for (auto it = lat.begin(); it != lat.end(); ++it) {
-        int32_t next_univ = *it;
-        count +=
-          count_universe_instances(next_univ, target_univ_id, univ_count_memo);
-      }
-    }
-  }
-
-  // Remember the number of instances in this universe.
-  univ_count_memo[search_univ] = count;
-
-  return count;
-}
-
-//==============================================================================
-
-std::string distribcell_path_inner(int32_t target_cell, int32_t map,
-  int32_t target_offset, const Universe& search_univ, int32_t offset)
-{
-  std::stringstream path;
-
-  path << "u" << search_univ.id_ << "->";
+  path += fmt::format("u{}->", search_univ.id_);
 
   // Check to see if this universe directly contains the target cell.  If so,
   // write to the path and return.
   for (int32_t cell_indx : search_univ.cells_) {
     if ((cell_indx == target_cell) && (offset == target_offset)) {
       Cell& c = *model::cells[cell_indx];
-      path << "c" << c.id_;
-      return path.str();
+      path += fmt::format("c{}", c.id_);
+      return;
     }
   }
 
@@ -541,27 +659,27 @@ std::string distribcell_path_inner(int32_t target_cell, int32_t map,
 
   // Add the cell to the path string.
   Cell& c = *model::cells[*cell_it];
-  path << "c" << c.id_ << "->";
+  path += fmt::format("c{}->", c.id_);
 
   if (c.type_ == Fill::UNIVERSE) {
     // Recurse into the fill cell.
     offset += c.offset_[map];
-    path << distribcell_path_inner(
-      target_cell, map, target_offset, *model::universes[c.fill_], offset);
-    return path.str();
+    distribcell_path_inner(target_cell, map, target_offset,
+      *model::universes[c.fill_], offset, path);
+    return;
   } else {
     // Recurse into the lattice cell.
     Lattice& lat = *model::lattices[c.fill_];
-    path << "l" << lat.id_;
+    path += fmt::format("l{}", lat.id_);
     for (ReverseLatticeIter it = lat.rbegin(); it != lat.rend(); ++it) {
       int32_t indx = lat.universes_.size() * map + it.indx_;
       int32_t temp_offset = offset + lat.offsets_[indx];
       if (temp_offset <= target_offset) {
         offset = temp_offset;
-        path << "(" << lat.index_to_string(it.indx_) << ")->";
-        path << distribcell_path_inner(
-          target_cell, map, target_offset, *model::universes[*it], offset);
-        return path.str();
+        path += fmt::format("({})->", lat.index_to_string(it.indx_));
+        distribcell_path_inner(target_cell, map, target_offset,
+          *model::universes[*it], offset, path);
+        return;
       }
     }
     throw std::runtime_error {"Error determining distribcell path."};
@@ -572,7 +690,9 @@ std::string distribcell_path(
   int32_t target_cell, int32_t map, int32_t target_offset)
 {
   auto& root_univ = *model::universes[model::root_universe];
-  return distribcell_path_inner(target_cell, map, target_offset, root_univ, 0);
+  std::string path;
+  distribcell_path_inner(target_cell, map, target_offset, root_univ, 0, path);
+  return path;
 }
 
 //==============================================================================
@@ -620,6 +740,7 @@ void free_memory_geometry()
   model::lattice_map.clear();
 
   model::overlap_check_count.clear();
+  model::overlap_check_count_thread.clear();
 }
 
 } // namespace openmc
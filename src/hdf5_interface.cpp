@@ -1,5 +1,6 @@
 #include "openmc/hdf5_interface.h"
 
+#include <algorithm> // for min
 #include <cstring>
 #include <stdexcept>
 #include <string>
@@ -16,6 +17,7 @@
 #endif
 
 #include "openmc/array.h"
+#include "openmc/settings.h"
 
 namespace openmc {
 
@@ -151,7 +153,10 @@ void ensure_exists(hid_t obj_id, const char* name, bool attribute)
   }
 }
 
-hid_t file_open(const char* filename, char mode, bool parallel)
+namespace {
+
+hid_t file_open_impl(
+  const char* filename, char mode, bool parallel, bool page_aligned)
 {
   bool create;
   unsigned int flags;
@@ -171,14 +176,43 @@ hid_t file_open(const char* filename, char mode, bool parallel)
   }
 
   hid_t plist = H5P_DEFAULT;
+  bool aligned = false;
 #ifdef PHDF5
   if (parallel) {
+    // Give MPI-IO the stripe size of the file system so that collective
+    // buffering writes whole stripes
+    MPI_Info info = MPI_INFO_NULL;
+    if (settings::io_stripe_size > 0) {
+      auto stripe = std::to_string(settings::io_stripe_size);
+      MPI_Info_create(&info);
+      MPI_Info_set(info, "striping_unit", stripe.c_str());
+      MPI_Info_set(info, "cb_buffer_size", stripe.c_str());
+      MPI_Info_set(info, "romio_cb_write", "enable");
+    }
+
     // Setup file access property list with parallel I/O access
     plist = H5Pcreate(H5P_FILE_ACCESS);
-    H5Pset_fapl_mpio(plist, openmc::mpi::intracomm, MPI_INFO_NULL);
+    H5Pset_fapl_mpio(plist, openmc::mpi::intracomm, info);
+
+    // Align large objects to stripe boundaries so that no stripe is shared by
+    // writes to different objects
+    if (settings::io_stripe_size > 0) {
+      hsize_t stripe = settings::io_stripe_size;
+      H5Pset_alignment(plist, stripe, stripe);
+      MPI_Info_free(&info);
+      aligned = true;
+    }
   }
 #endif
 
+  // Align large objects to pages if requested so that source banks can be
+  // mapped into memory directly
+  if (create && page_aligned && !aligned) {
+    if (plist == H5P_DEFAULT)
+      plist = H5Pcreate(H5P_FILE_ACCESS);
+    H5Pset_alignment(plist, 1 << 16, 4096);
+  }
+
   // Open the file collectively
   hid_t file_id;
   if (create) {
@@ -191,18 +225,55 @@ hid_t file_open(const char* filename, char mode, bool parallel)
       "Failed to open HDF5 file with mode '{}': {}", mode, filename));
   }
 
-#ifdef PHDF5
   // Close the property list
-  if (parallel)
+  if (plist != H5P_DEFAULT)
     H5Pclose(plist);
-#endif
 
   return file_id;
 }
 
-hid_t file_open(const std::string& filename, char mode, bool parallel)
+} // namespace
+
+hid_t file_open(const char* filename, char mode, bool parallel)
+{
+  return file_open_impl(filename, mode, parallel, false);
+}
+
+hid_t file_open(
+  const std::string& filename, char mode, bool parallel, bool page_aligned)
+{
+  return file_open_impl(filename.c_str(), mode, parallel, page_aligned);
+}
+
+hid_t file_open_memory(const std::string& filename, bool page_aligned)
+{
+  // Grow the image in 1 MiB increments and never write it to disk
+  hid_t plist = H5Pcreate(H5P_FILE_ACCESS);
+  H5Pset_fapl_core(plist, 1 << 20, false);
+  if (page_aligned)
+    H5Pset_alignment(plist, 1 << 16, 4096);
+  hid_t file_id =
+    H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, plist);
+  H5Pclose(plist);
+  if (file_id < 0) {
+    fatal_error("Failed to create in-memory HDF5 file: " + filename);
+  }
+  return file_id;
+}
+
+vector<char> file_image(hid_t file_id)
 {
-  return file_open(filename.c_str(), mode, parallel);
+  // Cached metadata must be flushed or the image will not be a valid file
+  H5Fflush(file_id, H5F_SCOPE_GLOBAL);
+
+  // A first call with no buffer gives the size of the image
+  ssize_t size = H5Fget_file_image(file_id, nullptr, 0);
+  if (size < 0) {
+    fatal_error("Failed to get image of HDF5 file.");
+  }
+  vector<char> image(size);
+  H5Fget_file_image(file_id, image.data(), image.size());
+  return image;
 }
 
 hid_t open_group(hid_t group_id, const std::string& name)
@@ -360,6 +431,26 @@ vector<std::string> dataset_names(hid_t group_id)
   return member_names(group_id, H5O_TYPE_DATASET);
 }
 
+size_t dataset_bytes(hid_t group_id)
+{
+  size_t bytes = 0;
+  for (const auto& name : dataset_names(group_id)) {
+    hid_t dset = open_dataset(group_id, name.c_str());
+    hid_t dspace = H5Dget_space(dset);
+    hid_t filetype = H5Dget_type(dset);
+    bytes += H5Sget_simple_extent_npoints(dspace) * H5Tget_size(filetype);
+    H5Tclose(filetype);
+    H5Sclose(dspace);
+    close_dataset(dset);
+  }
+  for (const auto& name : group_names(group_id)) {
+    hid_t subgroup = open_group(group_id, name.c_str());
+    bytes += dataset_bytes(subgroup);
+    close_group(subgroup);
+  }
+  return bytes;
+}
+
 bool object_exists(hid_t object_id, const char* name)
 {
   htri_t out = H5LTpath_valid(object_id, name, true);
@@ -544,6 +635,32 @@ void read_tally_results(
   H5Sclose(memspace);
 }
 
+void read_tally_results_block(hid_t dset, hsize_t start, hsize_t n_filter,
+  hsize_t n_score, double* results)
+{
+  // Create dataspace for hyperslab in memory
+  constexpr int ndim = 3;
+  hsize_t dims[ndim] {n_filter, n_score, 3};
+  hsize_t mem_start[ndim] {0, 0, 1};
+  hsize_t count[ndim] {n_filter, n_score, 2};
+  hid_t memspace = H5Screate_simple(ndim, dims, nullptr);
+  H5Sselect_hyperslab(
+    memspace, H5S_SELECT_SET, mem_start, nullptr, count, nullptr);
+
+  // Select the filter bins of this block in the file
+  hsize_t file_start[ndim] {start, 0, 0};
+  hid_t filespace = H5Dget_space(dset);
+  H5Sselect_hyperslab(
+    filespace, H5S_SELECT_SET, file_start, nullptr, count, nullptr);
+
+  // Read the block
+  H5Dread(dset, H5T_NATIVE_DOUBLE, memspace, filespace, H5P_DEFAULT, results);
+
+  // Free resources
+  H5Sclose(filespace);
+  H5Sclose(memspace);
+}
+
 void write_attr(hid_t obj_id, int ndim, const hsize_t* dims, const char* name,
   hid_t mem_type_id, const void* buffer)
 {
@@ -696,6 +813,53 @@ void write_tally_results(
   H5Sclose(memspace);
 }
 
+hid_t create_tally_results(
+  hid_t group_id, hsize_t n_filter, hsize_t n_score, hsize_t n_chunk)
+{
+  // Use chunked storage so that chunks that are never written take no space
+  // in the file and are read back as zeros
+  constexpr int ndim = 3;
+  hsize_t dims[ndim] {n_filter, n_score, 2};
+  hsize_t chunk[ndim] {std::min(n_chunk, n_filter), n_score, 2};
+  hid_t plist = H5Pcreate(H5P_DATASET_CREATE);
+  H5Pset_chunk(plist, ndim, chunk);
+
+  hid_t dspace = H5Screate_simple(ndim, dims, nullptr);
+  hid_t dset = H5Dcreate(group_id, "results", H5T_NATIVE_DOUBLE, dspace,
+    H5P_DEFAULT, plist, H5P_DEFAULT);
+
+  // Free resources
+  H5Sclose(dspace);
+  H5Pclose(plist);
+  return dset;
+}
+
+void write_tally_results_block(hid_t dset, hsize_t start, hsize_t n_filter,
+  hsize_t n_score, const double* results)
+{
+  // Set dimensions of sum/sum_sq hyperslab of the block in memory
+  constexpr int ndim = 3;
+  hsize_t dims[ndim] {n_filter, n_score, 3};
+  hsize_t mem_start[ndim] {0, 0, 1};
+  hsize_t count[ndim] {n_filter, n_score, 2};
+  hid_t memspace = H5Screate_simple(ndim, dims, nullptr);
+  H5Sselect_hyperslab(
+    memspace, H5S_SELECT_SET, mem_start, nullptr, count, nullptr);
+
+  // Select the filter bins of this block in the file
+  hsize_t file_start[ndim] {start, 0, 0};
+  hid_t filespace = H5Dget_space(dset);
+  H5Sselect_hyperslab(
+    filespace, H5S_SELECT_SET, file_start, nullptr, count, nullptr);
+
+  // Write the block
+  H5Dwrite(dset, H5T_NATIVE_DOUBLE, memspace, filespace, H5P_DEFAULT, results);
+
+  // Free resources
+  H5Sclose(filespace);
+  H5Sclose(memspace);
+}
+
 bool using_mpio_device(hid_t obj_id)
 {
   // Determine file that this object is part of
@@ -728,6 +892,8 @@ const hid_t H5TypeMap<unsigned int>::type_id = H5T_NATIVE_UINT;
 template<>
 const hid_t H5TypeMap<int64_t>::type_id = H5T_NATIVE_INT64;
 template<>
+const hid_t H5TypeMap<float>::type_id = H5T_NATIVE_FLOAT;
+template<>
 const hid_t H5TypeMap<double>::type_id = H5T_NATIVE_DOUBLE;
 template<>
 const hid_t H5TypeMap<char>::type_id = H5T_NATIVE_CHAR;
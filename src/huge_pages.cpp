@@ -0,0 +1,169 @@
+#include "openmc/huge_pages.h"
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+#define HAS_MEMORY_MAPPING
+#endif
+
+#include <array>
+#include <cstdint> // for uintptr_t
+#include <cstdlib> // for malloc, free
+#include <new>     // for bad_alloc
+#include <unordered_map>
+
+#ifdef HAS_MEMORY_MAPPING
+#include <sys/mman.h> // for mmap, madvise, munmap
+#endif
+
+#include "openmc/error.h"
+#include "openmc/settings.h"
+
+namespace openmc {
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace {
+
+//! How a block of memory is backed
+enum class PageKind { REGULAR, TRANSPARENT, EXPLICIT };
+
+//! Memory currently allocated for a kind of data by how it is backed
+struct PageUsage {
+  std::array<size_t, 3> nbytes {}; //!< Bytes indexed by PageKind
+};
+
+std::array<PageUsage, 2> usage; //!< Usage indexed by PageUse
+
+//! How each block mapped from the operating system is backed
+std::unordered_map<void*, PageKind> mapped_kinds;
+
+void record(PageUse use, PageKind kind, size_t nbytes, bool add)
+{
+  auto& n = usage[static_cast<int>(use)].nbytes[static_cast<int>(kind)];
+  n = add ? n + nbytes : n - nbytes;
+}
+
+#ifdef HAS_MEMORY_MAPPING
+//! Length of the mapping for a block, which is a whole number of huge pages
+size_t mapped_length(size_t nbytes)
+{
+  return (nbytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+}
+
+//! Map anonymous memory aligned to a huge page boundary so that transparent
+//! huge pages can back all of it
+void* map_aligned(size_t length)
+{
+  size_t extra = length + HUGE_PAGE_SIZE;
+  void* ptr = mmap(nullptr, extra, PROT_READ | PROT_WRITE,
+    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (ptr == MAP_FAILED)
+    return ptr;
+
+  // Trim the unaligned head and the remaining tail
+  auto start = reinterpret_cast<uintptr_t>(ptr);
+  auto aligned =
+    (start + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+  if (aligned > start)
+    munmap(ptr, aligned - start);
+  size_t tail = start + extra - (aligned + length);
+  if (tail > 0)
+    munmap(reinterpret_cast<void*>(aligned + length), tail);
+  return reinterpret_cast<void*>(aligned);
+}
+#endif
+
+} // namespace
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+void* allocate_pages(size_t nbytes, PageUse use)
+{
+#ifdef HAS_MEMORY_MAPPING
+  if (nbytes >= HUGE_PAGE_SIZE) {
+    size_t length = mapped_length(nbytes);
+    void* ptr = MAP_FAILED;
+    PageKind kind = PageKind::REGULAR;
+
+#ifdef MAP_HUGETLB
+    // Explicit huge pages are only available if the administrator reserved
+    // them, so failure here is expected on most systems
+    if (settings::huge_pages) {
+      ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      if (ptr != MAP_FAILED)
+        kind = PageKind::EXPLICIT;
+    }
+#endif
+
+    if (ptr == MAP_FAILED) {
+      ptr = map_aligned(length);
+      if (ptr == MAP_FAILED)
+        throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+      if (settings::huge_pages && madvise(ptr, length, MADV_HUGEPAGE) == 0)
+        kind = PageKind::TRANSPARENT;
+#endif
+    }
+
+#pragma omp critical(huge_pages)
+    {
+      mapped_kinds[ptr] = kind;
+      record(use, kind, nbytes, true);
+    }
+    return ptr;
+  }
+#endif
+
+  void* ptr = std::malloc(nbytes > 0 ? nbytes : 1);
+  if (!ptr)
+    throw std::bad_alloc();
+#pragma omp critical(huge_pages)
+  record(use, PageKind::REGULAR, nbytes, true);
+  return ptr;
+}
+
+void free_pages(void* ptr, size_t nbytes, PageUse use)
+{
+  if (!ptr)
+    return;
+
+#ifdef HAS_MEMORY_MAPPING
+  if (nbytes >= HUGE_PAGE_SIZE) {
+#pragma omp critical(huge_pages)
+    {
+      auto it = mapped_kinds.find(ptr);
+      record(use, it->second, nbytes, false);
+      mapped_kinds.erase(it);
+    }
+    munmap(ptr, mapped_length(nbytes));
+    return;
+  }
+#endif
+
+#pragma omp critical(huge_pages)
+  record(use, PageKind::REGULAR, nbytes, false);
+  std::free(ptr);
+}
+
+void print_huge_page_usage(PageUse use)
+{
+  if (!settings::huge_pages)
+    return;
+
+  const auto& n = usage[static_cast<int>(use)].nbytes;
+  size_t n_explicit = n[static_cast<int>(PageKind::EXPLICIT)];
+  size_t n_transparent = n[static_cast<int>(PageKind::TRANSPARENT)];
+  size_t n_regular = n[static_cast<int>(PageKind::REGULAR)];
+  const char* name =
+    use == PageUse::CROSS_SECTIONS ? "Nuclide cross sections" : "Tally results";
+  write_message(5,
+    "{}: {:.1f} MB in explicit huge pages, {:.1f} MB eligible for "
+    "transparent huge pages, {:.1f} MB in regular pages",
+    name, n_explicit / 1.0e6, n_transparent / 1.0e6, n_regular / 1.0e6);
+}
+
+} // namespace openmc
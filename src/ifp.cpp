@@ -0,0 +1,81 @@
+#include "openmc/ifp.h"
+
+#include "openmc/bank.h"
+#include "openmc/constants.h"
+#include "openmc/message_passing.h"
+#include "openmc/settings.h"
+#include "openmc/simulation.h"
+
+namespace openmc {
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace simulation {
+
+vector<IfpAncestor> ifp_source_bank;
+int ifp_n_ancestors {0};
+
+} // namespace simulation
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+void init_ifp_source_bank()
+{
+  simulation::ifp_source_bank.assign(
+    simulation::work_per_rank * settings::ifp_n_generation, IfpAncestor {});
+  simulation::ifp_n_ancestors = 0;
+}
+
+void ifp_fission_ancestry(const SourceSite& site, vector<IfpAncestor>& ancestry)
+{
+  // The parent was born from the source site at the same position as the
+  // offset used to sort the fission bank
+  int n_generation = settings::ifp_n_generation;
+  int n = simulation::ifp_n_ancestors;
+  int64_t i = site.parent_id - 1 - simulation::work_index[mpi::rank];
+  const IfpAncestor* parent = &simulation::ifp_source_bank[i * n_generation];
+
+  // Once all generations are known, the oldest ancestor of the parent is
+  // dropped to make room for the new one
+  int first = n < n_generation ? 0 : 1;
+  ancestry.insert(ancestry.end(), parent + first, parent + n);
+  IfpAncestor newest;
+  newest.lifetime = site.time - simulation::source_bank[i].time;
+  newest.delayed_group = site.delayed_group;
+  ancestry.push_back(newest);
+  ancestry.resize(ancestry.size() + first + n_generation - n - 1);
+}
+
+void ifp_next_generation()
+{
+  if (simulation::ifp_n_ancestors < settings::ifp_n_generation)
+    ++simulation::ifp_n_ancestors;
+}
+
+double score_ifp(const Particle& p, int score_bin)
+{
+  // Only fissions by neutrons whose ancestors go back the full number of
+  // generations are scored
+  if (p.type() != ParticleType::neutron || !p.fission())
+    return 0.0;
+  if (simulation::ifp_n_ancestors < settings::ifp_n_generation)
+    return 0.0;
+
+  // The oldest ancestor is the first of those of the particle's source site
+  int64_t i = (p.current_work() - 1) * settings::ifp_n_generation;
+  const auto& ancestor = simulation::ifp_source_bank[i];
+  switch (score_bin) {
+  case SCORE_IFP_TIME_NUM:
+    return ancestor.lifetime * p.wgt_last();
+  case SCORE_IFP_BETA_NUM:
+    return ancestor.delayed_group > 0 ? p.wgt_last() : 0.0;
+  default:
+    return p.wgt_last();
+  }
+}
+
+} // namespace openmc
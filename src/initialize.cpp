@@ -16,6 +16,7 @@
 #include "openmc/error.h"
 #include "openmc/geometry_aux.h"
 #include "openmc/hdf5_interface.h"
+#include "openmc/ifp.h"
 #include "openmc/material.h"
 #include "openmc/memory.h"
 #include "openmc/message_passing.h"
@@ -32,6 +33,7 @@
 #include "openmc/thermal.h"
 #include "openmc/timer.h"
 #include "openmc/vector.h"
+#include "openmc/weight_windows.h"
 
 #ifdef LIBMESH
 #include "libmesh/libmesh.h"
@@ -125,17 +127,38 @@ void initialize_mpi(MPI_Comm intracomm)
 {
   mpi::intracomm = intracomm;
 
-  // Initialize MPI
+  // Initialize MPI. With threads, any of them may be allowed to make MPI calls
+  // so that a thread can make progress on communication during transport.
   int flag;
   MPI_Initialized(&flag);
-  if (!flag)
+  int provided = MPI_THREAD_SINGLE;
+  if (!flag) {
+#ifdef _OPENMP
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#else
     MPI_Init(nullptr, nullptr);
+#endif
+  } else {
+    MPI_Query_thread(&provided);
+  }
+  mpi::thread_multiple = provided >= MPI_THREAD_MULTIPLE;
 
   // Determine number of processes and rank for each
   MPI_Comm_size(intracomm, &mpi::n_procs);
   MPI_Comm_rank(intracomm, &mpi::rank);
   mpi::master = (mpi::rank == 0);
 
+  // Group processes that can share memory with one another
+  MPI_Comm_split_type(intracomm, MPI_COMM_TYPE_SHARED, mpi::rank,
+    MPI_INFO_NULL, &mpi::node_intracomm);
+  MPI_Comm_size(mpi::node_intracomm, &mpi::n_procs_node);
+  MPI_Comm_rank(mpi::node_intracomm, &mpi::node_rank);
+
+  // Group the lowest-ranked process on each node so that results can be
+  // combined within each node before being combined across nodes
+  MPI_Comm_split(intracomm, mpi::node_rank == 0 ? 0 : MPI_UNDEFINED, mpi::rank,
+    &mpi::leader_intracomm);
+
   // Create bank datatype
   SourceSite b;
   MPI_Aint disp[10];
@@ -158,6 +181,52 @@ void initialize_mpi(MPI_Comm intracomm)
     MPI_DOUBLE, MPI_INT, MPI_INT, MPI_INT, MPI_LONG, MPI_LONG};
   MPI_Type_create_struct(10, blocks, disp, types, &mpi::source_site);
   MPI_Type_commit(&mpi::source_site);
+
+  // Create compact bank datatype
+  CompactSourceSite c;
+  MPI_Get_address(&c.r, &disp[0]);
+  MPI_Get_address(&c.E, &disp[1]);
+  MPI_Get_address(&c.time, &disp[2]);
+  MPI_Get_address(&c.wgt, &disp[3]);
+  MPI_Get_address(&c.parent_id, &disp[4]);
+  MPI_Get_address(&c.progeny_id, &disp[5]);
+  MPI_Get_address(&c.u, &disp[6]);
+  MPI_Get_address(&c.surf_id, &disp[7]);
+  MPI_Get_address(&c.particle, &disp[8]);
+  MPI_Get_address(&c.delayed_group, &disp[9]);
+  for (int i = 9; i >= 0; --i) {
+    disp[i] -= disp[0];
+  }
+
+  int compact_blocks[] {3, 1, 1, 1, 1, 1, 3, 1, 1, 1};
+  MPI_Datatype compact_types[] {MPI_DOUBLE, MPI_DOUBLE, MPI_DOUBLE,
+    MPI_DOUBLE, MPI_INT64_T, MPI_INT64_T, MPI_FLOAT, MPI_INT32_T, MPI_INT16_T,
+    MPI_INT16_T};
+  MPI_Datatype compact_struct;
+  MPI_Type_create_struct(
+    10, compact_blocks, disp, compact_types, &compact_struct);
+
+  // Resize the type so that arrays of sites account for trailing padding
+  MPI_Type_create_resized(
+    compact_struct, 0, sizeof(CompactSourceSite), &mpi::compact_source_site);
+  MPI_Type_commit(&mpi::compact_source_site);
+  MPI_Type_free(&compact_struct);
+
+  // Create datatype for the ancestors of source sites
+  IfpAncestor a;
+  MPI_Get_address(&a.lifetime, &disp[0]);
+  MPI_Get_address(&a.delayed_group, &disp[1]);
+  disp[1] -= disp[0];
+  disp[0] = 0;
+
+  int ifp_blocks[] {1, 1};
+  MPI_Datatype ifp_types[] {MPI_FLOAT, MPI_INT};
+  MPI_Datatype ifp_struct;
+  MPI_Type_create_struct(2, ifp_blocks, disp, ifp_types, &ifp_struct);
+  MPI_Type_create_resized(
+    ifp_struct, 0, sizeof(IfpAncestor), &mpi::ifp_ancestry);
+  MPI_Type_commit(&mpi::ifp_ancestry);
+  MPI_Type_free(&ifp_struct);
 }
 #endif // OPENMC_MPI
 
@@ -303,6 +372,10 @@ void read_input_xml()
 
   read_tallies_xml();
 
+  // Add the tallies used to generate weight windows
+  if (settings::run_mode != RunMode::PLOTTING)
+    create_weight_windows_generator_tallies();
+
   // Initialize distribcell_filters
   prepare_distribcell();
 
@@ -1,5 +1,6 @@
 #include "openmc/lattice.h"
 
+#include <algorithm> // for min
 #include <cmath>
 #include <string>
 
@@ -98,8 +99,8 @@ void Lattice::adjust_indices()
 
 //==============================================================================
 
-int32_t Lattice::fill_offset_table(int32_t offset, int32_t target_univ_id,
-  int map, std::unordered_map<int32_t, int32_t>& univ_count_memo)
+int32_t Lattice::fill_offset_table(
+  int32_t offset, int map, const vector<int32_t>& univ_counts)
 {
   // If the offsets have already been determined for this "map", don't bother
   // recalculating all of them and just return the total offset. Note that the
@@ -109,13 +110,12 @@ int32_t Lattice::fill_offset_table(int32_t offset, int32_t target_univ_id,
   if (offsets_[map * universes_.size()] != C_NONE) {
     int last_offset = offsets_[(map + 1) * universes_.size() - 1];
     int last_univ = universes_.back();
-    return last_offset +
-           count_universe_instances(last_univ, target_univ_id, univ_count_memo);
+    return last_offset + univ_counts[last_univ];
   }
 
   for (LatticeIter it = begin(); it != end(); ++it) {
     offsets_[map * universes_.size() + it.indx_] = offset;
-    offset += count_universe_instances(*it, target_univ_id, univ_count_memo);
+    offset += univ_counts[*it];
   }
   return offset;
 }
@@ -299,6 +299,72 @@ std::pair<double, array<int, 3>> RectLattice::distance(
 
 //==============================================================================
 
+std::pair<double, array<int, 3>> RectLattice::distance_dda(
+  LocalCoord& coord) const
+{
+  const Position& r {coord.r};
+  const Direction& u {coord.u};
+  auto& dist {coord.lattice_dist};
+
+  // Find the distance to the oncoming edge along each axis if the direction
+  // has changed since they were last computed, or if roundoff while updating
+  // them has put an edge behind the particle
+  int n_axes = is_3d_ ? 3 : 2;
+  if (coord.lattice_u != u ||
+      std::min({dist[0], dist[1], dist[2]}) < 0.0) {
+    for (int i = 0; i < 3; ++i) {
+      double x0 {copysign(0.5 * pitch_[i], u[i])};
+      if (i < n_axes && std::abs(r[i] - x0) > FP_PRECISION && u[i] != 0) {
+        dist[i] = (x0 - r[i]) / u[i];
+      } else {
+        dist[i] = INFTY;
+      }
+    }
+    coord.lattice_u = u;
+  }
+
+  // Select the nearest edge, preferring earlier axes in case of a tie
+  int i_min = 0;
+  for (int i = 1; i < n_axes; ++i) {
+    if (dist[i] < dist[i_min])
+      i_min = i;
+  }
+  array<int, 3> lattice_trans {0, 0, 0};
+  if (dist[i_min] < INFTY)
+    lattice_trans[i_min] = u[i_min] > 0 ? 1 : -1;
+  return {dist[i_min], lattice_trans};
+}
+
+//==============================================================================
+
+void RectLattice::cross_dda(
+  LocalCoord& coord, const array<int, 3>& translation) const
+{
+  if (coord.lattice_u != coord.u)
+    return;
+
+  // The next edge along the crossed axis is one pitch further
+  for (int i = 0; i < 3; ++i) {
+    if (translation[i] != 0)
+      coord.lattice_dist[i] += pitch_[i] / std::abs(coord.u[i]);
+  }
+}
+
+//==============================================================================
+
+Position RectLattice::cross_local_position(
+  Position r, const array<int, 3>& translation) const
+{
+  r.x -= translation[0] * pitch_.x;
+  r.y -= translation[1] * pitch_.y;
+  if (is_3d_) {
+    r.z -= translation[2] * pitch_.z;
+  }
+  return r;
+}
+
+//==============================================================================
+
 void RectLattice::get_indices(
   Position r, Direction u, array<int, 3>& result) const
 {
@@ -476,6 +542,16 @@ HexLattice::HexLattice(pugi::xml_node lat_node) : Lattice {lat_node}
     orientation_ = Orientation::y;
   }
 
+  // The beta, gamma, and delta faces are at +30, -30, and +90 degrees from
+  // the basis0 direction (see HexLattice::distance)
+  if (orientation_ == Orientation::y) {
+    face_normals_ = {{{std::sqrt(3.0) / 2.0, 0.5},
+      {std::sqrt(3.0) / 2.0, -0.5}, {0.0, 1.0}}};
+  } else {
+    face_normals_ = {{{1.0, 0.0}, {0.5, -std::sqrt(3.0) / 2.0},
+      {0.5, std::sqrt(3.0) / 2.0}}};
+  }
+
   // Read the lattice center.
   std::string center_str {get_node_value(lat_node, "center")};
   vector<std::string> center_words {split(center_str)};
@@ -723,19 +799,8 @@ std::pair<double, array<int, 3>> HexLattice::distance(
   //   beta   = (1, 0)            = +30 degrees from basis0
   //   gamma  = (1/2, -sqrt(3)/2) = -60 degrees from beta
   //   delta  = (1/2, sqrt(3)/2)  = +60 degrees from beta
-  // The z-axis is considered separately.
-  double beta_dir;
-  double gamma_dir;
-  double delta_dir;
-  if (orientation_ == Orientation::y) {
-    beta_dir = u.x * std::sqrt(3.0) / 2.0 + u.y / 2.0;
-    gamma_dir = u.x * std::sqrt(3.0) / 2.0 - u.y / 2.0;
-    delta_dir = u.y;
-  } else {
-    beta_dir = u.x;
-    gamma_dir = u.x / 2.0 - u.y * std::sqrt(3.0) / 2.0;
-    delta_dir = u.x / 2.0 + u.y * std::sqrt(3.0) / 2.0;
-  }
+  // The beta, gamma, and delta vectors are stored in face_normals_, and the
+  // z-axis is considered separately.
 
   // Note that hexagonal lattice distance calculations are performed
   // using the particle's coordinates relative to the neighbor lattice
@@ -743,84 +808,27 @@ std::pair<double, array<int, 3>> HexLattice::distance(
   // because there is significant disagreement between neighboring cells
   // on where the lattice boundary is due to finite precision issues.
 
-  // beta direction
+  // Change in the radial lattice indices when crossing the beta, gamma, and
+  // delta faces in their positive directions
+  constexpr int face_trans[3][2] {{1, 0}, {1, -1}, {0, 1}};
+
   double d {INFTY};
   array<int, 3> lattice_trans;
-  double edge = -copysign(0.5 * pitch_[0], beta_dir); // Oncoming edge
-  Position r_t;
-  if (beta_dir > 0) {
-    const array<int, 3> i_xyz_t {i_xyz[0] + 1, i_xyz[1], i_xyz[2]};
-    r_t = get_local_position(r, i_xyz_t);
-  } else {
-    const array<int, 3> i_xyz_t {i_xyz[0] - 1, i_xyz[1], i_xyz[2]};
-    r_t = get_local_position(r, i_xyz_t);
-  }
-  double beta;
-  if (orientation_ == Orientation::y) {
-    beta = r_t.x * std::sqrt(3.0) / 2.0 + r_t.y / 2.0;
-  } else {
-    beta = r_t.x;
-  }
-  if ((std::abs(beta - edge) > FP_PRECISION) && beta_dir != 0) {
-    d = (edge - beta) / beta_dir;
-    if (beta_dir > 0) {
-      lattice_trans = {1, 0, 0};
-    } else {
-      lattice_trans = {-1, 0, 0};
-    }
-  }
-
-  // gamma direction
-  edge = -copysign(0.5 * pitch_[0], gamma_dir);
-  if (gamma_dir > 0) {
-    const array<int, 3> i_xyz_t {i_xyz[0] + 1, i_xyz[1] - 1, i_xyz[2]};
-    r_t = get_local_position(r, i_xyz_t);
-  } else {
-    const array<int, 3> i_xyz_t {i_xyz[0] - 1, i_xyz[1] + 1, i_xyz[2]};
-    r_t = get_local_position(r, i_xyz_t);
-  }
-  double gamma;
-  if (orientation_ == Orientation::y) {
-    gamma = r_t.x * std::sqrt(3.0) / 2.0 - r_t.y / 2.0;
-  } else {
-    gamma = r_t.x / 2.0 - r_t.y * std::sqrt(3.0) / 2.0;
-  }
-  if ((std::abs(gamma - edge) > FP_PRECISION) && gamma_dir != 0) {
-    double this_d = (edge - gamma) / gamma_dir;
-    if (this_d < d) {
-      if (gamma_dir > 0) {
-        lattice_trans = {1, -1, 0};
-      } else {
-        lattice_trans = {-1, 1, 0};
-      }
-      d = this_d;
-    }
-  }
-
-  // delta direction
-  edge = -copysign(0.5 * pitch_[0], delta_dir);
-  if (delta_dir > 0) {
-    const array<int, 3> i_xyz_t {i_xyz[0], i_xyz[1] + 1, i_xyz[2]};
-    r_t = get_local_position(r, i_xyz_t);
-  } else {
-    const array<int, 3> i_xyz_t {i_xyz[0], i_xyz[1] - 1, i_xyz[2]};
-    r_t = get_local_position(r, i_xyz_t);
-  }
-  double delta;
-  if (orientation_ == Orientation::y) {
-    delta = r_t.y;
-  } else {
-    delta = r_t.x / 2.0 + r_t.y * std::sqrt(3.0) / 2.0;
-  }
-  if ((std::abs(delta - edge) > FP_PRECISION) && delta_dir != 0) {
-    double this_d = (edge - delta) / delta_dir;
-    if (this_d < d) {
-      if (delta_dir > 0) {
-        lattice_trans = {0, 1, 0};
-      } else {
-        lattice_trans = {0, -1, 0};
+  for (int k = 0; k < 3; ++k) {
+    const auto& n {face_normals_[k]};
+    double dir = n[0] * u.x + n[1] * u.y;
+    double edge = -copysign(0.5 * pitch_[0], dir); // Oncoming edge
+    int sign = (dir > 0) ? 1 : -1;
+    const array<int, 3> i_xyz_t {i_xyz[0] + sign * face_trans[k][0],
+      i_xyz[1] + sign * face_trans[k][1], i_xyz[2]};
+    Position r_t = get_local_position(r, i_xyz_t);
+    double x = n[0] * r_t.x + n[1] * r_t.y;
+    if ((std::abs(x - edge) > FP_PRECISION) && dir != 0) {
+      double this_d = (edge - x) / dir;
+      if (this_d < d) {
+        d = this_d;
+        lattice_trans = {sign * face_trans[k][0], sign * face_trans[k][1], 0};
       }
-      d = this_d;
     }
   }
 
@@ -847,6 +855,56 @@ std::pair<double, array<int, 3>> HexLattice::distance(
 
 //==============================================================================
 
+template<HexLattice::Orientation O>
+bool HexLattice::round_indices(Position r_o, array<int, 3>& result) const
+{
+  // Axial coordinates of the position in units of tile centers, such that the
+  // six neighbors of a tile are at offsets of +/-(1, 0), +/-(0, 1), and
+  // +/-(1, -1).  The third cube coordinate is s = -q - r.
+  double q, r;
+  if (O == Orientation::y) {
+    q = r_o.x / (0.5 * std::sqrt(3.0) * pitch_[0]);
+    r = r_o.y / pitch_[0] - 0.5 * q;
+  } else {
+    r = r_o.y / (0.5 * std::sqrt(3.0) * pitch_[0]);
+    q = r_o.x / pitch_[0] - 0.5 * r;
+  }
+  double s = -q - r;
+
+  // Round to the nearest tile center in cube coordinates, fixing up the
+  // coordinate with the largest rounding error so that they sum to zero
+  double q_i = std::round(q);
+  double r_i = std::round(r);
+  double s_i = std::round(s);
+  double dq = std::abs(q_i - q);
+  double dr = std::abs(r_i - r);
+  double ds = std::abs(s_i - s);
+  if (dq > dr && dq > ds) {
+    q_i = -r_i - s_i;
+  } else if (dr > ds) {
+    r_i = -q_i - s_i;
+  }
+  s_i = -q_i - r_i;
+
+  // The edge shared with a neighbor is where the difference of two cube
+  // offsets from the center reaches one.  Close to an edge, leave the choice
+  // to the coincidence checks in get_indices.
+  constexpr double margin {1e-6};
+  dq = q - q_i;
+  dr = r - r_i;
+  ds = s - s_i;
+  double width = std::max(
+    {std::abs(dq - dr), std::abs(dr - ds), std::abs(ds - dq)});
+  if (width > 1.0 - margin)
+    return false;
+
+  result[0] = static_cast<int>(q_i) + n_rings_ - 1;
+  result[1] = static_cast<int>(r_i) + n_rings_ - 1;
+  return true;
+}
+
+//==============================================================================
+
 void HexLattice::get_indices(
   Position r, Direction u, array<int, 3>& result) const
 {
@@ -868,6 +926,13 @@ void HexLattice::get_indices(
     }
   }
 
+  // Away from the edges of the tiles, the tile is found directly by rounding
+  bool found = (orientation_ == Orientation::y)
+                 ? round_indices<Orientation::y>(r_o, result)
+                 : round_indices<Orientation::x>(r_o, result);
+  if (found)
+    return;
+
   if (orientation_ == Orientation::y) {
     // Convert coordinates into skewed bases.  The (x, alpha) basis is used to
     // find the index of the global coordinates to within 4 cells.
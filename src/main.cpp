@@ -31,7 +31,11 @@ int main(int argc, char* argv[])
   switch (settings::run_mode) {
   case RunMode::FIXED_SOURCE:
   case RunMode::EIGENVALUE:
-    err = openmc_run();
+    err = settings::random_ray ? openmc_run_random_ray() : openmc_run();
+
+    // Weight windows generated with FW-CADIS are used in a Monte Carlo run
+    if (!err && settings::random_ray && settings::fw_cadis)
+      err = openmc_run();
     break;
   case RunMode::PLOTTING:
     err = openmc_plot_geometry();
@@ -0,0 +1,283 @@
+#include "openmc/majorant.h"
+
+#include <algorithm> // for max, min
+#include <cmath>     // for log, pow
+#include <map>
+#include <set>
+#include <string>
+
+#include "openmc/capi.h"
+#include "openmc/cell.h"
+#include "openmc/constants.h"
+#include "openmc/error.h"
+#include "openmc/lattice.h"
+#include "openmc/material.h"
+#include "openmc/nuclide.h"
+#include "openmc/particle_data.h"
+#include "openmc/settings.h"
+#include "openmc/simulation.h"
+#include "openmc/thermal.h"
+#include "openmc/timer.h"
+#include "openmc/universe.h"
+
+namespace openmc {
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace simulation {
+
+vector<Majorant> majorants;
+vector<int> universe_majorant;
+int global_majorant {C_NONE};
+
+} // namespace simulation
+
+//==============================================================================
+// Majorant implementation
+//==============================================================================
+
+double Majorant::operator()(double E) const
+{
+  int neutron = static_cast<int>(ParticleType::neutron);
+  int k = std::log(E / data::energy_min[neutron]) / simulation::log_spacing;
+  k = std::max(0, std::min(k, static_cast<int>(xs_.size()) - 1));
+  return xs_[k];
+}
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+namespace {
+
+// Number of intervals in each logarithmic bin at which S(a,b) cross sections
+// are evaluated for the majorant
+constexpr int N_SAB_INTERVALS {4};
+
+// Bounds computed so far, which are empty until they are needed
+vector<vector<double>> nuclide_bounds;  //!< Microscopic bound of each nuclide
+vector<vector<double>> material_bounds; //!< Macroscopic bound of each material
+
+// Index in simulation::majorants of the majorant of each set of materials
+std::map<std::set<int32_t>, int> set_majorant;
+
+//! Collect the materials filling a universe at any depth
+void collect_materials(
+  int32_t i_univ, vector<bool>& visited, std::set<int32_t>& materials)
+{
+  if (visited[i_univ])
+    return;
+  visited[i_univ] = true;
+
+  for (auto i_cell : model::universes[i_univ]->cells_) {
+    const auto& c {*model::cells[i_cell]};
+    switch (c.type_) {
+    case Fill::MATERIAL:
+      for (auto i_mat : c.material_) {
+        if (i_mat != MATERIAL_VOID)
+          materials.insert(i_mat);
+      }
+      break;
+    case Fill::UNIVERSE:
+      collect_materials(c.fill_, visited, materials);
+      break;
+    case Fill::LATTICE: {
+      const auto& lat {*model::lattices[c.fill_]};
+      for (auto i : lat.universes_) {
+        if (i != C_NONE)
+          collect_materials(i, visited, materials);
+      }
+      if (lat.outer_ != NO_OUTER_UNIVERSE)
+        collect_materials(lat.outer_, visited, materials);
+      break;
+    }
+    }
+  }
+}
+
+//! Determine an upper bound on the total macroscopic cross section of a
+//! material in each bin of the logarithmic energy grid. The bounds of its
+//! nuclides have to be known.
+vector<double> material_bound(const Material& mat)
+{
+  int M = settings::n_log_bins;
+  vector<double> bound(M, 0.0);
+  for (int i = 0; i < mat.nuclide_.size(); ++i) {
+    const auto& xs {nuclide_bounds[mat.nuclide_[i]]};
+    for (int k = 0; k < M; ++k) {
+      bound[k] += mat.atom_density_(i) * xs[k];
+    }
+  }
+
+  // Below their maximum energy, S(a,b) tables add their elastic and inelastic
+  // cross sections for the fraction of the nuclide they apply to
+  for (const auto& table : mat.thermal_tables_) {
+    const auto& sab {*data::thermal_scatt[table.index_table]};
+    double N = mat.atom_density_(table.index_nuclide) * table.fraction;
+    for (int k = 0; k < M; ++k) {
+      double E_low = simulation::log_grid_energy[k];
+      if (E_low >= sab.energy_max_)
+        break;
+      double E_high =
+        std::min(simulation::log_grid_energy[k + 1], sab.energy_max_);
+
+      double xs_max = 0.0;
+      for (const auto& data : sab.data_) {
+        for (int j = 0; j <= N_SAB_INTERVALS; ++j) {
+          double E = E_low * std::pow(E_high / E_low,
+                               static_cast<double>(j) / N_SAB_INTERVALS);
+          double elastic, inelastic;
+          data.calculate_xs(E, &elastic, &inelastic);
+          xs_max = std::max(xs_max, elastic + inelastic);
+        }
+      }
+      bound[k] += N * xs_max;
+    }
+  }
+  return bound;
+}
+
+//! Compute the bounds of a set of materials and of their nuclides that aren't
+//! known yet
+void compute_bounds(const std::set<int32_t>& materials)
+{
+  nuclide_bounds.resize(data::nuclides.size());
+  material_bounds.resize(model::materials.size());
+
+  vector<int32_t> mats;
+  std::set<int> nucs;
+  for (auto i_mat : materials) {
+    if (!material_bounds[i_mat].empty())
+      continue;
+    mats.push_back(i_mat);
+    for (auto i_nuc : model::materials[i_mat]->nuclide_) {
+      if (nuclide_bounds[i_nuc].empty())
+        nucs.insert(i_nuc);
+    }
+  }
+  vector<int> nuclides(nucs.begin(), nucs.end());
+
+  // Bounding a nuclide scans its energy grid at every temperature, reading
+  // deferred temperatures as needed
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < nuclides.size(); ++i) {
+    int i_nuc = nuclides[i];
+    nuclide_bounds[i_nuc] = data::nuclides[i_nuc]->total_xs_bound();
+  }
+
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < mats.size(); ++i) {
+    material_bounds[mats[i]] = material_bound(*model::materials[mats[i]]);
+  }
+}
+
+//! Find the majorant of a set of materials whose bounds are known, adding it
+//! if no other universe has the same materials
+int majorant_index(const std::set<int32_t>& materials)
+{
+  auto it = set_majorant.find(materials);
+  if (it != set_majorant.end())
+    return it->second;
+
+  vector<double> xs(settings::n_log_bins, 0.0);
+  for (auto i_mat : materials) {
+    const auto& bound {material_bounds[i_mat]};
+    for (int k = 0; k < xs.size(); ++k) {
+      xs[k] = std::max(xs[k], bound[k]);
+    }
+  }
+  int i_majorant = simulation::majorants.size();
+  simulation::majorants.emplace_back(std::move(xs));
+  set_majorant.emplace(materials, i_majorant);
+  return i_majorant;
+}
+
+} // namespace
+
+void compute_majorants(const vector<int32_t>& universes)
+{
+  simulation::universe_majorant.resize(model::universes.size(), C_NONE);
+
+  // Determine the materials in each universe without a majorant
+  vector<int32_t> pending;
+  vector<std::set<int32_t>> pending_materials;
+  std::set<int32_t> all_materials;
+  for (auto i_univ : universes) {
+    if (simulation::universe_majorant[i_univ] != C_NONE)
+      continue;
+    std::set<int32_t> materials;
+    vector<bool> visited(model::universes.size(), false);
+    collect_materials(i_univ, visited, materials);
+    all_materials.insert(materials.begin(), materials.end());
+    pending.push_back(i_univ);
+    pending_materials.push_back(std::move(materials));
+  }
+  if (pending.empty())
+    return;
+
+  Timer timer;
+  timer.start();
+  compute_bounds(all_materials);
+  for (int i = 0; i < pending.size(); ++i) {
+    simulation::universe_majorant[pending[i]] =
+      majorant_index(pending_materials[i]);
+  }
+  timer.stop();
+  write_message(6, "Time computing majorants: {:.3f} s", timer.elapsed());
+}
+
+void compute_global_majorant()
+{
+  if (simulation::global_majorant != C_NONE)
+    return;
+
+  std::set<int32_t> materials;
+  for (int32_t i = 0; i < model::materials.size(); ++i) {
+    materials.insert(i);
+  }
+  compute_bounds(materials);
+  simulation::global_majorant = majorant_index(materials);
+}
+
+void free_memory_majorant()
+{
+  simulation::majorants.clear();
+  simulation::universe_majorant.clear();
+  simulation::global_majorant = C_NONE;
+  nuclide_bounds.clear();
+  material_bounds.clear();
+  set_majorant.clear();
+}
+
+//==============================================================================
+// C API functions
+//==============================================================================
+
+extern "C" int openmc_majorant_xs(int32_t id, double E, double* xs)
+{
+  if (!settings::run_CE || simulation::log_grid_energy.empty()) {
+    set_errmsg("Majorants require continuous-energy data and an initialized "
+               "simulation.");
+    return OPENMC_E_ALLOCATE;
+  }
+
+  int i_majorant;
+  if (id == C_NONE) {
+    compute_global_majorant();
+    i_majorant = simulation::global_majorant;
+  } else {
+    auto it = model::universe_map.find(id);
+    if (it == model::universe_map.end()) {
+      set_errmsg("No universe exists with ID=" + std::to_string(id) + ".");
+      return OPENMC_E_INVALID_ID;
+    }
+    compute_majorants({it->second});
+    i_majorant = simulation::universe_majorant[it->second];
+  }
+  *xs = simulation::majorants[i_majorant](E);
+  return 0;
+}
+
+} // namespace openmc
@@ -7,11 +7,14 @@
 #include <string>
 #include <unordered_set>
 
+#include <fmt/core.h>
+
 #include "xtensor/xbuilder.hpp"
 #include "xtensor/xoperation.hpp"
 #include "xtensor/xview.hpp"
 
 #include "openmc/capi.h"
+#include "openmc/cell.h"
 #include "openmc/container_util.h"
 #include "openmc/cross_sections.h"
 #include "openmc/error.h"
@@ -21,11 +24,14 @@
 #include "openmc/message_passing.h"
 #include "openmc/mgxs_interface.h"
 #include "openmc/nuclide.h"
+#include "openmc/offload.h"
 #include "openmc/photon.h"
 #include "openmc/search.h"
 #include "openmc/settings.h"
 #include "openmc/simulation.h"
 #include "openmc/string_utils.h"
+#include "openmc/tallies/derivative.h"
+#include "openmc/tallies/tally.h"
 #include "openmc/thermal.h"
 #include "openmc/xml_interface.h"
 
@@ -64,6 +70,10 @@ Material::Material(pugi::xml_node node)
     depletable_ = get_node_value_bool(node, "depletable");
   }
 
+  if (check_for_node(node, "tabulate_xs")) {
+    tabulate_xs_ = get_node_value_bool(node, "tabulate_xs");
+  }
+
   bool sum_density {false};
   pugi::xml_node density_node = node.child("density");
   std::string units;
@@ -359,7 +369,7 @@ void Material::finalize()
 
     // Generate material bremsstrahlung data for electrons and positrons
     if (settings::photon_transport &&
-        settings::electron_treatment == ElectronTreatment::TTB) {
+        settings::electron_treatment != ElectronTreatment::LED) {
       this->init_bremsstrahlung();
     }
 
@@ -369,6 +379,12 @@ void Material::finalize()
 
 // Normalize density
 this->normalize_density();
+
+// Condensed history needs the atom densities of the material
+if (settings::run_CE && settings::photon_transport &&
+    settings::electron_treatment == ElectronTreatment::CH) {
+  this->init_condensed_history();
+}
 }
 
 void Material::normalize_density()
@@ -502,7 +518,7 @@ void Material::collision_stopping_power(double* s_col, bool positron)
 
     // Get atomic density of nuclide given atom/weight percent
     double atom_density =
-      (atom_density_[0] > 0.0) ? atom_density_[i] : -atom_density_[i] / awr;
+      (atom_density_[0] >= 0.0) ? atom_density_[i] : -atom_density_[i] / awr;
 
     electron_density += atom_density * elm.Z_;
     mass_density += atom_density * awr * MASS_NEUTRON;
@@ -597,6 +613,8 @@ void Material::init_bremsstrahlung()
     // Allocate arrays for TTB data
     ttb->pdf = xt::zeros<double>({n_e, n_e});
     ttb->cdf = xt::zeros<double>({n_e, n_e});
+    ttb->exponent = xt::zeros<double>({n_e, n_e});
+    ttb->guide = xt::zeros<int>({n_e, n_e});
     ttb->yield = xt::empty<double>({n_e});
 
     // Allocate temporary arrays
@@ -620,7 +638,7 @@ void Material::init_bremsstrahlung()
       // Get atomic density and mass density of nuclide given atom/weight
       // percent
       double atom_density =
-        (atom_density_[0] > 0.0) ? atom_density_[i] : -atom_density_[i] / awr;
+        (atom_density_[0] >= 0.0) ? atom_density_[i] : -atom_density_[i] / awr;
 
       // Calculate the "equivalent" atomic number Zeq of the material
       Z_eq_sq += atom_density * elm.Z_ * elm.Z_;
@@ -636,27 +654,31 @@ void Material::init_bremsstrahlung()
 
     // Calculate the positron DCS and radiative stopping power. These are
     // obtained by multiplying the electron DCS and radiative stopping powers by
-    // a factor r, which is a numerical approximation of the ratio of the
-    // radiative stopping powers for positrons and electrons. Source: F. Salvat,
-    // J. M. Fernández-Varea, and J. Sempau, "PENELOPE-2011: A Code System for
-    // Monte Carlo Simulation of Electron and Photon Transport," OECD-NEA,
-    // Issy-les-Moulineaux, France (2011).
+    // the ratio of the radiative stopping powers for positrons and electrons.
     if (positron) {
       for (int i = 0; i < n_e; ++i) {
-        double t = std::log(
-          1.0 + 1.0e6 * data::ttb_e_grid(i) / (Z_eq_sq * MASS_ELECTRON_EV));
-        double r =
-          1.0 -
-          std::exp(-1.2359e-1 * t + 6.1274e-2 * std::pow(t, 2) -
-                   3.1516e-2 * std::pow(t, 3) + 7.7446e-3 * std::pow(t, 4) -
-                   1.0595e-3 * std::pow(t, 5) + 7.0568e-5 * std::pow(t, 6) -
-                   1.808e-6 * std::pow(t, 7));
+        double r = positron_radiative_ratio(data::ttb_e_grid(i), Z_eq_sq);
         stopping_power_radiative(i) *= r;
         auto dcs_i = xt::view(dcs, i, xt::all());
         dcs_i *= r;
       }
     }
 
+    // Condensed history samples photon energies from the DCS at each incident
+    // energy by rejection, so each row is scaled by its maximum
+    if (settings::electron_treatment == ElectronTreatment::CH) {
+      ttb->dcs = dcs;
+      for (int i = 0; i < n_e; ++i) {
+        auto dcs_i = xt::view(ttb->dcs, i, xt::all());
+        double dcs_max = *std::max_element(dcs_i.begin(), dcs_i.end());
+        if (dcs_max > 0.0) {
+          dcs_i /= dcs_max;
+        } else {
+          dcs_i = 1.0;
+        }
+      }
+    }
+
     // Total material stopping power
     xt::xtensor<double, 1> stopping_power =
       stopping_power_collision + stopping_power_radiative;
@@ -743,10 +765,24 @@ void Material::init_bremsstrahlung()
 
         c += 0.5 * (w_r - w_l) * (std::exp(w_l + x_l) + std::exp(w_r + x_r));
         ttb->cdf(j, i + 1) = c;
+
+        // Exponent used when sampling the photon energy on this interval
+        ttb->exponent(j, i) =
+          std::log(ttb->pdf(j, i + 1) / ttb->pdf(j, i)) / (w_r - w_l) + 1.0;
       }
 
       // Set photon number yield
       ttb->yield(j) = c;
+
+      // Entry g of the guide table is the interval of the CDF containing g / j
+      // of the yield, found as by lower_bound_index()
+      int i = 0;
+      for (int g = 0; g < j; ++g) {
+        double value = c * g / j;
+        while (i + 1 < j && ttb->cdf(j, i + 1) < value)
+          ++i;
+        ttb->guide(j, g) = i;
+      }
     }
 
     // Use logarithm of number yield since it is log-log interpolated
@@ -754,6 +790,70 @@ void Material::init_bremsstrahlung()
   }
 }
 
+void Material::init_condensed_history()
+{
+  auto n_e = data::ttb_e_grid.size();
+  int n = element_.size();
+
+  // Classical electron radius in cm
+  constexpr double CM_PER_ANGSTROM {1.0e-8};
+  constexpr double r_e =
+    CM_PER_ANGSTROM * PLANCK_C / (2.0 * PI * FINE_STRUCTURE * MASS_ELECTRON_EV);
+
+  // Determine the equivalent atomic number and the radiation length of the
+  // material, with atom densities in [atom/b-cm] converted to [atom/cm^3]
+  constexpr double CM_SQ_PER_BARN {1.0e24};
+  double Z_eq_sq = 0.0;
+  double sum_density = 0.0;
+  double inv_radiation_length = 0.0;
+  for (int i = 0; i < n; ++i) {
+    const auto& elm = *data::elements[element_[i]];
+    Z_eq_sq += atom_density_(i) * elm.Z_ * elm.Z_;
+    sum_density += atom_density_(i);
+    inv_radiation_length += atom_density_(i) * radiation_length_factor(elm.Z_);
+  }
+  Z_eq_sq /= sum_density;
+  inv_radiation_length *= 4.0 * r_e * r_e * CM_SQ_PER_BARN / FINE_STRUCTURE;
+  ttb_->radiation_length = 1.0 / inv_radiation_length;
+
+  for (int particle = 0; particle < 2; ++particle) {
+    BremsstrahlungData* ttb =
+      (particle == 0) ? &ttb_->electron : &ttb_->positron;
+    bool positron = (particle == 1);
+
+    // Get the collision stopping power of the material in [eV/cm]
+    xt::xtensor<double, 1> stopping_power({n_e}, 0.0);
+    this->collision_stopping_power(stopping_power.data(), positron);
+
+    // Add the radiative stopping power, converting the element stopping
+    // cross sections from [eV-mb] to [eV-b]
+    constexpr double BARN_PER_MILLIBARN {1.0e-3};
+    for (int i = 0; i < n; ++i) {
+      const auto& elm = *data::elements[element_[i]];
+      for (int j = 0; j < n_e; ++j) {
+        double s_rad = BARN_PER_MILLIBARN * atom_density_(i) *
+                       elm.stopping_power_radiative_(j);
+        if (positron) {
+          s_rad *= positron_radiative_ratio(data::ttb_e_grid(j), Z_eq_sq);
+        }
+        stopping_power(j) += s_rad;
+      }
+    }
+
+    // Integrate the inverse stopping power over energy with the trapezoidal
+    // rule in log energy, taking the range to be zero at the lowest energy
+    ttb->range = xt::zeros<double>({n_e});
+    for (int j = 1; j < n_e; ++j) {
+      double e_l = data::ttb_e_grid(j - 1);
+      double e_r = data::ttb_e_grid(j);
+      ttb->range(j) =
+        ttb->range(j - 1) + 0.5 * std::log(e_r / e_l) *
+                              (e_l / stopping_power(j - 1) +
+                                e_r / stopping_power(j));
+    }
+  }
+}
+
 void Material::init_nuclide_index()
 {
   int n = settings::run_CE ? data::nuclides.size() : data::mg.nuclides_.size();
@@ -764,7 +864,296 @@ void Material::init_nuclide_index()
   }
 }
 
-void Material::calculate_xs(Particle& p) const
+size_t Material::init_union_grid()
+{
+  union_grid_ = {};
+  if (nuclide_.empty())
+    return 0;
+
+  // Merge energy grids at all temperatures of all nuclides in the material
+  auto& energy = union_grid_.energy;
+  for (int i_nuc : nuclide_) {
+    for (const auto& grid : data::nuclides[i_nuc]->grid_) {
+      energy.insert(energy.end(), grid.energy.begin(), grid.energy.end());
+    }
+  }
+  std::sort(energy.begin(), energy.end());
+  energy.erase(std::unique(energy.begin(), energy.end()), energy.end());
+  if (energy.size() < 2) {
+    energy.clear();
+    return 0;
+  }
+
+  // Determine indices on the union grid corresponding to the logarithmic grid
+  int M = settings::n_log_bins;
+  union_grid_.grid_index.resize(M + 1);
+  int j = 0;
+  for (int k = 0; k <= M; ++k) {
+    double E = simulation::log_grid_energy[k];
+    while (j + 2 < energy.size() && energy[j + 1] <= E) {
+      ++j;
+    }
+    union_grid_.grid_index[k] = j;
+  }
+
+  // For each nuclide and temperature, store the index of the interval on the
+  // nuclide grid that contains each union grid interval
+  size_t n_union = energy.size();
+  union_grid_.nuclide_index.resize(nuclide_.size());
+  for (int i = 0; i < nuclide_.size(); ++i) {
+    const auto& nuc {*data::nuclides[nuclide_[i]]};
+    auto& maps = union_grid_.nuclide_index[i];
+    maps.resize(nuc.grid_.size());
+    for (int t = 0; t < nuc.grid_.size(); ++t) {
+      // Temperatures read lazily later fall back to the regular search
+      const auto& E_nuc = nuc.grid_[t].energy;
+      if (E_nuc.empty())
+        continue;
+      int n = E_nuc.size();
+      maps[t].resize(n_union);
+      int k = 0;
+      for (int m = 0; m < n_union; ++m) {
+        while (k + 2 < n && E_nuc[k + 1] <= energy[m]) {
+          ++k;
+        }
+        maps[t][m] = k;
+      }
+    }
+  }
+
+  size_t bytes = sizeof(double) * n_union + sizeof(int) * (M + 1);
+  for (const auto& maps : union_grid_.nuclide_index) {
+    for (const auto& map : maps) {
+      bytes += sizeof(int) * map.size();
+    }
+  }
+  return bytes;
+}
+
+size_t Material::init_photon_union_grid()
+{
+  photon_union_grid_ = {};
+  if (element_.empty())
+    return 0;
+
+  // Merge the log energy grids of all elements in the material
+  auto& energy = photon_union_grid_.energy;
+  for (int i_elem : element_) {
+    const auto& E_elem = data::elements[i_elem]->energy_;
+    energy.insert(energy.end(), E_elem.begin(), E_elem.end());
+  }
+  std::sort(energy.begin(), energy.end());
+  energy.erase(std::unique(energy.begin(), energy.end()), energy.end());
+  if (energy.size() < 2) {
+    energy.clear();
+    return 0;
+  }
+
+  // For each element, store the index of the interval on the element grid
+  // that contains each union grid interval, treating points off either end of
+  // the element grid and repeated points the same way as
+  // PhotonInteraction::calculate_xs
+  size_t n_union = energy.size();
+  photon_union_grid_.element_index.resize(element_.size());
+  for (int i = 0; i < element_.size(); ++i) {
+    const auto& E_elem = data::elements[element_[i]]->energy_;
+    int n = E_elem.size();
+    auto& map = photon_union_grid_.element_index[i];
+    map.resize(n_union);
+    int k = 0;
+    for (int m = 0; m < n_union; ++m) {
+      while (k + 2 < n && E_elem[k + 1] <= energy[m]) {
+        ++k;
+      }
+      map[m] = (E_elem[k] == E_elem[k + 1]) ? k + 1 : k;
+    }
+  }
+
+  return sizeof(double) * n_union +
+         sizeof(int) * n_union * photon_union_grid_.element_index.size();
+}
+
+size_t Material::init_macro_xs_tables()
+{
+  macro_xs_tables_.clear();
+  macro_xs_table_index_.clear();
+  macro_xs_excluded_.clear();
+  if (union_grid_.energy.empty())
+    return 0;
+
+  // Choosing between bounding temperatures is stochastic, so tables can only
+  // represent the nearest temperature method
+  if (settings::temperature_method != TemperatureMethod::NEAREST) {
+    warning(fmt::format("Macroscopic cross sections for material {} will not "
+                        "be tabulated since temperature interpolation is on.",
+      id_));
+    return 0;
+  }
+
+  // Determine energy ranges where cross sections do not follow from linear
+  // interpolation of the pointwise data
+  for (const auto& table : thermal_tables_) {
+    macro_xs_excluded_.emplace_back(
+      0.0, data::thermal_scatt[table.index_table]->energy_max_);
+  }
+  for (int i_nuc : nuclide_) {
+    const auto& nuc {*data::nuclides[i_nuc]};
+    if (nuc.multipole_) {
+      macro_xs_excluded_.emplace_back(
+        nuc.multipole_->E_min_, nuc.multipole_->E_max_);
+    }
+    if (settings::urr_ptables_on && nuc.urr_present_) {
+      for (const auto& urr : nuc.urr_data_) {
+        macro_xs_excluded_.emplace_back(urr.energy_.front(), urr.energy_.back());
+      }
+    }
+  }
+
+  // Collect distinct temperatures of cells filled with this material as
+  // indices in data::cell_sqrtkT
+  vector<int> i_sqrtkTs;
+  for (const auto& c : model::cells) {
+    int n = std::max(c->material_.size(), c->i_sqrtkT_.size());
+    for (int i = 0; i < n; ++i) {
+      int i_mat = c->material_[c->material_.size() > 1 ? i : 0];
+      int i_sqrtkT = c->i_sqrtkT_[c->i_sqrtkT_.size() > 1 ? i : 0];
+      if (i_mat == index_ && !contains(i_sqrtkTs, i_sqrtkT))
+        i_sqrtkTs.push_back(i_sqrtkT);
+    }
+  }
+
+  // Cell temperatures that select the same temperature of every nuclide share
+  // a table
+  macro_xs_table_index_.assign(data::cell_sqrtkT.size(), C_NONE);
+  for (int i_sqrtkT : i_sqrtkTs) {
+    vector<int> i_temp;
+    for (int i_nuc : nuclide_) {
+      i_temp.push_back(data::nuclides[i_nuc]->cell_temp_index_[i_sqrtkT]);
+    }
+    int i_table = 0;
+    while (i_table < macro_xs_tables_.size() &&
+           macro_xs_tables_[i_table].i_temp != i_temp) {
+      ++i_table;
+    }
+    if (i_table == macro_xs_tables_.size()) {
+      MacroXSTable table;
+      table.i_temp = std::move(i_temp);
+      macro_xs_tables_.push_back(std::move(table));
+    }
+    macro_xs_table_index_[i_sqrtkT] = i_table;
+  }
+
+  // Sum nuclide contributions at each point on the unionized grid
+  const auto& energy {union_grid_.energy};
+  size_t n_union = energy.size();
+  for (auto& table : macro_xs_tables_) {
+    table.xs = xt::zeros<double>({n_union, static_cast<size_t>(4)});
+    for (int i = 0; i < nuclide_.size(); ++i) {
+      const auto& nuc {*data::nuclides[nuclide_[i]]};
+      int i_temp = table.i_temp[i];
+      const auto& map {union_grid_.nuclide_index[i][i_temp]};
+      for (int m = 0; m < n_union; ++m) {
+        auto micro = nuc.interpolate_xs(i_temp, map[m], energy[m]);
+        for (int k = 0; k < 4; ++k) {
+          table.xs(m, k) += atom_density_(i) * micro[k];
+        }
+      }
+    }
+  }
+
+  return sizeof(double) * 4 * n_union * macro_xs_tables_.size();
+}
+
+size_t Material::memory_usage() const
+{
+  size_t bytes = sizeof(double) * union_grid_.energy.size() +
+                 sizeof(int) * union_grid_.grid_index.size();
+  for (const auto& maps : union_grid_.nuclide_index) {
+    for (const auto& map : maps) {
+      bytes += sizeof(int) * map.size();
+    }
+  }
+  bytes += sizeof(double) * photon_union_grid_.energy.size();
+  for (const auto& map : photon_union_grid_.element_index) {
+    bytes += sizeof(int) * map.size();
+  }
+  for (const auto& table : macro_xs_tables_) {
+    bytes += sizeof(double) * table.xs.size();
+  }
+  return bytes;
+}
+
+int Material::union_grid_index(double E, int i_log_union) const
+{
+  return union_grid_interval(union_grid_.energy.data(),
+    union_grid_.energy.size(), union_grid_.grid_index.data(), E, i_log_union);
+}
+
+int Material::macro_xs_table(const Particle& p) const
+{
+  if (macro_xs_tables_.empty())
+    return C_NONE;
+
+  // Track-length tallies and derivatives rely on the microscopic cross
+  // sections, which are not updated when a table is used
+  if (!model::active_tracklength_tallies.empty() || !model::tally_derivs.empty())
+    return C_NONE;
+
+  double E = p.E();
+  for (const auto& range : macro_xs_excluded_) {
+    if (E >= range.first && E <= range.second)
+      return C_NONE;
+  }
+
+  // Find the table for the particle's temperature by its index in
+  // data::cell_sqrtkT. Only temperatures that came from a cell have one.
+  int i_sqrtkT = p.i_sqrtkT();
+  if (i_sqrtkT < 0)
+    return C_NONE;
+  if (i_sqrtkT < macro_xs_table_index_.size())
+    return macro_xs_table_index_[i_sqrtkT];
+
+  // A cell temperature assigned after the tables were built can still select
+  // the same temperature of every nuclide as one of them
+  for (int i_table = 0; i_table < macro_xs_tables_.size(); ++i_table) {
+    const auto& i_temp {macro_xs_tables_[i_table].i_temp};
+    int i = 0;
+    while (i < nuclide_.size() &&
+           data::nuclides[nuclide_[i]]->cell_temp_index_[i_sqrtkT] ==
+             i_temp[i]) {
+      ++i;
+    }
+    if (i == nuclide_.size())
+      return i_table;
+  }
+  return C_NONE;
+}
+
+bool Material::calculate_tabulated_xs(Particle& p) const
+{
+  int i_table = this->macro_xs_table(p);
+  if (i_table == C_NONE)
+    return false;
+
+  // Interpolate on the unionized grid
+  double E = p.E();
+  int neutron = static_cast<int>(ParticleType::neutron);
+  int i_log_union =
+    std::log(E / data::energy_min[neutron]) / simulation::log_spacing;
+  int i = this->union_grid_index(E, i_log_union);
+
+  // This is the same interpolation that is done on an offload device
+  double xs[4];
+  interpolate_macro_xs(union_grid_.energy.data(),
+    macro_xs_tables_[i_table].xs.data(), i, E, xs);
+  p.macro_xs().total = xs[0];
+  p.macro_xs().absorption = xs[1];
+  p.macro_xs().fission = xs[2];
+  p.macro_xs().nu_fission = xs[3];
+  return true;
+}
+
+void Material::calculate_xs(Particle& p, bool tabulated) const
 {
   // Set all material macroscopic cross sections to zero
   p.macro_xs().total = 0.0;
@@ -773,19 +1162,146 @@ void Material::calculate_xs(Particle& p) const
   p.macro_xs().nu_fission = 0.0;
 
   if (p.type() == ParticleType::neutron) {
-    this->calculate_neutron_xs(p);
+    this->calculate_neutron_xs(p, tabulated);
   } else if (p.type() == ParticleType::photon) {
     this->calculate_photon_xs(p);
   }
 }
 
-void Material::calculate_neutron_xs(Particle& p) const
+void Material::calculate_xs(gsl::span<Particle*> particles) const
+{
+  int neutron = static_cast<int>(ParticleType::neutron);
+  bool use_union = !union_grid_.energy.empty();
+
+  // Determine grid indices for each particle. Particles whose macroscopic
+  // cross sections come from a table are removed from the batch.
+  size_t n = 0;
+  vector<int> i_log_union(particles.size());
+  vector<int> i_union(particles.size());
+  for (auto* p : particles) {
+    p->macro_xs().total = 0.0;
+    p->macro_xs().absorption = 0.0;
+    p->macro_xs().fission = 0.0;
+    p->macro_xs().nu_fission = 0.0;
+    p->enter_material_neutron_xs(p->material());
+    p->xs_cdf().clear();
+    if (!macro_xs_tables_.empty() && this->calculate_tabulated_xs(*p))
+      continue;
+
+    i_log_union[n] =
+      std::log(p->E() / data::energy_min[neutron]) / simulation::log_spacing;
+    if (use_union)
+      i_union[n] = this->union_grid_index(p->E(), i_log_union[n]);
+    particles[n++] = p;
+  }
+
+  // Per-particle state reused for each nuclide
+  vector<int> i_sab(n);
+  vector<double> sab_frac(n);
+  vector<char> update(n);
+  vector<int> mp_index(n);
+  vector<double> mp_E;
+  vector<double> mp_sqrtkT;
+  vector<array<double, 3>> mp_xs;
+
+  // Position in thermal_tables_
+  int j = 0;
+
+  for (int i = 0; i < nuclide_.size(); ++i) {
+    int i_nuclide = nuclide_[i];
+    auto& nuc {*data::nuclides[i_nuclide]};
+
+    // Check if this nuclide matches one of the S(a,b) tables specified. This
+    // relies on thermal_tables_ being sorted by .index_nuclide
+    const ThermalTable* sab = nullptr;
+    if (j < thermal_tables_.size() && thermal_tables_[j].index_nuclide == i) {
+      sab = &thermal_tables_[j++];
+    }
+
+    // Find particles whose microscopic cross sections need to be updated
+    for (size_t k = 0; k < n; ++k) {
+      Particle& p {*particles[k]};
+      i_sab[k] = C_NONE;
+      sab_frac[k] = 0.0;
+      if (sab && p.E() <= data::thermal_scatt[sab->index_table]->energy_max_) {
+        i_sab[k] = sab->index_table;
+        sab_frac[k] = sab->fraction;
+      }
+
+      const auto& micro {p.neutron_xs(i_nuclide)};
+      update[k] = p.E() != micro.last_E || p.sqrtkT() != micro.last_sqrtkT ||
+                  i_sab[k] != micro.index_sab || sab_frac[k] != micro.sab_frac;
+    }
+
+    // Evaluate multipole data for every particle in its energy range at once
+    mp_index.assign(n, -1);
+    if (nuc.multipole_) {
+      mp_E.clear();
+      mp_sqrtkT.clear();
+      for (size_t k = 0; k < n; ++k) {
+        const Particle& p {*particles[k]};
+        if (update[k] && multipole_in_range(nuc, p.E())) {
+          mp_index[k] = mp_E.size();
+          mp_E.push_back(p.E());
+          mp_sqrtkT.push_back(p.sqrtkT());
+        }
+      }
+      mp_xs.resize(mp_E.size());
+      nuc.multipole_->evaluate(mp_E, mp_sqrtkT, mp_xs);
+    }
+
+    // Calculate microscopic cross sections for each particle in the batch
+    for (size_t k = 0; k < n; ++k) {
+      if (!update[k])
+        continue;
+      Particle& p {*particles[k]};
+      const array<double, 3>* mp =
+        mp_index[k] >= 0 ? &mp_xs[mp_index[k]] : nullptr;
+      if (use_union) {
+        Nuclide::UnionIndex u {&union_grid_.nuclide_index[i], i_union[k]};
+        nuc.calculate_xs(i_sab[k], i_log_union[k], sab_frac[k], p, &u, mp);
+      } else {
+        nuc.calculate_xs(i_sab[k], i_log_union[k], sab_frac[k], p, nullptr, mp);
+      }
+    }
+
+    // Add contributions to macroscopic cross sections
+    double atom_density = atom_density_(i);
+    for (size_t k = 0; k < n; ++k) {
+      Particle& p {*particles[k]};
+      const auto& micro {p.neutron_xs(i_nuclide)};
+      p.macro_xs().total += atom_density * micro.total;
+      p.macro_xs().absorption += atom_density * micro.absorption;
+      p.macro_xs().fission += atom_density * micro.fission;
+      p.macro_xs().nu_fission += atom_density * micro.nu_fission;
+      if (settings::xs_cdf)
+        p.xs_cdf().push_back(p.macro_xs().total);
+    }
+  }
+}
+
+void Material::calculate_neutron_xs(Particle& p, bool tabulated) const
 {
+  p.enter_material_neutron_xs(p.material());
+  p.xs_cdf().clear();
+
+  // Use precomputed macroscopic cross sections if available
+  if (tabulated && !macro_xs_tables_.empty() &&
+      this->calculate_tabulated_xs(p))
+    return;
+
   // Find energy index on energy grid
   int neutron = static_cast<int>(ParticleType::neutron);
   int i_grid =
     std::log(p.E() / data::energy_min[neutron]) / simulation::log_spacing;
 
+  // If a unionized grid is available, locate the energy on it once so that the
+  // per-nuclide grid searches reduce to table lookups
+  int i_union = C_NONE;
+  if (!union_grid_.energy.empty()) {
+    i_union = this->union_grid_index(p.E(), i_grid);
+  }
+
   // Determine if this material has S(a,b) tables
   bool check_sab = (thermal_tables_.size() > 0);
 
@@ -826,15 +1342,8 @@ void Material::calculate_neutron_xs(Particle& p) const
     // ======================================================================
     // CALCULATE MICROSCOPIC CROSS SECTION
 
-    // Determine microscopic cross sections for this nuclide
-    int i_nuclide = nuclide_[i];
-
-    // Calculate microscopic cross section for this nuclide
-    const auto& micro {p.neutron_xs(i_nuclide)};
-    if (p.E() != micro.last_E || p.sqrtkT() != micro.last_sqrtkT ||
-        i_sab != micro.index_sab || sab_frac != micro.sab_frac) {
-      data::nuclides[i_nuclide]->calculate_xs(i_sab, i_grid, sab_frac, p);
-    }
+    this->update_nuclide_xs(p, i, i_sab, sab_frac, i_grid, i_union);
+    const auto& micro {p.neutron_xs(nuclide_[i])};
 
     // ======================================================================
     // ADD TO MACROSCOPIC CROSS SECTION
@@ -847,6 +1356,50 @@ void Material::calculate_neutron_xs(Particle& p) const
     p.macro_xs().absorption += atom_density * micro.absorption;
     p.macro_xs().fission += atom_density * micro.fission;
     p.macro_xs().nu_fission += atom_density * micro.nu_fission;
+    if (settings::xs_cdf)
+      p.xs_cdf().push_back(p.macro_xs().total);
+  }
+}
+
+void Material::calculate_nuclide_xs(Particle& p, int i) const
+{
+  // Find the S(a,b) table assigned to the nuclide, if any
+  int i_sab = C_NONE;
+  double sab_frac = 0.0;
+  for (const auto& sab : thermal_tables_) {
+    if (sab.index_nuclide == i) {
+      if (p.E() <= data::thermal_scatt[sab.index_table]->energy_max_) {
+        i_sab = sab.index_table;
+        sab_frac = sab.fraction;
+      }
+      break;
+    }
+  }
+
+  int neutron = static_cast<int>(ParticleType::neutron);
+  int i_grid =
+    std::log(p.E() / data::energy_min[neutron]) / simulation::log_spacing;
+  int i_union = C_NONE;
+  if (!union_grid_.energy.empty()) {
+    i_union = this->union_grid_index(p.E(), i_grid);
+  }
+  this->update_nuclide_xs(p, i, i_sab, sab_frac, i_grid, i_union);
+}
+
+void Material::update_nuclide_xs(Particle& p, int i, int i_sab,
+  double sab_frac, int i_grid, int i_union) const
+{
+  // Calculate microscopic cross sections unless they are current
+  int i_nuclide = nuclide_[i];
+  const auto& micro {p.neutron_xs(i_nuclide)};
+  if (p.E() != micro.last_E || p.sqrtkT() != micro.last_sqrtkT ||
+      i_sab != micro.index_sab || sab_frac != micro.sab_frac) {
+    if (i_union != C_NONE) {
+      Nuclide::UnionIndex u {&union_grid_.nuclide_index[i], i_union};
+      data::nuclides[i_nuclide]->calculate_xs(i_sab, i_grid, sab_frac, p, &u);
+    } else {
+      data::nuclides[i_nuclide]->calculate_xs(i_sab, i_grid, sab_frac, p);
+    }
   }
 }
 
@@ -856,6 +1409,23 @@ void Material::calculate_photon_xs(Particle& p) const
   p.macro_xs().incoherent = 0.0;
   p.macro_xs().photoelectric = 0.0;
   p.macro_xs().pair_production = 0.0;
+  p.xs_cdf().clear();
+
+  // Find the interval on the unionized grid once so that each element's
+  // interval is a table lookup
+  const auto& union_energy {photon_union_grid_.energy};
+  double log_E = std::log(p.E());
+  int i_union = -1;
+  if (!union_energy.empty()) {
+    if (log_E < union_energy.front()) {
+      i_union = 0;
+    } else if (log_E >= union_energy.back()) {
+      i_union = union_energy.size() - 2;
+    } else {
+      i_union = upper_bound_index(
+        union_energy.cbegin(), union_energy.cend(), log_E);
+    }
+  }
 
   // Add contribution from each nuclide in material
   for (int i = 0; i < nuclide_.size(); ++i) {
@@ -868,7 +1438,13 @@ void Material::calculate_photon_xs(Particle& p) const
     // Calculate microscopic cross section for this nuclide
     const auto& micro {p.photon_xs(i_element)};
     if (p.E() != micro.last_E) {
-      data::elements[i_element]->calculate_xs(p);
+      const auto& element {*data::elements[i_element]};
+      if (i_union >= 0) {
+        element.calculate_xs(
+          p, log_E, photon_union_grid_.element_index[i][i_union]);
+      } else {
+        element.calculate_xs(p);
+      }
     }
 
     // ========================================================================
@@ -883,6 +1459,8 @@ void Material::calculate_photon_xs(Particle& p) const
     p.macro_xs().incoherent += atom_density * micro.incoherent;
     p.macro_xs().photoelectric += atom_density * micro.photoelectric;
     p.macro_xs().pair_production += atom_density * micro.pair_production;
+    if (settings::xs_cdf)
+      p.xs_cdf().push_back(p.macro_xs().total);
   }
 }
 
@@ -955,6 +1533,9 @@ void Material::set_density(double density, gsl::cstring_span units)
     throw std::invalid_argument {
       "Invalid units '" + std::string(units.data()) + "' specified."};
   }
+
+  // Tabulated macroscopic cross sections scale with density
+  macro_xs_tables_.clear();
 }
 
 void Material::set_densities(
@@ -964,6 +1545,18 @@ void Material::set_densities(
   Expects(n > 0);
   Expects(n == density.size());
 
+  // When the nuclides are already in the material, e.g. between depletion
+  // steps, overwrite their densities in place
+  vector<int> index;
+  for (const auto& nuc : name) {
+    auto it = data::nuclide_map.find(nuc);
+    if (it == data::nuclide_map.end())
+      break;
+    index.push_back(it->second);
+  }
+  if (index.size() == n && this->update_densities(index, density))
+    return;
+
   if (n != nuclide_.size()) {
     nuclide_.resize(n);
     atom_density_ = xt::zeros<double>({n});
@@ -971,6 +1564,11 @@ void Material::set_densities(
       element_.resize(n);
   }
 
+  // Nuclides may change, so any unionized grids are set up again below
+  bool neutron_grid = !union_grid_.energy.empty();
+  bool photon_grid = !photon_union_grid_.energy.empty();
+  macro_xs_tables_.clear();
+
   double sum_density = 0.0;
   for (gsl::index i = 0; i < n; ++i) {
     const auto& nuc {name[i]};
@@ -996,12 +1594,89 @@ void Material::set_densities(
 
   // Generate material bremsstrahlung data for electrons and positrons
   if (settings::photon_transport &&
-      settings::electron_treatment == ElectronTreatment::TTB) {
+      settings::electron_treatment != ElectronTreatment::LED) {
     this->init_bremsstrahlung();
+    if (settings::electron_treatment == ElectronTreatment::CH) {
+      this->init_condensed_history();
+    }
   }
 
   // Assign S(a,b) tables
   this->init_thermal();
+
+  // Keep the direct address table current if a simulation set it up
+  if (!mat_nuclide_index_.empty())
+    this->init_nuclide_index();
+
+  this->rebuild_union_grids(neutron_grid, photon_grid);
+}
+
+bool Material::update_densities(
+  gsl::span<const int> nuclide, gsl::span<const double> density)
+{
+  Expects(nuclide.size() == density.size());
+
+  // Find the position of each nuclide in nuclide_, first assuming that the
+  // nuclides are given in the same order
+  vector<int> local(nuclide.size(), C_NONE);
+  bool same_order = nuclide.size() == nuclide_.size();
+  for (gsl::index i = 0; same_order && i < nuclide.size(); ++i) {
+    same_order = nuclide[i] == nuclide_[i];
+    local[i] = i;
+  }
+  if (!same_order) {
+    // Scratch direct address table, reset after each use
+    static thread_local vector<int> position;
+    if (position.size() < data::nuclides.size())
+      position.resize(data::nuclides.size(), C_NONE);
+    for (int i = 0; i < nuclide_.size(); ++i) {
+      position[nuclide_[i]] = i;
+    }
+    for (gsl::index i = 0; i < nuclide.size(); ++i) {
+      local[i] = position[nuclide[i]];
+    }
+    for (int i_nuc : nuclide_) {
+      position[i_nuc] = C_NONE;
+    }
+  }
+
+  // Nuclides that are not in the material can only be given zero density
+  double sum_density = 0.0;
+  for (gsl::index i = 0; i < nuclide.size(); ++i) {
+    Expects(density[i] >= 0.0);
+    if (local[i] == C_NONE && density[i] > 0.0)
+      return false;
+    sum_density += density[i];
+  }
+  if (sum_density <= 0.0)
+    return false;
+
+  // Nuclides of the material that are not given are set to zero density
+  std::fill(atom_density_.begin(), atom_density_.end(), 0.0);
+  for (gsl::index i = 0; i < nuclide.size(); ++i) {
+    if (local[i] != C_NONE)
+      atom_density_(local[i]) = density[i];
+  }
+
+  density_ = sum_density;
+  density_gpcc_ = 0.0;
+  for (int i = 0; i < nuclide_.size(); ++i) {
+    double awr = data::nuclides[nuclide_[i]]->awr_;
+    density_gpcc_ += atom_density_(i) * awr * MASS_NEUTRON / N_AVOGADRO;
+  }
+
+  // The unionized grids and thermal tables depend only on which nuclides are
+  // present, but tabulated macroscopic cross sections scale with density
+  macro_xs_tables_.clear();
+
+  if (settings::photon_transport &&
+      settings::electron_treatment != ElectronTreatment::LED) {
+    this->init_bremsstrahlung();
+    if (settings::electron_treatment == ElectronTreatment::CH) {
+      this->init_condensed_history();
+    }
+  }
+  return true;
 }
 
 double Material::volume() const
@@ -1077,14 +1752,6 @@ void Material::to_hdf5(hid_t group) const
   close_group(material_group);
 }
 
-void Material::export_properties_hdf5(hid_t group) const
-{
-  hid_t material_group = create_group(group, "material " + std::to_string(id_));
-  write_attribute(material_group, "atom_density", density_);
-  write_attribute(material_group, "mass_density", density_gpcc_);
-  close_group(material_group);
-}
-
 void Material::import_properties_hdf5(hid_t group)
 {
   hid_t material_group = open_group(group, "material " + std::to_string(id_));
@@ -1105,6 +1772,7 @@ void Material::add_nuclide(const std::string& name, double density)
       density_gpcc_ +=
         (density - atom_density_(i)) * awr * MASS_NEUTRON / N_AVOGADRO;
       atom_density_(i) = density;
+      macro_xs_tables_.clear();
       return;
     }
   }
@@ -1118,6 +1786,12 @@ void Material::add_nuclide(const std::string& name, double density)
   int i_nuc = data::nuclide_map[name];
   nuclide_.push_back(i_nuc);
 
+  // The unionized grids no longer cover all nuclides, so they are set up
+  // again below
+  bool neutron_grid = !union_grid_.energy.empty();
+  bool photon_grid = !photon_union_grid_.energy.empty();
+  macro_xs_tables_.clear();
+
   // Append new element if photon transport is on
   if (settings::photon_transport) {
     int i_elem = data::element_map[to_element(name)];
@@ -1135,12 +1809,80 @@ void Material::add_nuclide(const std::string& name, double density)
   density_ += density;
   density_gpcc_ +=
     density * data::nuclides[i_nuc]->awr_ * MASS_NEUTRON / N_AVOGADRO;
+
+  // Keep the direct address table current if a simulation set it up
+  if (!mat_nuclide_index_.empty())
+    this->init_nuclide_index();
+
+  this->rebuild_union_grids(neutron_grid, photon_grid);
+}
+
+void Material::rebuild_union_grids(bool neutron, bool photon)
+{
+  if (neutron) {
+    this->init_union_grid();
+    if (tabulate_xs_)
+      this->init_macro_xs_tables();
+  }
+  if (photon)
+    this->init_photon_union_grid();
 }
 
 //==============================================================================
 // Non-method functions
 //==============================================================================
 
+double positron_radiative_ratio(double E, double Z_eq_sq)
+{
+  // Numerical approximation of the ratio from F. Salvat, J. M.
+  // Fernández-Varea, and J. Sempau, "PENELOPE-2011: A Code System for Monte
+  // Carlo Simulation of Electron and Photon Transport," OECD-NEA,
+  // Issy-les-Moulineaux, France (2011).
+  double t = std::log(1.0 + 1.0e6 * E / (Z_eq_sq * MASS_ELECTRON_EV));
+  return 1.0 -
+         std::exp(-1.2359e-1 * t + 6.1274e-2 * std::pow(t, 2) -
+                  3.1516e-2 * std::pow(t, 3) + 7.7446e-3 * std::pow(t, 4) -
+                  1.0595e-3 * std::pow(t, 5) + 7.0568e-5 * std::pow(t, 6) -
+                  1.808e-6 * std::pow(t, 7));
+}
+
+double radiation_length_factor(int Z)
+{
+  // Radiation logarithms, which are tabulated for the lightest elements.
+  // Source: Y. S. Tsai, "Pair production and bremsstrahlung of charged
+  // leptons," Rev. Mod. Phys., 46, 815 (1974).
+  double L_rad;
+  double L_rad_prime;
+  switch (Z) {
+  case 1:
+    L_rad = 5.31;
+    L_rad_prime = 6.144;
+    break;
+  case 2:
+    L_rad = 4.79;
+    L_rad_prime = 5.621;
+    break;
+  case 3:
+    L_rad = 4.74;
+    L_rad_prime = 5.805;
+    break;
+  case 4:
+    L_rad = 4.71;
+    L_rad_prime = 5.924;
+    break;
+  default:
+    L_rad = std::log(184.15 * std::pow(Z, -1.0 / 3.0));
+    L_rad_prime = std::log(1194.0 * std::pow(Z, -2.0 / 3.0));
+  }
+
+  // Coulomb correction
+  double a_sq = Z * Z / (FINE_STRUCTURE * FINE_STRUCTURE);
+  double f_c = a_sq * (1.0 / (1.0 + a_sq) + 0.20206 - 0.0369 * a_sq +
+                        0.0083 * a_sq * a_sq - 0.002 * a_sq * a_sq * a_sq);
+
+  return Z * Z * (L_rad - f_c) + Z * L_rad_prime;
+}
+
 double sternheimer_adjustment(const vector<double>& f,
   const vector<double>& e_b_sq, double e_p_sq, double n_conduction,
   double log_I, double tol, int max_iter)
@@ -1442,6 +2184,70 @@ extern "C" int openmc_material_set_densities(
   return 0;
 }
 
+extern "C" int openmc_materials_set_densities(int n_materials,
+  const int32_t* index, int n_nuclides, const int* nuclides,
+  const double* densities)
+{
+  for (int i = 0; i < n_materials; ++i) {
+    if (index[i] < 0 || index[i] >= model::materials.size()) {
+      set_errmsg("Index in materials array is out of bounds.");
+      return OPENMC_E_OUT_OF_BOUNDS;
+    }
+  }
+  for (int k = 0; k < n_nuclides; ++k) {
+    if (nuclides[k] < 0 || nuclides[k] >= data::nuclides.size()) {
+      set_errmsg("Index in nuclides vector is out of bounds.");
+      return OPENMC_E_OUT_OF_BOUNDS;
+    }
+  }
+  for (size_t j = 0; j < static_cast<size_t>(n_materials) * n_nuclides; ++j) {
+    if (densities[j] < 0.0) {
+      set_errmsg("Nuclide densities must be non-negative.");
+      return OPENMC_E_INVALID_ARGUMENT;
+    }
+  }
+
+  // Materials that already contain the nuclides are updated in place, each
+  // from its own row of the densities array
+  gsl::span<const int> nucs {nuclides, nuclides + n_nuclides};
+  vector<char> updated(n_materials);
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < n_materials; ++i) {
+    const double* row = densities + static_cast<size_t>(i) * n_nuclides;
+    updated[i] = model::materials[index[i]]->update_densities(
+      nucs, {row, row + n_nuclides});
+  }
+
+  // Any others get the nuclides with nonzero density, which may need to be
+  // loaded and so is done serially
+  for (int i = 0; i < n_materials; ++i) {
+    if (updated[i])
+      continue;
+    const double* row = densities + static_cast<size_t>(i) * n_nuclides;
+    vector<std::string> name;
+    vector<double> density;
+    for (int k = 0; k < n_nuclides; ++k) {
+      if (row[k] > 0.0) {
+        name.push_back(data::nuclides[nuclides[k]]->name_);
+        density.push_back(row[k]);
+      }
+    }
+    if (name.empty()) {
+      set_errmsg(fmt::format(
+        "No nuclide densities given for material {}.",
+        model::materials[index[i]]->id()));
+      return OPENMC_E_INVALID_ARGUMENT;
+    }
+    try {
+      model::materials[index[i]]->set_densities(name, density);
+    } catch (const std::exception& e) {
+      set_errmsg(e.what());
+      return OPENMC_E_UNASSIGNED;
+    }
+  }
+  return 0;
+}
+
 extern "C" int openmc_material_set_id(int32_t index, int32_t id)
 {
   if (index >= 0 && index < model::materials.size()) {
@@ -97,6 +97,32 @@ double t_percentile(double p, int df)
 
 void calc_pn_c(int n, double x, double pnx[])
 {
+  // Use an unrolled evaluation for the orders commonly used in expansions
+  switch (n) {
+  case 0:
+    return calc_pn<0>(x, pnx);
+  case 1:
+    return calc_pn<1>(x, pnx);
+  case 2:
+    return calc_pn<2>(x, pnx);
+  case 3:
+    return calc_pn<3>(x, pnx);
+  case 4:
+    return calc_pn<4>(x, pnx);
+  case 5:
+    return calc_pn<5>(x, pnx);
+  case 6:
+    return calc_pn<6>(x, pnx);
+  case 7:
+    return calc_pn<7>(x, pnx);
+  case 8:
+    return calc_pn<8>(x, pnx);
+  case 9:
+    return calc_pn<9>(x, pnx);
+  case 10:
+    return calc_pn<10>(x, pnx);
+  }
+
   pnx[0] = 1.;
   if (n >= 1) {
     pnx[1] = x;
@@ -658,8 +684,16 @@ void calc_zn(int n, double rho, double phi, double zn[])
   double sin_phi = std::sin(phi);
   double cos_phi = std::cos(phi);
 
-  vector<double> sin_phi_vec(n + 1); // Sin[n * phi]
-  vector<double> cos_phi_vec(n + 1); // Cos[n * phi]
+  // Scratch space is kept for each thread so that no memory is allocated once
+  // the largest order has been seen
+  static thread_local vector<double> sin_phi_vec; // Sin[n * phi]
+  static thread_local vector<double> cos_phi_vec; // Cos[n * phi]
+  static thread_local vector<double> zn_values;
+  if (sin_phi_vec.size() < static_cast<size_t>(n + 2)) {
+    sin_phi_vec.resize(n + 2);
+    cos_phi_vec.resize(n + 2);
+    zn_values.resize((n + 1) * (n + 1));
+  }
   sin_phi_vec[0] = 1.0;
   cos_phi_vec[0] = 1.0;
   sin_phi_vec[1] = 2.0 * cos_phi;
@@ -677,16 +711,19 @@ void calc_zn(int n, double rho, double phi, double zn[])
   // ===========================================================================
   // Calculate R_pq(rho)
   // Matrix forms of the coefficients which are easier to work with
-  vector<vector<double>> zn_mat(n + 1, vector<double>(n + 1));
+  auto zn_mat = [n](int q, int p) -> double& {
+    return zn_values[q * (n + 1) + p];
+  };
 
   // Fill the main diagonal first (Eq 3.9 in Chong)
   for (int p = 0; p <= n; p++) {
-    zn_mat[p][p] = std::pow(rho, p);
+    zn_mat(p, p) = std::pow(rho, p);
   }
 
   // Fill the 2nd diagonal (Eq 3.10 in Chong)
   for (int q = 0; q <= n - 2; q++) {
-    zn_mat[q][q + 2] = (q + 2) * zn_mat[q + 2][q + 2] - (q + 1) * zn_mat[q][q];
+    zn_mat(q, q + 2) =
+      (q + 2) * zn_mat(q + 2, q + 2) - (q + 1) * zn_mat(q, q);
   }
 
   // Fill in the rest of the values using the original results (Eq. 3.8 in
@@ -697,8 +734,8 @@ void calc_zn(int n, double rho, double phi, double zn[])
       double k1 = ((p + q) * (p - q) * (p - 2)) / 2.;
       double k3 = -q * q * (p - 1) - p * (p - 1) * (p - 2);
       double k4 = (-p * (p + q - 2) * (p - q - 2)) / 2.;
-      zn_mat[q][p] =
-        ((k2 * rho * rho + k3) * zn_mat[q][p - 2] + k4 * zn_mat[q][p - 4]) / k1;
+      zn_mat(q, p) =
+        ((k2 * rho * rho + k3) * zn_mat(q, p - 2) + k4 * zn_mat(q, p - 4)) / k1;
     }
   }
 
@@ -712,11 +749,11 @@ void calc_zn(int n, double rho, double phi, double zn[])
   for (int p = 0; p <= n; p++) {
     for (int q = -p; q <= p; q += 2) {
       if (q < 0) {
-        zn[i] = zn_mat[std::abs(q)][p] * sin_phi_vec[std::abs(q) - 1];
+        zn[i] = zn_mat(std::abs(q), p) * sin_phi_vec[std::abs(q) - 1];
       } else if (q == 0) {
-        zn[i] = zn_mat[q][p];
+        zn[i] = zn_mat(q, p);
       } else {
-        zn[i] = zn_mat[q][p] * cos_phi_vec[q];
+        zn[i] = zn_mat(q, p) * cos_phi_vec[q];
       }
       i++;
     }
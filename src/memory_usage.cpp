@@ -0,0 +1,285 @@
+#include "openmc/memory_usage.h"
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+#define HAS_RUSAGE
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm> // for max
+#include <cstdint>   // for int64_t
+
+#ifdef HAS_RUSAGE
+#include <sys/resource.h> // for getrusage
+#endif
+
+#include <fmt/format.h>
+
+#include "openmc/array.h"
+#include "openmc/bank.h"
+#include "openmc/capi.h"
+#include "openmc/cell.h"
+#include "openmc/error.h"
+#include "openmc/event.h"
+#include "openmc/ifp.h"
+#include "openmc/lattice.h"
+#include "openmc/material.h"
+#include "openmc/message_passing.h"
+#include "openmc/nuclide.h"
+#include "openmc/output.h"
+#include "openmc/particle.h"
+#include "openmc/settings.h"
+#include "openmc/tallies/tally.h"
+#include "openmc/thermal.h"
+#include "openmc/universe.h"
+
+namespace openmc {
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace {
+
+array<size_t, N_MEMORY_USES> current; //!< Memory as of the last measurement
+array<size_t, N_MEMORY_USES> peak;    //!< Largest memory measured
+size_t peak_total {0}; //!< Largest memory of all subsystems together
+
+// Labels for output of each subsystem
+const char* use_labels[N_MEMORY_USES] {"Nuclide data",
+  "Thermal scattering data", "Material energy grids", "Geometry",
+  "Tally results", "Particle banks", "Particles"};
+
+size_t nuclide_memory()
+{
+  size_t bytes = 0;
+  for (const auto& nuc : data::nuclides) {
+    bytes += nuc->memory_usage();
+  }
+  return bytes;
+}
+
+size_t thermal_memory()
+{
+  size_t bytes = 0;
+  for (const auto& table : data::thermal_scatt) {
+    bytes += table->memory_usage();
+  }
+  return bytes;
+}
+
+size_t material_memory()
+{
+  size_t bytes = 0;
+  for (const auto& mat : model::materials) {
+    bytes += mat->memory_usage();
+  }
+  return bytes;
+}
+
+size_t geometry_memory()
+{
+  size_t bytes = 0;
+  for (const auto& cell : model::cells) {
+    bytes += cell->memory_usage();
+  }
+  for (const auto& univ : model::universes) {
+    bytes += univ->memory_usage();
+  }
+  for (const auto& lat : model::lattices) {
+    bytes += lat->memory_usage();
+  }
+  return bytes;
+}
+
+size_t tally_memory()
+{
+  size_t bytes = 0;
+  for (const auto& t : model::tallies) {
+    bytes += t->memory_usage();
+  }
+  return bytes;
+}
+
+size_t bank_memory()
+{
+  using namespace simulation;
+  size_t bytes = sizeof(SourceSite) * source_bank.capacity() +
+                 fission_bank.nbytes() + surf_source_bank.nbytes() +
+                 sizeof(int64_t) * progeny_per_particle.capacity() +
+                 sizeof(IfpAncestor) * ifp_source_bank.capacity();
+  for (const auto& buffer : surf_source_buffers) {
+    bytes += sizeof(SourceSite) * buffer.capacity();
+  }
+  return bytes;
+}
+
+size_t particle_memory()
+{
+  // In event-based mode, the particles in flight and the queues of events
+  // pending for them are allocated up front
+  if (settings::event_based) {
+    using namespace simulation;
+    size_t bytes = calculate_fuel_xs_queue.nbytes() +
+                   calculate_nonfuel_xs_queue.nbytes() +
+                   advance_particle_queue.nbytes() +
+                   surface_crossing_queue.nbytes() + collision_queue.nbytes() +
+                   secondary_queue.nbytes() + free_particle_queue.nbytes();
+    for (const auto& p : particles) {
+      bytes += p.memory_usage();
+    }
+    return bytes;
+  }
+
+  // Otherwise each thread holds one particle at a time, which is as large as
+  // a newly created one apart from the sites in its secondary bank
+#ifdef _OPENMP
+  int n_threads = omp_get_max_threads();
+#else
+  int n_threads = 1;
+#endif
+  Particle p;
+  return n_threads * p.memory_usage();
+}
+
+} // namespace
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+void update_memory_usage()
+{
+  current[static_cast<int>(MemoryUse::NUCLIDES)] = nuclide_memory();
+  current[static_cast<int>(MemoryUse::THERMAL)] = thermal_memory();
+  current[static_cast<int>(MemoryUse::MATERIALS)] = material_memory();
+  current[static_cast<int>(MemoryUse::GEOMETRY)] = geometry_memory();
+  current[static_cast<int>(MemoryUse::TALLIES)] = tally_memory();
+  current[static_cast<int>(MemoryUse::BANKS)] = bank_memory();
+  current[static_cast<int>(MemoryUse::PARTICLES)] = particle_memory();
+
+  size_t total = 0;
+  for (int i = 0; i < N_MEMORY_USES; ++i) {
+    peak[i] = std::max(peak[i], current[i]);
+    total += current[i];
+  }
+  peak_total = std::max(peak_total, total);
+}
+
+size_t memory_usage(MemoryUse use)
+{
+  return current[static_cast<int>(use)];
+}
+
+size_t peak_memory_usage(MemoryUse use)
+{
+  return peak[static_cast<int>(use)];
+}
+
+size_t peak_resident_memory()
+{
+#ifdef HAS_RUSAGE
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+    // The maximum resident set size is in bytes on macOS and in kilobytes
+    // elsewhere
+#ifdef __APPLE__
+    return usage.ru_maxrss;
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+  }
+#endif
+  return 0;
+}
+
+void print_memory_usage()
+{
+  // Most data is replicated on every process, so the process holding the most
+  // memory is the one that determines whether a job fits
+  constexpr int n = 2 * N_MEMORY_USES + 2;
+  int64_t bytes[n];
+  for (int i = 0; i < N_MEMORY_USES; ++i) {
+    bytes[2 * i] = current[i];
+    bytes[2 * i + 1] = peak[i];
+  }
+  bytes[n - 2] = peak_total;
+  bytes[n - 1] = peak_resident_memory();
+#ifdef OPENMC_MPI
+  MPI_Reduce(mpi::master ? MPI_IN_PLACE : bytes, bytes, n, MPI_INT64_T,
+    MPI_MAX, 0, mpi::intracomm);
+#endif
+  if (!mpi::master)
+    return;
+
+  header("Memory Usage", 6);
+  if (settings::verbosity < 6)
+    return;
+
+  if (mpi::n_procs > 1)
+    fmt::print(" Largest memory of any process:\n");
+  int64_t total = 0;
+  for (int i = 0; i < N_MEMORY_USES; ++i) {
+    fmt::print(" {:<33} = {:>10.1f} MB (peak {:.1f} MB)\n", use_labels[i],
+      bytes[2 * i] / 1.0e6, bytes[2 * i + 1] / 1.0e6);
+    total += bytes[2 * i];
+  }
+  fmt::print(" {:<33} = {:>10.1f} MB (peak {:.1f} MB)\n", "Total accounted",
+    total / 1.0e6, bytes[n - 2] / 1.0e6);
+  if (bytes[n - 1] > 0) {
+    fmt::print(" {:<33} = {:>10.1f} MB\n", "Peak resident memory",
+      bytes[n - 1] / 1.0e6);
+  }
+
+  // Memory of each nuclide at each temperature that has been read on this
+  // process
+  if (settings::verbosity >= 8) {
+    for (const auto& nuc : data::nuclides) {
+      for (int t = 0; t < nuc->kTs_.size(); ++t) {
+        size_t b = nuc->memory_usage(t);
+        if (b > 0) {
+          auto label = fmt::format("{} at {} K", nuc->name_,
+            nuc->temperatures_[t]);
+          fmt::print("   {:<31} = {:>10.1f} MB\n", label, b / 1.0e6);
+        }
+      }
+    }
+  }
+}
+
+void reset_memory_usage()
+{
+  current.fill(0);
+  peak.fill(0);
+  peak_total = 0;
+}
+
+//==============================================================================
+// C API functions
+//==============================================================================
+
+extern "C" int openmc_memory_usage(
+  int64_t current_bytes[], int64_t peak_bytes[], int64_t* resident)
+{
+  update_memory_usage();
+  for (int i = 0; i < N_MEMORY_USES; ++i) {
+    current_bytes[i] = current[i];
+    peak_bytes[i] = peak[i];
+  }
+  *resident = peak_resident_memory();
+  return 0;
+}
+
+extern "C" int openmc_nuclide_memory_usage(int index, int64_t* bytes)
+{
+  if (index < 0 || index >= data::nuclides.size()) {
+    set_errmsg("Index in nuclides vector is out of bounds.");
+    return OPENMC_E_OUT_OF_BOUNDS;
+  }
+  *bytes = data::nuclides[index]->memory_usage();
+  return 0;
+}
+
+} // namespace openmc
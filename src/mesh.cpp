@@ -27,6 +27,7 @@
 #include "openmc/hdf5_interface.h"
 #include "openmc/memory.h"
 #include "openmc/message_passing.h"
+#include "openmc/random_lcg.h"
 #include "openmc/search.h"
 #include "openmc/settings.h"
 #include "openmc/tallies/filter.h"
@@ -36,6 +37,7 @@
 #ifdef LIBMESH
 #include "libmesh/mesh_modification.h"
 #include "libmesh/mesh_tools.h"
+#include "libmesh/nemesis_io.h"
 #include "libmesh/numeric_vector.h"
 #endif
 
@@ -92,6 +94,61 @@ inline bool check_intersection_point(double x1, double x0, double y1, double y0,
   return false;
 }
 
+//! Add the weights of bank sites to the counts of the mesh bins they are in.
+//
+//! Each thread counts its share of the sites in an array of its own, and the
+//! arrays are added in order of thread so the counts do not depend on timing.
+
+void add_site_weights(const StructuredMesh& mesh, const SourceSite* bank, int64_t length,
+  double* cnt, bool& outside)
+{
+  int n_bins = mesh.n_bins();
+#ifdef _OPENMP
+  int n_threads = omp_get_max_threads();
+#else
+  int n_threads = 1;
+#endif
+  vector<vector<double>> cnt_thread(n_threads);
+  bool outside_ = false;
+
+#pragma omp parallel
+  {
+#ifdef _OPENMP
+    auto& cnt_local = cnt_thread[omp_get_thread_num()];
+#else
+    auto& cnt_local = cnt_thread[0];
+#endif
+    cnt_local.resize(n_bins, 0.0);
+
+#pragma omp for schedule(static) reduction(|| : outside_)
+    for (int64_t i = 0; i < length; i++) {
+      const auto& site = bank[i];
+
+      // determine scoring bin for entropy mesh
+      int mesh_bin = mesh.get_bin(site.r);
+
+      // if outside mesh, skip particle
+      if (mesh_bin < 0) {
+        outside_ = true;
+        continue;
+      }
+
+      // Add to appropriate bin
+      cnt_local[mesh_bin] += site.wgt;
+    }
+  }
+
+  // Sum the counts from each thread
+#pragma omp parallel for
+  for (int j = 0; j < n_bins; j++) {
+    for (const auto& cnt_local : cnt_thread) {
+      if (!cnt_local.empty())
+        cnt[j] += cnt_local[j];
+    }
+  }
+  outside = outside || outside_;
+}
+
 //==============================================================================
 // Mesh implementation
 //==============================================================================
@@ -102,6 +159,13 @@ Mesh::Mesh(pugi::xml_node node)
   id_ = std::stoi(get_node_value(node, "id"));
 }
 
+Position Mesh::sample_element(int bin, uint64_t* seed) const
+{
+  fatal_error(fmt::format("Positions cannot be sampled in elements of {} "
+                          "mesh {}.",
+    this->get_mesh_type(), id_));
+}
+
 void Mesh::set_id(int32_t id)
 {
   Expects(id >= 0 || id == C_NONE);
@@ -302,6 +366,29 @@ int StructuredMesh::get_bin(Position r) const
   return get_bin_from_indices(ijk);
 }
 
+double StructuredMesh::distance_to_bin_boundary(
+  Position r, const Direction& u) const
+{
+  // Offset the position a tiny bit in direction of flight, as in raytrace_mesh,
+  // so that a position on a boundary is in the bin it is moving into
+  bool in_mesh;
+  MeshIndex ijk = get_indices(r + TINY_BIT * u, in_mesh);
+
+  // Inside the mesh, the bin is left at the nearest grid surface. Outside of
+  // it, the mesh can only be entered once every coordinate that is out of
+  // range has reached the grid.
+  double distance = in_mesh ? INFTY : 0.0;
+  for (int k = 0; k < n_dimension_; ++k) {
+    double d = distance_to_grid_boundary(ijk, k, r, u, 0.0).distance;
+    if (in_mesh) {
+      distance = std::min(distance, d);
+    } else if (ijk[k] < 1 || ijk[k] > shape_[k]) {
+      distance = std::max(distance, d);
+    }
+  }
+  return distance;
+}
+
 int StructuredMesh::n_bins() const
 {
   return std::accumulate(
@@ -324,21 +411,7 @@ xt::xtensor<double, 1> StructuredMesh::count_sites(
   xt::xarray<double> cnt {shape, 0.0};
   bool outside_ = false;
 
-  for (int64_t i = 0; i < length; i++) {
-    const auto& site = bank[i];
-
-    // determine scoring bin for entropy mesh
-    int mesh_bin = get_bin(site.r);
-
-    // if outside mesh, skip particle
-    if (mesh_bin < 0) {
-      outside_ = true;
-      continue;
-    }
-
-    // Add to appropriate bin
-    cnt(mesh_bin) += site.wgt;
-  }
+  add_site_weights(*this, bank, length, cnt.data(), outside_);
 
   // Create copy of count data. Since ownership will be acquired by xtensor,
   // std::allocator must be used to avoid Valgrind mismatched free() / delete
@@ -540,6 +613,21 @@ void StructuredMesh::surface_bins_crossed(
   raytrace_mesh(r0, r1, u, SurfaceAggregator(this, bins));
 }
 
+bool StructuredMesh::within_element(
+  Position r0, Position r1, const Direction& u) const
+{
+  // The raytracing scores no surfaces for very short tracks
+  if ((r1 - r0).norm() < 2 * TINY_BIT)
+    return true;
+
+  bool in_mesh;
+  MeshIndex ijk = get_indices(r0 + TINY_BIT * u, in_mesh);
+  if (!in_mesh)
+    return false;
+  MeshIndex ijk_end = get_indices(r1, in_mesh);
+  return in_mesh && ijk == ijk_end;
+}
+
 //==============================================================================
 // RegularMesh implementation
 //==============================================================================
@@ -627,6 +715,20 @@ RegularMesh::RegularMesh(pugi::xml_node node) : StructuredMesh {node}
   volume_frac_ = 1.0 / xt::prod(shape)();
 }
 
+Position RegularMesh::sample_element(int bin, uint64_t* seed) const
+{
+  if (n_dimension_ != 3) {
+    fatal_error(fmt::format(
+      "Positions can only be sampled in a three-dimensional mesh {}.", id_));
+  }
+  auto ijk = get_indices_from_bin(bin);
+  Position r;
+  for (int i = 0; i < 3; ++i) {
+    r[i] = lower_left_[i] + (ijk[i] - 1 + prn(seed)) * width_[i];
+  }
+  return r;
+}
+
 int RegularMesh::get_index_in_direction(double r, int i) const
 {
   return std::ceil((r - lower_left_[i]) / width_[i]);
@@ -669,6 +771,108 @@ StructuredMesh::MeshDistance RegularMesh::distance_to_grid_boundary(
   return d;
 }
 
+void RegularMesh::bins_crossed(Position r0, Position r1, const Direction& u,
+  vector<int>& bins, vector<double>& lengths) const
+{
+  // Compute the length of the entire track.
+  double total_distance = (r1 - r0).norm();
+  if (total_distance == 0.0)
+    return;
+
+  const int n = n_dimension_;
+
+  // Find the bins containing the start and end of the track, offset a tiny bit
+  // toward the interior of the track as in the general raytracing
+  MeshIndex ijk;
+  MeshIndex ijk_end;
+  bool start_in_mesh = true;
+  bool same_bin = true;
+  Position r_start = r0 + TINY_BIT * u;
+  Position r_end = r1 - TINY_BIT * u;
+  for (int k = 0; k < n; ++k) {
+    ijk[k] = RegularMesh::get_index_in_direction(r_start[k], k);
+    ijk_end[k] = RegularMesh::get_index_in_direction(r_end[k], k);
+    if (ijk[k] < 1 || ijk[k] > shape_[k])
+      start_in_mesh = false;
+    if (ijk[k] != ijk_end[k])
+      same_bin = false;
+  }
+
+  // Tracks that start outside the mesh may enter it anywhere, so they are
+  // handled by the general raytracing
+  if (!start_in_mesh) {
+    StructuredMesh::bins_crossed(r0, r1, u, bins, lengths);
+    return;
+  }
+
+  // Short tracks and tracks that stay within one bin score to a single bin
+  if (same_bin || total_distance < 2 * TINY_BIT) {
+    bins.push_back(StructuredMesh::get_bin_from_indices(ijk));
+    lengths.push_back(1.0);
+    return;
+  }
+
+  // Make room for the largest number of bins that can be crossed. The filter
+  // match vectors are cleared rather than freed between events, so this only
+  // allocates when a track crosses more bins than any previous one.
+  int n_cross = 1;
+  for (int k = 0; k < n; ++k) {
+    n_cross += std::abs(ijk_end[k] - ijk[k]);
+  }
+  bins.reserve(bins.size() + n_cross);
+  lengths.reserve(lengths.size() + n_cross);
+
+  // Calculate the inverse direction and the initial distances to the next
+  // grid plane along each axis
+  std::array<double, 3> inv_u;
+  std::array<double, 3> distances {INFTY, INFTY, INFTY};
+  for (int k = 0; k < n; ++k) {
+    if (std::abs(u[k]) >= FP_PRECISION) {
+      inv_u[k] = 1.0 / u[k];
+      double plane = u[k] > 0 ? positive_grid_boundary(ijk, k)
+                              : negative_grid_boundary(ijk, k);
+      distances[k] = (plane - r0[k]) * inv_u[k];
+    }
+  }
+
+  // Step through the bins until the end of the track is reached or the track
+  // leaves the mesh, which cannot be reentered since the mesh is convex
+  double traveled_distance {0.0};
+  while (true) {
+    const auto k = std::min_element(distances.begin(), distances.end()) -
+                   distances.begin();
+
+    bins.push_back(StructuredMesh::get_bin_from_indices(ijk));
+    lengths.push_back(
+      (std::min(distances[k], total_distance) - traveled_distance) /
+      total_distance);
+
+    traveled_distance = distances[k];
+    if (traveled_distance >= total_distance)
+      return;
+
+    if (u[k] > 0) {
+      if (++ijk[k] > shape_[k])
+        return;
+      distances[k] = (positive_grid_boundary(ijk, k) - r0[k]) * inv_u[k];
+    } else {
+      if (--ijk[k] < 1)
+        return;
+      distances[k] = (negative_grid_boundary(ijk, k) - r0[k]) * inv_u[k];
+    }
+  }
+}
+
+void RegularMesh::surface_bins_crossed(
+  Position r0, Position r1, const Direction& u, vector<int>& bins) const
+{
+  // Elements are convex, so a track that begins and ends in the same element
+  // crosses none of its surfaces
+  if (within_element(r0, r1, u))
+    return;
+  StructuredMesh::surface_bins_crossed(r0, r1, u, bins);
+}
+
 std::pair<vector<double>, vector<double>> RegularMesh::plot(
   Position plot_ll, Position plot_ur) const
 {
@@ -734,21 +938,7 @@ xt::xtensor<double, 1> RegularMesh::count_sites(
   xt::xarray<double> cnt {shape, 0.0};
   bool outside_ = false;
 
-  for (int64_t i = 0; i < length; i++) {
-    const auto& site = bank[i];
-
-    // determine scoring bin for entropy mesh
-    int mesh_bin = get_bin(site.r);
-
-    // if outside mesh, skip particle
-    if (mesh_bin < 0) {
-      outside_ = true;
-      continue;
-    }
-
-    // Add to appropriate bin
-    cnt(mesh_bin) += site.wgt;
-  }
+  add_site_weights(*this, bank, length, cnt.data(), outside_);
 
   // Create copy of count data. Since ownership will be acquired by xtensor,
   // std::allocator must be used to avoid Valgrind mismatched free() / delete
@@ -860,11 +1050,31 @@ int RectilinearMesh::set_grid()
   return 0;
 }
 
+Position RectilinearMesh::sample_element(int bin, uint64_t* seed) const
+{
+  auto ijk = get_indices_from_bin(bin);
+  Position r;
+  for (int i = 0; i < 3; ++i) {
+    double x0 = negative_grid_boundary(ijk, i);
+    double x1 = positive_grid_boundary(ijk, i);
+    r[i] = x0 + prn(seed) * (x1 - x0);
+  }
+  return r;
+}
+
 int RectilinearMesh::get_index_in_direction(double r, int i) const
 {
   return lower_bound_index(grid_[i].begin(), grid_[i].end(), r) + 1;
 }
 
+void RectilinearMesh::surface_bins_crossed(
+  Position r0, Position r1, const Direction& u, vector<int>& bins) const
+{
+  if (within_element(r0, r1, u))
+    return;
+  StructuredMesh::surface_bins_crossed(r0, r1, u, bins);
+}
+
 std::pair<vector<double>, vector<double>> RectilinearMesh::plot(
   Position plot_ll, Position plot_ur) const
 {
@@ -911,6 +1121,58 @@ void RectilinearMesh::to_hdf5(hid_t group) const
 // CylindricalMesh implementation
 //==============================================================================
 
+namespace {
+
+//! Find the index of the bin containing a value along one axis of a mesh, where
+//! 0 and the number of bins + 1 indicate values below and above the grid
+int grid_index(const vector<double>& grid, const BinLookup& lookup, double v)
+{
+  if (v < grid.front())
+    return 0;
+  if (v > grid.back())
+    return grid.size();
+  return lookup.find(grid, v) + 1;
+}
+
+//! Map the direction of a point in the x-y plane other than the origin to a
+//! value in [0, 4] that increases with its azimuthal angle over [0, 2 pi], one
+//! unit per quadrant. Unlike the angle itself, it is found without
+//! trigonometric functions, and its precision is about the same everywhere.
+double azimuthal_key(double x, double y)
+{
+  if (y >= 0.0) {
+    return x >= 0.0 ? y / (x + y) : 1.0 - x / (y - x);
+  } else {
+    return x < 0.0 ? 2.0 - y / (-x - y) : 3.0 + x / (x - y);
+  }
+}
+
+//! Find azimuthal_key() of an azimuthal angle in [0, 2 pi]
+double azimuthal_key(double phi)
+{
+  // The sine of 2 pi isn't exactly zero, which would put the last grid value
+  // slightly below the largest key
+  if (phi >= 2.0 * PI)
+    return 4.0;
+  return azimuthal_key(std::cos(phi), std::sin(phi));
+}
+
+//! Fill the tables of azimuthal keys, cosines, and sines of a phi grid
+void set_phi_tables(const vector<double>& grid, vector<double>& key,
+  vector<double>& cos, vector<double>& sin)
+{
+  key.resize(grid.size());
+  cos.resize(grid.size());
+  sin.resize(grid.size());
+  for (int i = 0; i < grid.size(); ++i) {
+    key[i] = azimuthal_key(grid[i]);
+    cos[i] = std::cos(grid[i]);
+    sin[i] = std::sin(grid[i]);
+  }
+}
+
+} // namespace
+
 CylindricalMesh::CylindricalMesh(pugi::xml_node node) : StructuredMesh {node}
 {
   n_dimension_ = 3;
@@ -934,19 +1196,21 @@ std::string CylindricalMesh::get_mesh_type() const
 StructuredMesh::MeshIndex CylindricalMesh::get_indices(
   Position r, bool& in_mesh) const
 {
-  Position mapped_r;
+  MeshIndex idx;
+  double rho = std::sqrt(r.x * r.x + r.y * r.y);
+  idx[0] = grid_index(grid_[0], lookup_[0], rho);
 
-  mapped_r[0] = std::hypot(r.x, r.y);
-  mapped_r[2] = r[2];
-  if (mapped_r[0] < FP_PRECISION) {
-    mapped_r[1] = 0.0;
-  } else {
-    mapped_r[1] = std::atan2(r.y, r.x);
-    if (mapped_r[1] < 0)
-      mapped_r[1] += 2 * M_PI;
-  }
+  // Compare the point with the phi grid through its azimuthal key rather than
+  // its angle
+  double key = rho < FP_PRECISION ? 0.0 : azimuthal_key(r.x, r.y);
+  idx[1] = lower_bound_index(phi_key_.begin(), phi_key_.end(), key) + 1;
+  idx[2] = grid_index(grid_[2], lookup_[2], r.z);
 
-  MeshIndex idx = StructuredMesh::get_indices(mapped_r, in_mesh);
+  in_mesh = true;
+  for (int i = 0; i < 3; ++i) {
+    if (idx[i] < 1 || idx[i] > shape_[i])
+      in_mesh = false;
+  }
 
   idx[1] = sanitize_phi(idx[1]);
 
@@ -1000,15 +1264,13 @@ double CylindricalMesh::find_phi_crossing(
 
   shell = sanitize_phi(shell);
 
-  const double p0 = grid_[1][shell];
-
   // solve y(s)/x(s) = tan(p0) = sin(p0)/cos(p0)
   // => x(s) * cos(p0) = y(s) * sin(p0)
   // => (y + s * v) * cos(p0) = (x + s * u) * sin(p0)
   // = s * (v * cos(p0) - u * sin(p0)) = - (y * cos(p0) - x * sin(p0))
 
-  const double c0 = std::cos(p0);
-  const double s0 = std::sin(p0);
+  const double c0 = phi_cos_[shell];
+  const double s0 = phi_sin_[shell];
 
   const double denominator = (u.x * s0 - u.y * c0);
 
@@ -1109,12 +1371,32 @@ int CylindricalMesh::set_grid()
   lower_left_ = {grid_[0].front(), grid_[1].front(), grid_[2].front()};
   upper_right_ = {grid_[0].back(), grid_[1].back(), grid_[2].back()};
 
+  for (int i = 0; i < 3; ++i) {
+    lookup_[i].set_edges(grid_[i]);
+  }
+  set_phi_tables(grid_[1], phi_key_, phi_cos_, phi_sin_);
+
   return 0;
 }
 
+Position CylindricalMesh::sample_element(int bin, uint64_t* seed) const
+{
+  // The radius is sampled so that positions are uniform in the area of the
+  // annular sector
+  auto ijk = get_indices_from_bin(bin);
+  double r0 = grid_[0][ijk[0] - 1];
+  double r1 = grid_[0][ijk[0]];
+  double r = std::sqrt(r0 * r0 + prn(seed) * (r1 * r1 - r0 * r0));
+  double phi0 = grid_[1][ijk[1] - 1];
+  double phi = phi0 + prn(seed) * (grid_[1][ijk[1]] - phi0);
+  double z0 = grid_[2][ijk[2] - 1];
+  double z = z0 + prn(seed) * (grid_[2][ijk[2]] - z0);
+  return {r * std::cos(phi), r * std::sin(phi), z};
+}
+
 int CylindricalMesh::get_index_in_direction(double r, int i) const
 {
-  return lower_bound_index(grid_[i].begin(), grid_[i].end(), r) + 1;
+  return grid_index(grid_[i], lookup_[i], r);
 }
 
 std::pair<vector<double>, vector<double>> CylindricalMesh::plot(
@@ -1166,20 +1448,28 @@ std::string SphericalMesh::get_mesh_type() const
 StructuredMesh::MeshIndex SphericalMesh::get_indices(
   Position r, bool& in_mesh) const
 {
-  Position mapped_r;
+  MeshIndex idx;
+  double rho = r.norm();
+  idx[0] = grid_index(grid_[0], lookup_[0], rho);
 
-  mapped_r[0] = r.norm();
-  if (mapped_r[0] < FP_PRECISION) {
-    mapped_r[1] = 0.0;
-    mapped_r[2] = 0.0;
-  } else {
-    mapped_r[1] = std::acos(r.z / mapped_r.x);
-    mapped_r[2] = std::atan2(r.y, r.x);
-    if (mapped_r[2] < 0)
-      mapped_r[2] += 2 * M_PI;
+  // Compare the point with the theta and phi grids through 1 - cos(theta) and
+  // the azimuthal key rather than the angles themselves
+  double theta_key = 0.0;
+  double phi_key = 0.0;
+  if (rho >= FP_PRECISION) {
+    theta_key = 1.0 - r.z / rho;
+    if (r.x != 0.0 || r.y != 0.0)
+      phi_key = azimuthal_key(r.x, r.y);
   }
+  idx[1] =
+    lower_bound_index(theta_key_.begin(), theta_key_.end(), theta_key) + 1;
+  idx[2] = lower_bound_index(phi_key_.begin(), phi_key_.end(), phi_key) + 1;
 
-  MeshIndex idx = StructuredMesh::get_indices(mapped_r, in_mesh);
+  in_mesh = true;
+  for (int i = 0; i < 3; ++i) {
+    if (idx[i] < 1 || idx[i] > shape_[i])
+      in_mesh = false;
+  }
 
   idx[1] = sanitize_theta(idx[1]);
   idx[2] = sanitize_phi(idx[2]);
@@ -1227,7 +1517,7 @@ double SphericalMesh::find_theta_crossing(
   // b = r*u * cos(theta)^2 - u.z * r.z
   // c = r*r * cos(theta)^2 - r.z^2
 
-  const double cos_t = std::cos(grid_[1][shell]);
+  const double cos_t = theta_cos_[shell];
   const bool sgn = std::signbit(cos_t);
   const double cos_t_2 = cos_t * cos_t;
 
@@ -1282,15 +1572,13 @@ double SphericalMesh::find_phi_crossing(
 
   shell = sanitize_phi(shell);
 
-  const double p0 = grid_[2][shell];
-
   // solve y(s)/x(s) = tan(p0) = sin(p0)/cos(p0)
   // => x(s) * cos(p0) = y(s) * sin(p0)
   // => (y + s * v) * cos(p0) = (x + s * u) * sin(p0)
   // = s * (v * cos(p0) - u * sin(p0)) = - (y * cos(p0) - x * sin(p0))
 
-  const double c0 = std::cos(p0);
-  const double s0 = std::sin(p0);
+  const double c0 = phi_cos_[shell];
+  const double s0 = phi_sin_[shell];
 
   const double denominator = (u.x * s0 - u.y * c0);
 
@@ -1372,12 +1660,40 @@ int SphericalMesh::set_grid()
   lower_left_ = {grid_[0].front(), grid_[1].front(), grid_[2].front()};
   upper_right_ = {grid_[0].back(), grid_[1].back(), grid_[2].back()};
 
+  for (int i = 0; i < 3; ++i) {
+    lookup_[i].set_edges(grid_[i]);
+  }
+  theta_key_.resize(grid_[1].size());
+  theta_cos_.resize(grid_[1].size());
+  for (int i = 0; i < grid_[1].size(); ++i) {
+    theta_cos_[i] = std::cos(grid_[1][i]);
+    theta_key_[i] = 1.0 - theta_cos_[i];
+  }
+  set_phi_tables(grid_[2], phi_key_, phi_cos_, phi_sin_);
+
   return 0;
 }
 
+Position SphericalMesh::sample_element(int bin, uint64_t* seed) const
+{
+  // The radius and the cosine of the polar angle are sampled so that
+  // positions are uniform in the volume of the element
+  auto ijk = get_indices_from_bin(bin);
+  double r0 = grid_[0][ijk[0] - 1];
+  double r1 = grid_[0][ijk[0]];
+  double r =
+    std::cbrt(r0 * r0 * r0 + prn(seed) * (r1 * r1 * r1 - r0 * r0 * r0));
+  double mu0 = std::cos(grid_[1][ijk[1] - 1]);
+  double mu = mu0 + prn(seed) * (std::cos(grid_[1][ijk[1]]) - mu0);
+  double phi0 = grid_[2][ijk[2] - 1];
+  double phi = phi0 + prn(seed) * (grid_[2][ijk[2]] - phi0);
+  double rho = r * std::sqrt(std::max(0.0, 1.0 - mu * mu));
+  return {rho * std::cos(phi), rho * std::sin(phi), r * mu};
+}
+
 int SphericalMesh::get_index_in_direction(double r, int i) const
 {
-  return lower_bound_index(grid_[i].begin(), grid_[i].end(), r) + 1;
+  return grid_index(grid_[i], lookup_[i], r);
 }
 
 std::pair<vector<double>, vector<double>> SphericalMesh::plot(
@@ -1817,7 +2133,15 @@ void MOABMesh::initialize()
 
   // build acceleration data structures
   compute_barycentric_data(ehs_);
+  compute_neighbors(ehs_);
   build_kdtree(ehs_);
+
+#ifdef _OPENMP
+  int n_threads = omp_get_max_threads();
+#else
+  int n_threads = 1;
+#endif
+  last_tet_.assign(n_threads, 0);
 }
 
 void MOABMesh::create_interface()
@@ -1968,6 +2292,24 @@ void MOABMesh::bins_crossed(Position r0, Position r1, const Direction& u,
 moab::EntityHandle MOABMesh::get_tet(const Position& r) const
 {
   moab::CartVect pos(r.x, r.y, r.z);
+
+#ifdef _OPENMP
+  int thread_num = omp_get_thread_num();
+#else
+  int thread_num = 0;
+#endif
+
+  // Consecutive lookups by a thread are usually close together, so first try
+  // walking from the last tet found by this thread
+  auto& last_tet = last_tet_[thread_num];
+  if (last_tet != 0) {
+    auto tet = walk_to_tet(pos, last_tet);
+    if (tet != 0) {
+      last_tet = tet;
+      return tet;
+    }
+  }
+
   // find the leaf of the kd-tree for this position
   moab::AdaptiveKDTreeIter kdtree_iter;
   moab::ErrorCode rval = kdtree_->point_search(pos.array(), kdtree_iter);
@@ -1986,6 +2328,7 @@ moab::EntityHandle MOABMesh::get_tet(const Position& r) const
   // loop over the tets in this leaf, returning the containing tet if found
   for (const auto& tet : tets) {
     if (point_in_tet(pos, tet)) {
+      last_tet = tet;
       return tet;
     }
   }
@@ -2061,6 +2404,83 @@ void MOABMesh::compute_barycentric_data(const moab::Range& tets)
   }
 }
 
+void MOABMesh::compute_neighbors(const moab::Range& tets)
+{
+  moab::ErrorCode rval;
+
+  tet_neighbors_.assign(tets.size(), {-1, -1, -1, -1});
+
+  for (auto& tet : tets) {
+    vector<moab::EntityHandle> verts;
+    rval = mbi_->get_connectivity(&tet, 1, verts);
+    if (rval != moab::MB_SUCCESS) {
+      fatal_error("Failed to get connectivity of tet on umesh: " + filename_);
+    }
+
+    auto& neighbors = tet_neighbors_[get_bin_from_ent_handle(tet)];
+    for (int i = 0; i < 4; ++i) {
+      // The face opposite vertex i is made up of the other three vertices
+      moab::EntityHandle face[3];
+      int n = 0;
+      for (int j = 0; j < 4; ++j) {
+        if (j != i)
+          face[n++] = verts[j];
+      }
+
+      // Find the other tet sharing all three vertices, if there is one
+      moab::Range adj;
+      rval = mbi_->get_adjacencies(face, 3, 3, false, adj);
+      if (rval != moab::MB_SUCCESS) {
+        fatal_error("Failed to get adjacent tets on umesh: " + filename_);
+      }
+      for (auto other : adj) {
+        if (other != tet) {
+          neighbors[i] = get_bin_from_ent_handle(other);
+        }
+      }
+    }
+  }
+}
+
+moab::EntityHandle MOABMesh::walk_to_tet(
+  const moab::CartVect& r, moab::EntityHandle tet) const
+{
+  for (int step = 0; step < MAX_WALK_STEPS; ++step) {
+    // get the first vertex of the tet, which is the reference point for the
+    // barycentric data
+    const moab::EntityHandle* conn;
+    int n_conn;
+    moab::ErrorCode rval = mbi_->get_connectivity(tet, conn, n_conn);
+    if (rval != moab::MB_SUCCESS) {
+      return 0;
+    }
+    moab::CartVect p_zero;
+    rval = mbi_->get_coords(conn, 1, p_zero.array());
+    if (rval != moab::MB_SUCCESS) {
+      return 0;
+    }
+
+    // compute the barycentric coordinates for all four vertices
+    int bin = get_bin_from_ent_handle(tet);
+    moab::CartVect b = baryc_data_[bin] * (r - p_zero);
+    std::array<double, 4> lambda {1.0 - b[0] - b[1] - b[2], b[0], b[1], b[2]};
+
+    // the position is inside the tet if all coordinates are non-negative.
+    // Otherwise, it lies beyond the face opposite the most negative one.
+    auto i_min =
+      std::min_element(lambda.begin(), lambda.end()) - lambda.begin();
+    if (lambda[i_min] >= 0.0) {
+      return tet;
+    }
+    int next = tet_neighbors_[bin][i_min];
+    if (next < 0) {
+      return 0;
+    }
+    tet = get_ent_handle_from_bin(next);
+  }
+  return 0;
+}
+
 bool MOABMesh::point_in_tet(
   const moab::CartVect& r, moab::EntityHandle tet) const
 {
@@ -2273,14 +2693,23 @@ void MOABMesh::remove_scores()
   tag_names_.clear();
 }
 
-void MOABMesh::set_score_data(const std::string& score,
-  const vector<double>& values, const vector<double>& std_dev)
+void MOABMesh::set_score_data(const std::string& score, int offset,
+  gsl::span<const double> values, gsl::span<const double> std_dev)
 {
   auto score_tags = this->get_score_tags(score);
 
+  // gather the tetrahedra for this range of bins
+  vector<moab::EntityHandle> ents;
+  ents.reserve(values.size());
+  auto it = ehs_.begin() + offset;
+  for (int i = 0; i < values.size(); ++i, ++it) {
+    ents.push_back(*it);
+  }
+
   moab::ErrorCode rval;
   // set the score value
-  rval = mbi_->tag_set_data(score_tags.first, ehs_, values.data());
+  rval = mbi_->tag_set_data(
+    score_tags.first, ents.data(), ents.size(), values.data());
   if (rval != moab::MB_SUCCESS) {
     auto msg = fmt::format("Failed to set the tally value for score '{}' "
                            "on unstructured mesh {}",
@@ -2289,7 +2718,8 @@ void MOABMesh::set_score_data(const std::string& score,
   }
 
   // set the error value
-  rval = mbi_->tag_set_data(score_tags.second, ehs_, std_dev.data());
+  rval = mbi_->tag_set_data(
+    score_tags.second, ents.data(), ents.size(), std_dev.data());
   if (rval != moab::MB_SUCCESS) {
     auto msg = fmt::format("Failed to set the tally error for score '{}' "
                            "on unstructured mesh {}",
@@ -2378,6 +2808,7 @@ void LibMesh::initialize()
     pl_.back()->set_contains_point_tol(FP_COINCIDENT);
     pl_.back()->enable_out_of_mesh_mode();
   }
+  last_elem_.assign(n_threads, nullptr);
 
   // store first element in the mesh to use as an offset for bin indices
   auto first_elem = *m_->elements_begin();
@@ -2450,8 +2881,8 @@ void LibMesh::remove_scores()
   variable_map_.clear();
 }
 
-void LibMesh::set_score_data(const std::string& var_name,
-  const vector<double>& values, const vector<double>& std_dev)
+void LibMesh::set_score_data(const std::string& var_name, int offset,
+  gsl::span<const double> values, gsl::span<const double> std_dev)
 {
   auto& eqn_sys = equation_systems_->get_system(eq_system_name_);
 
@@ -2459,8 +2890,6 @@ void LibMesh::set_score_data(const std::string& var_name,
     equation_systems_->init();
   }
 
-  const libMesh::DofMap& dof_map = eqn_sys.get_dof_map();
-
   // look up the value variable
   std::string value_name = var_name + "_mean";
   unsigned int value_num = variable_map_.at(value_name);
@@ -2468,32 +2897,44 @@ void LibMesh::set_score_data(const std::string& var_name,
   std::string std_dev_name = var_name + "_std_dev";
   unsigned int std_dev_num = variable_map_.at(std_dev_name);
 
-  for (auto it = m_->local_elements_begin(); it != m_->local_elements_end();
-       it++) {
-    auto bin = get_bin_from_element(*it);
+  auto sys_num = eqn_sys.number();
+  auto proc_id = m_->processor_id();
 
-    // set value
-    vector<libMesh::dof_id_type> value_dof_indices;
-    dof_map.dof_indices(*it, value_dof_indices, value_num);
-    Ensures(value_dof_indices.size() == 1);
-    eqn_sys.solution->set(value_dof_indices[0], values.at(bin));
+  for (int i = 0; i < values.size(); ++i) {
+    // only elements owned by this process are set; with a distributed mesh
+    // others may not be present at all
+    const libMesh::Elem* elem =
+      m_->query_elem_ptr(offset + i + first_element_id_);
+    if (!elem || elem->processor_id() != proc_id)
+      continue;
 
-    // set std dev
-    vector<libMesh::dof_id_type> std_dev_dof_indices;
-    dof_map.dof_indices(*it, std_dev_dof_indices, std_dev_num);
-    Ensures(std_dev_dof_indices.size() == 1);
-    eqn_sys.solution->set(std_dev_dof_indices[0], std_dev.at(bin));
+    // variables are constant monomials so each has a single dof per element
+    eqn_sys.solution->set(elem->dof_number(sys_num, value_num, 0), values[i]);
+    eqn_sys.solution->set(
+      elem->dof_number(sys_num, std_dev_num, 0), std_dev[i]);
   }
 }
 
 void LibMesh::write(const std::string& filename) const
 {
-  write_message(fmt::format(
-    "Writing file: {}.e for unstructured mesh {}", filename, this->id_));
-  libMesh::ExodusII_IO exo(*m_);
-  std::set<std::string> systems_out = {eq_system_name_};
-  exo.write_discontinuous_exodusII(
-    filename + ".e", *equation_systems_, &systems_out);
+  auto& eqn_sys = equation_systems_->get_system(eq_system_name_);
+  eqn_sys.solution->close();
+
+  if (m_->is_serial()) {
+    write_message(fmt::format(
+      "Writing file: {}.e for unstructured mesh {}", filename, this->id_));
+    libMesh::ExodusII_IO exo(*m_);
+    std::set<std::string> systems_out = {eq_system_name_};
+    exo.write_discontinuous_exodusII(
+      filename + ".e", *equation_systems_, &systems_out);
+  } else {
+    // each process writes the elements it owns to its own Nemesis file
+    write_message(fmt::format(
+      "Writing files: {}.n.* for unstructured mesh {}", filename, this->id_));
+    libMesh::Nemesis_IO nem(*m_);
+    nem.write(filename + ".n");
+    nem.write_element_data(*equation_systems_);
+  }
 }
 
 void LibMesh::bins_crossed(Position r0, Position r1, const Direction& u,
@@ -2519,9 +2960,27 @@ int LibMesh::get_bin(Position r) const
   int thread_num = 0;
 #endif
 
+  // Consecutive lookups by a thread are usually close together, so check the
+  // last element found by this thread and its neighbors first
+  auto& last_elem = last_elem_[thread_num];
+  if (last_elem) {
+    if (last_elem->contains_point(p, FP_COINCIDENT)) {
+      return get_bin_from_element(last_elem);
+    }
+    for (auto neighbor_ptr : last_elem->neighbor_ptr_range()) {
+      if (neighbor_ptr && neighbor_ptr->contains_point(p, FP_COINCIDENT)) {
+        last_elem = neighbor_ptr;
+        return get_bin_from_element(last_elem);
+      }
+    }
+  }
+
   const auto& point_locator = pl_.at(thread_num);
 
   const auto elem_ptr = (*point_locator)(p);
+  if (elem_ptr) {
+    last_elem = elem_ptr;
+  }
   return elem_ptr ? get_bin_from_element(elem_ptr) : -1;
 }
 
@@ -2641,6 +3100,16 @@ void meshes_to_hdf5(hid_t group)
   close_group(meshes_group);
 }
 
+int get_mesh_bin(const Particle& p, int32_t i_mesh, Position r)
+{
+  int bin;
+  if (!p.mesh_bin_cache().find(i_mesh, r, bin)) {
+    bin = model::meshes[i_mesh]->get_bin(r);
+    p.mesh_bin_cache().insert(i_mesh, r, bin);
+  }
+  return bin;
+}
+
 void free_memory_mesh()
 {
   model::meshes.clear();
@@ -1,16 +1,131 @@
 #include "openmc/message_passing.h"
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 namespace openmc {
 namespace mpi {
 
 int rank {0};
 int n_procs {1};
 bool master {true};
+int node_rank {0};
+int n_procs_node {1};
+bool thread_multiple {false};
+GenerationSums generation_sums;
+
+namespace {
+
+constexpr int PROGRESS_INTERVAL {50}; //!< Microseconds between probes
+
+std::thread progress_thread;            //!< Thread making MPI progress
+std::atomic<bool> progress_stop {false}; //!< Whether the thread should stop
+
+} // namespace
 
 #ifdef OPENMC_MPI
 MPI_Comm intracomm {MPI_COMM_NULL};
+MPI_Comm node_intracomm {MPI_COMM_NULL};
+MPI_Comm leader_intracomm {MPI_COMM_NULL};
 MPI_Datatype source_site {MPI_DATATYPE_NULL};
+MPI_Datatype compact_source_site {MPI_DATATYPE_NULL};
+MPI_Datatype ifp_ancestry {MPI_DATATYPE_NULL};
+#endif
+
+#ifdef OPENMC_MPI
+void reduce_sum(void* buffer, int count, MPI_Datatype type, bool all)
+{
+  // Combine values on the lowest-ranked process of each node
+  if (n_procs_node > 1) {
+    if (node_rank == 0) {
+      MPI_Reduce(
+        MPI_IN_PLACE, buffer, count, type, MPI_SUM, 0, node_intracomm);
+    } else {
+      MPI_Reduce(buffer, nullptr, count, type, MPI_SUM, 0, node_intracomm);
+    }
+  }
+
+  // Combine values across nodes. The master is the lowest-ranked leader.
+  if (leader_intracomm != MPI_COMM_NULL) {
+    if (all) {
+      MPI_Allreduce(
+        MPI_IN_PLACE, buffer, count, type, MPI_SUM, leader_intracomm);
+    } else {
+      MPI_Reduce(master ? MPI_IN_PLACE : buffer, buffer, count, type, MPI_SUM,
+        0, leader_intracomm);
+    }
+  }
+
+  // Share the sums with the other processes on each node
+  if (all && n_procs_node > 1) {
+    MPI_Bcast(buffer, count, type, 0, node_intracomm);
+  }
+}
+#endif
+
+//==============================================================================
+// GenerationSums implementation
+//==============================================================================
+
+int GenerationSums::add()
+{
+  local_.push_back(0.0);
+  sum_.push_back(0.0);
+  return local_.size() - 1;
+}
+
+void GenerationSums::start()
+{
+#ifdef OPENMC_MPI
+  if (n_procs > 1) {
+    MPI_Iallreduce(local_.data(), sum_.data(), local_.size(), MPI_DOUBLE,
+      MPI_SUM, intracomm, &request_);
+    return;
+  }
+#endif
+  sum_ = local_;
+}
+
+double GenerationSums::get(int i)
+{
+#ifdef OPENMC_MPI
+  if (request_ != MPI_REQUEST_NULL)
+    MPI_Wait(&request_, MPI_STATUS_IGNORE);
+#endif
+  return sum_[i];
+}
+
+//==============================================================================
+// Progress thread
+//==============================================================================
+
+void start_progress_thread()
+{
+#ifdef OPENMC_MPI
+  if (progress_thread.joinable() || n_procs == 1 || !thread_multiple)
+    return;
+
+  progress_stop = false;
+  progress_thread = std::thread([] {
+    while (!progress_stop.load(std::memory_order_relaxed)) {
+      int flag;
+      MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, intracomm, &flag,
+        MPI_STATUS_IGNORE);
+      std::this_thread::sleep_for(
+        std::chrono::microseconds(PROGRESS_INTERVAL));
+    }
+  });
 #endif
+}
+
+void stop_progress_thread()
+{
+  if (!progress_thread.joinable())
+    return;
+  progress_stop = true;
+  progress_thread.join();
+}
 
 extern "C" bool openmc_master()
 {
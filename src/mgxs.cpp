@@ -299,6 +299,8 @@ Mgxs::Mgxs(
 
   // Make sure the scattering format is updated to the final case
   scatter_format = final_scatter_format;
+
+  build_tracking_xs();
 }
 
 //==============================================================================
@@ -407,6 +409,8 @@ Mgxs::Mgxs(const std::string& in_name, const vector<double>& mat_kTs,
     // And finally, combine the data
     combine(mgxs_to_combine, interpolant, temp_indices, t);
   } // end temperature (t) loop
+
+  build_tracking_xs();
 }
 
 //==============================================================================
@@ -620,12 +624,37 @@ void Mgxs::calculate_xs(Particle& p)
   int tid = 0;
 #endif
   set_temperature_index(p.sqrtkT());
-  set_angle_index(p.u_local());
-  XsData* xs_t = &xs[cache[tid].t];
-  p.macro_xs().total = xs_t->total(cache[tid].a, p.g());
-  p.macro_xs().absorption = xs_t->absorption(cache[tid].a, p.g());
-  p.macro_xs().nu_fission =
-    fissionable ? xs_t->nu_fission(cache[tid].a, p.g()) : 0.;
+
+  // Isotropic data has a single angle, so the direction is not needed
+  int a = 0;
+  if (!is_isotropic) {
+    set_angle_index(p.u_local());
+    a = cache[tid].a;
+  }
+
+  const TrackingXs& xs_g =
+    tracking_xs[(cache[tid].t * n_tracking_angles + a) * num_groups + p.g()];
+  p.macro_xs().total = xs_g.total;
+  p.macro_xs().absorption = xs_g.absorption;
+  p.macro_xs().nu_fission = xs_g.nu_fission;
+}
+
+//==============================================================================
+
+void Mgxs::build_tracking_xs()
+{
+  n_tracking_angles = xs.empty() ? 1 : xs[0].total.shape()[0];
+  tracking_xs.resize(xs.size() * n_tracking_angles * num_groups);
+  for (int t = 0; t < xs.size(); t++) {
+    for (int a = 0; a < n_tracking_angles; a++) {
+      for (int g = 0; g < num_groups; g++) {
+        auto& x = tracking_xs[(t * n_tracking_angles + a) * num_groups + g];
+        x.total = xs[t].total(a, g);
+        x.absorption = xs[t].absorption(a, g);
+        x.nu_fission = fissionable ? xs[t].nu_fission(a, g) : 0.;
+      }
+    }
+  }
 }
 
 //==============================================================================
@@ -117,37 +117,56 @@ void MgxsInterface::add_mgxs(
 void MgxsInterface::create_macro_xs()
 {
   // Get temperatures to read for each material
-  auto kTs = get_mat_kTs();
+  mat_kTs_ = get_mat_kTs();
+
+  // First we have to normalize the densities as it has not been called yet
+  // for MG mode
+  int n = model::materials.size();
+  for (auto& mat : model::materials) {
+    mat->finalize();
+  }
+
+  // Materials without any temperatures keep a blank entry to preserve the
+  // ordering of materials
+  macro_xs_.clear();
+  macro_xs_.resize(n);
+  macro_init_ = make_unique<std::once_flag[]>(n);
+  if (settings::temperature_lazy)
+    return;
+
+  // Combining the nuclide data of one material does not depend on any other
+  // material, and materials can differ widely in their number of nuclides
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < n; ++i) {
+    macro_xs(i);
+  }
+}
+
+void MgxsInterface::build_macro_xs(int i_mat)
+{
+  const auto& kTs {mat_kTs_[i_mat]};
+  if (kTs.empty())
+    return;
 
   // Force all nuclides in a material to be the same representation.
   // Therefore type(nuclides[mat->nuclide_[0]]) dictates type(macroxs).
   // At the same time, we will find the scattering type, as that will dictate
   // how we allocate the scatter object within macroxs.
+  const auto& mat {model::materials[i_mat]};
 
-  for (int i = 0; i < model::materials.size(); ++i) {
-    // First we have to normalize the densities as it has not been called yet
-    // for MG mode
-    auto& mat {model::materials[i]};
-    mat->finalize();
-    if (kTs[i].size() > 0) {
-      // Convert atom_densities to a vector
-      vector<double> atom_densities(
-        mat->atom_density_.begin(), mat->atom_density_.end());
-
-      // Build array of pointers to nuclides's Mgxs objects needed for this
-      // material
-      vector<Mgxs*> mgxs_ptr;
-      for (int i_nuclide : mat->nuclide_) {
-        mgxs_ptr.push_back(&nuclides_[i_nuclide]);
-      }
+  // Convert atom_densities to a vector
+  vector<double> atom_densities(
+    mat->atom_density_.begin(), mat->atom_density_.end());
 
-      macro_xs_.emplace_back(mat->name_, kTs[i], mgxs_ptr, atom_densities,
-        num_energy_groups_, num_delayed_groups_);
-    } else {
-      // Preserve the ordering of materials by including a blank entry
-      macro_xs_.emplace_back();
-    }
+  // Build array of pointers to nuclides's Mgxs objects needed for this
+  // material
+  vector<Mgxs*> mgxs_ptr;
+  for (int i_nuclide : mat->nuclide_) {
+    mgxs_ptr.push_back(&nuclides_[i_nuclide]);
   }
+
+  macro_xs_[i_mat] = Mgxs(mat->name_, kTs, mgxs_ptr, atom_densities,
+    num_energy_groups_, num_delayed_groups_);
 }
 
 //==============================================================================
@@ -0,0 +1,51 @@
+#include "openmc/node_shared.h"
+
+namespace openmc {
+
+//==============================================================================
+// NodeSharedSegment implementation
+//==============================================================================
+
+NodeSharedSegment::NodeSharedSegment(size_t nbytes)
+{
+#ifdef OPENMC_MPI
+  // Only the writer contributes memory; everyone else maps the writer's block
+  MPI_Aint size = this->writer() ? nbytes : 0;
+  void* base;
+  MPI_Win_allocate_shared(
+    size, 1, MPI_INFO_NULL, mpi::node_intracomm, &base, &win_);
+
+  MPI_Aint writer_size;
+  int disp_unit;
+  MPI_Win_shared_query(win_, 0, &writer_size, &disp_unit, &base);
+  data_ = static_cast<char*>(base);
+
+  // Keep a passive access epoch open for the lifetime of the segment so that
+  // loads and stores can be made directly
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, win_);
+#else
+  local_.resize(nbytes);
+  data_ = local_.data();
+#endif
+}
+
+NodeSharedSegment::~NodeSharedSegment()
+{
+#ifdef OPENMC_MPI
+  if (win_ != MPI_WIN_NULL) {
+    MPI_Win_unlock_all(win_);
+    MPI_Win_free(&win_);
+  }
+#endif
+}
+
+void NodeSharedSegment::sync()
+{
+#ifdef OPENMC_MPI
+  MPI_Win_sync(win_);
+  MPI_Barrier(mpi::node_intracomm);
+  MPI_Win_sync(win_);
+#endif
+}
+
+} // namespace openmc
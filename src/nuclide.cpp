@@ -6,6 +6,7 @@
 #include "openmc/endf.h"
 #include "openmc/error.h"
 #include "openmc/hdf5_interface.h"
+#include "openmc/huge_pages.h"
 #include "openmc/message_passing.h"
 #include "openmc/photon.h"
 #include "openmc/random_lcg.h"
@@ -20,8 +21,14 @@
 #include "xtensor/xbuilder.hpp"
 #include "xtensor/xview.hpp"
 
-#include <algorithm> // for sort, min_element
-#include <string>    // for to_string, stoi
+#include <sys/stat.h> // for stat
+
+#include <algorithm>  // for sort, min_element, max_element
+#include <cstdio>     // for rename, remove
+#include <cstring>    // for memcmp
+#include <fstream>    // for ifstream, ofstream
+#include <functional> // for hash
+#include <string>     // for to_string, stoi
 
 namespace openmc {
 
@@ -29,6 +36,12 @@ namespace openmc {
 // Global variables
 //==============================================================================
 
+#ifdef OPENMC_XS_SINGLE_PRECISION
+const bool XS_SINGLE_PRECISION = true;
+#else
+const bool XS_SINGLE_PRECISION = false;
+#endif
+
 namespace data {
 array<double, 2> energy_min {0.0, 0.0};
 array<double, 2> energy_max {INFTY, INFTY};
@@ -36,6 +49,8 @@ double temperature_min {INFTY};
 double temperature_max {0.0};
 std::unordered_map<std::string, int> nuclide_map;
 vector<unique_ptr<Nuclide>> nuclides;
+vector<double> cell_sqrtkT;
+std::unordered_map<double, int> cell_sqrtkT_map;
 } // namespace data
 
 //==============================================================================
@@ -48,7 +63,19 @@ int Nuclide::XS_FISSION {2};
 int Nuclide::XS_NU_FISSION {3};
 int Nuclide::XS_PHOTON_PROD {4};
 
-Nuclide::Nuclide(hid_t group, const vector<double>& temperature)
+// Identification of cross section cache files. The version must be
+// incremented whenever the layout of the file changes.
+constexpr char XS_CACHE_MAGIC[8] {'O', 'M', 'C', 'X', 'S', 'C', 'A', 'C'};
+constexpr int32_t XS_CACHE_VERSION {1};
+
+// Number of 0K grid points covered by each entry of Nuclide::elastic_0K_max_
+constexpr int ELASTIC_0K_BLOCK {64};
+
+// Fewest inelastic scattering reactions for which cumulative cross sections
+// are stored. Summing fewer reactions directly is as fast as searching.
+constexpr int INELASTIC_CDF_MIN_REACTIONS {8};
+
+Nuclide::Nuclide(hid_t group, const vector<double>& temperature, bool derive)
 {
   // Set index of nuclide in global vector
   index_ = data::nuclides.size();
@@ -89,6 +116,7 @@ Nuclide::Nuclide(hid_t group, const vector<double>& temperature)
   // temperatures in the range are loaded irrespective of what temperatures
   // actually appear in the model
   vector<int> temps_to_read;
+  vector<int> temps_needed;
   int n = temperature.size();
   double T_min = n > 0 ? settings::temperature_range[0] : 0.0;
   double T_max = n > 0 ? settings::temperature_range[1] : INFTY;
@@ -128,6 +156,7 @@ Nuclide::Nuclide(hid_t group, const vector<double>& temperature)
       }
 
       if (std::abs(T_actual - T_desired) < settings::temperature_tolerance) {
+        temps_needed.push_back(std::round(T_actual));
         if (!contains(temps_to_read, std::round(T_actual))) {
           temps_to_read.push_back(std::round(T_actual));
 
@@ -158,6 +187,8 @@ Nuclide::Nuclide(hid_t group, const vector<double>& temperature)
             T_desired < temps_available[j + 1]) {
           int T_j = std::round(temps_available[j]);
           int T_j1 = std::round(temps_available[j + 1]);
+          temps_needed.push_back(T_j);
+          temps_needed.push_back(T_j1);
           if (!contains(temps_to_read, T_j)) {
             temps_to_read.push_back(T_j);
           }
@@ -180,6 +211,20 @@ Nuclide::Nuclide(hid_t group, const vector<double>& temperature)
   // Sort temperatures to read
   std::sort(temps_to_read.begin(), temps_to_read.end());
 
+  // In lazy mode, temperatures that are only present because of the
+  // temperature range are read the first time a lookup needs them. At least
+  // one temperature is always read so that the energy bounds are known.
+  vector<bool> deferred(temps_to_read.size(), false);
+  if (settings::temperature_lazy) {
+    for (int i = 0; i < temps_to_read.size(); ++i) {
+      deferred[i] = !contains(temps_needed, temps_to_read[i]);
+    }
+    if (!contains(deferred, false))
+      deferred[0] = false;
+  }
+  temperatures_ = temps_to_read;
+  library_path_ = library_path(group);
+
   data::temperature_min =
     std::min(data::temperature_min, static_cast<double>(temps_to_read.front()));
   data::temperature_max =
@@ -196,7 +241,11 @@ Nuclide::Nuclide(hid_t group, const vector<double>& temperature)
 
     // Read energy grid
     grid_.emplace_back();
-    read_dataset(energy_group, dset.c_str(), grid_.back().energy);
+    if (!deferred[grid_.size() - 1]) {
+      vector<double> energy;
+      read_dataset(energy_group, dset.c_str(), energy);
+      grid_.back().energy = NodeSharedArray<double>(std::move(energy));
+    }
   }
   close_group(kT_group);
 
@@ -211,7 +260,8 @@ Nuclide::Nuclide(hid_t group, const vector<double>& temperature)
   for (auto name : group_names(rxs_group)) {
     if (starts_with(name, "reaction_")) {
       hid_t rx_group = open_group(rxs_group, name.c_str());
-      reactions_.push_back(make_unique<Reaction>(rx_group, temps_to_read));
+      reactions_.push_back(
+        make_unique<Reaction>(rx_group, temps_to_read, deferred));
 
       // Check for 0K elastic scattering
       const auto& rx = reactions_.back();
@@ -310,7 +360,21 @@ Nuclide::Nuclide(hid_t group, const vector<double>& temperature)
     close_group(fer_group);
   }
 
-  this->create_derived(prompt_photons_.get(), delayed_photons_.get());
+  // Mark temperatures that have been read as initialized
+  temperature_init_ = make_unique<std::once_flag[]>(kTs_.size());
+  temperature_loaded_ = make_unique<std::atomic<bool>[]>(kTs_.size());
+  for (int t = 0; t < kTs_.size(); ++t) {
+    temperature_loaded_[t] = !deferred[t];
+    if (!deferred[t])
+      std::call_once(temperature_init_[t], [] {});
+  }
+
+  this->create_derived(group);
+  if (derive)
+    this->derive_xs();
+
+  // Resolve temperature indices for cell temperatures assigned so far
+  this->update_cell_temperatures();
 }
 
 Nuclide::~Nuclide()
@@ -318,15 +382,8 @@ Nuclide::~Nuclide()
   data::nuclide_map.erase(name_);
 }
 
-void Nuclide::create_derived(
-  const Function1D* prompt_photons, const Function1D* delayed_photons)
+void Nuclide::create_derived(hid_t group)
 {
-  for (const auto& grid : grid_) {
-    // Allocate and initialize cross section
-    array<size_t, 2> shape {grid.energy.size(), 5};
-    xs_.emplace_back(shape, 0.0);
-  }
-
   reaction_index_.fill(C_NONE);
   for (int i = 0; i < reactions_.size(); ++i) {
     const auto& rx {reactions_[i]};
@@ -334,62 +391,18 @@ void Nuclide::create_derived(
     // Set entry in direct address table for reaction
     reaction_index_[rx->mt_] = i;
 
-    for (int t = 0; t < kTs_.size(); ++t) {
-      int j = rx->xs_[t].threshold;
-      int n = rx->xs_[t].value.size();
-      auto xs = xt::adapt(rx->xs_[t].value);
-
-      for (const auto& p : rx->products_) {
-        if (p.particle_ == ParticleType::photon) {
-          auto pprod = xt::view(xs_[t], xt::range(j, j + n), XS_PHOTON_PROD);
-          for (int k = 0; k < n; ++k) {
-            double E = grid_[t].energy[k + j];
-
-            // For fission, artificially increase the photon yield to account
-            // for delayed photons
-            double f = 1.0;
-            if (settings::delayed_photon_scaling) {
-              if (is_fission(rx->mt_)) {
-                if (prompt_photons && delayed_photons) {
-                  double energy_prompt = (*prompt_photons)(E);
-                  double energy_delayed = (*delayed_photons)(E);
-                  f = (energy_prompt + energy_delayed) / (energy_prompt);
-                }
-              }
-            }
-
-            pprod[k] += f * xs[k] * (*p.yield_)(E);
-          }
-        }
-      }
-
-      // Skip redundant reactions
-      if (rx->redundant_)
-        continue;
-
-      // Add contribution to total cross section
-      auto total = xt::view(xs_[t], xt::range(j, j + n), XS_TOTAL);
-      total += xs;
-
-      // Add contribution to absorption cross section
-      auto absorption = xt::view(xs_[t], xt::range(j, j + n), XS_ABSORPTION);
-      if (is_disappearance(rx->mt_)) {
-        absorption += xs;
-      }
+    // Keep track of fission reactions
+    if (!rx->redundant_ && is_fission(rx->mt_)) {
+      fissionable_ = true;
+      fission_rx_.push_back(rx.get());
+      if (rx->mt_ == N_F)
+        has_partial_fission_ = true;
+    }
 
-      if (is_fission(rx->mt_)) {
-        fissionable_ = true;
-        auto fission = xt::view(xs_[t], xt::range(j, j + n), XS_FISSION);
-        fission += xs;
-        absorption += xs;
-
-        // Keep track of fission reactions
-        if (t == 0) {
-          fission_rx_.push_back(rx.get());
-          if (rx->mt_ == N_F)
-            has_partial_fission_ = true;
-        }
-      }
+    // Keep track of the products that secondary photons are sampled from
+    for (int j = 0; j < rx->products_.size(); ++j) {
+      if (rx->products_[j].particle_ == ParticleType::photon)
+        photon_products_.push_back({i, j});
     }
   }
 
@@ -402,17 +415,13 @@ void Nuclide::create_derived(
     }
   }
 
-  // Calculate nu-fission cross section
-  for (int t = 0; t < kTs_.size(); ++t) {
-    if (fissionable_) {
-      int n = grid_[t].energy.size();
-      for (int i = 0; i < n; ++i) {
-        double E = grid_[t].energy[i];
-        xs_[t](i, XS_NU_FISSION) =
-          nu(E, EmissionMode::total) * xs_[t](i, XS_FISSION);
-      }
-    }
-  }
+  // Identify derived cross sections in the cache. Nuclides with temperatures
+  // yet to be read are not cached since their derived cross sections are
+  // incomplete.
+  if (!settings::path_xs_cache.empty() && !this->has_deferred_temperatures())
+    xs_cache_key_ = xs_cache_key(library_path_, name_, kTs_);
+
+  inelastic_cdf_.resize(kTs_.size());
 
   if (settings::res_scat_on) {
     // Determine if this nuclide should be treated as a resonant scatterer
@@ -457,11 +466,296 @@ void Nuclide::create_derived(
           (E[i + 1] - E[i]);
         xs_cdf_[i+1] = xs_cdf_sum;
       }
+
+      // Maximum cross section in each block of the 0K grid, used to find the
+      // DBRC rejection bound without scanning every point in the range
+      int n_block = E.size() / ELASTIC_0K_BLOCK;
+      elastic_0K_max_.resize(n_block);
+      for (int b = 0; b < n_block; ++b) {
+        auto first = xs.begin() + b * ELASTIC_0K_BLOCK;
+        elastic_0K_max_[b] = *std::max_element(first, first + ELASTIC_0K_BLOCK);
+      }
+    }
+  }
+}
+
+void Nuclide::derive_xs()
+{
+  for (int t = 0; t < kTs_.size(); ++t) {
+    if (!grid_[t].energy.empty())
+      this->build_inelastic_cdf(t);
+  }
+
+  // Reuse the result of a previous run when a cross section cache is available
+  std::string path;
+  if (!xs_cache_key_.empty()) {
+    path = fmt::format("{}/{}_{:016x}.xs", settings::path_xs_cache, name_,
+      std::hash<std::string> {}(xs_cache_key_));
+    if (this->read_xs_cache(path, xs_cache_key_))
+      return;
+  }
+
+  // Sum reaction cross sections at each temperature that has been read
+  xs_.resize(kTs_.size());
+  for (int t = 0; t < kTs_.size(); ++t) {
+    if (!grid_[t].energy.empty())
+      xs_[t] = this->sum_reaction_xs(t);
+  }
+
+  if (!path.empty() && mpi::master)
+    this->write_xs_cache(path, xs_cache_key_);
+}
+
+void Nuclide::build_inelastic_cdf(int i_temp)
+{
+  int n = index_inelastic_scatter_.size();
+  if (n < INELASTIC_CDF_MIN_REACTIONS)
+    return;
+
+  // Intervals below the lowest threshold have no inelastic scattering
+  int n_energy = grid_[i_temp].energy.size();
+  int first = n_energy;
+  for (int i : index_inelastic_scatter_) {
+    first = std::min(first, reactions_[i]->xs_[i_temp].threshold);
+  }
+  auto& cdf {inelastic_cdf_[i_temp]};
+  cdf.threshold = first;
+  int n_interval = std::max(n_energy - 1 - first, 0);
+  cdf.value.resize(2 * n * static_cast<size_t>(n_interval));
+
+  for (int i = first; i < n_energy - 1; ++i) {
+    xs_real* row = &cdf.value[2 * n * static_cast<size_t>(i - first)];
+    double lower = 0.0;
+    double upper = 0.0;
+    for (int k = 0; k < n; ++k) {
+      const auto& xs = reactions_[index_inelastic_scatter_[k]]->xs_[i_temp];
+      if (i >= xs.threshold) {
+        lower += xs.value[i - xs.threshold];
+        upper += xs.value[i - xs.threshold + 1];
+      }
+      row[k] = lower;
+      row[n + k] = upper;
+    }
+  }
+}
+
+NodeSharedArray<xs_real> Nuclide::sum_reaction_xs(int i_temp) const
+{
+  // Allocate and initialize cross section
+  const auto& energy = grid_[i_temp].energy;
+  array<size_t, 2> shape {energy.size(), 5};
+  xt::xtensor<double, 2> derived(shape, 0.0);
+
+  const Function1D* prompt_photons = prompt_photons_.get();
+  const Function1D* delayed_photons = delayed_photons_.get();
+  for (const auto& rx : reactions_) {
+    int j = rx->xs_[i_temp].threshold;
+    const auto& xs = rx->xs_[i_temp].value;
+    int n = xs.size();
+
+    for (const auto& p : rx->products_) {
+      if (p.particle_ == ParticleType::photon) {
+        auto pprod = xt::view(derived, xt::range(j, j + n), XS_PHOTON_PROD);
+        for (int k = 0; k < n; ++k) {
+          double E = energy[k + j];
+
+          // For fission, artificially increase the photon yield to account
+          // for delayed photons
+          double f = 1.0;
+          if (settings::delayed_photon_scaling) {
+            if (is_fission(rx->mt_)) {
+              if (prompt_photons && delayed_photons) {
+                double energy_prompt = (*prompt_photons)(E);
+                double energy_delayed = (*delayed_photons)(E);
+                f = (energy_prompt + energy_delayed) / (energy_prompt);
+              }
+            }
+          }
+
+          pprod[k] += f * xs[k] * (*p.yield_)(E);
+        }
+      }
+    }
+
+    // Skip redundant reactions
+    if (rx->redundant_)
+      continue;
+
+    // Add contribution to total cross section
+    auto total = xt::view(derived, xt::range(j, j + n), XS_TOTAL);
+    for (int k = 0; k < n; ++k)
+      total[k] += xs[k];
+
+    // Add contribution to absorption cross section
+    auto absorption = xt::view(derived, xt::range(j, j + n), XS_ABSORPTION);
+    if (is_disappearance(rx->mt_)) {
+      for (int k = 0; k < n; ++k)
+        absorption[k] += xs[k];
+    }
+
+    if (is_fission(rx->mt_)) {
+      auto fission = xt::view(derived, xt::range(j, j + n), XS_FISSION);
+      for (int k = 0; k < n; ++k) {
+        fission[k] += xs[k];
+        absorption[k] += xs[k];
+      }
+    }
+  }
+
+  // Calculate nu-fission cross section
+  if (fissionable_) {
+    for (int i = 0; i < energy.size(); ++i) {
+      derived(i, XS_NU_FISSION) =
+        nu(energy[i], EmissionMode::total) * derived(i, XS_FISSION);
+    }
+  }
+
+  // Store derived cross sections as a row-major array that can later be
+  // moved into node-shared memory. Sums are formed in double precision before
+  // being rounded to the storage type.
+  return NodeSharedArray<xs_real>(
+    vector<xs_real>(derived.begin(), derived.end()), shape[1]);
+}
+
+bool Nuclide::read_xs_cache(const std::string& path, const std::string& key)
+{
+  std::ifstream in {path, std::ios::binary};
+  if (!in)
+    return false;
+
+  // Make sure the file is a cache of the expected version for this nuclide
+  char magic[sizeof(XS_CACHE_MAGIC)];
+  int32_t version;
+  uint64_t key_size;
+  in.read(magic, sizeof(magic));
+  in.read(reinterpret_cast<char*>(&version), sizeof(version));
+  in.read(reinterpret_cast<char*>(&key_size), sizeof(key_size));
+  if (!in || std::memcmp(magic, XS_CACHE_MAGIC, sizeof(magic)) != 0 ||
+      version != XS_CACHE_VERSION || key_size != key.size())
+    return false;
+  std::string file_key(key_size, '\0');
+  in.read(&file_key[0], key_size);
+  if (!in || file_key != key)
+    return false;
+
+  // Read derived cross sections at each temperature
+  uint64_t n_temps;
+  in.read(reinterpret_cast<char*>(&n_temps), sizeof(n_temps));
+  if (!in || n_temps != kTs_.size())
+    return false;
+  vector<vector<xs_real>> values(n_temps);
+  for (int t = 0; t < n_temps; ++t) {
+    uint64_t n_energy;
+    in.read(reinterpret_cast<char*>(&n_energy), sizeof(n_energy));
+    if (!in || n_energy != grid_[t].energy.size())
+      return false;
+    values[t].resize(5 * n_energy);
+    in.read(reinterpret_cast<char*>(values[t].data()),
+      values[t].size() * sizeof(xs_real));
+  }
+  if (!in)
+    return false;
+
+  xs_.resize(n_temps);
+  for (int t = 0; t < n_temps; ++t) {
+    xs_[t] = NodeSharedArray<xs_real>(std::move(values[t]), 5);
+  }
+  return true;
+}
+
+void Nuclide::write_xs_cache(
+  const std::string& path, const std::string& key) const
+{
+  // Write to a temporary file that is then renamed so that other processes
+  // never read a partially written cache
+  std::string tmp_path = path + ".tmp";
+  std::ofstream out {tmp_path, std::ios::binary};
+  int32_t version = XS_CACHE_VERSION;
+  uint64_t key_size = key.size();
+  uint64_t n_temps = kTs_.size();
+  out.write(XS_CACHE_MAGIC, sizeof(XS_CACHE_MAGIC));
+  out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+  out.write(reinterpret_cast<const char*>(&key_size), sizeof(key_size));
+  out.write(key.data(), key_size);
+  out.write(reinterpret_cast<const char*>(&n_temps), sizeof(n_temps));
+  for (int t = 0; t < n_temps; ++t) {
+    uint64_t n_energy = grid_[t].energy.size();
+    out.write(reinterpret_cast<const char*>(&n_energy), sizeof(n_energy));
+    out.write(reinterpret_cast<const char*>(xs_[t].data()), xs_[t].nbytes());
+  }
+  out.close();
+
+  if (!out || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+    warning(fmt::format("Could not write cross section cache file {}.", path));
+  }
+}
+
+size_t Nuclide::share_data()
+{
+  // Gather every array that is to be shared. Energy grids are always double
+  // precision whereas cross section values use the storage type.
+  vector<NodeSharedArray<double>*> grids;
+  vector<NodeSharedArray<xs_real>*> values;
+  for (int t = 0; t < kTs_.size(); ++t) {
+    grids.push_back(&grid_[t].energy);
+    values.push_back(&xs_[t]);
+    for (auto& rx : reactions_) {
+      values.push_back(&rx->xs_[t].value);
+    }
+  }
+
+  // Lay out arrays within a single segment, keeping each one aligned to a
+  // cache line
+  constexpr size_t alignment = 64;
+  size_t nbytes = 0;
+  auto layout = [&](const auto& arrays) {
+    vector<size_t> offsets;
+    for (const auto* a : arrays) {
+      offsets.push_back(nbytes);
+      nbytes += (a->nbytes() + alignment - 1) / alignment * alignment;
     }
+    return offsets;
+  };
+  vector<size_t> grid_offsets = layout(grids);
+  vector<size_t> value_offsets = layout(values);
+
+  auto segment = std::make_shared<NodeSharedSegment>(nbytes);
+  for (int i = 0; i < grids.size(); ++i) {
+    grids[i]->attach(segment, grid_offsets[i], settings::numa_first_touch);
+  }
+  for (int i = 0; i < values.size(); ++i) {
+    values[i]->attach(segment, value_offsets[i], settings::numa_first_touch);
+  }
+  segment->sync();
+  return nbytes;
+}
+
+void Nuclide::place_data()
+{
+  auto use = PageUse::CROSS_SECTIONS;
+  bool spread = settings::numa_first_touch;
+  for (int t = 0; t < kTs_.size(); ++t) {
+    grid_[t].energy.move_to_pages(use, spread);
+    xs_[t].move_to_pages(use, spread);
+    for (auto& rx : reactions_) {
+      rx->xs_[t].value.move_to_pages(use, spread);
+    }
+  }
+}
+
+size_t Nuclide::init_grid()
+{
+  size_t bytes = 0;
+  for (int t = 0; t < grid_.size(); ++t) {
+    // Temperatures that have not been read yet are set up once they are
+    if (!grid_[t].energy.empty())
+      bytes += this->init_grid(t);
   }
+  return bytes;
 }
 
-void Nuclide::init_grid()
+size_t Nuclide::init_grid(int i_temp)
 {
   int neutron = static_cast<int>(ParticleType::neutron);
   double E_min = data::energy_min[neutron];
@@ -474,24 +768,155 @@ void Nuclide::init_grid()
   // Create equally log-spaced energy grid
   auto umesh = xt::linspace(0.0, M * spacing, M + 1);
 
-  for (auto& grid : grid_) {
-    // Resize array for storing grid indices
-    grid.grid_index.resize(M + 1);
-
-    // Determine corresponding indices in nuclide grid to energies on
-    // equal-logarithmic grid
-    int j = 0;
-    for (int k = 0; k <= M; ++k) {
-      while (std::log(grid.energy[j + 1] / E_min) <= umesh(k)) {
-        // Ensure that for isotopes where maxval(grid.energy) << E_max that
-        // there are no out-of-bounds issues.
-        if (j + 2 == grid.energy.size())
-          break;
-        ++j;
+  auto& grid = grid_[i_temp];
+
+  // Resize array for storing grid indices
+  grid.grid_index.resize(M + 1);
+
+  // Determine corresponding indices in nuclide grid to energies on
+  // equal-logarithmic grid
+  int j = 0;
+  for (int k = 0; k <= M; ++k) {
+    while (std::log(grid.energy[j + 1] / E_min) <= umesh(k)) {
+      // Ensure that for isotopes where maxval(grid.energy) << E_max that
+      // there are no out-of-bounds issues.
+      if (j + 2 == grid.energy.size())
+        break;
+      ++j;
+    }
+    grid.grid_index[k] = j;
+  }
+
+  // Subdivide logarithmic bins that contain many grid points so that the
+  // remaining search window holds roughly hash_grid_points_per_bin points
+  int target = settings::hash_grid_points_per_bin;
+  if (target <= 0)
+    return 0;
+
+  grid.hash_offset.resize(M + 1);
+  grid.hash_index.clear();
+  for (int k = 0; k < M; ++k) {
+    grid.hash_offset[k] = grid.hash_index.size();
+    int n_points = grid.grid_index[k + 1] - grid.grid_index[k];
+    int n_sub = std::max(1, (n_points + target - 1) / target);
+
+    // Determine grid index at each sub-bin boundary, with sub-bins equally
+    // spaced in energy across the logarithmic bin
+    double E_low = simulation::log_grid_energy[k];
+    double width = (simulation::log_grid_energy[k + 1] - E_low) / n_sub;
+    int i_grid = grid.grid_index[k];
+    grid.hash_index.push_back(i_grid);
+    for (int s = 1; s < n_sub; ++s) {
+      double E = E_low + s * width;
+      while (i_grid + 2 < grid.energy.size() && grid.energy[i_grid + 1] <= E)
+        ++i_grid;
+      grid.hash_index.push_back(i_grid);
+    }
+  }
+  grid.hash_offset[M] = grid.hash_index.size();
+  grid.hash_index.push_back(grid.grid_index[M]);
+
+  return sizeof(int) * (grid.hash_offset.size() + grid.hash_index.size());
+}
+
+size_t Nuclide::memory_usage(int i_temp) const
+{
+  const auto& grid = grid_[i_temp];
+  size_t bytes = grid.energy.nbytes() + xs_[i_temp].nbytes() +
+                 sizeof(int) * (grid.grid_index.size() +
+                                 grid.hash_offset.size() +
+                                 grid.hash_index.size());
+  for (const auto& rx : reactions_) {
+    bytes += rx->xs_[i_temp].value.nbytes();
+  }
+  if (i_temp < inelastic_cdf_.size())
+    bytes += sizeof(xs_real) * inelastic_cdf_[i_temp].value.size();
+  return bytes;
+}
+
+size_t Nuclide::memory_usage() const
+{
+  size_t bytes = 0;
+  for (int t = 0; t < kTs_.size(); ++t) {
+    bytes += this->memory_usage(t);
+  }
+
+  // Resonance scattering data
+  bytes += sizeof(double) * (energy_0K_.size() + elastic_0K_.size() +
+                              xs_cdf_.size() + elastic_0K_max_.size());
+
+  // Unresolved resonance probability tables
+  for (const auto& urr : urr_data_) {
+    bytes += sizeof(double) * (urr.energy_.size() + urr.cdf_values_.size()) +
+             sizeof(UrrData::XSSet) * urr.xs_values_.size();
+  }
+
+  // Windowed multipole data
+  if (multipole_) {
+    bytes += sizeof(double) * (multipole_->curvefit_.size() +
+                                multipole_->data_re_.size() +
+                                multipole_->data_im_.size());
+  }
+  return bytes;
+}
+
+bool Nuclide::has_deferred_temperatures() const
+{
+  // The grids themselves may be written by another thread reading a deferred
+  // temperature, so only the flags set once reading finishes are checked
+  for (int t = 0; t < kTs_.size(); ++t) {
+    if (!temperature_loaded_[t].load(std::memory_order_acquire))
+      return true;
+  }
+  return false;
+}
+
+void Nuclide::load_temperature(int i_temp)
+{
+  write_message(7, "Reading {} at {} K from {}", name_, temperatures_[i_temp],
+    library_path_);
+
+  // The HDF5 library is not assumed to be thread-safe, so only one deferred
+  // temperature is read at a time
+  auto& grid = grid_[i_temp];
+#pragma omp critical(LoadTemperature)
+  {
+    hid_t file_id = file_open(library_path_, 'r');
+    hid_t group = open_group(file_id, name_.c_str());
+    std::string dset {std::to_string(temperatures_[i_temp]) + "K"};
+
+    // Read energy grid
+    hid_t energy_group = open_group(group, "energy");
+    vector<double> energy;
+    read_dataset(energy_group, dset.c_str(), energy);
+    grid.energy = NodeSharedArray<double>(std::move(energy));
+    close_group(energy_group);
+
+    // Read reaction cross sections, which appear in the same order as when
+    // the reactions were constructed
+    hid_t rxs_group = open_group(group, "reactions");
+    int i_rx = 0;
+    for (auto name : group_names(rxs_group)) {
+      if (starts_with(name, "reaction_")) {
+        hid_t rx_group = open_group(rxs_group, name.c_str());
+        reactions_[i_rx++]->xs_[i_temp] =
+          Reaction::read_xs(rx_group, temperatures_[i_temp]);
+        close_group(rx_group);
       }
-      grid.grid_index[k] = j;
     }
+    close_group(rxs_group);
+
+    close_group(group);
+    file_close(file_id);
   }
+
+  // Derive cross sections and, if the logarithmic grid has already been set
+  // up for the other temperatures, grid indices
+  xs_[i_temp] = this->sum_reaction_xs(i_temp);
+  this->build_inelastic_cdf(i_temp);
+  if (!simulation::log_grid_energy.empty())
+    this->init_grid(i_temp);
+  temperature_loaded_[i_temp].store(true, std::memory_order_release);
 }
 
 double Nuclide::nu(double E, EmissionMode mode, int group) const
@@ -537,6 +962,35 @@ double Nuclide::nu(double E, EmissionMode mode, int group) const
   UNREACHABLE();
 }
 
+double Nuclide::nu(double E, EmissionMode mode, NuclideMicroXS& micro) const
+{
+  // Discard yields evaluated at a different energy
+  if (micro.nu_E != E) {
+    micro.nu_E = E;
+    micro.nu_total = -1.0;
+    micro.nu_prompt = -1.0;
+    micro.nu_delayed = -1.0;
+  }
+
+  double* nu;
+  switch (mode) {
+  case EmissionMode::prompt:
+    nu = &micro.nu_prompt;
+    break;
+  case EmissionMode::delayed:
+    nu = &micro.nu_delayed;
+    break;
+  case EmissionMode::total:
+    nu = &micro.nu_total;
+    break;
+  default:
+    UNREACHABLE();
+  }
+  if (*nu < 0.0)
+    *nu = this->nu(E, mode);
+  return *nu;
+}
+
 void Nuclide::calculate_elastic_xs(Particle& p) const
 {
   // Get temperature index, grid index, and interpolation factor
@@ -575,8 +1029,29 @@ double Nuclide::elastic_xs_0K(double E) const
   return (1.0 - f) * elastic_0K_[i_grid] + f * elastic_0K_[i_grid + 1];
 }
 
-void Nuclide::calculate_xs(
-  int i_sab, int i_log_union, double sab_frac, Particle& p)
+double Nuclide::elastic_xs_0K_max(int i_begin, int i_end) const
+{
+  // Blocks lying entirely within the range
+  int b_begin = (i_begin + ELASTIC_0K_BLOCK - 1) / ELASTIC_0K_BLOCK;
+  int b_end = i_end / ELASTIC_0K_BLOCK;
+  if (b_begin >= b_end) {
+    return *std::max_element(
+      elastic_0K_.begin() + i_begin, elastic_0K_.begin() + i_end);
+  }
+
+  // Scan the partial blocks at either end and use the block maxima in between
+  double xs_max = elastic_0K_[i_begin];
+  for (int i = i_begin; i < b_begin * ELASTIC_0K_BLOCK; ++i)
+    xs_max = std::max(xs_max, elastic_0K_[i]);
+  for (int b = b_begin; b < b_end; ++b)
+    xs_max = std::max(xs_max, elastic_0K_max_[b]);
+  for (int i = b_end * ELASTIC_0K_BLOCK; i < i_end; ++i)
+    xs_max = std::max(xs_max, elastic_0K_[i]);
+  return xs_max;
+}
+
+void Nuclide::calculate_xs(int i_sab, int i_log_union, double sab_frac,
+  Particle& p, const UnionIndex* u, const array<double, 3>* mp_xs)
 {
   auto& micro {p.neutron_xs(index_)};
 
@@ -593,16 +1068,23 @@ void Nuclide::calculate_xs(
 
   // Evaluate multipole or interpolate
   if (use_mp) {
-    // Call multipole kernel
+    // Call multipole kernel unless the cross sections were evaluated as part
+    // of a batch
     double sig_s, sig_a, sig_f;
-    std::tie(sig_s, sig_a, sig_f) = multipole_->evaluate(p.E(), p.sqrtkT());
+    if (mp_xs) {
+      sig_s = (*mp_xs)[0];
+      sig_a = (*mp_xs)[1];
+      sig_f = (*mp_xs)[2];
+    } else {
+      std::tie(sig_s, sig_a, sig_f) = multipole_->evaluate(p.E(), p.sqrtkT());
+    }
 
     micro.total = sig_s + sig_a;
     micro.elastic = sig_s;
     micro.absorption = sig_a;
     micro.fission = sig_f;
     micro.nu_fission =
-      fissionable_ ? sig_f * this->nu(p.E(), EmissionMode::total) : 0.0;
+      fissionable_ ? sig_f * this->nu(p.E(), EmissionMode::total, micro) : 0.0;
 
     if (simulation::need_depletion_rx) {
       // Only non-zero reaction is (n,gamma)
@@ -634,16 +1116,15 @@ void Nuclide::calculate_xs(
     double f;
     int i_temp = -1;
     switch (settings::temperature_method) {
-    case TemperatureMethod::NEAREST: {
-      double max_diff = INFTY;
-      for (int t = 0; t < kTs_.size(); ++t) {
-        double diff = std::abs(kTs_[t] - kT);
-        if (diff < max_diff) {
-          i_temp = t;
-          max_diff = diff;
-        }
+    case TemperatureMethod::NEAREST:
+      // Use the index cached when the cell temperature was assigned if the
+      // particle's temperature came from a cell
+      if (p.i_sqrtkT() >= 0) {
+        i_temp = cell_temp_index_[p.i_sqrtkT()];
+      } else {
+        i_temp = this->nearest_temperature(kT);
       }
-    } break;
+      break;
 
     case TemperatureMethod::INTERPOLATION:
       // Find temperatures that bound the actual temperature
@@ -659,6 +1140,10 @@ void Nuclide::calculate_xs(
       break;
     }
 
+    // Read data at this temperature if it was deferred
+    if (settings::temperature_lazy)
+      this->ensure_temperature(i_temp);
+
     // Determine the energy grid index using a logarithmic mapping to
     // reduce the energy range over which a binary search needs to be
     // performed
@@ -667,15 +1152,39 @@ void Nuclide::calculate_xs(
     const auto& xs {xs_[i_temp]};
 
     int i_grid;
-    if (p.E() < grid.energy.front()) {
+    if (u && !(*u->map)[i_temp].empty()) {
+      // The unionized grid contains every point of this nuclide's grid, so the
+      // bounding index follows directly from the precomputed map
+      i_grid = (*u->map)[i_temp][u->i_union];
+    } else if (p.E() < grid.energy.front()) {
       i_grid = 0;
     } else if (p.E() > grid.energy.back()) {
       i_grid = grid.energy.size() - 2;
     } else {
       // Determine bounding indices based on which equal log-spaced
       // interval the energy is in
-      int i_low = grid.grid_index[i_log_union];
-      int i_high = grid.grid_index[i_log_union + 1] + 1;
+      int i_low;
+      int i_high;
+      if (grid.hash_offset.empty()) {
+        i_low = grid.grid_index[i_log_union];
+        i_high = grid.grid_index[i_log_union + 1] + 1;
+      } else {
+        // Narrow the window further using the sub-bins of this interval
+        int offset = grid.hash_offset[i_log_union];
+        int n_sub = grid.hash_offset[i_log_union + 1] - offset;
+        double E_low = simulation::log_grid_energy[i_log_union];
+        double E_high = simulation::log_grid_energy[i_log_union + 1];
+        int s = (p.E() - E_low) / (E_high - E_low) * n_sub;
+        s = std::min(std::max(s, 0), n_sub - 1);
+        i_low = grid.hash_index[offset + s];
+        i_high = grid.hash_index[offset + s + 1] + 1;
+
+        // Guard against roundoff in the sub-bin calculation
+        while (i_low > 0 && grid.energy[i_low] > p.E())
+          --i_low;
+        while (i_high < grid.energy.size() - 1 && grid.energy[i_high] <= p.E())
+          ++i_high;
+      }
 
       // Perform binary search over reduced range
       i_grid = i_low + lower_bound_index(
@@ -783,6 +1292,134 @@ void Nuclide::calculate_xs(
   micro.last_sqrtkT = p.sqrtkT();
 }
 
+int Nuclide::sample_inelastic_scatter(
+  const NuclideMicroXS& micro, double cutoff) const
+{
+  if (micro.index_temp < 0)
+    return C_NONE;
+  const auto& cdf {inelastic_cdf_[micro.index_temp]};
+  int n = index_inelastic_scatter_.size();
+  int64_t i = micro.index_grid - cdf.threshold;
+  if (cdf.value.empty() || i < 0 || 2 * n * i >= cdf.value.size())
+    return C_NONE;
+
+  // Binary search for the first reaction whose interpolated cumulative cross
+  // section reaches the cutoff
+  const xs_real* row = &cdf.value[2 * n * i];
+  double f = micro.interp_factor;
+  int lo = 0;
+  int hi = n;
+  while (lo < hi) {
+    int mid = (lo + hi) / 2;
+    if ((1.0 - f) * row[mid] + f * row[n + mid] < cutoff) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo < n ? index_inelastic_scatter_[lo] : C_NONE;
+}
+
+int Nuclide::nearest_temperature(double kT) const
+{
+  int i_temp = -1;
+  double max_diff = INFTY;
+  for (int t = 0; t < kTs_.size(); ++t) {
+    double diff = std::abs(kTs_[t] - kT);
+    if (diff < max_diff) {
+      i_temp = t;
+      max_diff = diff;
+    }
+  }
+  return i_temp;
+}
+
+void Nuclide::update_cell_temperatures()
+{
+  for (auto i = cell_temp_index_.size(); i < data::cell_sqrtkT.size(); ++i) {
+    double sqrtkT = data::cell_sqrtkT[i];
+    cell_temp_index_.push_back(this->nearest_temperature(sqrtkT * sqrtkT));
+  }
+}
+
+array<double, 4> Nuclide::interpolate_xs(
+  int i_temp, int i_grid, double E) const
+{
+  const auto& energy {grid_[i_temp].energy};
+  const auto& xs {xs_[i_temp]};
+
+  // check for rare case where two energy points are the same
+  if (energy[i_grid] == energy[i_grid + 1])
+    ++i_grid;
+  double f = (E - energy[i_grid]) / (energy[i_grid + 1] - energy[i_grid]);
+
+  array<double, 4> result;
+  result[0] = (1.0 - f) * xs(i_grid, XS_TOTAL) + f * xs(i_grid + 1, XS_TOTAL);
+  result[1] =
+    (1.0 - f) * xs(i_grid, XS_ABSORPTION) + f * xs(i_grid + 1, XS_ABSORPTION);
+  if (fissionable_) {
+    result[2] =
+      (1.0 - f) * xs(i_grid, XS_FISSION) + f * xs(i_grid + 1, XS_FISSION);
+    result[3] =
+      (1.0 - f) * xs(i_grid, XS_NU_FISSION) + f * xs(i_grid + 1, XS_NU_FISSION);
+  } else {
+    result[2] = 0.0;
+    result[3] = 0.0;
+  }
+  return result;
+}
+
+vector<double> Nuclide::total_xs_bound()
+{
+  int M = settings::n_log_bins;
+  vector<double> bound(M, 0.0);
+  vector<double> bound_temp(M);
+  for (int t = 0; t < kTs_.size(); ++t) {
+    this->ensure_temperature(t);
+    const auto& grid {grid_[t]};
+    const auto& xs {xs_[t]};
+    int n = grid.energy.size();
+
+    // A lookup within a bin interpolates between grid points from the bin's
+    // starting index up to one past its ending index
+    for (int k = 0; k < M; ++k) {
+      bound_temp[k] = 0.0;
+      int i_end = std::min(grid.grid_index[k + 1] + 1, n - 1);
+      for (int i = grid.grid_index[k]; i <= i_end; ++i) {
+        bound_temp[k] =
+          std::max(bound_temp[k], static_cast<double>(xs(i, XS_TOTAL)));
+      }
+    }
+
+    // Probability tables either replace the smooth elastic, fission, and
+    // capture cross sections or give factors that multiply them
+    if (urr_present_ && settings::urr_ptables_on) {
+      const auto& urr {urr_data_[t]};
+      double urr_max = 0.0;
+      for (const auto& x : urr.xs_values_) {
+        urr_max = std::max(urr_max,
+          urr.multiply_smooth_ ? std::max({x.elastic, x.fission, x.n_gamma})
+                               : x.elastic + x.fission + x.n_gamma);
+      }
+      for (int k = 0; k < M; ++k) {
+        if (simulation::log_grid_energy[k + 1] < urr.energy_.front() ||
+            simulation::log_grid_energy[k] > urr.energy_.back())
+          continue;
+        if (urr.multiply_smooth_) {
+          bound_temp[k] *= std::max(1.0, urr_max);
+        } else {
+          bound_temp[k] += urr_max;
+        }
+      }
+    }
+
+    for (int k = 0; k < M; ++k) {
+      bound[k] = std::max(bound[k], bound_temp[k]);
+    }
+  }
+  return bound;
+}
+
 void Nuclide::calculate_sab_xs(int i_sab, double sab_frac, Particle& p)
 {
   auto& micro {p.neutron_xs(index_)};
@@ -794,8 +1431,8 @@ void Nuclide::calculate_sab_xs(int i_sab, double sab_frac, Particle& p)
   int i_temp;
   double elastic;
   double inelastic;
-  data::thermal_scatt[i_sab]->calculate_xs(
-    p.E(), p.sqrtkT(), &i_temp, &elastic, &inelastic, p.current_seed());
+  data::thermal_scatt[i_sab]->calculate_xs(p.E(), p.sqrtkT(), p.i_sqrtkT(),
+    &i_temp, &elastic, &inelastic, p.current_seed());
 
   // Store the S(a,b) cross sections.
   micro.thermal = sab_frac * (elastic + inelastic);
@@ -821,9 +1458,17 @@ void Nuclide::calculate_urr_xs(int i_temp, Particle& p) const
   // Create a shorthand for the URR data
   const auto& urr = urr_data_[i_temp];
 
-  // Determine the energy table
-  int i_energy =
-    lower_bound_index(urr.energy_.begin(), urr.energy_.end(), p.E());
+  // Determine the energy table. If the energy is still within the bracket found
+  // on the last lookup, the search can be skipped.
+  bool same_table = (micro.urr_index_temp == i_temp);
+  int i_energy;
+  if (same_table && urr.energy_[micro.urr_index_energy] < p.E() &&
+      p.E() <= urr.energy_[micro.urr_index_energy + 1]) {
+    i_energy = micro.urr_index_energy;
+  } else {
+    i_energy =
+      lower_bound_index(urr.energy_.begin(), urr.energy_.end(), p.E());
+  }
 
   // Sample the probability table using the cumulative distribution
 
@@ -835,13 +1480,27 @@ void Nuclide::calculate_urr_xs(int i_temp, Particle& p) const
   double r = future_prn(static_cast<int64_t>(index_), *p.current_seed());
   p.stream() = STREAM_TRACKING;
 
-  // Warning: this assumes row-major order of cdf_values_
-  int i_low = upper_bound_index(&urr.cdf_values_(i_energy, 0),
-                &urr.cdf_values_(i_energy, 0) + urr.n_cdf(), r) +
-              1;
-  int i_up = upper_bound_index(&urr.cdf_values_(i_energy + 1, 0),
-               &urr.cdf_values_(i_energy + 1, 0) + urr.n_cdf(), r) +
-             1;
+  // The bands only need to be found again if the bracket or random number
+  // has changed since the last lookup
+  int i_low;
+  int i_up;
+  if (same_table && i_energy == micro.urr_index_energy && r == micro.urr_prn) {
+    i_low = micro.urr_band_low;
+    i_up = micro.urr_band_up;
+  } else {
+    // Warning: this assumes row-major order of cdf_values_
+    i_low = upper_bound_index(&urr.cdf_values_(i_energy, 0),
+              &urr.cdf_values_(i_energy, 0) + urr.n_cdf(), r) +
+            1;
+    i_up = upper_bound_index(&urr.cdf_values_(i_energy + 1, 0),
+             &urr.cdf_values_(i_energy + 1, 0) + urr.n_cdf(), r) +
+           1;
+    micro.urr_index_temp = i_temp;
+    micro.urr_index_energy = i_energy;
+    micro.urr_prn = r;
+    micro.urr_band_low = i_low;
+    micro.urr_band_up = i_up;
+  }
 
   // Determine elastic, fission, and capture cross sections from the
   // probability table
@@ -943,7 +1602,7 @@ void Nuclide::calculate_urr_xs(int i_temp, Particle& p) const
 
   // Determine nu-fission cross-section
   if (fissionable_) {
-    micro.nu_fission = nu(p.E(), EmissionMode::total) * micro.fission;
+    micro.nu_fission = nu(p.E(), EmissionMode::total, micro) * micro.fission;
   }
 }
 
@@ -985,33 +1644,82 @@ std::pair<gsl::index, double> Nuclide::find_temperature(double T) const
 double Nuclide::collapse_rate(int MT, double temperature,
   gsl::span<const double> energy, gsl::span<const double> flux) const
 {
-  Expects(MT > 0);
+  double rate;
+  this->collapse_rates(
+    {&MT, 1}, temperature, energy, flux, log_grid_indices(energy), &rate);
+  return rate;
+}
+
+void Nuclide::collapse_rates(gsl::span<const int> MTs, double temperature,
+  gsl::span<const double> energy, gsl::span<const double> flux,
+  gsl::span<const int> i_log, double* rates) const
+{
   Expects(energy.size() > 0);
   Expects(energy.size() == flux.size() + 1);
 
-  int i_rx = reaction_index_[MT];
-  if (i_rx < 0)
-    return 0.0;
-  const auto& rx = reactions_[i_rx];
-
   // Determine temperature index
   gsl::index i_temp;
   double f;
   std::tie(i_temp, f) = this->find_temperature(temperature);
+  this->ensure_temperature(i_temp);
+  if (f > 0.0)
+    this->ensure_temperature(i_temp + 1);
+
+  // Locate the group boundaries on the energy grid once for all reactions
+  vector<int> indices_low;
+  vector<int> indices_high;
+  this->grid_indices(i_temp, energy, i_log, indices_low);
+  if (f > 0.0)
+    this->grid_indices(i_temp + 1, energy, i_log, indices_high);
+
+  for (int k = 0; k < MTs.size(); ++k) {
+    Expects(MTs[k] > 0);
+    int i_rx = reaction_index_[MTs[k]];
+    if (i_rx < 0) {
+      rates[k] = 0.0;
+      continue;
+    }
+    const auto& rx = reactions_[i_rx];
 
-  // Get reaction rate at lower temperature
-  const auto& grid_low = grid_[i_temp].energy;
-  double rr_low = rx->collapse_rate(i_temp, energy, flux, grid_low);
+    // Get reaction rate at lower temperature
+    double rr_low = rx->collapse_rate(
+      i_temp, energy, flux, grid_[i_temp].energy, indices_low);
 
-  if (f > 0.0) {
-    // Interpolate between reaction rate at lower and higher temperature
-    const auto& grid_high = grid_[i_temp + 1].energy;
-    double rr_high = rx->collapse_rate(i_temp + 1, energy, flux, grid_high);
-    return rr_low + f * (rr_high - rr_low);
-  } else {
-    // If interpolation factor is zero, return reaction rate at lower
-    // temperature
-    return rr_low;
+    if (f > 0.0) {
+      // Interpolate between reaction rate at lower and higher temperature
+      double rr_high = rx->collapse_rate(
+        i_temp + 1, energy, flux, grid_[i_temp + 1].energy, indices_high);
+      rates[k] = rr_low + f * (rr_high - rr_low);
+    } else {
+      // If interpolation factor is zero, return reaction rate at lower
+      // temperature
+      rates[k] = rr_low;
+    }
+  }
+}
+
+void Nuclide::grid_indices(gsl::index i_temp, gsl::span<const double> energy,
+  gsl::span<const int> i_log, vector<int>& indices) const
+{
+  const auto& grid {grid_[i_temp]};
+  int n = grid.energy.size();
+  indices.resize(energy.size());
+  for (int j = 0; j < energy.size(); ++j) {
+    double E = energy[j];
+    if (E <= grid.energy.front()) {
+      indices[j] = 0;
+    } else if (E >= grid.energy.back()) {
+      indices[j] = n - 2;
+    } else if (i_log[j] >= 0 && !grid.grid_index.empty()) {
+      // Only search the part of the grid within the logarithmic interval
+      int i_low = grid.grid_index[i_log[j]];
+      int i_high = std::min(grid.grid_index[i_log[j] + 1] + 2, n);
+      indices[j] = i_low + lower_bound_index(grid.energy.cbegin() + i_low,
+                             grid.energy.cbegin() + i_high, E);
+    } else {
+      indices[j] =
+        lower_bound_index(grid.energy.cbegin(), grid.energy.cend(), E);
+    }
   }
 }
 
@@ -1039,16 +1747,19 @@ void check_data_version(hid_t file_id)
   }
 }
 
+void share_nuclide_data(Nuclide& nuc)
+{
+  size_t bytes = nuc.share_data();
+  write_message(
+    6, "Shared {:.1f} MB of {} data within node", bytes / 1.0e6, nuc.name_);
+}
+
 extern "C" size_t nuclides_size()
 {
   return data::nuclides.size();
 }
 
-//==============================================================================
-// C API
-//==============================================================================
-
-extern "C" int openmc_load_nuclide(const char* name, const double* temps, int n)
+int load_nuclide(const char* name, const double* temps, int n, bool derive)
 {
   if (data::nuclide_map.find(name) == data::nuclide_map.end() ||
       data::nuclide_map.at(name) >= data::elements.size()) {
@@ -1072,7 +1783,13 @@ extern "C" int openmc_load_nuclide(const char* name, const double* temps, int n)
     // Read nuclide data from HDF5
     hid_t group = open_group(file_id, name);
     vector<double> temperature {temps, temps + n};
-    data::nuclides.push_back(make_unique<Nuclide>(group, temperature));
+    data::nuclides.push_back(make_unique<Nuclide>(group, temperature, derive));
+
+    // Keep a single copy of the cross section data on each node
+    if (derive && settings::shared_cross_sections)
+      share_nuclide_data(*data::nuclides.back());
+    if (derive && (settings::numa_first_touch || settings::huge_pages))
+      data::nuclides.back()->place_data();
 
     close_group(group);
     file_close(file_id);
@@ -1116,6 +1833,33 @@ extern "C" int openmc_load_nuclide(const char* name, const double* temps, int n)
   return 0;
 }
 
+vector<int> log_grid_indices(gsl::span<const double> energy)
+{
+  int neutron = static_cast<int>(ParticleType::neutron);
+  double E_min = data::energy_min[neutron];
+  double E_max = data::energy_max[neutron];
+  vector<int> i_log(energy.size(), -1);
+  if (simulation::log_spacing <= 0.0)
+    return i_log;
+  for (int j = 0; j < energy.size(); ++j) {
+    if (energy[j] >= E_min && energy[j] < E_max) {
+      i_log[j] = std::min(
+        static_cast<int>(std::log(energy[j] / E_min) / simulation::log_spacing),
+        settings::n_log_bins - 1);
+    }
+  }
+  return i_log;
+}
+
+//==============================================================================
+// C API
+//==============================================================================
+
+extern "C" int openmc_load_nuclide(const char* name, const double* temps, int n)
+{
+  return load_nuclide(name, temps, n, true);
+}
+
 extern "C" int openmc_get_nuclide_index(const char* name, int* index)
 {
   auto it = data::nuclide_map.find(name);
@@ -1159,12 +1903,112 @@ extern "C" int openmc_nuclide_collapse_rate(int index, int MT,
   return 0;
 }
 
+extern "C" int openmc_collapse_rates(int n_spectra, const double* temperatures,
+  const double* energy, const double* flux, int n_groups, int n_nuclides,
+  const int* nuclides, int n_reactions, const int* MTs, double* rates)
+{
+  for (int k = 0; k < n_nuclides; ++k) {
+    if (nuclides[k] < 0 || nuclides[k] >= data::nuclides.size()) {
+      set_errmsg("Index in nuclides vector is out of bounds.");
+      return OPENMC_E_OUT_OF_BOUNDS;
+    }
+  }
+  for (int k = 0; k < n_reactions; ++k) {
+    if (MTs[k] <= 0 || MTs[k] >= 902) {
+      set_errmsg(fmt::format("Invalid MT value: {}", MTs[k]));
+      return OPENMC_E_INVALID_ARGUMENT;
+    }
+  }
+
+  // The logarithmic grid indices of the group boundaries are shared by all
+  // nuclides and spectra
+  gsl::span<const double> E {energy, energy + n_groups + 1};
+  auto i_log = log_grid_indices(E);
+
+  // Each spectrum, e.g. the flux in one depletable material, is collapsed
+  // independently
+  int err = 0;
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < n_spectra; ++i) {
+    gsl::span<const double> phi {
+      flux + i * n_groups, flux + (i + 1) * n_groups};
+    for (int k = 0; k < n_nuclides; ++k) {
+      double* r = rates + (static_cast<size_t>(i) * n_nuclides + k) *
+                            n_reactions;
+      try {
+        data::nuclides[nuclides[k]]->collapse_rates(
+          {MTs, MTs + n_reactions}, temperatures[i], E, phi, i_log, r);
+      } catch (const std::out_of_range& e) {
+#pragma omp critical(CollapseRates)
+        {
+          set_errmsg(e.what());
+          err = OPENMC_E_OUT_OF_BOUNDS;
+        }
+      }
+    }
+  }
+  return err;
+}
+
+std::string library_path(hid_t group)
+{
+  ssize_t n = std::max<ssize_t>(H5Fget_name(group, nullptr, 0), 0);
+  std::string path(n + 1, '\0');
+  H5Fget_name(group, &path[0], path.size());
+  path.resize(n);
+  return path;
+}
+
+std::string xs_cache_key(const std::string& path, const std::string& name,
+  const vector<double>& kTs)
+{
+  // Identify the library by its path, size, and modification time so that
+  // cache files are not reused once the library changes
+  long long size = 0;
+  long long mtime = 0;
+  struct stat info;
+  if (stat(path.c_str(), &info) == 0) {
+    size = info.st_size;
+    mtime = info.st_mtime;
+  }
+
+  std::string key = fmt::format("{} {} {} {} {} {}", path, size, mtime, name,
+    settings::delayed_photon_scaling, sizeof(xs_real));
+  for (double kT : kTs) {
+    key += fmt::format(" {:a}", kT);
+  }
+  return key;
+}
+
 void nuclides_clear()
 {
   data::nuclides.clear();
   data::nuclide_map.clear();
 }
 
+int cell_temperature_index(double sqrtkT, bool update_nuclides)
+{
+  auto it = data::cell_sqrtkT_map.find(sqrtkT);
+  if (it != data::cell_sqrtkT_map.end())
+    return it->second;
+
+  int i = data::cell_sqrtkT.size();
+  data::cell_sqrtkT.push_back(sqrtkT);
+  data::cell_sqrtkT_map[sqrtkT] = i;
+
+  // Extend the cached temperature indices of nuclides and S(a,b) tables
+  // already loaded
+  if (update_nuclides) {
+    for (auto& nuc : data::nuclides) {
+      nuc->update_cell_temperatures();
+    }
+    for (auto& sab : data::thermal_scatt) {
+      sab->update_cell_temperatures();
+    }
+  }
+  return i;
+}
+
 bool multipole_in_range(const Nuclide& nuc, double E)
 {
   return E >= nuc.multipole_->E_min_ && E <= nuc.multipole_->E_max_;
@@ -0,0 +1,231 @@
+#include "openmc/offload.h"
+
+#include "openmc/constants.h"
+
+#ifdef OPENMC_OFFLOAD
+#include <algorithm> // for copy, min
+#include <cmath>     // for log
+
+#include <omp.h>
+
+#include "openmc/error.h"
+#include "openmc/material.h"
+#include "openmc/message_passing.h"
+#include "openmc/nuclide.h"
+#include "openmc/particle_data.h"
+#include "openmc/settings.h"
+#include "openmc/simulation.h"
+#include "openmc/vector.h"
+#endif
+
+namespace openmc {
+
+#ifdef OPENMC_OFFLOAD
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace {
+
+//! Location of one tabulated temperature of a material in the flat arrays
+struct DeviceTable {
+  int64_t energy; //!< Offset of the unionized grid in grid_energy
+  int64_t index;  //!< Offset of the logarithmic grid map in grid_index
+  int64_t xs;     //!< Offset of the cross sections in table_xs
+  int n_energy;   //!< Number of points on the unionized grid
+};
+
+int device_num {-1}; //!< Device used by this process, or -1 if none
+
+// Material data, which is mapped to the device for the whole simulation
+vector<double> grid_energy;
+vector<int> grid_index;
+vector<double> table_xs;
+vector<DeviceTable> tables;
+vector<int> first_table; //!< Index in tables of each material's first table
+
+// Buffers for the lookups of one queue, also mapped for the whole simulation
+// so that each lookup only updates the entries in use
+int64_t capacity {0};
+vector<int> lookup_table;
+vector<double> lookup_E;
+vector<double> lookup_xs;
+
+} // namespace
+
+#endif
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+void offload_init(int64_t n_particles)
+{
+#ifdef OPENMC_OFFLOAD
+  offload_free();
+
+  // Only tabulated macroscopic cross sections are looked up on the device
+  bool any_tables = false;
+  for (const auto& mat : model::materials) {
+    if (!mat->macro_xs_tables_.empty())
+      any_tables = true;
+  }
+  if (!settings::run_CE || !any_tables)
+    return;
+
+  int n_devices = omp_get_num_devices();
+  if (n_devices == 0) {
+    warning("No offload device is available. Cross sections will be looked "
+            "up on the host.");
+    return;
+  }
+
+  // Processes on a node are spread over its devices
+  device_num = mpi::node_rank % n_devices;
+
+  // Flatten the grids and tables of all materials
+  for (const auto& mat : model::materials) {
+    first_table.push_back(tables.size());
+    if (mat->macro_xs_tables_.empty())
+      continue;
+
+    const auto& grid {mat->union_grid_};
+    DeviceTable t;
+    t.energy = grid_energy.size();
+    t.index = grid_index.size();
+    t.n_energy = grid.energy.size();
+    grid_energy.insert(
+      grid_energy.end(), grid.energy.begin(), grid.energy.end());
+    grid_index.insert(
+      grid_index.end(), grid.grid_index.begin(), grid.grid_index.end());
+    for (const auto& table : mat->macro_xs_tables_) {
+      t.xs = table_xs.size();
+      table_xs.insert(table_xs.end(), table.xs.begin(), table.xs.end());
+      tables.push_back(t);
+    }
+  }
+
+  capacity = n_particles;
+  lookup_table.resize(capacity);
+  lookup_E.resize(capacity);
+  lookup_xs.resize(4 * capacity);
+
+  double* d_energy = grid_energy.data();
+  int* d_index = grid_index.data();
+  double* d_table_xs = table_xs.data();
+  DeviceTable* d_tables = tables.data();
+  int* d_table = lookup_table.data();
+  double* d_E = lookup_E.data();
+  double* d_xs = lookup_xs.data();
+#pragma omp target enter data device(device_num)                             \
+  map(to : d_energy[:grid_energy.size()], d_index[:grid_index.size()],        \
+      d_table_xs[:table_xs.size()], d_tables[:tables.size()])                 \
+  map(alloc : d_table[:capacity], d_E[:capacity], d_xs[:4 * capacity])
+
+  write_message(6,
+    "Mapped {:.1f} MB of tabulated cross sections to offload device {}",
+    (grid_energy.size() * sizeof(double) + grid_index.size() * sizeof(int) +
+      table_xs.size() * sizeof(double)) /
+      1.0e6,
+    device_num);
+#endif
+}
+
+void offload_free()
+{
+#ifdef OPENMC_OFFLOAD
+  if (device_num >= 0) {
+    double* d_energy = grid_energy.data();
+    int* d_index = grid_index.data();
+    double* d_table_xs = table_xs.data();
+    DeviceTable* d_tables = tables.data();
+    int* d_table = lookup_table.data();
+    double* d_E = lookup_E.data();
+    double* d_xs = lookup_xs.data();
+#pragma omp target exit data device(device_num)                              \
+  map(delete : d_energy[:grid_energy.size()], d_index[:grid_index.size()],    \
+      d_table_xs[:table_xs.size()], d_tables[:tables.size()],                 \
+      d_table[:capacity], d_E[:capacity], d_xs[:4 * capacity])
+  }
+
+  grid_energy.clear();
+  grid_index.clear();
+  table_xs.clear();
+  tables.clear();
+  first_table.clear();
+  lookup_table.clear();
+  lookup_E.clear();
+  lookup_xs.clear();
+  capacity = 0;
+  device_num = -1;
+#endif
+}
+
+bool offload_active()
+{
+#ifdef OPENMC_OFFLOAD
+  return device_num >= 0;
+#else
+  return false;
+#endif
+}
+
+int offload_table_index(int i_material, int i_table)
+{
+#ifdef OPENMC_OFFLOAD
+  return first_table[i_material] + i_table;
+#else
+  return C_NONE;
+#endif
+}
+
+void offload_tabulated_xs(
+  int64_t n, const int* table, const double* E, double* xs)
+{
+#ifdef OPENMC_OFFLOAD
+  int neutron = static_cast<int>(ParticleType::neutron);
+  double E_min = data::energy_min[neutron];
+  double log_spacing = simulation::log_spacing;
+
+  // Host addresses of the mapped arrays, which the target region translates
+  // to their device copies
+  const double* d_energy = grid_energy.data();
+  const int* d_index = grid_index.data();
+  const double* d_table_xs = table_xs.data();
+  const DeviceTable* d_tables = tables.data();
+  int* d_table = lookup_table.data();
+  double* d_E = lookup_E.data();
+  double* d_xs = lookup_xs.data();
+  int64_t n_energy = grid_energy.size();
+  int64_t n_index = grid_index.size();
+  int64_t n_table_xs = table_xs.size();
+  int64_t n_tables = tables.size();
+
+  for (int64_t start = 0; start < n; start += capacity) {
+    int64_t m = std::min(capacity, n - start);
+    std::copy(table + start, table + start + m, d_table);
+    std::copy(E + start, E + start + m, d_E);
+#pragma omp target update device(device_num) to(d_table[:m], d_E[:m])
+
+#pragma omp target teams distribute parallel for device(device_num)          \
+  map(alloc : d_energy[:n_energy], d_index[:n_index],                          \
+      d_table_xs[:n_table_xs], d_tables[:n_tables], d_table[:m], d_E[:m],      \
+      d_xs[:4 * m])
+    for (int64_t i = 0; i < m; ++i) {
+      const DeviceTable& t = d_tables[d_table[i]];
+      const double* energy = d_energy + t.energy;
+      double e = d_E[i];
+      int i_log_union = std::log(e / E_min) / log_spacing;
+      int k = union_grid_interval(
+        energy, t.n_energy, d_index + t.index, e, i_log_union);
+      interpolate_macro_xs(energy, d_table_xs + t.xs, k, e, d_xs + 4 * i);
+    }
+
+#pragma omp target update device(device_num) from(d_xs[:4 * m])
+    std::copy(d_xs, d_xs + 4 * m, xs + 4 * start);
+  }
+#endif
+}
+
+} // namespace openmc
@@ -23,6 +23,7 @@
 #include "openmc/cell.h"
 #include "openmc/constants.h"
 #include "openmc/eigenvalue.h"
+#include "openmc/event.h"
 #include "openmc/error.h"
 #include "openmc/geometry.h"
 #include "openmc/lattice.h"
@@ -31,6 +32,7 @@
 #include "openmc/mgxs_interface.h"
 #include "openmc/nuclide.h"
 #include "openmc/plot.h"
+#include "openmc/profile.h"
 #include "openmc/reaction.h"
 #include "openmc/settings.h"
 #include "openmc/simulation.h"
@@ -278,6 +280,8 @@ void print_plot()
 
 void print_overlap_check()
 {
+  reduce_overlap_check_count();
+
 #ifdef OPENMC_MPI
   vector<int64_t> temp(model::overlap_check_count);
   MPI_Reduce(temp.data(), model::overlap_check_count.data(),
@@ -308,6 +312,52 @@ void print_overlap_check()
 
 //==============================================================================
 
+void print_crossing_recovery()
+{
+  int n = model::surfaces.size();
+  vector<int64_t> failures(n);
+  vector<int64_t> recoveries(n);
+  for (int i = 0; i < n; i++) {
+    failures[i] = model::surfaces[i]->n_search_failures_;
+    recoveries[i] = model::surfaces[i]->n_recoveries_;
+  }
+#ifdef OPENMC_MPI
+  MPI_Reduce(mpi::master ? MPI_IN_PLACE : failures.data(), failures.data(), n,
+    MPI_INT64_T, MPI_SUM, 0, mpi::intracomm);
+  MPI_Reduce(mpi::master ? MPI_IN_PLACE : recoveries.data(),
+    recoveries.data(), n, MPI_INT64_T, MPI_SUM, 0, mpi::intracomm);
+#endif
+
+  if (!mpi::master)
+    return;
+
+  // List the surfaces with the most misses first
+  vector<int> order;
+  for (int i = 0; i < n; i++) {
+    if (failures[i] > 0)
+      order.push_back(i);
+  }
+  if (order.empty())
+    return;
+  std::sort(order.begin(), order.end(),
+    [&failures](int i, int j) { return failures[i] > failures[j]; });
+
+  header("surface crossing recovery summary", 1);
+  fmt::print(" Surface ID   Neighbor List Misses   Recovered\n");
+  constexpr int max_surfaces {20};
+  for (int k = 0; k < std::min<int>(order.size(), max_surfaces); k++) {
+    int i = order[k];
+    fmt::print(" {:10} {:22} {:11}\n", model::surfaces[i]->id_, failures[i],
+      recoveries[i]);
+  }
+  if (order.size() > max_surfaces) {
+    fmt::print(
+      " ... {} more surfaces with misses\n", order.size() - max_surfaces);
+  }
+}
+
+//==============================================================================
+
 void print_usage()
 {
   if (mpi::master) {
@@ -400,6 +450,13 @@ void show_rate(const char* label, double particles_per_sec)
   fmt::print(" {:<33} = {:.6} particles/second\n", label, particles_per_sec);
 }
 
+void show_kernel_stats(const char* label, EventKernel kernel)
+{
+  const auto& stats = simulation::event_kernel_stats[static_cast<int>(kernel)];
+  fmt::print("     {:<29} = {:>10} calls, {:>10.4e} particles/call\n", label,
+    stats.n_calls, stats.average());
+}
+
 void print_runtime()
 {
   using namespace simulation;
@@ -421,7 +478,24 @@ void print_runtime()
     show_time("Advancing", time_event_advance_particle.elapsed(), 2);
     show_time("Surface crossings", time_event_surface_crossing.elapsed(), 2);
     show_time("Collisions", time_event_collision.elapsed(), 2);
+    show_time("Tallying", time_event_tally.elapsed(), 2);
+    show_time("Sorting queues", time_event_sort.elapsed(), 2);
     show_time("Particle death", time_event_death.elapsed(), 2);
+    fmt::print("   Event kernel calls\n");
+    show_kernel_stats("Particle initialization", EventKernel::INIT);
+    show_kernel_stats("Fuel XS lookups", EventKernel::CALCULATE_FUEL_XS);
+    show_kernel_stats(
+      "Non-fuel XS lookups", EventKernel::CALCULATE_NONFUEL_XS);
+    show_kernel_stats("Advancing", EventKernel::ADVANCE_PARTICLE);
+    show_kernel_stats("Surface crossings", EventKernel::SURFACE_CROSSING);
+    show_kernel_stats("Collisions", EventKernel::COLLISION);
+    if (settings::event_secondary_queue) {
+      show_kernel_stats(
+        "Secondary initialization", EventKernel::SECONDARY_INIT);
+    }
+  }
+  if (settings::profile) {
+    print_profile();
   }
   if (settings::run_mode == RunMode::EIGENVALUE) {
     show_time("Time in inactive batches", time_inactive.elapsed(), 1);
@@ -534,6 +608,11 @@ void print_results()
     std::tie(mean, stdev) = mean_stdev(&gt(GlobalTally::LEAKAGE, 0), n);
     fmt::print(
       " Leakage Fraction            = {:.5f} +/- {:.5f}\n", mean, t_n1 * stdev);
+    if (simulation::n_res_scat_samples > 0) {
+      fmt::print(" Res. Scattering Acceptance  = {:.5f}\n",
+        static_cast<double>(simulation::n_res_scat_samples) /
+          simulation::n_res_scat_trials);
+    }
   } else {
     if (mpi::master)
       warning("Could not compute uncertainties -- only one "
@@ -549,6 +628,11 @@ void print_results()
     }
     fmt::print(" Leakage Fraction           = {:.5f}\n",
       gt(GlobalTally::LEAKAGE, TallyResult::SUM) / n);
+    if (simulation::n_res_scat_samples > 0) {
+      fmt::print(" Res. Scattering Acceptance = {:.5f}\n",
+        static_cast<double>(simulation::n_res_scat_samples) /
+          simulation::n_res_scat_trials);
+    }
   }
   fmt::print("\n");
   std::fflush(stdout);
@@ -567,6 +651,10 @@ const std::unordered_map<int, const char*> score_names = {
   {SCORE_KAPPA_FISSION, "Kappa-Fission Rate"},
   {SCORE_EVENTS, "Events"},
   {SCORE_DECAY_RATE, "Decay Rate"},
+  {SCORE_PULSE_HEIGHT, "Pulse-Height"},
+  {SCORE_IFP_TIME_NUM, "IFP Generation Time Numerator"},
+  {SCORE_IFP_BETA_NUM, "IFP Delayed Fraction Numerator"},
+  {SCORE_IFP_DENOM, "IFP Denominator"},
   {SCORE_DELAYED_NU_FISSION, "Delayed-Nu-Fission Rate"},
   {SCORE_PROMPT_NU_FISSION, "Prompt-Nu-Fission Rate"},
   {SCORE_INVERSE_VELOCITY, "Flux-Weighted Inverse Velocity"},
@@ -575,6 +663,55 @@ const std::unordered_map<int, const char*> score_names = {
   {SCORE_CURRENT, "Current"},
 };
 
+namespace {
+
+//! Format the results for a contiguous range of filter bin combinations of a
+//! tally. Score and nuclide labels are resolved beforehand so that this can be
+//! called concurrently from several threads.
+
+void write_tally_results(std::ostream& out, const Tally& tally,
+  int64_t i_begin, int64_t i_end, const vector<std::string>& nuclide_names,
+  const vector<std::string>& score_labels, double t_value)
+{
+  for (int64_t filter_index = i_begin; filter_index < i_end; ++filter_index) {
+    // Print info about this combination of filter bins.  The stride check
+    // prevents redundant output.
+    int indent = 0;
+    for (auto i = 0; i < tally.filters().size(); ++i) {
+      if (filter_index % tally.strides(i) == 0) {
+        const auto& filt {*model::tally_filters[tally.filters(i)]};
+        int bin = (filter_index / tally.strides(i)) % filt.n_bins();
+        fmt::print(out, "{0:{1}}{2}\n", "", indent + 1, filt.text_label(bin));
+      }
+      indent += 2;
+    }
+
+    // Loop over all nuclide and score combinations.
+    int score_index = 0;
+    for (const auto& nuclide_name : nuclide_names) {
+      // Write label for this nuclide bin.
+      fmt::print(out, "{0:{1}}{2}\n", "", indent + 1, nuclide_name);
+
+      // Write the score, mean, and uncertainty.
+      indent += 2;
+      for (const auto& score_name : score_labels) {
+        double x[] {
+          tally.result(filter_index, score_index, TallyResult::VALUE),
+          tally.result(filter_index, score_index, TallyResult::SUM),
+          tally.result(filter_index, score_index, TallyResult::SUM_SQ)};
+        double mean, stdev;
+        std::tie(mean, stdev) = mean_stdev(x, tally.n_realizations_);
+        fmt::print(out, "{0:{1}}{2:<36} {3:.6} +/- {4:.6}\n", "", indent + 1,
+          score_name, mean, t_value * stdev);
+        score_index += 1;
+      }
+      indent -= 2;
+    }
+  }
+}
+
+} // namespace
+
 //! Create an ASCII output file showing all tally results.
 
 void write_tallies()
@@ -589,6 +726,18 @@ void write_tallies()
   std::ofstream tallies_out;
   tallies_out.open(filename, std::ios::out | std::ios::trunc);
 
+  // Large tallies are formatted in chunks of filter bin combinations by all
+  // threads. Chunks are written in order one wave at a time so that only a
+  // bounded amount of text is held in memory.
+#ifdef _OPENMP
+  int n_threads = omp_get_max_threads();
+#else
+  int n_threads = 1;
+#endif
+  constexpr int64_t CHUNK_SIZE {1000};
+  int64_t chunks_per_wave = 4 * n_threads;
+  vector<std::string> chunks;
+
   // Loop over each tally.
   for (auto i_tally = 0; i_tally < model::tallies.size(); ++i_tally) {
     const auto& tally {*model::tallies[i_tally]};
@@ -604,6 +753,19 @@ void write_tallies()
       continue;
     }
 
+    // Tallies with more results than the user-specified limit are only
+    // available in the statepoint
+    int64_t n_filter_bins = tally.n_filter_bins();
+    int64_t n_results =
+      n_filter_bins * tally.nuclides_.size() * tally.scores_.size();
+    if (settings::tallies_out_max_bins > 0 &&
+        n_results > settings::tallies_out_max_bins) {
+      fmt::print(tallies_out,
+        " {} results exceed the limit of {}; see the statepoint file\n\n",
+        n_results, settings::tallies_out_max_bins);
+      continue;
+    }
+
     // Calculate t-value for confidence intervals
     double t_value = 1;
     if (settings::confidence_intervals) {
@@ -635,61 +797,47 @@ void write_tallies()
       }
     }
 
-    // Initialize Filter Matches Object
-    vector<FilterMatch> filter_matches;
-    // Allocate space for tally filter matches
-    filter_matches.resize(model::tally_filters.size());
-
-    // Loop over all filter bin combinations.
-    auto filter_iter = FilterBinIter(tally, false, &filter_matches);
-    auto end = FilterBinIter(tally, true, &filter_matches);
-    for (; filter_iter != end; ++filter_iter) {
-      auto filter_index = filter_iter.index_;
-
-      // Print info about this combination of filter bins.  The stride check
-      // prevents redundant output.
-      int indent = 0;
-      for (auto i = 0; i < tally.filters().size(); ++i) {
-        if (filter_index % tally.strides(i) == 0) {
-          auto i_filt = tally.filters(i);
-          const auto& filt {*model::tally_filters[i_filt]};
-          auto& match {filter_matches[i_filt]};
-          fmt::print(tallies_out, "{0:{1}}{2}\n", "", indent + 1,
-            filt.text_label(match.i_bin_));
-        }
-        indent += 2;
+    // Get labels for nuclide and score bins
+    vector<std::string> nuclide_names;
+    for (auto i_nuclide : tally.nuclides_) {
+      if (i_nuclide == -1) {
+        nuclide_names.push_back("Total Material");
+      } else if (settings::run_CE) {
+        nuclide_names.push_back(data::nuclides[i_nuclide]->name_);
+      } else {
+        nuclide_names.push_back(data::mg.nuclides_[i_nuclide].name);
+      }
+    }
+    vector<std::string> score_labels;
+    for (auto score : tally.scores_) {
+      score_labels.push_back(
+        score > 0 ? reaction_name(score) : score_names.at(score));
+    }
+
+    // Small tallies are written directly to the file
+    int64_t n_chunks = (n_filter_bins + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    if (n_threads == 1 || n_chunks <= 1) {
+      write_tally_results(tallies_out, tally, 0, n_filter_bins, nuclide_names,
+        score_labels, t_value);
+      continue;
+    }
+
+    for (int64_t first = 0; first < n_chunks; first += chunks_per_wave) {
+      int64_t n_wave = std::min(chunks_per_wave, n_chunks - first);
+      chunks.resize(n_wave);
+
+#pragma omp parallel for schedule(dynamic)
+      for (int64_t i = 0; i < n_wave; ++i) {
+        int64_t i_begin = (first + i) * CHUNK_SIZE;
+        int64_t i_end = std::min(i_begin + CHUNK_SIZE, n_filter_bins);
+        std::ostringstream out;
+        write_tally_results(
+          out, tally, i_begin, i_end, nuclide_names, score_labels, t_value);
+        chunks[i] = out.str();
       }
 
-      // Loop over all nuclide and score combinations.
-      int score_index = 0;
-      for (auto i_nuclide : tally.nuclides_) {
-        // Write label for this nuclide bin.
-        if (i_nuclide == -1) {
-          fmt::print(tallies_out, "{0:{1}}Total Material\n", "", indent + 1);
-        } else {
-          if (settings::run_CE) {
-            fmt::print(tallies_out, "{0:{1}}{2}\n", "", indent + 1,
-              data::nuclides[i_nuclide]->name_);
-          } else {
-            fmt::print(tallies_out, "{0:{1}}{2}\n", "", indent + 1,
-              data::mg.nuclides_[i_nuclide].name);
-          }
-        }
-
-        // Write the score, mean, and uncertainty.
-        indent += 2;
-        for (auto score : tally.scores_) {
-          std::string score_name =
-            score > 0 ? reaction_name(score) : score_names.at(score);
-          double mean, stdev;
-          std::tie(mean, stdev) =
-            mean_stdev(&tally.results_(filter_index, score_index, 0),
-              tally.n_realizations_);
-          fmt::print(tallies_out, "{0:{1}}{2:<36} {3:.6} +/- {4:.6}\n", "",
-            indent + 1, score_name, mean, t_value * stdev);
-          score_index += 1;
-        }
-        indent -= 2;
+      for (const auto& chunk : chunks) {
+        tallies_out << chunk;
       }
     }
   }
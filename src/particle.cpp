@@ -1,6 +1,6 @@
 #include "openmc/particle.h"
 
-#include <algorithm> // copy, min
+#include <algorithm> // copy, find_if, min
 #include <cmath>     // log, abs
 
 #include <fmt/core.h>
@@ -8,8 +8,11 @@
 #include "openmc/bank.h"
 #include "openmc/capi.h"
 #include "openmc/cell.h"
+#include "openmc/census.h"
+#include "openmc/condensed_history.h"
 #include "openmc/constants.h"
 #include "openmc/dagmc.h"
+#include "openmc/delta_tracking.h"
 #include "openmc/error.h"
 #include "openmc/geometry.h"
 #include "openmc/hdf5_interface.h"
@@ -20,15 +23,18 @@
 #include "openmc/photon.h"
 #include "openmc/physics.h"
 #include "openmc/physics_mg.h"
+#include "openmc/profile.h"
 #include "openmc/random_lcg.h"
 #include "openmc/settings.h"
 #include "openmc/simulation.h"
 #include "openmc/source.h"
 #include "openmc/surface.h"
 #include "openmc/tallies/derivative.h"
+#include "openmc/tallies/flux_spectrum.h"
 #include "openmc/tallies/tally.h"
 #include "openmc/tallies/tally_scoring.h"
 #include "openmc/track_output.h"
+#include "openmc/weight_windows.h"
 
 #ifdef DAGMC
 #include "DagMC.hpp"
@@ -69,6 +75,17 @@ void Particle::create_secondary(
     return;
   }
 
+  // Energy carried away by photons and charged particles is not deposited
+  // where they are born. A positron also carries the rest mass energy that
+  // becomes its annihilation photons.
+  if (!model::active_pulse_height_tallies.empty() &&
+      this->type() != ParticleType::neutron) {
+    double E_carried = E;
+    if (type == ParticleType::positron)
+      E_carried += 2.0 * MASS_ELECTRON_EV;
+    deposit_energy(-E_carried);
+  }
+
   secondary_bank().emplace_back();
 
   auto& bank {secondary_bank().back()};
@@ -86,6 +103,7 @@ void Particle::from_source(const SourceSite* src)
 {
   // Reset some attributes
   clear();
+  distance_cache().clear();
   surface() = 0;
   cell_born() = C_NONE;
   material() = C_NONE;
@@ -116,13 +134,43 @@ void Particle::from_source(const SourceSite* src)
 }
 
 void Particle::event_calculate_xs()
+{
+  ProfileScope profile(ProfileRegion::CALCULATE_XS);
+  if (!this->prepare_calculate_xs())
+    return;
+  DomainScope profile_material(ProfileDomain::MATERIAL, material());
+  count_event(TransportEvent::XS_LOOKUP);
+
+  if (settings::run_CE) {
+    model::materials[material()]->calculate_xs(*this);
+  } else {
+    // Get the MG data; unlike the CE case, we have to re-calculate cross
+    // sections for every collision since the cross sections may be
+    // angle-dependent
+    data::mg.macro_xs(material()).calculate_xs(*this);
+
+    // Update the particle's group while we know we are multi-group
+    g_last() = g();
+  }
+}
+
+bool Particle::prepare_calculate_xs()
 {
   // Set the random number stream
   stream() = STREAM_TRACKING;
 
-  // Store pre-collision particle properties
+  // Store pre-collision particle properties. With condensed history, the
+  // energy lost on steps ending at a boundary is kept until the next collision
+  // so that it is deposited there.
+  bool crossed =
+    event() == TallyEvent::SURFACE || event() == TallyEvent::LATTICE;
+  bool keep_E_last =
+    settings::electron_treatment == ElectronTreatment::CH &&
+    (type() == ParticleType::electron || type() == ParticleType::positron) &&
+    crossed;
   wgt_last() = wgt();
-  E_last() = E();
+  if (!keep_E_last)
+    E_last() = E();
   u_last() = u();
   r_last() = r();
   time_last() = time();
@@ -139,8 +187,10 @@ void Particle::event_calculate_xs()
     if (!exhaustive_find_cell(*this)) {
       mark_as_lost(
         "Could not find the cell containing particle " + std::to_string(id()));
-      return;
+      return false;
     }
+    // Overlaps can be checked as after a crossing since the cell is new
+    crossed = true;
 
     // Set birth cell attribute
     if (cell_born() == C_NONE)
@@ -151,42 +201,68 @@ void Particle::event_calculate_xs()
   if (write_track())
     write_particle_track(*this);
 
-  if (settings::check_overlaps)
+  if (settings::check_overlaps && sample_overlap_check(*this, crossed))
     check_cell_overlap(*this);
 
-  // Calculate microscopic and macroscopic cross sections
-  if (material() != MATERIAL_VOID) {
-    if (settings::run_CE) {
-      if (material() != material_last() || sqrtkT() != sqrtkT_last()) {
-        // If the material is the same as the last material and the
-        // temperature hasn't changed, we don't need to lookup cross
-        // sections again.
-        model::materials[material()]->calculate_xs(*this);
-      }
-    } else {
-      // Get the MG data; unlike the CE case above, we have to re-calculate
-      // cross sections for every collision since the cross sections may
-      // be angle-dependent
-      data::mg.macro_xs_[material()].calculate_xs(*this);
-
-      // Update the particle's group while we know we are multi-group
-      g_last() = g();
-    }
-  } else {
+  // Determine whether microscopic and macroscopic cross sections need to be
+  // calculated
+  if (material() == MATERIAL_VOID) {
     macro_xs().total = 0.0;
     macro_xs().absorption = 0.0;
     macro_xs().fission = 0.0;
     macro_xs().nu_fission = 0.0;
+    return false;
+  }
+
+  // If the material is the same as the last material and the temperature
+  // hasn't changed, we don't need to lookup cross sections again.
+  return !settings::run_CE || material() != material_last() ||
+         sqrtkT() != sqrtkT_last();
+}
+
+void Particle::move(double distance)
+{
+  for (int j = 0; j < n_coord(); ++j) {
+    coord(j).r += distance * coord(j).u;
+    if (settings::lattice_dda) {
+      for (auto& d : coord(j).lattice_dist)
+        d -= distance;
+    }
   }
+  this->time() += distance / this->speed();
 }
 
+void Particle::slow_down()
+{
+  if ((type() == ParticleType::electron || type() == ParticleType::positron) &&
+      settings::electron_treatment == ElectronTreatment::CH)
+    continuous_slowing_down(*this, this->track_distance());
+}
+
+template<unsigned Features>
 void Particle::event_advance()
 {
-  // Find the distance to the nearest boundary
-  boundary() = distance_to_boundary(*this);
+  // Determine whether this step is delta tracked through a universe
+  int delta_level = (Features & FEATURE_DELTA_TRACKING)
+                      ? delta_tracking_level(*this)
+                      : C_NONE;
+  delta_tracked() = delta_level != C_NONE;
+
+  // Find the distance to the nearest boundary, which for a delta-tracked step
+  // is the boundary of the delta-tracked universe
+  boundary() = distance_to_boundary(*this, delta_level);
 
   // Sample a distance to collision
-  if (type() == ParticleType::electron || type() == ParticleType::positron) {
+  bool charged =
+    type() == ParticleType::electron || type() == ParticleType::positron;
+  bool condensed =
+    charged && settings::electron_treatment == ElectronTreatment::CH;
+  if ((Features & FEATURE_DELTA_TRACKING) && delta_tracked()) {
+    // Sampled from the majorant by delta_track() below
+    collision_distance() = INFINITY;
+  } else if (condensed) {
+    collision_distance() = condensed_history_step(*this);
+  } else if (charged) {
     collision_distance() = 0.0;
   } else if (macro_xs().total == 0.0) {
     collision_distance() = INFINITY;
@@ -194,20 +270,62 @@ void Particle::event_advance()
     collision_distance() = -std::log(prn(current_seed())) / macro_xs().total;
   }
 
-  // Select smaller of the two distances
-  double distance = std::min(boundary().distance, collision_distance());
+  // Stop just past the next bin boundary of the weight window meshes so that
+  // the weight windows can be applied there
+  if ((Features & FEATURE_WEIGHT_WINDOWS) && settings::weight_windows_on &&
+      settings::weight_window_mesh_crossings) {
+    double d = distance_to_weight_window_boundary(*this) + TINY_BIT;
+    if (d < boundary().distance) {
+      boundary().distance = d;
+      boundary().weight_window = true;
+    }
+  }
 
-  // Advance particle in space and time
-  for (int j = 0; j < n_coord(); ++j) {
-    coord(j).r += distance * coord(j).u;
+  // Stop at the end of the time window so that the particle can be banked for
+  // the next one
+  if ((Features & FEATURE_CENSUS) && !settings::census_times.empty()) {
+    double d = std::max(0.0, (census_time() - time()) * speed());
+    if (d < boundary().distance) {
+      boundary().distance = d;
+      boundary().weight_window = false;
+      boundary().census = true;
+    }
   }
-  this->time() += distance / this->speed();
+
+  if ((Features & FEATURE_DELTA_TRACKING) && delta_tracked()) {
+    delta_track(*this, delta_level);
+    return;
+  }
+
+  // Select smaller of the two distances
+  double distance = this->track_distance();
+
+  // Advance particle in space and time. Charged particles with condensed
+  // history lose energy along the step at the event that ends it, once the
+  // step has been scored at the energy it started with.
+  move(distance);
+}
+
+template<unsigned Features>
+void Particle::event_tally_advance()
+{
+  // Delta-tracked steps have no track-length estimate; they are scored at
+  // their collisions instead
+  if ((Features & FEATURE_DELTA_TRACKING) && delta_tracked())
+    return;
+
+  double distance = this->track_distance();
 
   // Score track-length tallies
   if (!model::active_tracklength_tallies.empty()) {
     score_tracklength_tally(*this, distance);
   }
 
+  // Score the fine-group flux spectrum used to collapse depletion rates
+  if (model::flux_spectrum.active() && type() == ParticleType::neutron) {
+    model::flux_spectrum.score(material(), E(), wgt() * distance);
+  }
+
   // Score track-length estimate of k-eff
   if (settings::run_mode == RunMode::EIGENVALUE &&
       type() == ParticleType::neutron) {
@@ -215,13 +333,34 @@ void Particle::event_advance()
   }
 
   // Score flux derivative accumulators for differential tallies.
-  if (!model::active_tallies.empty()) {
+  if ((Features & FEATURE_DERIVATIVES) && !model::active_tallies.empty()) {
     score_track_derivative(*this, distance);
   }
 }
 
 void Particle::event_cross_surface()
 {
+  // Charged particles lose energy continuously along the step
+  slow_down();
+
+  // The history is continued in the next time window
+  if (boundary().census) {
+    bank_census_particle(*this);
+    return;
+  }
+
+  // The particle stays in the same cell at a weight window mesh boundary
+  if (boundary().weight_window) {
+    // Score mesh surface currents with the weight before it is changed, like at
+    // a collision
+    if (!model::active_meshsurf_tallies.empty()) {
+      score_surface_tally(*this, model::active_meshsurf_tallies);
+    }
+    r_last_current() = r();
+    apply_weight_windows(*this);
+    return;
+  }
+
   // Set surface that particle is on and adjust coordinate levels
   surface() = boundary().surface_index;
   n_coord() = boundary().coord_level;
@@ -238,9 +377,11 @@ void Particle::event_cross_surface()
     // Particle crosses lattice boundary
     cross_lattice(*this, boundary());
     event() = TallyEvent::LATTICE;
+    count_event(TransportEvent::LATTICE_CROSSING);
   } else {
     // Particle crosses surface
     cross_surface();
+    count_event(TransportEvent::SURFACE_CROSSING);
     event() = TallyEvent::SURFACE;
   }
   // Score cell to cell partial currents
@@ -251,6 +392,13 @@ void Particle::event_cross_surface()
 
 void Particle::event_collide()
 {
+  ProfileScope profile(ProfileRegion::COLLISION);
+  DomainScope profile_material(ProfileDomain::MATERIAL, material());
+  count_event(TransportEvent::COLLISION);
+
+  // Charged particles lose energy continuously along the step
+  slow_down();
+
   // Score collision estimate of keff
   if (settings::run_mode == RunMode::EIGENVALUE &&
       type() == ParticleType::neutron) {
@@ -268,11 +416,37 @@ void Particle::event_collide()
   surface() = 0;
 
   if (settings::run_CE) {
+    // Tabulated macroscopic cross sections don't update the microscopic cross
+    // sections. Sampling the collision calculates those it needs, but
+    // collision estimators score every nuclide at the pre-collision energy.
+    if (type() == ParticleType::neutron &&
+        !model::active_collision_tallies.empty() &&
+        model::materials[material()]->tabulate_xs_) {
+      const auto& mat {model::materials[material()]};
+      for (int i = 0; i < mat->nuclide_.size(); ++i) {
+        mat->calculate_nuclide_xs(*this, i);
+      }
+    }
     collision(*this);
+
+    // Deposit the energy lost by photons and charged particles for
+    // pulse-height tallies, including the rest mass energy of a positron that
+    // annihilated
+    if (!model::active_pulse_height_tallies.empty() &&
+        type() != ParticleType::neutron) {
+      double E_deposited = E_last() - (alive() ? E() : 0.0);
+      if (!alive() && type() == ParticleType::positron)
+        E_deposited += 2.0 * MASS_ELECTRON_EV;
+      deposit_energy(E_deposited);
+    }
   } else {
     collision_mg(*this);
   }
+}
 
+template<unsigned Features>
+void Particle::event_tally_collision()
+{
   // Score collision estimator tallies -- this is done after a collision
   // has occurred rather than before because we need information on the
   // outgoing energy for any tallies with an outgoing energy filter
@@ -317,7 +491,7 @@ void Particle::event_collide()
   }
 
   // Score flux derivative accumulators for differential tallies.
-  if (!model::active_tallies.empty())
+  if ((Features & FEATURE_DERIVATIVES) && !model::active_tallies.empty())
     score_collision_derivative(*this);
 
 #ifdef DAGMC
@@ -325,6 +499,7 @@ void Particle::event_collide()
 #endif
 }
 
+template<unsigned Features>
 void Particle::event_revive_from_secondary()
 {
   // If particle has too many events, display warning and kill it
@@ -338,7 +513,7 @@ void Particle::event_revive_from_secondary()
   // Check for secondary particles if this particle is dead
   if (!alive()) {
     // Write final position for this particle
-    if (write_track()) {
+    if ((Features & FEATURE_TRACKS) && write_track()) {
       write_particle_track(*this);
     }
 
@@ -351,11 +526,12 @@ void Particle::event_revive_from_secondary()
     n_event() = 0;
 
     // Enter new particle in particle track file
-    if (write_track())
+    if ((Features & FEATURE_TRACKS) && write_track())
       add_particle_track(*this);
   }
 }
 
+template<unsigned Features>
 void Particle::event_death()
 {
 #ifdef DAGMC
@@ -363,7 +539,7 @@ void Particle::event_death()
 #endif
 
   // Finish particle track output.
-  if (write_track()) {
+  if ((Features & FEATURE_TRACKS) && write_track()) {
     finalize_particle_track(*this);
   }
 
@@ -383,6 +559,12 @@ void Particle::event_death()
   keff_tally_tracklength() = 0.0;
   keff_tally_leakage() = 0.0;
 
+  // Score the energy deposited by the history and its secondaries
+  if (!energy_deposits().empty()) {
+    score_pulse_height_tally(*this);
+    energy_deposits().clear();
+  }
+
   // Record the number of progeny created by this particle.
   // This data will be used to efficiently sort the fission bank.
   if (settings::run_mode == RunMode::EIGENVALUE) {
@@ -391,6 +573,43 @@ void Particle::event_death()
   }
 }
 
+// Feature sets that the history-based transport loop is instantiated for; see
+// select_transport_features() in simulation.cpp
+#define INSTANTIATE_EVENTS(FEATURES)                                          \
+  template void Particle::event_advance<FEATURES>();                          \
+  template void Particle::event_tally_advance<FEATURES>();                    \
+  template void Particle::event_tally_collision<FEATURES>();                  \
+  template void Particle::event_revive_from_secondary<FEATURES>();            \
+  template void Particle::event_death<FEATURES>();
+
+INSTANTIATE_EVENTS(0)
+INSTANTIATE_EVENTS(FEATURE_DELTA_TRACKING)
+INSTANTIATE_EVENTS(FEATURE_WEIGHT_WINDOWS)
+INSTANTIATE_EVENTS(FEATURE_TRACKS)
+INSTANTIATE_EVENTS(FEATURE_ALL)
+
+#undef INSTANTIATE_EVENTS
+
+void Particle::deposit_energy(double E)
+{
+  for (int j = 0; j < n_coord(); ++j) {
+    int i_cell = coord(j).cell;
+    if (!model::pulse_height_cells[i_cell])
+      continue;
+
+    // A history deposits energy in few cells, so the deposits are kept in a
+    // short list rather than indexed by cell
+    auto& deposits = energy_deposits();
+    auto it = std::find_if(deposits.begin(), deposits.end(),
+      [i_cell](const EnergyDeposit& d) { return d.cell == i_cell; });
+    if (it != deposits.end()) {
+      it->E += E;
+    } else {
+      deposits.push_back({i_cell, E});
+    }
+  }
+}
+
 void Particle::cross_surface()
 {
   int i_surface = std::abs(surface());
@@ -412,7 +631,11 @@ void Particle::cross_surface()
     site.particle = type();
     site.parent_id = id();
     site.progeny_id = n_progeny();
-    int64_t idx = simulation::surf_source_bank.thread_safe_append(site);
+    if (settings::surf_source_stream) {
+      bank_surf_source_site(site);
+    } else {
+      int64_t idx = simulation::surf_source_bank.thread_safe_append(site);
+    }
   }
 
 // if we're crossing a CSG surface, make sure the DAG history is reset
@@ -445,9 +668,11 @@ void Particle::cross_surface()
     sqrtkT_last() = sqrtkT();
     // set new cell value
     coord(n_coord() - 1).cell = i_cell;
+    ++geometry_state();
     cell_instance() = 0;
     material() = model::cells[i_cell]->material_[0];
     sqrtkT() = model::cells[i_cell]->sqrtkT_[0];
+    i_sqrtkT() = model::cells[i_cell]->i_sqrtkT_[0];
     return;
   }
 #endif
@@ -564,8 +789,8 @@ void Particle::cross_reflective_bc(const Surface& surf, Direction new_u)
   }
 }
 
-void Particle::cross_periodic_bc(
-  const Surface& surf, Position new_r, Direction new_u, int new_surface)
+void Particle::cross_periodic_bc(const Surface& surf, Position new_r,
+  Direction new_u, int new_surface, NeighborList& partners)
 {
   // Do not handle periodic boundary conditions on lower universes
   if (n_coord() != 1) {
@@ -593,10 +818,11 @@ void Particle::cross_periodic_bc(
   // Reassign particle's surface
   surface() = new_surface;
 
-  // Figure out what cell particle is in now
+  // Figure out what cell particle is in now. It is almost always one of the
+  // cells next to the partner surface.
   n_coord() = 1;
 
-  if (!neighbor_list_find_cell(*this)) {
+  if (!neighbor_list_find_cell(*this, partners)) {
     mark_as_lost("Couldn't find particle after hitting periodic "
                  "boundary on surface " +
                  std::to_string(surf.id_) +
@@ -624,6 +850,7 @@ void Particle::mark_as_lost(const char* message)
   wgt() = 0.0;
 #pragma omp atomic
   simulation::n_lost_particles += 1;
+  count_event(TransportEvent::LOST_PARTICLE);
 
   // Count the total number of simulated particles (on this processor)
   auto n = simulation::current_batch * settings::gen_per_batch *
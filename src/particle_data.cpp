@@ -1,11 +1,18 @@
 #include "openmc/particle_data.h"
 
+#include <algorithm> // for max
+#include <cstdint>   // for uintptr_t
+#include <new>       // for operator new
+#include <unordered_set>
+
 #include "openmc/cell.h"
+#include "openmc/error.h"
 #include "openmc/geometry.h"
 #include "openmc/material.h"
 #include "openmc/nuclide.h"
 #include "openmc/photon.h"
 #include "openmc/settings.h"
+#include "openmc/simulation.h"
 #include "openmc/tallies/derivative.h"
 #include "openmc/tallies/filter.h"
 #include "openmc/tallies/tally.h"
@@ -28,8 +35,85 @@ void LocalCoord::reset()
   lattice_i[1] = 0;
   lattice_i[2] = 0;
   rotated = false;
+  lattice_u = {0.0, 0.0, 0.0};
+  instance_cell = C_NONE;
+}
+
+#ifdef OPENMC_PARTICLE_SOA
+//==============================================================================
+// ParticleSoA implementation
+//==============================================================================
+
+ParticleSoA::Block* ParticleSoA::blocks_[ParticleSoA::MAX_BLOCKS];
+
+namespace {
+
+// Slots that have been released and the number of slots ever claimed. These
+// are never destroyed so that particles with static storage duration can still
+// release their slots at exit.
+vector<int64_t>& free_slots()
+{
+  static auto* slots = new vector<int64_t>;
+  return *slots;
+}
+
+int64_t n_slots {0};
+
+} // namespace
+
+int64_t ParticleSoA::acquire()
+{
+  int64_t slot;
+#pragma omp critical(particle_soa)
+  {
+    auto& free = free_slots();
+    if (!free.empty()) {
+      slot = free.back();
+      free.pop_back();
+    } else {
+      slot = n_slots++;
+      int i_block = slot >> BLOCK_BITS;
+      if (i_block >= MAX_BLOCKS) {
+        fatal_error("Too many particles exist at once for the particle data "
+                    "storage.");
+      }
+
+      // Blocks are kept until exit. The storage is over-allocated so that the
+      // block can be aligned to a cache line.
+      if (!blocks_[i_block]) {
+        constexpr size_t align = alignof(Block);
+        char* p = static_cast<char*>(::operator new(sizeof(Block) + align));
+        p += align - reinterpret_cast<uintptr_t>(p) % align;
+        blocks_[i_block] = new (p) Block;
+      }
+    }
+  }
+
+  // Default values matching those of ParticleData without slots
+  E(slot) = 0.0;
+  wgt(slot) = 1.0;
+  sqrtkT(slot) = -1.0;
+  material(slot) = -1;
+  macro_xs(slot) = {};
+  return slot;
+}
+
+void ParticleSoA::release(int64_t slot)
+{
+#pragma omp critical(particle_soa)
+  free_slots().push_back(slot);
 }
 
+void ParticleSoA::copy(int64_t from, int64_t to)
+{
+  E(to) = E(from);
+  wgt(to) = wgt(from);
+  sqrtkT(to) = sqrtkT(from);
+  material(to) = material(from);
+  macro_xs(to) = macro_xs(from);
+}
+#endif
+
 ParticleData::ParticleData()
 {
   // Create and clear coordinate levels
@@ -47,14 +131,105 @@ ParticleData::ParticleData()
     zero_flux_derivs();
   }
 
-  // Allocate space for tally filter matches
-  filter_matches_.resize(model::tally_filters.size());
+  // Allocate space for tally filter matches only if tallies can be scored,
+  // which keeps particles used without tallies small
+  if (!model::active_tallies.empty() || settings::event_based) {
+    filter_matches_.resize(model::tally_filters.size());
+  }
 
-  // Create microscopic cross section caches
-  neutron_xs_.resize(data::nuclides.size());
+  // Create microscopic cross section caches. The compact neutron cache only
+  // holds the nuclides that can be looked up within a single material.
+  if (settings::compact_micro_xs && simulation::n_micro_xs_compact > 0) {
+    neutron_xs_.resize(simulation::n_micro_xs_compact);
+    neutron_xs_nuclide_.resize(simulation::n_micro_xs_compact, C_NONE);
+  } else {
+    neutron_xs_.resize(data::nuclides.size());
+  }
   photon_xs_.resize(data::elements.size());
 }
 
+size_t ParticleData::memory_usage() const
+{
+  size_t bytes = sizeof(ParticleData) +
+                 sizeof(LocalCoord) * coord_.capacity() +
+                 sizeof(int) * cell_last_.capacity() +
+                 sizeof(NuclideMicroXS) * neutron_xs_.capacity() +
+                 sizeof(int) * neutron_xs_nuclide_.capacity() +
+                 sizeof(ElementMicroXS) * photon_xs_.capacity() +
+                 sizeof(double) * (xs_cdf_.capacity() + flux_derivs_.capacity()) +
+                 sizeof(SourceSite) * secondary_bank_.capacity() +
+                 sizeof(NuBank) * nu_bank_.capacity() +
+                 sizeof(EnergyDeposit) * energy_deposits_.capacity();
+  for (const auto& match : filter_matches_) {
+    bytes += sizeof(FilterMatch) + sizeof(int) * match.bins_.capacity() +
+             sizeof(double) * match.weights_.capacity();
+  }
+  return bytes;
+}
+
+int ParticleData::neutron_xs_slot(int i_nuclide)
+{
+  // Open addressing with linear probing. The cache is sized to be at most half
+  // full, so probe sequences are short.
+  int mask = neutron_xs_nuclide_.size() - 1;
+  int slot = i_nuclide & mask;
+  for (int n = 0; n <= mask; ++n) {
+    if (neutron_xs_nuclide_[slot] == i_nuclide) {
+      return slot;
+    } else if (neutron_xs_nuclide_[slot] == C_NONE) {
+      neutron_xs_nuclide_[slot] = i_nuclide;
+      neutron_xs_[slot] = NuclideMicroXS {};
+      return slot;
+    }
+    slot = (slot + 1) & mask;
+  }
+  fatal_error("Compact microscopic cross section cache is full.");
+}
+
+const NuclideMicroXS& ParticleData::find_neutron_xs(int i_nuclide) const
+{
+  static const NuclideMicroXS empty {};
+  int mask = neutron_xs_nuclide_.size() - 1;
+  int slot = i_nuclide & mask;
+  for (int n = 0; n <= mask; ++n) {
+    if (neutron_xs_nuclide_[slot] == i_nuclide) {
+      return neutron_xs_[slot];
+    } else if (neutron_xs_nuclide_[slot] == C_NONE) {
+      break;
+    }
+    slot = (slot + 1) & mask;
+  }
+  return empty;
+}
+
+int compact_micro_xs_size()
+{
+  // Nuclides that can be looked up while in one material are those in the
+  // material itself along with any that are tallied or differentiated
+  std::unordered_set<int> tallied;
+  for (const auto& t : model::tallies) {
+    for (int i_nuclide : t->nuclides_) {
+      if (i_nuclide >= 0)
+        tallied.insert(i_nuclide);
+    }
+  }
+  for (const auto& deriv : model::tally_derivs) {
+    if (deriv.variable == DerivativeVariable::NUCLIDE_DENSITY)
+      tallied.insert(deriv.diff_nuclide);
+  }
+  size_t n_max = 0;
+  for (const auto& mat : model::materials) {
+    n_max = std::max(n_max, mat->nuclide_.size());
+  }
+
+  // Keep the cache at most half full. If it would be no smaller than the full
+  // cache, the full cache is used instead.
+  size_t n = 1;
+  while (n < 2 * (n_max + tallied.size()))
+    n *= 2;
+  return (n < data::nuclides.size()) ? n : 0;
+}
+
 TrackState ParticleData::get_track_state() const
 {
   TrackState state;
@@ -71,4 +246,34 @@ TrackState ParticleData::get_track_state() const
   return state;
 }
 
+//==============================================================================
+// CompactSourceSite implementation
+//==============================================================================
+
+CompactSourceSite::CompactSourceSite(const SourceSite& site)
+  : r {site.r}, E {site.E}, time {site.time}, wgt {site.wgt},
+    parent_id {site.parent_id}, progeny_id {site.progeny_id},
+    u {static_cast<float>(site.u.x), static_cast<float>(site.u.y),
+      static_cast<float>(site.u.z)},
+    surf_id {site.surf_id}, particle {static_cast<int16_t>(site.particle)},
+    delayed_group {static_cast<int16_t>(site.delayed_group)}
+{}
+
+SourceSite CompactSourceSite::expand() const
+{
+  SourceSite site;
+  site.r = r;
+  site.u = {u[0], u[1], u[2]};
+  site.u /= site.u.norm();
+  site.E = E;
+  site.time = time;
+  site.wgt = wgt;
+  site.delayed_group = delayed_group;
+  site.surf_id = surf_id;
+  site.particle = static_cast<ParticleType>(particle);
+  site.parent_id = parent_id;
+  site.progeny_id = progeny_id;
+  return site;
+}
+
 } // namespace openmc
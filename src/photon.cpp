@@ -19,6 +19,7 @@
 #include "xtensor/xslice.hpp"
 #include "xtensor/xview.hpp"
 
+#include <algorithm> // for max, min, sort, unique
 #include <cmath>
 #include <fmt/core.h>
 #include <tuple> // for tie
@@ -26,6 +27,8 @@
 namespace openmc {
 
 constexpr int PhotonInteraction::MAX_STACK_SIZE;
+constexpr int ScatteringTable::N_LEVELS;
+constexpr int ScatteringTable::N_ALPHA;
 
 //==============================================================================
 // Global variables
@@ -40,6 +43,84 @@ vector<unique_ptr<PhotonInteraction>> elements;
 
 } // namespace data
 
+//==============================================================================
+// ScatteringTable implementation
+//==============================================================================
+
+void ScatteringTable::build(double alpha_min, double alpha_max,
+  const std::function<double(double, double, double)>& integral)
+{
+  // Values of v at which the distribution is integrated, spaced
+  // logarithmically to resolve the forward peak of coherent scattering at
+  // high energies and uniformly elsewhere
+  constexpr int n_log {360};
+  constexpr int n_linear {200};
+  vector<double> v;
+  v.push_back(0.0);
+  for (int i = 0; i < n_log; ++i) {
+    v.push_back(std::pow(10.0, -18.0 + 18.0 * i / n_log));
+  }
+  for (int i = 1; i <= n_linear; ++i) {
+    v.push_back(static_cast<double>(i) / n_linear);
+  }
+  std::sort(v.begin(), v.end());
+  v.erase(std::unique(v.begin(), v.end()), v.end());
+  int n_v = v.size();
+
+  log_alpha_min_ = std::log(alpha_min);
+  double spacing =
+    std::max(std::log(alpha_max) - log_alpha_min_, 1.0e-6) / (N_ALPHA - 1);
+  inv_spacing_ = 1.0 / spacing;
+
+  v_.resize(N_ALPHA * N_LEVELS);
+  vector<double> cdf(n_v);
+  for (int i = 0; i < N_ALPHA; ++i) {
+    double alpha = std::exp(log_alpha_min_ + i * spacing);
+    cdf[0] = 0.0;
+    for (int j = 0; j < n_v - 1; ++j) {
+      cdf[j + 1] = cdf[j] + std::max(integral(alpha, v[j], v[j + 1]), 0.0);
+    }
+
+    // Invert the cumulative distribution at equally spaced probabilities,
+    // interpolating linearly between the values of v it was integrated at
+    double* row = &v_[i * N_LEVELS];
+    double total = cdf.back();
+    int j = 0;
+    for (int l = 0; l < N_LEVELS; ++l) {
+      if (total <= 0.0) {
+        row[l] = static_cast<double>(l) / (N_LEVELS - 1);
+        continue;
+      }
+      double c = total * l / (N_LEVELS - 1);
+      while (j < n_v - 2 && cdf[j + 1] < c)
+        ++j;
+      double dc = cdf[j + 1] - cdf[j];
+      double f = dc > 0.0 ? std::min(std::max((c - cdf[j]) / dc, 0.0), 1.0)
+                          : 0.0;
+      row[l] = v[j] + f * (v[j + 1] - v[j]);
+    }
+  }
+}
+
+double ScatteringTable::sample(double alpha, uint64_t* seed) const
+{
+  // Find the grid energies around the photon energy
+  double x = (std::log(alpha) - log_alpha_min_) * inv_spacing_;
+  x = std::min(std::max(x, 0.0), N_ALPHA - 1.0);
+  int i = std::min(static_cast<int>(x), N_ALPHA - 2);
+  double f = x - i;
+
+  // Interpolate between the values of v at the same probability at each
+  double y = prn(seed) * (N_LEVELS - 1);
+  int l = std::min(static_cast<int>(y), N_LEVELS - 2);
+  double g = y - l;
+  const double* lower = &v_[i * N_LEVELS + l];
+  const double* upper = lower + N_LEVELS;
+  double v = (1.0 - f) * (lower[0] + g * (lower[1] - lower[0])) +
+             f * (upper[0] + g * (upper[1] - upper[0]));
+  return std::max(1.0 - 2.0 * v, -1.0);
+}
+
 //==============================================================================
 // PhotonInteraction implementation
 //==============================================================================
@@ -192,6 +273,15 @@ PhotonInteraction::PhotonInteraction(hid_t group)
           transition.energy = matrix(j, 2);
           transition.probability = matrix(j, 3) / norm;
         }
+
+        // Create a guide table for sampling transitions
+        double c = 0.0;
+        for (const auto& transition : shell.transitions) {
+          c += transition.probability;
+          shell.transition_cdf.push_back(c);
+        }
+        shell.transition_guide = guide_table(shell.transition_cdf.begin(),
+          shell.transition_cdf.end(), n_transition);
       }
     }
     close_group(tgroup);
@@ -207,6 +297,13 @@ PhotonInteraction::PhotonInteraction(hid_t group)
       max_size, MAX_STACK_SIZE));
   }
 
+  // Find the subshells whose vacancy cascades only emit particles that are
+  // killed by the energy cutoffs
+  vector<bool> visited(shells_.size(), false);
+  for (int i_shell = 0; i_shell < shells_.size(); ++i_shell) {
+    this->calc_below_cutoff(visited, i_shell);
+  }
+
   // Determine number of electron shells
   rgroup = open_group(group, "compton_profiles");
 
@@ -238,10 +335,37 @@ PhotonInteraction::PhotonInteraction(hid_t group)
     }
   }
 
+  // Create guide tables for sampling a shell and a momentum on its profile.
+  // The cumulative sums of the shell PDF are accumulated in the same order as
+  // when sampling, so guided searches find the same shell.
+  double c = 0.0;
+  for (auto p : electron_pdf_) {
+    c += p;
+    electron_cdf_.push_back(c);
+  }
+  electron_guide_ = guide_table(
+    electron_cdf_.begin(), electron_cdf_.end(), electron_cdf_.size());
+
+  // Entry g of a profile guide table is the interval of the CDF containing
+  // g / n_profile of its total, found as by lower_bound_index()
+  profile_guide_.resize(n_shell);
+  for (int i = 0; i < n_shell; ++i) {
+    double c_end = profile_cdf_(i, n_profile - 1);
+    auto& guide = profile_guide_[i];
+    guide.resize(n_profile);
+    int j = 0;
+    for (int g = 0; g < n_profile; ++g) {
+      double value = c_end * g / n_profile;
+      while (j + 1 < n_profile && profile_cdf_(i, j + 1) < value)
+        ++j;
+      guide[g] = j;
+    }
+  }
+
   // Calculate total pair production
   pair_production_total_ = pair_production_nuclear_ + pair_production_electron_;
 
-  if (settings::electron_treatment == ElectronTreatment::TTB) {
+  if (settings::electron_treatment != ElectronTreatment::LED) {
     // Read bremsstrahlung scaled DCS
     rgroup = open_group(group, "bremsstrahlung");
     read_dataset(rgroup, "dcs", dcs_);
@@ -327,6 +451,45 @@ PhotonInteraction::PhotonInteraction(hid_t group)
   pair_production_total_ = xt::where(
     pair_production_total_ > 0.0, xt::log(pair_production_total_), -500.0);
   heating_ = xt::where(heating_ > 0.0, xt::log(heating_), -500.0);
+
+  if (settings::photon_scattering_tables)
+    this->build_scattering_tables();
+}
+
+void PhotonInteraction::build_scattering_tables()
+{
+  // Photons are only transported above the energy cutoff
+  int photon = static_cast<int>(ParticleType::photon);
+  double E_min =
+    std::max(std::exp(energy_(0)), settings::energy_cutoff[photon]);
+  double E_max = std::exp(energy_(energy_.size() - 1));
+  double alpha_min = E_min / MASS_ELECTRON_EV;
+  double alpha_max = std::max(E_max, E_min) / MASS_ELECTRON_EV;
+
+  // For coherent scattering, v = x^2/x^2_max is distributed as the derivative
+  // of the integrated form factor F(x^2) times the Thomson factor (1 + mu^2)/2
+  coherent_table_.build(
+    alpha_min, alpha_max, [this](double alpha, double v0, double v1) {
+      double x2_max = std::pow(MASS_ELECTRON_EV / PLANCK_C * alpha, 2);
+      double mu = 1.0 - (v0 + v1);
+      return (coherent_int_form_factor_(v1 * x2_max) -
+               coherent_int_form_factor_(v0 * x2_max)) *
+             0.5 * (1.0 + mu * mu);
+    });
+
+  // For incoherent scattering, the Klein-Nishina cross section is multiplied
+  // by the incoherent form factor S(x), which is otherwise applied by rejection
+  auto pdf = [this](double alpha, double v) {
+    double mu = 1.0 - 2.0 * v;
+    double ratio = 1.0 / (1.0 + 2.0 * alpha * v);
+    double kn = ratio * ratio * (ratio + 1.0 / ratio - 1.0 + mu * mu);
+    double x = MASS_ELECTRON_EV / PLANCK_C * alpha * std::sqrt(v);
+    return kn * incoherent_form_factor_(x);
+  };
+  incoherent_table_.build(
+    alpha_min, alpha_max, [&pdf](double alpha, double v0, double v1) {
+      return 0.5 * (pdf(alpha, v0) + pdf(alpha, v1)) * (v1 - v0);
+    });
 }
 
 PhotonInteraction::~PhotonInteraction()
@@ -382,39 +545,78 @@ int PhotonInteraction::calc_helper(
   return max_size;
 }
 
-void PhotonInteraction::compton_scatter(double alpha, bool doppler,
-  double* alpha_out, double* mu, int* i_shell, uint64_t* seed) const
+bool PhotonInteraction::calc_below_cutoff(vector<bool>& visited, int i_shell)
 {
-  double form_factor_xmax = 0.0;
-  while (true) {
-    // Sample Klein-Nishina distribution for trial energy and angle
-    std::tie(*alpha_out, *mu) = klein_nishina(alpha, seed);
-
-    // Note that the parameter used here does not correspond exactly to the
-    // momentum transfer q in ENDF-102 Eq. (27.2). Rather, this is the
-    // parameter as defined by Hubbell, where the actual data comes from
-    double x =
-      MASS_ELECTRON_EV / PLANCK_C * alpha * std::sqrt(0.5 * (1.0 - *mu));
-
-    // Calculate S(x, Z) and S(x_max, Z)
-    double form_factor_x = incoherent_form_factor_(x);
-    if (form_factor_xmax == 0.0) {
-      form_factor_xmax =
-        incoherent_form_factor_(MASS_ELECTRON_EV / PLANCK_C * alpha);
+  auto& shell {shells_[i_shell]};
+  if (visited[i_shell]) {
+    return shell.below_cutoff;
+  }
+  visited[i_shell] = true;
+
+  // Without transitions, a fluorescent photon is emitted at the binding energy
+  int photon = static_cast<int>(ParticleType::photon);
+  int electron = static_cast<int>(ParticleType::electron);
+  if (shell.transitions.empty()) {
+    shell.below_cutoff = shell.binding_energy < settings::energy_cutoff[photon];
+    return shell.below_cutoff;
+  }
+
+  // Otherwise the particle emitted by each transition and the cascades from
+  // the vacancies it leaves must all be below the cutoffs
+  for (const auto& transition : shell.transitions) {
+    bool auger = (transition.secondary_subshell != -1);
+    int type = auger ? electron : photon;
+    if (transition.energy >= settings::energy_cutoff[type] ||
+        !this->calc_below_cutoff(visited, transition.primary_subshell) ||
+        (auger &&
+          !this->calc_below_cutoff(visited, transition.secondary_subshell))) {
+      return false;
     }
+  }
+  shell.below_cutoff = true;
+  return true;
+}
 
-    // Perform rejection on form factor
-    if (prn(seed) < form_factor_x / form_factor_xmax) {
-      if (doppler) {
-        double E_out;
-        this->compton_doppler(alpha, *mu, &E_out, i_shell, seed);
-        *alpha_out = E_out / MASS_ELECTRON_EV;
-      } else {
-        *i_shell = -1;
+void PhotonInteraction::compton_scatter(double alpha, bool doppler,
+  double* alpha_out, double* mu, int* i_shell, uint64_t* seed) const
+{
+  if (!incoherent_table_.empty()) {
+    // Sample the angle from the tabulated distribution, which includes the
+    // form factor
+    *mu = incoherent_table_.sample(alpha, seed);
+    *alpha_out = alpha / (1.0 + alpha * (1.0 - *mu));
+  } else {
+    double form_factor_xmax = 0.0;
+    while (true) {
+      // Sample Klein-Nishina distribution for trial energy and angle
+      std::tie(*alpha_out, *mu) = klein_nishina(alpha, seed);
+
+      // Note that the parameter used here does not correspond exactly to the
+      // momentum transfer q in ENDF-102 Eq. (27.2). Rather, this is the
+      // parameter as defined by Hubbell, where the actual data comes from
+      double x =
+        MASS_ELECTRON_EV / PLANCK_C * alpha * std::sqrt(0.5 * (1.0 - *mu));
+
+      // Calculate S(x, Z) and S(x_max, Z)
+      double form_factor_x = incoherent_form_factor_(x);
+      if (form_factor_xmax == 0.0) {
+        form_factor_xmax =
+          incoherent_form_factor_(MASS_ELECTRON_EV / PLANCK_C * alpha);
       }
-      break;
+
+      // Perform rejection on form factor
+      if (prn(seed) < form_factor_x / form_factor_xmax)
+        break;
     }
   }
+
+  if (doppler) {
+    double E_out;
+    this->compton_doppler(alpha, *mu, &E_out, i_shell, seed);
+    *alpha_out = E_out / MASS_ELECTRON_EV;
+  } else {
+    *i_shell = -1;
+  }
 }
 
 void PhotonInteraction::compton_doppler(
@@ -426,12 +628,8 @@ void PhotonInteraction::compton_doppler(
   while (true) {
     // Sample electron shell
     double rn = prn(seed);
-    double c = 0.0;
-    for (shell = 0; shell < electron_pdf_.size(); ++shell) {
-      c += electron_pdf_(shell);
-      if (rn < c)
-        break;
-    }
+    shell = guide_search(electron_cdf_.begin(), electron_guide_, rn, 0,
+      electron_cdf_.size() - 1);
 
     // Determine binding energy of shell
     double E_b = binding_energy_(shell);
@@ -474,11 +672,18 @@ void PhotonInteraction::compton_doppler(
     }
 
     // Sample value on bounded cdf
-    c = prn(seed) * c_max;
-
-    // Determine pz corresponding to sampled cdf value
-    auto cdf_shell = xt::view(profile_cdf_, shell, xt::all());
-    int i = lower_bound_index(cdf_shell.cbegin(), cdf_shell.cend(), c);
+    double c = prn(seed) * c_max;
+
+    // Determine pz corresponding to sampled cdf value, starting from the
+    // guide table and moving to the last CDF value below c
+    const auto& guide = profile_guide_[shell];
+    double c_end = profile_cdf_(shell, n - 1);
+    int g = c_end > 0.0 ? std::min<int>(c / c_end * n, n - 1) : 0;
+    int i = guide[g];
+    while (i > 0 && profile_cdf_(shell, i) >= c)
+      --i;
+    while (i + 1 < n && profile_cdf_(shell, i + 1) < c)
+      ++i;
     double pz_l = data::compton_profile_pz(i);
     double pz_r = data::compton_profile_pz(i + 1);
     double p_l = profile_pdf_(shell, i);
@@ -555,6 +760,12 @@ void PhotonInteraction::calculate_xs(Particle& p) const
   if (energy_(i_grid) == energy_(i_grid + 1))
     ++i_grid;
 
+  this->calculate_xs(p, log_E, i_grid);
+}
+
+void PhotonInteraction::calculate_xs(
+  Particle& p, double log_E, int i_grid) const
+{
   // calculate interpolation factor
   double f =
     (log_E - energy_(i_grid)) / (energy_(i_grid + 1) - energy_(i_grid));
@@ -594,6 +805,9 @@ void PhotonInteraction::calculate_xs(Particle& p) const
 
 double PhotonInteraction::rayleigh_scatter(double alpha, uint64_t* seed) const
 {
+  if (!coherent_table_.empty())
+    return coherent_table_.sample(alpha, seed);
+
   double mu;
   while (true) {
     // Determine maximum value of x^2
@@ -761,6 +975,11 @@ void PhotonInteraction::atomic_relaxation(int i_shell, Particle& p) const
     int i_hole = holes[--n_holes];
     const auto& shell {shells_[i_hole]};
 
+    // Skip cascades that would only create particles below the energy cutoffs
+    if (settings::condense_relaxation && shell.below_cutoff) {
+      continue;
+    }
+
     // If no transitions, assume fluorescent photon from captured free electron
     if (shell.transitions.empty()) {
       Direction u = isotropic_direction(p.current_seed());
@@ -770,14 +989,10 @@ void PhotonInteraction::atomic_relaxation(int i_shell, Particle& p) const
     }
 
     // Sample transition
-    double c = -prn(p.current_seed());
-    int i_trans;
-    for (i_trans = 0; i_trans < shell.transitions.size(); ++i_trans) {
-      c += shell.transitions[i_trans].probability;
-      if (c > 0)
-        break;
-    }
-    const auto& transition = shell.transitions[i_trans];
+    int n_trans = shell.transitions.size();
+    int i_trans = guide_search(shell.transition_cdf.begin(),
+      shell.transition_guide, prn(p.current_seed()), 0, n_trans - 1);
+    const auto& transition = shell.transitions[std::min(i_trans, n_trans - 1)];
 
     // Sample angle isotropically
     Direction u = isotropic_direction(p.current_seed());
@@ -2,6 +2,7 @@
 
 #include "openmc/bank.h"
 #include "openmc/bremsstrahlung.h"
+#include "openmc/condensed_history.h"
 #include "openmc/constants.h"
 #include "openmc/distribution_multi.h"
 #include "openmc/eigenvalue.h"
@@ -27,7 +28,7 @@
 
 #include <fmt/core.h>
 
-#include <algorithm> // for max, min, max_element
+#include <algorithm> // for max, min, max_element, lower_bound, upper_bound
 #include <cmath>     // for sqrt, exp, log, abs, copysign
 #include <xtensor/xview.hpp>
 
@@ -190,6 +191,11 @@ void create_fission_sites(Particle& p, int i_nuclide, const Reaction& rx)
   // or the secondary particle bank.
   bool use_fission_bank = (settings::run_mode == RunMode::EIGENVALUE);
 
+  // With a Wielandt shift, each fission neutron is transported in the current
+  // generation with probability k/k_e. Only the remaining ones are banked for
+  // the next generation.
+  bool wielandt = use_fission_bank && settings::wielandt_shift > 0.0;
+
   // Counter for the number of fission sites successfully stored to the shared
   // fission bank or the secondary particle bank
   int n_sites_stored;
@@ -202,14 +208,26 @@ void create_fission_sites(Particle& p, int i_nuclide, const Reaction& rx)
     site.time = p.time();
     site.wgt = 1. / weight;
     site.parent_id = p.id();
-    site.progeny_id = p.n_progeny()++;
     site.surf_id = 0;
 
+    // Only sites banked for the next generation count as progeny, which are
+    // used to sort the fission bank
+    bool in_generation = wielandt && prn(p.current_seed()) <
+                                       simulation::keff / simulation::k_shift;
+    if (!in_generation)
+      site.progeny_id = p.n_progeny()++;
+
     // Sample delayed group and angle/energy for fission reaction
-    sample_fission_neutron(i_nuclide, rx, p.E(), &site, p.current_seed());
+    sample_fission_neutron(i_nuclide, rx, &site, p);
 
     // Store fission site in bank
-    if (use_fission_bank) {
+    if (in_generation) {
+      p.secondary_bank().push_back(site);
+#pragma omp atomic
+      simulation::wielandt_weight += site.wgt;
+#pragma omp atomic
+      simulation::total_weight += site.wgt;
+    } else if (use_fission_bank) {
       int64_t idx = simulation::fission_bank.thread_safe_append(site);
       if (idx == -1) {
         warning(
@@ -433,6 +451,11 @@ void sample_electron_reaction(Particle& p)
 {
   // TODO: create reaction types
 
+  if (settings::electron_treatment == ElectronTreatment::CH) {
+    condensed_history_collision(p);
+    return;
+  }
+
   if (settings::electron_treatment == ElectronTreatment::TTB) {
     double E_lost;
     thick_target_bremsstrahlung(p, &E_lost);
@@ -447,6 +470,11 @@ void sample_positron_reaction(Particle& p)
 {
   // TODO: create reaction types
 
+  if (settings::electron_treatment == ElectronTreatment::CH) {
+    condensed_history_collision(p);
+    return;
+  }
+
   if (settings::electron_treatment == ElectronTreatment::TTB) {
     double E_lost;
     thick_target_bremsstrahlung(p, &E_lost);
@@ -473,18 +501,39 @@ int sample_nuclide(Particle& p)
   const auto& mat {model::materials[p.material()]};
   int n = mat->nuclide_.size();
 
+  // Search the cumulative cross sections if the lookup stored them
+  const auto& cdf {p.xs_cdf()};
+  if (cdf.size() == n) {
+    auto it = std::lower_bound(cdf.begin(), cdf.end(), cutoff);
+    if (it != cdf.end())
+      return mat->nuclide_[it - cdf.begin()];
+  }
+
   double prob = 0.0;
   for (int i = 0; i < n; ++i) {
     // Get atom density
     int i_nuclide = mat->nuclide_[i];
     double atom_density = mat->atom_density_[i];
 
+    // Tabulated macroscopic cross sections leave the microscopic ones to be
+    // calculated only for the nuclides that are searched
+    if (mat->tabulate_xs_)
+      mat->calculate_nuclide_xs(p, i);
+
     // Increment probability to compare to cutoff
     prob += atom_density * p.neutron_xs(i_nuclide).total;
     if (prob >= cutoff)
       return i_nuclide;
   }
 
+  // A tabulated total is interpolated on a grid holding the energies of every
+  // nuclide, so it only differs from the sum of the microscopic cross sections
+  // by roundoff. A cutoff falling in that sliver past the sum is clamped to
+  // the last nuclide, while a larger shortfall means the table doesn't match
+  // the nuclide data and is treated as a failure to sample.
+  if (mat->tabulate_xs_ && n > 0 && cutoff - prob <= FP_REL_PRECISION * cutoff)
+    return mat->nuclide_[n - 1];
+
   // If we reach here, no nuclide was sampled
   p.write_restart();
   throw std::runtime_error {"Did not sample any nuclide during collision."};
@@ -498,6 +547,17 @@ int sample_element(Particle& p)
   // Get pointers to elements, densities
   const auto& mat {model::materials[p.material()]};
 
+  // Search the cumulative cross sections if the lookup stored them
+  const auto& cdf {p.xs_cdf()};
+  if (cdf.size() == mat->element_.size()) {
+    auto it = std::upper_bound(cdf.begin(), cdf.end(), cutoff);
+    if (it != cdf.end()) {
+      int i = it - cdf.begin();
+      p.event_nuclide() = mat->nuclide_[i];
+      return mat->element_[i];
+    }
+  }
+
   double prob = 0.0;
   for (int i = 0; i < mat->element_.size(); ++i) {
     // Find atom density
@@ -562,50 +622,61 @@ Reaction& sample_fission(int i_nuclide, Particle& p)
     "No fission reaction was sampled for " + nuc->name_};
 }
 
-void sample_photon_product(
-  int i_nuclide, Particle& p, int* i_rx, int* i_product)
+int photon_product_cdf(int i_nuclide, Particle& p, vector<double>& cdf)
 {
-  // Get grid index and interpolation factor and sample photon production cdf
   const auto& micro = p.neutron_xs(i_nuclide);
-  double cutoff = prn(p.current_seed()) * micro.photon_prod;
-  double prob = 0.0;
-
-  // Loop through each reaction type
   const auto& nuc {data::nuclides[i_nuclide]};
-  for (int i = 0; i < nuc->reactions_.size(); ++i) {
-    // Evaluate neutron cross section
-    const auto& rx = nuc->reactions_[i];
-    double xs = rx->xs(micro);
-
-    // if cross section is zero for this reaction, skip it
-    if (xs == 0.0)
-      continue;
-
-    for (int j = 0; j < rx->products_.size(); ++j) {
-      if (rx->products_[j].particle_ == ParticleType::photon) {
-        // For fission, artificially increase the photon yield to account
-        // for delayed photons
-        double f = 1.0;
-        if (settings::delayed_photon_scaling) {
-          if (is_fission(rx->mt_)) {
-            if (nuc->prompt_photons_ && nuc->delayed_photons_) {
-              double energy_prompt = (*nuc->prompt_photons_)(p.E());
-              double energy_delayed = (*nuc->delayed_photons_)(p.E());
-              f = (energy_prompt + energy_delayed) / (energy_prompt);
-            }
-          }
-        }
+  cdf.resize(nuc->photon_products_.size());
+
+  // For fission, artificially increase the photon yield to account for
+  // delayed photons
+  double f_fission = 1.0;
+  if (settings::delayed_photon_scaling && nuc->prompt_photons_ &&
+      nuc->delayed_photons_) {
+    double energy_prompt = (*nuc->prompt_photons_)(p.E());
+    double energy_delayed = (*nuc->delayed_photons_)(p.E());
+    f_fission = (energy_prompt + energy_delayed) / (energy_prompt);
+  }
 
-        // add to cumulative probability
-        prob += f * (*rx->products_[j].yield_)(p.E()) * xs;
+  double prob = 0.0;
+  int i_last = C_NONE;
+  int i_rx_last = C_NONE;
+  double xs = 0.0;
+  for (int k = 0; k < cdf.size(); ++k) {
+    // Evaluate the neutron cross section once for all products of a reaction
+    int i = nuc->photon_products_[k][0];
+    const auto& rx = nuc->reactions_[i];
+    if (i != i_rx_last) {
+      xs = rx->xs(micro);
+      i_rx_last = i;
+    }
 
-        *i_rx = i;
-        *i_product = j;
-        if (prob > cutoff)
-          return;
-      }
+    // Products of reactions with no cross section add nothing
+    if (xs != 0.0) {
+      double f = is_fission(rx->mt_) ? f_fission : 1.0;
+      const auto& product = rx->products_[nuc->photon_products_[k][1]];
+      prob += f * (*product.yield_)(p.E()) * xs;
+      i_last = k;
     }
+    cdf[k] = prob;
   }
+  return i_last;
+}
+
+void sample_photon_product(int i_nuclide, Particle& p,
+  const vector<double>& cdf, int i_last, int* i_rx, int* i_product)
+{
+  // Sample the photon production cdf. The interpolated photon production
+  // cross section can exceed the sum over products, in which case the last
+  // product that can occur is chosen.
+  double cutoff = prn(p.current_seed()) * p.neutron_xs(i_nuclide).photon_prod;
+  int k = std::upper_bound(cdf.begin(), cdf.end(), cutoff) - cdf.begin();
+  if (k > i_last)
+    k = i_last;
+
+  const auto& nuc {data::nuclides[i_nuclide]};
+  *i_rx = nuc->photon_products_[k][0];
+  *i_product = nuc->photon_products_[k][1];
 }
 
 void absorption(Particle& p, int i_nuclide)
@@ -692,21 +763,27 @@ void scatter(Particle& p, int i_nuclide)
     // =======================================================================
     // INELASTIC SCATTERING
 
+    // Search the cumulative inelastic cross sections if they are stored, and
+    // otherwise sum the reaction cross sections until reaching the cutoff
+    int i = nuc->sample_inelastic_scatter(micro, cutoff - prob);
     int j = 0;
-    int i = 0;
-    while (prob < cutoff) {
-      i = nuc->index_inelastic_scatter_[j];
+    while (i == C_NONE && prob < cutoff) {
+      int i_rx = nuc->index_inelastic_scatter_[j];
       ++j;
 
       // Check to make sure inelastic scattering reaction sampled
-      if (i >= nuc->reactions_.size()) {
+      if (i_rx >= nuc->reactions_.size()) {
         p.write_restart();
         fatal_error("Did not sample any reaction for nuclide " + nuc->name_);
       }
 
       // add to cumulative probability
-      prob += nuc->reactions_[i]->xs(micro);
+      prob += nuc->reactions_[i_rx]->xs(micro);
+      if (prob >= cutoff)
+        i = i_rx;
     }
+    if (i == C_NONE)
+      i = 0;
 
     // Perform collision physics for inelastic scattering
     const auto& rx {nuc->reactions_[i]};
@@ -811,6 +888,14 @@ void sab_scatter(int i_nuclide, int i_sab, Particle& p)
   p.u() = rotate_angle(p.u(), p.mu(), nullptr, p.current_seed());
 }
 
+void count_res_scat_sample(int64_t n_trial)
+{
+#pragma omp atomic
+  simulation::n_res_scat_samples += 1;
+#pragma omp atomic
+  simulation::n_res_scat_trials += n_trial;
+}
+
 Direction sample_target_velocity(const Nuclide& nuc, double E, Direction u,
   Direction v_neut, double xs_eff, double kT, uint64_t* seed)
 {
@@ -893,11 +978,12 @@ Direction sample_target_velocity(const Nuclide& nuc, double E, Direction u,
       xs_up += m * (E_up - nuc.energy_0K_[i_E_up]);
 
       // get max 0K xs value over range of practical relative energies
-      double xs_max = *std::max_element(
-        &nuc.elastic_0K_[i_E_low + 1], &nuc.elastic_0K_[i_E_up + 1]);
+      double xs_max = nuc.elastic_xs_0K_max(i_E_low + 1, i_E_up + 1);
       xs_max = std::max({xs_low, xs_max, xs_up});
 
+      int64_t n_trial = 0;
       while (true) {
+        ++n_trial;
         double E_rel;
         Direction v_target;
         while (true) {
@@ -913,8 +999,10 @@ Direction sample_target_velocity(const Nuclide& nuc, double E, Direction u,
         // perform Doppler broadening rejection correction (dbrc)
         double xs_0K = nuc.elastic_xs_0K(E_rel);
         double R = xs_0K / xs_max;
-        if (prn(seed) < R)
+        if (prn(seed) < R) {
+          count_res_scat_sample(n_trial);
           return v_target;
+        }
       }
 
     } else if (sampling_method == ResScatMethod::rvs) {
@@ -932,7 +1020,10 @@ Direction sample_target_velocity(const Nuclide& nuc, double E, Direction u,
                  (nuc.energy_0K_[i_E_up + 1] - nuc.energy_0K_[i_E_up]);
       double cdf_up = nuc.xs_cdf_[i_E_up] + m * (E_up - nuc.energy_0K_[i_E_up]);
 
+      int64_t n_trial = 0;
       while (true) {
+        ++n_trial;
+
         // directly sample Maxwellian
         double E_t = -kT * std::log(prn(seed));
 
@@ -954,6 +1045,7 @@ Direction sample_target_velocity(const Nuclide& nuc, double E, Direction u,
 
         if (std::abs(mu) < 1.0) {
           // set and accept target velocity
+          count_res_scat_sample(n_trial);
           E_t /= nuc.awr_;
           return std::sqrt(E_t) * rotate_angle(u, mu, nullptr, seed);
         }
@@ -1018,13 +1110,19 @@ Direction sample_cxs_target_velocity(
   return vt * rotate_angle(u, mu, nullptr, seed);
 }
 
-void sample_fission_neutron(int i_nuclide, const Reaction& rx, double E_in,
-  SourceSite* site, uint64_t* seed)
+void sample_fission_neutron(
+  int i_nuclide, const Reaction& rx, SourceSite* site, Particle& p)
 {
-  // Determine total nu, delayed nu, and delayed neutron fraction
+  double E_in = p.E();
+  uint64_t* seed = p.current_seed();
+
+  // Determine total nu, delayed nu, and delayed neutron fraction. These are
+  // the same for every site banked from a collision, so they are taken from
+  // the microscopic cross section cache after the first site.
   const auto& nuc {data::nuclides[i_nuclide]};
-  double nu_t = nuc->nu(E_in, Nuclide::EmissionMode::total);
-  double nu_d = nuc->nu(E_in, Nuclide::EmissionMode::delayed);
+  auto& micro {p.neutron_xs(i_nuclide)};
+  double nu_t = nuc->nu(E_in, Nuclide::EmissionMode::total, micro);
+  double nu_d = nuc->nu(E_in, Nuclide::EmissionMode::delayed, micro);
   double beta = nu_d / nu_t;
 
   if (prn(seed) < beta) {
@@ -1146,13 +1244,22 @@ void sample_secondary_photons(Particle& p, int i_nuclide)
   int y = static_cast<int>(y_t);
   if (prn(p.current_seed()) <= y_t - y)
     ++y;
+  if (y == 0)
+    return;
+
+  // The probability of each product depends only on the incident energy, so
+  // it is found once for all of the photons
+  static thread_local vector<double> cdf;
+  int i_last = photon_product_cdf(i_nuclide, p, cdf);
+  if (i_last == C_NONE)
+    return;
 
   // Sample each secondary photon
   for (int i = 0; i < y; ++i) {
     // Sample the reaction and product
     int i_rx;
     int i_product;
-    sample_photon_product(i_nuclide, p, &i_rx, &i_product);
+    sample_photon_product(i_nuclide, p, cdf, i_last, &i_rx, &i_product);
 
     // Sample the outgoing energy and angle
     auto& rx = data::nuclides[i_nuclide]->reactions_[i_rx];
@@ -72,7 +72,7 @@ void sample_reaction(Particle& p)
 
 void scatter(Particle& p)
 {
-  data::mg.macro_xs_[p.material()].sample_scatter(
+  data::mg.macro_xs(p.material()).sample_scatter(
     p.g_last(), p.g(), p.mu(), p.wgt(), p.current_seed());
 
   // Rotate the angle
@@ -118,6 +118,11 @@ void create_fission_sites(Particle& p)
   // or the secondary particle bank.
   bool use_fission_bank = (settings::run_mode == RunMode::EIGENVALUE);
 
+  // With a Wielandt shift, each fission neutron is transported in the current
+  // generation with probability k/k_e. Only the remaining ones are banked for
+  // the next generation.
+  bool wielandt = use_fission_bank && settings::wielandt_shift > 0.0;
+
   // Counter for the number of fission sites successfully stored to the shared
   // fission bank or the secondary particle bank
   int n_sites_stored;
@@ -127,9 +132,16 @@ void create_fission_sites(Particle& p)
     SourceSite site;
     site.r = p.r();
     site.particle = ParticleType::neutron;
+    site.time = p.time();
     site.wgt = 1. / weight;
     site.parent_id = p.id();
-    site.progeny_id = p.n_progeny()++;
+
+    // Only sites banked for the next generation count as progeny, which are
+    // used to sort the fission bank
+    bool in_generation = wielandt && prn(p.current_seed()) <
+                                       simulation::keff / simulation::k_shift;
+    if (!in_generation)
+      site.progeny_id = p.n_progeny()++;
 
     // Sample the cosine of the angle, assuming fission neutrons are emitted
     // isotropically
@@ -144,7 +156,7 @@ void create_fission_sites(Particle& p)
     // Sample secondary energy distribution for the fission reaction
     int dg;
     int gout;
-    data::mg.macro_xs_[p.material()].sample_fission_energy(
+    data::mg.macro_xs(p.material()).sample_fission_energy(
       p.g(), dg, gout, p.current_seed());
 
     // Store the energy and delayed groups on the fission bank
@@ -155,7 +167,13 @@ void create_fission_sites(Particle& p)
     site.delayed_group = dg + 1;
 
     // Store fission site in bank
-    if (use_fission_bank) {
+    if (in_generation) {
+      p.secondary_bank().push_back(site);
+#pragma omp atomic
+      simulation::wielandt_weight += site.wgt;
+#pragma omp atomic
+      simulation::total_weight += site.wgt;
+    } else if (use_fission_bank) {
       int64_t idx = simulation::fission_bank.thread_safe_append(site);
       if (idx == -1) {
         warning(
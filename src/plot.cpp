@@ -19,6 +19,7 @@
 #include "openmc/geometry.h"
 #include "openmc/hdf5_interface.h"
 #include "openmc/material.h"
+#include "openmc/memory.h"
 #include "openmc/mesh.h"
 #include "openmc/message_passing.h"
 #include "openmc/output.h"
@@ -28,6 +29,7 @@
 #include "openmc/settings.h"
 #include "openmc/simulation.h"
 #include "openmc/string_utils.h"
+#include "openmc/vector.h"
 
 namespace openmc {
 
@@ -109,12 +111,14 @@ uint64_t plotter_seed = 1;
 extern "C" int openmc_plot_geometry()
 {
 
-  for (auto& pl : model::plots) {
+  for (int i = 0; i < model::plots.size(); ++i) {
+    const auto& pl = model::plots[i];
     write_message(5, "Processing plot {}: {}...", pl.id_, pl.path_plot_);
 
     if (PlotType::slice == pl.type_) {
-      // create 2D image
-      create_image(pl);
+      // create 2D image, handing out the images to processes in turn
+      if (i % mpi::n_procs == mpi::rank)
+        create_image(pl);
     } else if (PlotType::voxel == pl.type_) {
       // create voxel file for 3D viewing
       create_voxel(pl);
@@ -644,7 +648,7 @@ void Plot::set_overlap_color(pugi::xml_node plot_node)
   // they're going to be plotted
   if (color_overlaps_ && settings::run_mode == RunMode::PLOTTING) {
     settings::check_overlaps = true;
-    model::overlap_check_count.resize(model::cells.size(), 0);
+    init_overlap_check_count();
   }
 }
 
@@ -876,37 +880,63 @@ void create_voxel(Plot const& pl)
   // initial particle position
   Position ll = pl.origin_ - pl.width_ / 2.;
 
-  // Open binary plot file for writing
-  std::ofstream of;
-  std::string fname = std::string(pl.path_plot_);
-  fname = strtrim(fname);
-  hid_t file_id = file_open(fname, 'w');
+  // Divide the slices among the processes
+  int n_slices = pl.pixels_[2];
+  int z_begin = static_cast<int64_t>(n_slices) * mpi::rank / mpi::n_procs;
+  int z_end = static_cast<int64_t>(n_slices) * (mpi::rank + 1) / mpi::n_procs;
 
-  // write header info
-  write_attribute(file_id, "filetype", "voxel");
-  write_attribute(file_id, "version", VERSION_VOXEL);
-  write_attribute(file_id, "openmc_version", VERSION);
-
-#ifdef GIT_SHA1
-  write_attribute(file_id, "git_sha1", GIT_SHA1);
+#ifdef PHDF5
+  // Each process writes its own slab of slices
+  bool write_slab = true;
+#else
+  // The master process writes the slabs of all processes
+  bool write_slab = mpi::master;
 #endif
 
-  // Write current date and time
-  write_attribute(file_id, "date_and_time", time_stamp().c_str());
-  array<int, 3> pixels;
-  std::copy(pl.pixels_.begin(), pl.pixels_.end(), pixels.begin());
-  write_attribute(file_id, "num_voxels", pixels);
-  write_attribute(file_id, "voxel_width", vox);
-  write_attribute(file_id, "lower_left", ll);
-
   // Create dataset for voxel data -- note that the dimensions are reversed
   // since we want the order in the file to be z, y, x
   hsize_t dims[3];
   dims[0] = pl.pixels_[2];
   dims[1] = pl.pixels_[1];
   dims[2] = pl.pixels_[0];
-  hid_t dspace, dset, memspace;
-  voxel_init(file_id, &(dims[0]), &dspace, &dset, &memspace);
+  hid_t file_id, dspace, dset, memspace;
+
+  std::string fname = std::string(pl.path_plot_);
+  fname = strtrim(fname);
+  if (mpi::master) {
+    // Open binary plot file for writing
+    file_id = file_open(fname, 'w');
+
+    // write header info
+    write_attribute(file_id, "filetype", "voxel");
+    write_attribute(file_id, "version", VERSION_VOXEL);
+    write_attribute(file_id, "openmc_version", VERSION);
+
+#ifdef GIT_SHA1
+    write_attribute(file_id, "git_sha1", GIT_SHA1);
+#endif
+
+    // Write current date and time
+    write_attribute(file_id, "date_and_time", time_stamp().c_str());
+    array<int, 3> pixels;
+    std::copy(pl.pixels_.begin(), pl.pixels_.end(), pixels.begin());
+    write_attribute(file_id, "num_voxels", pixels);
+    write_attribute(file_id, "voxel_width", vox);
+    write_attribute(file_id, "lower_left", ll);
+
+    voxel_init(file_id, &(dims[0]), &dspace, &dset, &memspace);
+  }
+
+#ifdef PHDF5
+  // Reopen the file on all processes once the master has created it
+  if (mpi::master) {
+    voxel_finalize(dspace, dset, memspace);
+    file_close(file_id);
+  }
+  MPI_Barrier(mpi::intracomm);
+  file_id = file_open(fname, 'a', true);
+  voxel_open(file_id, &dspace, &dset, &memspace);
+#endif
 
   PlotBase pltbase;
   pltbase.width_ = pl.width_;
@@ -916,10 +946,18 @@ void create_voxel(Plot const& pl)
   pltbase.level_ = -1; // all universes for voxel files
   pltbase.color_overlaps_ = pl.color_overlaps_;
 
-  ProgressBar pb;
-  for (int z = 0; z < pl.pixels_[2]; z++) {
+  // Show the progress of the slab on the master process
+  unique_ptr<ProgressBar> pb;
+  if (mpi::master)
+    pb = make_unique<ProgressBar>();
+
+  // Slices that are sent to the master process
+  vector<int32_t> slab;
+
+  for (int z = z_begin; z < z_end; z++) {
     // update progress bar
-    pb.set_value(100. * (double)z / (double)(pl.pixels_[2] - 1));
+    if (pb)
+      pb->set_value(100. * (z - z_begin) / (double)(z_end - z_begin - 1));
 
     // update z coordinate
     pltbase.origin_.z = ll.z + z * vox[2];
@@ -934,20 +972,60 @@ void create_voxel(Plot const& pl)
     xt::xtensor<int32_t, 2> data_flipped = xt::flip(data_slice, 0);
 
     // Write to HDF5 dataset
-    voxel_write_slice(z, dspace, dset, memspace, data_flipped.data());
+    if (write_slab) {
+      voxel_write_slice(z, dspace, dset, memspace, data_flipped.data());
+    } else {
+      slab.insert(slab.end(), data_flipped.begin(), data_flipped.end());
+    }
+  }
+
+#if defined(OPENMC_MPI) && !defined(PHDF5)
+  // Send the slabs of the other processes to the master one slice at a time
+  int slice_size = pl.pixels_[0] * pl.pixels_[1];
+  if (mpi::master) {
+    vector<int32_t> slice(slice_size);
+    for (int i = 1; i < mpi::n_procs; ++i) {
+      int begin = static_cast<int64_t>(n_slices) * i / mpi::n_procs;
+      int end = static_cast<int64_t>(n_slices) * (i + 1) / mpi::n_procs;
+      for (int z = begin; z < end; ++z) {
+        MPI_Recv(slice.data(), slice_size, MPI_INT32_T, i, 0, mpi::intracomm,
+          MPI_STATUS_IGNORE);
+        voxel_write_slice(z, dspace, dset, memspace, slice.data());
+      }
+    }
+  } else {
+    for (int z = 0; z < z_end - z_begin; ++z) {
+      MPI_Send(&slab[static_cast<size_t>(z) * slice_size], slice_size,
+        MPI_INT32_T, 0, 0, mpi::intracomm);
+    }
   }
+#endif
 
-  voxel_finalize(dspace, dset, memspace);
-  file_close(file_id);
+  if (write_slab) {
+    voxel_finalize(dspace, dset, memspace);
+    file_close(file_id);
+  }
 }
 
 void voxel_init(hid_t file_id, const hsize_t* dims, hid_t* dspace, hid_t* dset,
   hid_t* memspace)
 {
   // Create dataspace/dataset for voxel data
-  *dspace = H5Screate_simple(3, dims, nullptr);
-  *dset = H5Dcreate(file_id, "data", H5T_NATIVE_INT, *dspace, H5P_DEFAULT,
+  hid_t space = H5Screate_simple(3, dims, nullptr);
+  hid_t data = H5Dcreate(file_id, "data", H5T_NATIVE_INT, space, H5P_DEFAULT,
     H5P_DEFAULT, H5P_DEFAULT);
+  H5Sclose(space);
+  H5Dclose(data);
+
+  voxel_open(file_id, dspace, dset, memspace);
+}
+
+void voxel_open(hid_t file_id, hid_t* dspace, hid_t* dset, hid_t* memspace)
+{
+  *dset = open_dataset(file_id, "data");
+  *dspace = H5Dget_space(*dset);
+  hsize_t dims[3];
+  H5Sget_simple_extent_dims(*dspace, dims, nullptr);
 
   // Create dataspace for a slice of the voxel
   hsize_t dims_slice[2] {dims[1], dims[2]};
@@ -990,7 +1068,7 @@ extern "C" int openmc_id_map(const void* plot, int32_t* data_out)
   }
 
   if (plt->color_overlaps_ && model::overlap_check_count.size() == 0) {
-    model::overlap_check_count.resize(model::cells.size());
+    init_overlap_check_count();
   }
 
   auto ids = plt->get_map<IdData>();
@@ -1011,7 +1089,7 @@ extern "C" int openmc_property_map(const void* plot, double* data_out)
   }
 
   if (plt->color_overlaps_ && model::overlap_check_count.size() == 0) {
-    model::overlap_check_count.resize(model::cells.size());
+    init_overlap_check_count();
   }
 
   auto props = plt->get_map<PropertyData>();
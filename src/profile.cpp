@@ -0,0 +1,348 @@
+#include "openmc/profile.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm> // for min, partial_sort
+#include <numeric>   // for iota
+
+#include <fmt/core.h>
+
+#include "openmc/capi.h"
+#include "openmc/cell.h"
+#include "openmc/error.h"
+#include "openmc/hdf5_interface.h"
+#include "openmc/material.h"
+#include "openmc/message_passing.h"
+#include "openmc/tallies/tally.h"
+#include "openmc/timer.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace simulation {
+
+ProfileCounters profile_totals;
+DomainCounters profile_domain_totals;
+
+} // namespace simulation
+
+namespace {
+
+// Counters of one thread. The padding keeps counters that are updated by
+// different threads out of the same cache line.
+struct ThreadProfile {
+  array<int64_t, N_TRANSPORT_EVENTS> events;
+  ProfileCounters counters;
+  DomainCounters domains;
+  char padding[64];
+};
+
+vector<ThreadProfile> thread_profiles;
+
+// Innermost profiled region that each thread is in
+thread_local ProfileScope* current_scope {nullptr};
+
+// Labels for output and names of HDF5 groups for each region
+const char* region_labels[N_PROFILE_REGIONS] {"XS lookups",
+  "Distance to boundary", "Finding cells", "Collisions", "Tally scoring"};
+const char* region_names[N_PROFILE_REGIONS] {"calculate xs",
+  "distance to boundary", "find cell", "collision", "tally"};
+const char* domain_labels[N_PROFILE_DOMAINS] {"Material", "Cell", "Tally"};
+const char* domain_names[N_PROFILE_DOMAINS] {"materials", "cells", "tallies"};
+
+// Number of the most expensive domains of each kind that are displayed
+constexpr int N_DOMAINS_SHOWN {10};
+
+//! User-defined ID of a material, cell, or tally
+int32_t domain_id(int domain, int i)
+{
+  switch (static_cast<ProfileDomain>(domain)) {
+  case ProfileDomain::MATERIAL:
+    return model::materials[i]->id_;
+  case ProfileDomain::CELL:
+    return model::cells[i]->id_;
+  default:
+    return model::tallies[i]->id_;
+  }
+}
+
+//! Counters of this thread
+ThreadProfile& thread_profile()
+{
+#ifdef _OPENMP
+  return thread_profiles[omp_get_thread_num()];
+#else
+  return thread_profiles[0];
+#endif
+}
+
+} // namespace
+
+//==============================================================================
+// ProfileScope implementation
+//==============================================================================
+
+void ProfileScope::start(ProfileRegion region)
+{
+  // Regions are only timed during a simulation, and a region entered again
+  // from within itself is already being timed
+  if (thread_profiles.empty() ||
+      (current_scope && current_scope->region_ == region))
+    return;
+
+  active_ = true;
+  region_ = region;
+  parent_ = current_scope;
+  current_scope = this;
+  start_ = clock::now();
+}
+
+void ProfileScope::stop()
+{
+  std::chrono::duration<double> diff = clock::now() - start_;
+  double elapsed = diff.count();
+
+  auto& counter = thread_profile().counters[static_cast<int>(region_)];
+  ++counter.n_calls;
+  counter.total += elapsed;
+  counter.self += elapsed - child_time_;
+
+  if (parent_)
+    parent_->child_time_ += elapsed;
+  current_scope = parent_;
+}
+
+//==============================================================================
+// DomainScope implementation
+//==============================================================================
+
+void DomainScope::start(
+  ProfileDomain domain, int32_t index, const vector<int>* indices)
+{
+  if (thread_profiles.empty())
+    return;
+
+  active_ = true;
+  domain_ = domain;
+  index_ = index;
+  indices_ = indices;
+  start_ = clock::now();
+}
+
+void DomainScope::stop()
+{
+  std::chrono::duration<double> diff = clock::now() - start_;
+  auto& counters = thread_profile().domains[static_cast<int>(domain_)];
+  if (indices_) {
+    double share = diff.count() / indices_->size();
+    for (auto i : *indices_) {
+      ++counters[i].n_calls;
+      counters[i].time += share;
+    }
+  } else {
+    ++counters[index_].n_calls;
+    counters[index_].time += diff.count();
+  }
+}
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+void count_event(TransportEvent event, int64_t n)
+{
+  if (!thread_profiles.empty())
+    thread_profile().events[static_cast<int>(event)] += n;
+}
+
+void reset_profile()
+{
+#ifdef _OPENMP
+  int n_threads = omp_get_max_threads();
+#else
+  int n_threads = 1;
+#endif
+  thread_profiles.assign(n_threads, ThreadProfile {});
+  simulation::profile_totals = {};
+  simulation::profile_domain_totals = {};
+
+  if (settings::profile_domains) {
+    for (auto& tp : thread_profiles) {
+      tp.domains[static_cast<int>(ProfileDomain::MATERIAL)].resize(
+        model::materials.size());
+      tp.domains[static_cast<int>(ProfileDomain::CELL)].resize(
+        model::cells.size());
+      tp.domains[static_cast<int>(ProfileDomain::TALLY)].resize(
+        model::tallies.size());
+    }
+  }
+}
+
+void reduce_profile()
+{
+  // Sum over threads
+  ProfileCounters sum {};
+  for (const auto& tp : thread_profiles) {
+    for (int i = 0; i < N_PROFILE_REGIONS; ++i) {
+      sum[i].n_calls += tp.counters[i].n_calls;
+      sum[i].total += tp.counters[i].total;
+      sum[i].self += tp.counters[i].self;
+    }
+  }
+
+#ifdef OPENMC_MPI
+  // Sum over processes
+  int64_t n_calls[N_PROFILE_REGIONS];
+  double times[2 * N_PROFILE_REGIONS];
+  for (int i = 0; i < N_PROFILE_REGIONS; ++i) {
+    n_calls[i] = sum[i].n_calls;
+    times[2 * i] = sum[i].total;
+    times[2 * i + 1] = sum[i].self;
+  }
+  if (mpi::master) {
+    MPI_Reduce(MPI_IN_PLACE, n_calls, N_PROFILE_REGIONS, MPI_INT64_T, MPI_SUM,
+      0, mpi::intracomm);
+    MPI_Reduce(MPI_IN_PLACE, times, 2 * N_PROFILE_REGIONS, MPI_DOUBLE,
+      MPI_SUM, 0, mpi::intracomm);
+  } else {
+    MPI_Reduce(n_calls, nullptr, N_PROFILE_REGIONS, MPI_INT64_T, MPI_SUM, 0,
+      mpi::intracomm);
+    MPI_Reduce(times, nullptr, 2 * N_PROFILE_REGIONS, MPI_DOUBLE, MPI_SUM, 0,
+      mpi::intracomm);
+  }
+  for (int i = 0; i < N_PROFILE_REGIONS; ++i) {
+    sum[i].n_calls = n_calls[i];
+    sum[i].total = times[2 * i];
+    sum[i].self = times[2 * i + 1];
+  }
+#endif
+
+  simulation::profile_totals = sum;
+
+  // Sum counters of each domain over threads and processes
+  for (int d = 0; d < N_PROFILE_DOMAINS; ++d) {
+    int n = thread_profiles.empty() ? 0 : thread_profiles[0].domains[d].size();
+    vector<int64_t> n_calls(n, 0);
+    vector<double> times(n, 0.0);
+    for (const auto& tp : thread_profiles) {
+      for (int i = 0; i < n; ++i) {
+        n_calls[i] += tp.domains[d][i].n_calls;
+        times[i] += tp.domains[d][i].time;
+      }
+    }
+#ifdef OPENMC_MPI
+    if (mpi::master) {
+      MPI_Reduce(MPI_IN_PLACE, n_calls.data(), n, MPI_INT64_T, MPI_SUM, 0,
+        mpi::intracomm);
+      MPI_Reduce(
+        MPI_IN_PLACE, times.data(), n, MPI_DOUBLE, MPI_SUM, 0, mpi::intracomm);
+    } else {
+      MPI_Reduce(n_calls.data(), nullptr, n, MPI_INT64_T, MPI_SUM, 0,
+        mpi::intracomm);
+      MPI_Reduce(
+        times.data(), nullptr, n, MPI_DOUBLE, MPI_SUM, 0, mpi::intracomm);
+    }
+#endif
+    auto& totals = simulation::profile_domain_totals[d];
+    totals.resize(n);
+    for (int i = 0; i < n; ++i) {
+      totals[i].n_calls = n_calls[i];
+      totals[i].time = times[i];
+    }
+  }
+}
+
+void print_profile()
+{
+  fmt::print("   Profiled regions (summed over threads and processes)\n");
+  for (int i = 0; i < N_PROFILE_REGIONS; ++i) {
+    const auto& c = simulation::profile_totals[i];
+    fmt::print("     {:<29} = {:>10.4e} seconds, {:>10.4e} self, {:>10} "
+               "calls\n",
+      region_labels[i], c.total, c.self, c.n_calls);
+  }
+
+  // Show the domains of each kind with the most time attributed to them
+  for (int d = 0; d < N_PROFILE_DOMAINS; ++d) {
+    const auto& totals = simulation::profile_domain_totals[d];
+    if (totals.empty())
+      continue;
+    vector<int> order(totals.size());
+    std::iota(order.begin(), order.end(), 0);
+    int n_shown = std::min<int>(N_DOMAINS_SHOWN, order.size());
+    std::partial_sort(order.begin(), order.begin() + n_shown, order.end(),
+      [&](int a, int b) { return totals[a].time > totals[b].time; });
+
+    fmt::print("   Most expensive {}\n", domain_names[d]);
+    for (int k = 0; k < n_shown; ++k) {
+      int i = order[k];
+      if (totals[i].n_calls == 0)
+        break;
+      auto label = fmt::format("{} {}", domain_labels[d], domain_id(d, i));
+      fmt::print("     {:<29} = {:>10.4e} seconds, {:>10} calls\n",
+        label, totals[i].time, totals[i].n_calls);
+    }
+  }
+}
+
+void write_profile(hid_t group_id)
+{
+  for (int i = 0; i < N_PROFILE_REGIONS; ++i) {
+    const auto& c = simulation::profile_totals[i];
+    hid_t region_group = create_group(group_id, region_names[i]);
+    write_dataset(region_group, "calls", c.n_calls);
+    write_dataset(region_group, "total", c.total);
+    write_dataset(region_group, "self", c.self);
+    close_group(region_group);
+  }
+
+  // Write the counters of each domain along with its ID
+  for (int d = 0; d < N_PROFILE_DOMAINS; ++d) {
+    const auto& totals = simulation::profile_domain_totals[d];
+    if (totals.empty())
+      continue;
+    vector<int32_t> ids;
+    vector<int64_t> n_calls;
+    vector<double> times;
+    for (int i = 0; i < totals.size(); ++i) {
+      ids.push_back(domain_id(d, i));
+      n_calls.push_back(totals[i].n_calls);
+      times.push_back(totals[i].time);
+    }
+    hid_t domain_group = create_group(group_id, domain_names[d]);
+    write_dataset(domain_group, "ids", ids);
+    write_dataset(domain_group, "calls", n_calls);
+    write_dataset(domain_group, "time", times);
+    close_group(domain_group);
+  }
+}
+
+//==============================================================================
+// C API functions
+//==============================================================================
+
+extern "C" int openmc_get_performance_counters(int64_t counts[], double* time)
+{
+  if (thread_profiles.empty()) {
+    set_errmsg("Simulation has not been initialized.");
+    return OPENMC_E_ALLOCATE;
+  }
+
+  // Sum over threads of this process
+  for (int i = 0; i < N_TRANSPORT_EVENTS; ++i) {
+    counts[i] = 0;
+    for (const auto& tp : thread_profiles) {
+      counts[i] += tp.events[i];
+    }
+  }
+  *time = simulation::time_transport.elapsed();
+  return 0;
+}
+
+} // namespace openmc
@@ -12,6 +12,89 @@ constexpr uint64_t prn_mult {6364136223846793005ULL}; // multiplication
 constexpr uint64_t prn_add {1442695040888963407ULL};  // additive factor, c
 constexpr uint64_t prn_stride {152917LL}; // stride between particles
 
+#ifdef OPENMC_RNG_PHILOX
+// With the counter-based generator, a seed is the counter of the next random
+// number. Streams start at multiples of 2^62 apart and particles within a
+// stream are prn_stride apart, so every (stream, particle) pair has the same
+// number of random numbers available as with the LCG.
+static_assert(N_STREAMS <= 4, "Each stream needs its own quarter of counters");
+constexpr int stream_shift {62};
+
+// Philox-4x32-10 parameters
+constexpr uint32_t philox_mult_0 {0xD2511F53u};
+constexpr uint32_t philox_mult_1 {0xCD9E8D57u};
+constexpr uint32_t philox_weyl_0 {0x9E3779B9u}; // golden ratio
+constexpr uint32_t philox_weyl_1 {0xBB67AE85u}; // sqrt(3) - 1
+
+//==============================================================================
+// PHILOX
+//==============================================================================
+
+// Philox-4x32-10 counter-based generator from:
+// @inproceedings{salmon:random123,
+//    title = "Parallel Random Numbers: As Easy as 1, 2, 3",
+//    author = "John K. Salmon and Mark A. Moraes and Ron O. Dror and
+//    David E. Shaw",
+//    booktitle = "Proceedings of the International Conference for High
+//    Performance Computing, Networking, Storage and Analysis",
+//    year = "2011",
+//}
+// The counter is the seed and the key is the master seed. Only the first two
+// output words are used.
+inline uint64_t philox(uint64_t counter)
+{
+  uint32_t x0 = static_cast<uint32_t>(counter);
+  uint32_t x1 = static_cast<uint32_t>(counter >> 32);
+  uint32_t x2 = 0;
+  uint32_t x3 = 0;
+  uint32_t k0 = static_cast<uint32_t>(master_seed);
+  uint32_t k1 = static_cast<uint32_t>(static_cast<uint64_t>(master_seed) >> 32);
+  for (int i = 0; i < 10; ++i) {
+    uint64_t p0 = static_cast<uint64_t>(philox_mult_0) * x0;
+    uint64_t p1 = static_cast<uint64_t>(philox_mult_1) * x2;
+    x0 = static_cast<uint32_t>(p1 >> 32) ^ x1 ^ k0;
+    x1 = static_cast<uint32_t>(p1);
+    x2 = static_cast<uint32_t>(p0 >> 32) ^ x3 ^ k1;
+    x3 = static_cast<uint32_t>(p0);
+    k0 += philox_weyl_0;
+    k1 += philox_weyl_1;
+  }
+  return (static_cast<uint64_t>(x1) << 32) | x0;
+}
+
+//==============================================================================
+// PRN
+//==============================================================================
+
+double prn(uint64_t* seed)
+{
+  *seed += 1;
+
+  // Use the upper 53 bits so that the result is strictly less than one
+  return ldexp(philox(*seed) >> 11, -53);
+}
+
+void prn_batch(uint64_t* seed, int n, double* values)
+{
+  // Each number depends only on its own counter, so the loop vectorizes
+  uint64_t start = *seed;
+#pragma omp simd
+  for (int i = 0; i < n; ++i) {
+    values[i] = ldexp(philox(start + i + 1) >> 11, -53);
+  }
+  *seed += n;
+}
+
+void prn_lanes(uint64_t* seeds, int n, double* values)
+{
+#pragma omp simd
+  for (int i = 0; i < n; ++i) {
+    seeds[i] += 1;
+    values[i] = ldexp(philox(seeds[i]) >> 11, -53);
+  }
+}
+#else
+
 //==============================================================================
 // PRN
 //==============================================================================
@@ -28,20 +111,42 @@ constexpr uint64_t prn_stride {152917LL}; // stride between particles
 //    month = Sep,
 //    xurl = "https://www.cs.hmc.edu/tr/hmc-cs-2014-0905.pdf",
 //}
-double prn(uint64_t* seed)
+inline double pcg_output(uint64_t state)
 {
-  // Advance the LCG
-  *seed = (prn_mult * (*seed) + prn_add);
-
   // Permute the output
   uint64_t word =
-    ((*seed >> ((*seed >> 59u) + 5u)) ^ *seed) * 12605985483714917081ull;
+    ((state >> ((state >> 59u) + 5u)) ^ state) * 12605985483714917081ull;
   uint64_t result = (word >> 43u) ^ word;
 
   // Convert output from unsigned integer to double
   return ldexp(result, -64);
 }
 
+double prn(uint64_t* seed)
+{
+  // Advance the LCG
+  *seed = (prn_mult * (*seed) + prn_add);
+  return pcg_output(*seed);
+}
+
+void prn_batch(uint64_t* seed, int n, double* values)
+{
+  for (int i = 0; i < n; ++i) {
+    values[i] = prn(seed);
+  }
+}
+
+void prn_lanes(uint64_t* seeds, int n, double* values)
+{
+  // Each seed has its own LCG, so the loop vectorizes
+#pragma omp simd
+  for (int i = 0; i < n; ++i) {
+    seeds[i] = prn_mult * seeds[i] + prn_add;
+    values[i] = pcg_output(seeds[i]);
+  }
+}
+#endif
+
 //==============================================================================
 // FUTURE_PRN
 //==============================================================================
@@ -58,8 +163,13 @@ double future_prn(int64_t n, uint64_t seed)
 
 uint64_t init_seed(int64_t id, int offset)
 {
+#ifdef OPENMC_RNG_PHILOX
+  return (static_cast<uint64_t>(offset) << stream_shift) +
+         static_cast<uint64_t>(id) * prn_stride;
+#else
   return future_seed(
     static_cast<uint64_t>(id) * prn_stride, master_seed + offset);
+#endif
 }
 
 //==============================================================================
@@ -69,8 +179,7 @@ uint64_t init_seed(int64_t id, int offset)
 void init_particle_seeds(int64_t id, uint64_t* seeds)
 {
   for (int i = 0; i < N_STREAMS; i++) {
-    seeds[i] =
-      future_seed(static_cast<uint64_t>(id) * prn_stride, master_seed + i);
+    seeds[i] = init_seed(id, i);
   }
 }
 
@@ -89,6 +198,10 @@ void advance_prn_seed(int64_t n, uint64_t* seed)
 
 uint64_t future_seed(uint64_t n, uint64_t seed)
 {
+#ifdef OPENMC_RNG_PHILOX
+  // Skipping ahead only moves the counter
+  return seed + n;
+#else
   // The algorithm here to determine the parameters used to skip ahead is
   // described in F. Brown, "Random Number Generation with Arbitrary Stride,"
   // Trans. Am. Nucl. Soc. (Nov. 1994). This algorithm is able to skip ahead in
@@ -116,6 +229,7 @@ uint64_t future_seed(uint64_t n, uint64_t seed)
 
   // With G and C, we can now find the new seed.
   return g_new * seed + c_new;
+#endif
 }
 
 //==============================================================================
@@ -0,0 +1,770 @@
+#include "openmc/random_ray.h"
+
+#include <algorithm> // for fill, max, min
+#include <cmath>     // for expm1, sqrt
+#include <map>
+#include <string>
+#include <utility> // for pair, swap
+
+#include <fmt/core.h>
+
+#include "openmc/capi.h"
+#include "openmc/cell.h"
+#include "openmc/constants.h"
+#include "openmc/distribution_multi.h"
+#include "openmc/error.h"
+#include "openmc/geometry.h"
+#include "openmc/hdf5_interface.h"
+#include "openmc/message_passing.h"
+#include "openmc/mgxs_interface.h"
+#include "openmc/output.h"
+#include "openmc/random_lcg.h"
+#include "openmc/search.h"
+#include "openmc/settings.h"
+#include "openmc/simulation.h"
+#include "openmc/source.h"
+#include "openmc/surface.h"
+#include "openmc/timer.h"
+#include "openmc/weight_windows.h"
+
+namespace openmc {
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace simulation {
+
+vector<int64_t> source_region_offsets;
+int64_t n_source_regions {0};
+vector<double> source_region_volumes;
+vector<double> source_region_flux;
+vector<double> source_region_adjoint_flux;
+double random_ray_keff {1.0};
+double random_ray_keff_std {0.0};
+
+} // namespace simulation
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+namespace {
+
+// Number of positions sampled for the start of a ray before giving up
+constexpr int MAX_START_ATTEMPTS {1000};
+
+int n_groups; //!< Number of energy groups
+
+// Cross sections of each combination of material and temperature found in
+// the source regions. Group vectors are indexed by set * n_groups + group and
+// group matrices by (set * n_groups + incoming group) * n_groups + outgoing
+// group.
+vector<int> region_xs;        //!< Set of each source region, C_NONE if void
+vector<double> xs_total;      //!< Total cross section
+vector<double> xs_nu_fission; //!< Nu-fission cross section
+vector<double> xs_chi;        //!< Fission spectrum
+vector<double> xs_scatter;    //!< Nu-scatter matrix
+
+// Values of each source region and group, indexed by region * n_groups + group
+vector<double> flux_old; //!< Scalar flux of the previous batch
+vector<double> flux_new; //!< Integral of the angular flux along the rays of
+                         //!< the batch, then the scalar flux of the batch
+vector<double> flux_sum; //!< Sum of the scalar flux over active batches
+vector<double> source;   //!< Isotropic source divided by the total xs
+vector<double> external; //!< Fraction of the external source emitted
+vector<double> adjoint_source; //!< Adjoint source density
+
+bool adjoint {false}; //!< Whether the adjoint flux is being solved for
+
+// Values of each source region
+vector<double> length_batch; //!< Active ray length in the current batch
+vector<double> length_sum;   //!< Active ray length over all batches
+
+int64_t n_start_attempts; //!< Ray starting positions sampled
+int64_t n_start_found;    //!< Ray starting positions inside the geometry
+
+//! Add the cross sections of a material at a temperature as a new set
+void add_xs_set(int i_mat, double sqrtkT)
+{
+  auto& xs {data::mg.macro_xs(i_mat)};
+  xs.set_temperature_index(sqrtkT);
+  xs.set_angle_index({0.0, 0.0, 1.0});
+  for (int gin = 0; gin < n_groups; ++gin) {
+    xs_total.push_back(xs.get_xs(MgxsType::TOTAL, gin));
+    xs_nu_fission.push_back(
+      xs.fissionable ? xs.get_xs(MgxsType::NU_FISSION, gin) : 0.0);
+    for (int gout = 0; gout < n_groups; ++gout) {
+      xs_scatter.push_back(
+        xs.get_xs(MgxsType::NU_SCATTER, gin, &gout, nullptr, nullptr));
+      xs_chi.push_back(xs.fissionable ? xs.get_xs(MgxsType::CHI_PROMPT, gin,
+                                          &gout, nullptr, nullptr)
+                                      : 0.0);
+    }
+  }
+}
+
+//! Number the source regions and find their cross sections
+void init_source_regions()
+{
+  n_groups = data::mg.num_energy_groups_;
+
+  auto& offsets {simulation::source_region_offsets};
+  offsets.assign(model::cells.size(), C_NONE);
+  int64_t n = 0;
+  for (int32_t i = 0; i < model::cells.size(); ++i) {
+    const auto& c {*model::cells[i]};
+    if (c.type_ == Fill::MATERIAL) {
+      offsets[i] = n;
+      n += c.n_instances_;
+    }
+  }
+  simulation::n_source_regions = n;
+
+  // Regions with the same material and temperature share cross sections
+  std::map<std::pair<int32_t, double>, int> sets;
+  region_xs.assign(n, C_NONE);
+  for (int32_t i = 0; i < model::cells.size(); ++i) {
+    const auto& c {*model::cells[i]};
+    if (c.type_ != Fill::MATERIAL)
+      continue;
+    for (int j = 0; j < c.n_instances_; ++j) {
+      int32_t i_mat = c.material_.size() > 1 ? c.material_[j] : c.material_[0];
+      if (i_mat == MATERIAL_VOID)
+        continue;
+      double sqrtkT = c.sqrtkT_.size() > 1 ? c.sqrtkT_[j] : c.sqrtkT_[0];
+      auto key = std::make_pair(i_mat, sqrtkT);
+      auto it = sets.find(key);
+      if (it == sets.end()) {
+        it = sets.emplace(key, sets.size()).first;
+        add_xs_set(i_mat, sqrtkT);
+      }
+      region_xs[offsets[i] + j] = it->second;
+    }
+  }
+
+  int64_t n_values = n * n_groups;
+  flux_old.assign(n_values, 1.0);
+  flux_new.assign(n_values, 0.0);
+  flux_sum.assign(n_values, 0.0);
+  source.assign(n_values, 0.0);
+  external.assign(n_values, 0.0);
+  length_batch.assign(n, 0.0);
+  length_sum.assign(n, 0.0);
+  n_start_attempts = 0;
+  n_start_found = 0;
+}
+
+//! Estimate how the external source is divided among source regions and
+//! groups by sampling as many sites as a batch has rays
+void sample_external_source_regions()
+{
+  Particle p;
+  for (int64_t i = 0; i < settings::n_particles; ++i) {
+    uint64_t seed = init_seed(i + 1, STREAM_SOURCE);
+    auto site = sample_external_source(&seed);
+    p.n_coord() = 1;
+    p.coord(0).universe = model::root_universe;
+    p.r() = site.r;
+    p.u() = site.u;
+    if (!exhaustive_find_cell(p))
+      continue;
+    int g = static_cast<int>(site.E);
+    external[source_region(p) * n_groups + g] +=
+      site.wgt / settings::n_particles;
+  }
+}
+
+//! Estimate the volume of the geometry within the box that rays start in
+double geometry_volume()
+{
+  Position width =
+    settings::random_ray_upper_right - settings::random_ray_lower_left;
+  return width.x * width.y * width.z * n_start_found /
+         std::max<int64_t>(n_start_attempts, 1);
+}
+
+//! Compute the source of each region from the flux of the previous batch
+void compute_sources(double keff)
+{
+  // The external source is emitted per unit volume of a region, whose
+  // volume is estimated from the ray lengths so far
+  double total_length = 0.0;
+  for (auto length : length_sum)
+    total_length += length;
+  double V_geometry = geometry_volume();
+
+#pragma omp parallel for schedule(static)
+  for (int64_t r = 0; r < simulation::n_source_regions; ++r) {
+    int s = region_xs[r];
+    double V = total_length > 0.0 ? length_sum[r] / total_length * V_geometry
+                                   : 0.0;
+    for (int gout = 0; gout < n_groups; ++gout) {
+      int64_t i = r * n_groups + gout;
+      if (s == C_NONE) {
+        source[i] = 0.0;
+        continue;
+      }
+      double Q;
+      if (adjoint) {
+        // The adjoint source is already a density, and neutrons are
+        // transported with the transposed scattering and fission matrices
+        Q = adjoint_source[i];
+        for (int gin = 0; gin < n_groups; ++gin) {
+          int64_t k =
+            (static_cast<int64_t>(s) * n_groups + gout) * n_groups + gin;
+          Q += (xs_scatter[k] +
+                 xs_chi[k] * xs_nu_fission[s * n_groups + gout] / keff) *
+               flux_old[r * n_groups + gin];
+        }
+      } else {
+        Q = V > 0.0 ? external[i] / V : 0.0;
+        for (int gin = 0; gin < n_groups; ++gin) {
+          int64_t k =
+            (static_cast<int64_t>(s) * n_groups + gin) * n_groups + gout;
+          Q += (xs_scatter[k] +
+                 xs_chi[k] * xs_nu_fission[s * n_groups + gin] / keff) *
+               flux_old[r * n_groups + gin];
+        }
+      }
+      double total = xs_total[s * n_groups + gout];
+      source[i] = total > 0.0 ? Q / total : 0.0;
+    }
+  }
+}
+
+//! Attenuate the angular flux of a ray along a segment within one source
+//! region, adding the integral of the angular flux to the region if the
+//! segment is past the dead zone
+void attenuate(int64_t r, double length, bool active, vector<double>& psi)
+{
+  int s = region_xs[r];
+  for (int g = 0; g < n_groups; ++g) {
+    int64_t i = r * n_groups + g;
+    double integral = psi[g] * length;
+    double total = s == C_NONE ? 0.0 : xs_total[s * n_groups + g];
+    if (total > 0.0) {
+      double delta = (psi[g] - source[i]) * -std::expm1(-total * length);
+      integral = source[i] * length + delta / total;
+      psi[g] -= delta;
+    }
+    if (active) {
+#pragma omp atomic
+      flux_new[i] += integral;
+    }
+  }
+  if (active) {
+#pragma omp atomic
+    length_batch[r] += length;
+  }
+}
+
+//! Reflect a ray off a boundary surface. Unlike
+//! Particle::cross_reflective_bc(), this only changes the direction and
+//! coordinates of the ray and scores no surface tallies.
+void reflect_ray(Particle& p, const Surface& surf, Direction u)
+{
+  if (p.n_coord() != 1) {
+    p.mark_as_lost(fmt::format(
+      "Cannot reflect ray off surface {} in a lower universe.", surf.id_));
+    return;
+  }
+  p.u() = u / u.norm();
+  p.coord(0).cell = p.cell_last(p.n_coord_last() - 1);
+  p.surface() = -p.surface();
+  if (!neighbor_list_find_cell(p)) {
+    p.mark_as_lost(fmt::format(
+      "Couldn't find ray after reflecting from surface {}.", surf.id_));
+  }
+}
+
+//! Move a ray across the boundary it has reached. The ray is only a
+//! characteristic of the transport equation, so none of the leakage, surface
+//! tally and surface source side effects of Particle::event_cross_surface()
+//! apply. A ray reaching a vacuum boundary is reflected back without any
+//! incoming flux.
+void cross_boundary(Particle& p, uint64_t* seed, vector<double>& psi)
+{
+  p.surface() = p.boundary().surface_index;
+  p.n_coord() = p.boundary().coord_level;
+  for (int j = 0; j < p.n_coord(); ++j) {
+    p.cell_last(j) = p.coord(j).cell;
+  }
+  p.n_coord_last() = p.n_coord();
+
+  const auto& translation {p.boundary().lattice_translation};
+  if (translation[0] != 0 || translation[1] != 0 || translation[2] != 0) {
+    cross_lattice(p, p.boundary());
+    return;
+  }
+
+  const auto& surf {*model::surfaces[std::abs(p.surface()) - 1]};
+  if (!surf.bc_) {
+    // Find the cell on the other side, searching all cells if the neighbors
+    // don't contain it
+    if (neighbor_list_find_cell(p))
+      return;
+    p.n_coord() = 1;
+    if (exhaustive_find_cell(p))
+      return;
+    p.surface() = 0;
+    p.n_coord() = 1;
+    p.r() += TINY_BIT * p.u();
+    if (!exhaustive_find_cell(p)) {
+      p.mark_as_lost(fmt::format(
+        "Couldn't find ray after crossing surface {}.", surf.id_));
+    }
+    return;
+  }
+
+  std::string bc = surf.bc_->type();
+  if (bc == "vacuum") {
+    std::fill(psi.begin(), psi.end(), 0.0);
+    reflect_ray(p, surf, surf.reflect(p.r(), p.u(), &p));
+  } else if (bc == "reflective") {
+    reflect_ray(p, surf, surf.reflect(p.r(), p.u(), &p));
+  } else if (bc == "white") {
+    reflect_ray(p, surf, surf.diffuse_reflect(p.r(), p.u(), seed));
+  } else {
+    // Periodic boundaries only score mesh surface tallies of a Monte Carlo
+    // simulation in progress, so rays go through the boundary condition
+    surf.bc_->handle_particle(p, surf);
+  }
+}
+
+//! Sample a ray and track it through the geometry. A ray starts with the
+//! angular flux of the source in its region, which it forgets over the
+//! inactive distance before its contributions are added.
+void trace_ray(Particle& p, uint64_t* seed, vector<double>& psi,
+  int64_t& n_attempts, int64_t& n_found)
+{
+  // Sample a starting position in the geometry and an isotropic direction
+  bool found = false;
+  for (int i = 0; i < MAX_START_ATTEMPTS && !found; ++i) {
+    Position xi {prn(seed), prn(seed), prn(seed)};
+    p.n_coord() = 1;
+    p.coord(0).universe = model::root_universe;
+    p.r() = settings::random_ray_lower_left +
+            xi * (settings::random_ray_upper_right -
+                   settings::random_ray_lower_left);
+    p.u() = isotropic_direction(seed);
+    p.surface() = 0;
+    p.wgt() = 1.0;
+    ++n_attempts;
+    found = exhaustive_find_cell(p);
+  }
+  if (!found)
+    return;
+  ++n_found;
+
+  int64_t r = source_region(p);
+  for (int g = 0; g < n_groups; ++g) {
+    psi[g] = source[r * n_groups + g];
+  }
+
+  double d_inactive = settings::random_ray_distance_inactive;
+  double d_total = d_inactive + settings::random_ray_distance_active;
+  double traveled = 0.0;
+  for (int n_event = 0; n_event < MAX_EVENTS; ++n_event) {
+    p.boundary() = distance_to_boundary(p);
+    double d = std::min(p.boundary().distance, d_total - traveled);
+
+    // Split the segment at the end of the dead zone
+    r = source_region(p);
+    double d_dead = std::max(0.0, std::min(d, d_inactive - traveled));
+    if (d_dead > 0.0)
+      attenuate(r, d_dead, false, psi);
+    if (d > d_dead)
+      attenuate(r, d - d_dead, true, psi);
+    traveled += d;
+    if (traveled >= d_total)
+      return;
+
+    p.move(d);
+    cross_boundary(p, seed, psi);
+    if (!p.alive())
+      return;
+  }
+}
+
+//! Transport the rays of a batch on this process
+void transport_rays(int batch)
+{
+  std::fill(flux_new.begin(), flux_new.end(), 0.0);
+  std::fill(length_batch.begin(), length_batch.end(), 0.0);
+
+  int64_t i_begin = simulation::work_index[mpi::rank];
+  int64_t i_end = i_begin + simulation::work_per_rank;
+  int64_t n_attempts = 0;
+  int64_t n_found = 0;
+#pragma omp parallel reduction(+ : n_attempts, n_found)
+  {
+    Particle p;
+    vector<double> psi(n_groups);
+#pragma omp for schedule(dynamic)
+    for (int64_t i = i_begin; i < i_end; ++i) {
+      uint64_t seed =
+        init_seed(batch * settings::n_particles + i + 1, STREAM_TRACKING);
+      trace_ray(p, &seed, psi, n_attempts, n_found);
+    }
+  }
+
+#ifdef OPENMC_MPI
+  MPI_Allreduce(MPI_IN_PLACE, flux_new.data(), flux_new.size(), MPI_DOUBLE,
+    MPI_SUM, mpi::intracomm);
+  MPI_Allreduce(MPI_IN_PLACE, length_batch.data(), length_batch.size(),
+    MPI_DOUBLE, MPI_SUM, mpi::intracomm);
+  MPI_Allreduce(
+    MPI_IN_PLACE, &n_attempts, 1, MPI_INT64_T, MPI_SUM, mpi::intracomm);
+  MPI_Allreduce(
+    MPI_IN_PLACE, &n_found, 1, MPI_INT64_T, MPI_SUM, mpi::intracomm);
+#endif
+  n_start_attempts += n_attempts;
+  n_start_found += n_found;
+
+  for (int64_t r = 0; r < simulation::n_source_regions; ++r) {
+    length_sum[r] += length_batch[r];
+  }
+}
+
+//! Turn the integrals of the angular flux into scalar fluxes. The volume of
+//! each region is estimated from the ray lengths of all batches so far,
+//! which is less noisy than the lengths of the current batch.
+void normalize_flux()
+{
+  double total_sum = 0.0;
+  double total_batch = 0.0;
+  for (int64_t r = 0; r < simulation::n_source_regions; ++r) {
+    total_sum += length_sum[r];
+    total_batch += length_batch[r];
+  }
+
+#pragma omp parallel for schedule(static)
+  for (int64_t r = 0; r < simulation::n_source_regions; ++r) {
+    double length = total_sum > 0.0 ? length_sum[r] / total_sum * total_batch
+                                    : 0.0;
+    for (int g = 0; g < n_groups; ++g) {
+      int64_t i = r * n_groups + g;
+      flux_new[i] = length > 0.0 ? flux_new[i] / length : 0.0;
+    }
+  }
+}
+
+//! Compute the fission production rate of a scalar flux, weighting regions
+//! by their estimated volume fractions
+double fission_rate(const vector<double>& flux)
+{
+  double rate = 0.0;
+  for (int64_t r = 0; r < simulation::n_source_regions; ++r) {
+    int s = region_xs[r];
+    if (s == C_NONE)
+      continue;
+    for (int g = 0; g < n_groups; ++g) {
+      rate += length_sum[r] * xs_nu_fission[s * n_groups + g] *
+              flux[r * n_groups + g];
+    }
+  }
+  return rate;
+}
+
+//! Write the volumes and fluxes of the source regions, and any weight windows
+//! generated from them, to an HDF5 file
+void write_random_ray(const std::string& filename)
+{
+  hid_t file_id = file_open(filename, 'w');
+  write_attribute(file_id, "filetype", "random_ray");
+  write_attribute(file_id, "version", VERSION_RANDOM_RAY);
+  write_attribute(file_id, "openmc_version", VERSION);
+#ifdef GIT_SHA1
+  write_attribute(file_id, "git_sha1", GIT_SHA1);
+#endif
+  write_attribute(file_id, "date_and_time", time_stamp());
+  write_attribute(file_id, "n_groups", n_groups);
+  if (settings::run_mode == RunMode::EIGENVALUE) {
+    array<double, 2> keff {
+      simulation::random_ray_keff, simulation::random_ray_keff_std};
+    write_dataset(file_id, "k_combined", keff);
+  }
+
+  // Identify the cell and instance of each source region
+  vector<int32_t> cell_ids;
+  vector<int32_t> instances;
+  for (int32_t i = 0; i < model::cells.size(); ++i) {
+    const auto& c {*model::cells[i]};
+    if (c.type_ != Fill::MATERIAL)
+      continue;
+    for (int j = 0; j < c.n_instances_; ++j) {
+      cell_ids.push_back(c.id_);
+      instances.push_back(j);
+    }
+  }
+  write_dataset(file_id, "cells", cell_ids);
+  write_dataset(file_id, "instances", instances);
+  write_dataset(file_id, "volumes", simulation::source_region_volumes);
+
+  hsize_t dims[] {static_cast<hsize_t>(simulation::n_source_regions),
+    static_cast<hsize_t>(n_groups)};
+  write_dataset_lowlevel(file_id, 2, dims, "flux", H5T_NATIVE_DOUBLE, H5S_ALL,
+    false, simulation::source_region_flux.data());
+  if (!simulation::source_region_adjoint_flux.empty()) {
+    write_dataset_lowlevel(file_id, 2, dims, "adjoint_flux", H5T_NATIVE_DOUBLE,
+      H5S_ALL, false, simulation::source_region_adjoint_flux.data());
+  }
+
+  // Weight windows generated from the adjoint flux
+  for (const auto& generator : variance_reduction::generators) {
+    if (generator->method() == WeightWindowMethod::FW_CADIS)
+      generator->weight_windows().to_hdf5(file_id);
+  }
+  file_close(file_id);
+}
+
+//! Update the sources and sweep the rays for each batch, averaging the flux
+//! over the active batches in flux_sum
+//
+//! \param eigenvalue Whether to iterate on the eigenvalue
+//! \param first_batch Number of the first batch, which determines the seeds
+//!   of its rays
+void iterate_batches(bool eigenvalue, int first_batch)
+{
+  std::fill(flux_sum.begin(), flux_sum.end(), 0.0);
+  double keff = 1.0;
+  double keff_sum = 0.0;
+  double keff_sum_sq = 0.0;
+  int n_active = 0;
+  for (int batch = 1; batch <= settings::n_batches; ++batch) {
+    compute_sources(keff);
+    transport_rays(first_batch + batch - 1);
+    normalize_flux();
+
+    if (eigenvalue) {
+      double rate_old = fission_rate(flux_old);
+      if (rate_old > 0.0)
+        keff *= fission_rate(flux_new) / rate_old;
+    }
+    std::swap(flux_old, flux_new);
+
+    if (batch > settings::n_inactive) {
+      ++n_active;
+      for (int64_t i = 0; i < flux_old.size(); ++i) {
+        flux_sum[i] += flux_old[i];
+      }
+      keff_sum += keff;
+      keff_sum_sq += keff * keff;
+    }
+    if (eigenvalue) {
+      write_message(6, "  Batch {:>6}/{}   k = {:.5f}", batch,
+        settings::n_batches, keff);
+    } else {
+      write_message(6, "  Batch {:>6}/{}", batch, settings::n_batches);
+    }
+  }
+
+  // Average the active batches
+  if (n_active == 0)
+    return;
+  for (auto& flux : flux_sum)
+    flux /= n_active;
+  if (eigenvalue) {
+    simulation::random_ray_keff = keff_sum / n_active;
+    simulation::random_ray_keff_std =
+      n_active > 1
+        ? std::sqrt(std::max(0.0, (keff_sum_sq / n_active -
+                                    std::pow(keff_sum / n_active, 2)) /
+                                    (n_active - 1)))
+        : 0.0;
+  }
+}
+
+//! Average the adjoint flux of the source regions over the mesh bins and
+//! energy groups of weight windows. The average is weighted by volume by
+//! sampling points uniformly in the box that rays start in. Each multigroup
+//! group belongs to the weight window group containing its average energy.
+//
+//! \param ww Weight windows whose mesh and energy groups are averaged over
+//! \return Adjoint flux in each mesh bin within each energy group, zero where
+//!   no point was sampled
+vector<double> mesh_adjoint_flux(const WeightWindows& ww)
+{
+  const auto& mesh = ww.mesh();
+  const auto& bounds = ww.energy_bounds();
+  int64_t n_bins = mesh.n_bins();
+  vector<int> ww_group(n_groups, C_NONE);
+  for (int g = 0; g < n_groups; ++g) {
+    double E = data::mg.energy_bin_avg_[g];
+    if (E >= bounds.front() && E <= bounds.back())
+      ww_group[g] = lower_bound_index(bounds.begin(), bounds.end(), E);
+  }
+
+  int64_t n_values = n_bins * (bounds.size() - 1);
+  vector<double> sum(n_values, 0.0);
+  vector<double> count(n_values, 0.0);
+  int64_t i_begin = simulation::work_index[mpi::rank] * settings::n_batches;
+  int64_t i_end = i_begin + simulation::work_per_rank * settings::n_batches;
+  int64_t id_offset = (2 * settings::n_batches + 2) * settings::n_particles;
+#pragma omp parallel
+  {
+    Particle p;
+#pragma omp for schedule(static)
+    for (int64_t i = i_begin; i < i_end; ++i) {
+      uint64_t seed = init_seed(id_offset + i + 1, STREAM_TRACKING);
+      Position xi {prn(&seed), prn(&seed), prn(&seed)};
+      p.n_coord() = 1;
+      p.coord(0).universe = model::root_universe;
+      p.r() = settings::random_ray_lower_left +
+              xi * (settings::random_ray_upper_right -
+                     settings::random_ray_lower_left);
+      p.u() = {0.0, 0.0, 1.0};
+      int bin = mesh.get_bin(p.r());
+      if (bin < 0 || !exhaustive_find_cell(p))
+        continue;
+      int64_t r = source_region(p);
+      for (int g = 0; g < n_groups; ++g) {
+        if (ww_group[g] == C_NONE)
+          continue;
+        int64_t j = ww_group[g] * n_bins + bin;
+#pragma omp atomic
+        sum[j] += simulation::source_region_adjoint_flux[r * n_groups + g];
+#pragma omp atomic
+        count[j] += 1.0;
+      }
+    }
+  }
+
+#ifdef OPENMC_MPI
+  MPI_Allreduce(
+    MPI_IN_PLACE, sum.data(), n_values, MPI_DOUBLE, MPI_SUM, mpi::intracomm);
+  MPI_Allreduce(
+    MPI_IN_PLACE, count.data(), n_values, MPI_DOUBLE, MPI_SUM, mpi::intracomm);
+#endif
+
+  for (int64_t j = 0; j < n_values; ++j) {
+    sum[j] = count[j] > 0.0 ? sum[j] / count[j] : 0.0;
+  }
+  return sum;
+}
+
+//! Set the weight windows and source biasing of each FW-CADIS generator from
+//! the adjoint flux
+void generate_fw_cadis_weight_windows()
+{
+  for (auto& generator : variance_reduction::generators) {
+    if (generator->method() != WeightWindowMethod::FW_CADIS)
+      continue;
+    generator->set_importance(mesh_adjoint_flux(generator->weight_windows()));
+  }
+}
+
+} // namespace
+
+int64_t source_region(const Particle& p)
+{
+  return simulation::source_region_offsets[p.lowest_coord().cell] +
+         p.cell_instance();
+}
+
+void free_memory_random_ray()
+{
+  simulation::source_region_offsets.clear();
+  simulation::n_source_regions = 0;
+  simulation::source_region_volumes.clear();
+  simulation::source_region_flux.clear();
+  simulation::source_region_adjoint_flux.clear();
+  region_xs.clear();
+  xs_total.clear();
+  xs_nu_fission.clear();
+  xs_chi.clear();
+  xs_scatter.clear();
+  flux_old.clear();
+  flux_new.clear();
+  flux_sum.clear();
+  source.clear();
+  external.clear();
+  adjoint_source.clear();
+  length_batch.clear();
+  length_sum.clear();
+}
+
+//==============================================================================
+// C API functions
+//==============================================================================
+
+extern "C" int openmc_run_random_ray()
+{
+  if (settings::run_CE) {
+    set_errmsg("The random ray solver requires multigroup cross sections.");
+    return OPENMC_E_INVALID_ARGUMENT;
+  }
+
+  if (mpi::master)
+    header("RANDOM RAY SOLVER", 3);
+  Timer timer;
+  timer.start();
+
+  free_memory_random_ray();
+  calculate_work();
+  init_source_regions();
+
+  // The external source of a region depends on its volume, so the regions
+  // are first swept once without any source to estimate their volumes
+  bool eigenvalue = settings::run_mode == RunMode::EIGENVALUE;
+  if (!eigenvalue) {
+    sample_external_source_regions();
+    std::fill(flux_old.begin(), flux_old.end(), 0.0);
+    transport_rays(0);
+  }
+  iterate_batches(eigenvalue, 1);
+  simulation::source_region_flux = flux_sum;
+
+  double total_length = 0.0;
+  for (auto length : length_sum)
+    total_length += length;
+  double V_geometry = geometry_volume();
+  simulation::source_region_volumes.resize(simulation::n_source_regions);
+  for (int64_t r = 0; r < simulation::n_source_regions; ++r) {
+    simulation::source_region_volumes[r] =
+      total_length > 0.0 ? length_sum[r] / total_length * V_geometry : 0.0;
+  }
+
+  // Report regions that no ray reached, whose fluxes are unknown
+  int64_t n_missed = 0;
+  for (auto length : length_sum) {
+    if (length == 0.0)
+      ++n_missed;
+  }
+  if (n_missed > 0 && mpi::master) {
+    warning(fmt::format("{} of {} source regions were not crossed by any ray.",
+      n_missed, simulation::n_source_regions));
+  }
+
+  if (settings::fw_cadis) {
+    // The adjoint source for global variance reduction is the inverse of the
+    // forward flux, so that the response is the flux relative to its value
+    // everywhere in the problem
+    adjoint_source.assign(flux_sum.size(), 0.0);
+    for (int64_t i = 0; i < flux_sum.size(); ++i) {
+      if (flux_sum[i] > 0.0)
+        adjoint_source[i] = 1.0 / flux_sum[i];
+    }
+    write_message(6, "  Solving for the adjoint flux");
+    adjoint = true;
+    std::fill(flux_old.begin(), flux_old.end(), 0.0);
+    iterate_batches(false, settings::n_batches + 1);
+    adjoint = false;
+    simulation::source_region_adjoint_flux = flux_sum;
+    generate_fw_cadis_weight_windows();
+  }
+
+  timer.stop();
+  if (mpi::master) {
+    if (eigenvalue) {
+      write_message(4, "  Combined k-effective = {:.5f} +/- {:.5f}",
+        simulation::random_ray_keff, simulation::random_ray_keff_std);
+    }
+    write_message(6, "  Time in random ray solver: {:.3f} s", timer.elapsed());
+    write_random_ray(fmt::format("{}random_ray.h5", settings::path_output));
+  }
+  return 0;
+}
+
+} // namespace openmc
@@ -1,5 +1,6 @@
 #include "openmc/reaction.h"
 
+#include <algorithm> // for max, min
 #include <string>
 #include <unordered_map>
 #include <utility> // for move
@@ -10,7 +11,6 @@
 #include "openmc/endf.h"
 #include "openmc/hdf5_interface.h"
 #include "openmc/random_lcg.h"
-#include "openmc/search.h"
 #include "openmc/secondary_uncorrelated.h"
 
 namespace openmc {
@@ -19,7 +19,8 @@ namespace openmc {
 // Reaction implementation
 //==============================================================================
 
-Reaction::Reaction(hid_t group, const vector<int>& temperatures)
+Reaction::Reaction(hid_t group, const vector<int>& temperatures,
+  const vector<bool>& deferred)
 {
   read_attribute(group, "Q_value", q_value_);
   read_attribute(group, "mt", mt_);
@@ -37,22 +38,12 @@ Reaction::Reaction(hid_t group, const vector<int>& temperatures)
   }
 
   // Read cross section and threshold_idx data
-  for (auto t : temperatures) {
-    // Get group corresponding to temperature
-    hid_t temp_group = open_group(group, fmt::format("{}K", t).c_str());
-    hid_t dset = open_dataset(temp_group, "xs");
-
-    // Get threshold index
-    TemperatureXS xs;
-    read_attribute(dset, "threshold_idx", xs.threshold);
-
-    // Read cross section values
-    read_dataset(dset, xs.value);
-    close_dataset(dset);
-    close_group(temp_group);
-
-    // create new entry in xs vector
-    xs_.push_back(std::move(xs));
+  for (int i = 0; i < temperatures.size(); ++i) {
+    if (!deferred.empty() && deferred[i]) {
+      xs_.push_back({0, {}});
+    } else {
+      xs_.push_back(read_xs(group, temperatures[i]));
+    }
   }
 
   // Read products
@@ -65,6 +56,26 @@ Reaction::Reaction(hid_t group, const vector<int>& temperatures)
   }
 }
 
+Reaction::TemperatureXS Reaction::read_xs(hid_t group, int T)
+{
+  // Get group corresponding to temperature
+  hid_t temp_group = open_group(group, fmt::format("{}K", T).c_str());
+  hid_t dset = open_dataset(temp_group, "xs");
+
+  // Get threshold index
+  TemperatureXS xs;
+  read_attribute(dset, "threshold_idx", xs.threshold);
+
+  // Read cross section values
+  vector<xs_real> value;
+  read_dataset(dset, value);
+  xs.value = NodeSharedArray<xs_real>(std::move(value));
+  close_dataset(dset);
+  close_group(temp_group);
+
+  return xs;
+}
+
 double Reaction::xs(
   gsl::index i_temp, gsl::index i_grid, double interp_factor) const
 {
@@ -84,50 +95,38 @@ double Reaction::xs(const NuclideMicroXS& micro) const
 
 double Reaction::collapse_rate(gsl::index i_temp,
   gsl::span<const double> energy, gsl::span<const double> flux,
-  const vector<double>& grid) const
+  const NodeSharedArray<double>& grid, gsl::span<const int> indices) const
 {
-  // Find index corresponding to first energy
   const auto& xs = xs_[i_temp].value;
-  int i_low = lower_bound_index(grid.cbegin(), grid.cend(), energy.front());
-
-  // Check for threshold and adjust starting point if necessary
-  int j_start = 0;
   int i_threshold = xs_[i_temp].threshold;
-  if (i_low < i_threshold) {
-    i_low = i_threshold;
-    while (energy[j_start + 1] < grid[i_low]) {
-      ++j_start;
-      if (j_start + 1 == energy.size())
-        return 0.0;
-    }
-  }
 
   double xs_flux_sum = 0.0;
 
-  for (int j = j_start; j < flux.size(); ++j) {
+  for (int j = 0; j < flux.size(); ++j) {
+    // Groups below the threshold do not contribute
+    if (indices[j + 1] < i_threshold)
+      continue;
+
     double E_group_low = energy[j];
     double E_group_high = energy[j + 1];
     double flux_per_eV = flux[j] / (E_group_high - E_group_low);
 
-    // Determine energy grid index corresponding to group high
-    int i_high = i_low;
-    while (grid[i_high + 1] < E_group_high && i_high + 1 < grid.size() - 1)
-      ++i_high;
-
-    // Loop over energy grid points within [E_group_low, E_group_high]
-    for (; i_low <= i_high; ++i_low) {
+    // Loop over energy grid intervals that overlap [E_group_low, E_group_high]
+    for (int i = std::max(indices[j], i_threshold); i <= indices[j + 1]; ++i) {
       // Determine bounding grid energies and cross sections
-      double E_l = grid[i_low];
-      double E_r = grid[i_low + 1];
+      double E_l = grid[i];
+      double E_r = grid[i + 1];
       if (E_l == E_r)
         continue;
 
-      double xs_l = xs[i_low - i_threshold];
-      double xs_r = xs[i_low + 1 - i_threshold];
-
       // Determine actual energies
       double E_low = std::max(E_group_low, E_l);
       double E_high = std::min(E_group_high, E_r);
+      if (E_high <= E_low)
+        continue;
+
+      double xs_l = xs[i - i_threshold];
+      double xs_r = xs[i + 1 - i_threshold];
 
       // Determine average cross section across segment
       double m = (xs_r - xs_l) / (E_r - E_l);
@@ -139,12 +138,6 @@ double Reaction::collapse_rate(gsl::index i_temp,
       double dE = (E_high - E_low);
       xs_flux_sum += flux_per_eV * xs_avg * dE;
     }
-
-    i_low = i_high;
-
-    // Check for end of energy grid
-    if (i_low + 1 == grid.size())
-      break;
   }
 
   return xs_flux_sum;
@@ -163,6 +156,10 @@ std::unordered_map<int, std::string> REACTION_NAME_MAP {
   {SCORE_FISSION, "fission"},
   {SCORE_NU_FISSION, "nu-fission"},
   {SCORE_DECAY_RATE, "decay-rate"},
+  {SCORE_PULSE_HEIGHT, "pulse-height"},
+  {SCORE_IFP_TIME_NUM, "ifp-time-numerator"},
+  {SCORE_IFP_BETA_NUM, "ifp-beta-numerator"},
+  {SCORE_IFP_DENOM, "ifp-denominator"},
   {SCORE_DELAYED_NU_FISSION, "delayed-nu-fission"},
   {SCORE_PROMPT_NU_FISSION, "prompt-nu-fission"},
   {SCORE_KAPPA_FISSION, "kappa-fission"},
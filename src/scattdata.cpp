@@ -67,6 +67,61 @@ void ScattData::base_init(int order, const xt::xtensor<int, 1>& in_gmin,
       v.resize(order);
     }
   }
+
+  build_alias_tables();
+}
+
+//==============================================================================
+
+void ScattData::build_alias_tables()
+{
+  size_t groups = energy.size();
+  alias_prob.assign(groups, {});
+  alias_bin.assign(groups, {});
+
+  for (int gin = 0; gin < groups; gin++) {
+    // A CDF search is just as fast for few outgoing groups, and incoming groups
+    // that do not scatter keep the search's fallback to the last group
+    int n = energy[gin].size();
+    double norm = std::accumulate(energy[gin].begin(), energy[gin].end(), 0.);
+    if (n < MIN_ALIAS_GROUPS || norm == 0.)
+      continue;
+
+    // Build the table with Vose's method: bins with less than the average
+    // probability are topped up by bins with more
+    auto& prob = alias_prob[gin];
+    auto& bin = alias_bin[gin];
+    prob.resize(n);
+    bin.resize(n);
+    vector<int> small;
+    vector<int> large;
+    for (int i = 0; i < n; i++) {
+      prob[i] = energy[gin][i] * n / norm;
+      bin[i] = i;
+      if (prob[i] < 1.) {
+        small.push_back(i);
+      } else {
+        large.push_back(i);
+      }
+    }
+    while (!small.empty() && !large.empty()) {
+      int s = small.back();
+      small.pop_back();
+      int l = large.back();
+      bin[s] = l;
+      prob[l] -= 1. - prob[s];
+      if (prob[l] < 1.) {
+        large.pop_back();
+        small.push_back(l);
+      }
+    }
+
+    // Remaining bins are full up to round-off
+    for (int i : small)
+      prob[i] = 1.;
+    for (int i : large)
+      prob[i] = 1.;
+  }
 }
 
 //==============================================================================
@@ -167,7 +222,18 @@ void ScattData::base_combine(size_t max_order, size_t order_dim,
 
 void ScattData::sample_energy(int gin, int& gout, int& i_gout, uint64_t* seed)
 {
-  // Sample the outgoing group
+  // Sample the outgoing group from the alias table if there is one
+  if (!alias_prob[gin].empty()) {
+    int n = alias_prob[gin].size();
+    double x = prn(seed) * n;
+    i_gout = std::min(static_cast<int>(x), n - 1);
+    if (x - i_gout >= alias_prob[gin][i_gout])
+      i_gout = alias_bin[gin][i_gout];
+    gout = gmin[gin] + i_gout;
+    return;
+  }
+
+  // Otherwise search the CDF of the outgoing group
   double xi = prn(seed);
   double prob = 0.;
   i_gout = 0;
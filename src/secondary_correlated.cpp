@@ -149,6 +149,9 @@ CorrelatedAngleEnergy::CorrelatedAngleEnergy(hid_t group)
       d.angle.emplace_back(mudist);
     } // outgoing energies
 
+    // Guide table for sampling outgoing energies
+    d.c_guide = guide_table(d.c.data(), d.c.data() + d.c.size(), d.c.size());
+
     distribution_.push_back(std::move(d));
   } // incoming energies
 }
@@ -207,15 +210,16 @@ void CorrelatedAngleEnergy::sample(
     }
   }
 
-  // Continuous portion
-  double c_k1;
-  for (int j = n_discrete; j < end; ++j) {
-    k = j;
-    c_k1 = distribution_[l].c[k + 1];
-    if (r1 < c_k1)
-      break;
-    k = j + 1;
-    c_k = c_k1;
+  // Continuous portion -- start from the guide table entry for r1 and find
+  // the first bin whose upper CDF value exceeds r1
+  double c_k1 = c_k;
+  if (n_discrete < end) {
+    const auto& d = distribution_[l];
+    int m = guide_search(d.c.data(), d.c_guide, r1, n_discrete + 1, end);
+    k = m - 1;
+    if (k > n_discrete)
+      c_k = d.c[k];
+    c_k1 = m <= end ? d.c[m] : c_k;
   }
 
   double E_l_k = distribution_[l].e_out[k];
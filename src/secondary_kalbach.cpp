@@ -110,6 +110,9 @@ KalbachMann::KalbachMann(hid_t group)
       d.c /= d.c[n - 1];
     }
 
+    // Guide table for sampling outgoing energies
+    d.c_guide = guide_table(d.c.data(), d.c.data() + d.c.size(), d.c.size());
+
     distribution_.push_back(std::move(d));
   } // incoming energies
 }
@@ -168,15 +171,14 @@ void KalbachMann::sample(
     }
   }
 
-  // Continuous portion
-  double c_k1;
-  for (int j = n_discrete; j < end; ++j) {
-    k = j;
-    c_k1 = distribution_[l].c[k + 1];
-    if (r1 < c_k1)
-      break;
-    k = j + 1;
-    c_k = c_k1;
+  // Continuous portion -- start from the guide table entry for r1 and find
+  // the first bin whose upper CDF value exceeds r1
+  if (n_discrete < end) {
+    const auto& d = distribution_[l];
+    int m = guide_search(d.c.data(), d.c_guide, r1, n_discrete + 1, end);
+    k = m - 1;
+    if (k > n_discrete)
+      c_k = d.c[k];
   }
 
   double E_l_k = distribution_[l].e_out[k];
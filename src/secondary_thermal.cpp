@@ -42,7 +42,7 @@ void CoherentElasticAE::sample(
 
   Expects(E_in >= energies.front());
 
-  const int i = lower_bound_index(energies.begin(), energies.end(), E_in);
+  const int i = xs_.bragg_index(E_in);
 
   // Sample a Bragg edge between 1 and i
   // E[0] < E_in < E[i+1] -> can scatter in bragg edges 0..i
@@ -226,6 +226,11 @@ IncoherentInelasticAE::IncoherentInelasticAE(hid_t group)
     d.e_out_pdf = edist.p;
     d.e_out_cdf = edist.c;
 
+    // Build a guide table on a fixed grid in CDF space so that the outgoing
+    // energy bin can be found in a constant expected number of steps
+    d.cdf_guide =
+      guide_table(d.e_out_cdf.cbegin(), d.e_out_cdf.cend(), d.n_e_out);
+
     for (int j = 0; j < d.n_e_out; ++j) {
       auto adist = dynamic_cast<Tabular*>(edist.angle[j].get());
       if (adist) {
@@ -256,19 +261,15 @@ void IncoherentInelasticAE::sample(
   // Pick closer energy based on interpolation factor
   int l = f > 0.5 ? i + 1 : i;
 
-  // Determine outgoing energy bin
-  // (First reset n_energy_out to the right value)
-  auto n = distribution_[l].n_e_out;
+  // Determine outgoing energy bin, starting from the guide table entry for
+  // the sampled CDF value
+  const auto& cdf = distribution_[l].e_out_cdf;
+  const auto& guide = distribution_[l].cdf_guide;
+  int n = distribution_[l].n_e_out;
   double r1 = prn(seed);
-  double c_j = distribution_[l].e_out_cdf[0];
-  double c_j1;
-  std::size_t j;
-  for (j = 0; j < n - 1; ++j) {
-    c_j1 = distribution_[l].e_out_cdf[j + 1];
-    if (r1 < c_j1)
-      break;
-    c_j = c_j1;
-  }
+  int j = guide_search(cdf.cbegin(), guide, r1, 1, n - 1) - 1;
+  double c_j = cdf[j];
+  double c_j1 = (j < n - 1) ? cdf[j + 1] : c_j;
 
   // check to make sure j is <= n_energy_out - 2
   j = std::min(j, n - 2);
@@ -40,37 +40,74 @@ namespace settings {
 
 // Default values for boolean flags
 bool assume_separate {false};
+bool async_statepoint {false};
+bool auto_tune {false};
 bool check_overlaps {false};
 bool cmfd_run {false};
+bool compact_bank {false};
+bool compact_micro_xs {false};
+bool condense_relaxation {false};
+bool crossing_recovery {false};
 bool confidence_intervals {false};
 bool create_fission_neutrons {true};
 bool delayed_photon_scaling {true};
+bool delta_tracking {false};
 bool entropy_on {false};
 bool event_based {false};
+bool event_secondary_queue {false};
+bool fission_matrix_on {false};
+bool fw_cadis {false};
+bool huge_pages {false};
+bool lattice_dda {false};
 bool legendre_to_tabular {true};
 bool material_cell_offsets {true};
+bool mmap_source_files {false};
+bool mpi_progress_thread {false};
+bool numa_first_touch {false};
 bool output_summary {true};
 bool output_tallies {true};
 bool particle_restart_run {false};
+bool partition_source_files {false};
+bool photon_scattering_tables {false};
 bool photon_transport {false};
+bool pipelined_bank {false};
+bool precompute_neighbors {false};
+bool profile {false};
+bool profile_domains {false};
+bool random_ray {false};
 bool reduce_tallies {true};
 bool res_scat_on {false};
 bool restart_run {false};
 bool run_CE {true};
 bool source_latest {false};
 bool source_separate {false};
+bool source_single_precision {false};
 bool source_write {true};
+bool shared_cross_sections {false};
 bool surf_source_write {false};
+bool surf_source_stream {false};
 bool surf_source_read {false};
+bool summary_compact {false};
+bool summary_reuse {false};
 bool survival_biasing {false};
+bool tally_rank_files {false};
+bool tally_stream {false};
+bool temperature_lazy {false};
 bool temperature_multipole {false};
+bool temperature_multipole_quadrature {false};
+bool track_delta_positions {false};
+bool track_single_precision {false};
+bool track_writer_thread {false};
 bool trigger_on {false};
 bool trigger_predict {false};
 bool ufs_on {false};
+bool union_grid {false};
 bool urr_ptables_on {true};
+bool weight_window_mesh_crossings {false};
 bool weight_windows_on {false};
 bool write_all_tracks {false};
 bool write_initial_source {false};
+bool xs_cdf {false};
 
 std::string path_cross_sections;
 std::string path_input;
@@ -78,6 +115,8 @@ std::string path_output;
 std::string path_particle_restart;
 std::string path_sourcepoint;
 std::string path_statepoint;
+std::string path_xs_cache;
+std::string tally_stream_path;
 
 int32_t n_inactive {0};
 int32_t max_lost_particles {10};
@@ -86,25 +125,52 @@ int32_t gen_per_batch {1};
 int64_t n_particles {-1};
 
 int64_t max_particles_in_flight {100000};
-
+int64_t event_xs_batch_size {0};
+EventSchedule event_schedule {EventSchedule::LONGEST};
+int64_t event_min_queue_size {0};
+int64_t event_sort_threshold {0};
+HistorySchedule history_schedule {HistorySchedule::LOOP};
+int64_t work_chunk_size {0};
+double event_refill_threshold {0.0};
+int64_t io_stripe_size {0};
+int64_t tallies_out_max_bins {0};
+
+vector<double> census_times;
+int fission_matrix_interval {0};
+double crossing_recovery_distance {1.0e-6};
+double delta_tracking_max_ratio {10.0};
+vector<int32_t> delta_tracking_universes;
 ElectronTreatment electron_treatment {ElectronTreatment::TTB};
+double electron_step_fraction {0.2};
 array<double, 4> energy_cutoff {0.0, 1000.0, 0.0, 0.0};
 int legendre_to_tabular_points {C_NONE};
 int max_order {0};
 int n_log_bins {8000};
+int hash_grid_points_per_bin {0};
+int ifp_n_generation {0};
 int n_batches;
 int n_max_batches;
 int max_splits {1000};
 int max_tracks {1000};
+bool overlap_check_crossings {false};
+double overlap_check_fraction {1.0};
+double random_ray_distance_active {0.0};
+double random_ray_distance_inactive {0.0};
+Position random_ray_lower_left;
+Position random_ray_upper_right;
 ResScatMethod res_scat_method {ResScatMethod::rvs};
 double res_scat_energy_min {0.01};
 double res_scat_energy_max {1000.0};
 vector<std::string> res_scat_nuclides;
 RunMode run_mode {RunMode::UNSET};
+int64_t secondary_bank_capacity {1000};
+int source_compression {0};
 std::unordered_set<int> sourcepoint_batch;
 std::unordered_set<int> statepoint_batch;
 std::unordered_set<int> source_write_surf_id;
 int64_t max_surface_particles;
+int tally_reduce_interval {1};
+vector<int> tally_stream_tallies;
 TemperatureMethod temperature_method {TemperatureMethod::NEAREST};
 double temperature_tolerance {10.0};
 double temperature_default {293.6};
@@ -112,11 +178,15 @@ array<double, 2> temperature_range {0.0, 0.0};
 int trace_batch;
 int trace_gen;
 int64_t trace_particle;
+int track_compression {0};
+double track_fraction {1.0};
 vector<array<int, 3>> track_identifiers;
+vector<double> track_region;
 int trigger_batch_interval {1};
 int verbosity {7};
 double weight_cutoff {0.25};
 double weight_survive {1.0};
+double wielandt_shift {0.0};
 
 } // namespace settings
 
@@ -390,11 +460,22 @@ void read_settings_xml()
       electron_treatment = ElectronTreatment::LED;
     } else if (temp_str == "ttb") {
       electron_treatment = ElectronTreatment::TTB;
+    } else if (temp_str == "ch") {
+      electron_treatment = ElectronTreatment::CH;
     } else {
       fatal_error("Unrecognized electron treatment: " + temp_str + ".");
     }
   }
 
+  // Step length of condensed history electron transport
+  if (check_for_node(root, "electron_step_fraction")) {
+    electron_step_fraction =
+      std::stod(get_node_value(root, "electron_step_fraction"));
+    if (electron_step_fraction <= 0.0 || electron_step_fraction > 1.0) {
+      fatal_error("Electron step fraction must be in (0, 1].");
+    }
+  }
+
   // Check for photon transport
   if (check_for_node(root, "photon_transport")) {
     photon_transport = get_node_value_bool(root, "photon_transport");
@@ -405,6 +486,17 @@ void read_settings_xml()
     }
   }
 
+  // Check for tabulated sampling of photon scattering angles
+  if (check_for_node(root, "photon_scattering_tables")) {
+    photon_scattering_tables =
+      get_node_value_bool(root, "photon_scattering_tables");
+  }
+
+  // Check for skipping atomic relaxation below the energy cutoffs
+  if (check_for_node(root, "condense_relaxation")) {
+    condense_relaxation = get_node_value_bool(root, "condense_relaxation");
+  }
+
   // Number of bins for logarithmic grid
   if (check_for_node(root, "log_grid_bins")) {
     n_log_bins = std::stoi(get_node_value(root, "log_grid_bins"));
@@ -414,6 +506,60 @@ void read_settings_xml()
     }
   }
 
+  // Target number of grid points per bin for hash energy grids
+  if (check_for_node(root, "hash_grid_points_per_bin")) {
+    hash_grid_points_per_bin =
+      std::stoi(get_node_value(root, "hash_grid_points_per_bin"));
+    if (hash_grid_points_per_bin < 0) {
+      fatal_error("Number of points per hash grid bin must be non-negative.");
+    }
+  }
+
+  // Directory for cached derived cross sections
+  if (check_for_node(root, "cross_sections_cache")) {
+    path_xs_cache = get_node_value(root, "cross_sections_cache");
+  }
+
+  // Compact per-particle microscopic cross section caches
+  if (check_for_node(root, "compact_micro_xs")) {
+    compact_micro_xs = get_node_value_bool(root, "compact_micro_xs");
+  }
+
+  // Cumulative cross sections stored for sampling collision nuclides
+  if (check_for_node(root, "xs_cdf")) {
+    xs_cdf = get_node_value_bool(root, "xs_cdf");
+  }
+
+  // Huge pages for large cross section and tally arrays
+  if (check_for_node(root, "huge_pages")) {
+    huge_pages = get_node_value_bool(root, "huge_pages");
+  }
+
+  // Spread pages of data used by all threads over NUMA domains
+  if (check_for_node(root, "numa_first_touch")) {
+    numa_first_touch = get_node_value_bool(root, "numa_first_touch");
+  }
+
+  // Make MPI progress on a separate thread during transport
+  if (check_for_node(root, "mpi_progress_thread")) {
+    mpi_progress_thread = get_node_value_bool(root, "mpi_progress_thread");
+    if (mpi_progress_thread && mpi::n_procs > 1 && !mpi::thread_multiple) {
+      warning("MPI progress thread requires MPI_THREAD_MULTIPLE, which was "
+              "not provided.");
+      mpi_progress_thread = false;
+    }
+  }
+
+  // Node-shared storage of nuclide cross sections
+  if (check_for_node(root, "shared_cross_sections")) {
+    shared_cross_sections = get_node_value_bool(root, "shared_cross_sections");
+  }
+
+  // Unionized energy grid for materials
+  if (check_for_node(root, "union_grid")) {
+    union_grid = get_node_value_bool(root, "union_grid");
+  }
+
   // Number of OpenMP threads
   if (check_for_node(root, "threads")) {
     if (mpi::master)
@@ -422,9 +568,23 @@ void read_settings_xml()
               "threads.");
   }
 
+  // Read meshes, which may be used by the spatial distribution of a source
+  read_meshes(root);
+
   // ==========================================================================
   // EXTERNAL SOURCE
 
+  // Check whether each process should only read its own slice of source files
+  if (check_for_node(root, "partition_source_files")) {
+    partition_source_files =
+      get_node_value_bool(root, "partition_source_files");
+  }
+
+  // Check whether source files should be sampled from memory maps
+  if (check_for_node(root, "mmap_source_files")) {
+    mmap_source_files = get_node_value_bool(root, "mmap_source_files");
+  }
+
   // Get point to list of <source> elements and make sure there is at least one
   for (pugi::xml_node node : root.children("source")) {
     if (check_for_node(node, "file")) {
@@ -548,9 +708,6 @@ void read_settings_xml()
     }
   }
 
-  // Read meshes
-  read_meshes(root);
-
   // Shannon Entropy mesh
   if (check_for_node(root, "entropy_mesh")) {
     int temp = std::stoi(get_node_value(root, "entropy_mesh"));
@@ -658,6 +815,24 @@ void read_settings_xml()
     sourcepoint_batch = statepoint_batch;
   }
 
+  // Check how source banks should be stored in files
+  if (check_for_node(root, "source_compression")) {
+    source_compression = std::stoi(get_node_value(root, "source_compression"));
+    if (source_compression < 0 || source_compression > 9) {
+      fatal_error("Source compression level must be between 0 and 9.");
+    }
+  }
+  if (check_for_node(root, "source_precision")) {
+    auto precision = get_node_value(root, "source_precision", true, true);
+    if (precision == "single") {
+      source_single_precision = true;
+    } else if (precision == "double") {
+      source_single_precision = false;
+    } else {
+      fatal_error("Unrecognized source precision: " + precision);
+    }
+  }
+
   // Check if the user has specified to write surface source
   if (check_for_node(root, "surf_source_write")) {
     surf_source_write = true;
@@ -677,6 +852,12 @@ void read_settings_xml()
       max_surface_particles =
         std::stoll(get_node_value(node_ssw, "max_particles"));
     }
+
+    // Determine whether sites are written as they are banked rather than
+    // held in memory until the end of the simulation
+    if (check_for_node(node_ssw, "stream")) {
+      surf_source_stream = get_node_value_bool(node_ssw, "stream");
+    }
   }
 
   // If source is not seperate and is to be written out in the statepoint file,
@@ -697,6 +878,38 @@ void read_settings_xml()
     reduce_tallies = !get_node_value_bool(root, "no_reduce");
   }
 
+  // Number of batches between reductions of tally results
+  if (check_for_node(root, "tally_reduce_interval")) {
+    tally_reduce_interval =
+      std::stoi(get_node_value(root, "tally_reduce_interval"));
+    if (tally_reduce_interval <= 0) {
+      fatal_error("Tally reduction interval must be greater than zero.");
+    }
+  }
+
+  // Publish the results of tallies after each batch
+  if (check_for_node(root, "tally_stream")) {
+    tally_stream = true;
+    xml_node node_ts = root.child("tally_stream");
+    if (check_for_node(node_ts, "tallies")) {
+      tally_stream_tallies = get_node_array<int>(node_ts, "tallies");
+    }
+    if (check_for_node(node_ts, "path")) {
+      tally_stream_path = get_node_value(node_ts, "path", false, true);
+    }
+  }
+
+  // Check if each process should write its own tally results when tallies
+  // are not reduced
+  if (check_for_node(root, "tally_rank_files")) {
+    tally_rank_files = get_node_value_bool(root, "tally_rank_files");
+    if (tally_rank_files && reduce_tallies) {
+      warning("Tally results are only written by each process when the "
+              "no-reduce method is used.");
+      tally_rank_files = false;
+    }
+  }
+
   // Check if the user has specified to use confidence intervals for
   // uncertainties rather than standard deviations
   if (check_for_node(root, "confidence_intervals")) {
@@ -712,11 +925,25 @@ void read_settings_xml()
     if (check_for_node(node_output, "summary")) {
       output_summary = get_node_value_bool(node_output, "summary");
     }
+    if (check_for_node(node_output, "summary_compact")) {
+      summary_compact = get_node_value_bool(node_output, "summary_compact");
+    }
+    if (check_for_node(node_output, "summary_reuse")) {
+      summary_reuse = get_node_value_bool(node_output, "summary_reuse");
+    }
 
     // Check for ASCII tallies output option
     if (check_for_node(node_output, "tallies")) {
       output_tallies = get_node_value_bool(node_output, "tallies");
     }
+    if (check_for_node(node_output, "tallies_max_bins")) {
+      tallies_out_max_bins =
+        std::stoll(get_node_value(node_output, "tallies_max_bins"));
+      if (tallies_out_max_bins < 0) {
+        fatal_error("Maximum number of tally bins written to tallies.out "
+                    "must be non-negative.");
+      }
+    }
 
     // Set output directory if a path has been specified
     if (check_for_node(node_output, "path")) {
@@ -777,6 +1004,147 @@ void read_settings_xml()
     }
   }
 
+  // Get census times, at which particles are banked and combed before they
+  // continue in the next time window
+  if (check_for_node(root, "census_times")) {
+    census_times = get_node_array<double>(root, "census_times");
+    if (run_mode == RunMode::EIGENVALUE) {
+      fatal_error("Census times can't be used in eigenvalue mode.");
+    }
+    for (int i = 0; i < census_times.size(); ++i) {
+      if (census_times[i] <= 0.0 ||
+          (i > 0 && census_times[i] <= census_times[i - 1])) {
+        fatal_error("Census times must be positive and increasing.");
+      }
+    }
+  }
+
+  // Check for delta tracking
+  if (check_for_node(root, "delta_tracking")) {
+    xml_node node_delta = root.child("delta_tracking");
+
+    // See if delta tracking is enabled
+    if (check_for_node(node_delta, "enable")) {
+      delta_tracking = get_node_value_bool(node_delta, "enable");
+    } else {
+      delta_tracking = true;
+    }
+
+    // Get universes to delta track
+    if (check_for_node(node_delta, "universes")) {
+      delta_tracking_universes =
+        get_node_array<int32_t>(node_delta, "universes");
+    }
+
+    // Ratio of the majorant to the total cross section above which the
+    // particle is surface tracked instead
+    if (check_for_node(node_delta, "max_ratio")) {
+      delta_tracking_max_ratio =
+        std::stod(get_node_value(node_delta, "max_ratio"));
+    }
+    if (delta_tracking_max_ratio < 1.0) {
+      fatal_error("Maximum delta tracking majorant ratio must be at least 1.");
+    }
+  }
+
+  // Check for recovery of particles missing neighbor lists
+  if (check_for_node(root, "crossing_recovery")) {
+    xml_node node_cr = root.child("crossing_recovery");
+    if (check_for_node(node_cr, "enable")) {
+      crossing_recovery = get_node_value_bool(node_cr, "enable");
+    } else {
+      crossing_recovery = true;
+    }
+    if (check_for_node(node_cr, "distance")) {
+      crossing_recovery_distance =
+        std::stod(get_node_value(node_cr, "distance"));
+      if (crossing_recovery_distance <= 0.0) {
+        fatal_error("Crossing recovery distance must be positive.");
+      }
+    }
+  }
+
+  // Check for sampled overlap checking
+  if (check_for_node(root, "overlap_checks")) {
+    xml_node node_oc = root.child("overlap_checks");
+
+    // Overlap checking can also be turned on from the command line
+    if (check_for_node(node_oc, "enable")) {
+      if (get_node_value_bool(node_oc, "enable"))
+        check_overlaps = true;
+    } else {
+      check_overlaps = true;
+    }
+
+    if (check_for_node(node_oc, "fraction")) {
+      overlap_check_fraction = std::stod(get_node_value(node_oc, "fraction"));
+      if (overlap_check_fraction <= 0.0 || overlap_check_fraction > 1.0) {
+        fatal_error("Fraction of events at which overlaps are checked must be "
+                    "greater than 0 and at most 1.");
+      }
+    }
+    if (check_for_node(node_oc, "crossings_only")) {
+      overlap_check_crossings =
+        get_node_value_bool(node_oc, "crossings_only");
+    }
+  }
+
+  // Check for fission matrix
+  if (check_for_node(root, "fission_matrix")) {
+    xml_node node_fm = root.child("fission_matrix");
+
+    // See if the fission matrix is enabled
+    if (check_for_node(node_fm, "enable")) {
+      fission_matrix_on = get_node_value_bool(node_fm, "enable");
+    } else {
+      fission_matrix_on = true;
+    }
+
+    // Number of inactive batches between corrections of the source
+    if (check_for_node(node_fm, "interval")) {
+      fission_matrix_interval = std::stoi(get_node_value(node_fm, "interval"));
+    }
+    if (fission_matrix_interval < 0) {
+      fatal_error("Fission matrix interval must be non-negative.");
+    }
+
+    if (fission_matrix_on && !entropy_on) {
+      fatal_error("The fission matrix is tallied on the Shannon entropy mesh, "
+                  "so an <entropy_mesh> element must be given.");
+    }
+  }
+
+  // Check for Wielandt shift of the eigenvalue
+  if (check_for_node(root, "wielandt_shift")) {
+    wielandt_shift = std::stod(get_node_value(root, "wielandt_shift"));
+    if (wielandt_shift < 0.0) {
+      fatal_error("Wielandt shift must be non-negative.");
+    }
+  }
+
+  // Check for iterated fission probability tallies
+  if (check_for_node(root, "ifp_n_generation")) {
+    ifp_n_generation = std::stoi(get_node_value(root, "ifp_n_generation"));
+    if (ifp_n_generation <= 0) {
+      fatal_error("Number of generations for iterated fission probability "
+                  "must be positive.");
+    }
+    if (run_mode != RunMode::EIGENVALUE) {
+      fatal_error("Iterated fission probability can only be used in an "
+                  "eigenvalue calculation.");
+    }
+    if (wielandt_shift > 0.0) {
+      fatal_error("Iterated fission probability cannot be used with a "
+                  "Wielandt shift.");
+    }
+    if (n_inactive * gen_per_batch < ifp_n_generation) {
+      warning("Iterated fission probability tallies are not scored until "
+              "source sites have ancestors for all generations, so the number "
+              "of inactive generations should be at least the number of "
+              "generations for iterated fission probability.");
+    }
+  }
+
   // Get volume calculations
   for (pugi::xml_node node_vol : root.children("volume_calc")) {
     model::volume_calcs.emplace_back(node_vol);
@@ -801,6 +1169,9 @@ void read_settings_xml()
     temperature_tolerance =
       std::stod(get_node_value(root, "temperature_tolerance"));
   }
+  if (check_for_node(root, "temperature_lazy")) {
+    temperature_lazy = get_node_value_bool(root, "temperature_lazy");
+  }
   if (check_for_node(root, "temperature_multipole")) {
     temperature_multipole = get_node_value_bool(root, "temperature_multipole");
 
@@ -810,6 +1181,10 @@ void read_settings_xml()
                   "photon transport.");
     }
   }
+  if (check_for_node(root, "temperature_multipole_quadrature")) {
+    temperature_multipole_quadrature =
+      get_node_value_bool(root, "temperature_multipole_quadrature");
+  }
   if (check_for_node(root, "temperature_range")) {
     auto range = get_node_array<double>(root, "temperature_range");
     temperature_range[0] = range.at(0);
@@ -857,11 +1232,188 @@ void read_settings_xml()
     event_based = get_node_value_bool(root, "event_based");
   }
 
+  // Check whether secondaries are shared between particle buffer slots
+  if (check_for_node(root, "event_secondary_queue")) {
+    event_secondary_queue = get_node_value_bool(root, "event_secondary_queue");
+  }
+
+  // Check whether the source bank exchange overlaps with transport
+  if (check_for_node(root, "pipelined_bank")) {
+    pipelined_bank = get_node_value_bool(root, "pipelined_bank");
+  }
+
+  // Check whether source sites are exchanged in compact form
+  if (check_for_node(root, "compact_bank")) {
+    compact_bank = get_node_value_bool(root, "compact_bank");
+  }
+
+  // Check whether rectangular lattice distances are updated incrementally
+  if (check_for_node(root, "lattice_dda")) {
+    lattice_dda = get_node_value_bool(root, "lattice_dda");
+  }
+
+  // Check whether neighbor lists are filled during geometry initialization
+  if (check_for_node(root, "precompute_neighbors")) {
+    precompute_neighbors = get_node_value_bool(root, "precompute_neighbors");
+  }
+
+  // Check whether time spent in parts of transport is measured
+  if (check_for_node(root, "profile")) {
+    profile = get_node_value_bool(root, "profile");
+  }
+
+  // Check whether time is attributed to materials, cells, and tallies, which
+  // requires the transport regions to be timed
+  if (check_for_node(root, "profile_domains")) {
+    profile_domains = get_node_value_bool(root, "profile_domains");
+    if (profile_domains)
+      profile = true;
+  }
+
+  // Check whether cross section lookups in event-based mode are batched
+  if (check_for_node(root, "event_xs_batch_size")) {
+    event_xs_batch_size =
+      std::stoll(get_node_value(root, "event_xs_batch_size"));
+    if (event_xs_batch_size < 0) {
+      fatal_error("Event-based cross section batch size must be non-negative.");
+    }
+  }
+
+  // Policy for choosing the next event kernel
+  if (check_for_node(root, "event_schedule")) {
+    auto temp = get_node_value(root, "event_schedule", true, true);
+    if (temp == "longest") {
+      event_schedule = EventSchedule::LONGEST;
+    } else if (temp == "ordered") {
+      event_schedule = EventSchedule::ORDERED;
+    } else {
+      fatal_error("Unrecognized event schedule: " + temp + ".");
+    }
+  }
+
+  // Policy for distributing histories among threads
+  if (check_for_node(root, "history_schedule")) {
+    auto temp = get_node_value(root, "history_schedule", true, true);
+    if (temp == "loop") {
+      history_schedule = HistorySchedule::LOOP;
+    } else if (temp == "work_stealing") {
+      history_schedule = HistorySchedule::WORK_STEALING;
+    } else {
+      fatal_error("Unrecognized history schedule: " + temp + ".");
+    }
+  }
+
+  // Number of fixed source histories that a process claims at a time
+  if (check_for_node(root, "work_chunk_size")) {
+    work_chunk_size = std::stoll(get_node_value(root, "work_chunk_size"));
+    if (work_chunk_size < 0) {
+      fatal_error("Work chunk size must be non-negative.");
+    }
+    if (work_chunk_size > 0 && event_based) {
+      warning("Histories are only claimed in chunks in history-based mode. "
+              "The work chunk size will be ignored.");
+    }
+  }
+
+  // Minimum number of particles in an event queue for it to be sorted
+  if (check_for_node(root, "event_sort_threshold")) {
+    event_sort_threshold =
+      std::stoll(get_node_value(root, "event_sort_threshold"));
+    if (event_sort_threshold < 0) {
+      fatal_error("Event-based sort threshold must be non-negative.");
+    }
+  }
+
+  // Minimum number of particles for a kernel to run in the ordered schedule
+  if (check_for_node(root, "event_min_queue_size")) {
+    event_min_queue_size =
+      std::stoll(get_node_value(root, "event_min_queue_size"));
+    if (event_min_queue_size < 0) {
+      fatal_error("Event-based minimum queue size must be non-negative.");
+    }
+  }
+
+  // Fraction of particles in flight below which new source particles are
+  // started in free slots
+  if (check_for_node(root, "event_refill_threshold")) {
+    event_refill_threshold =
+      std::stod(get_node_value(root, "event_refill_threshold"));
+    if (event_refill_threshold < 0.0 || event_refill_threshold > 1.0) {
+      fatal_error("Event-based refill threshold must be between 0 and 1.");
+    }
+  }
+
+  // Stripe size of the file system used to tune parallel HDF5 output
+  if (check_for_node(root, "io_stripe_size")) {
+    io_stripe_size = std::stoll(get_node_value(root, "io_stripe_size"));
+    if (io_stripe_size < 0) {
+      fatal_error("I/O stripe size must be non-negative.");
+    }
+  }
+
+  // Check whether performance settings should be tuned in inactive batches
+  if (check_for_node(root, "auto_tune")) {
+    auto_tune = get_node_value_bool(root, "auto_tune");
+  }
+
+  // Check whether state points should be written in the background
+  if (check_for_node(root, "async_statepoint")) {
+    async_statepoint = get_node_value_bool(root, "async_statepoint");
+#ifdef PHDF5
+    if (async_statepoint) {
+      warning("State points are written collectively with parallel HDF5 "
+              "and cannot be written in the background.");
+      async_statepoint = false;
+    }
+#endif
+  }
+
   // Check whether material cell offsets should be generated
   if (check_for_node(root, "material_cell_offsets")) {
     material_cell_offsets = get_node_value_bool(root, "material_cell_offsets");
   }
 
+  // Check for the random ray solver
+  if (check_for_node(root, "random_ray")) {
+    xml_node node_ray = root.child("random_ray");
+    random_ray = true;
+    if (run_CE) {
+      fatal_error("The random ray solver requires multigroup cross sections.");
+    }
+    if (run_mode != RunMode::EIGENVALUE && run_mode != RunMode::FIXED_SOURCE) {
+      fatal_error("The random ray solver requires an eigenvalue or fixed "
+                  "source run.");
+    }
+    if (check_for_node(node_ray, "distance_active")) {
+      random_ray_distance_active =
+        std::stod(get_node_value(node_ray, "distance_active"));
+    }
+    if (check_for_node(node_ray, "distance_inactive")) {
+      random_ray_distance_inactive =
+        std::stod(get_node_value(node_ray, "distance_inactive"));
+    }
+    if (random_ray_distance_active <= 0.0 ||
+        random_ray_distance_inactive < 0.0) {
+      fatal_error("Random ray active distance must be positive and inactive "
+                  "distance must not be negative.");
+    }
+    if (!check_for_node(node_ray, "lower_left") ||
+        !check_for_node(node_ray, "upper_right")) {
+      fatal_error("Random ray solver requires the lower-left and upper-right "
+                  "corners of the box that rays start in.");
+    }
+    auto ll = get_node_array<double>(node_ray, "lower_left");
+    auto ur = get_node_array<double>(node_ray, "upper_right");
+    if (ll.size() != 3 || ur.size() != 3) {
+      fatal_error("Random ray box corners must have three coordinates.");
+    }
+    random_ray_lower_left = {ll[0], ll[1], ll[2]};
+    random_ray_upper_right = {ur[0], ur[1], ur[2]};
+
+    // Source regions are numbered with the offsets of material cells
+    material_cell_offsets = true;
+  }
+
   // Weight window information
   for (pugi::xml_node node_ww : root.children("weight_windows")) {
     variance_reduction::weight_windows.emplace_back(
@@ -871,17 +1423,78 @@ void read_settings_xml()
     settings::weight_windows_on = true;
   }
 
+  for (pugi::xml_node node_wwg : root.children("weight_window_generator")) {
+    variance_reduction::generators.push_back(
+      make_unique<WeightWindowsGenerator>(node_wwg));
+    settings::weight_windows_on = true;
+    if (variance_reduction::generators.back()->method() ==
+        WeightWindowMethod::FW_CADIS) {
+      fw_cadis = true;
+    }
+  }
+
   if (check_for_node(root, "weight_windows_on")) {
     weight_windows_on = get_node_value_bool(root, "weight_windows_on");
   }
 
+  if (check_for_node(root, "weight_window_mesh_crossings")) {
+    weight_window_mesh_crossings =
+      get_node_value_bool(root, "weight_window_mesh_crossings");
+  }
+
   if (check_for_node(root, "max_splits")) {
     settings::max_splits = std::stoi(get_node_value(root, "max_splits"));
   }
 
+  if (check_for_node(root, "secondary_bank_capacity")) {
+    secondary_bank_capacity =
+      std::stoll(get_node_value(root, "secondary_bank_capacity"));
+    if (secondary_bank_capacity < 1) {
+      fatal_error("Secondary bank capacity must be at least one.");
+    }
+  }
+
   if (check_for_node(root, "max_tracks")) {
     settings::max_tracks = std::stoi(get_node_value(root, "max_tracks"));
   }
+
+  if (check_for_node(root, "track_writer_thread")) {
+    track_writer_thread = get_node_value_bool(root, "track_writer_thread");
+  }
+
+  // Sampling and storage of particle tracks
+  if (check_for_node(root, "track_fraction")) {
+    track_fraction = std::stod(get_node_value(root, "track_fraction"));
+    if (track_fraction <= 0.0 || track_fraction > 1.0) {
+      fatal_error("Track fraction must be greater than 0 and at most 1.");
+    }
+  }
+  if (check_for_node(root, "track_region")) {
+    track_region = get_node_array<double>(root, "track_region");
+    if (track_region.size() != 6) {
+      fatal_error("Must provide 6 values for <track_region> that specify the "
+                  "lower-left and upper-right corners of the region.");
+    }
+  }
+  if (check_for_node(root, "track_compression")) {
+    track_compression = std::stoi(get_node_value(root, "track_compression"));
+    if (track_compression < 0 || track_compression > 9) {
+      fatal_error("Track compression level must be between 0 and 9.");
+    }
+  }
+  if (check_for_node(root, "track_precision")) {
+    auto precision = get_node_value(root, "track_precision", true, true);
+    if (precision == "single") {
+      track_single_precision = true;
+    } else if (precision == "double") {
+      track_single_precision = false;
+    } else {
+      fatal_error("Unrecognized track precision: " + precision);
+    }
+  }
+  if (check_for_node(root, "track_delta_positions")) {
+    track_delta_positions = get_node_value_bool(root, "track_delta_positions");
+  }
 }
 
 void free_memory_settings()
@@ -890,6 +1503,9 @@ void free_memory_settings()
   settings::sourcepoint_batch.clear();
   settings::source_write_surf_id.clear();
   settings::res_scat_nuclides.clear();
+  settings::delta_tracking_universes.clear();
+  settings::census_times.clear();
+  settings::track_region.clear();
 }
 
 //==============================================================================
@@ -1,28 +1,43 @@
 #include "openmc/simulation.h"
 
+#include "openmc/auto_tune.h"
 #include "openmc/bank.h"
 #include "openmc/capi.h"
+#include "openmc/census.h"
 #include "openmc/container_util.h"
+#include "openmc/delta_tracking.h"
 #include "openmc/eigenvalue.h"
 #include "openmc/error.h"
 #include "openmc/event.h"
+#include "openmc/geometry.h"
 #include "openmc/geometry_aux.h"
+#include "openmc/huge_pages.h"
+#include "openmc/ifp.h"
 #include "openmc/material.h"
+#include "openmc/memory_usage.h"
 #include "openmc/message_passing.h"
+#include "openmc/mgxs_interface.h"
 #include "openmc/nuclide.h"
+#include "openmc/offload.h"
+#include "openmc/openmp_interface.h"
 #include "openmc/output.h"
 #include "openmc/particle.h"
 #include "openmc/photon.h"
+#include "openmc/profile.h"
 #include "openmc/random_lcg.h"
 #include "openmc/settings.h"
 #include "openmc/source.h"
 #include "openmc/state_point.h"
+#include "openmc/surface.h"
 #include "openmc/tallies/derivative.h"
 #include "openmc/tallies/filter.h"
+#include "openmc/tallies/flux_spectrum.h"
 #include "openmc/tallies/tally.h"
+#include "openmc/tallies/tally_stream.h"
 #include "openmc/tallies/trigger.h"
 #include "openmc/timer.h"
 #include "openmc/track_output.h"
+#include "openmc/weight_windows.h"
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -37,6 +52,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <mutex> // for lock_guard
 #include <string>
 
 //==============================================================================
@@ -52,11 +68,15 @@ int openmc_run()
   openmc::simulation::time_total.start();
   openmc_simulation_init();
 
+  // No results are read between batches, so reducing tallies may be deferred
+  // as requested by <tally_reduce_interval>
+  openmc::simulation::tally_results_deferrable = true;
   int err = 0;
   int status = 0;
   while (status == 0 && err == 0) {
     err = openmc_next_batch(&status);
   }
+  openmc::simulation::tally_results_deferrable = false;
 
   openmc_simulation_finalize();
   openmc::simulation::time_total.stop();
@@ -78,33 +98,102 @@ int openmc_simulation_init()
 
   // Determine how much work each process should do
   calculate_work();
+  if (dynamic_work()) {
+    create_work_counter();
+  }
 
   // Allocate source, fission and surface source banks.
   allocate_banks();
 
+  // Clear counters of transport events and profiled regions
+  reset_profile();
+
+  // Clear resonance scattering statistics, which are summed onto the master
+  // process at the end of each simulation
+  simulation::n_res_scat_samples = 0;
+  simulation::n_res_scat_trials = 0;
+
+  // The number of threads may have changed since the overlap check counts
+  // were allocated
+  if (settings::check_overlaps)
+    init_overlap_check_count();
+
+  // Clear the counts of neighbor list misses on each surface
+  for (auto& surf : model::surfaces) {
+    surf->n_search_failures_ = 0;
+    surf->n_recoveries_ = 0;
+  }
+
   // Create track file if needed
   if (!settings::track_identifiers.empty() || settings::write_all_tracks) {
     open_track_file();
   }
 
+  // Size the compact microscopic cross section cache before any particles
+  // are created
+  if (settings::run_CE && settings::compact_micro_xs) {
+    simulation::n_micro_xs_compact = compact_micro_xs_size();
+  }
+
   // If doing an event-based simulation, intialize the particle buffer
   // and event queues
   if (settings::event_based) {
     int64_t event_buffer_length =
       std::min(simulation::work_per_rank, settings::max_particles_in_flight);
     init_event_queues(event_buffer_length);
+
+    // Map tabulated cross sections to the offload device, if any
+    offload_init(event_buffer_length);
   }
 
   // Allocate tally results arrays if they're not allocated yet
   for (auto& t : model::tallies) {
     t->init_results();
   }
+  print_huge_page_usage(PageUse::TALLIES);
 
-  // Set up material nuclide index mapping
+  // Set up material nuclide index mapping. Mappings from a previous
+  // simulation are kept current as nuclides are added to materials.
+  size_t n_nuclides =
+    settings::run_CE ? data::nuclides.size() : data::mg.nuclides_.size();
   for (auto& mat : model::materials) {
-    mat->init_nuclide_index();
+    if (mat->mat_nuclide_index_.size() != n_nuclides)
+      mat->init_nuclide_index();
   }
 
+  // Compute majorants for delta tracking
+  init_delta_tracking();
+
+  // Restrict box sources to the voxels where their positions can be accepted
+  for (auto& s : model::external_sources) {
+    if (auto src = dynamic_cast<IndependentSource*>(s.get()))
+      src->build_domain_grid();
+  }
+
+  // Source files that are overwritten during the simulation can't be sampled
+  // from a memory map
+  for (auto& s : model::external_sources) {
+    if (auto src = dynamic_cast<FileSource*>(s.get()))
+      src->unmap_if_written();
+  }
+
+  // Pick the transport loop for the features used by the model
+  select_transport_features();
+
+  // Plan the configurations tried in inactive batches
+  init_auto_tune();
+
+  // Make progress on communication in flight while particles are transported
+  if (settings::mpi_progress_thread)
+    mpi::start_progress_thread();
+
+  // Start publishing tally results after each batch
+  start_tally_stream();
+
+  // Allocate the fission matrix before it may be read from a state point
+  if (settings::run_mode == RunMode::EIGENVALUE && settings::fission_matrix_on)
+    init_fission_matrix();
+
   // Reset global variables -- this is done before loading state point (as that
   // will potentially populate k_generation and entropy)
   simulation::current_batch = 0;
@@ -124,6 +213,10 @@ int openmc_simulation_init()
     }
   }
 
+  // Report the memory held by each subsystem once everything is allocated
+  update_memory_usage();
+  print_memory_usage();
+
   // Display header
   if (mpi::master) {
     if (settings::run_mode == RunMode::FIXED_SOURCE) {
@@ -152,25 +245,62 @@ int openmc_simulation_finalize()
   simulation::time_active.stop();
   simulation::time_finalize.start();
 
-  // Clear material nuclide mapping
-  for (auto& mat : model::materials) {
-    mat->mat_nuclide_index_.clear();
-  }
+  // Release cross sections mapped to the offload device
+  offload_free();
 
   // Close track file if open
   if (!settings::track_identifiers.empty() || settings::write_all_tracks) {
     close_track_file();
   }
 
+  // Publish the final results of the tally stream
+  stop_tally_stream();
+
   // Increment total number of generations
   simulation::total_gen += simulation::current_batch * settings::gen_per_batch;
 
+  // Complete the source bank exchange of the final generation
+  finish_bank_exchange();
+  mpi::stop_progress_thread();
+
+  // Release the counter used to claim histories
+  free_work_counter();
+
+  // Complete the state point or source file being written in the background
+  finish_async_writes();
+
 #ifdef OPENMC_MPI
   broadcast_results();
+
+  // Sum resonance scattering statistics over all processes
+  if (settings::res_scat_on) {
+    int64_t n_res_scat[] {
+      simulation::n_res_scat_samples, simulation::n_res_scat_trials};
+    MPI_Reduce(mpi::master ? MPI_IN_PLACE : n_res_scat, n_res_scat, 2,
+      MPI_INT64_T, MPI_SUM, 0, mpi::intracomm);
+    simulation::n_res_scat_samples = n_res_scat[0];
+    simulation::n_res_scat_trials = n_res_scat[1];
+  }
+
+  // Sum majorant violations over all processes
+  if (settings::delta_tracking) {
+    MPI_Reduce(mpi::master ? MPI_IN_PLACE : &simulation::n_majorant_violations,
+      &simulation::n_majorant_violations, 1, MPI_INT64_T, MPI_SUM, 0,
+      mpi::intracomm);
+  }
 #endif
 
-  // Write tally results to tallies.out
-  if (settings::output_tallies && mpi::master)
+  // The majorant only bounds the total cross section where it is computed
+  // from tabulated data, e.g. not for windowed multipole data
+  if (mpi::master && simulation::n_majorant_violations > 0) {
+    warning(fmt::format("The total cross section exceeded the delta tracking "
+                        "majorant at {} tentative collisions.",
+      simulation::n_majorant_violations));
+  }
+
+  // Write tally results to tallies.out. Results on the master process only
+  // cover that process when each process writes its own tally results.
+  if (settings::output_tallies && mpi::master && !settings::tally_rank_files)
     write_tallies();
 
   // Deactivate all tallies
@@ -178,9 +308,18 @@ int openmc_simulation_finalize()
     t->active_ = false;
   }
 
+  // Combine the flux spectrum from all processes so that it can be collapsed
+  // on any of them
+  if (model::flux_spectrum.active()) {
+    model::flux_spectrum.reduce();
+    model::flux_spectrum.set_active(false);
+  }
+
   // Stop timers and show timing statistics
   simulation::time_finalize.stop();
   simulation::time_total.stop();
+  if (settings::profile)
+    reduce_profile();
   if (mpi::master) {
     if (settings::verbosity >= 6)
       print_runtime();
@@ -189,6 +328,10 @@ int openmc_simulation_finalize()
   }
   if (settings::check_overlaps)
     print_overlap_check();
+  if (settings::crossing_recovery)
+    print_crossing_recovery();
+  update_memory_usage();
+  print_memory_usage();
 
   // Reset flags
   simulation::initialized = false;
@@ -217,12 +360,19 @@ int openmc_next_batch(int* status)
     // Start timer for transport
     simulation::time_transport.start();
 
-    // Transport loop
-    if (settings::event_based) {
-      transport_event_based();
-    } else {
-      transport_history_based();
+    // Transport loop, which is repeated for each time window when particles
+    // are banked at census times
+    for (int i = 0; i <= settings::census_times.size(); ++i) {
+      simulation::current_census = i;
+      if (i > 0)
+        comb_census_bank();
+      if (settings::event_based) {
+        transport_event_based();
+      } else {
+        transport_history_based();
+      }
     }
+    simulation::current_census = 0;
 
     // Accumulate time for transport
     simulation::time_transport.stop();
@@ -280,15 +430,58 @@ bool satisfy_triggers {false};
 int total_gen {0};
 double total_weight;
 int64_t work_per_rank;
+int n_micro_xs_compact {0};
+int64_t n_res_scat_samples {0};
+int64_t n_res_scat_trials {0};
 
 const RegularMesh* entropy_mesh {nullptr};
 const RegularMesh* ufs_mesh {nullptr};
 
 vector<double> k_generation;
+vector<double> log_grid_energy;
 vector<int64_t> work_index;
 
+#ifdef OPENMC_MPI
+MPI_Win work_counter {MPI_WIN_NULL};
+#endif
+
 } // namespace simulation
 
+namespace {
+
+// Data and settings that the energy grids of nuclides and materials were last
+// set up for, so that the grids are only set up again when one changes
+vector<double> grid_inputs;
+
+//! Set up unionized energy grids and tabulated macroscopic cross sections for
+//! materials. Materials clear their grids and tables when their nuclides or
+//! densities are changed, so unless all are rebuilt only those are set up.
+void init_material_grids(bool rebuild)
+{
+  size_t bytes = 0;
+  for (auto& mat : model::materials) {
+    bool new_grid = false;
+    if ((settings::union_grid || mat->tabulate_xs_) &&
+        (rebuild || mat->union_grid_.energy.empty())) {
+      bytes += mat->init_union_grid();
+      new_grid = true;
+    }
+    if (mat->tabulate_xs_ && (new_grid || mat->macro_xs_tables_.empty())) {
+      bytes += mat->init_macro_xs_tables();
+    }
+    if (settings::photon_transport &&
+        (rebuild || mat->photon_union_grid_.energy.empty())) {
+      bytes += mat->init_photon_union_grid();
+    }
+  }
+  if (bytes > 0) {
+    write_message(
+      6, "Memory used by unionized energy grids: {:.1f} MB", bytes / 1.0e6);
+  }
+}
+
+} // namespace
+
 //==============================================================================
 // Non-member functions
 //==============================================================================
@@ -301,12 +494,33 @@ void allocate_banks()
 
     // Allocate fission bank
     init_fission_bank(3 * simulation::work_per_rank);
+
+    // Source sites start out without ancestors, which they gain one
+    // generation at a time
+    if (settings::ifp_n_generation > 0)
+      init_ifp_source_bank();
   }
 
-  if (settings::surf_source_write) {
+  if (settings::surf_source_stream) {
+    // Allocate a buffer for each thread and open the file they are written to
+#ifdef _OPENMP
+    int n_threads = omp_get_max_threads();
+#else
+    int n_threads = 1;
+#endif
+    simulation::surf_source_buffers.resize(n_threads);
+    for (auto& buffer : simulation::surf_source_buffers) {
+      buffer.reserve(SURF_SOURCE_BUFFER_SIZE);
+    }
+    open_surf_source_stream();
+  } else if (settings::surf_source_write) {
     // Allocate surface source bank
     simulation::surf_source_bank.reserve(settings::max_surface_particles);
   }
+
+  if (!settings::census_times.empty()) {
+    init_census_bank();
+  }
 }
 
 void initialize_batch()
@@ -341,19 +555,37 @@ void initialize_batch()
     for (auto& t : model::tallies) {
       t->active_ = true;
     }
+    model::flux_spectrum.set_active(true);
   }
 
   // Add user tallies to active tallies list
   setup_active_tallies();
+
+  // Try the next configuration of the auto-tuned settings
+  auto_tune_initialize_batch();
 }
 
 void finalize_batch()
 {
+  // Time the configuration of the auto-tuned settings
+  auto_tune_finalize_batch();
+
   // Reduce tallies onto master process and accumulate
   simulation::time_tallies.start();
   accumulate_tallies();
   simulation::time_tallies.stop();
 
+  // Hand the accumulated results to the tally stream
+  if (simulation::current_batch > settings::n_inactive)
+    publish_tally_stream();
+
+  // Update the weight windows from the flux accumulated so far
+  update_weight_windows();
+
+  // Add up the overlap checks made by each thread
+  if (settings::check_overlaps)
+    reduce_overlap_check_count();
+
   // Reset global tally results
   if (simulation::current_batch <= settings::n_inactive) {
     xt::view(simulation::global_tallies, xt::all()) = 0.0;
@@ -401,18 +633,26 @@ void finalize_batch()
   }
 
   // Write out surface source if requested.
-  if (settings::surf_source_write &&
+  if (settings::surf_source_stream &&
       simulation::current_batch == settings::n_batches) {
+    close_surf_source_stream();
+  } else if (settings::surf_source_write &&
+             simulation::current_batch == settings::n_batches) {
     auto filename = settings::path_output + "surface_source.h5";
     write_source_point(filename.c_str(), true);
   }
+
+  // Raise the high-water marks of subsystems that grew during the batch
+  update_memory_usage();
 }
 
 void initialize_generation()
 {
   if (settings::run_mode == RunMode::EIGENVALUE) {
-    // Clear out the fission bank
+    // Clear out the fission bank, giving back the space it grew into to hold
+    // sites that overflowed its capacity in the last generation
     simulation::fission_bank.resize(0);
+    simulation::fission_bank.restore_capacity();
 
     // Count source sites if using uniform fission source weighting
     if (settings::ufs_on)
@@ -421,6 +661,10 @@ void initialize_generation()
     // Store current value of tracklength k
     simulation::keff_generation = simulation::global_tallies(
       GlobalTally::K_TRACKLENGTH, TallyResult::VALUE);
+
+    // Shift the eigenvalue from the latest estimate of k
+    simulation::k_shift = simulation::keff + settings::wielandt_shift;
+    simulation::wielandt_weight = 0.0;
   }
 }
 
@@ -447,14 +691,34 @@ void finalize_generation()
   global_tally_leakage = 0.0;
 
   if (settings::run_mode == RunMode::EIGENVALUE) {
+    // Gather any sites that overflowed the fission bank's capacity into one
+    // array until the next generation
+    simulation::fission_bank.consolidate();
+
+    // Start summing values of the generation over all processes, which is
+    // completed while the fission bank is sorted
+    set_generation_sums();
+    mpi::generation_sums.start();
+
     // If using shared memory, stable sort the fission bank (by parent IDs)
     // so as to allow for reproducibility regardless of which order particles
     // are run in.
     sort_fission_bank();
 
+    // Tally the fission matrix during inactive batches, before the source
+    // bank is replaced
+    bool tally_fm = settings::fission_matrix_on &&
+                    simulation::current_batch <= settings::n_inactive;
+    if (tally_fm)
+      tally_fission_matrix();
+
     // Distribute fission bank across processors evenly
     synchronize_bank();
 
+    // Correct the new source with the fission matrix at the end of a batch
+    if (tally_fm && simulation::current_gen == settings::gen_per_batch)
+      update_fission_matrix();
+
     // Calculate shannon entropy
     if (settings::entropy_on)
       shannon_entropy();
@@ -470,21 +734,33 @@ void finalize_generation()
   }
 }
 
-void initialize_history(Particle& p, int64_t index_source)
+int64_t fixed_source_id(int64_t index_source)
+{
+  return (simulation::total_gen + overall_generation() - 1) *
+           settings::n_particles +
+         simulation::work_index[mpi::rank] + index_source;
+}
+
+void initialize_history(
+  Particle& p, int64_t index_source, const SourceSite* site)
 {
   // set defaults
   if (settings::run_mode == RunMode::EIGENVALUE) {
     // set defaults for eigenvalue simulations from primary bank
     p.from_source(&simulation::source_bank[index_source - 1]);
   } else if (settings::run_mode == RunMode::FIXED_SOURCE) {
-    // initialize random number seed
-    int64_t id = (simulation::total_gen + overall_generation() - 1) *
-                   settings::n_particles +
-                 simulation::work_index[mpi::rank] + index_source;
-    uint64_t seed = init_seed(id, STREAM_SOURCE);
-    // sample from external source distribution or custom library then set
-    auto site = sample_external_source(&seed);
-    p.from_source(&site);
+    if (simulation::current_census > 0) {
+      // continue particles combed from the census bank
+      p.from_source(&simulation::census_source[index_source - 1]);
+    } else if (site) {
+      p.from_source(site);
+    } else {
+      // initialize random number seed
+      uint64_t seed = init_seed(fixed_source_id(index_source), STREAM_SOURCE);
+      // sample from external source distribution or custom library then set
+      auto sampled = sample_external_source(&seed);
+      p.from_source(&sampled);
+    }
   }
   p.current_work() = index_source;
 
@@ -503,10 +779,11 @@ void initialize_history(Particle& p, int64_t index_source)
   // Reset weight window ratio
   p.ww_factor() = 0.0;
 
+  // Meshes may have changed since the last particle was tracked
+  p.mesh_bin_cache() = {};
+
   // set random number seed
-  int64_t particle_seed =
-    (simulation::total_gen + overall_generation() - 1) * settings::n_particles +
-    p.id();
+  int64_t particle_seed = census_generation() * settings::n_particles + p.id();
   init_particle_seeds(particle_seed, p.seeds());
 
   // set particle trace
@@ -524,9 +801,12 @@ void initialize_history(Particle& p, int64_t index_source)
     write_message("Simulating Particle {}", p.id());
   }
 
-// Add paricle's starting weight to count for normalizing tallies later
+  // Add paricle's starting weight to count for normalizing tallies later. The
+  // weight of particles continued from a census was counted at their source.
+  if (simulation::current_census == 0) {
 #pragma omp atomic
-  simulation::total_weight += p.wgt();
+    simulation::total_weight += p.wgt();
+  }
 
   // Force calculation of cross-sections by setting last energy to zero
   if (settings::run_CE) {
@@ -569,18 +849,93 @@ void calculate_work()
   }
 }
 
+bool dynamic_work()
+{
+  return settings::work_chunk_size > 0 && mpi::n_procs > 1 &&
+         settings::run_mode == RunMode::FIXED_SOURCE && !settings::event_based;
+}
+
+void create_work_counter()
+{
+#ifdef OPENMC_MPI
+  // The counter lives on the master process, and a passive access epoch is
+  // kept open so that any process can update it at any time
+  MPI_Aint size = mpi::master ? sizeof(int64_t) : 0;
+  int64_t* counter;
+  MPI_Win_allocate(size, sizeof(int64_t), MPI_INFO_NULL, mpi::intracomm,
+    &counter, &simulation::work_counter);
+  if (mpi::master)
+    *counter = 0;
+  MPI_Win_lock_all(0, simulation::work_counter);
+#endif
+}
+
+void free_work_counter()
+{
+#ifdef OPENMC_MPI
+  if (simulation::work_counter != MPI_WIN_NULL) {
+    MPI_Win_unlock_all(simulation::work_counter);
+    MPI_Win_free(&simulation::work_counter);
+  }
+#endif
+}
+
+void reset_work_counter()
+{
+#ifdef OPENMC_MPI
+  // The barriers ensure that every process has stopped claiming histories of
+  // the previous generation before the reset, and that none claims histories
+  // of this generation before it
+  MPI_Barrier(mpi::intracomm);
+  if (mpi::master) {
+    int64_t zero = 0;
+    MPI_Accumulate(&zero, 1, MPI_INT64_T, 0, 0, 1, MPI_INT64_T, MPI_REPLACE,
+      simulation::work_counter);
+    MPI_Win_flush(0, simulation::work_counter);
+  }
+  MPI_Barrier(mpi::intracomm);
+#endif
+}
+
+bool claim_work_chunk(int64_t* i_begin, int64_t* i_end)
+{
+#ifdef OPENMC_MPI
+  int64_t chunk = settings::work_chunk_size;
+  int64_t start;
+  MPI_Fetch_and_op(&chunk, &start, MPI_INT64_T, 0, 0, MPI_SUM,
+    simulation::work_counter);
+  MPI_Win_flush(0, simulation::work_counter);
+  if (start >= settings::n_particles)
+    return false;
+
+  // Histories are indexed relative to the first history that this process
+  // would be given by calculate_work(), so particle IDs, and hence random
+  // number seeds, do not depend on which process runs them
+  int64_t end = std::min(start + chunk, settings::n_particles);
+  *i_begin = start - simulation::work_index[mpi::rank];
+  *i_end = end - simulation::work_index[mpi::rank];
+  return true;
+#else
+  return false;
+#endif
+}
+
 void initialize_data()
 {
   // Determine minimum/maximum energy for incident neutron/photon data
   data::energy_max = {INFTY, INFTY};
   data::energy_min = {0.0, 0.0};
   for (const auto& nuc : data::nuclides) {
-    if (nuc->grid_.size() >= 1) {
+    // Use the first temperature that has been read (see temperature_lazy)
+    for (const auto& grid : nuc->grid_) {
+      if (grid.energy.empty())
+        continue;
       int neutron = static_cast<int>(ParticleType::neutron);
       data::energy_min[neutron] =
-        std::max(data::energy_min[neutron], nuc->grid_[0].energy.front());
+        std::max(data::energy_min[neutron], grid.energy.front());
       data::energy_max[neutron] =
-        std::min(data::energy_max[neutron], nuc->grid_[0].energy.back());
+        std::min(data::energy_max[neutron], grid.energy.back());
+      break;
     }
   }
 
@@ -596,7 +951,7 @@ void initialize_data()
       }
     }
 
-    if (settings::electron_treatment == ElectronTreatment::TTB) {
+    if (settings::electron_treatment != ElectronTreatment::LED) {
       // Determine if minimum/maximum energy for bremsstrahlung is greater/less
       // than the current minimum/maximum
       if (data::ttb_e_grid.size() >= 1) {
@@ -614,8 +969,10 @@ void initialize_data()
   for (const auto& nuc : data::nuclides) {
     // If a nuclide is present in a material that's not used in the model, its
     // grid has not been allocated
-    if (nuc->grid_.size() > 0) {
-      double max_E = nuc->grid_[0].energy.back();
+    auto grid = std::find_if(nuc->grid_.begin(), nuc->grid_.end(),
+      [](const Nuclide::EnergyGrid& g) { return !g.energy.empty(); });
+    if (grid != nuc->grid_.end()) {
+      double max_E = grid->energy.back();
       int neutron = static_cast<int>(ParticleType::neutron);
       if (max_E == data::energy_max[neutron]) {
         write_message(7, "Maximum neutron transport energy: {} eV for {}",
@@ -629,14 +986,57 @@ void initialize_data()
     }
   }
 
-  // Set up logarithmic grid for nuclides
-  for (auto& nuc : data::nuclides) {
-    nuc->init_grid();
-  }
+  // The grids set up for a previous simulation can be kept unless the energy
+  // range, grid settings, or nuclide data they were built from have changed
   int neutron = static_cast<int>(ParticleType::neutron);
+  int n_grids = 0;
+  for (const auto& nuc : data::nuclides) {
+    for (const auto& grid : nuc->grid_) {
+      if (!grid.energy.empty())
+        ++n_grids;
+    }
+  }
+  vector<double> inputs {data::energy_min[neutron], data::energy_max[neutron],
+    static_cast<double>(settings::n_log_bins),
+    static_cast<double>(settings::hash_grid_points_per_bin),
+    static_cast<double>(data::nuclides.size()), static_cast<double>(n_grids),
+    static_cast<double>(settings::union_grid),
+    static_cast<double>(settings::photon_transport),
+    static_cast<double>(static_cast<int>(settings::temperature_method))};
+  bool changed = inputs != grid_inputs;
+  grid_inputs = inputs;
+
+  if (!changed) {
+    init_material_grids(false);
+    return;
+  }
+
+  // Set up logarithmic grid for nuclides
   simulation::log_spacing =
     std::log(data::energy_max[neutron] / data::energy_min[neutron]) /
     settings::n_log_bins;
+  simulation::log_grid_energy.resize(settings::n_log_bins + 1);
+  for (int k = 0; k <= settings::n_log_bins; ++k) {
+    simulation::log_grid_energy[k] =
+      data::energy_min[neutron] * std::exp(k * simulation::log_spacing);
+  }
+  size_t hash_bytes = 0;
+  Timer timer_grid;
+  timer_grid.start();
+  int n_nuclides = data::nuclides.size();
+#pragma omp parallel for reduction(+ : hash_bytes) schedule(dynamic)
+  for (int i = 0; i < n_nuclides; ++i) {
+    hash_bytes += data::nuclides[i]->init_grid();
+  }
+  timer_grid.stop();
+  write_message(
+    6, "Time initializing energy grids: {:.3f} s", timer_grid.elapsed());
+  if (settings::hash_grid_points_per_bin > 0) {
+    write_message(
+      6, "Memory used by hash energy grids: {:.1f} MB", hash_bytes / 1.0e6);
+  }
+
+  init_material_grids(true);
 }
 
 #ifdef OPENMC_MPI
@@ -644,6 +1044,11 @@ void broadcast_results()
 {
   // Broadcast tally results so that each process has access to results
   for (auto& t : model::tallies) {
+    if (t->sparse_results_) {
+      t->sparse_results_->broadcast();
+      continue;
+    }
+
     // Create a new datatype that consists of all values for a given filter
     // bin and then use that to broadcast. This is done to minimize the
     // chance of the 'count' argument of MPI_BCAST exceeding 2**31
@@ -678,40 +1083,238 @@ void free_memory_simulation()
 {
   simulation::k_generation.clear();
   simulation::entropy.clear();
+  simulation::log_grid_energy.clear();
+  grid_inputs.clear();
 }
 
-void transport_history_based_single_particle(Particle& p)
+namespace {
+
+//! Transport a particle with checks only for the features in Features
+template<unsigned Features>
+void transport_single_particle(Particle& p)
 {
   while (true) {
     p.event_calculate_xs();
     if (!p.alive())
       break;
-    p.event_advance();
+    p.event_advance<Features>();
+    p.event_tally_advance<Features>();
     if (p.collision_distance() > p.boundary().distance) {
       p.event_cross_surface();
     } else {
       p.event_collide();
+      p.event_tally_collision<Features>();
     }
-    p.event_revive_from_secondary();
+    p.event_revive_from_secondary<Features>();
     if (!p.alive())
       break;
   }
-  p.event_death();
+  p.event_death<Features>();
+}
+
+//! Transport loop picked by select_transport_features()
+void (*transport_function)(Particle&) = transport_single_particle<FEATURE_ALL>;
+
+} // namespace
+
+void select_transport_features()
+{
+  unsigned features = 0;
+  if (settings::delta_tracking)
+    features |= FEATURE_DELTA_TRACKING;
+  if (settings::weight_windows_on && settings::weight_window_mesh_crossings)
+    features |= FEATURE_WEIGHT_WINDOWS;
+  if (!settings::census_times.empty())
+    features |= FEATURE_CENSUS;
+  if (settings::write_all_tracks || !settings::track_identifiers.empty())
+    features |= FEATURE_TRACKS;
+  if (!model::tally_derivs.empty())
+    features |= FEATURE_DERIVATIVES;
+
+  // Use a loop instantiated for exactly these features if there is one and
+  // otherwise the loop that checks for every feature. The cases must match the
+  // instantiations of the events in particle.cpp.
+  switch (features) {
+  case 0:
+    transport_function = transport_single_particle<0>;
+    break;
+  case FEATURE_DELTA_TRACKING:
+    transport_function = transport_single_particle<FEATURE_DELTA_TRACKING>;
+    break;
+  case FEATURE_WEIGHT_WINDOWS:
+    transport_function = transport_single_particle<FEATURE_WEIGHT_WINDOWS>;
+    break;
+  case FEATURE_TRACKS:
+    transport_function = transport_single_particle<FEATURE_TRACKS>;
+    break;
+  default:
+    transport_function = transport_single_particle<FEATURE_ALL>;
+  }
+}
+
+void transport_history_based_single_particle(Particle& p)
+{
+  transport_function(p);
 }
 
 void transport_history_based()
 {
-#pragma omp parallel for schedule(runtime)
-  for (int64_t i_work = 1; i_work <= simulation::work_per_rank; ++i_work) {
-    Particle p;
-    initialize_history(p, i_work);
+  // If the source bank is still being exchanged, transport each chunk of it
+  // as soon as it has arrived
+  if (simulation::current_census > 0) {
+    transport_history_based(0, simulation::census_source.size());
+  } else if (bank_exchange_pending()) {
+    int64_t i_begin, i_end;
+    while (receive_bank_chunk(&i_begin, &i_end)) {
+      transport_history_based(i_begin, i_end);
+    }
+  } else if (dynamic_work()) {
+    // Claim chunks of histories until all of them have been handed out
+    reset_work_counter();
+    int64_t i_begin, i_end;
+    while (claim_work_chunk(&i_begin, &i_end)) {
+      transport_history_based(i_begin, i_end);
+    }
+  } else {
+    transport_history_based(0, simulation::work_per_rank);
+  }
+}
+
+namespace {
+
+//! Histories that remain to be run by one thread. The owner takes histories
+//! from the front of the range while other threads steal from the back.
+struct WorkRange {
+  OpenMPMutex mutex;
+  int64_t begin {0}; //!< Index of the next history
+  int64_t end {0};   //!< Index one past the last history
+  char padding[64];  //!< Keeps ranges of different threads in separate lines
+};
+
+//! Take up to n_max of the next histories from a range
+bool pop_work(WorkRange& range, int64_t n_max, int64_t& i_work, int64_t& n)
+{
+  std::lock_guard<OpenMPMutex> lock(range.mutex);
+  if (range.begin == range.end)
+    return false;
+  i_work = range.begin;
+  n = std::min(n_max, range.end - range.begin);
+  range.begin += n;
+  return true;
+}
+
+//! Move the back half of the histories of one range into an empty range
+bool steal_work(WorkRange& victim, WorkRange& thief)
+{
+  int64_t begin, end;
+  {
+    std::lock_guard<OpenMPMutex> lock(victim.mutex);
+    int64_t n = victim.end - victim.begin;
+    if (n == 0)
+      return false;
+    end = victim.end;
+    victim.end -= (n + 1) / 2;
+    begin = victim.end;
+  }
+  std::lock_guard<OpenMPMutex> lock(thief.mutex);
+  thief.begin = begin;
+  thief.end = end;
+  return true;
+}
+
+//! Run a block of consecutive histories. In fixed source mode, the source
+//! sites of the whole block are sampled together, so that a custom source
+//! library can generate them with one call.
+//
+//! \param[in] p Particle reused for each history
+//! \param[in] i_begin Index of the first history, starting from zero
+//! \param[in] n Number of histories
+//! \param[in] sites Buffer for the source sites of the block
+void transport_history_block(
+  Particle& p, int64_t i_begin, int64_t n, vector<SourceSite>& sites)
+{
+  bool sample = settings::run_mode == RunMode::FIXED_SOURCE &&
+                simulation::current_census == 0;
+  if (sample) {
+    sample_external_sources(fixed_source_id(i_begin + 1), n, sites.data());
+  }
+  for (int64_t i = 0; i < n; ++i) {
+    initialize_history(p, i_begin + i + 1, sample ? &sites[i] : nullptr);
     transport_history_based_single_particle(p);
   }
 }
 
+} // namespace
+
+void transport_history_based(int64_t i_begin, int64_t i_end)
+{
+  // Divide the histories evenly among threads when work stealing
+  int n_threads = 1;
+#ifdef _OPENMP
+  n_threads = omp_get_max_threads();
+#endif
+  bool stealing = settings::history_schedule == HistorySchedule::WORK_STEALING;
+  vector<WorkRange> ranges(stealing ? n_threads : 0);
+  for (int i = 0; i < ranges.size(); ++i) {
+    ranges[i].begin = i_begin + (i_end - i_begin) * i / n_threads;
+    ranges[i].end = i_begin + (i_end - i_begin) * (i + 1) / n_threads;
+  }
+
+  // Histories are run in blocks that share one call to sample source sites,
+  // small enough that there are still several blocks for each thread
+  int64_t block_size = std::max<int64_t>(1,
+    std::min<int64_t>(EXTSRC_BATCH_SIZE, (i_end - i_begin) / (4 * n_threads)));
+
+#pragma omp parallel
+  {
+    // Each thread reuses one particle for all of its histories so that the
+    // secondary bank is allocated once rather than regrown for every history
+    Particle p;
+    p.secondary_bank().reserve(settings::secondary_bank_capacity);
+    vector<SourceSite> sites(block_size);
+
+    if (stealing) {
+      int i_thread = 0;
+#ifdef _OPENMP
+      i_thread = omp_get_thread_num();
+#endif
+      WorkRange& own = ranges[i_thread];
+      while (true) {
+        int64_t i_work, n;
+        if (pop_work(own, block_size, i_work, n)) {
+          transport_history_block(p, i_work, n, sites);
+          continue;
+        }
+
+        // Once its own histories are finished, a thread looks for another
+        // thread with histories left. Since histories are never added, the
+        // thread is done when all other ranges are empty.
+        bool found = false;
+        for (int i = 1; i < n_threads && !found; ++i) {
+          found = steal_work(ranges[(i_thread + i) % n_threads], own);
+        }
+        if (!found)
+          break;
+      }
+    } else {
+#pragma omp for schedule(runtime)
+      for (int64_t i_work = i_begin; i_work < i_end; i_work += block_size) {
+        transport_history_block(
+          p, i_work, std::min(block_size, i_end - i_work), sites);
+      }
+    }
+  }
+}
+
 void transport_event_based()
 {
-  int64_t remaining_work = simulation::work_per_rank;
+  // Event-based transport initializes particles from contiguous ranges of the
+  // source bank, so the whole bank must have arrived
+  finish_bank_exchange();
+
+  int64_t remaining_work = simulation::current_census > 0
+                             ? simulation::census_source.size()
+                             : simulation::work_per_rank;
   int64_t source_offset = 0;
 
   // To cap the total amount of memory used to store particle object data, the
@@ -726,38 +1329,24 @@ void transport_event_based()
 
     // Initialize all particle histories for this subiteration
     process_init_events(n_particles, source_offset);
+    remaining_work -= n_particles;
+    source_offset += n_particles;
 
     // Event-based transport loop
-    while (true) {
-      // Determine which event kernel has the longest queue
-      int64_t max = std::max({simulation::calculate_fuel_xs_queue.size(),
-        simulation::calculate_nonfuel_xs_queue.size(),
-        simulation::advance_particle_queue.size(),
-        simulation::surface_crossing_queue.size(),
-        simulation::collision_queue.size()});
-
-      // Execute event with the longest queue
-      if (max == 0) {
-        break;
-      } else if (max == simulation::calculate_fuel_xs_queue.size()) {
-        process_calculate_xs_events(simulation::calculate_fuel_xs_queue);
-      } else if (max == simulation::calculate_nonfuel_xs_queue.size()) {
-        process_calculate_xs_events(simulation::calculate_nonfuel_xs_queue);
-      } else if (max == simulation::advance_particle_queue.size()) {
-        process_advance_particle_events();
-      } else if (max == simulation::surface_crossing_queue.size()) {
-        process_surface_crossing_events();
-      } else if (max == simulation::collision_queue.size()) {
-        process_collision_events();
-      }
-    }
+    do {
+      // Keep the buffer occupied with new source particles if requested
+      int64_t n_refill =
+        process_refill_events(n_particles, remaining_work, source_offset);
+      remaining_work -= n_refill;
+      source_offset += n_refill;
+    } while (process_next_events());
+
+    // All particles are dead, so none of the slots are free any longer once
+    // the buffer is initialized again
+    simulation::free_particle_queue.resize(0);
 
     // Execute death event for all particles
     process_death_events(n_particles);
-
-    // Adjust remaining work and source offset variables
-    remaining_work -= n_particles;
-    source_offset += n_particles;
   }
 }
 
@@ -2,14 +2,22 @@
 
 #if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
 #define HAS_DYNAMIC_LINKING
+#define HAS_MEMORY_MAPPING
 #endif
 
-#include <algorithm> // for move
+#include <algorithm> // for min, move
 
 #ifdef HAS_DYNAMIC_LINKING
 #include <dlfcn.h> // for dlopen, dlsym, dlclose, dlerror
 #endif
 
+#ifdef HAS_MEMORY_MAPPING
+#include <fcntl.h>    // for open
+#include <sys/mman.h> // for mmap, madvise, munmap
+#include <sys/stat.h> // for stat
+#include <unistd.h>   // for close, sysconf
+#endif
+
 #include "xtensor/xadapt.hpp"
 #include <fmt/core.h>
 
@@ -21,6 +29,7 @@
 #include "openmc/hdf5_interface.h"
 #include "openmc/material.h"
 #include "openmc/memory.h"
+#include "openmc/mesh.h"
 #include "openmc/message_passing.h"
 #include "openmc/mgxs_interface.h"
 #include "openmc/nuclide.h"
@@ -42,10 +51,23 @@ namespace model {
 vector<unique_ptr<Source>> external_sources;
 }
 
+//==============================================================================
+// Source implementation
+//==============================================================================
+
+void Source::sample_batch(uint64_t* seeds, int n, SourceSite* sites) const
+{
+  for (int i = 0; i < n; ++i) {
+    sites[i] = this->sample(seeds + i);
+  }
+}
+
 //==============================================================================
 // IndependentSource implementation
 //==============================================================================
 
+int64_t IndependentSource::n_accept_ {0};
+
 IndependentSource::IndependentSource(
   UPtrSpace space, UPtrAngle angle, UPtrDist energy, UPtrDist time)
   : space_ {std::move(space)}, angle_ {std::move(angle)},
@@ -98,6 +120,11 @@ IndependentSource::IndependentSource(pugi::xml_node node)
         space_ = UPtrSpace {new SpatialBox(node_space, true)};
       } else if (type == "point") {
         space_ = UPtrSpace {new SpatialPoint(node_space)};
+      } else if (type == "mesh") {
+        auto mesh_space = new MeshSpatial(node_space);
+        if (mesh_space->has_energy())
+          mesh_space_ = mesh_space;
+        space_ = UPtrSpace {mesh_space};
       } else {
         fatal_error(fmt::format(
           "Invalid spatial distribution for external source: {}", type));
@@ -155,64 +182,277 @@ IndependentSource::IndependentSource(pugi::xml_node node)
 }
 
 SourceSite IndependentSource::sample(uint64_t* seed) const
+{
+  if (bias_importance_.empty())
+    return this->sample_unbiased(seed);
+
+  // Sites are accepted with a probability proportional to their importance,
+  // so that their weights are inversely proportional to it
+  while (true) {
+    SourceSite site = this->sample_unbiased(seed);
+    double importance = this->importance(site);
+    if (prn(seed) * bias_max_ < importance) {
+      site.wgt = bias_mean_ / importance;
+      return site;
+    }
+  }
+}
+
+SourceSite IndependentSource::sample_unbiased(uint64_t* seed) const
 {
   SourceSite site;
 
+  // Set particle type
+  site.particle = particle_;
+
   // Repeat sampling source location until a good site has been found
-  bool found = false;
+  int element = -1;
   int n_reject = 0;
-  static int n_accept = 0;
-  while (!found) {
-    // Set particle type
-    site.particle = particle_;
-
-    // Sample spatial distribution
-    site.r = space_->sample(seed);
-
-    // Now search to see if location exists in geometry
-    int32_t cell_index, instance;
-    double xyz[] {site.r.x, site.r.y, site.r.z};
-    int err = openmc_find_cell(xyz, &cell_index, &instance);
-    found = (err != OPENMC_E_GEOMETRY);
-
-    // Check if spatial site is in fissionable material
-    if (found) {
-      auto space_box = dynamic_cast<SpatialBox*>(space_.get());
-      if (space_box) {
-        if (space_box->only_fissionable()) {
-          // Determine material
-          const auto& c = model::cells[cell_index];
-          auto mat_index =
-            c->material_.size() == 1 ? c->material_[0] : c->material_[instance];
-
-          if (mat_index == MATERIAL_VOID) {
-            found = false;
-          } else {
-            if (!model::materials[mat_index]->fissionable_)
-              found = false;
-          }
-        }
-      }
-    }
-
-    // Check for rejection
-    if (!found) {
-      ++n_reject;
-      if (n_reject >= EXTSRC_REJECT_THRESHOLD &&
-          static_cast<double>(n_accept) / n_reject <= EXTSRC_REJECT_FRACTION) {
-        fatal_error("More than 95% of external source sites sampled were "
-                    "rejected. Please check your external source definition.");
-      }
+  while (true) {
+    if (!grid_voxels_.empty()) {
+      site.r = this->sample_domain_grid(seed);
+    } else if (mesh_space_) {
+      element = mesh_space_->sample_element(seed);
+      site.r = mesh_space_->sample_position(element, seed);
+    } else {
+      site.r = space_->sample(seed);
     }
+    if (this->accept_position(site.r))
+      break;
+    reject_position(++n_reject);
   }
 
   // Increment number of accepted samples
-  ++n_accept;
+#pragma omp atomic
+  ++n_accept_;
 
   // Sample angle
   site.u = angle_->sample(seed);
 
   // Check for monoenergetic source above maximum particle energy
+  this->check_energy_range();
+
+  // Sample from the energy spectrum of the mesh element if it has one
+  const Distribution* energy =
+    mesh_space_ ? mesh_space_->energy(element) : energy_.get();
+  while (true) {
+    // Sample energy spectrum
+    site.E = energy->sample(seed);
+
+    // Resample if energy falls outside minimum or maximum particle energy
+    if (this->accept_energy(site.E))
+      break;
+  }
+
+  // Sample particle creation time
+  site.time = time_->sample(seed);
+
+  return site;
+}
+
+void IndependentSource::sample_batch(
+  uint64_t* seeds, int n, SourceSite* sites) const
+{
+  // The number of resamples of a biased site depends on all of its
+  // distributions, so biased sites are sampled one at a time, as are sites
+  // sampled from a domain grid or with the energy spectrum of a mesh element
+  if (!bias_importance_.empty() || !grid_voxels_.empty() || mesh_space_) {
+    Source::sample_batch(seeds, n, sites);
+    return;
+  }
+
+  // Each distribution is sampled for all sites at once. Sites whose position
+  // or energy is rejected are resampled individually with their own seed, so
+  // every site is the same one sample() would give with its seed.
+  vector<Position> r(n);
+  space_->sample_batch(seeds, n, r.data());
+  for (int i = 0; i < n; ++i) {
+    int n_reject = 0;
+    while (!this->accept_position(r[i])) {
+      reject_position(++n_reject);
+      r[i] = space_->sample(seeds + i);
+    }
+  }
+
+  // The count is shared by all threads, so it is updated once per batch
+#pragma omp atomic
+  n_accept_ += n;
+
+  vector<Direction> u(n);
+  angle_->sample_batch(seeds, n, u.data());
+
+  this->check_energy_range();
+  vector<double> E(n);
+  energy_->sample_batch(seeds, n, E.data());
+  for (int i = 0; i < n; ++i) {
+    while (!this->accept_energy(E[i])) {
+      E[i] = energy_->sample(seeds + i);
+    }
+  }
+
+  vector<double> time(n);
+  time_->sample_batch(seeds, n, time.data());
+
+  for (int i = 0; i < n; ++i) {
+    sites[i] = {};
+    sites[i].particle = particle_;
+    sites[i].r = r[i];
+    sites[i].u = u[i];
+    sites[i].E = E[i];
+    sites[i].time = time[i];
+  }
+}
+
+void IndependentSource::set_importance(int32_t mesh_idx,
+  const vector<double>& energy_bounds, const vector<double>& importance)
+{
+  bias_importance_.clear();
+  bias_mesh_ = mesh_idx;
+  bias_energy_ = energy_bounds;
+  bias_floor_ = INFTY;
+  for (auto x : importance) {
+    if (x > 0.0)
+      bias_floor_ = std::min(bias_floor_, x);
+  }
+  if (bias_floor_ == INFTY) {
+    bias_mean_ = 1.0;
+    return;
+  }
+  bias_importance_ = importance;
+
+  // Normalize the weights of biased sites with the mean importance of
+  // unbiased sites, and accept sites relative to the largest importance found
+  double sum = 0.0;
+  bias_max_ = 0.0;
+  for (int64_t i = 0; i < EXTSRC_BIAS_SAMPLES; ++i) {
+    uint64_t seed = init_seed(i + 1, STREAM_SOURCE);
+    double x = this->importance(this->sample_unbiased(&seed));
+    sum += x;
+    bias_max_ = std::max(bias_max_, x);
+  }
+  bias_mean_ = sum / EXTSRC_BIAS_SAMPLES;
+}
+
+void IndependentSource::build_domain_grid()
+{
+  grid_voxels_.clear();
+  auto box = dynamic_cast<SpatialBox*>(space_.get());
+  if (!box)
+    return;
+
+  // Only build the grid if few positions in the box are accepted
+  int n_accept = 0;
+#pragma omp parallel for reduction(+ : n_accept)
+  for (int i = 0; i < EXTSRC_GRID_SAMPLES; ++i) {
+    uint64_t seed = init_seed(i + 1, STREAM_SOURCE);
+    if (this->accept_position(box->sample(&seed)))
+      ++n_accept;
+  }
+  if (n_accept >= EXTSRC_GRID_ACCEPT_FRACTION * EXTSRC_GRID_SAMPLES)
+    return;
+
+  // Keep the voxels where any sampled position is accepted. All voxels have
+  // the same volume, so positions are uniform in the box once a voxel is
+  // picked uniformly from those kept.
+  Position lower_left = box->lower_left();
+  grid_width_ = (box->upper_right() - lower_left) / EXTSRC_GRID_DIM;
+  int n_voxels = EXTSRC_GRID_DIM * EXTSRC_GRID_DIM * EXTSRC_GRID_DIM;
+  vector<char> occupied(n_voxels, 0);
+#pragma omp parallel for schedule(dynamic)
+  for (int v = 0; v < n_voxels; ++v) {
+    Position corner {lower_left.x + (v % EXTSRC_GRID_DIM) * grid_width_.x,
+      lower_left.y + (v / EXTSRC_GRID_DIM % EXTSRC_GRID_DIM) * grid_width_.y,
+      lower_left.z + (v / (EXTSRC_GRID_DIM * EXTSRC_GRID_DIM)) * grid_width_.z};
+    uint64_t seed = init_seed(v + 1, STREAM_SOURCE);
+    for (int i = 0; i < EXTSRC_GRID_VOXEL_SAMPLES; ++i) {
+      Position xi {prn(&seed), prn(&seed), prn(&seed)};
+      if (this->accept_position(corner + xi * grid_width_)) {
+        occupied[v] = 1;
+        break;
+      }
+    }
+  }
+  for (int v = 0; v < n_voxels; ++v) {
+    if (occupied[v])
+      grid_voxels_.push_back(v);
+  }
+
+  // If no voxel was found, positions are rejected as usual
+  if (grid_voxels_.empty())
+    return;
+  write_message(6, "Sampling source positions from {} of {} voxels of box",
+    grid_voxels_.size(), n_voxels);
+}
+
+Position IndependentSource::sample_domain_grid(uint64_t* seed) const
+{
+  auto box = static_cast<SpatialBox*>(space_.get());
+  int n = grid_voxels_.size();
+  int v = grid_voxels_[std::min(static_cast<int>(prn(seed) * n), n - 1)];
+  Position xi {prn(seed), prn(seed), prn(seed)};
+  Position index {static_cast<double>(v % EXTSRC_GRID_DIM),
+    static_cast<double>(v / EXTSRC_GRID_DIM % EXTSRC_GRID_DIM),
+    static_cast<double>(v / (EXTSRC_GRID_DIM * EXTSRC_GRID_DIM))};
+  return box->lower_left() + (index + xi) * grid_width_;
+}
+
+double IndependentSource::importance(const SourceSite& site) const
+{
+  const auto& mesh = *model::meshes[bias_mesh_];
+  int bin = mesh.get_bin(site.r);
+  if (bin < 0 || site.E < bias_energy_.front() || site.E > bias_energy_.back())
+    return bias_floor_;
+  int group =
+    lower_bound_index(bias_energy_.begin(), bias_energy_.end(), site.E);
+  double x = bias_importance_[group * mesh.n_bins() + bin];
+  return x > 0.0 ? x : bias_floor_;
+}
+
+bool IndependentSource::accept_position(Position r) const
+{
+  // Search to see if location exists in geometry
+  int32_t cell_index, instance;
+  double xyz[] {r.x, r.y, r.z};
+  int err = openmc_find_cell(xyz, &cell_index, &instance);
+  if (err == OPENMC_E_GEOMETRY)
+    return false;
+
+  // Check if spatial site is in fissionable material
+  auto space_box = dynamic_cast<SpatialBox*>(space_.get());
+  if (space_box) {
+    if (space_box->only_fissionable()) {
+      // Determine material
+      const auto& c = model::cells[cell_index];
+      auto mat_index =
+        c->material_.size() == 1 ? c->material_[0] : c->material_[instance];
+
+      if (mat_index == MATERIAL_VOID) {
+        return false;
+      } else {
+        if (!model::materials[mat_index]->fissionable_)
+          return false;
+      }
+    }
+  }
+  return true;
+}
+
+void IndependentSource::reject_position(int n_reject)
+{
+  if (n_reject < EXTSRC_REJECT_THRESHOLD)
+    return;
+
+  int64_t n_accept;
+#pragma omp atomic read
+  n_accept = n_accept_;
+  if (static_cast<double>(n_accept) / n_reject <= EXTSRC_REJECT_FRACTION) {
+    fatal_error("More than 95% of external source sites sampled were "
+                "rejected. Please check your external source definition.");
+  }
+}
+
+void IndependentSource::check_energy_range() const
+{
   auto p = static_cast<int>(particle_);
   auto energy_ptr = dynamic_cast<Discrete*>(energy_.get());
   if (energy_ptr) {
@@ -225,27 +465,19 @@ SourceSite IndependentSource::sample(uint64_t* seed) const
                   "one cross section table");
     }
   }
+}
 
-  while (true) {
-    // Sample energy spectrum
-    site.E = energy_->sample(seed);
-
-    // Resample if energy falls outside minimum or maximum particle energy
-    if (site.E < data::energy_max[p] && site.E > data::energy_min[p])
-      break;
-  }
-
-  // Sample particle creation time
-  site.time = time_->sample(seed);
-
-  return site;
+bool IndependentSource::accept_energy(double E) const
+{
+  auto p = static_cast<int>(particle_);
+  return E < data::energy_max[p] && E > data::energy_min[p];
 }
 
 //==============================================================================
 // FileSource implementation
 //==============================================================================
 
-FileSource::FileSource(std::string path)
+FileSource::FileSource(std::string path) : path_ {path}
 {
   // Check if source file exists
   if (!file_exists(path)) {
@@ -266,15 +498,204 @@ FileSource::FileSource(std::string path)
     fatal_error("Specified starting source file not a source file type.");
   }
 
-  // Read in the source particles
-  read_source_bank(file_id, sites_, false);
+  // Read in the source particles, or only those in this process's slice of
+  // the file when it is partitioned, unless they can be sampled directly from
+  // a memory map of the file
+  if (!settings::mmap_source_files || !this->map_sites(path, file_id))
+    this->read_sites(file_id);
 
   // Close file
   file_close(file_id);
 }
 
+FileSource::~FileSource()
+{
+#ifdef HAS_MEMORY_MAPPING
+  if (mapping_)
+    munmap(mapping_, mapping_size_);
+#endif
+}
+
+void FileSource::read_sites(hid_t file_id)
+{
+  if (settings::partition_source_files) {
+    read_source_bank_partition(file_id, sites_);
+  } else {
+    read_source_bank(file_id, sites_, false);
+  }
+}
+
+#ifdef HAS_MEMORY_MAPPING
+namespace {
+
+//! Determine whether a file is one that the simulation writes to, comparing
+//! files by identity since the same file may be reached by different paths
+bool file_written_by_run(const std::string& path)
+{
+  struct stat target;
+  if (stat(path.c_str(), &target) != 0)
+    return false;
+
+  // Files written under a fixed name
+  vector<std::string> written;
+  if (settings::source_latest)
+    written.push_back(settings::path_output + "source.h5");
+  if (settings::surf_source_write)
+    written.push_back(settings::path_output + "surface_source.h5");
+  if (settings::write_initial_source)
+    written.push_back(settings::path_output + "initial_source.h5");
+
+  // Streamed surface sources are written by each process, all of which have
+  // to agree on whether the file is read
+  if (settings::surf_source_stream) {
+    for (int i = 0; i < mpi::n_procs; ++i) {
+      written.push_back(
+        fmt::format("{}surface_source.{}.h5", settings::path_output, i));
+    }
+  }
+
+  // Files named after the batch they are written in
+  int w = std::to_string(settings::n_max_batches).size();
+  for (int b : settings::statepoint_batch) {
+    written.push_back(
+      fmt::format("{0}statepoint.{1:0{2}}.h5", settings::path_output, b, w));
+  }
+  if (settings::source_write && settings::source_separate) {
+    for (int b : settings::sourcepoint_batch) {
+      written.push_back(
+        fmt::format("{0}source.{1:0{2}}.h5", settings::path_output, b, w));
+    }
+  }
+
+  for (const auto& name : written) {
+    struct stat info;
+    if (stat(name.c_str(), &info) == 0 && info.st_dev == target.st_dev &&
+        info.st_ino == target.st_ino)
+      return true;
+  }
+  return false;
+}
+
+} // namespace
+#endif
+
+void FileSource::unmap_if_written()
+{
+#ifdef HAS_MEMORY_MAPPING
+  // Every process has the same settings, so they agree on whether to read the
+  // file, which is collective with parallel HDF5
+  if (!mapped_sites_ || !file_written_by_run(path_))
+    return;
+
+  // Truncating the file while it is mapped would leave pages that can no
+  // longer be read, so its sites are read into memory instead
+  warning(fmt::format("Source file '{}' is written during the simulation and "
+                      "will be read instead of memory mapped.",
+    path_));
+  munmap(mapping_, mapping_size_);
+  mapping_ = nullptr;
+  mapping_size_ = 0;
+  mapped_sites_ = nullptr;
+  n_mapped_sites_ = 0;
+
+  hid_t file_id = file_open(path_, 'r', true);
+  this->read_sites(file_id);
+  file_close(file_id);
+#endif
+}
+
+bool FileSource::map_sites(const std::string& path, hid_t file_id)
+{
+#ifdef HAS_MEMORY_MAPPING
+  // Check that the sites are stored contiguously and that their datatype in
+  // the file, including byte order and padding, is that of sites in memory
+  hid_t banktype = h5banktype();
+  hid_t dset = open_source_bank(file_id, banktype);
+  hid_t dtype = H5Dget_type(dset);
+  hid_t dcpl = H5Dget_create_plist(dset);
+  bool native = H5Tequal(dtype, banktype) > 0 &&
+                H5Pget_layout(dcpl) == H5D_CONTIGUOUS;
+  haddr_t offset = H5Dget_offset(dset);
+  hsize_t n_sites;
+  hid_t dspace = H5Dget_space(dset);
+  H5Sget_simple_extent_dims(dspace, &n_sites, nullptr);
+  H5Sclose(dspace);
+  H5Pclose(dcpl);
+  H5Tclose(dtype);
+  H5Dclose(dset);
+  H5Tclose(banktype);
+
+  if (!native || offset == HADDR_UNDEF ||
+      offset % alignof(SourceSite) != 0) {
+    warning(fmt::format("Source sites in '{}' are not stored contiguously "
+                        "with their layout in memory and will be read instead "
+                        "of memory mapped.",
+      path));
+    return false;
+  }
+
+  // Determine the sites that this process samples from
+  hsize_t i_start = 0;
+  hsize_t n = n_sites;
+  if (settings::partition_source_files) {
+    i_start = n_sites * mpi::rank / mpi::n_procs;
+    n = n_sites * (mpi::rank + 1) / mpi::n_procs - i_start;
+  }
+
+  // Too few sites to partition is left to the read, which reports the error
+  if (n_sites < static_cast<hsize_t>(mpi::n_procs) &&
+      settings::partition_source_files)
+    return false;
+
+  // Map the pages holding those sites, which must start on a page boundary.
+  // The mapping is private so that nothing is ever written back to the file.
+  size_t page_size = sysconf(_SC_PAGESIZE);
+  size_t begin = offset + i_start * sizeof(SourceSite);
+  size_t map_offset = begin - begin % page_size;
+  size_t length = begin + n * sizeof(SourceSite) - map_offset;
+  void* mapping = MAP_FAILED;
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, map_offset);
+    close(fd);
+  }
+  bool mapped = (mapping != MAP_FAILED);
+
+#ifdef OPENMC_MPI
+  // Reading the file is collective, so every process has to read it if any
+  // of them could not map it
+  MPI_Allreduce(
+    MPI_IN_PLACE, &mapped, 1, MPI_C_BOOL, MPI_LAND, mpi::intracomm);
+#endif
+  if (!mapped) {
+    if (mapping != MAP_FAILED)
+      munmap(mapping, length);
+    warning(fmt::format(
+      "Source file '{}' could not be memory mapped and will be read instead.",
+      path));
+    return false;
+  }
+
+  // Sites are sampled at random, so reading ahead of each page is wasted
+  madvise(mapping, length, MADV_RANDOM);
+
+  mapping_ = mapping;
+  mapping_size_ = length;
+  mapped_sites_ = reinterpret_cast<const SourceSite*>(
+    static_cast<const char*>(mapping) + (begin - map_offset));
+  n_mapped_sites_ = n;
+  return true;
+#else
+  return false;
+#endif
+}
+
 SourceSite FileSource::sample(uint64_t* seed) const
 {
+  if (mapped_sites_) {
+    size_t i_site = n_mapped_sites_ * prn(seed);
+    return mapped_sites_[i_site];
+  }
   size_t i_site = sites_.size() * prn(seed);
   return sites_[i_site];
 }
@@ -340,28 +761,60 @@ void initialize_source()
 {
   write_message("Initializing source particles...", 5);
 
-// Generation source sites from specified distribution in user input
-#pragma omp parallel for
-  for (int64_t i = 0; i < simulation::work_per_rank; ++i) {
-    // initialize random number seed
+  // Generate source sites from specified distribution in user input. Each
+  // process samples only its own range of source IDs and each thread a static
+  // share of that range, so no part of the bank is generated serially and the
+  // sites do not depend on the number of processes or threads.
+#pragma omp parallel for schedule(static)
+  for (int64_t i = 0; i < simulation::work_per_rank; i += EXTSRC_BATCH_SIZE) {
+    int64_t n =
+      std::min<int64_t>(EXTSRC_BATCH_SIZE, simulation::work_per_rank - i);
     int64_t id = simulation::total_gen * settings::n_particles +
                  simulation::work_index[mpi::rank] + i + 1;
-    uint64_t seed = init_seed(id, STREAM_SOURCE);
 
     // sample external source distribution
-    simulation::source_bank[i] = sample_external_source(&seed);
+    sample_external_sources(id, n, &simulation::source_bank[i]);
   }
 
   // Write out initial source
   if (settings::write_initial_source) {
     write_message("Writing out initial source...", 5);
     std::string filename = settings::path_output + "initial_source.h5";
-    hid_t file_id = file_open(filename, 'w', true);
+    hid_t file_id = file_open(filename, 'w', true, true);
     write_source_bank(file_id, false);
     file_close(file_id);
   }
 }
 
+namespace {
+
+//! Sample which external source distribution a site comes from
+//! \param[in] total_strength Sum of the strengths of all sources
+//! \param[inout] seed Pseudorandom seed pointer
+//! \return Index of the source distribution
+int sample_source_index(double total_strength, uint64_t* seed)
+{
+  double xi = prn(seed) * total_strength;
+  double c = 0.0;
+  int i = 0;
+  for (; i < model::external_sources.size(); ++i) {
+    c += model::external_sources[i]->strength();
+    if (xi < c)
+      break;
+  }
+  return i;
+}
+
+//! Convert the energy of a site to its energy group in MG mode
+void convert_to_group(SourceSite& site)
+{
+  site.E = lower_bound_index(data::mg.rev_energy_bins_.begin(),
+    data::mg.rev_energy_bins_.end(), site.E);
+  site.E = data::mg.num_energy_groups_ - site.E - 1.;
+}
+
+} // namespace
+
 SourceSite sample_external_source(uint64_t* seed)
 {
   // Determine total source strength
@@ -372,13 +825,7 @@ SourceSite sample_external_source(uint64_t* seed)
   // Sample from among multiple source distributions
   int i = 0;
   if (model::external_sources.size() > 1) {
-    double xi = prn(seed) * total_strength;
-    double c = 0.0;
-    for (; i < model::external_sources.size(); ++i) {
-      c += model::external_sources[i]->strength();
-      if (xi < c)
-        break;
-    }
+    i = sample_source_index(total_strength, seed);
   }
 
   // Sample source site from i-th source distribution
@@ -386,14 +833,69 @@ SourceSite sample_external_source(uint64_t* seed)
 
   // If running in MG, convert site.E to group
   if (!settings::run_CE) {
-    site.E = lower_bound_index(data::mg.rev_energy_bins_.begin(),
-      data::mg.rev_energy_bins_.end(), site.E);
-    site.E = data::mg.num_energy_groups_ - site.E - 1.;
+    convert_to_group(site);
   }
 
   return site;
 }
 
+void sample_external_sources(int64_t id_begin, int64_t n, SourceSite* sites)
+{
+  const auto& sources = model::external_sources;
+
+  // Determine total source strength
+  double total_strength = 0.0;
+  for (auto& s : sources)
+    total_strength += s->strength();
+
+  uint64_t seeds[EXTSRC_BATCH_SIZE];
+  int source_index[EXTSRC_BATCH_SIZE];
+  int lanes[EXTSRC_BATCH_SIZE];
+  uint64_t group_seeds[EXTSRC_BATCH_SIZE];
+  vector<SourceSite> group_sites(EXTSRC_BATCH_SIZE);
+
+  for (int64_t i_begin = 0; i_begin < n; i_begin += EXTSRC_BATCH_SIZE) {
+    int m = std::min<int64_t>(EXTSRC_BATCH_SIZE, n - i_begin);
+    SourceSite* batch = sites + i_begin;
+    for (int i = 0; i < m; ++i) {
+      seeds[i] = init_seed(id_begin + i_begin + i, STREAM_SOURCE);
+    }
+
+    if (sources.size() == 1) {
+      sources[0]->sample_batch(seeds, m, batch);
+    } else {
+      // Sample from among multiple source distributions
+      for (int i = 0; i < m; ++i) {
+        source_index[i] = sample_source_index(total_strength, seeds + i);
+      }
+
+      // Sample the sites from each source distribution together
+      for (int j = 0; j < sources.size(); ++j) {
+        int k = 0;
+        for (int i = 0; i < m; ++i) {
+          if (source_index[i] == j) {
+            lanes[k] = i;
+            group_seeds[k++] = seeds[i];
+          }
+        }
+        if (k == 0)
+          continue;
+        sources[j]->sample_batch(group_seeds, k, group_sites.data());
+        for (int l = 0; l < k; ++l) {
+          batch[lanes[l]] = group_sites[l];
+        }
+      }
+    }
+
+    // If running in MG, convert site.E to group
+    if (!settings::run_CE) {
+      for (int i = 0; i < m; ++i) {
+        convert_to_group(batch[i]);
+      }
+    }
+  }
+}
+
 void free_memory_source()
 {
   model::external_sources.clear();
@@ -2,7 +2,10 @@
 
 #include <algorithm>
 #include <cstdint> // for int64_t
+#include <fstream>  // for ofstream
+#include <future>   // for async, future
 #include <string>
+#include <utility>  // for move
 
 #include "xtensor/xbuilder.hpp" // for empty_like
 #include "xtensor/xview.hpp"
@@ -19,8 +22,10 @@
 #include "openmc/mgxs_interface.h"
 #include "openmc/nuclide.h"
 #include "openmc/output.h"
+#include "openmc/profile.h"
 #include "openmc/settings.h"
 #include "openmc/simulation.h"
+#include "openmc/string_utils.h"
 #include "openmc/tallies/derivative.h"
 #include "openmc/tallies/filter.h"
 #include "openmc/tallies/filter_mesh.h"
@@ -30,6 +35,21 @@
 
 namespace openmc {
 
+namespace {
+
+std::future<bool> async_write; //!< background write of the last file
+std::string async_write_file;  //!< name of the file being written
+
+} // namespace
+
+namespace simulation {
+
+hid_t surf_source_file {-1};       //!< streamed surface source file
+hid_t surf_source_dset {-1};       //!< source_bank dataset of the stream
+hsize_t surf_source_n_written {0}; //!< sites written to the stream
+
+} // namespace simulation
+
 extern "C" int openmc_statepoint_write(const char* filename, bool* write_source)
 {
   simulation::time_statepoint.start();
@@ -50,13 +70,21 @@ extern "C" int openmc_statepoint_write(const char* filename, bool* write_source)
   // Determine whether or not to write the source bank
   bool write_source_ = write_source ? *write_source : true;
 
+  // State points written by the simulation itself can be built in memory and
+  // written in the background while the next batch runs
+  bool async = settings::async_statepoint && !filename;
+
   // Write message
   write_message("Creating state point " + filename_ + "...", 5);
 
+  // Sum the profile counters of all processes
+  if (settings::profile)
+    reduce_profile();
+
   hid_t file_id;
   if (mpi::master) {
     // Create statepoint file
-    file_id = file_open(filename_, 'w');
+    file_id = async ? file_open_memory(filename_) : file_open(filename_, 'w');
 
     // Write file type
     write_attribute(file_id, "filetype", "statepoint");
@@ -248,9 +276,13 @@ extern "C" int openmc_statepoint_write(const char* filename, bool* write_source)
           // Write sum and sum_sq for each bin
           std::string name = "tally " + std::to_string(tally->id_);
           hid_t tally_group = open_group(tallies_group, name.c_str());
-          auto& results = tally->results_;
-          write_tally_results(tally_group, results.shape()[0],
-            results.shape()[1], results.data());
+          if (tally->sparse_results_) {
+            tally->sparse_results_->write(tally_group);
+          } else {
+            auto& results = tally->results_;
+            write_tally_results(tally_group, results.shape()[0],
+              results.shape()[1], results.data());
+          }
           close_group(tally_group);
         }
       } else {
@@ -268,6 +300,15 @@ extern "C" int openmc_statepoint_write(const char* filename, bool* write_source)
     // results before writing them to the state point file.
     write_tally_results_nr(file_id);
 
+    // Otherwise, each process writes its own results to a separate file that
+    // can be merged with the state point afterwards
+    if (settings::tally_rank_files) {
+      std::string base = filename_;
+      if (ends_with(base, ".h5"))
+        base.erase(base.size() - 3);
+      write_tally_results_rank(fmt::format("{}.rank{}.h5", base, mpi::rank));
+    }
+
   } else if (mpi::master) {
     // Write number of global realizations
     write_dataset(file_id, "n_realizations", simulation::n_realizations);
@@ -303,7 +344,15 @@ extern "C" int openmc_statepoint_write(const char* filename, bool* write_source)
       runtime_group, "writing statepoints", time_statepoint.elapsed());
     close_group(runtime_group);
 
-    file_close(file_id);
+    // Write the time spent in each profiled region
+    if (settings::profile) {
+      hid_t profile_group = create_group(file_id, "profile");
+      write_profile(profile_group);
+      close_group(profile_group);
+    }
+
+    if (!async)
+      file_close(file_id);
   }
 
 #ifdef PHDF5
@@ -312,15 +361,28 @@ extern "C" int openmc_statepoint_write(const char* filename, bool* write_source)
   bool parallel = false;
 #endif
 
+  // With parallel HDF5, tally results that were not reduced are written by
+  // all processes together
+  bool parallel_tallies = parallel && !settings::reduce_tallies &&
+                          !settings::tally_rank_files;
+
   // Write the source bank if desired
-  if (write_source_) {
-    if (mpi::master || parallel)
+  if (write_source_ || parallel_tallies) {
+    // An in-memory file is still open on the master
+    bool reopen = (mpi::master || parallel) && !async;
+    if (reopen)
       file_id = file_open(filename_, 'a', true);
-    write_source_bank(file_id, false);
-    if (mpi::master || parallel)
+    if (parallel_tallies)
+      write_tally_results_parallel(file_id);
+    if (write_source_)
+      write_source_bank(file_id, false);
+    if (reopen)
       file_close(file_id);
   }
 
+  if (mpi::master && async)
+    file_close_async(file_id, filename_);
+
 #if defined(LIBMESH) || defined(DAGMC)
   // write unstructured mesh tally files
   write_unstructured_mesh_results();
@@ -471,9 +533,18 @@ void load_state_point()
           tally->writable_ = false;
         } else {
 
-          auto& results = tally->results_;
-          read_tally_results(tally_group, results.shape()[0],
-            results.shape()[1], results.data());
+          if (tally->sparse_results_) {
+            tally->sparse_results_->read(tally_group);
+          } else {
+            auto& results = tally->results_;
+#ifdef PHDF5
+            read_tally_results_parallel(tally_group, results.shape()[0],
+              results.shape()[1], results.data());
+#else
+            read_tally_results(tally_group, results.shape()[0],
+              results.shape()[1], results.data());
+#endif
+          }
           read_dataset(tally_group, "n_realizations", tally->n_realizations_);
           close_group(tally_group);
         }
@@ -483,6 +554,24 @@ void load_state_point()
     }
   }
 
+  // Results of user tallies that each process wrote to its own file are read
+  // back by the same process
+  if (attribute_exists(file_id, "n_tally_rank_files")) {
+    int n_files;
+    read_attribute(file_id, "n_tally_rank_files", n_files);
+    if (n_files != mpi::n_procs || settings::reduce_tallies) {
+      fatal_error(fmt::format(
+        "Tally results were written to {} per-process files and can only be "
+        "restored by as many processes with tally reduction disabled.",
+        n_files));
+    }
+    std::string base = settings::path_statepoint;
+    if (ends_with(base, ".h5"))
+      base.erase(base.size() - 3);
+    read_tally_results_rank(
+      file_id, fmt::format("{}.rank{}.h5", base, mpi::rank));
+  }
+
   // Read source if in eigenvalue mode
   if (settings::run_mode == RunMode::EIGENVALUE) {
 
@@ -538,6 +627,62 @@ hid_t h5banktype()
   return banktype;
 }
 
+hid_t h5banktype_single()
+{
+  // Positions and directions are stored as floats. The members have the same
+  // names as in the native bank datatype, so HDF5 converts between the two
+  // when sites are read or written.
+  hid_t postype = H5Tcreate(H5T_COMPOUND, 3 * sizeof(float));
+  H5Tinsert(postype, "x", 0, H5T_NATIVE_FLOAT);
+  H5Tinsert(postype, "y", sizeof(float), H5T_NATIVE_FLOAT);
+  H5Tinsert(postype, "z", 2 * sizeof(float), H5T_NATIVE_FLOAT);
+
+  // Members are packed one after another
+  size_t size = 6 * sizeof(float) + 2 * sizeof(double) + 3 * sizeof(int);
+  hid_t banktype = H5Tcreate(H5T_COMPOUND, size);
+  size_t offset = 0;
+  H5Tinsert(banktype, "r", offset, postype);
+  offset += 3 * sizeof(float);
+  H5Tinsert(banktype, "u", offset, postype);
+  offset += 3 * sizeof(float);
+  H5Tinsert(banktype, "E", offset, H5T_NATIVE_DOUBLE);
+  offset += sizeof(double);
+  H5Tinsert(banktype, "wgt", offset, H5T_NATIVE_DOUBLE);
+  offset += sizeof(double);
+  H5Tinsert(banktype, "delayed_group", offset, H5T_NATIVE_INT);
+  offset += sizeof(int);
+  H5Tinsert(banktype, "surf_id", offset, H5T_NATIVE_INT);
+  offset += sizeof(int);
+  H5Tinsert(banktype, "particle", offset, H5T_NATIVE_INT);
+
+  H5Tclose(postype);
+  return banktype;
+}
+
+hid_t source_bank_dcpl(hid_t filetype, hsize_t n_sites)
+{
+  hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+  bool compress = settings::source_compression > 0;
+  if (n_sites == 0 || !(compress || settings::io_stripe_size > 0))
+    return dcpl;
+
+  // Store the sites in chunks of about one file system stripe, or 1 MiB if
+  // the stripe size is not known
+  hsize_t chunk_bytes =
+    settings::io_stripe_size > 0 ? settings::io_stripe_size : 1 << 20;
+  hsize_t chunk[] {std::max<hsize_t>(chunk_bytes / H5Tget_size(filetype), 1)};
+  chunk[0] = std::min(chunk[0], n_sites);
+  H5Pset_chunk(dcpl, 1, chunk);
+
+  // Shuffling the bytes of each site groups the similar high-order bytes of
+  // the floating point values, which compress much better
+  if (compress) {
+    H5Pset_shuffle(dcpl);
+    H5Pset_deflate(dcpl, settings::source_compression);
+  }
+  return dcpl;
+}
+
 vector<int64_t> calculate_surf_source_size()
 {
   vector<int64_t> surf_source_index;
@@ -562,6 +707,80 @@ vector<int64_t> calculate_surf_source_size()
   return surf_source_index;
 }
 
+void open_surf_source_stream()
+{
+  // Each process writes its own file since the sites are written as they are
+  // banked rather than collectively
+  std::string filename = settings::path_output + "surface_source.h5";
+  if (mpi::n_procs > 1) {
+    filename = fmt::format(
+      "{}surface_source.{}.h5", settings::path_output, mpi::rank);
+  }
+  simulation::surf_source_file = file_open(filename, 'w');
+  write_attribute(simulation::surf_source_file, "filetype", "source");
+
+  // Create an empty dataset that is extended as sites are written, which
+  // requires it to be chunked
+  hid_t filetype =
+    settings::source_single_precision ? h5banktype_single() : h5banktype();
+  hsize_t dims[] {0};
+  hsize_t maxdims[] {H5S_UNLIMITED};
+  hid_t dspace = H5Screate_simple(1, dims, maxdims);
+  hid_t dcpl = source_bank_dcpl(filetype, SURF_SOURCE_BUFFER_SIZE);
+  if (H5Pget_layout(dcpl) != H5D_CHUNKED) {
+    hsize_t chunk[] {SURF_SOURCE_BUFFER_SIZE};
+    H5Pset_chunk(dcpl, 1, chunk);
+  }
+  simulation::surf_source_dset = H5Dcreate(simulation::surf_source_file,
+    "source_bank", filetype, dspace, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+  simulation::surf_source_n_written = 0;
+
+  H5Pclose(dcpl);
+  H5Sclose(dspace);
+  H5Tclose(filetype);
+}
+
+void write_surf_source_stream(const vector<SourceSite>& sites)
+{
+  if (sites.empty())
+    return;
+
+  // Extend the dataset and select the new sites at its end
+  hsize_t start[] {simulation::surf_source_n_written};
+  hsize_t count[] {sites.size()};
+  hsize_t dims[] {start[0] + count[0]};
+  H5Dset_extent(simulation::surf_source_dset, dims);
+  hid_t dspace = H5Dget_space(simulation::surf_source_dset);
+  H5Sselect_hyperslab(dspace, H5S_SELECT_SET, start, nullptr, count, nullptr);
+  hid_t memspace = H5Screate_simple(1, count, nullptr);
+
+  hid_t banktype = h5banktype();
+  H5Dwrite(simulation::surf_source_dset, banktype, memspace, dspace,
+    H5P_DEFAULT, sites.data());
+  simulation::surf_source_n_written += count[0];
+
+  H5Tclose(banktype);
+  H5Sclose(memspace);
+  H5Sclose(dspace);
+}
+
+void close_surf_source_stream()
+{
+  if (simulation::surf_source_file < 0)
+    return;
+
+  // Write the sites left in each thread's buffer
+  for (auto& buffer : simulation::surf_source_buffers) {
+    write_surf_source_stream(buffer);
+    buffer.clear();
+  }
+
+  H5Dclose(simulation::surf_source_dset);
+  file_close(simulation::surf_source_file);
+  simulation::surf_source_dset = -1;
+  simulation::surf_source_file = -1;
+}
+
 void write_source_point(const char* filename, bool surf_source_bank)
 {
   // When using parallel HDF5, the file is written to collectively by all
@@ -585,22 +804,63 @@ void write_source_point(const char* filename, bool surf_source_bank)
       simulation::current_batch, w);
   }
 
+  // As with state points, only files named after the batch are written in the
+  // background. Source files are never written collectively in the background
+  // since asynchronous writes are disabled with parallel HDF5.
+  bool async = settings::async_statepoint && !filename;
+
   hid_t file_id;
   if (mpi::master || parallel) {
-    file_id = file_open(filename_, 'w', true);
+    // Align the source bank to pages so that the file can be memory mapped
+    file_id = async ? file_open_memory(filename_, true)
+                    : file_open(filename_, 'w', true, true);
     write_attribute(file_id, "filetype", "source");
   }
 
   // Get pointer to source bank and write to file
   write_source_bank(file_id, surf_source_bank);
 
-  if (mpi::master || parallel)
-    file_close(file_id);
+  if (mpi::master || parallel) {
+    if (async) {
+      file_close_async(file_id, filename_);
+    } else {
+      file_close(file_id);
+    }
+  }
+}
+
+void file_close_async(hid_t file_id, const std::string& filename)
+{
+  // Copy the contents of the file so that the next batch can change the
+  // results while they are written
+  auto image = file_image(file_id);
+  file_close(file_id);
+
+  // Only one file is written at a time, so at most two images are held
+  finish_async_writes();
+
+  async_write_file = filename;
+  async_write = std::async(
+    std::launch::async, [filename, image = std::move(image)]() {
+      std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+      out.write(image.data(), image.size());
+      out.close();
+      return !out.fail();
+    });
+}
+
+void finish_async_writes()
+{
+  if (async_write.valid() && !async_write.get()) {
+    fatal_error("Failed to write " + async_write_file);
+  }
 }
 
 void write_source_bank(hid_t group_id, bool surf_source_bank)
 {
   hid_t banktype = h5banktype();
+  hid_t filetype =
+    settings::source_single_precision ? h5banktype_single() : h5banktype();
 
   // Set total and individual process dataspace sizes for source bank
   int64_t dims_size = settings::n_particles;
@@ -612,6 +872,10 @@ void write_source_bank(hid_t group_id, bool surf_source_bank)
   vector<int64_t> surf_source_index_vector;
   vector<SourceSite> surf_source_bank_vector;
 
+  // Make sure the whole source bank has arrived
+  if (!surf_source_bank)
+    finish_bank_exchange();
+
   // Reset dataspace sizes and vectors for surface source bank
   if (surf_source_bank) {
     surf_source_index_vector = calculate_surf_source_size();
@@ -631,8 +895,11 @@ void write_source_bank(hid_t group_id, bool surf_source_bank)
   // Set size of total dataspace for all procs and rank
   hsize_t dims[] {static_cast<hsize_t>(dims_size)};
   hid_t dspace = H5Screate_simple(1, dims, nullptr);
-  hid_t dset = H5Dcreate(group_id, "source_bank", banktype, dspace, H5P_DEFAULT,
-    H5P_DEFAULT, H5P_DEFAULT);
+
+  hid_t dcpl = source_bank_dcpl(filetype, dims[0]);
+  hid_t dset = H5Dcreate(
+    group_id, "source_bank", filetype, dspace, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+  H5Pclose(dcpl);
 
   // Create another data space but for each proc individually
   hsize_t count[] {static_cast<hsize_t>(count_size)};
@@ -661,8 +928,10 @@ void write_source_bank(hid_t group_id, bool surf_source_bank)
     // Create dataset big enough to hold all source sites
     hsize_t dims[] {static_cast<hsize_t>(dims_size)};
     hid_t dspace = H5Screate_simple(1, dims, nullptr);
-    hid_t dset = H5Dcreate(group_id, "source_bank", banktype, dspace,
-      H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    hid_t dcpl = source_bank_dcpl(filetype, dims[0]);
+    hid_t dset = H5Dcreate(group_id, "source_bank", filetype, dspace,
+      H5P_DEFAULT, dcpl, H5P_DEFAULT);
+    H5Pclose(dcpl);
 
     // Save source bank sites since the array is overwritten below
 #ifdef OPENMC_MPI
@@ -711,6 +980,7 @@ void write_source_bank(hid_t group_id, bool surf_source_bank)
   }
 #endif
 
+  H5Tclose(filetype);
   H5Tclose(banktype);
 }
 
@@ -729,11 +999,8 @@ std::string dtype_member_names(hid_t dtype_id)
   return names;
 }
 
-void read_source_bank(
-  hid_t group_id, vector<SourceSite>& sites, bool distribute)
+hid_t open_source_bank(hid_t group_id, hid_t banktype)
 {
-  hid_t banktype = h5banktype();
-
   // Open the dataset
   hid_t dset = H5Dopen(group_id, "source_bank", H5P_DEFAULT);
 
@@ -741,6 +1008,7 @@ void read_source_bank(
   hid_t dtype = H5Dget_type(dset);
   auto file_member_names = dtype_member_names(dtype);
   auto bank_member_names = dtype_member_names(banktype);
+  H5Tclose(dtype);
   if (file_member_names != bank_member_names) {
     fatal_error(fmt::format(
       "Source site attributes in file do not match what is "
@@ -748,6 +1016,28 @@ void read_source_bank(
       "attributes = ({})",
       file_member_names, bank_member_names));
   }
+  return dset;
+}
+
+void read_source_sites(hid_t dset, hid_t banktype, hid_t memspace,
+  hid_t dspace, vector<SourceSite>& sites)
+{
+#ifdef PHDF5
+  // Read data in parallel
+  hid_t plist = H5Pcreate(H5P_DATASET_XFER);
+  H5Pset_dxpl_mpio(plist, H5FD_MPIO_COLLECTIVE);
+  H5Dread(dset, banktype, memspace, dspace, plist, sites.data());
+  H5Pclose(plist);
+#else
+  H5Dread(dset, banktype, memspace, dspace, H5P_DEFAULT, sites.data());
+#endif
+}
+
+void read_source_bank(
+  hid_t group_id, vector<SourceSite>& sites, bool distribute)
+{
+  hid_t banktype = h5banktype();
+  hid_t dset = open_source_bank(group_id, banktype);
 
   hid_t dspace = H5Dget_space(dset);
   hsize_t n_sites;
@@ -777,15 +1067,7 @@ void read_source_bank(
     memspace = H5S_ALL;
   }
 
-#ifdef PHDF5
-  // Read data in parallel
-  hid_t plist = H5Pcreate(H5P_DATASET_XFER);
-  H5Pset_dxpl_mpio(plist, H5FD_MPIO_COLLECTIVE);
-  H5Dread(dset, banktype, memspace, dspace, plist, sites.data());
-  H5Pclose(plist);
-#else
-  H5Dread(dset, banktype, memspace, dspace, H5P_DEFAULT, sites.data());
-#endif
+  read_source_sites(dset, banktype, memspace, dspace, sites);
 
   // Close all ids
   H5Sclose(dspace);
@@ -795,6 +1077,37 @@ void read_source_bank(
   H5Tclose(banktype);
 }
 
+void read_source_bank_partition(hid_t group_id, vector<SourceSite>& sites)
+{
+  hid_t banktype = h5banktype();
+  hid_t dset = open_source_bank(group_id, banktype);
+
+  hid_t dspace = H5Dget_space(dset);
+  hsize_t n_sites;
+  H5Sget_simple_extent_dims(dspace, &n_sites, nullptr);
+  if (n_sites < static_cast<hsize_t>(mpi::n_procs)) {
+    fatal_error("Number of source sites in source file is less than the "
+                "number of processes it is partitioned across.");
+  }
+
+  // Each process reads a contiguous slice of the sites whose size differs
+  // from that of the other slices by at most one
+  hsize_t offset = n_sites * mpi::rank / mpi::n_procs;
+  hsize_t n_sites_local = n_sites * (mpi::rank + 1) / mpi::n_procs - offset;
+  sites.resize(n_sites_local);
+  hid_t memspace = H5Screate_simple(1, &n_sites_local, nullptr);
+  H5Sselect_hyperslab(
+    dspace, H5S_SELECT_SET, &offset, nullptr, &n_sites_local, nullptr);
+
+  read_source_sites(dset, banktype, memspace, dspace, sites);
+
+  // Close all ids
+  H5Sclose(dspace);
+  H5Sclose(memspace);
+  H5Dclose(dset);
+  H5Tclose(banktype);
+}
+
 void write_unstructured_mesh_results()
 {
 
@@ -827,59 +1140,79 @@ void write_unstructured_mesh_results()
         break;
       }
 
-      int n_realizations = tally->n_realizations_;
+      // MOAB meshes are only written by the master process whereas each
+      // process sets and writes its own part of a libMesh mesh
+      bool all_ranks = umesh->library() != "moab";
+      if (!all_ranks && !mpi::master)
+        continue;
 
-      for (int score_idx = 0; score_idx < tally->scores_.size(); score_idx++) {
-        for (int nuc_idx = 0; nuc_idx < tally->nuclides_.size(); nuc_idx++) {
-          // combine the score and nuclide into a name for the value
-          auto score_str = fmt::format("{}_{}", tally->score_name(score_idx),
-            tally->nuclide_name(nuc_idx));
-          // add this score to the mesh
-          // (this is in a separate loop because all variables need to be added
-          //  to libMesh's equation system before any are initialized, which
-          //  happens in set_score_data)
-          umesh->add_score(score_str);
+      int n_realizations = tally->n_realizations_;
+      int n_values = tally->scores_.size() * tally->nuclides_.size();
+
+      // combine each score and nuclide into a name for the value, ordered by
+      // nuclide-score index
+      vector<std::string> score_strs;
+      for (int nuc_idx = 0; nuc_idx < tally->nuclides_.size(); nuc_idx++) {
+        for (int score_idx = 0; score_idx < tally->scores_.size();
+             score_idx++) {
+          score_strs.push_back(fmt::format("{}_{}",
+            tally->score_name(score_idx), tally->nuclide_name(nuc_idx)));
         }
       }
 
-      for (int score_idx = 0; score_idx < tally->scores_.size(); score_idx++) {
-        for (int nuc_idx = 0; nuc_idx < tally->nuclides_.size(); nuc_idx++) {
-          // combine the score and nuclide into a name for the value
-          auto score_str = fmt::format("{}_{}", tally->score_name(score_idx),
-            tally->nuclide_name(nuc_idx));
-
-          // index for this nuclide and score
-          int nuc_score_idx = score_idx + nuc_idx * tally->scores_.size();
+      // add the scores to the mesh
+      // (this is in a separate loop because all variables need to be added
+      //  to libMesh's equation system before any are initialized, which
+      //  happens in set_score_data)
+      for (const auto& score_str : score_strs) {
+        umesh->add_score(score_str);
+      }
 
-          // construct result vectors
-          vector<double> mean_vec(umesh->n_bins()),
-            std_dev_vec(umesh->n_bins());
-          for (int j = 0; j < tally->results_.shape()[0]; j++) {
+      // Results for all scores are computed a chunk of bins at a time and
+      // handed to the mesh so that memory use doesn't scale with the number
+      // of elements times the number of scores
+      int n_bins = tally->n_filter_bins();
+      int chunk_size = std::min(UMESH_RESULTS_CHUNK_SIZE, n_bins);
+      vector<double> mean_vec(n_values * chunk_size);
+      vector<double> std_dev_vec(n_values * chunk_size);
+      for (int offset = 0; offset < n_bins; offset += chunk_size) {
+        int n = std::min(chunk_size, n_bins - offset);
+
+        if (mpi::master) {
+          for (int i = 0; i < n; i++) {
+            int j = offset + i;
             // get the volume for this bin
             double volume = umesh->volume(j);
-            // compute the mean
-            double mean = tally->results_(j, nuc_score_idx, TallyResult::SUM) /
-                          n_realizations;
-            mean_vec.at(j) = mean / volume;
-
-            // compute the standard deviation
-            double sum_sq =
-              tally->results_(j, nuc_score_idx, TallyResult::SUM_SQ);
-            double std_dev {0.0};
-            if (n_realizations > 1) {
-              std_dev = sum_sq / n_realizations - mean * mean;
-              std_dev = std::sqrt(std_dev / (n_realizations - 1));
+            for (int k = 0; k < n_values; k++) {
+              // compute the mean
+              double mean =
+                tally->result(j, k, TallyResult::SUM) / n_realizations;
+
+              // compute the standard deviation
+              double sum_sq = tally->result(j, k, TallyResult::SUM_SQ);
+              double std_dev {0.0};
+              if (n_realizations > 1) {
+                std_dev = sum_sq / n_realizations - mean * mean;
+                std_dev = std::sqrt(std_dev / (n_realizations - 1));
+              }
+              mean_vec[k * n + i] = mean / volume;
+              std_dev_vec[k * n + i] = std_dev / volume;
             }
-            std_dev_vec[j] = std_dev / volume;
           }
+        }
 #ifdef OPENMC_MPI
-          MPI_Bcast(
-            mean_vec.data(), mean_vec.size(), MPI_DOUBLE, 0, mpi::intracomm);
-          MPI_Bcast(std_dev_vec.data(), std_dev_vec.size(), MPI_DOUBLE, 0,
+        if (all_ranks) {
+          MPI_Bcast(mean_vec.data(), n_values * n, MPI_DOUBLE, 0,
             mpi::intracomm);
+          MPI_Bcast(std_dev_vec.data(), n_values * n, MPI_DOUBLE, 0,
+            mpi::intracomm);
+        }
 #endif
-          // set the data for this score
-          umesh->set_score_data(score_str, mean_vec, std_dev_vec);
+        // set the data for each score in this chunk
+        for (int k = 0; k < n_values; k++) {
+          gsl::span<const double> mean_span(mean_vec.data() + k * n, n);
+          gsl::span<const double> std_dev_span(std_dev_vec.data() + k * n, n);
+          umesh->set_score_data(score_strs[k], offset, mean_span, std_dev_span);
         }
       }
 
@@ -889,9 +1222,6 @@ void write_unstructured_mesh_results()
       std::string filename = fmt::format("tally_{0}.{1:0{2}}", tally->id_,
         simulation::current_batch, batch_width);
 
-      if (umesh->library() == "moab" && !mpi::master)
-        continue;
-
       // Write the unstructured mesh and data to file
       umesh->write(filename);
 
@@ -936,6 +1266,28 @@ void write_tally_results_nr(hid_t file_id)
     write_dataset(file_id, "global_tallies", gt);
   }
 
+  // Results of user tallies are left to the file written by each process
+  if (settings::tally_rank_files) {
+    if (mpi::master) {
+      write_attribute(file_id, "tallies_present", 0);
+      write_attribute(file_id, "n_tally_rank_files", mpi::n_procs);
+      close_group(tallies_group);
+    }
+    return;
+  }
+
+#ifdef PHDF5
+  // Results of user tallies are written by all processes once the file has
+  // been reopened for parallel access
+  if (mpi::master) {
+    bool present = std::any_of(model::tallies.begin(), model::tallies.end(),
+      [](const unique_ptr<Tally>& t) { return t->active_ && t->writable_; });
+    write_attribute(file_id, "tallies_present", present ? 1 : 0);
+    close_group(tallies_group);
+  }
+  return;
+#endif
+
   for (const auto& t : model::tallies) {
     // Skip any tallies that are not active
     if (!t->active_)
@@ -1005,4 +1357,218 @@ void write_tally_results_nr(hid_t file_id)
   }
 }
 
+void write_tally_results_parallel(hid_t file_id)
+{
+#ifdef PHDF5
+  hid_t tallies_group = open_group(file_id, "tallies");
+
+  for (const auto& t : model::tallies) {
+    if (!t->active_ || !t->writable_)
+      continue;
+
+    // Make copy of the sums and sums of squares in a contiguous array
+    auto values_view = xt::view(t->results_, xt::all(), xt::all(),
+      xt::range(static_cast<int>(TallyResult::SUM),
+        static_cast<int>(TallyResult::SUM_SQ) + 1));
+    xt::xtensor<double, 3> values = values_view;
+    hsize_t n_filter = values.shape()[0];
+    hsize_t n_score = values.shape()[1];
+    int n_per_bin = n_score * 2;
+
+    // Each process owns a contiguous range of filter bins
+    vector<int> counts(mpi::n_procs);
+    vector<int> displs(mpi::n_procs);
+    for (int i = 0; i < mpi::n_procs; ++i) {
+      hsize_t first = n_filter * i / mpi::n_procs;
+      hsize_t last = n_filter * (i + 1) / mpi::n_procs;
+      displs[i] = first * n_per_bin;
+      counts[i] = (last - first) * n_per_bin;
+    }
+    hsize_t first_bin = displs[mpi::rank] / n_per_bin;
+    hsize_t n_bins = counts[mpi::rank] / n_per_bin;
+
+    // Sum the results over all processes, leaving each process with only the
+    // filter bins it owns
+    vector<double> owned(counts[mpi::rank]);
+    MPI_Reduce_scatter(values.data(), owned.data(), counts.data(), MPI_DOUBLE,
+      MPI_SUM, mpi::intracomm);
+
+    // At the end of the simulation, store the results back in the regular
+    // TallyResults array on the master process
+    if (simulation::current_batch == settings::n_max_batches ||
+        simulation::satisfy_triggers) {
+      MPI_Gatherv(owned.data(), owned.size(), MPI_DOUBLE, values.data(),
+        counts.data(), displs.data(), MPI_DOUBLE, 0, mpi::intracomm);
+      if (mpi::master)
+        values_view = values;
+    }
+
+    // Create the dataset collectively, with chunks of about one stripe. If
+    // the stripe size is not given, the default Lustre stripe size of 1 MiB
+    // is used.
+    std::string groupname {"tally " + std::to_string(t->id_)};
+    hid_t tally_group = open_group(tallies_group, groupname.c_str());
+    hsize_t stripe =
+      settings::io_stripe_size > 0 ? settings::io_stripe_size : 1 << 20;
+    hsize_t n_chunk = stripe / (n_per_bin * sizeof(double));
+    hid_t dset = create_tally_results(
+      tally_group, n_filter, n_score, std::max<hsize_t>(n_chunk, 1));
+
+    // Select the filter bins owned by this process
+    constexpr int ndim = 3;
+    hsize_t count[ndim] {n_bins, n_score, 2};
+    hsize_t start[ndim] {first_bin, 0, 0};
+    hid_t memspace = H5Screate_simple(ndim, count, nullptr);
+    hid_t filespace = H5Dget_space(dset);
+    if (n_bins > 0) {
+      H5Sselect_hyperslab(
+        filespace, H5S_SELECT_SET, start, nullptr, count, nullptr);
+    } else {
+      H5Sselect_none(memspace);
+      H5Sselect_none(filespace);
+    }
+
+    // Write the results of all processes collectively
+    hid_t plist = H5Pcreate(H5P_DATASET_XFER);
+    H5Pset_dxpl_mpio(plist, H5FD_MPIO_COLLECTIVE);
+    H5Dwrite(dset, H5T_NATIVE_DOUBLE, memspace, filespace, plist, owned.data());
+
+    // Free resources
+    H5Pclose(plist);
+    H5Sclose(filespace);
+    H5Sclose(memspace);
+    close_dataset(dset);
+    close_group(tally_group);
+  }
+
+  close_group(tallies_group);
+#endif
+}
+
+void read_tally_results_parallel(
+  hid_t group_id, hsize_t n_filter, hsize_t n_score, double* results)
+{
+#ifdef PHDF5
+  int n_per_bin = n_score * 2;
+
+  // Each process reads a contiguous range of filter bins
+  vector<int> counts(mpi::n_procs);
+  vector<int> displs(mpi::n_procs);
+  for (int i = 0; i < mpi::n_procs; ++i) {
+    hsize_t first = n_filter * i / mpi::n_procs;
+    hsize_t last = n_filter * (i + 1) / mpi::n_procs;
+    displs[i] = first * n_per_bin;
+    counts[i] = (last - first) * n_per_bin;
+  }
+  hsize_t first_bin = displs[mpi::rank] / n_per_bin;
+  hsize_t n_bins = counts[mpi::rank] / n_per_bin;
+
+  // Select the filter bins read by this process
+  hid_t dset = open_dataset(group_id, "results");
+  constexpr int ndim = 3;
+  hsize_t count[ndim] {n_bins, n_score, 2};
+  hsize_t start[ndim] {first_bin, 0, 0};
+  hid_t memspace = H5Screate_simple(ndim, count, nullptr);
+  hid_t filespace = H5Dget_space(dset);
+  if (n_bins > 0) {
+    H5Sselect_hyperslab(
+      filespace, H5S_SELECT_SET, start, nullptr, count, nullptr);
+  } else {
+    H5Sselect_none(memspace);
+    H5Sselect_none(filespace);
+  }
+
+  // Read the results of all processes collectively
+  vector<double> owned(counts[mpi::rank]);
+  hid_t plist = H5Pcreate(H5P_DATASET_XFER);
+  H5Pset_dxpl_mpio(plist, H5FD_MPIO_COLLECTIVE);
+  H5Dread(dset, H5T_NATIVE_DOUBLE, memspace, filespace, plist, owned.data());
+
+  // Free resources
+  H5Pclose(plist);
+  H5Sclose(filespace);
+  H5Sclose(memspace);
+  close_dataset(dset);
+
+  // Gather the sums and sums of squares on the master process
+  vector<double> values(mpi::master ? n_filter * n_per_bin : 0);
+  MPI_Gatherv(owned.data(), owned.size(), MPI_DOUBLE, values.data(),
+    counts.data(), displs.data(), MPI_DOUBLE, 0, mpi::intracomm);
+  if (mpi::master) {
+    constexpr int sum = static_cast<int>(TallyResult::SUM);
+    constexpr int sum_sq = static_cast<int>(TallyResult::SUM_SQ);
+    for (hsize_t i = 0; i < n_filter * n_score; ++i) {
+      results[3 * i + sum] = values[2 * i];
+      results[3 * i + sum_sq] = values[2 * i + 1];
+    }
+  }
+#endif
+}
+
+void read_tally_results_rank(hid_t file_id, const std::string& filename)
+{
+  hid_t rank_file_id = file_open(filename, 'r');
+  std::string filetype;
+  read_attribute(rank_file_id, "filetype", filetype);
+  int rank;
+  read_attribute(rank_file_id, "rank", rank);
+  if (filetype != "tally results" || rank != mpi::rank) {
+    fatal_error(fmt::format(
+      "{} does not hold the tally results of process {}.", filename, mpi::rank));
+  }
+
+  // Read the sum and sum_sq accumulated on this process for each tally. The
+  // number of realizations is the same on all processes.
+  hid_t tallies_group = open_group(file_id, "tallies");
+  hid_t rank_tallies_group = open_group(rank_file_id, "tallies");
+  for (auto& t : model::tallies) {
+    if (!t->writable_)
+      continue;
+
+    std::string groupname {"tally " + std::to_string(t->id_)};
+    if (!object_exists(rank_tallies_group, groupname.c_str()))
+      continue;
+    hid_t tally_group = open_group(tallies_group, groupname.c_str());
+    read_dataset(tally_group, "n_realizations", t->n_realizations_);
+    close_group(tally_group);
+
+    tally_group = open_group(rank_tallies_group, groupname.c_str());
+    auto& results = t->results_;
+    read_tally_results(
+      tally_group, results.shape()[0], results.shape()[1], results.data());
+    close_group(tally_group);
+  }
+  close_group(rank_tallies_group);
+  close_group(tallies_group);
+
+  file_close(rank_file_id);
+}
+
+void write_tally_results_rank(const std::string& filename)
+{
+  hid_t file_id = file_open(filename, 'w');
+  write_attribute(file_id, "filetype", "tally results");
+  write_attribute(file_id, "version", VERSION_STATEPOINT);
+  write_attribute(file_id, "rank", mpi::rank);
+  write_attribute(file_id, "n_procs", mpi::n_procs);
+  write_dataset(file_id, "current_batch", simulation::current_batch);
+
+  // Write the sum and sum_sq accumulated on this process for each tally
+  hid_t tallies_group = create_group(file_id, "tallies");
+  for (const auto& t : model::tallies) {
+    if (!t->active_ || !t->writable_)
+      continue;
+
+    std::string groupname {"tally " + std::to_string(t->id_)};
+    hid_t tally_group = create_group(tallies_group, groupname.c_str());
+    auto& results = t->results_;
+    write_tally_results(
+      tally_group, results.shape()[0], results.shape()[1], results.data());
+    close_group(tally_group);
+  }
+  close_group(tallies_group);
+
+  file_close(file_id);
+}
+
 } // namespace openmc
@@ -1,5 +1,9 @@
 #include "openmc/summary.h"
 
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+
 #include <fmt/core.h>
 
 #include "openmc/capi.h"
@@ -13,28 +17,88 @@
 #include "openmc/nuclide.h"
 #include "openmc/output.h"
 #include "openmc/settings.h"
+#include "openmc/state_point.h"
 #include "openmc/surface.h"
 
 namespace openmc {
 
 void write_summary()
 {
-  // Display output message
-  write_message("Writing summary.h5 file...", 5);
-
   // Set filename for summary file
   std::string filename = fmt::format("{}summary.h5", settings::path_output);
 
-  // Create a new file using default properties.
-  hid_t file = file_open(filename, 'w');
+  // Keep a summary file that was written from the same input
+  auto hash = summary_input_hash();
+  if (settings::summary_reuse && summary_is_current(filename, hash)) {
+    write_message("Reusing existing summary.h5 file...", 5);
+    return;
+  }
+
+  // Display output message
+  write_message("Writing summary.h5 file...", 5);
+
+  // Build the file in memory if it is to be written in the background
+  bool async = settings::async_statepoint;
+  hid_t file = async ? file_open_memory(filename) : file_open(filename, 'w');
 
   write_header(file);
+  write_attribute(file, "input_hash", hash);
   write_nuclides(file);
   write_geometry(file);
   write_materials(file);
 
   // Terminate access to the file.
+  if (async) {
+    file_close_async(file, filename);
+  } else {
+    file_close(file);
+  }
+}
+
+std::string summary_input_hash()
+{
+  // Use 64-bit FNV-1a so that the hash is the same for every build
+  uint64_t hash = 14695981039346656037ull;
+  auto update = [&hash](const std::string& s) {
+    for (unsigned char c : s) {
+      hash ^= c;
+      hash *= 1099511628211ull;
+    }
+    // Separate consecutive strings
+    hash ^= 0xff;
+    hash *= 1099511628211ull;
+  };
+
+  update(fmt::format("{}.{}.{}", VERSION[0], VERSION[1], VERSION[2]));
+  update(settings::summary_compact ? "compact" : "groups");
+  update(settings::path_cross_sections);
+  for (const char* name : {"settings.xml", "geometry.xml", "materials.xml"}) {
+    std::ifstream in(settings::path_input + name, std::ios::binary);
+    std::stringstream contents;
+    contents << in.rdbuf();
+    update(contents.str());
+  }
+
+  return fmt::format("{:016x}", hash);
+}
+
+bool summary_is_current(const std::string& filename, const std::string& hash)
+{
+  // A file left incomplete by an interrupted run is simply rewritten
+  if (!file_exists(filename) || H5Fis_hdf5(filename.c_str()) <= 0)
+    return false;
+  hid_t file = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+  if (file < 0)
+    return false;
+
+  bool current = false;
+  if (attribute_exists(file, "input_hash")) {
+    std::string file_hash;
+    read_attribute(file, "input_hash", file_hash);
+    current = (file_hash == hash);
+  }
   file_close(file);
+  return current;
 }
 
 void write_header(hid_t file)
@@ -102,9 +166,20 @@ void write_geometry(hid_t file)
   write_attribute(geom_group, "n_universes", model::universes.size());
   write_attribute(geom_group, "n_lattices", model::lattices.size());
 
+  // Tables can only describe CSG cells and universes
+  bool compact = settings::summary_compact;
+  for (const auto& u : model::universes) {
+    if (u->geom_type() == GeometryType::DAG)
+      compact = false;
+  }
+
   auto cells_group = create_group(geom_group, "cells");
-  for (const auto& c : model::cells)
-    c->to_hdf5(cells_group);
+  if (compact) {
+    write_cells_compact(cells_group);
+  } else {
+    for (const auto& c : model::cells)
+      c->to_hdf5(cells_group);
+  }
   close_group(cells_group);
 
   auto surfaces_group = create_group(geom_group, "surfaces");
@@ -113,8 +188,12 @@ void write_geometry(hid_t file)
   close_group(surfaces_group);
 
   auto universes_group = create_group(geom_group, "universes");
-  for (const auto& u : model::universes)
-    u->to_hdf5(universes_group);
+  if (compact) {
+    write_universes_compact(universes_group);
+  } else {
+    for (const auto& u : model::universes)
+      u->to_hdf5(universes_group);
+  }
   close_group(universes_group);
 
   auto lattices_group = create_group(geom_group, "lattices");
@@ -125,6 +204,100 @@ void write_geometry(hid_t file)
   close_group(geom_group);
 }
 
+void write_cells_compact(hid_t cells_group)
+{
+  vector<int32_t> ids;
+  vector<std::string> names;
+  vector<int32_t> universes;
+  vector<std::string> fill_types;
+  vector<int32_t> fills;
+  vector<std::string> regions;
+  vector<int32_t> materials;
+  vector<int32_t> material_offsets {0};
+  vector<double> temperatures;
+  vector<int32_t> temperature_offsets {0};
+  vector<int32_t> translation_index;
+  vector<double> translations;
+  vector<int32_t> rotation_index;
+  vector<double> rotations;
+
+  for (int32_t i = 0; i < model::cells.size(); ++i) {
+    const auto& c = *model::cells[i];
+    ids.push_back(c.id_);
+    names.push_back(c.name_);
+    universes.push_back(model::universes[c.universe_]->id_);
+    regions.push_back(c.region_spec());
+
+    if (c.type_ == Fill::MATERIAL) {
+      fill_types.push_back("material");
+      fills.push_back(C_NONE);
+      for (auto i_mat : c.material_) {
+        materials.push_back(
+          i_mat != MATERIAL_VOID ? model::materials[i_mat]->id_ : MATERIAL_VOID);
+      }
+      for (auto sqrtkT : c.sqrtkT_) {
+        temperatures.push_back(sqrtkT * sqrtkT / K_BOLTZMANN);
+      }
+    } else if (c.type_ == Fill::UNIVERSE) {
+      fill_types.push_back("universe");
+      fills.push_back(model::universes[c.fill_]->id_);
+      if (c.translation_ != Position(0, 0, 0)) {
+        translation_index.push_back(i);
+        translations.insert(translations.end(),
+          {c.translation_.x, c.translation_.y, c.translation_.z});
+      }
+      if (!c.rotation_.empty()) {
+        // Rotations are always written as the full rotation matrix
+        rotation_index.push_back(i);
+        rotations.insert(
+          rotations.end(), c.rotation_.begin(), c.rotation_.begin() + 9);
+      }
+    } else {
+      fill_types.push_back("lattice");
+      fills.push_back(model::lattices[c.fill_]->id_);
+    }
+    material_offsets.push_back(materials.size());
+    temperature_offsets.push_back(temperatures.size());
+  }
+
+  write_dataset(cells_group, "id", ids);
+  write_dataset(cells_group, "name", names);
+  write_dataset(cells_group, "universe", universes);
+  write_dataset(cells_group, "fill_type", fill_types);
+  write_dataset(cells_group, "fill", fills);
+  write_dataset(cells_group, "region", regions);
+  write_dataset(cells_group, "material", materials);
+  write_dataset(cells_group, "material_offset", material_offsets);
+  write_dataset(cells_group, "temperature", temperatures);
+  write_dataset(cells_group, "temperature_offset", temperature_offsets);
+  write_dataset(cells_group, "translation_index", translation_index);
+  hsize_t dims[] {translation_index.size(), 3};
+  write_double(
+    cells_group, 2, dims, "translation", translations.data(), false);
+  write_dataset(cells_group, "rotation_index", rotation_index);
+  dims[0] = rotation_index.size();
+  dims[1] = 9;
+  write_double(cells_group, 2, dims, "rotation", rotations.data(), false);
+}
+
+void write_universes_compact(hid_t universes_group)
+{
+  vector<int32_t> ids;
+  vector<int32_t> cells;
+  vector<int32_t> cell_offsets {0};
+  for (const auto& u : model::universes) {
+    ids.push_back(u->id_);
+    for (auto i_cell : u->cells_) {
+      cells.push_back(model::cells[i_cell]->id_);
+    }
+    cell_offsets.push_back(cells.size());
+  }
+
+  write_dataset(universes_group, "id", ids);
+  write_dataset(universes_group, "cells", cells);
+  write_dataset(universes_group, "cell_offset", cell_offsets);
+}
+
 void write_materials(hid_t file)
 {
   // write number of materials
@@ -154,12 +327,44 @@ extern "C" int openmc_properties_export(const char* filename)
   auto msg = fmt::format("Exporting properties to {}...", name);
   write_message(msg, 5);
 
+  // Gather the temperatures of all cells into one array, with the
+  // temperatures of cell i at [offset[i], offset[i + 1])
+  auto n_cells = model::cells.size();
+  vector<int32_t> cell_ids(n_cells);
+  vector<int64_t> temperature_offset(n_cells + 1, 0);
+  for (int32_t i = 0; i < n_cells; ++i) {
+    cell_ids[i] = model::cells[i]->id_;
+    temperature_offset[i + 1] =
+      temperature_offset[i] + model::cells[i]->sqrtkT_.size();
+  }
+  vector<double> temperatures(temperature_offset.back());
+#pragma omp parallel for schedule(static)
+  for (int32_t i = 0; i < n_cells; ++i) {
+    const auto& sqrtkT = model::cells[i]->sqrtkT_;
+    for (int j = 0; j < sqrtkT.size(); ++j) {
+      temperatures[temperature_offset[i] + j] =
+        sqrtkT[j] * sqrtkT[j] / K_BOLTZMANN;
+    }
+  }
+
+  // Gather the densities of all materials
+  auto n_materials = model::materials.size();
+  vector<int32_t> material_ids(n_materials);
+  vector<double> atom_density(n_materials);
+  vector<double> mass_density(n_materials);
+  for (int32_t i = 0; i < n_materials; ++i) {
+    const auto& mat = *model::materials[i];
+    material_ids[i] = mat.id_;
+    atom_density[i] = mat.density();
+    mass_density[i] = mat.density_gpcc();
+  }
+
   // Create a new file using default properties.
   hid_t file = file_open(name, 'w');
 
   // Write metadata
   write_attribute(file, "filetype", "properties");
-  write_attribute(file, "version", VERSION_STATEPOINT);
+  write_attribute(file, "version", VERSION_PROPERTIES);
   write_attribute(file, "openmc_version", VERSION);
 #ifdef GIT_SHA1
   write_attribute(file, "git_sha1", GIT_SHA1);
@@ -169,20 +374,20 @@ extern "C" int openmc_properties_export(const char* filename)
 
   // Write cell properties
   auto geom_group = create_group(file, "geometry");
-  write_attribute(geom_group, "n_cells", model::cells.size());
+  write_attribute(geom_group, "n_cells", n_cells);
   auto cells_group = create_group(geom_group, "cells");
-  for (const auto& c : model::cells) {
-    c->export_properties_hdf5(cells_group);
-  }
+  write_dataset(cells_group, "id", cell_ids);
+  write_dataset(cells_group, "temperature", temperatures);
+  write_dataset(cells_group, "temperature_offset", temperature_offset);
   close_group(cells_group);
   close_group(geom_group);
 
   // Write material properties
   hid_t materials_group = create_group(file, "materials");
-  write_attribute(materials_group, "n_materials", model::materials.size());
-  for (const auto& mat : model::materials) {
-    mat->export_properties_hdf5(materials_group);
-  }
+  write_attribute(materials_group, "n_materials", n_materials);
+  write_dataset(materials_group, "id", material_ids);
+  write_dataset(materials_group, "atom_density", atom_density);
+  write_dataset(materials_group, "mass_density", mass_density);
   close_group(materials_group);
 
   // Terminate access to the file.
@@ -190,6 +395,89 @@ extern "C" int openmc_properties_export(const char* filename)
   return 0;
 }
 
+//! Set cell temperatures from the contiguous arrays of a properties file
+int import_cell_temperatures(hid_t cells_group, const std::string& filename)
+{
+  vector<int32_t> ids;
+  vector<double> temperatures;
+  vector<int64_t> offset;
+  read_dataset(cells_group, "id", ids);
+  read_dataset(cells_group, "temperature", temperatures);
+  read_dataset(cells_group, "temperature_offset", offset);
+  if (offset.size() != model::cells.size() + 1 ||
+      offset.back() != temperatures.size()) {
+    set_errmsg(fmt::format("Cell temperatures in {} are malformed.", filename));
+    return OPENMC_E_INVALID_ARGUMENT;
+  }
+
+  // List every instance whose temperature is set. A single temperature
+  // applies to all instances of a cell.
+  vector<int32_t> index;
+  vector<int32_t> instance;
+  vector<double> T;
+  for (int32_t i = 0; i < model::cells.size(); ++i) {
+    const auto& c = *model::cells[i];
+    if (ids[i] != c.id_) {
+      set_errmsg(
+        fmt::format("Cell IDs in {} don't match current model.", filename));
+      return OPENMC_E_GEOMETRY;
+    }
+    auto n_temps = offset[i + 1] - offset[i];
+    if (n_temps > 1 && n_temps != c.n_instances_) {
+      set_errmsg(fmt::format("Number of temperatures for cell {} doesn't "
+                             "match number of instances",
+        c.id_));
+      return OPENMC_E_INVALID_ARGUMENT;
+    }
+    for (int32_t j = 0; j < n_temps; ++j) {
+      index.push_back(i);
+      instance.push_back(n_temps > 1 ? j : -1);
+      T.push_back(temperatures[offset[i] + j]);
+    }
+  }
+
+  return openmc_cells_set_temperatures(
+    index.size(), index.data(), instance.data(), T.data());
+}
+
+//! Set material densities from the contiguous arrays of a properties file
+int import_material_densities(
+  hid_t materials_group, const std::string& filename)
+{
+  vector<int32_t> ids;
+  vector<double> atom_density;
+  read_dataset(materials_group, "id", ids);
+  read_dataset(materials_group, "atom_density", atom_density);
+  if (ids.size() != model::materials.size() ||
+      atom_density.size() != ids.size()) {
+    set_errmsg(
+      fmt::format("Material densities in {} are malformed.", filename));
+    return OPENMC_E_INVALID_ARGUMENT;
+  }
+  for (int32_t i = 0; i < ids.size(); ++i) {
+    if (ids[i] != model::materials[i]->id_) {
+      set_errmsg(
+        fmt::format("Material IDs in {} don't match current model.", filename));
+      return OPENMC_E_GEOMETRY;
+    }
+  }
+
+  int err = 0;
+#pragma omp parallel for schedule(static)
+  for (int32_t i = 0; i < ids.size(); ++i) {
+    try {
+      model::materials[i]->set_density(atom_density[i], "atom/b-cm");
+    } catch (const std::exception& e) {
+#pragma omp critical(ImportMaterialDensities)
+      {
+        set_errmsg(e.what());
+        err = OPENMC_E_UNASSIGNED;
+      }
+    }
+  }
+  return err;
+}
+
 extern "C" int openmc_properties_import(const char* filename)
 {
   // Display output message
@@ -224,20 +512,30 @@ extern "C" int openmc_properties_import(const char* filename)
     return OPENMC_E_GEOMETRY;
   }
 
-  // Read cell properties
+  // Read cell properties. Files written before version 2.0 of the format have
+  // a group per cell.
   auto cells_group = open_group(geom_group, "cells");
-  try {
-    for (const auto& c : model::cells) {
-      c->import_properties_hdf5(cells_group);
+  int err = 0;
+  if (object_exists(cells_group, "temperature")) {
+    err = import_cell_temperatures(cells_group, filename);
+  } else {
+    try {
+      for (const auto& c : model::cells) {
+        c->import_properties_hdf5(cells_group);
+      }
+    } catch (const std::exception& e) {
+      set_errmsg(e.what());
+      err = OPENMC_E_UNASSIGNED;
     }
-  } catch (const std::exception& e) {
-    set_errmsg(e.what());
-    return OPENMC_E_UNASSIGNED;
   }
   close_group(cells_group);
   close_group(geom_group);
+  if (err) {
+    file_close(file);
+    return err;
+  }
 
-  // Make sure number of cells matches
+  // Make sure number of materials matches
   auto materials_group = open_group(file, "materials");
   read_attribute(materials_group, "n_materials", n);
   if (n != openmc::model::materials.size()) {
@@ -249,14 +547,23 @@ extern "C" int openmc_properties_import(const char* filename)
   }
 
   // Read material properties
-  for (const auto& mat : model::materials) {
-    mat->import_properties_hdf5(materials_group);
+  if (object_exists(materials_group, "atom_density")) {
+    err = import_material_densities(materials_group, filename);
+  } else {
+    try {
+      for (const auto& mat : model::materials) {
+        mat->import_properties_hdf5(materials_group);
+      }
+    } catch (const std::exception& e) {
+      set_errmsg(e.what());
+      err = OPENMC_E_UNASSIGNED;
+    }
   }
   close_group(materials_group);
 
   // Terminate access to the file.
   file_close(file);
-  return 0;
+  return err;
 }
 
 } // namespace openmc
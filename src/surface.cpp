@@ -1,7 +1,9 @@
 #include "openmc/surface.h"
 
+#include <algorithm> // for min, max
 #include <cmath>
 #include <complex>
+#include <initializer_list>
 #include <set>
 #include <utility>
 
@@ -28,6 +30,7 @@ namespace openmc {
 namespace model {
 std::unordered_map<int, int> surface_map;
 vector<unique_ptr<Surface>> surfaces;
+SurfaceStore surface_store;
 } // namespace model
 
 //==============================================================================
@@ -394,23 +397,19 @@ BoundingBox SurfaceZPlane::bounding_box(bool pos_side) const
 }
 
 //==============================================================================
-// SurfacePlane implementation
+// Generic functions for general planes
 //==============================================================================
 
-SurfacePlane::SurfacePlane(pugi::xml_node surf_node) : CSGSurface(surf_node)
-{
-  read_coeffs(surf_node, id_, A_, B_, C_, D_);
-}
-
-double SurfacePlane::evaluate(Position r) const
+double plane_evaluate(Position r, double A, double B, double C, double D)
 {
-  return A_ * r.x + B_ * r.y + C_ * r.z - D_;
+  return A * r.x + B * r.y + C * r.z - D;
 }
 
-double SurfacePlane::distance(Position r, Direction u, bool coincident) const
+double plane_distance(Position r, Direction u, bool coincident, double A,
+  double B, double C, double D)
 {
-  const double f = A_ * r.x + B_ * r.y + C_ * r.z - D_;
-  const double projection = A_ * u.x + B_ * u.y + C_ * u.z;
+  const double f = A * r.x + B * r.y + C * r.z - D;
+  const double projection = A * u.x + B * u.y + C * u.z;
   if (coincident || std::abs(f) < FP_COINCIDENT || projection == 0.0) {
     return INFTY;
   } else {
@@ -421,6 +420,25 @@ double SurfacePlane::distance(Position r, Direction u, bool coincident) const
   }
 }
 
+//==============================================================================
+// SurfacePlane implementation
+//==============================================================================
+
+SurfacePlane::SurfacePlane(pugi::xml_node surf_node) : CSGSurface(surf_node)
+{
+  read_coeffs(surf_node, id_, A_, B_, C_, D_);
+}
+
+double SurfacePlane::evaluate(Position r) const
+{
+  return plane_evaluate(r, A_, B_, C_, D_);
+}
+
+double SurfacePlane::distance(Position r, Direction u, bool coincident) const
+{
+  return plane_distance(r, u, coincident, A_, B_, C_, D_);
+}
+
 Direction SurfacePlane::normal(Position r) const
 {
   return {A_, B_, C_};
@@ -643,29 +661,26 @@ BoundingBox SurfaceZCylinder::bounding_box(bool pos_side) const
 }
 
 //==============================================================================
-// SurfaceSphere implementation
+// Generic functions for spheres
 //==============================================================================
 
-SurfaceSphere::SurfaceSphere(pugi::xml_node surf_node) : CSGSurface(surf_node)
-{
-  read_coeffs(surf_node, id_, x0_, y0_, z0_, radius_);
-}
-
-double SurfaceSphere::evaluate(Position r) const
+double sphere_evaluate(
+  Position r, double x0, double y0, double z0, double radius)
 {
-  const double x = r.x - x0_;
-  const double y = r.y - y0_;
-  const double z = r.z - z0_;
-  return x * x + y * y + z * z - radius_ * radius_;
+  const double x = r.x - x0;
+  const double y = r.y - y0;
+  const double z = r.z - z0;
+  return x * x + y * y + z * z - radius * radius;
 }
 
-double SurfaceSphere::distance(Position r, Direction u, bool coincident) const
+double sphere_distance(Position r, Direction u, bool coincident, double x0,
+  double y0, double z0, double radius)
 {
-  const double x = r.x - x0_;
-  const double y = r.y - y0_;
-  const double z = r.z - z0_;
+  const double x = r.x - x0;
+  const double y = r.y - y0;
+  const double z = r.z - z0;
   const double k = x * u.x + y * u.y + z * u.z;
-  const double c = x * x + y * y + z * z - radius_ * radius_;
+  const double c = x * x + y * y + z * z - radius * radius;
   const double quad = k * k - c;
 
   if (quad < 0.0) {
@@ -698,9 +713,33 @@ double SurfaceSphere::distance(Position r, Direction u, bool coincident) const
   }
 }
 
+Direction sphere_normal(Position r, double x0, double y0, double z0)
+{
+  return {2.0 * (r.x - x0), 2.0 * (r.y - y0), 2.0 * (r.z - z0)};
+}
+
+//==============================================================================
+// SurfaceSphere implementation
+//==============================================================================
+
+SurfaceSphere::SurfaceSphere(pugi::xml_node surf_node) : CSGSurface(surf_node)
+{
+  read_coeffs(surf_node, id_, x0_, y0_, z0_, radius_);
+}
+
+double SurfaceSphere::evaluate(Position r) const
+{
+  return sphere_evaluate(r, x0_, y0_, z0_, radius_);
+}
+
+double SurfaceSphere::distance(Position r, Direction u, bool coincident) const
+{
+  return sphere_distance(r, u, coincident, x0_, y0_, z0_, radius_);
+}
+
 Direction SurfaceSphere::normal(Position r) const
 {
-  return {2.0 * (r.x - x0_), 2.0 * (r.y - y0_), 2.0 * (r.z - z0_)};
+  return sphere_normal(r, x0_, y0_, z0_);
 }
 
 void SurfaceSphere::to_hdf5_inner(hid_t group_id) const
@@ -905,25 +944,22 @@ void SurfaceZCone::to_hdf5_inner(hid_t group_id) const
 }
 
 //==============================================================================
-// SurfaceQuadric implementation
+// Generic functions for general quadrics
 //==============================================================================
 
-SurfaceQuadric::SurfaceQuadric(pugi::xml_node surf_node) : CSGSurface(surf_node)
-{
-  read_coeffs(surf_node, id_, A_, B_, C_, D_, E_, F_, G_, H_, J_, K_);
-}
-
-double SurfaceQuadric::evaluate(Position r) const
+double quadric_evaluate(Position r, double A, double B, double C, double D,
+  double E, double F, double G, double H, double J, double K)
 {
   const double x = r.x;
   const double y = r.y;
   const double z = r.z;
-  return x * (A_ * x + D_ * y + G_) + y * (B_ * y + E_ * z + H_) +
-         z * (C_ * z + F_ * x + J_) + K_;
+  return x * (A * x + D * y + G) + y * (B * y + E * z + H) +
+         z * (C * z + F * x + J) + K;
 }
 
-double SurfaceQuadric::distance(
-  Position r, Direction ang, bool coincident) const
+double quadric_distance(Position r, Direction ang, bool coincident, double A,
+  double B, double C, double D, double E, double F, double G, double H,
+  double J, double K)
 {
   const double& x = r.x;
   const double& y = r.y;
@@ -933,12 +969,12 @@ double SurfaceQuadric::distance(
   const double& w = ang.z;
 
   const double a =
-    A_ * u * u + B_ * v * v + C_ * w * w + D_ * u * v + E_ * v * w + F_ * u * w;
-  const double k = A_ * u * x + B_ * v * y + C_ * w * z +
-                   0.5 * (D_ * (u * y + v * x) + E_ * (v * z + w * y) +
-                           F_ * (w * x + u * z) + G_ * u + H_ * v + J_ * w);
-  const double c = A_ * x * x + B_ * y * y + C_ * z * z + D_ * x * y +
-                   E_ * y * z + F_ * x * z + G_ * x + H_ * y + J_ * z + K_;
+    A * u * u + B * v * v + C * w * w + D * u * v + E * v * w + F * u * w;
+  const double k = A * u * x + B * v * y + C * w * z +
+                   0.5 * (D * (u * y + v * x) + E * (v * z + w * y) +
+                           F * (w * x + u * z) + G * u + H * v + J * w);
+  const double c = A * x * x + B * y * y + C * z * z + D * x * y +
+                   E * y * z + F * x * z + G * x + H * y + J * z + K;
   double quad = k * k - a * c;
 
   double d;
@@ -993,13 +1029,40 @@ double SurfaceQuadric::distance(
   return d;
 }
 
-Direction SurfaceQuadric::normal(Position r) const
+Direction quadric_normal(Position r, double A, double B, double C, double D,
+  double E, double F, double G, double H, double J)
 {
   const double& x = r.x;
   const double& y = r.y;
   const double& z = r.z;
-  return {2.0 * A_ * x + D_ * y + F_ * z + G_,
-    2.0 * B_ * y + D_ * x + E_ * z + H_, 2.0 * C_ * z + E_ * y + F_ * x + J_};
+  return {2.0 * A * x + D * y + F * z + G,
+    2.0 * B * y + D * x + E * z + H, 2.0 * C * z + E * y + F * x + J};
+}
+
+//==============================================================================
+// SurfaceQuadric implementation
+//==============================================================================
+
+SurfaceQuadric::SurfaceQuadric(pugi::xml_node surf_node) : CSGSurface(surf_node)
+{
+  read_coeffs(surf_node, id_, A_, B_, C_, D_, E_, F_, G_, H_, J_, K_);
+}
+
+double SurfaceQuadric::evaluate(Position r) const
+{
+  return quadric_evaluate(r, A_, B_, C_, D_, E_, F_, G_, H_, J_, K_);
+}
+
+double SurfaceQuadric::distance(
+  Position r, Direction ang, bool coincident) const
+{
+  return quadric_distance(
+    r, ang, coincident, A_, B_, C_, D_, E_, F_, G_, H_, J_, K_);
+}
+
+Direction SurfaceQuadric::normal(Position r) const
+{
+  return quadric_normal(r, A_, B_, C_, D_, E_, F_, G_, H_, J_);
 }
 
 void SurfaceQuadric::to_hdf5_inner(hid_t group_id) const
@@ -1013,9 +1076,50 @@ void SurfaceQuadric::to_hdf5_inner(hid_t group_id) const
 // Torus helper functions
 //==============================================================================
 
+double torus_evaluate(
+  double x1, double x2, double x3, double A, double B, double C)
+{
+  double rho = std::sqrt(x1 * x1 + x2 * x2) - A;
+  return (x3 * x3) / (B * B) + (rho * rho) / (C * C) - 1.;
+}
+
 double torus_distance(double x1, double x2, double x3, double u1, double u2,
   double u3, double A, double B, double C, bool coincident)
 {
+  // The torus lies within the slab |x3| <= B and the cylinder of radius A + C
+  // about its axis. If the ray misses the intersection of the two, it can't
+  // hit the torus and there is no need to solve the quartic. The bounds are
+  // padded so that rays grazing the torus are never rejected.
+  double pad = FP_REL_PRECISION * (A + C);
+  double t_min = -INFTY;
+  double t_max = INFTY;
+  double half_height = B + pad;
+  if (u3 != 0.0) {
+    double t1 = (-half_height - x3) / u3;
+    double t2 = (half_height - x3) / u3;
+    t_min = std::min(t1, t2);
+    t_max = std::max(t1, t2);
+  } else if (std::abs(x3) > half_height) {
+    return INFTY;
+  }
+
+  double R = A + C + pad;
+  double a = u1 * u1 + u2 * u2;
+  double k = u1 * x1 + u2 * x2;
+  double c = x1 * x1 + x2 * x2 - R * R;
+  if (a > 0.0) {
+    double quad = k * k - a * c;
+    if (quad < 0.0)
+      return INFTY;
+    double sqrt_quad = std::sqrt(quad);
+    t_min = std::max(t_min, (-k - sqrt_quad) / a);
+    t_max = std::min(t_max, (-k + sqrt_quad) / a);
+  } else if (c > 0.0) {
+    return INFTY;
+  }
+  if (t_max < t_min || t_max < 0.0)
+    return INFTY;
+
   // Coefficients for equation: (c2 t^2 + c1 t + c0)^2 = c2' t^2 + c1' t + c0'
   double D = (C * C) / (B * B);
   double c2 = u1 * u1 + u2 * u2 + D * u3 * u3;
@@ -1056,6 +1160,28 @@ double torus_distance(double x1, double x2, double x3, double u1, double u2,
   return distance;
 }
 
+// The first template parameter indicates which axis the torus is aligned to.
+// The other two parameters indicate the other two axes.
+template<int i1, int i2, int i3>
+Direction axis_aligned_torus_normal(
+  Position r, Position r0, double A, double B, double C)
+{
+  // reduce the expansion of the full form for torus
+  const Position x = r - r0;
+
+  // f(x1,x2,x3) = x1^2/B^2 + (sqrt(x2^2 + x3^2) - A)^2/C^2 - 1
+  // ∂f/∂x1 = 2x1/B^2
+  // ∂f/∂x2 = 2x2(g - A)/(g*C^2) where g = sqrt(x2^2 + x3^2)
+  // ∂f/∂x3 = 2x3(g - A)/(g*C^2)
+  // Multiplying by g*C^2*B^2 / 2 gives:
+  double g = std::sqrt(x.get<i2>() * x.get<i2>() + x.get<i3>() * x.get<i3>());
+  Direction n;
+  n.get<i1>() = C * C * g * x.get<i1>();
+  n.get<i2>() = x.get<i2>() * (g - A) * B * B;
+  n.get<i3>() = x.get<i3>() * (g - A) * B * B;
+  return n / n.norm();
+}
+
 //==============================================================================
 // SurfaceXTorus implementation
 //==============================================================================
@@ -1077,8 +1203,7 @@ double SurfaceXTorus::evaluate(Position r) const
   double x = r.x - x0_;
   double y = r.y - y0_;
   double z = r.z - z0_;
-  return (x * x) / (B_ * B_) +
-         std::pow(std::sqrt(y * y + z * z) - A_, 2) / (C_ * C_) - 1.;
+  return torus_evaluate(y, z, x, A_, B_, C_);
 }
 
 double SurfaceXTorus::distance(Position r, Direction u, bool coincident) const
@@ -1091,22 +1216,7 @@ double SurfaceXTorus::distance(Position r, Direction u, bool coincident) const
 
 Direction SurfaceXTorus::normal(Position r) const
 {
-  // reduce the expansion of the full form for torus
-  double x = r.x - x0_;
-  double y = r.y - y0_;
-  double z = r.z - z0_;
-
-  // f(x,y,z) = x^2/B^2 + (sqrt(y^2 + z^2) - A)^2/C^2 - 1
-  // ∂f/∂x = 2x/B^2
-  // ∂f/∂y = 2y(g - A)/(g*C^2) where g = sqrt(y^2 + z^2)
-  // ∂f/∂z = 2z(g - A)/(g*C^2)
-  // Multiplying by g*C^2*B^2 / 2 gives:
-  double g = std::sqrt(y * y + z * z);
-  double nx = C_ * C_ * g * x;
-  double ny = y * (g - A_) * B_ * B_;
-  double nz = z * (g - A_) * B_ * B_;
-  Direction n(nx, ny, nz);
-  return n / n.norm();
+  return axis_aligned_torus_normal<0, 1, 2>(r, {x0_, y0_, z0_}, A_, B_, C_);
 }
 
 //==============================================================================
@@ -1130,8 +1240,7 @@ double SurfaceYTorus::evaluate(Position r) const
   double x = r.x - x0_;
   double y = r.y - y0_;
   double z = r.z - z0_;
-  return (y * y) / (B_ * B_) +
-         std::pow(std::sqrt(x * x + z * z) - A_, 2) / (C_ * C_) - 1.;
+  return torus_evaluate(x, z, y, A_, B_, C_);
 }
 
 double SurfaceYTorus::distance(Position r, Direction u, bool coincident) const
@@ -1144,22 +1253,7 @@ double SurfaceYTorus::distance(Position r, Direction u, bool coincident) const
 
 Direction SurfaceYTorus::normal(Position r) const
 {
-  // reduce the expansion of the full form for torus
-  double x = r.x - x0_;
-  double y = r.y - y0_;
-  double z = r.z - z0_;
-
-  // f(x,y,z) = y^2/B^2 + (sqrt(x^2 + z^2) - A)^2/C^2 - 1
-  // ∂f/∂x = 2x(g - A)/(g*C^2) where g = sqrt(x^2 + z^2)
-  // ∂f/∂y = 2y/B^2
-  // ∂f/∂z = 2z(g - A)/(g*C^2)
-  // Multiplying by g*C^2*B^2 / 2 gives:
-  double g = std::sqrt(x * x + z * z);
-  double nx = x * (g - A_) * B_ * B_;
-  double ny = C_ * C_ * g * y;
-  double nz = z * (g - A_) * B_ * B_;
-  Direction n(nx, ny, nz);
-  return n / n.norm();
+  return axis_aligned_torus_normal<1, 0, 2>(r, {x0_, y0_, z0_}, A_, B_, C_);
 }
 
 //==============================================================================
@@ -1183,8 +1277,7 @@ double SurfaceZTorus::evaluate(Position r) const
   double x = r.x - x0_;
   double y = r.y - y0_;
   double z = r.z - z0_;
-  return (z * z) / (B_ * B_) +
-         std::pow(std::sqrt(x * x + y * y) - A_, 2) / (C_ * C_) - 1.;
+  return torus_evaluate(x, y, z, A_, B_, C_);
 }
 
 double SurfaceZTorus::distance(Position r, Direction u, bool coincident) const
@@ -1197,22 +1290,217 @@ double SurfaceZTorus::distance(Position r, Direction u, bool coincident) const
 
 Direction SurfaceZTorus::normal(Position r) const
 {
-  // reduce the expansion of the full form for torus
-  double x = r.x - x0_;
-  double y = r.y - y0_;
-  double z = r.z - z0_;
+  return axis_aligned_torus_normal<2, 0, 1>(r, {x0_, y0_, z0_}, A_, B_, C_);
+}
 
-  // f(x,y,z) = z^2/B^2 + (sqrt(x^2 + y^2) - A)^2/C^2 - 1
-  // ∂f/∂x = 2x(g - A)/(g*C^2) where g = sqrt(x^2 + y^2)
-  // ∂f/∂y = 2y(g - A)/(g*C^2)
-  // ∂f/∂z = 2z/B^2
-  // Multiplying by g*C^2*B^2 / 2 gives:
-  double g = std::sqrt(x * x + y * y);
-  double nx = x * (g - A_) * B_ * B_;
-  double ny = y * (g - A_) * B_ * B_;
-  double nz = C_ * C_ * g * z;
-  Position n(nx, ny, nz);
-  return n / n.norm();
+//==============================================================================
+// SurfaceStore implementation
+//==============================================================================
+
+void SurfaceStore::build()
+{
+  clear();
+  entries_.reserve(model::surfaces.size());
+  for (const auto& surf : model::surfaces) {
+    Entry e {Kind::OTHER, static_cast<int32_t>(coeffs_.size())};
+    auto add = [&](Kind kind, std::initializer_list<double> coeffs) {
+      e.kind = kind;
+      coeffs_.insert(coeffs_.end(), coeffs);
+    };
+
+    const Surface* s = surf.get();
+    if (auto p = dynamic_cast<const SurfaceXPlane*>(s)) {
+      add(Kind::X_PLANE, {p->x0_});
+    } else if (auto p = dynamic_cast<const SurfaceYPlane*>(s)) {
+      add(Kind::Y_PLANE, {p->y0_});
+    } else if (auto p = dynamic_cast<const SurfaceZPlane*>(s)) {
+      add(Kind::Z_PLANE, {p->z0_});
+    } else if (auto p = dynamic_cast<const SurfacePlane*>(s)) {
+      add(Kind::PLANE, {p->A_, p->B_, p->C_, p->D_});
+    } else if (auto p = dynamic_cast<const SurfaceXCylinder*>(s)) {
+      add(Kind::X_CYLINDER, {p->y0_, p->z0_, p->radius_});
+    } else if (auto p = dynamic_cast<const SurfaceYCylinder*>(s)) {
+      add(Kind::Y_CYLINDER, {p->x0_, p->z0_, p->radius_});
+    } else if (auto p = dynamic_cast<const SurfaceZCylinder*>(s)) {
+      add(Kind::Z_CYLINDER, {p->x0_, p->y0_, p->radius_});
+    } else if (auto p = dynamic_cast<const SurfaceSphere*>(s)) {
+      add(Kind::SPHERE, {p->x0_, p->y0_, p->z0_, p->radius_});
+    } else if (auto p = dynamic_cast<const SurfaceXCone*>(s)) {
+      add(Kind::X_CONE, {p->x0_, p->y0_, p->z0_, p->radius_sq_});
+    } else if (auto p = dynamic_cast<const SurfaceYCone*>(s)) {
+      add(Kind::Y_CONE, {p->x0_, p->y0_, p->z0_, p->radius_sq_});
+    } else if (auto p = dynamic_cast<const SurfaceZCone*>(s)) {
+      add(Kind::Z_CONE, {p->x0_, p->y0_, p->z0_, p->radius_sq_});
+    } else if (auto p = dynamic_cast<const SurfaceQuadric*>(s)) {
+      add(Kind::QUADRIC, {p->A_, p->B_, p->C_, p->D_, p->E_, p->F_, p->G_,
+                           p->H_, p->J_, p->K_});
+    } else if (auto p = dynamic_cast<const SurfaceXTorus*>(s)) {
+      add(Kind::X_TORUS, {p->x0_, p->y0_, p->z0_, p->A_, p->B_, p->C_});
+    } else if (auto p = dynamic_cast<const SurfaceYTorus*>(s)) {
+      add(Kind::Y_TORUS, {p->x0_, p->y0_, p->z0_, p->A_, p->B_, p->C_});
+    } else if (auto p = dynamic_cast<const SurfaceZTorus*>(s)) {
+      add(Kind::Z_TORUS, {p->x0_, p->y0_, p->z0_, p->A_, p->B_, p->C_});
+    }
+    entries_.push_back(e);
+  }
+}
+
+void SurfaceStore::clear()
+{
+  entries_.clear();
+  coeffs_.clear();
+}
+
+double SurfaceStore::evaluate(int32_t i_surf, Position r) const
+{
+  const Entry& e = entries_[i_surf];
+  const double* c = coeffs_.data() + e.offset;
+  switch (e.kind) {
+  case Kind::X_PLANE:
+    return r.x - c[0];
+  case Kind::Y_PLANE:
+    return r.y - c[0];
+  case Kind::Z_PLANE:
+    return r.z - c[0];
+  case Kind::PLANE:
+    return plane_evaluate(r, c[0], c[1], c[2], c[3]);
+  case Kind::X_CYLINDER:
+    return axis_aligned_cylinder_evaluate<1, 2>(r, c[0], c[1], c[2]);
+  case Kind::Y_CYLINDER:
+    return axis_aligned_cylinder_evaluate<0, 2>(r, c[0], c[1], c[2]);
+  case Kind::Z_CYLINDER:
+    return axis_aligned_cylinder_evaluate<0, 1>(r, c[0], c[1], c[2]);
+  case Kind::SPHERE:
+    return sphere_evaluate(r, c[0], c[1], c[2], c[3]);
+  case Kind::X_CONE:
+    return axis_aligned_cone_evaluate<0, 1, 2>(r, c[0], c[1], c[2], c[3]);
+  case Kind::Y_CONE:
+    return axis_aligned_cone_evaluate<1, 0, 2>(r, c[1], c[0], c[2], c[3]);
+  case Kind::Z_CONE:
+    return axis_aligned_cone_evaluate<2, 0, 1>(r, c[2], c[0], c[1], c[3]);
+  case Kind::QUADRIC:
+    return quadric_evaluate(
+      r, c[0], c[1], c[2], c[3], c[4], c[5], c[6], c[7], c[8], c[9]);
+  case Kind::X_TORUS:
+    return torus_evaluate(
+      r.y - c[1], r.z - c[2], r.x - c[0], c[3], c[4], c[5]);
+  case Kind::Y_TORUS:
+    return torus_evaluate(
+      r.x - c[0], r.z - c[2], r.y - c[1], c[3], c[4], c[5]);
+  case Kind::Z_TORUS:
+    return torus_evaluate(
+      r.x - c[0], r.y - c[1], r.z - c[2], c[3], c[4], c[5]);
+  default:
+    return model::surfaces[i_surf]->evaluate(r);
+  }
+}
+
+double SurfaceStore::distance(
+  int32_t i_surf, Position r, Direction u, bool coincident) const
+{
+  const Entry& e = entries_[i_surf];
+  const double* c = coeffs_.data() + e.offset;
+  switch (e.kind) {
+  case Kind::X_PLANE:
+    return axis_aligned_plane_distance<0>(r, u, coincident, c[0]);
+  case Kind::Y_PLANE:
+    return axis_aligned_plane_distance<1>(r, u, coincident, c[0]);
+  case Kind::Z_PLANE:
+    return axis_aligned_plane_distance<2>(r, u, coincident, c[0]);
+  case Kind::PLANE:
+    return plane_distance(r, u, coincident, c[0], c[1], c[2], c[3]);
+  case Kind::X_CYLINDER:
+    return axis_aligned_cylinder_distance<0, 1, 2>(
+      r, u, coincident, c[0], c[1], c[2]);
+  case Kind::Y_CYLINDER:
+    return axis_aligned_cylinder_distance<1, 0, 2>(
+      r, u, coincident, c[0], c[1], c[2]);
+  case Kind::Z_CYLINDER:
+    return axis_aligned_cylinder_distance<2, 0, 1>(
+      r, u, coincident, c[0], c[1], c[2]);
+  case Kind::SPHERE:
+    return sphere_distance(r, u, coincident, c[0], c[1], c[2], c[3]);
+  case Kind::X_CONE:
+    return axis_aligned_cone_distance<0, 1, 2>(
+      r, u, coincident, c[0], c[1], c[2], c[3]);
+  case Kind::Y_CONE:
+    return axis_aligned_cone_distance<1, 0, 2>(
+      r, u, coincident, c[1], c[0], c[2], c[3]);
+  case Kind::Z_CONE:
+    return axis_aligned_cone_distance<2, 0, 1>(
+      r, u, coincident, c[2], c[0], c[1], c[3]);
+  case Kind::QUADRIC:
+    return quadric_distance(r, u, coincident, c[0], c[1], c[2], c[3], c[4],
+      c[5], c[6], c[7], c[8], c[9]);
+  case Kind::X_TORUS:
+    return torus_distance(r.y - c[1], r.z - c[2], r.x - c[0], u.y, u.z, u.x,
+      c[3], c[4], c[5], coincident);
+  case Kind::Y_TORUS:
+    return torus_distance(r.x - c[0], r.z - c[2], r.y - c[1], u.x, u.z, u.y,
+      c[3], c[4], c[5], coincident);
+  case Kind::Z_TORUS:
+    return torus_distance(r.x - c[0], r.y - c[1], r.z - c[2], u.x, u.y, u.z,
+      c[3], c[4], c[5], coincident);
+  default:
+    return model::surfaces[i_surf]->distance(r, u, coincident);
+  }
+}
+
+Direction SurfaceStore::normal(int32_t i_surf, Position r) const
+{
+  const Entry& e = entries_[i_surf];
+  const double* c = coeffs_.data() + e.offset;
+  switch (e.kind) {
+  case Kind::X_PLANE:
+    return {1., 0., 0.};
+  case Kind::Y_PLANE:
+    return {0., 1., 0.};
+  case Kind::Z_PLANE:
+    return {0., 0., 1.};
+  case Kind::PLANE:
+    return {c[0], c[1], c[2]};
+  case Kind::X_CYLINDER:
+    return axis_aligned_cylinder_normal<0, 1, 2>(r, c[0], c[1]);
+  case Kind::Y_CYLINDER:
+    return axis_aligned_cylinder_normal<1, 0, 2>(r, c[0], c[1]);
+  case Kind::Z_CYLINDER:
+    return axis_aligned_cylinder_normal<2, 0, 1>(r, c[0], c[1]);
+  case Kind::SPHERE:
+    return sphere_normal(r, c[0], c[1], c[2]);
+  case Kind::X_CONE:
+    return axis_aligned_cone_normal<0, 1, 2>(r, c[0], c[1], c[2], c[3]);
+  case Kind::Y_CONE:
+    return axis_aligned_cone_normal<1, 0, 2>(r, c[1], c[0], c[2], c[3]);
+  case Kind::Z_CONE:
+    return axis_aligned_cone_normal<2, 0, 1>(r, c[2], c[0], c[1], c[3]);
+  case Kind::QUADRIC:
+    return quadric_normal(
+      r, c[0], c[1], c[2], c[3], c[4], c[5], c[6], c[7], c[8]);
+  case Kind::X_TORUS:
+    return axis_aligned_torus_normal<0, 1, 2>(
+      r, {c[0], c[1], c[2]}, c[3], c[4], c[5]);
+  case Kind::Y_TORUS:
+    return axis_aligned_torus_normal<1, 0, 2>(
+      r, {c[0], c[1], c[2]}, c[3], c[4], c[5]);
+  case Kind::Z_TORUS:
+    return axis_aligned_torus_normal<2, 0, 1>(
+      r, {c[0], c[1], c[2]}, c[3], c[4], c[5]);
+  default:
+    return model::surfaces[i_surf]->normal(r);
+  }
+}
+
+bool SurfaceStore::sense(int32_t i_surf, Position r, Direction u) const
+{
+  if (entries_[i_surf].kind == Kind::OTHER)
+    return model::surfaces[i_surf]->sense(r, u);
+
+  // Same logic as Surface::sense
+  const double f = evaluate(i_surf, r);
+  if (std::abs(f) < FP_COINCIDENT) {
+    return u.dot(normal(i_surf, r)) > 0.0;
+  }
+  return f > 0.0;
 }
 
 //==============================================================================
@@ -1383,6 +1671,7 @@ void read_surfaces(pugi::xml_node node)
 
 void free_memory_surfaces()
 {
+  model::surface_store.clear();
   model::surfaces.clear();
   model::surface_map.clear();
 }
@@ -0,0 +1,74 @@
+#include "openmc/tallies/bin_lookup.h"
+
+#include <algorithm> // for max, min
+#include <cmath>     // for abs
+
+#include "openmc/search.h"
+
+namespace openmc {
+
+//==============================================================================
+// BinLookup implementation
+//==============================================================================
+
+void BinLookup::set_edges(gsl::span<const double> edges)
+{
+  uniform_ = false;
+  int n_bins = edges.size() - 1;
+  if (n_bins < 1)
+    return;
+
+  // Small deviations from uniformity only cost a step of the correction in
+  // find(), so a loose tolerance is used. This also accepts edges that were
+  // written out in decimal.
+  start_ = edges.front();
+  width_ = (edges.back() - edges.front()) / n_bins;
+  for (gsl::index i = 1; i < n_bins; ++i) {
+    if (std::abs(edges[i] - (start_ + i * width_)) > 1.0e-6 * width_)
+      return;
+  }
+  inv_width_ = 1.0 / width_;
+  uniform_ = true;
+}
+
+int BinLookup::find(gsl::span<const double> edges, double x) const
+{
+  if (!uniform_)
+    return lower_bound_index(edges.begin(), edges.end(), x);
+
+  // Correct the estimate for round-off so the result matches a binary search
+  int n_bins = edges.size() - 1;
+  int bin = static_cast<int>((x - start_) * inv_width_);
+  bin = std::min(std::max(bin, 0), n_bins - 1);
+  while (bin > 0 && x <= edges[bin])
+    --bin;
+  while (bin < n_bins - 1 && x > edges[bin + 1])
+    ++bin;
+  return bin;
+}
+
+//==============================================================================
+// IndexBinMap implementation
+//==============================================================================
+
+void IndexBinMap::set(gsl::span<const int32_t> indices, int32_t n_domains)
+{
+  bins_.clear();
+  map_.clear();
+
+  // An array over all domains is used unless it would be much larger than the
+  // number of bins, e.g. for a few cells out of millions in a DAGMC model
+  dense_ = static_cast<size_t>(n_domains) <= 64 * indices.size() + 65536;
+  if (dense_)
+    bins_.assign(n_domains, -1);
+
+  for (gsl::index i = 0; i < indices.size(); ++i) {
+    if (dense_) {
+      bins_[indices[i]] = i;
+    } else {
+      map_[indices[i]] = i;
+    }
+  }
+}
+
+} // namespace openmc
@@ -95,7 +95,30 @@ void read_tally_derivatives(pugi::xml_node node)
     fatal_error("Differential tallies not supported in multi-group mode");
 }
 
-void apply_derivative_to_score(const Particle& p, int i_tally, int i_nuclide,
+namespace {
+
+//! Get the temperature derivatives of the scattering, absorption, and fission
+//! cross sections of a nuclide with multipole data, reusing the values stored
+//! with the particle's microscopic cross sections when possible.
+
+std::tuple<double, double, double> multipole_deriv(
+  Particle& p, int i_nuclide, double E)
+{
+  auto& micro {p.neutron_xs(i_nuclide)};
+  if (E != micro.deriv_E || p.sqrtkT() != micro.deriv_sqrtkT) {
+    const auto& nuc {*data::nuclides[i_nuclide]};
+    std::tie(micro.deriv_scatter, micro.deriv_absorption,
+      micro.deriv_fission) = nuc.multipole_->evaluate_deriv(E, p.sqrtkT());
+    micro.deriv_E = E;
+    micro.deriv_sqrtkT = p.sqrtkT();
+  }
+  return std::make_tuple(
+    micro.deriv_scatter, micro.deriv_absorption, micro.deriv_fission);
+}
+
+} // namespace
+
+void apply_derivative_to_score(Particle& p, int i_tally, int i_nuclide,
   double atom_density, int score_bin, double& score)
 {
   const Tally& tally {*model::tallies[i_tally]};
@@ -317,7 +340,7 @@ void apply_derivative_to_score(const Particle& p, int i_tally, int i_nuclide,
         if (p.neutron_xs(p.event_nuclide()).total) {
           double dsig_s, dsig_a, dsig_f;
           std::tie(dsig_s, dsig_a, dsig_f) =
-            nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
+            multipole_deriv(p, p.event_nuclide(), p.E_last());
           score *= flux_deriv + (dsig_s + dsig_a) * material.atom_density_(i) /
                                   p.macro_xs().total;
         } else {
@@ -330,7 +353,7 @@ void apply_derivative_to_score(const Particle& p, int i_tally, int i_nuclide,
             p.neutron_xs(p.event_nuclide()).absorption) {
           double dsig_s, dsig_a, dsig_f;
           std::tie(dsig_s, dsig_a, dsig_f) =
-            nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
+            multipole_deriv(p, p.event_nuclide(), p.E_last());
           score *=
             flux_deriv + dsig_s * material.atom_density_(i) /
                            (p.macro_xs().total - p.macro_xs().absorption);
@@ -343,7 +366,7 @@ void apply_derivative_to_score(const Particle& p, int i_tally, int i_nuclide,
         if (p.neutron_xs(p.event_nuclide()).absorption) {
           double dsig_s, dsig_a, dsig_f;
           std::tie(dsig_s, dsig_a, dsig_f) =
-            nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
+            multipole_deriv(p, p.event_nuclide(), p.E_last());
           score *= flux_deriv +
                    dsig_a * material.atom_density_(i) / p.macro_xs().absorption;
         } else {
@@ -355,7 +378,7 @@ void apply_derivative_to_score(const Particle& p, int i_tally, int i_nuclide,
         if (p.neutron_xs(p.event_nuclide()).fission) {
           double dsig_s, dsig_a, dsig_f;
           std::tie(dsig_s, dsig_a, dsig_f) =
-            nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
+            multipole_deriv(p, p.event_nuclide(), p.E_last());
           score *= flux_deriv +
                    dsig_f * material.atom_density_(i) / p.macro_xs().fission;
         } else {
@@ -369,7 +392,7 @@ void apply_derivative_to_score(const Particle& p, int i_tally, int i_nuclide,
                       p.neutron_xs(p.event_nuclide()).fission;
           double dsig_s, dsig_a, dsig_f;
           std::tie(dsig_s, dsig_a, dsig_f) =
-            nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
+            multipole_deriv(p, p.event_nuclide(), p.E_last());
           score *= flux_deriv + nu * dsig_f * material.atom_density_(i) /
                                   p.macro_xs().nu_fission;
         } else {
@@ -404,16 +427,15 @@ void apply_derivative_to_score(const Particle& p, int i_tally, int i_nuclide,
                 p.neutron_xs(i_nuc).total) {
               double dsig_s, dsig_a, dsig_f;
               std::tie(dsig_s, dsig_a, dsig_f) =
-                nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
+                multipole_deriv(p, i_nuc, p.E_last());
               cum_dsig += (dsig_s + dsig_a) * material.atom_density_(i);
             }
           }
           score *= flux_deriv + cum_dsig / p.macro_xs().total;
         } else if (p.neutron_xs(i_nuclide).total) {
-          const auto& nuc {*data::nuclides[i_nuclide]};
           double dsig_s, dsig_a, dsig_f;
           std::tie(dsig_s, dsig_a, dsig_f) =
-            nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
+            multipole_deriv(p, i_nuclide, p.E_last());
           score *=
             flux_deriv + (dsig_s + dsig_a) / p.neutron_xs(i_nuclide).total;
         } else {
@@ -431,7 +453,7 @@ void apply_derivative_to_score(const Particle& p, int i_tally, int i_nuclide,
                 (p.neutron_xs(i_nuc).total - p.neutron_xs(i_nuc).absorption)) {
               double dsig_s, dsig_a, dsig_f;
               std::tie(dsig_s, dsig_a, dsig_f) =
-                nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
+                multipole_deriv(p, i_nuc, p.E_last());
               cum_dsig += dsig_s * material.atom_density_(i);
             }
           }
@@ -439,10 +461,9 @@ void apply_derivative_to_score(const Particle& p, int i_tally, int i_nuclide,
                    cum_dsig / (p.macro_xs().total - p.macro_xs().absorption);
         } else if (p.neutron_xs(i_nuclide).total -
                    p.neutron_xs(i_nuclide).absorption) {
-          const auto& nuc {*data::nuclides[i_nuclide]};
           double dsig_s, dsig_a, dsig_f;
           std::tie(dsig_s, dsig_a, dsig_f) =
-            nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
+            multipole_deriv(p, i_nuclide, p.E_last());
           score *= flux_deriv + dsig_s / (p.neutron_xs(i_nuclide).total -
                                            p.neutron_xs(i_nuclide).absorption);
         } else {
@@ -460,16 +481,15 @@ void apply_derivative_to_score(const Particle& p, int i_tally, int i_nuclide,
                 p.neutron_xs(i_nuc).absorption) {
               double dsig_s, dsig_a, dsig_f;
               std::tie(dsig_s, dsig_a, dsig_f) =
-                nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
+                multipole_deriv(p, i_nuc, p.E_last());
               cum_dsig += dsig_a * material.atom_density_(i);
             }
           }
           score *= flux_deriv + cum_dsig / p.macro_xs().absorption;
         } else if (p.neutron_xs(i_nuclide).absorption) {
-          const auto& nuc {*data::nuclides[i_nuclide]};
           double dsig_s, dsig_a, dsig_f;
           std::tie(dsig_s, dsig_a, dsig_f) =
-            nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
+            multipole_deriv(p, i_nuclide, p.E_last());
           score *= flux_deriv + dsig_a / p.neutron_xs(i_nuclide).absorption;
         } else {
           score *= flux_deriv;
@@ -486,16 +506,15 @@ void apply_derivative_to_score(const Particle& p, int i_tally, int i_nuclide,
                 p.neutron_xs(i_nuc).fission) {
               double dsig_s, dsig_a, dsig_f;
               std::tie(dsig_s, dsig_a, dsig_f) =
-                nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
+                multipole_deriv(p, i_nuc, p.E_last());
               cum_dsig += dsig_f * material.atom_density_(i);
             }
           }
           score *= flux_deriv + cum_dsig / p.macro_xs().fission;
         } else if (p.neutron_xs(i_nuclide).fission) {
-          const auto& nuc {*data::nuclides[i_nuclide]};
           double dsig_s, dsig_a, dsig_f;
           std::tie(dsig_s, dsig_a, dsig_f) =
-            nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
+            multipole_deriv(p, i_nuclide, p.E_last());
           score *= flux_deriv + dsig_f / p.neutron_xs(i_nuclide).fission;
         } else {
           score *= flux_deriv;
@@ -514,16 +533,15 @@ void apply_derivative_to_score(const Particle& p, int i_tally, int i_nuclide,
                 p.neutron_xs(i_nuc).nu_fission / p.neutron_xs(i_nuc).fission;
               double dsig_s, dsig_a, dsig_f;
               std::tie(dsig_s, dsig_a, dsig_f) =
-                nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
+                multipole_deriv(p, i_nuc, p.E_last());
               cum_dsig += nu * dsig_f * material.atom_density_(i);
             }
           }
           score *= flux_deriv + cum_dsig / p.macro_xs().nu_fission;
         } else if (p.neutron_xs(i_nuclide).fission) {
-          const auto& nuc {*data::nuclides[i_nuclide]};
           double dsig_s, dsig_a, dsig_f;
           std::tie(dsig_s, dsig_a, dsig_f) =
-            nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
+            multipole_deriv(p, i_nuclide, p.E_last());
           score *= flux_deriv + dsig_f / p.neutron_xs(i_nuclide).fission;
         } else {
           score *= flux_deriv;
@@ -582,7 +600,7 @@ void score_track_derivative(Particle& p, double distance)
           // (1 / phi) * (d_phi / d_T) = - N (d_sigma_tot / d_T) * dist
           double dsig_s, dsig_a, dsig_f;
           std::tie(dsig_s, dsig_a, dsig_f) =
-            nuc.multipole_->evaluate_deriv(p.E(), p.sqrtkT());
+            multipole_deriv(p, material.nuclide_[i], p.E());
           flux_deriv -=
             distance * (dsig_s + dsig_a) * material.atom_density_(i);
         }
@@ -648,7 +666,7 @@ void score_collision_derivative(Particle& p)
           const auto& micro_xs {p.neutron_xs(i_nuc)};
           double dsig_s, dsig_a, dsig_f;
           std::tie(dsig_s, dsig_a, dsig_f) =
-            nuc.multipole_->evaluate_deriv(p.E_last(), p.sqrtkT());
+            multipole_deriv(p, i_nuc, p.E_last());
           flux_deriv += dsig_s / (micro_xs.total - micro_xs.absorption);
           // Note that this is an approximation!  The real scattering cross
           // section is
@@ -46,6 +46,7 @@ namespace openmc {
 namespace model {
 std::unordered_map<int, int> filter_map;
 vector<unique_ptr<Filter>> tally_filters;
+vector<int32_t> filter_shared_match;
 } // namespace model
 
 //==============================================================================
@@ -6,7 +6,6 @@
 
 #include "openmc/constants.h"
 #include "openmc/error.h"
-#include "openmc/search.h"
 #include "openmc/xml_interface.h"
 
 namespace openmc {
@@ -50,6 +49,7 @@ void AzimuthalFilter::set_bins(gsl::span<double> bins)
   }
 
   n_bins_ = bins_.size() - 1;
+  lookup_.set_edges(bins_);
 }
 
 void AzimuthalFilter::get_all_bins(
@@ -59,7 +59,7 @@ void AzimuthalFilter::get_all_bins(
   double phi = std::atan2(u.y, u.x);
 
   if (phi >= bins_.front() && phi <= bins_.back()) {
-    auto bin = lower_bound_index(bins_.begin(), bins_.end(), phi);
+    auto bin = lookup_.find(bins_, phi);
     match.bins_.push_back(bin);
     match.weights_.push_back(1.0);
   }
@@ -30,26 +30,40 @@ void CellFilter::set_cells(gsl::span<int32_t> cells)
   // Clear existing cells
   cells_.clear();
   cells_.reserve(cells.size());
-  map_.clear();
+  universe_binned_.assign(model::universes.size(), false);
 
-  // Update cells and mapping
+  // Update cells and mark the universes they are in
   for (auto& index : cells) {
     Expects(index >= 0);
     Expects(index < model::cells.size());
     cells_.push_back(index);
-    map_[index] = cells_.size() - 1;
+    auto it = model::universe_map.find(model::cells[index]->universe_);
+    if (it != model::universe_map.end())
+      universe_binned_[it->second] = true;
   }
+  map_.set(cells_, model::cells.size());
 
   n_bins_ = cells_.size();
 }
 
+int CellFilter::search(int32_t cell) const
+{
+  return map_.find(cell);
+}
+
 void CellFilter::get_all_bins(
   const Particle& p, TallyEstimator estimator, FilterMatch& match) const
 {
   for (int i = 0; i < p.n_coord(); i++) {
-    auto search = map_.find(p.coord(i).cell);
-    if (search != map_.end()) {
-      match.bins_.push_back(search->second);
+    // Skip levels in universes that contain none of the binned cells
+    const auto& coord {p.coord(i)};
+    if (coord.universe >= 0 && coord.universe < universe_binned_.size() &&
+        !universe_binned_[coord.universe])
+      continue;
+
+    int bin = map_.find(coord.cell);
+    if (bin >= 0) {
+      match.bins_.push_back(bin);
       match.weights_.push_back(1.0);
     }
   }
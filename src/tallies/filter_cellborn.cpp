@@ -7,9 +7,9 @@ namespace openmc {
 void CellbornFilter::get_all_bins(
   const Particle& p, TallyEstimator estimator, FilterMatch& match) const
 {
-  auto search = map_.find(p.cell_born());
-  if (search != map_.end()) {
-    match.bins_.push_back(search->second);
+  int bin = map_.find(p.cell_born());
+  if (bin >= 0) {
+    match.bins_.push_back(bin);
     match.weights_.push_back(1.0);
   }
 }
@@ -8,9 +8,9 @@ void CellFromFilter::get_all_bins(
   const Particle& p, TallyEstimator estimator, FilterMatch& match) const
 {
   for (int i = 0; i < p.n_coord_last(); i++) {
-    auto search = map_.find(p.cell_last(i));
-    if (search != map_.end()) {
-      match.bins_.push_back(search->second);
+    int bin = map_.find(p.cell_last(i));
+    if (bin >= 0) {
+      match.bins_.push_back(bin);
       match.weights_.push_back(1.0);
     }
   }
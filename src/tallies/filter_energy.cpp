@@ -1,5 +1,8 @@
 #include "openmc/tallies/filter_energy.h"
 
+#include <algorithm> // for max, min
+#include <cmath>     // for abs, exp, log
+
 #include <fmt/core.h>
 
 #include "openmc/capi.h"
@@ -38,6 +41,49 @@ void EnergyFilter::set_bins(gsl::span<const double> bins)
 
   n_bins_ = bins_.size() - 1;
 
+  // Check whether the bins are equally spaced in energy or lethargy so the bin
+  // of an energy can be computed directly. Small deviations from uniformity
+  // only cost a step of the correction in search(), so a loose tolerance is
+  // used.
+  search_ = BinSearch::BINARY;
+  hash_bins_.clear();
+  if (n_bins_ >= MIN_DIRECT_BINS) {
+    auto is_uniform = [this](auto f) {
+      double width = (f(bins_.back()) - f(bins_.front())) / n_bins_;
+      for (gsl::index i = 1; i < n_bins_; ++i) {
+        double expected = f(bins_.front()) + i * width;
+        if (std::abs(f(bins_[i]) - expected) > 1.0e-6 * width)
+          return false;
+      }
+      grid_start_ = f(bins_.front());
+      grid_inv_width_ = 1.0 / width;
+      return true;
+    };
+    auto energy = [](double E) { return E; };
+    auto lethargy = [](double E) { return std::log(E); };
+
+    if (is_uniform(energy)) {
+      search_ = BinSearch::LINEAR;
+    } else if (bins_.front() > 0.0 && is_uniform(lethargy)) {
+      search_ = BinSearch::LOGARITHMIC;
+    } else if (bins_.front() > 0.0) {
+      // For other structures, divide the lethargy range into equal cells and
+      // store the bin containing the lower edge of each cell so that only the
+      // few bins overlapping a cell need to be searched
+      search_ = BinSearch::HASH;
+      int n_cells = HASH_CELLS_PER_BIN * n_bins_;
+      grid_start_ = std::log(bins_.front());
+      grid_inv_width_ = n_cells / (std::log(bins_.back()) - grid_start_);
+      hash_bins_.resize(n_cells + 1);
+      for (int m = 0; m <= n_cells; ++m) {
+        double E = std::exp(grid_start_ + m / grid_inv_width_);
+        E = std::min(std::max(E, bins_.front()), bins_.back());
+        hash_bins_[m] = lower_bound_index(bins_.begin(), bins_.end(), E);
+      }
+      hash_bins_.back() = n_bins_ - 1;
+    }
+  }
+
   // In MG mode, check if the filter bins match the transport bins.
   // We can save tallying time if we know that the tally bins match the energy
   // group structure.  In that case, the matching bin index is simply the group
@@ -56,6 +102,44 @@ void EnergyFilter::set_bins(gsl::span<const double> bins)
   }
 }
 
+int EnergyFilter::search(double E) const
+{
+  if (E < bins_.front() || E > bins_.back())
+    return -1;
+
+  // Estimate the bin from the uniform grid
+  int bin = 0;
+  switch (search_) {
+  case BinSearch::BINARY:
+    return lower_bound_index(bins_.begin(), bins_.end(), E);
+  case BinSearch::LINEAR:
+    bin = static_cast<int>((E - grid_start_) * grid_inv_width_);
+    break;
+  case BinSearch::LOGARITHMIC:
+    bin = static_cast<int>((std::log(E) - grid_start_) * grid_inv_width_);
+    break;
+  case BinSearch::HASH: {
+    int n_cells = hash_bins_.size() - 1;
+    int m = static_cast<int>((std::log(E) - grid_start_) * grid_inv_width_);
+    m = std::min(std::max(m, 0), n_cells - 1);
+    int lo = hash_bins_[m];
+    int hi = hash_bins_[m + 1];
+    bin = lo + lower_bound_index(
+                 bins_.begin() + lo, bins_.begin() + hi + 2, E);
+    break;
+  }
+  }
+
+  // Correct for round-off so the result matches a binary search, which puts
+  // an energy equal to an interior edge in the lower bin
+  bin = std::min(std::max(bin, 0), n_bins_ - 1);
+  while (bin > 0 && E <= bins_[bin])
+    --bin;
+  while (bin < n_bins_ - 1 && E > bins_[bin + 1])
+    ++bin;
+  return bin;
+}
+
 void EnergyFilter::get_all_bins(
   const Particle& p, TallyEstimator estimator, FilterMatch& match) const
 {
@@ -72,8 +156,8 @@ void EnergyFilter::get_all_bins(
     auto E = p.E_last();
 
     // Bin the energy.
-    if (E >= bins_.front() && E <= bins_.back()) {
-      auto bin = lower_bound_index(bins_.begin(), bins_.end(), E);
+    int bin = this->search(E);
+    if (bin >= 0) {
       match.bins_.push_back(bin);
       match.weights_.push_back(1.0);
     }
@@ -103,8 +187,8 @@ void EnergyoutFilter::get_all_bins(
     match.weights_.push_back(1.0);
 
   } else {
-    if (p.E() >= bins_.front() && p.E() <= bins_.back()) {
-      auto bin = lower_bound_index(bins_.begin(), bins_.end(), p.E());
+    int bin = this->search(p.E());
+    if (bin >= 0) {
       match.bins_.push_back(bin);
       match.weights_.push_back(1.0);
     }
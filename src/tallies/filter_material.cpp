@@ -29,15 +29,14 @@ void MaterialFilter::set_materials(gsl::span<const int32_t> materials)
   // Clear existing materials
   materials_.clear();
   materials_.reserve(materials.size());
-  map_.clear();
 
   // Update materials and mapping
   for (auto& index : materials) {
     Expects(index >= 0);
     Expects(index < model::materials.size());
     materials_.push_back(index);
-    map_[index] = materials_.size() - 1;
   }
+  map_.set(materials_, model::materials.size());
 
   n_bins_ = materials_.size();
 }
@@ -45,9 +44,9 @@ void MaterialFilter::set_materials(gsl::span<const int32_t> materials)
 void MaterialFilter::get_all_bins(
   const Particle& p, TallyEstimator estimator, FilterMatch& match) const
 {
-  auto search = map_.find(p.material());
-  if (search != map_.end()) {
-    match.bins_.push_back(search->second);
+  int bin = map_.find(p.material());
+  if (bin >= 0) {
+    match.bins_.push_back(bin);
     match.weights_.push_back(1.0);
   }
 }
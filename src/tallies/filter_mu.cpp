@@ -3,7 +3,6 @@
 #include <fmt/core.h>
 
 #include "openmc/error.h"
-#include "openmc/search.h"
 #include "openmc/xml_interface.h"
 
 namespace openmc {
@@ -46,13 +45,14 @@ void MuFilter::set_bins(gsl::span<double> bins)
   }
 
   n_bins_ = bins_.size() - 1;
+  lookup_.set_edges(bins_);
 }
 
 void MuFilter::get_all_bins(
   const Particle& p, TallyEstimator estimator, FilterMatch& match) const
 {
   if (p.mu() >= bins_.front() && p.mu() <= bins_.back()) {
-    auto bin = lower_bound_index(bins_.begin(), bins_.end(), p.mu());
+    auto bin = lookup_.find(bins_, p.mu());
     match.bins_.push_back(bin);
     match.weights_.push_back(1.0);
   }
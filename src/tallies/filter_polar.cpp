@@ -4,7 +4,6 @@
 
 #include "openmc/constants.h"
 #include "openmc/error.h"
-#include "openmc/search.h"
 #include "openmc/xml_interface.h"
 
 namespace openmc {
@@ -47,6 +46,7 @@ void PolarFilter::set_bins(gsl::span<double> bins)
   }
 
   n_bins_ = bins_.size() - 1;
+  lookup_.set_edges(bins_);
 }
 
 void PolarFilter::get_all_bins(
@@ -57,7 +57,7 @@ void PolarFilter::get_all_bins(
   double theta = std::acos(z);
 
   if (theta >= bins_.front() && theta <= bins_.back()) {
-    auto bin = lower_bound_index(bins_.begin(), bins_.end(), theta);
+    auto bin = lookup_.find(bins_, theta);
     match.bins_.push_back(bin);
     match.weights_.push_back(1.0);
   }
@@ -46,31 +46,37 @@ void SphericalHarmonicsFilter::set_cosine(gsl::cstring_span cosine)
 void SphericalHarmonicsFilter::get_all_bins(
   const Particle& p, TallyEstimator estimator, FilterMatch& match) const
 {
-  // Determine cosine term for scatter expansion if necessary
-  vector<double> wgt(order_ + 1);
-  if (cosine_ == SphericalHarmonicsCosine::scatter) {
-    calc_pn_c(order_, p.mu(), wgt.data());
-  } else {
-    for (int i = 0; i < order_ + 1; i++) {
-      wgt[i] = 1;
-    }
-  }
-
-  // Find the Rn,m values
-  vector<double> rn(n_bins_);
-  calc_rn(order_, p.u_last(), rn.data());
+  // Find the Rn,m values directly in the match weights
+  auto offset = match.weights_.size();
+  match.weights_.resize(offset + n_bins_);
+  double* rn = match.weights_.data() + offset;
+  calc_rn(order_, p.u_last(), rn);
+
+  // Determine cosine term for scatter expansion if necessary. The Legendre
+  // polynomials are found with their recursion relation as each order is
+  // visited so that no scratch space is needed.
+  bool scatter = (cosine_ == SphericalHarmonicsCosine::scatter);
+  double mu = p.mu();
+  double pn = 1.;
+  double pn_prev = 0.;
 
   int j = 0;
   for (int n = 0; n < order_ + 1; n++) {
     // Calculate n-th order spherical harmonics for (u,v,w)
     int num_nm = 2 * n + 1;
+    double wgt = scatter ? pn : 1.;
 
     // Append the matching (bin,weight) for each moment
     for (int i = 0; i < num_nm; i++) {
-      match.weights_.push_back(wgt[n] * rn[j]);
+      rn[j] *= wgt;
       match.bins_.push_back(j);
       ++j;
     }
+
+    // Advance the Legendre polynomial to order n + 1
+    double pn_next = ((2 * n + 1) * mu * pn - n * pn_prev) / (n + 1);
+    pn_prev = pn;
+    pn = pn_next;
   }
 }
 
@@ -6,7 +6,6 @@
 
 #include <fmt/core.h>
 
-#include "openmc/search.h"
 #include "openmc/xml_interface.h"
 
 namespace openmc {
@@ -36,6 +35,7 @@ void TimeFilter::set_bins(gsl::span<const double> bins)
   // Copy bins
   std::copy(bins.cbegin(), bins.cend(), std::back_inserter(bins_));
   n_bins_ = bins_.size() - 1;
+  lookup_.set_edges(bins_);
 }
 
 void TimeFilter::get_all_bins(
@@ -59,30 +59,44 @@ void TimeFilter::get_all_bins(
     if (t_start == t_end)
       return;
 
-    // Determine first bin containing a portion of time interval
-    auto i_bin = lower_bound_index(bins_.begin(), bins_.end(), t_start);
-
-    // Find matching bins
-    double dt_total = t_end - t_start;
-    for (; i_bin < bins_.size() - 1; ++i_bin) {
-      double t_left = std::max(t_start, bins_[i_bin]);
-      double t_right = std::min(t_end, bins_[i_bin + 1]);
-
-      // Add match with weight equal to the fraction of the time interval within
-      // the current time bin
-      const double fraction = (t_right - t_left) / dt_total;
+    // Determine the first and last bins containing a portion of the time
+    // interval
+    int i_first = lookup_.find(bins_, std::max(t_start, bins_.front()));
+    int i_last = lookup_.find(bins_, std::min(t_end, bins_.back()));
+    if (t_start >= bins_[i_first + 1])
+      ++i_first;
+
+    // Add matches with weights equal to the fraction of the time interval
+    // within each bin. Only the first and last bins are partially covered, so
+    // the bins in between are covered by their whole width.
+    double inv_dt = 1.0 / (t_end - t_start);
+    if (i_first == i_last) {
+      double t_left = std::max(t_start, bins_[i_first]);
+      double t_right = std::min(t_end, bins_[i_first + 1]);
+      match.bins_.push_back(i_first);
+      match.weights_.push_back((t_right - t_left) * inv_dt);
+      return;
+    }
+    match.bins_.push_back(i_first);
+    match.weights_.push_back(
+      (bins_[i_first + 1] - std::max(t_start, bins_[i_first])) * inv_dt);
+    double uniform_fraction = lookup_.width() * inv_dt;
+    for (int i_bin = i_first + 1; i_bin < i_last; ++i_bin) {
       match.bins_.push_back(i_bin);
-      match.weights_.push_back(fraction);
-
-      if (t_end < bins_[i_bin + 1])
-        break;
+      match.weights_.push_back(lookup_.uniform()
+                                 ? uniform_fraction
+                                 : (bins_[i_bin + 1] - bins_[i_bin]) * inv_dt);
     }
+    match.bins_.push_back(i_last);
+    match.weights_.push_back(
+      (std::min(t_end, bins_[i_last + 1]) - bins_[i_last]) * inv_dt);
   } else {
     // -------------------------------------------------------------------------
     // For collision estimator or surface tallies, find a match based on the
     // exact time of the particle
-    const auto i_bin = lower_bound_index(bins_.begin(), bins_.end(), t_end);
-    match.bins_.push_back(i_bin);
+    if (t_end > bins_.back())
+      return;
+    match.bins_.push_back(lookup_.find(bins_, t_end));
     match.weights_.push_back(1.0);
   }
 }
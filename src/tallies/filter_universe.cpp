@@ -29,15 +29,14 @@ void UniverseFilter::set_universes(gsl::span<int32_t> universes)
   // Clear existing universes
   universes_.clear();
   universes_.reserve(universes.size());
-  map_.clear();
 
   // Update universes and mapping
   for (auto& index : universes) {
     Expects(index >= 0);
     Expects(index < model::universes.size());
     universes_.push_back(index);
-    map_[index] = universes_.size() - 1;
   }
+  map_.set(universes_, model::universes.size());
 
   n_bins_ = universes_.size();
 }
@@ -46,9 +45,9 @@ void UniverseFilter::get_all_bins(
   const Particle& p, TallyEstimator estimator, FilterMatch& match) const
 {
   for (int i = 0; i < p.n_coord(); i++) {
-    auto search = map_.find(p.coord(i).universe);
-    if (search != map_.end()) {
-      match.bins_.push_back(search->second);
+    int bin = map_.find(p.coord(i).universe);
+    if (bin >= 0) {
+      match.bins_.push_back(bin);
       match.weights_.push_back(1.0);
     }
   }
@@ -0,0 +1,278 @@
+#include "openmc/tallies/flux_spectrum.h"
+
+#include <algorithm> // for fill, copy
+
+#include <fmt/core.h>
+
+#include "openmc/capi.h"
+#include "openmc/error.h"
+#include "openmc/material.h"
+#include "openmc/message_passing.h"
+#include "openmc/nuclide.h"
+#include "openmc/settings.h"
+
+namespace openmc {
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace model {
+FluxSpectrum flux_spectrum;
+} // namespace model
+
+//==============================================================================
+// FluxSpectrum implementation
+//==============================================================================
+
+void FluxSpectrum::set(gsl::span<const int32_t> materials, int n_groups,
+  double E_min, double E_max, bool sparse)
+{
+  this->clear();
+  if (n_groups <= 0 || materials.empty())
+    return;
+
+  n_groups_ = n_groups;
+  sparse_ = sparse;
+  E_min_ = E_min;
+  E_max_ = E_max;
+  inv_width_ = n_groups / std::log(E_max / E_min);
+
+  materials_.assign(materials.begin(), materials.end());
+  material_index_.assign(model::materials.size(), -1);
+  for (int i = 0; i < materials_.size(); ++i) {
+    material_index_[materials_[i]] = i;
+  }
+
+  // Group boundaries equally spaced in lethargy
+  energy_.resize(n_groups + 1);
+  for (int g = 0; g <= n_groups; ++g) {
+    energy_[g] = E_min * std::exp(g / inv_width_);
+  }
+  energy_.back() = E_max;
+
+  if (sparse_) {
+    n_blocks_ = (n_groups + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    n_blocks_total_ = materials_.size() * n_blocks_;
+    blocks_ = make_unique<std::atomic<float*>[]>(n_blocks_total_);
+    for (size_t i = 0; i < n_blocks_total_; ++i)
+      blocks_[i].store(nullptr, std::memory_order_relaxed);
+  } else {
+    values_.assign(materials_.size() * n_groups, 0.0f);
+  }
+}
+
+void FluxSpectrum::clear()
+{
+  this->free_blocks();
+  active_ = false;
+  sparse_ = false;
+  n_groups_ = 0;
+  n_blocks_ = 0;
+  weight_ = 0.0;
+  materials_.clear();
+  material_index_.clear();
+  energy_.clear();
+  values_.clear();
+  values_.shrink_to_fit();
+}
+
+void FluxSpectrum::free_blocks()
+{
+  for (size_t i = 0; i < n_blocks_total_; ++i)
+    delete[] blocks_[i].load(std::memory_order_relaxed);
+  blocks_.reset();
+  n_blocks_total_ = 0;
+}
+
+void FluxSpectrum::reset()
+{
+  weight_ = 0.0;
+  std::fill(values_.begin(), values_.end(), 0.0f);
+  for (size_t i = 0; i < n_blocks_total_; ++i) {
+    float* x = blocks_[i].load(std::memory_order_relaxed);
+    if (x)
+      std::fill(x, x + BLOCK_SIZE, 0.0f);
+  }
+}
+
+void FluxSpectrum::reduce()
+{
+#ifdef OPENMC_MPI
+  if (mpi::n_procs == 1)
+    return;
+
+  MPI_Allreduce(
+    MPI_IN_PLACE, &weight_, 1, MPI_DOUBLE, MPI_SUM, mpi::intracomm);
+
+  if (!sparse_) {
+    MPI_Allreduce(MPI_IN_PLACE, values_.data(), values_.size(), MPI_FLOAT,
+      MPI_SUM, mpi::intracomm);
+    return;
+  }
+
+  // Find the blocks that have been scored on any process
+  vector<int> scored(n_blocks_total_);
+  for (size_t i = 0; i < n_blocks_total_; ++i) {
+    scored[i] = blocks_[i].load(std::memory_order_relaxed) ? 1 : 0;
+  }
+  MPI_Allreduce(MPI_IN_PLACE, scored.data(), scored.size(), MPI_INT, MPI_MAX,
+    mpi::intracomm);
+
+  // Sum those blocks in a contiguous array, allocating them on every process
+  vector<float> values;
+  for (size_t i = 0; i < n_blocks_total_; ++i) {
+    if (scored[i]) {
+      const float* x = this->allocate(i);
+      values.insert(values.end(), x, x + BLOCK_SIZE);
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, values.data(), values.size(), MPI_FLOAT, MPI_SUM,
+    mpi::intracomm);
+  size_t j = 0;
+  for (size_t i = 0; i < n_blocks_total_; ++i) {
+    if (scored[i]) {
+      std::copy(values.begin() + j, values.begin() + j + BLOCK_SIZE,
+        blocks_[i].load(std::memory_order_relaxed));
+      j += BLOCK_SIZE;
+    }
+  }
+#endif
+}
+
+void FluxSpectrum::get(int i, double* flux) const
+{
+  double norm = weight_ > 0.0 ? 1.0 / weight_ : 0.0;
+  if (!sparse_) {
+    const float* x = values_.data() + static_cast<size_t>(i) * n_groups_;
+    for (int g = 0; g < n_groups_; ++g)
+      flux[g] = x[g] * norm;
+    return;
+  }
+
+  for (int b = 0; b < n_blocks_; ++b) {
+    const float* x = blocks_[static_cast<size_t>(i) * n_blocks_ + b].load(
+      std::memory_order_acquire);
+    int g_start = b * BLOCK_SIZE;
+    int n = std::min(BLOCK_SIZE, n_groups_ - g_start);
+    for (int g = 0; g < n; ++g)
+      flux[g_start + g] = x ? x[g] * norm : 0.0;
+  }
+}
+
+//==============================================================================
+// C API functions
+//==============================================================================
+
+extern "C" int openmc_flux_spectrum_set(int n_materials,
+  const int32_t* materials, int n_groups, double E_min, double E_max,
+  bool sparse)
+{
+  for (int i = 0; i < n_materials; ++i) {
+    if (materials[i] < 0 || materials[i] >= model::materials.size()) {
+      set_errmsg("Index in materials array is out of bounds.");
+      return OPENMC_E_OUT_OF_BOUNDS;
+    }
+  }
+  if (n_groups > 0 && n_materials > 0) {
+    if (!settings::run_CE) {
+      set_errmsg("A flux spectrum can only be tallied in continuous-energy "
+                 "mode.");
+      return OPENMC_E_INVALID_ARGUMENT;
+    }
+    if (settings::delta_tracking) {
+      set_errmsg("A flux spectrum cannot be tallied with delta tracking since "
+                 "it has no track-length estimate.");
+      return OPENMC_E_INVALID_ARGUMENT;
+    }
+    if (E_min <= 0.0 || E_max <= E_min) {
+      set_errmsg("Energy bounds of a flux spectrum must be positive and "
+                 "increasing.");
+      return OPENMC_E_INVALID_ARGUMENT;
+    }
+  }
+
+  model::flux_spectrum.set(
+    {materials, static_cast<size_t>(n_materials)}, n_groups, E_min, E_max,
+    sparse);
+  return 0;
+}
+
+extern "C" int openmc_flux_spectrum_get_energy(
+  const double** energy, int* n_groups, int* n_materials)
+{
+  *energy = model::flux_spectrum.energy().data();
+  *n_groups = model::flux_spectrum.n_groups();
+  *n_materials = model::flux_spectrum.materials().size();
+  return 0;
+}
+
+extern "C" int openmc_flux_spectrum_get_flux(int index, double* flux)
+{
+  const auto& fs {model::flux_spectrum};
+  if (index < 0 || index >= fs.materials().size()) {
+    set_errmsg("Index in flux spectrum materials is out of bounds.");
+    return OPENMC_E_OUT_OF_BOUNDS;
+  }
+  fs.get(index, flux);
+  return 0;
+}
+
+extern "C" int openmc_flux_spectrum_collapse_rates(const double* temperatures,
+  int n_nuclides, const int* nuclides, int n_reactions, const int* MTs,
+  double* rates)
+{
+  const auto& fs {model::flux_spectrum};
+  if (!fs.on()) {
+    set_errmsg("No flux spectrum has been set.");
+    return OPENMC_E_ALLOCATE;
+  }
+  for (int k = 0; k < n_nuclides; ++k) {
+    if (nuclides[k] < 0 || nuclides[k] >= data::nuclides.size()) {
+      set_errmsg("Index in nuclides vector is out of bounds.");
+      return OPENMC_E_OUT_OF_BOUNDS;
+    }
+  }
+  for (int k = 0; k < n_reactions; ++k) {
+    if (MTs[k] <= 0 || MTs[k] >= 902) {
+      set_errmsg(fmt::format("Invalid MT value: {}", MTs[k]));
+      return OPENMC_E_INVALID_ARGUMENT;
+    }
+  }
+
+  // The logarithmic grid indices of the group boundaries are shared by all
+  // nuclides and materials
+  gsl::span<const double> E {fs.energy()};
+  auto i_log = log_grid_indices(E);
+
+  // The spectrum of each material is converted to double precision in a
+  // buffer reused by each thread and collapsed independently
+  int n_groups = fs.n_groups();
+  int n_materials = fs.materials().size();
+  int err = 0;
+#pragma omp parallel
+  {
+    vector<double> phi(n_groups);
+#pragma omp for schedule(dynamic)
+    for (int i = 0; i < n_materials; ++i) {
+      fs.get(i, phi.data());
+      for (int k = 0; k < n_nuclides; ++k) {
+        double* r = rates + (static_cast<size_t>(i) * n_nuclides + k) *
+                              n_reactions;
+        try {
+          data::nuclides[nuclides[k]]->collapse_rates(
+            {MTs, MTs + n_reactions}, temperatures[i], E, phi, i_log, r);
+        } catch (const std::out_of_range& e) {
+#pragma omp critical(CollapseFluxSpectrum)
+          {
+            set_errmsg(e.what());
+            err = OPENMC_E_OUT_OF_BOUNDS;
+          }
+        }
+      }
+    }
+  }
+  return err;
+}
+
+} // namespace openmc
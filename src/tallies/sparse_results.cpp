@@ -0,0 +1,154 @@
+#include "openmc/tallies/sparse_results.h"
+
+#include <algorithm> // for fill, copy, any_of
+
+#include "openmc/hdf5_interface.h"
+#include "openmc/message_passing.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+
+//==============================================================================
+// SparseTallyResults implementation
+//==============================================================================
+
+void SparseTallyResults::reset()
+{
+  for (int i = 0; i < this->n_blocks(); ++i) {
+    double* x = this->block(i);
+    if (x)
+      std::fill(x, x + this->block_size(i), 0.0);
+  }
+}
+
+void SparseTallyResults::reduce()
+{
+#ifdef OPENMC_MPI
+  // Find the blocks that have been scored on any process
+  vector<int> scored(this->n_blocks());
+  for (int i = 0; i < scored.size(); ++i) {
+    scored[i] = this->block(i) ? 1 : 0;
+  }
+  MPI_Allreduce(MPI_IN_PLACE, scored.data(), scored.size(), MPI_INT, MPI_MAX,
+    mpi::intracomm);
+
+  // Make copy of the values of those blocks in contiguous array, using zeros
+  // for blocks that were not scored on this process
+  constexpr int i_value = static_cast<int>(TallyResult::VALUE);
+  vector<double> values;
+  for (int i = 0; i < scored.size(); ++i) {
+    if (!scored[i])
+      continue;
+    const double* x = this->block(i);
+    size_t n = this->block_size(i) / 3;
+    for (size_t k = 0; k < n; ++k) {
+      values.push_back(x ? x[3 * k + i_value] : 0.0);
+    }
+  }
+  vector<double> values_reduced(mpi::master ? values.size() : 0);
+
+  // Reduce contiguous set of tally results
+  MPI_Reduce(values.data(), values_reduced.data(), values.size(), MPI_DOUBLE,
+    MPI_SUM, 0, mpi::intracomm);
+
+  // Transfer values on master and reset on other ranks
+  size_t j = 0;
+  for (int i = 0; i < scored.size(); ++i) {
+    if (!scored[i])
+      continue;
+    double* x = mpi::master ? this->allocate(i) : this->block(i);
+    size_t n = this->block_size(i) / 3;
+    if (x) {
+      for (size_t k = 0; k < n; ++k) {
+        x[3 * k + i_value] = mpi::master ? values_reduced[j + k] : 0.0;
+      }
+    }
+    j += n;
+  }
+#endif
+}
+
+void SparseTallyResults::broadcast()
+{
+#ifdef OPENMC_MPI
+  // Find the blocks that are allocated on the master process
+  vector<int> allocated(this->n_blocks());
+  for (int i = 0; i < allocated.size(); ++i) {
+    allocated[i] = this->block(i) ? 1 : 0;
+  }
+  MPI_Bcast(allocated.data(), allocated.size(), MPI_INT, 0, mpi::intracomm);
+
+  // Pack the values of those blocks into a contiguous array on master
+  size_t n_values = 0;
+  for (int i = 0; i < allocated.size(); ++i) {
+    if (allocated[i])
+      n_values += this->block_size(i);
+  }
+  vector<double> values;
+  values.reserve(n_values);
+  if (mpi::master) {
+    for (int i = 0; i < allocated.size(); ++i) {
+      if (allocated[i]) {
+        const double* x = this->block(i);
+        values.insert(values.end(), x, x + this->block_size(i));
+      }
+    }
+  } else {
+    values.resize(n_values);
+  }
+
+  // Broadcast contiguous set of tally results
+  MPI_Bcast(values.data(), n_values, MPI_DOUBLE, 0, mpi::intracomm);
+
+  // Unpack the values on other ranks, zeroing blocks master does not have
+  if (!mpi::master) {
+    size_t j = 0;
+    for (int i = 0; i < allocated.size(); ++i) {
+      size_t n = this->block_size(i);
+      if (allocated[i]) {
+        std::copy(&values[j], &values[j] + n, this->allocate(i));
+        j += n;
+      } else if (double* x = this->block(i)) {
+        std::fill(x, x + n, 0.0);
+      }
+    }
+  }
+#endif
+}
+
+void SparseTallyResults::write(hid_t group_id) const
+{
+  hid_t dset =
+    create_tally_results(group_id, n_filter_bins_, n_scores_, BLOCK_SIZE);
+  for (int i = 0; i < this->n_blocks(); ++i) {
+    const double* x = this->block(i);
+    if (x) {
+      write_tally_results_block(
+        dset, i * BLOCK_SIZE, this->block_bins(i), n_scores_, x);
+    }
+  }
+  close_dataset(dset);
+}
+
+void SparseTallyResults::read(hid_t group_id)
+{
+  hid_t dset = open_dataset(group_id, "results");
+  vector<double> values;
+  for (int i = 0; i < this->n_blocks(); ++i) {
+    values.assign(this->block_size(i), 0.0);
+    read_tally_results_block(
+      dset, i * BLOCK_SIZE, this->block_bins(i), n_scores_, values.data());
+
+    // Only keep blocks that have been scored
+    bool scored = std::any_of(
+      values.begin(), values.end(), [](double v) { return v != 0.0; });
+    if (scored) {
+      std::copy(values.begin(), values.end(), this->allocate(i));
+    } else if (double* x = this->block(i)) {
+      std::fill(x, x + values.size(), 0.0);
+    }
+  }
+  close_dataset(dset);
+}
+
+} // namespace openmc
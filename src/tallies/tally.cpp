@@ -2,7 +2,10 @@
 
 #include "openmc/array.h"
 #include "openmc/capi.h"
+#include "openmc/cell.h"
 #include "openmc/constants.h"
+#include "openmc/container_util.h"
+#include "openmc/eigenvalue.h"
 #include "openmc/error.h"
 #include "openmc/file_utils.h"
 #include "openmc/mesh.h"
@@ -28,6 +31,10 @@
 #include "openmc/tallies/filter_particle.h"
 #include "openmc/tallies/filter_sph_harm.h"
 #include "openmc/tallies/filter_surface.h"
+#include "openmc/tallies/flux_spectrum.h"
+#include "openmc/tallies/tally_scoring.h"
+#include "openmc/tallies/trigger.h"
+#include "openmc/weight_windows.h"
 #include "openmc/xml_interface.h"
 
 #include "xtensor/xadapt.hpp"
@@ -35,8 +42,11 @@
 #include "xtensor/xview.hpp"
 #include <fmt/core.h>
 
-#include <algorithm> // for max
+#include <algorithm> // for max, min, find_if
+#include <cmath>     // for sqrt
 #include <cstddef>   // for size_t
+#include <cstdint>   // for int64_t
+#include <limits>    // for numeric_limits
 #include <string>
 
 namespace openmc {
@@ -54,11 +64,17 @@ vector<int> active_tracklength_tallies;
 vector<int> active_collision_tallies;
 vector<int> active_meshsurf_tallies;
 vector<int> active_surface_tallies;
+vector<int> active_pulse_height_tallies;
+vector<bool> pulse_height_cells;
+vector<vector<int>> active_tracklength_groups;
+vector<vector<int>> active_collision_groups;
 } // namespace model
 
 namespace simulation {
 xt::xtensor_fixed<double, xt::xshape<N_GLOBAL_TALLIES, 3>> global_tallies;
 int32_t n_realizations {0};
+int n_unreduced_batches {0};
+bool tally_results_deferrable {false};
 } // namespace simulation
 
 double global_tally_absorption;
@@ -260,6 +276,7 @@ Tally::Tally(pugi::xml_node node)
 
   // Check if user specified estimator
   if (check_for_node(node, "estimator")) {
+    estimator_specified_ = true;
     std::string est = get_node_value(node, "estimator");
     if (est == "analog") {
       estimator_ = TallyEstimator::ANALOG;
@@ -295,6 +312,16 @@ Tally::Tally(pugi::xml_node node)
     }
   }
 
+  // Check if scores should be accumulated in thread-private buffers
+  if (check_for_node(node, "thread_buffers")) {
+    thread_buffers_ = get_node_value_bool(node, "thread_buffers");
+  }
+
+  // Check if results should be stored sparsely
+  if (check_for_node(node, "sparse_results")) {
+    sparse_ = get_node_value_bool(node, "sparse_results");
+  }
+
 #ifdef LIBMESH
   // ensure a tracklength tally isn't used with a libMesh filter
   for (auto i : this->filters_) {
@@ -376,6 +403,7 @@ void Tally::set_filters(gsl::span<Filter*> filters)
 
   // Set the strides.
   set_strides();
+  set_filter_plan();
 }
 
 void Tally::set_strides()
@@ -393,6 +421,79 @@ void Tally::set_strides()
   n_filter_bins_ = stride;
 }
 
+void Tally::set_filter_plan()
+{
+  // Rank filters by how cheaply they find their bins. Particle and energy
+  // filters are checked first since they often reject most events.
+  auto rank = [](int32_t i_filt) {
+    auto type = model::tally_filters[i_filt]->type();
+    if (type == "particle") {
+      return 0;
+    } else if (type == "energy" || type == "material" || type == "cellborn") {
+      return 1;
+    } else if (type == "cell" || type == "universe" || type == "cellfrom") {
+      return 2;
+    }
+    return 3;
+  };
+  filter_order_ = filters_;
+  std::stable_sort(filter_order_.begin(), filter_order_.end(),
+    [&](int32_t a, int32_t b) { return rank(a) < rank(b); });
+
+  // Find the particle types and energies that can match every filter
+  particle_mask_ = ~0u;
+  energy_min_ = 0.0;
+  energy_max_ = INFTY;
+  for (auto i_filt : filters_) {
+    const auto* filt = model::tally_filters[i_filt].get();
+    if (const auto* pf = dynamic_cast<const ParticleFilter*>(filt)) {
+      unsigned mask = 0;
+      for (auto type : pf->particles())
+        mask |= 1u << static_cast<int>(type);
+      particle_mask_ &= mask;
+    } else if (filt->type() == "energy") {
+      // Energy filters matching the transport groups bin by group instead
+      const auto* ef = static_cast<const EnergyFilter*>(filt);
+      if (settings::run_CE && !ef->matches_transport_groups() &&
+          !ef->bins().empty()) {
+        energy_min_ = std::max(energy_min_, ef->bins().front());
+        energy_max_ = std::min(energy_max_, ef->bins().back());
+      }
+    }
+  }
+}
+
+void Tally::init_depletion_rates()
+{
+  depletion_rates_ = false;
+  depletion_rx_.clear();
+  if (!settings::run_CE || !simulation::need_depletion_rx ||
+      type_ != TallyType::VOLUME || estimator_ == TallyEstimator::ANALOG ||
+      deriv_ != C_NONE)
+    return;
+
+  // Every nuclide must be tallied individually
+  for (auto i_nuclide : nuclides_) {
+    if (i_nuclide < 0)
+      return;
+  }
+
+  // Every score must be fission or a reaction precalculated for depletion
+  for (auto score : scores_) {
+    if (score == SCORE_FISSION) {
+      depletion_rx_.push_back(DEPLETION_RX.size());
+      continue;
+    }
+    auto it = std::find(DEPLETION_RX.begin(), DEPLETION_RX.end(), score);
+    if (it == DEPLETION_RX.end()) {
+      depletion_rx_.clear();
+      return;
+    }
+    depletion_rx_.push_back(it - DEPLETION_RX.begin());
+  }
+  depletion_rates_ = true;
+}
+
 void Tally::set_scores(pugi::xml_node node)
 {
   if (!check_for_node(node, "scores"))
@@ -497,6 +598,30 @@ void Tally::set_scores(const vector<std::string>& scores)
       if (settings::photon_transport)
         estimator_ = TallyEstimator::COLLISION;
       break;
+
+    case SCORE_PULSE_HEIGHT:
+      if (!settings::photon_transport)
+        fatal_error("Cannot tally pulse-height without photon transport.");
+      if (settings::weight_windows_on)
+        fatal_error("Cannot tally pulse-height with weight windows since "
+                    "split particles would be scored as separate energy "
+                    "deposits.");
+      type_ = TallyType::PULSE_HEIGHT;
+      estimator_ = TallyEstimator::ANALOG;
+      break;
+
+    case SCORE_IFP_TIME_NUM:
+    case SCORE_IFP_BETA_NUM:
+    case SCORE_IFP_DENOM:
+      if (settings::ifp_n_generation == 0)
+        fatal_error("Cannot tally " + score_str +
+                    " unless the number of generations for iterated fission "
+                    "probability is set.");
+      if (energyout_present)
+        fatal_error("Cannot tally " + score_str +
+                    " with an outgoing energy filter.");
+      estimator_ = TallyEstimator::ANALOG;
+      break;
     }
 
     scores_.push_back(score);
@@ -527,9 +652,37 @@ void Tally::set_scores(const vector<std::string>& scores)
       fatal_error("Cannot tally other scores in the same tally as surface "
                   "currents.");
   }
+  // Pulse-height tallies bin the energy deposited in each cell by a history,
+  // which needs exactly a cell filter and an energy filter
+  if (type_ == TallyType::PULSE_HEIGHT) {
+    if (scores_.size() != 1)
+      fatal_error("Cannot tally other scores in the same tally as "
+                  "pulse-height.");
+    if (!(nuclides_.size() == 1 && nuclides_[0] == -1))
+      fatal_error("Cannot tally pulse-height for an individual nuclide.");
+    int n_cell = 0;
+    int n_energy = 0;
+    for (auto i_filt : filters_) {
+      const auto& filt {*model::tally_filters[i_filt]};
+      if (filt.type() == "cell") {
+        ++n_cell;
+      } else if (filt.type() == "energy") {
+        ++n_energy;
+      }
+    }
+    if (n_cell != 1 || n_energy != 1 || filters_.size() != 2)
+      fatal_error(fmt::format("Pulse-height tally {} must have exactly one "
+                              "cell filter and one energy filter.",
+        id_));
+  }
   if ((surface_present || meshsurface_present) && scores_[0] != SCORE_CURRENT)
     fatal_error("Cannot tally score other than 'current' when using a surface "
                 "or mesh-surface filter.");
+
+  // Choose the kernel used to compute each score
+  score_kernels_.clear();
+  for (auto sc : scores_)
+    score_kernels_.push_back(get_score_kernel(sc));
 }
 
 void Tally::set_nuclides(pugi::xml_node node)
@@ -633,21 +786,160 @@ void Tally::init_triggers(pugi::xml_node node)
   }
 }
 
+//! Zero results with all threads. Results are scored by all threads, so
+//! touching their pages first in parallel spreads them over the NUMA domains.
+
+void zero_results(double* x, int64_t n)
+{
+#pragma omp parallel for schedule(static)
+  for (int64_t i = 0; i < n; ++i) {
+    x[i] = 0.0;
+  }
+}
+
 void Tally::init_results()
 {
   int n_scores = scores_.size() * nuclides_.size();
-  results_ = xt::empty<double>({n_filter_bins_, n_scores, 3});
+#ifdef _OPENMP
+  int n_threads = omp_get_max_threads();
+#else
+  int n_threads = 1;
+#endif
+
+  // Results from a previous simulation are kept if the tally still has the
+  // same shape, since they are zeroed whenever tallies are reset
+  auto shape = results_.shape();
+  if (!sparse_ && !sparse_results_ && shape[0] == n_filter_bins_ &&
+      shape[1] == n_scores &&
+      (thread_results_.empty() || thread_results_.size() == n_threads))
+    return;
+
+  // Sparse results are allocated block by block as bins are scored
+  thread_results_.clear();
+  if (sparse_) {
+    if (!settings::reduce_tallies) {
+      fatal_error(fmt::format("Sparse results for tally {} cannot be used "
+                              "with the no-reduce method.",
+        id_));
+    }
+    if (thread_buffers_) {
+      warning(fmt::format("Thread-private buffers are not used for tally {} "
+                          "since its results are sparse.",
+        id_));
+    }
+    results_ =
+      TallyArray<3>::from_shape({0, static_cast<size_t>(n_scores), 3});
+    sparse_results_ = make_unique<SparseTallyResults>(n_filter_bins_, n_scores);
+    return;
+  }
+  sparse_results_.reset();
+  results_ = TallyArray<3>::from_shape({static_cast<size_t>(n_filter_bins_),
+    static_cast<size_t>(n_scores), 3});
+  if (settings::numa_first_touch) {
+    zero_results(results_.data(), results_.size());
+  }
+
+  // Allocate a private copy of the bin values for each thread as long as the
+  // total memory for the copies stays reasonable
+  if (thread_buffers_ && n_threads > 1) {
+    double n_bytes = static_cast<double>(n_threads) * n_filter_bins_ *
+                     n_scores * sizeof(double);
+    if (n_bytes > MAX_THREAD_BUFFER_BYTES) {
+      warning(fmt::format("Thread-private buffers for tally {} would require "
+                          "{:.1f} MB; using atomic updates instead.",
+        id_, n_bytes / 1.0e6));
+    } else {
+      thread_results_.resize(n_threads);
+      if (settings::numa_first_touch) {
+        // Each thread zeroes its own copy so that it is placed in the NUMA
+        // domain the thread runs on
+#pragma omp parallel for schedule(static, 1)
+        for (int i = 0; i < n_threads; ++i) {
+          thread_results_[i] = xt::zeros<double>({n_filter_bins_, n_scores});
+        }
+      } else {
+        for (auto& buffer : thread_results_) {
+          buffer = xt::zeros<double>({n_filter_bins_, n_scores});
+        }
+      }
+    }
+  }
+}
+
+size_t Tally::memory_usage() const
+{
+  size_t bytes = sizeof(double) * results_.size();
+  for (const auto& buffer : thread_results_) {
+    bytes += sizeof(double) * buffer.size();
+  }
+  if (sparse_results_)
+    bytes += sparse_results_->nbytes();
+  return bytes;
 }
 
 void Tally::reset()
 {
   n_realizations_ = 0;
   if (results_.size() != 0) {
-    xt::view(results_, xt::all()) = 0.0;
+    if (settings::numa_first_touch) {
+      zero_results(results_.data(), results_.size());
+    } else {
+      xt::view(results_, xt::all()) = 0.0;
+    }
+  }
+  for (auto& buffer : thread_results_) {
+    buffer.fill(0.0);
+  }
+  if (sparse_results_) {
+    sparse_results_->reset();
+  }
+  for (auto& trigger : triggers_) {
+    trigger.ratio = 0.0;
+    trigger.worst_bins.clear();
   }
 }
 
-void Tally::accumulate()
+void Tally::reduce_thread_results()
+{
+  if (thread_results_.empty())
+    return;
+
+#pragma omp parallel for
+  for (int i = 0; i < results_.shape()[0]; ++i) {
+    for (int j = 0; j < results_.shape()[1]; ++j) {
+      double val = 0.0;
+      for (auto& buffer : thread_results_) {
+        val += buffer(i, j);
+        buffer(i, j) = 0.0;
+      }
+      results_(i, j, TallyResult::VALUE) += val;
+    }
+  }
+}
+
+namespace {
+
+//! Add the normalized values of consecutive (value, sum, sum_sq) triplets to
+//! their sums and sums of squares and zero the values. Indexing the raw array
+//! directly lets the compiler vectorize the loop.
+
+void accumulate_results(double* x, int64_t n, double norm)
+{
+  constexpr int i_value = static_cast<int>(TallyResult::VALUE);
+  constexpr int i_sum = static_cast<int>(TallyResult::SUM);
+  constexpr int i_sum_sq = static_cast<int>(TallyResult::SUM_SQ);
+#pragma omp simd
+  for (int64_t k = 0; k < n; ++k) {
+    double val = x[3 * k + i_value] * norm;
+    x[3 * k + i_value] = 0.0;
+    x[3 * k + i_sum] += val;
+    x[3 * k + i_sum_sq] += val * val;
+  }
+}
+
+} // namespace
+
+void Tally::accumulate(int n_batches)
 {
   // Increment number of realizations
   n_realizations_ += settings::reduce_tallies ? 1 : mpi::n_procs;
@@ -663,20 +955,37 @@ void Tally::accumulate()
       total_source = 1.0;
     }
 
-    // Account for number of source particles in normalization
+    // Account for number of source particles in normalization, including
+    // fission neutrons transported in the generation they were born in
     double norm =
-      total_source / (settings::n_particles * settings::gen_per_batch);
+      total_source /
+      (settings::n_particles * settings::gen_per_batch * n_batches +
+        simulation::wielandt_weight_unreduced);
 
-// Accumulate each result
+    // Accumulate each result in the blocks that have been scored
+    if (sparse_results_) {
+      auto& sparse = *sparse_results_;
+#pragma omp parallel for
+      for (int i = 0; i < sparse.n_blocks(); ++i) {
+        double* x = sparse.block(i);
+        if (x)
+          accumulate_results(x, sparse.block_size(i) / 3, norm);
+      }
+    } else {
+      // Accumulate each result, splitting the array into contiguous chunks
+      // of results for the threads
+      constexpr int64_t chunk_size = 1024;
+      int64_t n = results_.size() / 3;
 #pragma omp parallel for
-    for (int i = 0; i < results_.shape()[0]; ++i) {
-      for (int j = 0; j < results_.shape()[1]; ++j) {
-        double val = results_(i, j, TallyResult::VALUE) * norm;
-        results_(i, j, TallyResult::VALUE) = 0.0;
-        results_(i, j, TallyResult::SUM) += val;
-        results_(i, j, TallyResult::SUM_SQ) += val * val;
+      for (int64_t i = 0; i < n; i += chunk_size) {
+        accumulate_results(
+          results_.data() + 3 * i, std::min(chunk_size, n - i), norm);
       }
     }
+
+    // Update the uncertainties of triggered bins for the upcoming check
+    if (!triggers_.empty() && is_trigger_batch())
+      update_tally_triggers(*this);
   }
 }
 
@@ -759,74 +1068,198 @@ void read_tallies_xml()
 }
 
 #ifdef OPENMC_MPI
-void reduce_tally_results()
-{
-  // Don't reduce tally is no_reduce option is on
-  if (settings::reduce_tallies) {
-    for (int i_tally : model::active_tallies) {
-      // Skip any tallies that are not active
-      auto& tally {model::tallies[i_tally]};
+//==============================================================================
+//! Nonblocking reduction of the values of a tally onto the master process.
+//
+//! Values are reduced in place in results_ in chunks of at most
+//! REDUCE_CHUNK_SIZE, described to MPI by a strided datatype so that they are
+//! never copied into a separate buffer. Two chunks are in flight at a time.
+//! Each chunk is first combined among the processes on a node and then across
+//! nodes.
+//==============================================================================
 
-      // Get view of accumulated tally values
-      auto values_view = xt::view(tally->results_, xt::all(), xt::all(),
-        static_cast<int>(TallyResult::VALUE));
+class TallyReduction {
+public:
+  explicit TallyReduction(Tally& tally)
+    : tally_ {tally}, n_values_ {tally.results_.size() / 3},
+      chunk_size_ {std::min<size_t>(n_values_, REDUCE_CHUNK_SIZE)}
+  {
+    n_chunks_ = chunk_size_ > 0 ? (n_values_ + chunk_size_ - 1) / chunk_size_
+                                : 0;
+    if (mpi::leader_intracomm != MPI_COMM_NULL) {
+      MPI_Comm_size(mpi::leader_intracomm, &n_nodes_);
+    }
+  }
 
-      // Make copy of tally values in contiguous array
-      xt::xtensor<double, 2> values = values_view;
-      xt::xtensor<double, 2> values_reduced = xt::empty_like(values);
+  //! Start reducing the first chunks
+  void start()
+  {
+    for (int i = 0; i < std::min(n_chunks_, 2); ++i) {
+      this->post(i);
+    }
+  }
 
-      // Reduce contiguous set of tally results
-      MPI_Reduce(values.data(), values_reduced.data(), values.size(),
-        MPI_DOUBLE, MPI_SUM, 0, mpi::intracomm);
+  //! Wait for all chunks to be reduced, starting the remaining ones as
+  //! earlier ones finish
+  void finish()
+  {
+    for (int i = 0; i < n_chunks_; ++i) {
+      this->complete(i);
+      if (i + 2 < n_chunks_) {
+        this->post(i + 2);
+      }
+    }
+  }
 
-      // Transfer values on master and reset on other ranks
-      if (mpi::master) {
-        values_view = values_reduced;
+private:
+  //! Value results of a chunk, which are strided by the number of results
+  double* results(int i_chunk)
+  {
+    return tally_.results_.data() + 3 * i_chunk * chunk_size_ +
+           static_cast<int>(TallyResult::VALUE);
+  }
+
+  //! Datatype covering the values of a chunk. It may be freed as soon as the
+  //! operations using it have been started.
+  MPI_Datatype values_type(int i_chunk) const
+  {
+    int n = std::min(chunk_size_, n_values_ - i_chunk * chunk_size_);
+    MPI_Datatype type;
+    MPI_Type_vector(n, 1, 3, MPI_DOUBLE, &type);
+    MPI_Type_commit(&type);
+    return type;
+  }
+
+  //! Start combining the values in a chunk on this node
+  void post(int i_chunk)
+  {
+    auto& request = requests_[i_chunk % 2];
+    if (mpi::n_procs_node > 1) {
+      double* values = this->results(i_chunk);
+      MPI_Datatype type = this->values_type(i_chunk);
+      if (mpi::node_rank == 0) {
+        MPI_Ireduce(MPI_IN_PLACE, values, 1, type, MPI_SUM, 0,
+          mpi::node_intracomm, &request);
       } else {
-        values_view = 0.0;
+        MPI_Ireduce(
+          values, nullptr, 1, type, MPI_SUM, 0, mpi::node_intracomm, &request);
       }
+      MPI_Type_free(&type);
+    } else {
+      request = MPI_REQUEST_NULL;
     }
   }
 
-  // Note that global tallies are *always* reduced even when no_reduce option is
-  // on.
+  //! Wait for the values in a chunk to be combined on this node and combine
+  //! them across nodes, resetting them on all processes but the master
+  void complete(int i_chunk)
+  {
+    MPI_Wait(&requests_[i_chunk % 2], MPI_STATUS_IGNORE);
 
-  // Get view of global tally values
-  auto& gt = simulation::global_tallies;
-  auto gt_values_view =
-    xt::view(gt, xt::all(), static_cast<int>(TallyResult::VALUE));
+    double* values = this->results(i_chunk);
+    if (n_nodes_ > 1) {
+      MPI_Datatype type = this->values_type(i_chunk);
+      MPI_Reduce(mpi::master ? MPI_IN_PLACE : values, values, 1, type, MPI_SUM,
+        0, mpi::leader_intracomm);
+      MPI_Type_free(&type);
+    }
 
-  // Make copy of values in contiguous array
-  xt::xtensor<double, 1> gt_values = gt_values_view;
-  xt::xtensor<double, 1> gt_values_reduced = xt::empty_like(gt_values);
+    if (!mpi::master) {
+      int n = std::min(chunk_size_, n_values_ - i_chunk * chunk_size_);
+      for (int k = 0; k < n; ++k) {
+        values[3 * k] = 0.0;
+      }
+    }
+  }
 
-  // Reduce contiguous data
-  MPI_Reduce(gt_values.data(), gt_values_reduced.data(), N_GLOBAL_TALLIES,
-    MPI_DOUBLE, MPI_SUM, 0, mpi::intracomm);
+  Tally& tally_;
+  size_t n_values_;   //!< Number of values to reduce
+  size_t chunk_size_; //!< Maximum number of values in a chunk
+  int n_chunks_;      //!< Number of chunks
+  int n_nodes_ {1};   //!< Number of nodes, only known on node leaders
+  MPI_Request requests_[2] {MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+};
 
-  // Transfer values on master and reset on other ranks
-  if (mpi::master) {
-    gt_values_view = gt_values_reduced;
-  } else {
-    gt_values_view = 0.0;
+void reduce_global_tallies()
+{
+  // Reduce the global tally values in place, strided by the number of results
+  auto& gt = simulation::global_tallies;
+  double* values = gt.data() + static_cast<int>(TallyResult::VALUE);
+  MPI_Datatype type;
+  MPI_Type_vector(N_GLOBAL_TALLIES, 1, 3, MPI_DOUBLE, &type);
+  MPI_Type_commit(&type);
+  mpi::reduce_sum(values, 1, type, false);
+  MPI_Type_free(&type);
+
+  // Reset values on other ranks
+  if (!mpi::master) {
+    xt::view(gt, xt::all(), static_cast<int>(TallyResult::VALUE)) = 0.0;
   }
 
   // We also need to determine the total starting weight of particles from the
   // last realization
-  double weight_reduced;
-  MPI_Reduce(&simulation::total_weight, &weight_reduced, 1, MPI_DOUBLE, MPI_SUM,
-    0, mpi::intracomm);
-  if (mpi::master)
-    simulation::total_weight = weight_reduced;
+  mpi::reduce_sum(&simulation::total_weight, 1, MPI_DOUBLE, false);
 }
 #endif
 
+//! Determine whether user tallies are reduced and accumulated in the current
+//! batch, which only happens every few batches if requested
+
+bool accumulate_user_tallies()
+{
+  // Results have to be up to date whenever they might be used. Outside of
+  // openmc_run(), they may be read through the C API between any two batches.
+  int n_active = simulation::current_batch - settings::n_inactive;
+  if (mpi::n_procs == 1 || !settings::reduce_tallies ||
+      !simulation::tally_results_deferrable || n_active <= 0 ||
+      simulation::current_batch >= settings::n_batches ||
+      contains(settings::statepoint_batch, simulation::current_batch) ||
+      is_trigger_batch() || settings::tally_stream)
+    return true;
+
+  // Weight windows are updated from the flux tally in some batches
+  for (const auto& generator : variance_reduction::generators) {
+    if (generator->method() == WeightWindowMethod::MAGIC &&
+        simulation::current_batch % generator->update_interval() == 0)
+      return true;
+  }
+  return n_active % settings::tally_reduce_interval == 0;
+}
+
 void accumulate_tallies()
 {
+  // The flux spectrum is normalized by the source weight of all active batches
+  if (model::flux_spectrum.active())
+    model::flux_spectrum.add_weight(simulation::total_weight);
+
+  // Combine scores from thread-private buffers
+  for (int i_tally : model::active_tallies) {
+    model::tallies[i_tally]->reduce_thread_results();
+  }
+
+  // Scores from batches in which user tallies are not reduced are kept and
+  // accumulated in the next realization
+  simulation::n_unreduced_batches += 1;
+  bool accumulate = accumulate_user_tallies();
+
 #ifdef OPENMC_MPI
-  // Combine tally results onto master process
+  // Start reducing the results of user tallies onto the master process so that
+  // the communication for later tallies overlaps with accumulating earlier
+  // ones. Global tallies are reduced unconditionally.
+  bool reduce = accumulate && mpi::n_procs > 1 && settings::reduce_tallies;
+  vector<TallyReduction> reductions;
+  if (reduce) {
+    reductions.reserve(model::active_tallies.size());
+    for (int i_tally : model::active_tallies) {
+      auto& tally {*model::tallies[i_tally]};
+      if (!tally.sparse_results_) {
+        reductions.emplace_back(tally);
+        reductions.back().start();
+      }
+    }
+  }
   if (mpi::n_procs > 1)
-    reduce_tally_results();
+    reduce_global_tallies();
 #endif
 
   // Increase number of realizations (only used for global tallies)
@@ -860,10 +1293,55 @@ void accumulate_tallies()
     }
   }
 
-  // Accumulate results for each tally
+  if (!accumulate)
+    return;
+
+  // Accumulate results for each tally as soon as its reduction is complete
+#ifdef OPENMC_MPI
+  auto reduction = reductions.begin();
+#endif
   for (int i_tally : model::active_tallies) {
     auto& tally {model::tallies[i_tally]};
-    tally->accumulate();
+#ifdef OPENMC_MPI
+    if (reduce) {
+      if (tally->sparse_results_) {
+        tally->sparse_results_->reduce();
+      } else {
+        (reduction++)->finish();
+      }
+    }
+#endif
+    tally->accumulate(simulation::n_unreduced_batches);
+  }
+  simulation::n_unreduced_batches = 0;
+  simulation::wielandt_weight_unreduced = 0.0;
+}
+
+//! Group tallies that have the same filters and nuclides, keeping the
+//! original order of the tallies within each group
+
+void group_tallies(const vector<int>& tallies, vector<vector<int>>& groups)
+{
+  groups.clear();
+  for (auto i_tally : tallies) {
+    const auto& tally {*model::tallies[i_tally]};
+
+    // Tallies are not grouped when the user has specified that they are
+    // spatially separate since only the first tally scored to is used
+    auto it = groups.end();
+    if (!settings::assume_separate) {
+      it = std::find_if(groups.begin(), groups.end(), [&](const auto& group) {
+        const auto& other {*model::tallies[group.front()]};
+        return other.filters() == tally.filters() &&
+               other.nuclides_ == tally.nuclides_;
+      });
+    }
+
+    if (it == groups.end()) {
+      groups.push_back({i_tally});
+    } else {
+      it->push_back(i_tally);
+    }
   }
 }
 
@@ -875,11 +1353,16 @@ void setup_active_tallies()
   model::active_collision_tallies.clear();
   model::active_meshsurf_tallies.clear();
   model::active_surface_tallies.clear();
+  model::active_pulse_height_tallies.clear();
 
   for (auto i = 0; i < model::tallies.size(); ++i) {
-    const auto& tally {*model::tallies[i]};
+    auto& tally {*model::tallies[i]};
 
     if (tally.active_) {
+      // Filter bins may have changed since the filters were set
+      tally.set_filter_plan();
+      tally.init_depletion_rates();
+
       model::active_tallies.push_back(i);
       switch (tally.type_) {
 
@@ -902,6 +1385,53 @@ void setup_active_tallies()
 
       case TallyType::SURFACE:
         model::active_surface_tallies.push_back(i);
+        break;
+
+      case TallyType::PULSE_HEIGHT:
+        model::active_pulse_height_tallies.push_back(i);
+      }
+    }
+  }
+
+  // Flag the cells whose energy deposits are needed by pulse-height tallies
+  model::pulse_height_cells.clear();
+  if (!model::active_pulse_height_tallies.empty()) {
+    model::pulse_height_cells.resize(model::cells.size(), false);
+    for (auto i_tally : model::active_pulse_height_tallies) {
+      for (auto i_filt : model::tallies[i_tally]->filters()) {
+        const auto* filt =
+          dynamic_cast<const CellFilter*>(model::tally_filters[i_filt].get());
+        if (filt) {
+          for (auto i_cell : filt->cells())
+            model::pulse_height_cells[i_cell] = true;
+        }
+      }
+    }
+  }
+
+  group_tallies(
+    model::active_tracklength_tallies, model::active_tracklength_groups);
+  group_tallies(
+    model::active_collision_tallies, model::active_collision_groups);
+
+  // Mesh filters of the same type on the same mesh, such as those created
+  // separately for CMFD and weight window tallies, match the same bins, so
+  // only the first of them needs to trace the particle through the mesh
+  auto n = model::tally_filters.size();
+  model::filter_shared_match.assign(n, C_NONE);
+  for (int i = 0; i < n; ++i) {
+    const auto* a =
+      dynamic_cast<const MeshFilter*>(model::tally_filters[i].get());
+    if (!a)
+      continue;
+    for (int j = 0; j < i; ++j) {
+      const auto* b =
+        dynamic_cast<const MeshFilter*>(model::tally_filters[j].get());
+      if (b && b->type() == a->type() && b->mesh() == a->mesh() &&
+          b->translated() == a->translated() &&
+          b->translation() == a->translation()) {
+        model::filter_shared_match[i] = j;
+        break;
       }
     }
   }
@@ -914,6 +1444,7 @@ void free_memory_tally()
 
   model::tally_filters.clear();
   model::filter_map.clear();
+  model::filter_shared_match.clear();
 
   model::tallies.clear();
 
@@ -923,8 +1454,14 @@ void free_memory_tally()
   model::active_collision_tallies.clear();
   model::active_meshsurf_tallies.clear();
   model::active_surface_tallies.clear();
+  model::active_pulse_height_tallies.clear();
+  model::pulse_height_cells.clear();
+  model::active_tracklength_groups.clear();
+  model::active_collision_groups.clear();
 
   model::tally_map.clear();
+
+  model::flux_spectrum.clear();
 }
 
 //==============================================================================
@@ -986,6 +1523,7 @@ extern "C" int openmc_tally_set_estimator(int32_t index, const char* estimator)
   auto& t {model::tallies[index]};
 
   std::string est = estimator;
+  t->estimator_specified_ = true;
   if (est == "analog") {
     t->estimator_ = TallyEstimator::ANALOG;
   } else if (est == "collision") {
@@ -1044,6 +1582,8 @@ extern "C" int openmc_tally_set_type(int32_t index, const char* type)
     model::tallies[index]->type_ = TallyType::MESH_SURFACE;
   } else if (strcmp(type, "surface") == 0) {
     model::tallies[index]->type_ = TallyType::SURFACE;
+  } else if (strcmp(type, "pulse-height") == 0) {
+    model::tallies[index]->type_ = TallyType::PULSE_HEIGHT;
   } else {
     set_errmsg(fmt::format("Unknown tally type: {}", type));
     return OPENMC_E_INVALID_ARGUMENT;
@@ -1246,6 +1786,11 @@ extern "C" int openmc_tally_results(
   }
 
   const auto& t {model::tallies[index]};
+  if (t->sparse_results_) {
+    set_errmsg("Tally results are stored sparsely and cannot be accessed as "
+               "a dense array.");
+    return OPENMC_E_INVALID_TYPE;
+  }
   if (t->results_.size() == 0) {
     set_errmsg("Tally results have not been allocated yet.");
     return OPENMC_E_ALLOCATE;
@@ -1260,6 +1805,82 @@ extern "C" int openmc_tally_results(
   return 0;
 }
 
+//! \brief Returns a pointer to the results of one nuclide and score of a tally
+//! along with the shape and strides (in elements) of the slice, so that it can
+//! be read without copying it out of the results array.
+extern "C" int openmc_tally_results_slice(int32_t index, int i_nuclide,
+  int i_score, double** results, size_t* shape, size_t* strides)
+{
+  size_t s[3];
+  int err = openmc_tally_results(index, results, s);
+  if (err)
+    return err;
+
+  const auto& t {*model::tallies[index]};
+  if (i_nuclide < 0 || i_nuclide >= t.nuclides_.size() || i_score < 0 ||
+      i_score >= t.scores_.size()) {
+    set_errmsg("Nuclide or score index of tally is out of bounds.");
+    return OPENMC_E_OUT_OF_BOUNDS;
+  }
+
+  // Results of each filter bin are separated by all of its score bins
+  *results += (i_nuclide * t.scores_.size() + i_score) * s[2];
+  shape[0] = s[0];
+  shape[1] = s[2];
+  strides[0] = s[1] * s[2];
+  strides[1] = 1;
+  return 0;
+}
+
+//! \brief Computes the mean and standard deviation of the mean of tally
+//! results into buffers provided by the caller, either for one nuclide and
+//! score or for all of them.
+extern "C" int openmc_tally_mean_std_dev(int32_t index, int i_nuclide,
+  int i_score, double* mean, double* std_dev)
+{
+  if (index < 0 || index >= model::tallies.size()) {
+    set_errmsg("Index in tallies array is out of bounds.");
+    return OPENMC_E_OUT_OF_BOUNDS;
+  }
+
+  const auto& t {*model::tallies[index]};
+  if (!t.sparse_results_ && t.results_.size() == 0) {
+    set_errmsg("Tally results have not been allocated yet.");
+    return OPENMC_E_ALLOCATE;
+  }
+
+  // Determine which score bins to compute, all of them by default
+  int n_scores = t.scores_.size();
+  int first = 0;
+  int n_bins = n_scores * t.nuclides_.size();
+  if (i_nuclide >= 0) {
+    if (i_nuclide >= t.nuclides_.size() || i_score < 0 ||
+        i_score >= n_scores) {
+      set_errmsg("Nuclide or score index of tally is out of bounds.");
+      return OPENMC_E_OUT_OF_BOUNDS;
+    }
+    first = i_nuclide * n_scores + i_score;
+    n_bins = 1;
+  }
+
+  int n = t.n_realizations_;
+  for (int i = 0; i < t.n_filter_bins(); ++i) {
+    for (int j = 0; j < n_bins; ++j) {
+      double sum = t.result(i, first + j, TallyResult::SUM);
+      double m = n > 0 ? sum / n : sum;
+      if (mean)
+        mean[i * n_bins + j] = m;
+      if (std_dev) {
+        double sum_sq = t.result(i, first + j, TallyResult::SUM_SQ);
+        std_dev[i * n_bins + j] =
+          (n > 1 && m != 0.0) ? std::sqrt((sum_sq / n - m * m) / (n - 1))
+                              : std::numeric_limits<double>::infinity();
+      }
+    }
+  }
+  return 0;
+}
+
 extern "C" int openmc_global_tallies(double** ptr)
 {
   *ptr = simulation::global_tallies.data();
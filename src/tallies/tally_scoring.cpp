@@ -4,10 +4,12 @@
 #include "openmc/capi.h"
 #include "openmc/constants.h"
 #include "openmc/error.h"
+#include "openmc/ifp.h"
 #include "openmc/material.h"
 #include "openmc/mgxs_interface.h"
 #include "openmc/nuclide.h"
 #include "openmc/photon.h"
+#include "openmc/profile.h"
 #include "openmc/reaction_product.h"
 #include "openmc/search.h"
 #include "openmc/settings.h"
@@ -15,13 +17,26 @@
 #include "openmc/string_utils.h"
 #include "openmc/tallies/derivative.h"
 #include "openmc/tallies/filter.h"
+#include "openmc/tallies/filter_cell.h"
 #include "openmc/tallies/filter_delayedgroup.h"
 #include "openmc/tallies/filter_energy.h"
 
+#include <algorithm> // for copy
 #include <string>
 
 namespace openmc {
 
+//==============================================================================
+//! Check the type and energy of a particle against those that can contribute
+//! to a tally, before finding any filter bins
+//==============================================================================
+
+inline bool tally_may_score(const Tally& tally, const Particle& p)
+{
+  return ((tally.particle_mask_ >> static_cast<int>(p.type())) & 1u) &&
+         p.E_last() >= tally.energy_min_ && p.E_last() <= tally.energy_max_;
+}
+
 //==============================================================================
 // FilterBinIter implementation
 //==============================================================================
@@ -30,14 +45,43 @@ FilterBinIter::FilterBinIter(const Tally& tally, Particle& p)
   : filter_matches_ {p.filter_matches()}, tally_ {tally}
 {
   // Find all valid bins in each relevant filter if they have not already been
-  // found for this event.
-  for (auto i_filt : tally_.filters()) {
+  // found for this event. Filters are checked in the tally's evaluation order
+  // so that the search stops early at a cheap filter with no valid bins.
+  for (auto i_filt : tally_.filter_order()) {
     auto& match {filter_matches_[i_filt]};
+
+    // Bins of geometric filters found during an earlier event can be reused
+    // as long as the particle has not changed cells since then
+    if (match.geometry_state_ >= 0 &&
+        match.geometry_state_ != p.geometry_state())
+      match.bins_present_ = false;
+
     if (!match.bins_present_) {
-      match.bins_.clear();
-      match.weights_.clear();
-      model::tally_filters[i_filt]->get_all_bins(p, tally_.estimator_, match);
+      const auto& filt {*model::tally_filters[i_filt]};
+      int32_t i_shared = i_filt < model::filter_shared_match.size()
+                           ? model::filter_shared_match[i_filt]
+                           : C_NONE;
+      if (i_shared != C_NONE) {
+        // Copy the bins of an equivalent filter, finding them first if no
+        // tally has needed them yet during this event
+        auto& shared {filter_matches_[i_shared]};
+        if (!shared.bins_present_) {
+          shared.bins_.clear();
+          shared.weights_.clear();
+          model::tally_filters[i_shared]->get_all_bins(
+            p, tally_.estimator_, shared);
+          shared.bins_present_ = true;
+          shared.geometry_state_ = -1;
+        }
+        match.bins_ = shared.bins_;
+        match.weights_ = shared.weights_;
+      } else {
+        match.bins_.clear();
+        match.weights_.clear();
+        filt.get_all_bins(p, tally_.estimator_, match);
+      }
       match.bins_present_ = true;
+      match.geometry_state_ = filt.geometric() ? p.geometry_state() : -1;
     }
 
     // If there are no valid bins for this filter, then there are no valid
@@ -75,6 +119,7 @@ FilterBinIter::FilterBinIter(
         match.weights_.push_back(1.0);
       }
       match.bins_present_ = true;
+      match.geometry_state_ = -1;
     }
 
     if (match.bins_.size() == 0) {
@@ -164,15 +209,26 @@ void score_fission_delayed_dg(int i_tally, int d_bin, double score,
     filter_weight *= match.weights_[i_bin];
   }
 
-// Update the tally result
-#pragma omp atomic
-  tally.results_(filter_index, score_index, TallyResult::VALUE) +=
-    score * filter_weight;
+  // Update the tally result
+  tally.add_score(filter_index, score_index, score * filter_weight);
 
   // Reset the original delayed group bin
   dg_match.bins_[i_bin] = original_bin;
 }
 
+//! Helper function to evaluate the total, prompt, or delayed neutron yield of a
+//! nuclide, reusing the value cached with its microscopic cross sections
+
+double nuclide_nu(
+  Particle& p, int i_nuclide, double E, ReactionProduct::EmissionMode mode)
+{
+  // Yields only matter where there is fission, and a nuclide that isn't in the
+  // current material shouldn't be added to a compact cross section cache
+  if (static_cast<const Particle&>(p).neutron_xs(i_nuclide).fission == 0.0)
+    return 0.0;
+  return data::nuclides[i_nuclide]->nu(E, mode, p.neutron_xs(i_nuclide));
+}
+
 //! Helper function to retrieve fission q value from a nuclide
 
 double get_nuc_fission_q(const Nuclide& nuc, const Particle& p, int score_bin)
@@ -381,11 +437,10 @@ void score_fission_eout(Particle& p, int i_tally, int i_score, int score_bin)
       }
 
       // Set EnergyoutFilter bin index
-      if (E_out < eo_filt.bins().front() || E_out > eo_filt.bins().back()) {
+      int i_match = eo_filt.search(E_out);
+      if (i_match < 0) {
         continue;
       } else {
-        auto i_match = lower_bound_index(
-          eo_filt.bins().begin(), eo_filt.bins().end(), E_out);
         p.filter_matches(i_eout_filt).bins_[i_bin] = i_match;
       }
     }
@@ -405,10 +460,8 @@ void score_fission_eout(Particle& p, int i_tally, int i_score, int score_bin)
         filter_weight *= match.weights_[i_bin];
       }
 
-// Update tally results
-#pragma omp atomic
-      tally.results_(filter_index, i_score, TallyResult::VALUE) +=
-        score * filter_weight;
+      // Update tally results
+      tally.add_score(filter_index, i_score, score * filter_weight);
 
     } else if (score_bin == SCORE_DELAYED_NU_FISSION && g != 0) {
 
@@ -453,10 +506,8 @@ void score_fission_eout(Particle& p, int i_tally, int i_score, int score_bin)
           filter_weight *= match.weights_[i_bin];
         }
 
-// Update tally results
-#pragma omp atomic
-        tally.results_(filter_index, i_score, TallyResult::VALUE) +=
-          score * filter_weight;
+        // Update tally results
+        tally.add_score(filter_index, i_score, score * filter_weight);
       }
     }
   }
@@ -520,6 +571,231 @@ double get_nuclide_xs(const Particle& p, int i_nuclide, int score_bin)
   return 0.0;
 }
 
+//==============================================================================
+// Score kernels for tracklength and collision estimators
+//==============================================================================
+
+bool score_kernel_flux(
+  Particle& p, int i_nuclide, double atom_density, double flux, double& score)
+{
+  score = flux;
+  return true;
+}
+
+bool score_kernel_total(
+  Particle& p, int i_nuclide, double atom_density, double flux, double& score)
+{
+  if (i_nuclide >= 0) {
+    if (p.type() == ParticleType::neutron) {
+      score = p.neutron_xs(i_nuclide).total * atom_density * flux;
+    } else if (p.type() == ParticleType::photon) {
+      score = p.photon_xs(i_nuclide).total * atom_density * flux;
+    }
+  } else {
+    score = p.macro_xs().total * flux;
+  }
+  return true;
+}
+
+bool score_kernel_inverse_velocity(
+  Particle& p, int i_nuclide, double atom_density, double flux, double& score)
+{
+  if (p.type() != ParticleType::neutron)
+    return false;
+
+  // Score inverse velocity in units of s/cm.
+  score = flux / p.speed();
+  return true;
+}
+
+bool score_kernel_scatter(
+  Particle& p, int i_nuclide, double atom_density, double flux, double& score)
+{
+  if (p.type() == ParticleType::neutron) {
+    if (i_nuclide >= 0) {
+      const auto& micro = p.neutron_xs(i_nuclide);
+      score = (micro.total - micro.absorption) * atom_density * flux;
+    } else {
+      score = (p.macro_xs().total - p.macro_xs().absorption) * flux;
+    }
+  } else if (p.type() == ParticleType::photon) {
+    if (i_nuclide >= 0) {
+      const auto& micro = p.photon_xs(i_nuclide);
+      score = (micro.coherent + micro.incoherent) * atom_density * flux;
+    } else {
+      score = (p.macro_xs().coherent + p.macro_xs().incoherent) * flux;
+    }
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool score_kernel_absorption(
+  Particle& p, int i_nuclide, double atom_density, double flux, double& score)
+{
+  if (p.type() == ParticleType::neutron) {
+    if (i_nuclide >= 0) {
+      score = p.neutron_xs(i_nuclide).absorption * atom_density * flux;
+    } else {
+      score = p.macro_xs().absorption * flux;
+    }
+  } else if (p.type() == ParticleType::photon) {
+    if (i_nuclide >= 0) {
+      const auto& xs = p.photon_xs(i_nuclide);
+      score = (xs.total - xs.coherent - xs.incoherent) * atom_density * flux;
+    } else {
+      score =
+        (p.macro_xs().photoelectric + p.macro_xs().pair_production) * flux;
+    }
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool score_kernel_fission(
+  Particle& p, int i_nuclide, double atom_density, double flux, double& score)
+{
+  if (p.macro_xs().fission == 0)
+    return false;
+
+  if (i_nuclide >= 0) {
+    score = p.neutron_xs(i_nuclide).fission * atom_density * flux;
+  } else {
+    score = p.macro_xs().fission * flux;
+  }
+  return true;
+}
+
+bool score_kernel_nu_fission(
+  Particle& p, int i_nuclide, double atom_density, double flux, double& score)
+{
+  if (p.macro_xs().fission == 0)
+    return false;
+
+  if (i_nuclide >= 0) {
+    score = p.neutron_xs(i_nuclide).nu_fission * atom_density * flux;
+  } else {
+    score = p.macro_xs().nu_fission * flux;
+  }
+  return true;
+}
+
+bool score_kernel_elastic(
+  Particle& p, int i_nuclide, double atom_density, double flux, double& score)
+{
+  if (p.type() != ParticleType::neutron)
+    return false;
+
+  if (i_nuclide >= 0) {
+    if (p.neutron_xs(i_nuclide).elastic == CACHE_INVALID)
+      data::nuclides[i_nuclide]->calculate_elastic_xs(p);
+    score = p.neutron_xs(i_nuclide).elastic * atom_density * flux;
+  } else {
+    score = 0.;
+    if (p.material() != MATERIAL_VOID) {
+      const Material& material {*model::materials[p.material()]};
+      for (auto i = 0; i < material.nuclide_.size(); ++i) {
+        auto j_nuclide = material.nuclide_[i];
+        auto atom_density = material.atom_density_(i);
+        if (p.neutron_xs(j_nuclide).elastic == CACHE_INVALID)
+          data::nuclides[j_nuclide]->calculate_elastic_xs(p);
+        score += p.neutron_xs(j_nuclide).elastic * atom_density * flux;
+      }
+    }
+  }
+  return true;
+}
+
+//! Kernel for a photon interaction cross section, given the members of the
+//! microscopic and macroscopic cross sections that hold it
+template<double ElementMicroXS::*MICRO, double MacroXS::*MACRO>
+bool score_kernel_photon(
+  Particle& p, int i_nuclide, double atom_density, double flux, double& score)
+{
+  if (p.type() != ParticleType::photon)
+    return false;
+
+  if (i_nuclide >= 0) {
+    score = p.photon_xs(i_nuclide).*MICRO * atom_density * flux;
+  } else {
+    score = p.macro_xs().*MACRO * flux;
+  }
+  return true;
+}
+
+ScoreKernel get_score_kernel(int score_bin)
+{
+  switch (score_bin) {
+  case SCORE_FLUX:
+    return score_kernel_flux;
+  case SCORE_TOTAL:
+    return score_kernel_total;
+  case SCORE_INVERSE_VELOCITY:
+    return score_kernel_inverse_velocity;
+  case SCORE_SCATTER:
+    return score_kernel_scatter;
+  case SCORE_ABSORPTION:
+    return score_kernel_absorption;
+  case SCORE_FISSION:
+    return score_kernel_fission;
+  case SCORE_NU_FISSION:
+    return score_kernel_nu_fission;
+  case ELASTIC:
+    return score_kernel_elastic;
+  case COHERENT:
+    return score_kernel_photon<&ElementMicroXS::coherent, &MacroXS::coherent>;
+  case INCOHERENT:
+    return score_kernel_photon<&ElementMicroXS::incoherent,
+      &MacroXS::incoherent>;
+  case PHOTOELECTRIC:
+    return score_kernel_photon<&ElementMicroXS::photoelectric,
+      &MacroXS::photoelectric>;
+  case PAIR_PROD:
+    return score_kernel_photon<&ElementMicroXS::pair_production,
+      &MacroXS::pair_production>;
+  default:
+    return nullptr;
+  }
+}
+
+//! Update the results of a depletion rate tally for all of its nuclides and
+//! reactions at once from the precalculated microscopic cross sections.
+
+void score_depletion_rates(
+  Particle& p, int i_tally, int filter_index, double filter_weight, double flux)
+{
+  if (p.type() != ParticleType::neutron || p.material() == MATERIAL_VOID)
+    return;
+
+  Tally& tally {*model::tallies[i_tally]};
+  const Material& material {*model::materials[p.material()]};
+  int n_scores = tally.scores_.size();
+  int n = tally.nuclides_.size() * n_scores;
+
+  static thread_local vector<double> block;
+  block.assign(n, 0.0);
+  for (int i = 0; i < tally.nuclides_.size(); ++i) {
+    auto i_nuclide = tally.nuclides_[i];
+    auto j = material.mat_nuclide_index_[i_nuclide];
+    if (j == C_NONE)
+      continue;
+
+    // Reaction cross sections followed by fission
+    const auto& micro {p.neutron_xs(i_nuclide)};
+    double xs[DEPLETION_RX.size() + 1];
+    std::copy(micro.reaction, micro.reaction + DEPLETION_RX.size(), xs);
+    xs[DEPLETION_RX.size()] = micro.fission;
+
+    double factor = material.atom_density_(j) * flux * filter_weight;
+    double* row = block.data() + i * n_scores;
+    for (int k = 0; k < n_scores; ++k)
+      row[k] = xs[tally.depletion_rx_[k]] * factor;
+  }
+  tally.add_scores(filter_index, 0, block.data(), n);
+}
+
 //! Update tally results for continuous-energy tallies with a tracklength or
 //! collision estimator.
 
@@ -539,103 +815,27 @@ void score_general_ce_nonanalog(Particle& p, int i_tally, int start_index,
     auto score_index = start_index + i;
     double score = 0.0;
 
-    switch (score_bin) {
-    case SCORE_FLUX:
-      score = flux;
-      break;
-
-    case SCORE_TOTAL:
-      if (i_nuclide >= 0) {
-        if (p.type() == Type::neutron) {
-          score = p.neutron_xs(i_nuclide).total * atom_density * flux;
-        } else if (p.type() == Type::photon) {
-          score = p.photon_xs(i_nuclide).total * atom_density * flux;
-        }
-      } else {
-        score = p.macro_xs().total * flux;
-      }
-      break;
-
-    case SCORE_INVERSE_VELOCITY:
-      if (p.type() != Type::neutron)
-        continue;
-
-      // Score inverse velocity in units of s/cm.
-      score = flux / p.speed();
-      break;
-
-    case SCORE_SCATTER:
-      if (p.type() != Type::neutron && p.type() != Type::photon)
+    // Most common scores are computed by a kernel chosen when the scores were
+    // set rather than by going through the switch below
+    if (auto kernel = tally.score_kernels_[i]) {
+      if (!kernel(p, i_nuclide, atom_density, flux, score))
         continue;
 
-      if (i_nuclide >= 0) {
-        if (p.type() == Type::neutron) {
-          const auto& micro = p.neutron_xs(i_nuclide);
-          score = (micro.total - micro.absorption) * atom_density * flux;
-        } else {
-          const auto& micro = p.photon_xs(i_nuclide);
-          score = (micro.coherent + micro.incoherent) * atom_density * flux;
-        }
-      } else {
-        if (p.type() == Type::neutron) {
-          score = (p.macro_xs().total - p.macro_xs().absorption) * flux;
-        } else {
-          score = (p.macro_xs().coherent + p.macro_xs().incoherent) * flux;
-        }
-      }
-      break;
-
-    case SCORE_ABSORPTION:
-      if (p.type() != Type::neutron && p.type() != Type::photon)
-        continue;
-
-      if (i_nuclide >= 0) {
-        if (p.type() == Type::neutron) {
-          score = p.neutron_xs(i_nuclide).absorption * atom_density * flux;
-        } else {
-          const auto& xs = p.photon_xs(i_nuclide);
-          score =
-            (xs.total - xs.coherent - xs.incoherent) * atom_density * flux;
-        }
-      } else {
-        if (p.type() == Type::neutron) {
-          score = p.macro_xs().absorption * flux;
-        } else {
-          score =
-            (p.macro_xs().photoelectric + p.macro_xs().pair_production) * flux;
-        }
-      }
-      break;
-
-    case SCORE_FISSION:
-      if (p.macro_xs().fission == 0)
-        continue;
-
-      if (i_nuclide >= 0) {
-        score = p.neutron_xs(i_nuclide).fission * atom_density * flux;
-      } else {
-        score = p.macro_xs().fission * flux;
-      }
-      break;
-
-    case SCORE_NU_FISSION:
-      if (p.macro_xs().fission == 0)
-        continue;
-
-      if (i_nuclide >= 0) {
-        score = p.neutron_xs(i_nuclide).nu_fission * atom_density * flux;
-      } else {
-        score = p.macro_xs().nu_fission * flux;
-      }
-      break;
+      if (tally.deriv_ != C_NONE)
+        apply_derivative_to_score(
+          p, i_tally, i_nuclide, atom_density, score_bin, score);
+      tally.add_score(filter_index, score_index, score * filter_weight);
+      continue;
+    }
 
+    switch (score_bin) {
     case SCORE_PROMPT_NU_FISSION:
       if (p.macro_xs().fission == 0)
         continue;
       if (i_nuclide >= 0) {
         score = p.neutron_xs(i_nuclide).fission *
-                data::nuclides[i_nuclide]->nu(
-                  E, ReactionProduct::EmissionMode::prompt) *
+                nuclide_nu(
+                  p, i_nuclide, E, ReactionProduct::EmissionMode::prompt) *
                 atom_density * flux;
       } else {
         score = 0.;
@@ -646,8 +846,8 @@ void score_general_ce_nonanalog(Particle& p, int i_tally, int start_index,
             auto j_nuclide = material.nuclide_[i];
             auto atom_density = material.atom_density_(i);
             score += p.neutron_xs(j_nuclide).fission *
-                     data::nuclides[j_nuclide]->nu(
-                       E, ReactionProduct::EmissionMode::prompt) *
+                     nuclide_nu(
+                       p, j_nuclide, E, ReactionProduct::EmissionMode::prompt) *
                      atom_density * flux;
           }
         }
@@ -677,8 +877,8 @@ void score_general_ce_nonanalog(Particle& p, int i_tally, int start_index,
           // If the delayed group filter is not present, compute the score
           // by multiplying the delayed-nu-fission macro xs by the flux
           score = p.neutron_xs(i_nuclide).fission *
-                  data::nuclides[i_nuclide]->nu(
-                    E, ReactionProduct::EmissionMode::delayed) *
+                  nuclide_nu(
+                    p, i_nuclide, E, ReactionProduct::EmissionMode::delayed) *
                   atom_density * flux;
         }
       } else {
@@ -713,8 +913,8 @@ void score_general_ce_nonanalog(Particle& p, int i_tally, int start_index,
               auto j_nuclide = material.nuclide_[i];
               auto atom_density = material.atom_density_(i);
               score += p.neutron_xs(j_nuclide).fission *
-                       data::nuclides[j_nuclide]->nu(
-                         E, ReactionProduct::EmissionMode::delayed) *
+                       nuclide_nu(p, j_nuclide, E,
+                         ReactionProduct::EmissionMode::delayed) *
                        atom_density * flux;
             }
           }
@@ -853,34 +1053,10 @@ void score_general_ce_nonanalog(Particle& p, int i_tally, int start_index,
       break;
 
     case SCORE_EVENTS:
-// Simply count the number of scoring events
-#pragma omp atomic
-      tally.results_(filter_index, score_index, TallyResult::VALUE) += 1.0;
+      // Simply count the number of scoring events
+      tally.add_score(filter_index, score_index, 1.0);
       continue;
 
-    case ELASTIC:
-      if (p.type() != Type::neutron)
-        continue;
-
-      if (i_nuclide >= 0) {
-        if (p.neutron_xs(i_nuclide).elastic == CACHE_INVALID)
-          data::nuclides[i_nuclide]->calculate_elastic_xs(p);
-        score = p.neutron_xs(i_nuclide).elastic * atom_density * flux;
-      } else {
-        score = 0.;
-        if (p.material() != MATERIAL_VOID) {
-          const Material& material {*model::materials[p.material()]};
-          for (auto i = 0; i < material.nuclide_.size(); ++i) {
-            auto j_nuclide = material.nuclide_[i];
-            auto atom_density = material.atom_density_(i);
-            if (p.neutron_xs(j_nuclide).elastic == CACHE_INVALID)
-              data::nuclides[j_nuclide]->calculate_elastic_xs(p);
-            score += p.neutron_xs(j_nuclide).elastic * atom_density * flux;
-          }
-        }
-      }
-      break;
-
     case SCORE_FISS_Q_PROMPT:
     case SCORE_FISS_Q_RECOV:
       if (p.macro_xs().fission == 0.)
@@ -930,34 +1106,6 @@ void score_general_ce_nonanalog(Particle& p, int i_tally, int start_index,
       }
       break;
 
-    case COHERENT:
-    case INCOHERENT:
-    case PHOTOELECTRIC:
-    case PAIR_PROD:
-      if (p.type() != Type::photon)
-        continue;
-
-      if (i_nuclide >= 0) {
-        const auto& micro = p.photon_xs(i_nuclide);
-        double xs = (score_bin == COHERENT)
-                      ? micro.coherent
-                      : (score_bin == INCOHERENT) ? micro.incoherent
-                                                  : (score_bin == PHOTOELECTRIC)
-                                                      ? micro.photoelectric
-                                                      : micro.pair_production;
-        score = xs * atom_density * flux;
-      } else {
-        double xs = (score_bin == COHERENT)
-                      ? p.macro_xs().coherent
-                      : (score_bin == INCOHERENT)
-                          ? p.macro_xs().incoherent
-                          : (score_bin == PHOTOELECTRIC)
-                              ? p.macro_xs().photoelectric
-                              : p.macro_xs().pair_production;
-        score = xs * flux;
-      }
-      break;
-
     case HEATING:
       if (p.type() == Type::neutron) {
         score = score_neutron_heating(
@@ -1013,10 +1161,8 @@ void score_general_ce_nonanalog(Particle& p, int i_tally, int start_index,
       apply_derivative_to_score(
         p, i_tally, i_nuclide, atom_density, score_bin, score);
 
-// Update tally results
-#pragma omp atomic
-    tally.results_(filter_index, score_index, TallyResult::VALUE) +=
-      score * filter_weight;
+    // Update tally results
+    tally.add_score(filter_index, score_index, score * filter_weight);
   }
 }
 
@@ -1206,8 +1352,8 @@ void score_general_ce_analog(Particle& p, int i_tally, int start_index,
         // prompt-nu-fission
         if (p.neutron_xs(p.event_nuclide()).total > 0) {
           score = p.wgt_last() * p.neutron_xs(p.event_nuclide()).fission *
-                  data::nuclides[p.event_nuclide()]->nu(
-                    E, ReactionProduct::EmissionMode::prompt) /
+                  nuclide_nu(p, p.event_nuclide(), E,
+                    ReactionProduct::EmissionMode::prompt) /
                   p.neutron_xs(p.event_nuclide()).total * flux;
         } else {
           score = 0.;
@@ -1266,8 +1412,8 @@ void score_general_ce_analog(Particle& p, int i_tally, int start_index,
             // by multiplying the absorbed weight by the fraction of the
             // delayed-nu-fission xs to the absorption xs
             score = p.wgt_last() * p.neutron_xs(p.event_nuclide()).fission *
-                    data::nuclides[p.event_nuclide()]->nu(
-                      E, ReactionProduct::EmissionMode::delayed) /
+                    nuclide_nu(p, p.event_nuclide(), E,
+                      ReactionProduct::EmissionMode::delayed) /
                     p.neutron_xs(p.event_nuclide()).total * flux;
           }
         }
@@ -1430,11 +1576,16 @@ void score_general_ce_analog(Particle& p, int i_tally, int start_index,
       break;
 
     case SCORE_EVENTS:
-// Simply count the number of scoring events
-#pragma omp atomic
-      tally.results_(filter_index, score_index, TallyResult::VALUE) += 1.0;
+      // Simply count the number of scoring events
+      tally.add_score(filter_index, score_index, 1.0);
       continue;
 
+    case SCORE_IFP_TIME_NUM:
+    case SCORE_IFP_BETA_NUM:
+    case SCORE_IFP_DENOM:
+      score = score_ifp(p, score_bin) * flux;
+      break;
+
     case ELASTIC:
       if (p.type() != Type::neutron)
         continue;
@@ -1535,10 +1686,8 @@ void score_general_ce_analog(Particle& p, int i_tally, int start_index,
       apply_derivative_to_score(
         p, i_tally, i_nuclide, atom_density, score_bin, score);
 
-// Update tally results
-#pragma omp atomic
-    tally.results_(filter_index, score_index, TallyResult::VALUE) +=
-      score * filter_weight;
+    // Update tally results
+    tally.add_score(filter_index, score_index, score * filter_weight);
   }
 }
 
@@ -1594,8 +1743,8 @@ void score_general_mg(Particle& p, int i_tally, int start_index,
 
   // For shorthand, assign pointers to the material and nuclide xs set
   auto& nuc_xs = (i_nuclide >= 0) ? data::mg.nuclides_[i_nuclide]
-                                  : data::mg.macro_xs_[p.material()];
-  auto& macro_xs = data::mg.macro_xs_[p.material()];
+                                  : data::mg.macro_xs(p.material());
+  auto& macro_xs = data::mg.macro_xs(p.material());
 
   // Find the temperature and angle indices of interest
   macro_xs.set_angle_index(p_u);
@@ -2186,24 +2335,41 @@ void score_general_mg(Particle& p, int i_tally, int start_index,
       break;
 
     case SCORE_EVENTS:
-// Simply count the number of scoring events
-#pragma omp atomic
-      tally.results_(filter_index, score_index, TallyResult::VALUE) += 1.0;
+      // Simply count the number of scoring events
+      tally.add_score(filter_index, score_index, 1.0);
       continue;
 
+    case SCORE_IFP_TIME_NUM:
+    case SCORE_IFP_BETA_NUM:
+    case SCORE_IFP_DENOM:
+      score = score_ifp(p, score_bin) * flux;
+      break;
+
     default:
       continue;
     }
 
-// Update tally results
-#pragma omp atomic
-    tally.results_(filter_index, score_index, TallyResult::VALUE) +=
-      score * filter_weight;
+    // Update tally results
+    tally.add_score(filter_index, score_index, score * filter_weight);
+  }
+}
+
+//! Helper function used to reset the filter matches for the next tally event.
+//! Matches for geometric filters are kept since their bins remain valid until
+//! the particle's cell is searched for again.
+
+void reset_filter_matches(Particle& p)
+{
+  for (auto& match : p.filter_matches()) {
+    if (match.geometry_state_ < 0)
+      match.bins_present_ = false;
   }
 }
 
 void score_analog_tally_ce(Particle& p)
 {
+  ProfileScope profile(ProfileRegion::TALLY);
+
   // Since electrons/positrons are not transported, we assign a flux of zero.
   // Note that the heating score does NOT use the flux and will be non-zero for
   // electrons/positrons.
@@ -2213,8 +2379,14 @@ void score_analog_tally_ce(Particle& p)
       : 0.0;
 
   for (auto i_tally : model::active_analog_tallies) {
+    DomainScope profile_tally(ProfileDomain::TALLY, i_tally);
+    count_event(TransportEvent::TALLY_SCORE);
     const Tally& tally {*model::tallies[i_tally]};
 
+    // Skip tallies that cannot match the particle type or energy
+    if (!tally_may_score(tally, p))
+      continue;
+
     // Initialize an iterator over valid filter bin combinations.  If there are
     // no valid combinations, use a continue statement to ensure we skip the
     // assume_separate break below.
@@ -2249,16 +2421,22 @@ void score_analog_tally_ce(Particle& p)
       break;
   }
 
-  // Reset all the filter matches for the next tally event.
-  for (auto& match : p.filter_matches())
-    match.bins_present_ = false;
+  reset_filter_matches(p);
 }
 
 void score_analog_tally_mg(Particle& p)
 {
+  ProfileScope profile(ProfileRegion::TALLY);
+
   for (auto i_tally : model::active_analog_tallies) {
+    DomainScope profile_tally(ProfileDomain::TALLY, i_tally);
+    count_event(TransportEvent::TALLY_SCORE);
     const Tally& tally {*model::tallies[i_tally]};
 
+    // Skip tallies that cannot match the particle type or energy
+    if (!tally_may_score(tally, p))
+      continue;
+
     // Initialize an iterator over valid filter bin combinations.  If there are
     // no valid combinations, use a continue statement to ensure we skip the
     // assume_separate break below.
@@ -2298,18 +2476,28 @@ void score_analog_tally_mg(Particle& p)
       break;
   }
 
-  // Reset all the filter matches for the next tally event.
-  for (auto& match : p.filter_matches())
-    match.bins_present_ = false;
+  reset_filter_matches(p);
 }
 
 void score_tracklength_tally(Particle& p, double distance)
 {
+  ProfileScope profile(ProfileRegion::TALLY);
+
   // Determine the tracklength estimate of the flux
   double flux = p.wgt() * distance;
 
-  for (auto i_tally : model::active_tracklength_tallies) {
-    const Tally& tally {*model::tallies[i_tally]};
+  for (const auto& group : model::active_tracklength_groups) {
+    // Time spent on the group is shared by its tallies
+    DomainScope profile_group(ProfileDomain::TALLY, group);
+    count_event(TransportEvent::TALLY_SCORE, group.size());
+
+    // All tallies in the group have the same filters and nuclides, so the
+    // first one is used to find the filter bin combinations and nuclides
+    const Tally& tally {*model::tallies[group.front()]};
+
+    // Skip tallies that cannot match the particle type or energy
+    if (!tally_may_score(tally, p))
+      continue;
 
     // Initialize an iterator over valid filter bin combinations.  If there are
     // no valid combinations, use a continue statement to ensure we skip the
@@ -2324,6 +2512,18 @@ void score_tracklength_tally(Particle& p, double distance)
       auto filter_index = filter_iter.index_;
       auto filter_weight = filter_iter.weight_;
 
+      // Depletion rate tallies score all of their nuclides in one pass
+      bool any_general = false;
+      for (auto i_tally : group) {
+        if (model::tallies[i_tally]->depletion_rates_) {
+          score_depletion_rates(p, i_tally, filter_index, filter_weight, flux);
+        } else {
+          any_general = true;
+        }
+      }
+      if (!any_general)
+        continue;
+
       // Loop over nuclide bins.
       for (auto i = 0; i < tally.nuclides_.size(); ++i) {
         auto i_nuclide = tally.nuclides_[i];
@@ -2339,13 +2539,20 @@ void score_tracklength_tally(Particle& p, double distance)
           }
         }
 
-        // TODO: consider replacing this "if" with pointers or templates
-        if (settings::run_CE) {
-          score_general_ce_nonanalog(p, i_tally, i * tally.scores_.size(),
-            filter_index, filter_weight, i_nuclide, atom_density, flux);
-        } else {
-          score_general_mg(p, i_tally, i * tally.scores_.size(), filter_index,
-            filter_weight, i_nuclide, atom_density, flux);
+        // Score each tally in the group for this filter and nuclide bin
+        for (auto i_tally : group) {
+          if (model::tallies[i_tally]->depletion_rates_)
+            continue;
+          auto start_index = i * model::tallies[i_tally]->scores_.size();
+
+          // TODO: consider replacing this "if" with pointers or templates
+          if (settings::run_CE) {
+            score_general_ce_nonanalog(p, i_tally, start_index, filter_index,
+              filter_weight, i_nuclide, atom_density, flux);
+          } else {
+            score_general_mg(p, i_tally, start_index, filter_index,
+              filter_weight, i_nuclide, atom_density, flux);
+          }
         }
       }
     }
@@ -2358,21 +2565,31 @@ void score_tracklength_tally(Particle& p, double distance)
       break;
   }
 
-  // Reset all the filter matches for the next tally event.
-  for (auto& match : p.filter_matches())
-    match.bins_present_ = false;
+  reset_filter_matches(p);
 }
 
 void score_collision_tally(Particle& p)
 {
+  ProfileScope profile(ProfileRegion::TALLY);
+
   // Determine the collision estimate of the flux
   double flux = 0.0;
   if (p.type() == ParticleType::neutron || p.type() == ParticleType::photon) {
     flux = p.wgt_last() / p.macro_xs().total;
   }
 
-  for (auto i_tally : model::active_collision_tallies) {
-    const Tally& tally {*model::tallies[i_tally]};
+  for (const auto& group : model::active_collision_groups) {
+    // Time spent on the group is shared by its tallies
+    DomainScope profile_group(ProfileDomain::TALLY, group);
+    count_event(TransportEvent::TALLY_SCORE, group.size());
+
+    // All tallies in the group have the same filters and nuclides, so the
+    // first one is used to find the filter bin combinations and nuclides
+    const Tally& tally {*model::tallies[group.front()]};
+
+    // Skip tallies that cannot match the particle type or energy
+    if (!tally_may_score(tally, p))
+      continue;
 
     // Initialize an iterator over valid filter bin combinations.  If there are
     // no valid combinations, use a continue statement to ensure we skip the
@@ -2387,6 +2604,18 @@ void score_collision_tally(Particle& p)
       auto filter_index = filter_iter.index_;
       auto filter_weight = filter_iter.weight_;
 
+      // Depletion rate tallies score all of their nuclides in one pass
+      bool any_general = false;
+      for (auto i_tally : group) {
+        if (model::tallies[i_tally]->depletion_rates_) {
+          score_depletion_rates(p, i_tally, filter_index, filter_weight, flux);
+        } else {
+          any_general = true;
+        }
+      }
+      if (!any_general)
+        continue;
+
       // Loop over nuclide bins.
       for (auto i = 0; i < tally.nuclides_.size(); ++i) {
         auto i_nuclide = tally.nuclides_[i];
@@ -2400,13 +2629,20 @@ void score_collision_tally(Particle& p)
           atom_density = model::materials[p.material()]->atom_density_(j);
         }
 
-        // TODO: consider replacing this "if" with pointers or templates
-        if (settings::run_CE) {
-          score_general_ce_nonanalog(p, i_tally, i * tally.scores_.size(),
-            filter_index, filter_weight, i_nuclide, atom_density, flux);
-        } else {
-          score_general_mg(p, i_tally, i * tally.scores_.size(), filter_index,
-            filter_weight, i_nuclide, atom_density, flux);
+        // Score each tally in the group for this filter and nuclide bin
+        for (auto i_tally : group) {
+          if (model::tallies[i_tally]->depletion_rates_)
+            continue;
+          auto start_index = i * model::tallies[i_tally]->scores_.size();
+
+          // TODO: consider replacing this "if" with pointers or templates
+          if (settings::run_CE) {
+            score_general_ce_nonanalog(p, i_tally, start_index, filter_index,
+              filter_weight, i_nuclide, atom_density, flux);
+          } else {
+            score_general_mg(p, i_tally, start_index, filter_index,
+              filter_weight, i_nuclide, atom_density, flux);
+          }
         }
       }
     }
@@ -2419,16 +2655,18 @@ void score_collision_tally(Particle& p)
       break;
   }
 
-  // Reset all the filter matches for the next tally event.
-  for (auto& match : p.filter_matches())
-    match.bins_present_ = false;
+  reset_filter_matches(p);
 }
 
 void score_surface_tally(Particle& p, const vector<int>& tallies)
 {
+  ProfileScope profile(ProfileRegion::TALLY);
+
   double current = p.wgt_last();
 
   for (auto i_tally : tallies) {
+    DomainScope profile_tally(ProfileDomain::TALLY, i_tally);
+    count_event(TransportEvent::TALLY_SCORE);
     auto& tally {*model::tallies[i_tally]};
 
     // Initialize an iterator over valid filter bin combinations.  If there are
@@ -2450,8 +2688,7 @@ void score_surface_tally(Particle& p, const vector<int>& tallies)
       double score = current * filter_weight;
       for (auto score_index = 0; score_index < tally.scores_.size();
            ++score_index) {
-#pragma omp atomic
-        tally.results_(filter_index, score_index, TallyResult::VALUE) += score;
+        tally.add_score(filter_index, score_index, score);
       }
     }
 
@@ -2463,9 +2700,49 @@ void score_surface_tally(Particle& p, const vector<int>& tallies)
       break;
   }
 
-  // Reset all the filter matches for the next tally event.
-  for (auto& match : p.filter_matches())
-    match.bins_present_ = false;
+  reset_filter_matches(p);
+}
+
+void score_pulse_height_tally(Particle& p)
+{
+  ProfileScope profile(ProfileRegion::TALLY);
+
+  for (auto i_tally : model::active_pulse_height_tallies) {
+    DomainScope profile_tally(ProfileDomain::TALLY, i_tally);
+    count_event(TransportEvent::TALLY_SCORE);
+    auto& tally {*model::tallies[i_tally]};
+
+    // Find the cell and energy filters, which are the only filters allowed on
+    // a pulse-height tally
+    const CellFilter* cell_filter = nullptr;
+    const EnergyFilter* energy_filter = nullptr;
+    int cell_stride = 0;
+    int energy_stride = 0;
+    for (auto i = 0; i < tally.filters().size(); ++i) {
+      const auto* filt = model::tally_filters[tally.filters(i)].get();
+      if (filt->type() == "cell") {
+        cell_filter = dynamic_cast<const CellFilter*>(filt);
+        cell_stride = tally.strides(i);
+      } else {
+        energy_filter = dynamic_cast<const EnergyFilter*>(filt);
+        energy_stride = tally.strides(i);
+      }
+    }
+
+    // Count each cell the history deposited energy in once in the bin of the
+    // total energy deposited there. Deposits below 1 eV are left over from
+    // round-off when all of the energy was carried away by secondaries.
+    for (const auto& deposit : p.energy_deposits()) {
+      int cell_bin = cell_filter->search(deposit.cell);
+      if (cell_bin < 0 || deposit.E < 1.0)
+        continue;
+      int energy_bin = energy_filter->search(deposit.E);
+      if (energy_bin < 0)
+        continue;
+      tally.add_score(
+        cell_bin * cell_stride + energy_bin * energy_stride, 0, 1.0);
+    }
+  }
 }
 
 } // namespace openmc
@@ -0,0 +1,344 @@
+#include "openmc/tallies/tally_stream.h"
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+#define HAS_MEMORY_MAPPING
+#endif
+
+#include <algorithm> // for copy
+#include <atomic>    // for atomic_thread_fence
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility> // for swap
+
+#ifdef HAS_MEMORY_MAPPING
+#include <fcntl.h>    // for open
+#include <sys/mman.h> // for mmap, munmap
+#include <unistd.h>   // for close, ftruncate
+#endif
+
+#include <fmt/core.h>
+
+#include "openmc/capi.h"
+#include "openmc/error.h"
+#include "openmc/message_passing.h"
+#include "openmc/settings.h"
+#include "openmc/simulation.h"
+#include "openmc/tallies/tally.h"
+
+namespace openmc {
+
+//==============================================================================
+// Global variables
+//==============================================================================
+
+namespace simulation {
+
+vector<int32_t> tally_stream_ids;
+vector<int64_t> tally_stream_sizes;
+
+} // namespace simulation
+
+namespace {
+
+vector<int> stream_tallies; //!< Indices of the streamed tallies
+
+//! Transport set through the C API, used instead of the settings
+unique_ptr<TallyStreamTransport> custom_transport;
+unique_ptr<TallyStreamTransport> file_transport; //!< Transport to a file
+TallyStreamTransport* transport {nullptr};       //!< Transport in use
+
+std::thread publisher;             //!< Publishes frames in the background
+bool stream_active {false};        //!< Whether the publisher is running
+bool stream_done;                  //!< Whether the publisher should stop
+std::mutex stream_mutex;           //!< Protects pending_frame and flags
+std::condition_variable stream_cv; //!< Signals a new frame or shutdown
+int n_skipped; //!< Frames replaced before being published
+
+// Frames are filled in back_frame and swapped into pending_frame, where the
+// publisher takes them from, so neither side waits for the other
+TallyStreamFrame back_frame;    //!< Frame being filled after a batch
+TallyStreamFrame pending_frame; //!< Latest complete frame not yet taken
+TallyStreamFrame front_frame;   //!< Frame being published
+bool frame_pending {false};     //!< Whether pending_frame holds a new frame
+
+//==============================================================================
+//! Writes frames to a memory-mapped file, which is shared memory when the
+//! file is in a memory-backed file system such as /dev/shm. The file holds
+//! two slots so that a consumer can read the latest frame while the next one
+//! is written.
+//==============================================================================
+
+class MappedFileTransport : public TallyStreamTransport {
+public:
+  explicit MappedFileTransport(const std::string& path)
+  {
+#ifdef HAS_MEMORY_MAPPING
+    const auto& sizes {simulation::tally_stream_sizes};
+    n_tallies_ = sizes.size();
+    n_bins_ = 0;
+    for (auto n : sizes) {
+      n_bins_ += n;
+    }
+    slot_words_ = 1 + n_tallies_ + 2 * n_bins_;
+    size_ =
+      sizeof(int64_t) * (HEADER_WORDS + 2 * n_tallies_ + 2 * slot_words_);
+
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    void* mapping = MAP_FAILED;
+    if (fd >= 0) {
+      if (ftruncate(fd, size_) == 0) {
+        mapping =
+          mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      }
+      close(fd);
+    }
+    if (mapping == MAP_FAILED) {
+      fatal_error(fmt::format("Could not map tally stream file '{}'.", path));
+    }
+    words_ = static_cast<int64_t*>(mapping);
+
+    // Write the header and the layout of the tallies. The number of frames
+    // published is written last so that the file is not read before then.
+    words_[0] = TALLY_STREAM_MAGIC;
+    words_[1] = VERSION;
+    words_[2] = n_tallies_;
+    words_[3] = n_bins_;
+    for (int i = 0; i < n_tallies_; ++i) {
+      words_[HEADER_WORDS + i] = simulation::tally_stream_ids[i];
+      words_[HEADER_WORDS + n_tallies_ + i] = sizes[i];
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    sequence() = 0;
+#else
+    fatal_error(
+      "Tally streaming to a file is not supported on this platform.");
+#endif
+  }
+
+  ~MappedFileTransport()
+  {
+#ifdef HAS_MEMORY_MAPPING
+    munmap(words_, size_);
+#endif
+  }
+
+  void publish(const TallyStreamFrame& frame) override
+  {
+    // Frame s is written to slot s % 2 while consumers may still be reading
+    // frame s - 1 from the other slot
+    int64_t s = ++n_published_;
+    int64_t* slot =
+      words_ + HEADER_WORDS + 2 * n_tallies_ + (s % 2) * slot_words_;
+    slot[0] = frame.batch;
+    std::copy(frame.n_realizations.begin(), frame.n_realizations.end(),
+      slot + 1);
+    auto* values = reinterpret_cast<double*>(slot + 1 + n_tallies_);
+    std::copy(frame.mean.begin(), frame.mean.end(), values);
+    std::copy(frame.variance.begin(), frame.variance.end(), values + n_bins_);
+
+    std::atomic_thread_fence(std::memory_order_release);
+    sequence() = s;
+  }
+
+private:
+  static constexpr int HEADER_WORDS {5}; //!< Words before the tally layout
+  static constexpr int64_t VERSION {1};  //!< Revision of the file layout
+
+  //! Number of frames published, read by consumers while frames are written
+  volatile int64_t& sequence()
+  {
+    return reinterpret_cast<volatile int64_t*>(words_)[4];
+  }
+
+  int64_t* words_ {nullptr}; //!< Mapped file
+  size_t size_ {0};          //!< Size of the mapping in [bytes]
+  int64_t n_tallies_;        //!< Number of streamed tallies
+  int64_t n_bins_;           //!< Number of bins of all tallies together
+  int64_t slot_words_;       //!< Size of each slot in words
+  int64_t n_published_ {0};  //!< Number of frames published
+};
+
+//==============================================================================
+//! Passes frames to a function registered through the C API
+//==============================================================================
+
+class CallbackTransport : public TallyStreamTransport {
+public:
+  CallbackTransport(openmc_tally_stream_callback callback, void* data)
+    : callback_ {callback}, data_ {data}
+  {}
+
+  void publish(const TallyStreamFrame& frame) override
+  {
+    const auto& ids {simulation::tally_stream_ids};
+    callback_(frame.batch, ids.size(), ids.data(),
+      simulation::tally_stream_sizes.data(), frame.n_realizations.data(),
+      frame.mean.data(), frame.variance.data(), data_);
+  }
+
+private:
+  openmc_tally_stream_callback callback_;
+  void* data_;
+};
+
+//! Publish frames handed off after each batch until told to stop
+void publisher_loop()
+{
+  std::unique_lock<std::mutex> lock(stream_mutex);
+  while (true) {
+    stream_cv.wait(lock, [] { return frame_pending || stream_done; });
+    if (!frame_pending)
+      return;
+
+    // Publish without holding the lock so that the next frame can be handed
+    // off in the meantime
+    std::swap(pending_frame, front_frame);
+    frame_pending = false;
+    lock.unlock();
+    transport->publish(front_frame);
+    lock.lock();
+  }
+}
+
+} // namespace
+
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+void start_tally_stream()
+{
+  simulation::tally_stream_ids.clear();
+  simulation::tally_stream_sizes.clear();
+  stream_tallies.clear();
+  if ((!settings::tally_stream && !custom_transport) || !mpi::master)
+    return;
+
+  // Select the tallies given in the settings, or all of them
+  if (settings::tally_stream_tallies.empty()) {
+    for (int i = 0; i < model::tallies.size(); ++i) {
+      stream_tallies.push_back(i);
+    }
+  } else {
+    for (auto id : settings::tally_stream_tallies) {
+      auto it = model::tally_map.find(id);
+      if (it == model::tally_map.end()) {
+        fatal_error(fmt::format(
+          "Tally {} given for the tally stream does not exist.", id));
+      }
+      stream_tallies.push_back(it->second);
+    }
+  }
+  for (auto i_tally : stream_tallies) {
+    const auto& tally {*model::tallies[i_tally]};
+    simulation::tally_stream_ids.push_back(tally.id_);
+    simulation::tally_stream_sizes.push_back(static_cast<int64_t>(
+      tally.n_filter_bins()) * tally.scores_.size() * tally.nuclides_.size());
+  }
+
+  if (custom_transport) {
+    transport = custom_transport.get();
+  } else {
+    auto path = settings::tally_stream_path;
+    if (path.empty())
+      path = settings::path_output + "tally_stream.bin";
+    file_transport = make_unique<MappedFileTransport>(path);
+    transport = file_transport.get();
+  }
+
+  stream_done = false;
+  frame_pending = false;
+  n_skipped = 0;
+  stream_active = true;
+  publisher = std::thread(publisher_loop);
+}
+
+void publish_tally_stream()
+{
+  if (!stream_active)
+    return;
+
+  // Find the mean and the variance of the mean of each bin
+  back_frame.batch = simulation::current_batch;
+  back_frame.n_realizations.clear();
+  back_frame.mean.clear();
+  back_frame.variance.clear();
+  for (auto i_tally : stream_tallies) {
+    const auto& tally {*model::tallies[i_tally]};
+    int n = tally.n_realizations_;
+    back_frame.n_realizations.push_back(n);
+    int n_scores = tally.scores_.size() * tally.nuclides_.size();
+    for (int i = 0; i < tally.n_filter_bins(); ++i) {
+      for (int j = 0; j < n_scores; ++j) {
+        double mean = 0.0;
+        double variance = 0.0;
+        if (n > 0) {
+          mean = tally.result(i, j, TallyResult::SUM) / n;
+        }
+        if (n > 1) {
+          double sum_sq = tally.result(i, j, TallyResult::SUM_SQ);
+          variance = (sum_sq / n - mean * mean) / (n - 1);
+        }
+        back_frame.mean.push_back(mean);
+        back_frame.variance.push_back(variance);
+      }
+    }
+  }
+
+  // Replace any frame that the publisher has not taken yet
+  {
+    std::lock_guard<std::mutex> lock(stream_mutex);
+    if (frame_pending)
+      ++n_skipped;
+    std::swap(back_frame, pending_frame);
+    frame_pending = true;
+  }
+  stream_cv.notify_one();
+}
+
+void stop_tally_stream()
+{
+  if (!stream_active)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(stream_mutex);
+    stream_done = true;
+  }
+  stream_cv.notify_one();
+  publisher.join();
+  file_transport.reset();
+  transport = nullptr;
+  stream_active = false;
+
+  if (n_skipped > 0) {
+    write_message(6,
+      "{} tally stream frames were replaced by later batches before they "
+      "were published.",
+      n_skipped);
+  }
+}
+
+void set_tally_stream_transport(unique_ptr<TallyStreamTransport> t)
+{
+  custom_transport = std::move(t);
+}
+
+//==============================================================================
+// C API functions
+//==============================================================================
+
+extern "C" int openmc_tally_stream_set_callback(
+  openmc_tally_stream_callback callback, void* data)
+{
+  if (callback) {
+    set_tally_stream_transport(
+      make_unique<CallbackTransport>(callback, data));
+  } else {
+    set_tally_stream_transport(nullptr);
+  }
+  return 0;
+}
+
+} // namespace openmc
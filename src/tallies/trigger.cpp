@@ -1,7 +1,11 @@
 #include "openmc/tallies/trigger.h"
 
+#include <algorithm>  // for max
 #include <cmath>
-#include <utility> // for std::pair
+#include <cstddef>    // for size_t
+#include <functional> // for greater
+#include <queue>      // for priority_queue
+#include <utility>    // for std::pair
 
 #include <fmt/core.h>
 
@@ -28,14 +32,12 @@ KTrigger keff_trigger;
 //==============================================================================
 
 std::pair<double, double> get_tally_uncertainty(
-  int i_tally, int score_index, int filter_index)
+  const Tally& tally, int score_index, int filter_index)
 {
-  const auto& tally {model::tallies[i_tally]};
+  auto sum = tally.result(filter_index, score_index, TallyResult::SUM);
+  auto sum_sq = tally.result(filter_index, score_index, TallyResult::SUM_SQ);
 
-  auto sum = tally->results_(filter_index, score_index, TallyResult::SUM);
-  auto sum_sq = tally->results_(filter_index, score_index, TallyResult::SUM_SQ);
-
-  int n = tally->n_realizations_;
+  int n = tally.n_realizations_;
   auto mean = sum / n;
   double std_dev = std::sqrt((sum_sq / n - mean * mean) / (n - 1));
   double rel_err = (mean != 0.) ? std_dev / std::abs(mean) : 0.;
@@ -43,6 +45,93 @@ std::pair<double, double> get_tally_uncertainty(
   return {std_dev, rel_err};
 }
 
+//! Compute the uncertainty/threshold ratio of a tally bin for a trigger.
+
+double get_trigger_ratio(
+  const Tally& tally, const Trigger& trigger, int score_index, int filter_index)
+{
+  // Compute the tally uncertainty metrics.
+  auto uncert_pair = get_tally_uncertainty(tally, score_index, filter_index);
+  double std_dev = uncert_pair.first;
+  double rel_err = uncert_pair.second;
+
+  // Pick out the relevant uncertainty metric for this trigger.
+  double uncertainty;
+  switch (trigger.metric) {
+  case TriggerMetric::variance:
+    uncertainty = std_dev * std_dev;
+    break;
+  case TriggerMetric::standard_deviation:
+    uncertainty = std_dev;
+    break;
+  case TriggerMetric::relative_error:
+    uncertainty = rel_err;
+    break;
+  case TriggerMetric::not_active:
+    UNREACHABLE();
+  }
+
+  // Compute the uncertainty / threshold ratio.
+  double ratio = uncertainty / trigger.threshold;
+  if (trigger.metric == TriggerMetric::variance) {
+    ratio = std::sqrt(ratio);
+  }
+  return ratio;
+}
+
+void update_tally_triggers(Tally& tally)
+{
+  // Ignore tallies with less than two realizations.
+  if (tally.n_realizations_ < 2)
+    return;
+
+  int n_scores = tally.scores_.size();
+  for (auto& trigger : tally.triggers_) {
+    // Skip trigger if it is not active
+    if (trigger.metric == TriggerMetric::not_active)
+      continue;
+
+    // The trigger cannot be satisfied while one of the most uncertain bins
+    // from the last full evaluation is above the threshold, so only those
+    // bins need to be evaluated until the tally is close to convergence
+    trigger.ratio = 0.;
+    for (const auto& bin : trigger.worst_bins) {
+      trigger.ratio = std::max(trigger.ratio,
+        get_trigger_ratio(tally, trigger, bin.second, bin.first));
+    }
+    if (trigger.ratio > 1.)
+      continue;
+
+    // Evaluate the trigger's score for every nuclide and filter bin, keeping
+    // the most uncertain bins in a min-heap
+    using RatioBin = std::pair<double, std::pair<int, int>>;
+    std::priority_queue<RatioBin, vector<RatioBin>, std::greater<RatioBin>>
+      worst;
+    constexpr size_t n_worst = N_TRIGGER_WORST_BINS;
+    for (int i_nuclide = 0; i_nuclide < tally.nuclides_.size(); ++i_nuclide) {
+      int score_index = i_nuclide * n_scores + trigger.score_index;
+      for (int filter_index = 0; filter_index < tally.n_filter_bins();
+           ++filter_index) {
+        double ratio =
+          get_trigger_ratio(tally, trigger, score_index, filter_index);
+        trigger.ratio = std::max(trigger.ratio, ratio);
+        if (worst.size() < n_worst || ratio > worst.top().first) {
+          worst.push({ratio, {filter_index, score_index}});
+          if (worst.size() > n_worst)
+            worst.pop();
+        }
+      }
+    }
+
+    // Store the bins from the most to the least uncertain
+    trigger.worst_bins.resize(worst.size());
+    for (auto it = trigger.worst_bins.rbegin(); !worst.empty(); ++it) {
+      *it = worst.top().second;
+      worst.pop();
+    }
+  }
+}
+
 //! Find the limiting limiting tally trigger.
 //
 //! param[out] ratio The uncertainty/threshold ratio for the most limiting
@@ -53,58 +142,22 @@ std::pair<double, double> get_tally_uncertainty(
 void check_tally_triggers(double& ratio, int& tally_id, int& score)
 {
   ratio = 0.;
-  for (auto i_tally = 0; i_tally < model::tallies.size(); ++i_tally) {
-    const Tally& t {*model::tallies[i_tally]};
-
+  for (const auto& t : model::tallies) {
     // Ignore tallies with less than two realizations.
-    if (t.n_realizations_ < 2)
+    if (t->n_realizations_ < 2)
       continue;
 
-    for (const auto& trigger : t.triggers_) {
+    // The ratios were updated when the tally was accumulated
+    for (const auto& trigger : t->triggers_) {
       // Skip trigger if it is not active
       if (trigger.metric == TriggerMetric::not_active)
         continue;
 
-      const auto& results = t.results_;
-      for (auto filter_index = 0; filter_index < results.shape()[0];
-           ++filter_index) {
-        for (auto score_index = 0; score_index < results.shape()[1];
-             ++score_index) {
-          // Compute the tally uncertainty metrics.
-          auto uncert_pair =
-            get_tally_uncertainty(i_tally, score_index, filter_index);
-          double std_dev = uncert_pair.first;
-          double rel_err = uncert_pair.second;
-
-          // Pick out the relevant uncertainty metric for this trigger.
-          double uncertainty;
-          switch (trigger.metric) {
-          case TriggerMetric::variance:
-            uncertainty = std_dev * std_dev;
-            break;
-          case TriggerMetric::standard_deviation:
-            uncertainty = std_dev;
-            break;
-          case TriggerMetric::relative_error:
-            uncertainty = rel_err;
-            break;
-          case TriggerMetric::not_active:
-            UNREACHABLE();
-          }
-
-          // Compute the uncertainty / threshold ratio.
-          double this_ratio = uncertainty / trigger.threshold;
-          if (trigger.metric == TriggerMetric::variance) {
-            this_ratio = std::sqrt(ratio);
-          }
-
-          // If this is the most uncertain value, set the output variables.
-          if (this_ratio > ratio) {
-            ratio = this_ratio;
-            score = t.scores_[trigger.score_index];
-            tally_id = t.id_;
-          }
-        }
+      // If this is the most uncertain value, set the output variables.
+      if (trigger.ratio > ratio) {
+        ratio = trigger.ratio;
+        score = t->scores_[trigger.score_index];
+        tally_id = t->id_;
       }
     }
   }
@@ -143,21 +196,24 @@ double check_keff_trigger()
   return ratio;
 }
 
+bool is_trigger_batch()
+{
+  const auto current_batch {simulation::current_batch};
+  const auto n_batches {settings::n_batches};
+  const auto interval {settings::trigger_batch_interval};
+  return settings::trigger_on && current_batch >= n_batches &&
+         (current_batch - n_batches) % interval == 0;
+}
+
 //! See if tally and eigenvalue uncertainties are under trigger thresholds.
 
 void check_triggers()
 {
   // Make some aliases.
   const auto current_batch {simulation::current_batch};
-  const auto n_batches {settings::n_batches};
-  const auto interval {settings::trigger_batch_interval};
 
   // See if the current batch is one for which the triggers must be checked.
-  if (!settings::trigger_on)
-    return;
-  if (current_batch < n_batches)
-    return;
-  if (((current_batch - n_batches) % interval) != 0)
+  if (!is_trigger_batch())
     return;
 
   // Check the eigenvalue and tally triggers.
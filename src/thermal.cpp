@@ -14,6 +14,7 @@
 #include "openmc/constants.h"
 #include "openmc/endf.h"
 #include "openmc/error.h"
+#include "openmc/nuclide.h"
 #include "openmc/random_lcg.h"
 #include "openmc/search.h"
 #include "openmc/secondary_correlated.h"
@@ -144,18 +145,20 @@ ThermalScattering::ThermalScattering(
     // Open group for this temperature
     hid_t T_group = open_group(group, temp_str.data());
     data_.emplace_back(T_group);
+    nbytes_ += dataset_bytes(T_group);
     close_group(T_group);
   }
 
   close_group(kT_group);
+
+  this->update_cell_temperatures();
 }
 
-void ThermalScattering::calculate_xs(double E, double sqrtkT, int* i_temp,
-  double* elastic, double* inelastic, uint64_t* seed) const
+ThermalScattering::TemperatureChoice ThermalScattering::select_temperature(
+  double kT) const
 {
-  // Determine temperature for S(a,b) table
-  double kT = sqrtkT * sqrtkT;
-  int i = 0;
+  TemperatureChoice choice {0, 0.0};
+  int& i = choice.index;
 
   auto n = kTs_.size();
   if (n > 1) {
@@ -167,14 +170,40 @@ void ThermalScattering::calculate_xs(double E, double sqrtkT, int* i_temp,
       // Pick closer of two bounding temperatures
       if (kT - kTs_[i] > kTs_[i + 1] - kT)
         ++i;
-
     } else {
-      // Randomly sample between temperature i and i+1
-      double f = (kT - kTs_[i]) / (kTs_[i + 1] - kTs_[i]);
-      if (f > prn(seed))
-        ++i;
+      choice.f = (kT - kTs_[i]) / (kTs_[i + 1] - kTs_[i]);
     }
   }
+  return choice;
+}
+
+void ThermalScattering::update_cell_temperatures()
+{
+  for (auto i = cell_temp_.size(); i < data::cell_sqrtkT.size(); ++i) {
+    double sqrtkT = data::cell_sqrtkT[i];
+    cell_temp_.push_back(this->select_temperature(sqrtkT * sqrtkT));
+  }
+}
+
+void ThermalScattering::calculate_xs(double E, double sqrtkT, int i_sqrtkT,
+  int* i_temp, double* elastic, double* inelastic, uint64_t* seed) const
+{
+  // Determine temperature for S(a,b) table, using the selection cached when
+  // the cell temperature was assigned if the temperature came from a cell
+  TemperatureChoice choice;
+  if (i_sqrtkT >= 0 && i_sqrtkT < cell_temp_.size()) {
+    choice = cell_temp_[i_sqrtkT];
+  } else {
+    choice = this->select_temperature(sqrtkT * sqrtkT);
+  }
+  int i = choice.index;
+
+  // Randomly sample between temperature i and i+1
+  if (settings::temperature_method != TemperatureMethod::NEAREST &&
+      kTs_.size() > 1) {
+    if (choice.f > prn(seed))
+      ++i;
+  }
 
   // Set temperature index
   *i_temp = i;
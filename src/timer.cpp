@@ -25,6 +25,8 @@ Timer time_event_calculate_xs;
 Timer time_event_advance_particle;
 Timer time_event_surface_crossing;
 Timer time_event_collision;
+Timer time_event_tally;
+Timer time_event_sort;
 Timer time_event_death;
 
 } // namespace simulation
@@ -84,6 +86,8 @@ void reset_timers()
   simulation::time_event_advance_particle.reset();
   simulation::time_event_surface_crossing.reset();
   simulation::time_event_collision.reset();
+  simulation::time_event_tally.reset();
+  simulation::time_event_sort.reset();
   simulation::time_event_death.reset();
 }
 
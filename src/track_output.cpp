@@ -1,9 +1,12 @@
 #include "openmc/track_output.h"
 
 #include "openmc/constants.h"
+#include "openmc/error.h"
 #include "openmc/hdf5_interface.h"
 #include "openmc/message_passing.h"
+#include "openmc/openmp_interface.h"
 #include "openmc/position.h"
+#include "openmc/random_lcg.h"
 #include "openmc/settings.h"
 #include "openmc/simulation.h"
 #include "openmc/vector.h"
@@ -12,19 +15,233 @@
 #include <fmt/core.h>
 #include <hdf5.h>
 
-#include <cstddef> // for size_t
+#include <algorithm>          // for max, none_of
+#include <condition_variable> // for condition_variable
+#include <cstddef>            // for size_t
+#include <deque>
+#include <mutex> // for mutex, unique_lock
 #include <string>
+#include <thread>
 
 namespace openmc {
 
+//==============================================================================
+// Constants
+//==============================================================================
+
+// Number of track states a thread collects before its buffer is written
+constexpr size_t TRACK_BUFFER_STATES {16384};
+
+// Approximate size in bytes of each chunk of the extendible datasets
+constexpr size_t TRACK_CHUNK_BYTES {1 << 20};
+
+//==============================================================================
+// Helper types
+//==============================================================================
+
+namespace {
+
+//! Source history whose tracks are stored in the track file
+struct TrackHistory {
+  int batch;       //!< Batch of the source particle
+  int generation;  //!< Generation of the source particle
+  int64_t id;      //!< Number of the source particle
+  int n_particles; //!< Number of primary/secondary particles
+};
+
+//! Primary/secondary particle whose states are stored in the track file
+struct TrackParticle {
+  int particle;     //!< Particle type
+  int64_t n_states; //!< Number of track states
+};
+
+//! Tracks of finished histories that have not been written to file yet
+struct TrackBuffer {
+  vector<TrackHistory> histories;
+  vector<TrackParticle> particles;
+  vector<TrackState> states;
+
+  void clear()
+  {
+    histories.clear();
+    particles.clear();
+    states.clear();
+  }
+};
+
+} // namespace
+
 //==============================================================================
 // Global variables
 //==============================================================================
 
 hid_t track_file;     //! HDF5 identifier for track file
 hid_t track_dtype;    //! HDF5 identifier for track datatype
+hid_t track_filetype; //! HDF5 identifier for track datatype in file
+hid_t history_dtype;  //! HDF5 identifier for history datatype
+hid_t particle_dtype; //! HDF5 identifier for particle datatype
+hid_t track_dsets[3]; //! HDF5 identifiers for histories/particles/states
 int n_tracks_written; //! Number of tracks written
 
+namespace {
+
+vector<TrackBuffer> track_buffers; //! Tracks collected by each thread
+
+std::thread track_writer;            //! Writes buffers in the background
+bool track_writer_active {false};    //! Whether the writer thread is running
+bool track_writer_done;              //! Whether the writer should stop
+std::mutex track_writer_mutex;       //! Protects track_queue and done flag
+std::condition_variable track_cv;    //! Signals new buffers or shutdown
+std::deque<TrackBuffer> track_queue; //! Buffers waiting to be written
+
+} // namespace
+
+//==============================================================================
+// Helper functions
+//==============================================================================
+
+namespace {
+
+//! Create an empty one-dimensional dataset that can be extended without limit
+hid_t create_extendible_dataset(const char* name, hid_t dtype)
+{
+  hsize_t dims[] {0};
+  hsize_t maxdims[] {H5S_UNLIMITED};
+  hsize_t chunk[] {
+    std::max<hsize_t>(1, TRACK_CHUNK_BYTES / H5Tget_size(dtype))};
+  hid_t dspace = H5Screate_simple(1, dims, maxdims);
+  hid_t plist = H5Pcreate(H5P_DATASET_CREATE);
+  H5Pset_chunk(plist, 1, chunk);
+  if (settings::track_compression > 0) {
+    H5Pset_shuffle(plist);
+    H5Pset_deflate(plist, settings::track_compression);
+  }
+  hid_t dset = H5Dcreate(
+    track_file, name, dtype, dspace, H5P_DEFAULT, plist, H5P_DEFAULT);
+  H5Pclose(plist);
+  H5Sclose(dspace);
+  return dset;
+}
+
+//! Append an array of elements to the end of an extendible dataset
+void append_dataset(hid_t dset, hid_t dtype, const void* buffer, size_t n)
+{
+  if (n == 0)
+    return;
+
+  // Determine current size and extend dataset
+  hid_t dspace = H5Dget_space(dset);
+  hsize_t offset[1];
+  H5Sget_simple_extent_dims(dspace, offset, nullptr);
+  H5Sclose(dspace);
+  hsize_t count[] {n};
+  hsize_t dims[] {offset[0] + n};
+  H5Dset_extent(dset, dims);
+
+  // Write new elements to the end of the dataset
+  dspace = H5Dget_space(dset);
+  H5Sselect_hyperslab(dspace, H5S_SELECT_SET, offset, nullptr, count, nullptr);
+  hid_t memspace = H5Screate_simple(1, count, nullptr);
+  H5Dwrite(dset, dtype, memspace, dspace, H5P_DEFAULT, buffer);
+  H5Sclose(memspace);
+  H5Sclose(dspace);
+}
+
+//! Create the datatype of track states in single precision. The members have
+//! the same names as in the native datatype, so HDF5 converts between the two.
+hid_t track_type_single()
+{
+  hid_t postype = H5Tcreate(H5T_COMPOUND, 3 * sizeof(float));
+  H5Tinsert(postype, "x", 0, H5T_NATIVE_FLOAT);
+  H5Tinsert(postype, "y", sizeof(float), H5T_NATIVE_FLOAT);
+  H5Tinsert(postype, "z", 2 * sizeof(float), H5T_NATIVE_FLOAT);
+
+  // Members are packed one after another
+  size_t size = 6 * sizeof(float) + 3 * sizeof(double) + 3 * sizeof(int);
+  hid_t filetype = H5Tcreate(H5T_COMPOUND, size);
+  size_t offset = 0;
+  H5Tinsert(filetype, "r", offset, postype);
+  offset += 3 * sizeof(float);
+  H5Tinsert(filetype, "u", offset, postype);
+  offset += 3 * sizeof(float);
+  H5Tinsert(filetype, "E", offset, H5T_NATIVE_DOUBLE);
+  offset += sizeof(double);
+  H5Tinsert(filetype, "time", offset, H5T_NATIVE_DOUBLE);
+  offset += sizeof(double);
+  H5Tinsert(filetype, "wgt", offset, H5T_NATIVE_DOUBLE);
+  offset += sizeof(double);
+  H5Tinsert(filetype, "cell_id", offset, H5T_NATIVE_INT);
+  offset += sizeof(int);
+  H5Tinsert(filetype, "cell_instance", offset, H5T_NATIVE_INT);
+  offset += sizeof(int);
+  H5Tinsert(filetype, "material_id", offset, H5T_NATIVE_INT);
+
+  H5Tclose(postype);
+  return filetype;
+}
+
+//! Whether a track state lies in the region that tracks are written for
+bool in_track_region(const TrackState& state)
+{
+  const auto& b = settings::track_region;
+  const auto& r = state.r;
+  return r.x >= b[0] && r.y >= b[1] && r.z >= b[2] && r.x <= b[3] &&
+         r.y <= b[4] && r.z <= b[5];
+}
+
+//! Write the contents of a buffer to the track file
+void write_track_buffer(const TrackBuffer& buffer)
+{
+  append_dataset(track_dsets[0], history_dtype, buffer.histories.data(),
+    buffer.histories.size());
+  append_dataset(track_dsets[1], particle_dtype, buffer.particles.data(),
+    buffer.particles.size());
+  append_dataset(
+    track_dsets[2], track_dtype, buffer.states.data(), buffer.states.size());
+}
+
+//! Write buffers handed off by transport threads until told to stop
+void track_writer_loop()
+{
+  std::unique_lock<std::mutex> lock(track_writer_mutex);
+  while (true) {
+    track_cv.wait(
+      lock, [] { return !track_queue.empty() || track_writer_done; });
+    if (track_queue.empty())
+      return;
+
+    // Write buffer without holding the lock so that threads can keep queueing
+    TrackBuffer buffer = std::move(track_queue.front());
+    track_queue.pop_front();
+    lock.unlock();
+    write_track_buffer(buffer);
+    lock.lock();
+  }
+}
+
+//! Write out a buffer, either directly or by handing it to the writer thread,
+//! and leave it empty
+void flush_track_buffer(TrackBuffer& buffer)
+{
+  if (buffer.histories.empty())
+    return;
+
+  if (track_writer_active) {
+    {
+      std::lock_guard<std::mutex> lock(track_writer_mutex);
+      track_queue.push_back(std::move(buffer));
+    }
+    track_cv.notify_one();
+    buffer = TrackBuffer {};
+  } else {
+#pragma omp critical(FinalizeParticleTrack)
+    write_track_buffer(buffer);
+    buffer.clear();
+  }
+}
+
+} // namespace
+
 //==============================================================================
 // Non-member functions
 //==============================================================================
@@ -57,6 +274,8 @@ void open_track_file()
   track_file = file_open(filename, 'w');
   write_attribute(track_file, "filetype", "track");
   write_attribute(track_file, "version", VERSION_TRACK);
+  write_attribute(track_file, "delta_positions",
+    static_cast<int>(settings::track_delta_positions));
 
   // Create compound type for Position
   hid_t postype = H5Tcreate(H5T_COMPOUND, sizeof(struct Position));
@@ -78,10 +297,74 @@ void open_track_file()
   H5Tinsert(track_dtype, "material_id", HOFFSET(TrackState, material_id),
     H5T_NATIVE_INT);
   H5Tclose(postype);
+
+  // Create compound types for histories and primary/secondary particles
+  history_dtype = H5Tcreate(H5T_COMPOUND, sizeof(struct TrackHistory));
+  H5Tinsert(
+    history_dtype, "batch", HOFFSET(TrackHistory, batch), H5T_NATIVE_INT);
+  H5Tinsert(history_dtype, "generation", HOFFSET(TrackHistory, generation),
+    H5T_NATIVE_INT);
+  H5Tinsert(history_dtype, "particle_id", HOFFSET(TrackHistory, id),
+    H5T_NATIVE_INT64);
+  H5Tinsert(history_dtype, "n_particles", HOFFSET(TrackHistory, n_particles),
+    H5T_NATIVE_INT);
+  particle_dtype = H5Tcreate(H5T_COMPOUND, sizeof(struct TrackParticle));
+  H5Tinsert(particle_dtype, "particle", HOFFSET(TrackParticle, particle),
+    H5T_NATIVE_INT);
+  H5Tinsert(particle_dtype, "n_states", HOFFSET(TrackParticle, n_states),
+    H5T_NATIVE_INT64);
+
+  // Create datasets that buffered tracks are appended to
+  track_dsets[0] = create_extendible_dataset("histories", history_dtype);
+  track_dsets[1] = create_extendible_dataset("particles", particle_dtype);
+  track_filetype = settings::track_single_precision ? track_type_single()
+                                                     : H5Tcopy(track_dtype);
+  track_dsets[2] = create_extendible_dataset("states", track_filetype);
+
+  // Allocate one buffer per thread
+#ifdef _OPENMP
+  track_buffers.resize(omp_get_max_threads());
+#else
+  track_buffers.resize(1);
+#endif
+
+  // Start background writer if requested. HDF5 calls made from a thread that
+  // OpenMP does not know about are only safe with a thread-safe HDF5 build.
+  if (settings::track_writer_thread) {
+#ifdef H5_HAVE_THREADSAFE
+    track_writer_done = false;
+    track_writer_active = true;
+    track_writer = std::thread(track_writer_loop);
+#else
+    warning("HDF5 was not built thread-safe. Tracks will be written without "
+            "a background writer thread.");
+#endif
+  }
 }
 
 void close_track_file()
 {
+  // Write out remaining buffered tracks and wait for them to be written
+  for (auto& buffer : track_buffers) {
+    flush_track_buffer(buffer);
+  }
+  track_buffers.clear();
+  if (track_writer_active) {
+    {
+      std::lock_guard<std::mutex> lock(track_writer_mutex);
+      track_writer_done = true;
+    }
+    track_cv.notify_one();
+    track_writer.join();
+    track_writer_active = false;
+  }
+
+  for (auto dset : track_dsets) {
+    H5Dclose(dset);
+  }
+  H5Tclose(particle_dtype);
+  H5Tclose(history_dtype);
+  H5Tclose(track_filetype);
   H5Tclose(track_dtype);
   file_close(track_file);
 
@@ -92,6 +375,15 @@ void close_track_file()
 bool check_track_criteria(const Particle& p)
 {
   if (settings::write_all_tracks) {
+    // Sample whether to write tracks for this particle. A copy of the seed of
+    // a stream that is not used during transport is drawn from so that the
+    // random numbers used for tracking are not changed.
+    if (settings::track_fraction < 1.0) {
+      uint64_t seed = p.seeds(STREAM_VOLUME);
+      if (prn(&seed) >= settings::track_fraction)
+        return false;
+    }
+
     // Increment number of tracks written and get previous value
     int n;
 #pragma omp atomic capture
@@ -115,40 +407,45 @@ bool check_track_criteria(const Particle& p)
 
 void finalize_particle_track(Particle& p)
 {
-  // Determine number of coordinates for each particle
-  vector<int> offsets;
-  vector<int> particles;
-  vector<TrackState> tracks;
-  int offset = 0;
+#ifdef _OPENMP
+  auto& buffer = track_buffers[omp_get_thread_num()];
+#else
+  auto& buffer = track_buffers[0];
+#endif
+
+  // Copy history into this thread's buffer
+  int n_particles = 0;
   for (auto& track_i : p.tracks()) {
-    offsets.push_back(offset);
-    particles.push_back(static_cast<int>(track_i.particle));
-    offset += track_i.states.size();
-    tracks.insert(tracks.end(), track_i.states.begin(), track_i.states.end());
+    const auto& states = track_i.states;
+
+    // Skip primary/secondary particles with no state in the region of interest
+    if (!settings::track_region.empty() &&
+        std::none_of(states.begin(), states.end(), in_track_region))
+      continue;
+
+    buffer.particles.push_back({static_cast<int>(track_i.particle),
+      static_cast<int64_t>(states.size())});
+    size_t start = buffer.states.size();
+    buffer.states.insert(buffer.states.end(), states.begin(), states.end());
+    ++n_particles;
+
+    // Store each position after the first as the displacement from the
+    // previous state. Displacements are small and similar from state to state,
+    // so they lose less in single precision and compress better.
+    if (settings::track_delta_positions) {
+      for (size_t i = buffer.states.size() - 1; i > start; --i) {
+        buffer.states[i].r -= buffer.states[i - 1].r;
+      }
+    }
+  }
+  if (n_particles > 0) {
+    buffer.histories.push_back({simulation::current_batch,
+      simulation::current_gen, p.id(), n_particles});
   }
-  offsets.push_back(offset);
 
-#pragma omp critical(FinalizeParticleTrack)
-  {
-    // Create name for dataset
-    std::string dset_name = fmt::format("track_{}_{}_{}",
-      simulation::current_batch, simulation::current_gen, p.id());
-
-    // Write array of TrackState to file
-    hsize_t dims[] {static_cast<hsize_t>(tracks.size())};
-    hid_t dspace = H5Screate_simple(1, dims, nullptr);
-    hid_t dset = H5Dcreate(track_file, dset_name.c_str(), track_dtype, dspace,
-      H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-    H5Dwrite(dset, track_dtype, H5S_ALL, H5S_ALL, H5P_DEFAULT, tracks.data());
-
-    // Write attributes
-    write_attribute(dset, "n_particles", p.tracks().size());
-    write_attribute(dset, "offsets", offsets);
-    write_attribute(dset, "particles", particles);
-
-    // Free resources
-    H5Dclose(dset);
-    H5Sclose(dspace);
+  // Write buffer once it is large enough to make for an efficient append
+  if (buffer.states.size() >= TRACK_BUFFER_STATES) {
+    flush_track_buffer(buffer);
   }
 
   // Clear particle tracks
@@ -1,6 +1,9 @@
 #include "openmc/universe.h"
 
+#include <algorithm> // for max, nth_element
+#include <cmath>     // for abs
 #include <set>
+#include <utility>   // for pair
 
 #include "openmc/hdf5_interface.h"
 
@@ -13,6 +16,42 @@ vector<unique_ptr<Universe>> universes;
 
 } // namespace model
 
+//==============================================================================
+// Non-member functions
+//==============================================================================
+
+//! Check whether a cell contains the particle and, if so, set it as the cell
+//! of the particle's lowest coordinate level
+
+inline bool check_cell(Particle& p, int32_t i_cell)
+{
+  int32_t i_univ = p.coord(p.n_coord() - 1).universe;
+  if (model::cells[i_cell]->universe_ != i_univ)
+    return false;
+
+  // Check if this cell contains the particle;
+  Position r {p.r_local()};
+  Direction u {p.u_local()};
+  auto surf = p.surface();
+  if (model::cells[i_cell]->contains(r, u, surf, &p.sense_cache())) {
+    p.coord(p.n_coord() - 1).cell = i_cell;
+    return true;
+  }
+  return false;
+}
+
+inline bool box_contains(const BoundingBox& b, Position r)
+{
+  return r.x >= b.xmin && r.x <= b.xmax && r.y >= b.ymin && r.y <= b.ymax &&
+         r.z >= b.zmin && r.z <= b.zmax;
+}
+
+inline bool box_overlaps(const BoundingBox& a, const BoundingBox& b)
+{
+  return a.xmin <= b.xmax && b.xmin <= a.xmax && a.ymin <= b.ymax &&
+         b.ymin <= a.ymax && a.zmin <= b.zmax && b.zmin <= a.zmax;
+}
+
 //==============================================================================
 // Universe implementation
 //==============================================================================
@@ -38,24 +77,25 @@ void Universe::to_hdf5(hid_t universes_group) const
 
 bool Universe::find_cell(Particle& p) const
 {
-  const auto& cells {
-    !partitioner_ ? cells_ : partitioner_->get_cells(p.r_local(), p.u_local())};
-
-  for (auto it = cells.begin(); it != cells.end(); it++) {
-    int32_t i_cell = *it;
-    int32_t i_univ = p.coord(p.n_coord() - 1).universe;
-    if (model::cells[i_cell]->universe_ != i_univ)
-      continue;
-
-    // Check if this cell contains the particle;
-    Position r {p.r_local()};
-    Direction u {p.u_local()};
-    auto surf = p.surface();
-    if (model::cells[i_cell]->contains(r, u, surf)) {
-      p.coord(p.n_coord() - 1).cell = i_cell;
-      return true;
+  // Only cells whose bounding boxes contain the particle are tested by the
+  // BVH, and only cells in the particle's partition by the partitioner.  If
+  // none of them contain it, e.g. because of roundoff at a bounding surface,
+  // fall back to testing every cell.
+  if (bvh_ && bvh_->find_cell(p))
+    return true;
+
+  if (partitioner_) {
+    const auto& cells {partitioner_->get_cells(p.r_local(), p.u_local())};
+    for (auto i_cell : cells) {
+      if (check_cell(p, i_cell))
+        return true;
     }
   }
+
+  for (auto i_cell : cells_) {
+    if (check_cell(p, i_cell))
+      return true;
+  }
   return false;
 }
 
@@ -73,148 +113,377 @@ BoundingBox Universe::bounding_box() const
   return bbox;
 }
 
+size_t Universe::memory_usage() const
+{
+  size_t bytes = sizeof(Universe) + sizeof(int32_t) * cells_.size();
+  if (partitioner_)
+    bytes += partitioner_->memory_usage();
+  if (bvh_)
+    bytes += bvh_->memory_usage();
+  return bytes;
+}
+
 //==============================================================================
 // UniversePartitioner implementation
 //==============================================================================
 
-UniversePartitioner::UniversePartitioner(const Universe& univ)
+// Maximum depth of the partition tree, and the number of cells at or below
+// which a partition is not divided further
+constexpr int PARTITION_MAX_DEPTH {32};
+constexpr int PARTITION_LEAF_CELLS {3};
+
+//! Determine on which sides of a dividing surface a cell may lie.
+//
+//! \param i_surf Index of a surface accepted by is_partition_surface()
+//! \param cell The cell
+//! \param bbox Bounding box of the cell
+//! \return Whether the cell may lie on the negative and the positive side
+
+std::pair<bool, bool> partition_sides(
+  int32_t i_surf, const Cell& cell, const BoundingBox& bbox)
 {
-  // Define an ordered set of surface indices that point to z-planes.  Use a
-  // functor to to order the set by the z0_ values of the corresponding planes.
-  struct compare_surfs {
-    bool operator()(const int32_t& i_surf, const int32_t& j_surf) const
-    {
-      const auto* surf = model::surfaces[i_surf].get();
-      const auto* zplane = dynamic_cast<const SurfaceZPlane*>(surf);
-      double zi = zplane->z0_;
-      surf = model::surfaces[j_surf].get();
-      zplane = dynamic_cast<const SurfaceZPlane*>(surf);
-      double zj = zplane->z0_;
-      return zi < zj;
+  // A simple cell bounded by the surface lies on one side of it
+  if (cell.simple_) {
+    for (auto token : cell.rpn_) {
+      if (token == i_surf + 1)
+        return {false, true};
+      if (token == -(i_surf + 1))
+        return {true, false};
     }
-  };
-  std::set<int32_t, compare_surfs> surf_set;
+  }
+
+  const auto* surf = model::surfaces[i_surf].get();
+  if (const auto* p = dynamic_cast<const SurfaceXPlane*>(surf)) {
+    return {bbox.xmin < p->x0_, bbox.xmax > p->x0_};
+  } else if (const auto* p = dynamic_cast<const SurfaceYPlane*>(surf)) {
+    return {bbox.ymin < p->y0_, bbox.ymax > p->y0_};
+  } else if (const auto* p = dynamic_cast<const SurfaceZPlane*>(surf)) {
+    return {bbox.zmin < p->z0_, bbox.zmax > p->z0_};
+  }
+
+  const auto* cyl = dynamic_cast<const SurfaceZCylinder*>(surf);
+
+  // A simple cell inside of a smaller concentric cylinder lies inside this
+  // one, and one outside of a larger concentric cylinder lies outside of it
+  if (cell.simple_) {
+    for (auto token : cell.rpn_) {
+      const auto* other = dynamic_cast<const SurfaceZCylinder*>(
+        model::surfaces[std::abs(token) - 1].get());
+      if (!other || other->x0_ != cyl->x0_ || other->y0_ != cyl->y0_)
+        continue;
+      if (token < 0 && other->radius_ <= cyl->radius_)
+        return {true, false};
+      if (token > 0 && other->radius_ >= cyl->radius_)
+        return {false, true};
+    }
+  }
 
-  // Find all of the z-planes in this universe.  A set is used here for the
-  // O(log(n)) insertions that will ensure entries are not repeated.
+  // A cell whose bounding box misses the cylinder's lies outside of it
+  if (bbox.xmax <= cyl->x0_ - cyl->radius_ ||
+      bbox.xmin >= cyl->x0_ + cyl->radius_ ||
+      bbox.ymax <= cyl->y0_ - cyl->radius_ ||
+      bbox.ymin >= cyl->y0_ + cyl->radius_)
+    return {false, true};
+  return {true, true};
+}
+
+UniversePartitioner::UniversePartitioner(const Universe& univ)
+{
+  // Find all of the surfaces in this universe that can divide it.  A set is
+  // used here so that the surfaces are unique and in a reproducible order.
+  std::set<int32_t> surf_set;
   for (auto i_cell : univ.cells_) {
     for (auto token : model::cells[i_cell]->rpn_) {
       if (token < OP_UNION) {
         auto i_surf = std::abs(token) - 1;
-        const auto* surf = model::surfaces[i_surf].get();
-        if (const auto* zplane = dynamic_cast<const SurfaceZPlane*>(surf))
+        if (is_partition_surface(*model::surfaces[i_surf]))
           surf_set.insert(i_surf);
       }
     }
   }
-
-  // Populate the surfs_ vector from the ordered set.
   surfs_.insert(surfs_.begin(), surf_set.begin(), surf_set.end());
 
-  // Populate the partition lists.
-  partitions_.resize(surfs_.size() + 1);
+  // Determine the bounding box of each cell
+  vector<BoundingBox> boxes;
   for (auto i_cell : univ.cells_) {
-    // It is difficult to determine the bounds of a complex cell, so add complex
-    // cells to all partitions.
-    if (!model::cells[i_cell]->simple_) {
-      for (auto& p : partitions_)
-        p.push_back(i_cell);
-      continue;
-    }
+    boxes.push_back(model::cells[i_cell]->bounding_box());
+  }
 
-    // Find the tokens for bounding z-planes.
-    int32_t lower_token = 0, upper_token = 0;
-    double min_z, max_z;
-    for (auto token : model::cells[i_cell]->rpn_) {
-      if (token < OP_UNION) {
-        const auto* surf = model::surfaces[std::abs(token) - 1].get();
-        if (const auto* zplane = dynamic_cast<const SurfaceZPlane*>(surf)) {
-          if (lower_token == 0 || zplane->z0_ < min_z) {
-            lower_token = token;
-            min_z = zplane->z0_;
-          }
-          if (upper_token == 0 || zplane->z0_ > max_z) {
-            upper_token = token;
-            max_z = zplane->z0_;
-          }
-        }
+  // Build the tree starting from all of the cells
+  vector<int32_t> cells(univ.cells_.size());
+  for (int32_t i = 0; i < cells.size(); ++i)
+    cells[i] = i;
+  build(univ, boxes, cells, 0);
+}
+
+bool UniversePartitioner::is_partition_surface(const Surface& surf)
+{
+  return dynamic_cast<const SurfaceXPlane*>(&surf) ||
+         dynamic_cast<const SurfaceYPlane*>(&surf) ||
+         dynamic_cast<const SurfaceZPlane*>(&surf) ||
+         dynamic_cast<const SurfaceZCylinder*>(&surf);
+}
+
+int32_t UniversePartitioner::build(const Universe& univ,
+  const vector<BoundingBox>& boxes, const vector<int32_t>& cells, int depth)
+{
+  int32_t i_node = nodes_.size();
+  nodes_.push_back({C_NONE, C_NONE, C_NONE});
+
+  // Choose the surface that best balances the number of cells on either side,
+  // preferring the one that duplicates the fewest cells.  A surface is only
+  // useful if both sides have fewer cells than this node.
+  int n = cells.size();
+  int32_t best_surf = C_NONE;
+  int best_max = n;
+  int best_sum = 0;
+  if (n > PARTITION_LEAF_CELLS && depth < PARTITION_MAX_DEPTH) {
+    for (auto i_surf : surfs_) {
+      int n_neg = 0;
+      int n_pos = 0;
+      for (auto i : cells) {
+        auto sides =
+          partition_sides(i_surf, *model::cells[univ.cells_[i]], boxes[i]);
+        n_neg += sides.first;
+        n_pos += sides.second;
+      }
+      int n_max = std::max(n_neg, n_pos);
+      if (n_max < best_max || (n_max == best_max && best_surf != C_NONE &&
+                                n_neg + n_pos < best_sum)) {
+        best_surf = i_surf;
+        best_max = n_max;
+        best_sum = n_neg + n_pos;
       }
     }
+  }
 
-    // If there are no bounding z-planes, add this cell to all partitions.
-    if (lower_token == 0) {
-      for (auto& p : partitions_)
-        p.push_back(i_cell);
-      continue;
-    }
+  // If no surface divides the cells, this node is a leaf listing them in the
+  // order they appear in the universe
+  if (best_surf == C_NONE) {
+    vector<int32_t> partition;
+    for (auto i : cells)
+      partition.push_back(univ.cells_[i]);
+    nodes_[i_node].neg = partitions_.size();
+    partitions_.push_back(std::move(partition));
+    return i_node;
+  }
 
-    // Find the first partition this cell lies in.  If the lower_token indicates
-    // a negative halfspace, then the cell is unbounded in the lower direction
-    // and it lies in the first partition onward.  Otherwise, it is bounded by
-    // the positive halfspace given by the lower_token.
-    int first_partition = 0;
-    if (lower_token > 0) {
-      for (int i = 0; i < surfs_.size(); ++i) {
-        if (lower_token == surfs_[i] + 1) {
-          first_partition = i + 1;
-          break;
-        }
+  // Split the cells between the two sides of the surface
+  vector<int32_t> neg_cells;
+  vector<int32_t> pos_cells;
+  for (auto i : cells) {
+    auto sides =
+      partition_sides(best_surf, *model::cells[univ.cells_[i]], boxes[i]);
+    if (sides.first)
+      neg_cells.push_back(i);
+    if (sides.second)
+      pos_cells.push_back(i);
+  }
+
+  nodes_[i_node].surf = best_surf;
+  int32_t neg = build(univ, boxes, neg_cells, depth + 1);
+  int32_t pos = build(univ, boxes, pos_cells, depth + 1);
+  nodes_[i_node].neg = neg;
+  nodes_[i_node].pos = pos;
+  return i_node;
+}
+
+const vector<int32_t>& UniversePartitioner::get_cells(
+  Position r, Direction u) const
+{
+  // Descend the tree according to the sense of the coordinates for each
+  // dividing surface until reaching a leaf.
+  const Node* node = &nodes_[0];
+  while (node->surf != C_NONE) {
+    bool sense = model::surface_store.sense(node->surf, r, u);
+    node = &nodes_[sense ? node->pos : node->neg];
+  }
+  return partitions_[node->neg];
+}
+
+size_t UniversePartitioner::memory_usage() const
+{
+  size_t bytes = sizeof(int32_t) * surfs_.size() + sizeof(Node) * nodes_.size();
+  for (const auto& partition : partitions_) {
+    bytes += sizeof(int32_t) * partition.size();
+  }
+  return bytes;
+}
+
+//==============================================================================
+// UniverseBVH implementation
+//==============================================================================
+
+// Maximum number of cells in a leaf of the BVH
+constexpr int32_t BVH_LEAF_CELLS {4};
+
+UniverseBVH::UniverseBVH(const vector<int32_t>& cells)
+{
+  // Determine the bounding box of each cell, padded so that particles sitting
+  // on a bounding surface are not excluded by roundoff, and a point inside it
+  // to sort cells by.  For directions in which a box is unbounded, the center
+  // is taken at the finite bound if there is one. Unbounded sides of a box
+  // are +/-INFTY rather than infinite.
+  auto pad_lower = [](double x) {
+    return x - FP_COINCIDENT * std::max(1.0, std::abs(x));
+  };
+  auto pad_upper = [](double x) {
+    return x + FP_COINCIDENT * std::max(1.0, std::abs(x));
+  };
+  auto center = [](double lower, double upper) {
+    bool unbounded_lower = lower <= -0.5 * INFTY;
+    bool unbounded_upper = upper >= 0.5 * INFTY;
+    if (unbounded_lower)
+      return unbounded_upper ? 0.0 : upper;
+    return unbounded_upper ? lower : 0.5 * (lower + upper);
+  };
+
+  int32_t n = cells.size();
+  vector<BoundingBox> boxes(n);
+  vector<Position> centers(n);
+  for (int32_t i = 0; i < n; ++i) {
+    auto b = model::cells[cells[i]]->bounding_box();
+    centers[i] = {center(b.xmin, b.xmax), center(b.ymin, b.ymax),
+      center(b.zmin, b.zmax)};
+    boxes[i] = {pad_lower(b.xmin), pad_upper(b.xmax), pad_lower(b.ymin),
+      pad_upper(b.ymax), pad_lower(b.zmin), pad_upper(b.zmax)};
+  }
+
+  // Build the tree over a permutation of the cells
+  vector<int32_t> order(n);
+  for (int32_t i = 0; i < n; ++i)
+    order[i] = i;
+  build(order, boxes, centers, 0, n);
+
+  // Store the cells and their boxes in leaf order
+  for (auto i : order) {
+    cells_.push_back(cells[i]);
+    boxes_.push_back(boxes[i]);
+  }
+}
+
+void UniverseBVH::build(vector<int32_t>& order,
+  const vector<BoundingBox>& boxes, const vector<Position>& centers,
+  int32_t begin, int32_t end)
+{
+  // Determine the bounds of the node and of the centers of its cells
+  BoundingBox bbox = {INFTY, -INFTY, INFTY, -INFTY, INFTY, -INFTY};
+  BoundingBox center_bbox = {INFTY, -INFTY, INFTY, -INFTY, INFTY, -INFTY};
+  for (int32_t i = begin; i < end; ++i) {
+    const auto& c = centers[order[i]];
+    bbox |= boxes[order[i]];
+    center_bbox |= {c.x, c.x, c.y, c.y, c.z, c.z};
+  }
+
+  int32_t i_node = nodes_.size();
+  nodes_.push_back({bbox, begin, end - begin});
+
+  // Split along the direction in which the centers are most spread out
+  Position extent {center_bbox.xmax - center_bbox.xmin,
+    center_bbox.ymax - center_bbox.ymin, center_bbox.zmax - center_bbox.zmin};
+  int axis = 0;
+  if (extent.y > extent[axis])
+    axis = 1;
+  if (extent.z > extent[axis])
+    axis = 2;
+
+  // Make a leaf if there are few cells or they cannot be separated
+  if (end - begin <= BVH_LEAF_CELLS || extent[axis] == 0.0)
+    return;
+
+  // Divide the cells at the median of their centers
+  int32_t middle = begin + (end - begin) / 2;
+  std::nth_element(order.begin() + begin, order.begin() + middle,
+    order.begin() + end, [&centers, axis](int32_t i, int32_t j) {
+      return centers[i][axis] < centers[j][axis];
+    });
+
+  // The left child immediately follows its parent
+  build(order, boxes, centers, begin, middle);
+  nodes_[i_node].index = nodes_.size();
+  nodes_[i_node].n_cells = 0;
+  build(order, boxes, centers, middle, end);
+}
+
+bool UniverseBVH::find_cell(Particle& p) const
+{
+  // Traverse the tree depth-first, keeping a stack of right children that
+  // remain to be visited.  A median split keeps the depth below log2(n) + 1.
+  Position r {p.r_local()};
+  int32_t stack[64];
+  int n_stack = 0;
+  int32_t i_node = 0;
+  while (true) {
+    const auto& node = nodes_[i_node];
+    if (box_contains(node.bbox, r)) {
+      if (node.n_cells == 0) {
+        // Visit the left child next
+        stack[n_stack++] = node.index;
+        ++i_node;
+        continue;
       }
-    }
 
-    // Find the last partition this cell lies in.  The logic is analogous to the
-    // logic for first_partition.
-    int last_partition = surfs_.size();
-    if (upper_token < 0) {
-      for (int i = first_partition; i < surfs_.size(); ++i) {
-        if (upper_token == -(surfs_[i] + 1)) {
-          last_partition = i;
-          break;
-        }
+      // Test each cell in the leaf whose bounding box contains the particle
+      for (int32_t i = node.index; i < node.index + node.n_cells; ++i) {
+        if (box_contains(boxes_[i], r) && check_cell(p, cells_[i]))
+          return true;
       }
     }
 
-    // Add the cell to all relevant partitions.
-    for (int i = first_partition; i <= last_partition; ++i) {
-      partitions_[i].push_back(i_cell);
-    }
+    if (n_stack == 0)
+      return false;
+    i_node = stack[--n_stack];
   }
 }
 
-const vector<int32_t>& UniversePartitioner::get_cells(
-  Position r, Direction u) const
+void UniverseBVH::find_candidates(Position r, vector<int32_t>& cells) const
 {
-  // Perform a binary search for the partition containing the given coordinates.
-  int left = 0;
-  int middle = (surfs_.size() - 1) / 2;
-  int right = surfs_.size() - 1;
+  int32_t stack[64];
+  int n_stack = 0;
+  int32_t i_node = 0;
   while (true) {
-    // Check the sense of the coordinates for the current surface.
-    const auto& surf = *model::surfaces[surfs_[middle]];
-    if (surf.sense(r, u)) {
-      // The coordinates lie in the positive halfspace.  Recurse if there are
-      // more surfaces to check.  Otherwise, return the cells on the positive
-      // side of this surface.
-      int right_leaf = right - (right - middle) / 2;
-      if (right_leaf != middle) {
-        left = middle + 1;
-        middle = right_leaf;
-      } else {
-        return partitions_[middle + 1];
+    const auto& node = nodes_[i_node];
+    if (box_contains(node.bbox, r)) {
+      if (node.n_cells == 0) {
+        stack[n_stack++] = node.index;
+        ++i_node;
+        continue;
       }
+      for (int32_t i = node.index; i < node.index + node.n_cells; ++i) {
+        if (box_contains(boxes_[i], r))
+          cells.push_back(cells_[i]);
+      }
+    }
 
-    } else {
-      // The coordinates lie in the negative halfspace.  Recurse if there are
-      // more surfaces to check.  Otherwise, return the cells on the negative
-      // side of this surface.
-      int left_leaf = left + (middle - left) / 2;
-      if (left_leaf != middle) {
-        right = middle - 1;
-        middle = left_leaf;
-      } else {
-        return partitions_[middle];
+    if (n_stack == 0)
+      return;
+    i_node = stack[--n_stack];
+  }
+}
+
+void UniverseBVH::find_overlapping(
+  const BoundingBox& box, vector<int32_t>& cells) const
+{
+  int32_t stack[64];
+  int n_stack = 0;
+  int32_t i_node = 0;
+  while (true) {
+    const auto& node = nodes_[i_node];
+    if (box_overlaps(node.bbox, box)) {
+      if (node.n_cells == 0) {
+        stack[n_stack++] = node.index;
+        ++i_node;
+        continue;
+      }
+      for (int32_t i = node.index; i < node.index + node.n_cells; ++i) {
+        if (box_overlaps(boxes_[i], box))
+          cells.push_back(cells_[i]);
       }
     }
+
+    if (n_stack == 0)
+      return;
+    i_node = stack[--n_stack];
   }
 }
 
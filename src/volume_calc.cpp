@@ -3,6 +3,7 @@
 #include "openmc/capi.h"
 #include "openmc/cell.h"
 #include "openmc/constants.h"
+#include "openmc/distribution_multi.h"
 #include "openmc/error.h"
 #include "openmc/geometry.h"
 #include "openmc/hdf5_interface.h"
@@ -11,9 +12,11 @@
 #include "openmc/mgxs_interface.h"
 #include "openmc/nuclide.h"
 #include "openmc/output.h"
+#include "openmc/particle.h"
 #include "openmc/random_lcg.h"
 #include "openmc/settings.h"
 #include "openmc/timer.h"
+#include "openmc/universe.h"
 #include "openmc/xml_interface.h"
 
 #include <fmt/core.h>
@@ -23,8 +26,10 @@
 #include "xtensor/xadapt.hpp"
 #include "xtensor/xview.hpp"
 
-#include <algorithm> // for copy
+#include <algorithm> // for copy, max, min, sort
 #include <cmath>     // for pow, sqrt
+#include <map>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace openmc {
@@ -63,6 +68,19 @@ VolumeCalculation::VolumeCalculation(pugi::xml_node node)
   upper_right_ = get_node_array<double>(node, "upper_right");
   n_samples_ = std::stoull(get_node_value(node, "samples"));
 
+  // Read whether points or rays are sampled
+  if (check_for_node(node, "estimator")) {
+    std::string estimator = get_node_value(node, "estimator", true, true);
+    if (estimator == "point") {
+      estimator_ = Estimator::POINT;
+    } else if (estimator == "ray") {
+      estimator_ = Estimator::RAY;
+    } else {
+      fatal_error("Unrecognized estimator for stochastic volume calculation: " +
+                  estimator);
+    }
+  }
+
   if (check_for_node(node, "threshold")) {
     pugi::xml_node threshold_node = node.child("threshold");
 
@@ -97,12 +115,27 @@ VolumeCalculation::VolumeCalculation(pugi::xml_node node)
 
 vector<VolumeCalculation::Result> VolumeCalculation::execute() const
 {
-  // Shared data that is collected from all threads
+  // Rays are tracked with distances to CSG surfaces
+  if (estimator_ == Estimator::RAY) {
+    for (const auto& univ : model::universes) {
+      if (univ->geom_type() == GeometryType::DAG) {
+        fatal_error("The ray estimator for stochastic volume calculations is "
+                    "not supported with DAGMC geometry.");
+      }
+    }
+  }
+
+  // Map each domain ID to its index so that hits are found in constant time
   int n = domain_ids_.size();
-  vector<vector<int>> master_indices(
-    n); // List of material indices for each domain
-  vector<vector<int>> master_hits(
-    n); // Number of hits for each material in each domain
+  std::unordered_map<int, int> domain_index;
+  for (int i_domain = 0; i_domain < n; ++i_domain) {
+    domain_index[domain_ids_[i_domain]] = i_domain;
+  }
+
+  // Shared data that is collected from all threads. Sums for materials are
+  // ordered by domain so that they can be processed one domain at a time.
+  vector<double> master_volume_sums(2 * n, 0.0);
+  std::map<int64_t, array<double, 2>> master_material_sums;
   int iterations = 0;
 
   // Divide work over MPI processes
@@ -123,8 +156,9 @@ vector<VolumeCalculation::Result> VolumeCalculation::execute() const
 #pragma omp parallel
     {
       // Variables that are private to each thread
-      vector<vector<int>> indices(n);
-      vector<vector<int>> hits(n);
+      vector<double> volume_sums(2 * n, 0.0);
+      HitSums material_sums;
+      SampleHits sample;
       Particle p;
 
 // Sample locations and count hits
@@ -133,53 +167,16 @@ vector<VolumeCalculation::Result> VolumeCalculation::execute() const
         int64_t id = iterations * n_samples_ + i;
         uint64_t seed = init_seed(id, STREAM_VOLUME);
 
-        p.n_coord() = 1;
-        Position xi {prn(&seed), prn(&seed), prn(&seed)};
-        p.r() = lower_left_ + xi * (upper_right_ - lower_left_);
-        p.u() = {0.5, 0.5, 0.5};
-
-        // If this location is not in the geometry at all, move on to next block
-        if (!exhaustive_find_cell(p))
-          continue;
-
-        if (domain_type_ == TallyDomain::MATERIAL) {
-          if (p.material() != MATERIAL_VOID) {
-            for (int i_domain = 0; i_domain < n; i_domain++) {
-              if (model::materials[p.material()]->id_ ==
-                  domain_ids_[i_domain]) {
-                this->check_hit(
-                  p.material(), indices[i_domain], hits[i_domain]);
-                break;
-              }
-            }
-          }
-        } else if (domain_type_ == TallyDomain::CELL) {
-          for (int level = 0; level < p.n_coord(); ++level) {
-            for (int i_domain = 0; i_domain < n; i_domain++) {
-              if (model::cells[p.coord(level).cell]->id_ ==
-                  domain_ids_[i_domain]) {
-                this->check_hit(
-                  p.material(), indices[i_domain], hits[i_domain]);
-                break;
-              }
-            }
-          }
-        } else if (domain_type_ == TallyDomain::UNIVERSE) {
-          for (int level = 0; level < p.n_coord(); ++level) {
-            for (int i_domain = 0; i_domain < n; ++i_domain) {
-              if (model::universes[p.coord(level).universe]->id_ ==
-                  domain_ids_[i_domain]) {
-                check_hit(p.material(), indices[i_domain], hits[i_domain]);
-                break;
-              }
-            }
-          }
+        if (estimator_ == Estimator::RAY) {
+          this->sample_ray(&seed, p, domain_index, sample);
+        } else {
+          this->sample_point(&seed, p, domain_index, sample);
         }
+        this->add_sample(sample, volume_sums, material_sums);
       }
 
-      // At this point, each thread has its own pair of index/hits lists and we
-      // now need to reduce them. OpenMP is not nearly smart enough to do this
-      // on its own, so we have to manually reduce them
+      // At this point, each thread has its own sums, which are added to the
+      // master sums in thread order so that results are reproducible
 
 #ifdef _OPENMP
       int n_threads = omp_get_num_threads();
@@ -190,31 +187,70 @@ vector<VolumeCalculation::Result> VolumeCalculation::execute() const
 #pragma omp for ordered schedule(static)
       for (int i = 0; i < n_threads; ++i) {
 #pragma omp ordered
-        for (int i_domain = 0; i_domain < n; ++i_domain) {
-          for (int j = 0; j < indices[i_domain].size(); ++j) {
-            // Check if this material has been added to the master list and if
-            // so, accumulate the number of hits
-            bool already_added = false;
-            for (int k = 0; k < master_indices[i_domain].size(); k++) {
-              if (indices[i_domain][j] == master_indices[i_domain][k]) {
-                master_hits[i_domain][k] += hits[i_domain][j];
-                already_added = true;
-                break;
-              }
-            }
-            if (!already_added) {
-              // If we made it here, the material hasn't yet been added to the
-              // master list, so add entries to the master indices and master
-              // hits lists
-              master_indices[i_domain].push_back(indices[i_domain][j]);
-              master_hits[i_domain].push_back(hits[i_domain][j]);
-            }
+        {
+          for (int j = 0; j < 2 * n; ++j) {
+            master_volume_sums[j] += volume_sums[j];
+          }
+          for (const auto& s : material_sums) {
+            auto& sums = master_material_sums[s.first];
+            sums[0] += s.second[0];
+            sums[1] += s.second[1];
           }
         }
       }
     } // omp parallel
 
-    // Reduce hits onto master process
+#ifdef OPENMC_MPI
+    // Reduce sums onto master process
+    MPI_Reduce(mpi::master ? MPI_IN_PLACE : master_volume_sums.data(),
+      master_volume_sums.data(), 2 * n, MPI_DOUBLE, MPI_SUM, 0,
+      mpi::intracomm);
+
+    // Flatten the sums for materials of the other processes so that they can
+    // be gathered at once
+    vector<int64_t> keys;
+    vector<double> values;
+    if (!mpi::master) {
+      for (const auto& s : master_material_sums) {
+        keys.push_back(s.first);
+        values.push_back(s.second[0]);
+        values.push_back(s.second[1]);
+      }
+    }
+    int n_keys = keys.size();
+    vector<int> counts(mpi::n_procs, 0);
+    MPI_Gather(
+      &n_keys, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, mpi::intracomm);
+    vector<int> displs(mpi::n_procs, 0);
+    for (int j = 1; j < mpi::n_procs; ++j) {
+      displs[j] = displs[j - 1] + counts[j - 1];
+    }
+    vector<int64_t> all_keys(mpi::master ? displs.back() + counts.back() : 0);
+    MPI_Gatherv(keys.data(), n_keys, MPI_INT64_T, all_keys.data(),
+      counts.data(), displs.data(), MPI_INT64_T, 0, mpi::intracomm);
+
+    // Each key has a sum and a sum of squares
+    for (int j = 0; j < mpi::n_procs; ++j) {
+      counts[j] *= 2;
+      displs[j] *= 2;
+    }
+    vector<double> all_values(2 * all_keys.size());
+    MPI_Gatherv(values.data(), 2 * n_keys, MPI_DOUBLE, all_values.data(),
+      counts.data(), displs.data(), MPI_DOUBLE, 0, mpi::intracomm);
+
+    if (mpi::master) {
+      for (int k = 0; k < all_keys.size(); ++k) {
+        auto& sums = master_material_sums[all_keys[k]];
+        sums[0] += all_values[2 * k];
+        sums[1] += all_values[2 * k + 1];
+      }
+    } else {
+      // If iterating in an MPI run, the sums that were sent to the master
+      // need to be zeroed so they aren't counted twice
+      std::fill(master_volume_sums.begin(), master_volume_sums.end(), 0.0);
+      master_material_sums.clear();
+    }
+#endif
 
     // Determine volume of bounding box
     Position d {upper_right_ - lower_left_};
@@ -231,6 +267,8 @@ vector<VolumeCalculation::Result> VolumeCalculation::execute() const
     // Set size for members of the Result struct
     vector<Result> results(n);
 
+    int n_slots = model::materials.size() + 1;
+    auto it = master_material_sums.begin();
     for (int i_domain = 0; i_domain < n; ++i_domain) {
       // Get reference to result for this domain
       auto& result {results[i_domain]};
@@ -242,53 +280,16 @@ vector<VolumeCalculation::Result> VolumeCalculation::execute() const
                                     : data::mg.nuclides_.size();
       xt::xtensor<double, 2> atoms({n_nuc, 2}, 0.0);
 
-#ifdef OPENMC_MPI
       if (mpi::master) {
-        for (int j = 1; j < mpi::n_procs; j++) {
-          int q;
-          MPI_Recv(
-            &q, 1, MPI_INTEGER, j, 2 * j, mpi::intracomm, MPI_STATUS_IGNORE);
-          vector<int> buffer(2 * q);
-          MPI_Recv(buffer.data(), 2 * q, MPI_INTEGER, j, 2 * j + 1,
-            mpi::intracomm, MPI_STATUS_IGNORE);
-          for (int k = 0; k < q; ++k) {
-            bool already_added = false;
-            for (int m = 0; m < master_indices[i_domain].size(); ++m) {
-              if (buffer[2 * k] == master_indices[i_domain][m]) {
-                master_hits[i_domain][m] += buffer[2 * k + 1];
-                already_added = true;
-                break;
-              }
-            }
-            if (!already_added) {
-              master_indices[i_domain].push_back(buffer[2 * k]);
-              master_hits[i_domain].push_back(buffer[2 * k + 1]);
-            }
-          }
-        }
-      } else {
-        int q = master_indices[i_domain].size();
-        vector<int> buffer(2 * q);
-        for (int k = 0; k < q; ++k) {
-          buffer[2 * k] = master_indices[i_domain][k];
-          buffer[2 * k + 1] = master_hits[i_domain][k];
-        }
-
-        MPI_Send(&q, 1, MPI_INTEGER, 0, 2 * mpi::rank, mpi::intracomm);
-        MPI_Send(buffer.data(), 2 * q, MPI_INTEGER, 0, 2 * mpi::rank + 1,
-          mpi::intracomm);
-      }
-#endif
-
-      if (mpi::master) {
-        int total_hits = 0;
-        for (int j = 0; j < master_indices[i_domain].size(); ++j) {
-          total_hits += master_hits[i_domain][j];
-          double f =
-            static_cast<double>(master_hits[i_domain][j]) / total_samples;
-          double var_f = f * (1.0 - f) / total_samples;
-
-          int i_material = master_indices[i_domain][j];
+        // Accumulate nuclide densities over the materials found in the domain
+        int64_t next_domain = this->hit_key(i_domain + 1, MATERIAL_VOID);
+        for (; it != master_material_sums.end() && it->first < next_domain;
+             ++it) {
+          double f = it->second[0] / total_samples;
+          double var_f =
+            (it->second[1] / total_samples - f * f) / total_samples;
+
+          int i_material = it->first % n_slots - 1;
           if (i_material == MATERIAL_VOID)
             continue;
 
@@ -302,11 +303,12 @@ vector<VolumeCalculation::Result> VolumeCalculation::execute() const
         }
 
         // Determine volume
-        result.volume[0] =
-          static_cast<double>(total_hits) / total_samples * volume_sample;
-        result.volume[1] =
-          std::sqrt(result.volume[0] * (volume_sample - result.volume[0]) /
-                    total_samples);
+        double f = master_volume_sums[2 * i_domain] / total_samples;
+        double var_f =
+          (master_volume_sums[2 * i_domain + 1] / total_samples - f * f) /
+          total_samples;
+        result.volume[0] = f * volume_sample;
+        result.volume[1] = std::sqrt(std::max(var_f, 0.0)) * volume_sample;
         result.iterations = iterations;
 
         // update threshold value if needed
@@ -362,20 +364,6 @@ vector<VolumeCalculation::Result> VolumeCalculation::execute() const
     if (trigger_val < threshold_) {
       return results;
     }
-
-#ifdef OPENMC_MPI
-    // if iterating in an MPI run, need to zero indices and hits so they aren't
-    // counted twice
-    if (!mpi::master) {
-      for (auto& v : master_indices) {
-        std::fill(v.begin(), v.end(), 0);
-      }
-      for (auto& v : master_hits) {
-        std::fill(v.begin(), v.end(), 0);
-      }
-    }
-#endif
-
   } // end while
 }
 
@@ -463,25 +451,127 @@ void VolumeCalculation::to_hdf5(
   file_close(file_id);
 }
 
-void VolumeCalculation::check_hit(
-  int i_material, vector<int>& indices, vector<int>& hits) const
+int64_t VolumeCalculation::hit_key(int i_domain, int i_material) const
+{
+  int64_t n_slots = model::materials.size() + 1;
+  return i_domain * n_slots + i_material + 1;
+}
+
+void VolumeCalculation::score_domains(const Particle& p, double fraction,
+  const std::unordered_map<int, int>& domain_index, SampleHits& sample) const
 {
+  auto score = [&](int id) {
+    auto it = domain_index.find(id);
+    if (it != domain_index.end()) {
+      sample.emplace_back(this->hit_key(it->second, p.material()), fraction);
+    }
+  };
 
-  // Check if this material was previously hit and if so, increment count
-  bool already_hit = false;
-  for (int j = 0; j < indices.size(); j++) {
-    if (indices[j] == i_material) {
-      hits[j]++;
-      already_hit = true;
+  if (domain_type_ == TallyDomain::MATERIAL) {
+    if (p.material() != MATERIAL_VOID) {
+      score(model::materials[p.material()]->id_);
+    }
+  } else if (domain_type_ == TallyDomain::CELL) {
+    for (int level = 0; level < p.n_coord(); ++level) {
+      score(model::cells[p.coord(level).cell]->id_);
+    }
+  } else if (domain_type_ == TallyDomain::UNIVERSE) {
+    for (int level = 0; level < p.n_coord(); ++level) {
+      score(model::universes[p.coord(level).universe]->id_);
     }
   }
+}
+
+void VolumeCalculation::sample_point(uint64_t* seed, Particle& p,
+  const std::unordered_map<int, int>& domain_index, SampleHits& sample) const
+{
+  p.n_coord() = 1;
+  Position xi {prn(seed), prn(seed), prn(seed)};
+  p.r() = lower_left_ + xi * (upper_right_ - lower_left_);
+  p.u() = {0.5, 0.5, 0.5};
+
+  // If this location is not in the geometry at all, there is no hit
+  if (exhaustive_find_cell(p))
+    this->score_domains(p, 1.0, domain_index, sample);
+}
+
+void VolumeCalculation::sample_ray(uint64_t* seed, Particle& p,
+  const std::unordered_map<int, int>& domain_index, SampleHits& sample) const
+{
+  // Sample a line through a point in the bounding box in an isotropic
+  // direction
+  Position xi {prn(seed), prn(seed), prn(seed)};
+  Position r = lower_left_ + xi * (upper_right_ - lower_left_);
+  Direction u = isotropic_direction(seed);
+
+  // Find where the line enters and leaves the box
+  double t_enter = -INFTY;
+  double t_exit = INFTY;
+  for (int i = 0; i < 3; ++i) {
+    if (u[i] != 0.0) {
+      double t1 = (lower_left_[i] - r[i]) / u[i];
+      double t2 = (upper_right_[i] - r[i]) / u[i];
+      t_enter = std::max(t_enter, std::min(t1, t2));
+      t_exit = std::min(t_exit, std::max(t1, t2));
+    }
+  }
+  double chord = t_exit - t_enter;
+  if (chord <= 0.0)
+    return;
+
+  // Track the chord through the geometry, finding the cell again after each
+  // boundary crossing
+  const auto& root = *model::universes[model::root_universe];
+  double traveled = 0.0;
+  while (traveled < chord) {
+    p.n_coord() = 1;
+    p.r() = r + (t_enter + traveled) * u;
+    p.u() = u;
+
+    double distance;
+    if (exhaustive_find_cell(p)) {
+      distance = distance_to_boundary(p).distance;
+      double length = std::min(distance, chord - traveled);
+      this->score_domains(p, length / chord, domain_index, sample);
+    } else {
+      // Outside of the geometry, skip to the next surface of a cell in the
+      // root universe, where the line may enter the geometry again
+      distance = INFTY;
+      for (int i_cell : root.cells_) {
+        distance = std::min(
+          distance, model::cells[i_cell]->distance(p.r(), u, 0, &p).first);
+      }
+    }
+    traveled += distance + TINY_BIT;
+  }
+}
 
-  // If the material was not previously hit, append an entry to the material
-  // indices and hits lists
-  if (!already_hit) {
-    indices.push_back(i_material);
-    hits.push_back(1);
+void VolumeCalculation::add_sample(
+  SampleHits& sample, vector<double>& volume_sums, HitSums& material_sums) const
+{
+  // Sorting groups the parts of a ray in the same material and domain, and
+  // the materials of a domain, which are combined before being squared
+  std::sort(sample.begin(), sample.end());
+  int64_t n_slots = model::materials.size() + 1;
+  size_t j = 0;
+  while (j < sample.size()) {
+    int i_domain = sample[j].first / n_slots;
+    double f_domain = 0.0;
+    while (j < sample.size() && sample[j].first / n_slots == i_domain) {
+      int64_t key = sample[j].first;
+      double f = 0.0;
+      for (; j < sample.size() && sample[j].first == key; ++j) {
+        f += sample[j].second;
+      }
+      auto& sums = material_sums[key];
+      sums[0] += f;
+      sums[1] += f * f;
+      f_domain += f;
+    }
+    volume_sums[2 * i_domain] += f_domain;
+    volume_sums[2 * i_domain + 1] += f_domain * f_domain;
   }
+  sample.clear();
 }
 
 void free_memory_volume()
@@ -1,12 +1,22 @@
 #include "openmc/weight_windows.h"
 
+#include <algorithm> // for max, max_element
+
 #include "openmc/error.h"
 #include "openmc/file_utils.h"
 #include "openmc/hdf5_interface.h"
+#include "openmc/message_passing.h"
 #include "openmc/particle.h"
 #include "openmc/particle_data.h"
 #include "openmc/physics_common.h"
 #include "openmc/search.h"
+#include "openmc/settings.h"
+#include "openmc/simulation.h"
+#include "openmc/source.h"
+#include "openmc/tallies/filter_energy.h"
+#include "openmc/tallies/filter_mesh.h"
+#include "openmc/tallies/filter_particle.h"
+#include "openmc/tallies/tally.h"
 #include "openmc/xml_interface.h"
 
 #include <fmt/core.h>
@@ -22,6 +32,7 @@ namespace variance_reduction {
 
 std::unordered_map<int32_t, int32_t> ww_map;
 openmc::vector<unique_ptr<WeightWindows>> weight_windows;
+openmc::vector<unique_ptr<WeightWindowsGenerator>> generators;
 
 } // namespace variance_reduction
 
@@ -80,6 +91,12 @@ void apply_weight_windows(Particle& p)
     double max_split = weight_window.max_split;
     n_split = std::min(n_split, max_split);
 
+    // do not split into more particles than there is room for in the
+    // secondary bank so that it never has to be reallocated
+    double n_free = static_cast<double>(settings::secondary_bank_capacity) -
+                    p.secondary_bank().size();
+    n_split = std::max(std::min(n_split, n_free + 1.0), 1.0);
+
     p.n_split() += n_split;
 
     // Create secondaries and divide weight among all particles
@@ -98,10 +115,43 @@ void apply_weight_windows(Particle& p)
   } // else particle is in the window, continue as normal
 }
 
+double distance_to_weight_window_boundary(const Particle& p)
+{
+  double distance = INFTY;
+  for (const auto& ww : variance_reduction::weight_windows) {
+    if (ww->particle_type() != p.type())
+      continue;
+    const auto* mesh = dynamic_cast<const StructuredMesh*>(&ww->mesh());
+    if (mesh) {
+      distance =
+        std::min(distance, mesh->distance_to_bin_boundary(p.r(), p.u()));
+    }
+  }
+  return distance;
+}
+
 void free_memory_weight_windows()
 {
   variance_reduction::ww_map.clear();
   variance_reduction::weight_windows.clear();
+  variance_reduction::generators.clear();
+}
+
+void create_weight_windows_generator_tallies()
+{
+  for (auto& generator : variance_reduction::generators) {
+    if (generator->method() == WeightWindowMethod::MAGIC)
+      generator->create_tally();
+  }
+}
+
+void update_weight_windows()
+{
+  for (auto& generator : variance_reduction::generators) {
+    if (generator->method() == WeightWindowMethod::MAGIC &&
+        simulation::current_batch % generator->update_interval() == 0)
+      generator->update();
+  }
 }
 
 //==============================================================================
@@ -134,9 +184,12 @@ WeightWindows::WeightWindows(pugi::xml_node node)
   // energy bounds
   energy_bounds_ = get_node_array<double>(node, "energy_bounds");
 
-  // read the lower/upper weight bounds
-  lower_ww_ = get_node_array<double>(node, "lower_ww_bounds");
-  upper_ww_ = get_node_array<double>(node, "upper_ww_bounds");
+  // read the lower/upper weight bounds, which are stored in single precision
+  // so that meshes with many bins fit in memory
+  auto bounds = get_node_array<double>(node, "lower_ww_bounds");
+  lower_ww_.assign(bounds.begin(), bounds.end());
+  bounds = get_node_array<double>(node, "upper_ww_bounds");
+  upper_ww_.assign(bounds.begin(), bounds.end());
 
   // get the survival value - optional
   if (check_for_node(node, "survival_ratio")) {
@@ -176,9 +229,9 @@ WeightWindows::WeightWindows(pugi::xml_node node)
   }
 
   // num spatial*energy bins must match num weight bins
-  int num_spatial_bins = this->mesh().n_bins();
-  int num_energy_bins = energy_bounds_.size() - 1;
-  int num_weight_bins = lower_ww_.size();
+  int64_t num_spatial_bins = this->mesh().n_bins();
+  int64_t num_energy_bins = energy_bounds_.size() - 1;
+  int64_t num_weight_bins = lower_ww_.size();
   if (num_weight_bins != num_spatial_bins * num_energy_bins) {
     auto err_msg =
       fmt::format("In weight window domain {} the number of spatial "
@@ -189,6 +242,16 @@ WeightWindows::WeightWindows(pugi::xml_node node)
   }
 }
 
+WeightWindows::WeightWindows(
+  int32_t mesh_idx, ParticleType type, vector<double> energy_bounds)
+  : particle_type_ {type}, energy_bounds_ {std::move(energy_bounds)},
+    mesh_idx_ {mesh_idx}
+{
+  int64_t n = this->mesh().n_bins() * (energy_bounds_.size() - 1);
+  lower_ww_.assign(n, -1.0f);
+  upper_ww_.assign(n, -1.0f);
+}
+
 void WeightWindows::set_id(int32_t id)
 {
   Expects(id >= 0 || id == C_NONE);
@@ -220,7 +283,7 @@ void WeightWindows::set_id(int32_t id)
     variance_reduction::weight_windows.size() - 1;
 }
 
-WeightWindow WeightWindows::get_weight_window(const Particle& p) const
+WeightWindow WeightWindows::get_weight_window(Particle& p) const
 {
   // check for particle type
   if (particle_type_ != p.type()) {
@@ -229,7 +292,7 @@ WeightWindow WeightWindows::get_weight_window(const Particle& p) const
 
   // Get mesh index for particle's position
   const auto& mesh = this->mesh();
-  int ww_index = mesh.get_bin(p.r());
+  int64_t ww_index = get_mesh_bin(p, mesh_idx_, p.r());
 
   // particle is outside the weight window mesh
   if (ww_index < 0)
@@ -242,9 +305,14 @@ WeightWindow WeightWindows::get_weight_window(const Particle& p) const
   if (E < energy_bounds_.front() || E > energy_bounds_.back())
     return {};
 
-  // get the mesh bin in energy group
-  int energy_bin =
-    lower_bound_index(energy_bounds_.begin(), energy_bounds_.end(), E);
+  // get the mesh bin in energy group, starting with the group of the last
+  // lookup since collisions often leave the energy in the same group
+  int& energy_bin = p.ww_energy_bin();
+  if (energy_bin < 0 || energy_bin >= energy_bounds_.size() - 1 ||
+      E <= energy_bounds_[energy_bin] || E > energy_bounds_[energy_bin + 1]) {
+    energy_bin =
+      lower_bound_index(energy_bounds_.begin(), energy_bounds_.end(), E);
+  }
 
   // indices now points to the correct weight for the given energy
   ww_index += energy_bin * mesh.n_bins();
@@ -260,6 +328,13 @@ WeightWindow WeightWindows::get_weight_window(const Particle& p) const
   return ww;
 }
 
+void WeightWindows::set_bounds(vector<float> lower, vector<float> upper)
+{
+  Expects(lower.size() == lower_ww_.size() && upper.size() == lower.size());
+  lower_ww_ = std::move(lower);
+  upper_ww_ = std::move(upper);
+}
+
 void WeightWindows::to_hdf5(hid_t group) const
 {
   hid_t ww_group = create_group(group, fmt::format("weight_windows {}", id_));
@@ -278,4 +353,185 @@ void WeightWindows::to_hdf5(hid_t group) const
   close_group(ww_group);
 }
 
+//==============================================================================
+// WeightWindowsGenerator implementation
+//==============================================================================
+
+WeightWindowsGenerator::WeightWindowsGenerator(pugi::xml_node node)
+{
+  // Determine associated mesh
+  if (!check_for_node(node, "mesh")) {
+    fatal_error("Must specify <mesh> for a weight window generator.");
+  }
+  int32_t mesh_id = std::stoi(get_node_value(node, "mesh"));
+  auto it = model::mesh_map.find(mesh_id);
+  if (it == model::mesh_map.end()) {
+    fatal_error(fmt::format(
+      "Mesh {} used by a weight window generator does not exist.", mesh_id));
+  }
+
+  // get the particle type - optional
+  ParticleType type = ParticleType::neutron;
+  if (check_for_node(node, "particle_type")) {
+    type = str_to_particle_type(get_node_value(node, "particle_type"));
+  }
+
+  // energy bounds - optional, a single group covering all energies otherwise
+  vector<double> energy_bounds {0.0, INFTY};
+  if (check_for_node(node, "energy_bounds")) {
+    energy_bounds = get_node_array<double>(node, "energy_bounds");
+    if (energy_bounds.size() < 2) {
+      fatal_error("At least two energy bounds must be given for a weight "
+                  "window generator.");
+    }
+  }
+
+  // get the number of batches between updates - optional
+  if (check_for_node(node, "update_interval")) {
+    update_interval_ = std::stoi(get_node_value(node, "update_interval"));
+    if (update_interval_ < 1)
+      fatal_error("Weight window update interval must be at least 1.");
+  }
+
+  // get the upper to lower weight window ratio - optional
+  if (check_for_node(node, "ratio")) {
+    ratio_ = std::stod(get_node_value(node, "ratio"));
+    if (ratio_ <= 1.0)
+      fatal_error("Upper to lower weight window ratio must be larger than 1.");
+  }
+
+  // get the generation method - optional
+  if (check_for_node(node, "method")) {
+    auto method = get_node_value(node, "method", true, true);
+    if (method == "magic") {
+      method_ = WeightWindowMethod::MAGIC;
+    } else if (method == "fw_cadis") {
+      method_ = WeightWindowMethod::FW_CADIS;
+    } else {
+      fatal_error(fmt::format(
+        "Unknown weight window generation method: {}", method));
+    }
+  }
+  if (method_ == WeightWindowMethod::FW_CADIS) {
+    if (!settings::random_ray) {
+      fatal_error("FW-CADIS weight window generation requires the random ray "
+                  "solver.");
+    }
+    if (settings::run_mode != RunMode::FIXED_SOURCE) {
+      fatal_error("FW-CADIS weight window generation requires a fixed source "
+                  "run.");
+    }
+  }
+
+  // Create the weight windows that are updated, which can only be given an ID
+  // once they are in the weight windows vector
+  variance_reduction::weight_windows.push_back(
+    make_unique<WeightWindows>(it->second, type, std::move(energy_bounds)));
+  ww_idx_ = variance_reduction::weight_windows.size() - 1;
+  variance_reduction::weight_windows.back()->set_id();
+}
+
+void WeightWindowsGenerator::create_tally()
+{
+  const auto& ww = *variance_reduction::weight_windows[ww_idx_];
+
+  // The filters are ordered so that the filter bins of the tally have the same
+  // order as the weight window bounds
+  auto* particle_filter = Filter::create<ParticleFilter>();
+  ParticleType type = ww.particle_type();
+  particle_filter->set_particles({&type, 1});
+  auto* energy_filter = Filter::create<EnergyFilter>();
+  energy_filter->set_bins(ww.energy_bounds());
+  auto* mesh_filter = Filter::create<MeshFilter>();
+  mesh_filter->set_mesh(ww.mesh_idx());
+  vector<Filter*> filters {particle_filter, energy_filter, mesh_filter};
+
+  auto* tally = Tally::create();
+  tally->set_filters(filters);
+  tally->set_scores(vector<std::string> {"flux"});
+  tally->set_writable(false);
+  tally_idx_ = model::tallies.size() - 1;
+}
+
+void WeightWindowsGenerator::update()
+{
+  const auto& tally = *model::tallies[tally_idx_];
+  if (tally.n_realizations_ == 0)
+    return;
+
+  auto& ww = *variance_reduction::weight_windows[ww_idx_];
+  int64_t n_mesh_bins = ww.mesh().n_bins();
+  int64_t n_groups = ww.energy_bounds().size() - 1;
+  vector<float> lower(n_mesh_bins * n_groups, -1.0f);
+
+  // Tally results are only complete on the master process
+  if (mpi::master) {
+    for (int64_t g = 0; g < n_groups; ++g) {
+      int64_t offset = g * n_mesh_bins;
+      double flux_max = 0.0;
+      for (int64_t i = 0; i < n_mesh_bins; ++i) {
+        flux_max =
+          std::max(flux_max, tally.result(offset + i, 0, TallyResult::SUM));
+      }
+      if (flux_max <= 0.0)
+        continue;
+
+      for (int64_t i = 0; i < n_mesh_bins; ++i) {
+        double flux = tally.result(offset + i, 0, TallyResult::SUM);
+        if (flux > 0.0)
+          lower[offset + i] = 0.5 * flux / flux_max;
+      }
+    }
+  }
+
+#ifdef OPENMC_MPI
+  MPI_Bcast(lower.data(), lower.size(), MPI_FLOAT, 0, mpi::intracomm);
+#endif
+
+  vector<float> upper(lower.size());
+  for (int64_t i = 0; i < lower.size(); ++i) {
+    upper[i] = lower[i] < 0.0f ? -1.0f : ratio_ * lower[i];
+  }
+  ww.set_bounds(std::move(lower), std::move(upper));
+}
+
+void WeightWindowsGenerator::set_importance(const vector<double>& importance)
+{
+  auto& ww = *variance_reduction::weight_windows[ww_idx_];
+
+  // Bias the independent sources of the particle type, whose mean importance
+  // is the response that the weight windows are normalized with
+  double strength = 0.0;
+  double response = 0.0;
+  for (auto& s : model::external_sources) {
+    auto src = dynamic_cast<IndependentSource*>(s.get());
+    if (!src || src->particle_type() != ww.particle_type())
+      continue;
+    src->set_importance(ww.mesh_idx(), ww.energy_bounds(), importance);
+    strength += src->strength();
+    response += src->strength() * src->mean_importance();
+  }
+  if (strength > 0.0) {
+    response /= strength;
+  } else {
+    response = *std::max_element(importance.begin(), importance.end());
+    if (mpi::master) {
+      warning("No independent source emits the particle type of FW-CADIS "
+              "weight windows, so they are normalized to the largest "
+              "importance.");
+    }
+  }
+
+  // Center the windows on the weight of particles born in each bin
+  vector<float> lower(importance.size(), -1.0f);
+  vector<float> upper(importance.size(), -1.0f);
+  for (int64_t i = 0; i < importance.size(); ++i) {
+    if (importance[i] > 0.0) {
+      lower[i] = 2.0 * response / (importance[i] * (1.0 + ratio_));
+      upper[i] = ratio_ * lower[i];
+    }
+  }
+  ww.set_bounds(std::move(lower), std::move(upper));
+}
+
 } // namespace openmc
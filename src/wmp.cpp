@@ -6,7 +6,9 @@
 #include "openmc/hdf5_interface.h"
 #include "openmc/math_functions.h"
 #include "openmc/nuclide.h"
+#include "openmc/settings.h"
 
+#include "xtensor/xbuilder.hpp"
 #include <fmt/core.h>
 
 #include <algorithm> // for min
@@ -14,6 +16,41 @@
 
 namespace openmc {
 
+//========================================================================
+// Constants
+//========================================================================
+
+// Four-point Gauss-Hermite quadrature of the integral form of the Faddeeva
+// function, w(z) ~ iz * (W_A / (z^2 - W_B) + W_C / (z^2 - W_D)). The relative
+// error is about 1e-6 at |z| = 6 and falls off as |z|^-8, so it is only used
+// when settings::temperature_multipole_quadrature is on.
+constexpr double W_A {0.512424224754768462984202823134979415014943561548661};
+constexpr double W_B {0.275255128608410950901357962647054304017026259671664};
+constexpr double W_C {0.051765358792987823963876628425793170829107067780337};
+constexpr double W_D {2.724744871391589049098642037352945695982973740328335};
+constexpr double W_ASYMPTOTIC_Z2 {36.0}; //!< |z|^2 above which to use it
+
+//! Evaluate the quadrature approximation of the Faddeeva function using only
+//! real arithmetic so that calls can be vectorized
+inline void faddeeva_asymptotic(
+  double z_re, double z_im, double& w_re, double& w_im)
+{
+  double z2_re = z_re * z_re - z_im * z_im;
+  double z2_im = 2.0 * z_re * z_im;
+
+  // Sum of W_A / (z^2 - W_B) and W_C / (z^2 - W_D)
+  double d1 = z2_re - W_B;
+  double d2 = z2_re - W_D;
+  double f1 = W_A / (d1 * d1 + z2_im * z2_im);
+  double f2 = W_C / (d2 * d2 + z2_im * z2_im);
+  double s_re = d1 * f1 + d2 * f2;
+  double s_im = -z2_im * (f1 + f2);
+
+  // Multiply by iz
+  w_re = -z_im * s_re - z_re * s_im;
+  w_im = z_re * s_re - z_im * s_im;
+}
+
 //========================================================================
 // WindowedeMultipole implementation
 //========================================================================
@@ -32,12 +69,26 @@ WindowedMultipole::WindowedMultipole(hid_t group)
 
   // Read the "data" array.  Use its shape to figure out the number of poles
   // and residue types in this data.
-  read_dataset(group, "data", data_);
-  int n_residues = data_.shape()[1] - 1;
+  xt::xtensor<std::complex<double>, 2> data;
+  read_dataset(group, "data", data);
+  int n_poles = data.shape()[0];
+  int n_residues = data.shape()[1] - 1;
 
   // Check to see if this data includes fission residues.
   fissionable_ = (n_residues == 3);
 
+  // Split poles and residues into contiguous real and imaginary arrays so that
+  // consecutive poles can be evaluated in SIMD lanes. Residues for fission are
+  // left as zero for nonfissionable nuclides so every lane does the same work.
+  data_re_ = xt::zeros<double>({MP_RF + 1, n_poles});
+  data_im_ = xt::zeros<double>({MP_RF + 1, n_poles});
+  for (int i = 0; i < n_poles; ++i) {
+    for (int j = 0; j <= n_residues; ++j) {
+      data_re_(j, i) = data(i, j).real();
+      data_im_(j, i) = data(i, j).imag();
+    }
+  }
+
   // Read the "windows" array and use its shape to figure out the number of
   // windows.
   xt::xtensor<int, 2> windows;
@@ -79,30 +130,18 @@ WindowedMultipole::WindowedMultipole(hid_t group)
   }
 }
 
-std::tuple<double, double, double> WindowedMultipole::evaluate(
-  double E, double sqrtkT) const
+int WindowedMultipole::window_index(double sqrtE) const
 {
-  using namespace std::complex_literals;
-
-  // ==========================================================================
-  // Bookkeeping
-
-  // Define some frequently used variables.
-  double sqrtE = std::sqrt(E);
-  double invE = 1.0 / E;
-
-  // Locate window containing energy
-  int i_window = std::min(window_info_.size() - 1,
+  return std::min(window_info_.size() - 1,
     static_cast<size_t>((sqrtE - std::sqrt(E_min_)) * inv_spacing_));
-  const auto& window {window_info_[i_window]};
-
-  // Initialize the ouptut cross sections
-  double sig_s = 0.0;
-  double sig_a = 0.0;
-  double sig_f = 0.0;
+}
 
-  // ==========================================================================
-  // Add the contribution from the curvefit polynomial.
+array<double, 3> WindowedMultipole::evaluate_curvefit(
+  int i_window, double E, double sqrtkT) const
+{
+  array<double, 3> sig {0.0, 0.0, 0.0};
+  const auto& window {window_info_[i_window]};
+  int n_fit = fissionable_ ? 3 : 2;
 
   if (sqrtkT > 0.0 && window.broaden_poly) {
     // Broaden the curvefit.
@@ -111,61 +150,218 @@ std::tuple<double, double, double> WindowedMultipole::evaluate(
     broaden_wmp_polynomials(
       E, dopp, fit_order_ + 1, broadened_polynomials.data());
     for (int i_poly = 0; i_poly < fit_order_ + 1; ++i_poly) {
-      sig_s +=
-        curvefit_(i_window, i_poly, FIT_S) * broadened_polynomials[i_poly];
-      sig_a +=
-        curvefit_(i_window, i_poly, FIT_A) * broadened_polynomials[i_poly];
-      if (fissionable_) {
-        sig_f +=
-          curvefit_(i_window, i_poly, FIT_F) * broadened_polynomials[i_poly];
+      for (int r = 0; r < n_fit; ++r) {
+        sig[r] +=
+          curvefit_(i_window, i_poly, r) * broadened_polynomials[i_poly];
       }
     }
   } else {
     // Evaluate as if it were a polynomial
-    double temp = invE;
+    double sqrtE = std::sqrt(E);
+    double temp = 1.0 / E;
     for (int i_poly = 0; i_poly < fit_order_ + 1; ++i_poly) {
-      sig_s += curvefit_(i_window, i_poly, FIT_S) * temp;
-      sig_a += curvefit_(i_window, i_poly, FIT_A) * temp;
-      if (fissionable_) {
-        sig_f += curvefit_(i_window, i_poly, FIT_F) * temp;
+      for (int r = 0; r < n_fit; ++r) {
+        sig[r] += curvefit_(i_window, i_poly, r) * temp;
       }
       temp *= sqrtE;
     }
   }
+  return sig;
+}
+
+std::tuple<double, double, double> WindowedMultipole::evaluate(
+  double E, double sqrtkT) const
+{
+  // ==========================================================================
+  // Bookkeeping
+
+  // Define some frequently used variables.
+  double sqrtE = std::sqrt(E);
+  double invE = 1.0 / E;
+
+  // Locate window containing energy
+  int i_window = this->window_index(sqrtE);
+  const auto& window {window_info_[i_window]};
+
+  // ==========================================================================
+  // Add the contribution from the curvefit polynomial.
+
+  auto curvefit = this->evaluate_curvefit(i_window, E, sqrtkT);
+  double sig_s = curvefit[FIT_S];
+  double sig_a = curvefit[FIT_A];
+  double sig_f = curvefit[FIT_F];
 
   // ==========================================================================
   // Add the contribution from the poles in this window.
 
+  int i_start = window.index_start;
+  int n_poles = window.index_end - window.index_start + 1;
+  const double* pole_re = &data_re_(MP_EA, i_start);
+  const double* pole_im = &data_im_(MP_EA, i_start);
+  const double* rs_re = &data_re_(MP_RS, i_start);
+  const double* rs_im = &data_im_(MP_RS, i_start);
+  const double* ra_re = &data_re_(MP_RA, i_start);
+  const double* ra_im = &data_im_(MP_RA, i_start);
+  const double* rf_re = &data_re_(MP_RF, i_start);
+  const double* rf_im = &data_im_(MP_RF, i_start);
+
   if (sqrtkT == 0.0) {
-    // If at 0K, use asymptotic form.
-    for (int i_pole = window.index_start; i_pole <= window.index_end;
-         ++i_pole) {
-      std::complex<double> psi_chi = -1.0i / (data_(i_pole, MP_EA) - sqrtE);
-      std::complex<double> c_temp = psi_chi * invE;
-      sig_s += (data_(i_pole, MP_RS) * c_temp).real();
-      sig_a += (data_(i_pole, MP_RA) * c_temp).real();
-      if (fissionable_) {
-        sig_f += (data_(i_pole, MP_RF) * c_temp).real();
-      }
+    // If at 0K, use asymptotic form, c = -i / (pole - sqrt(E)) / E
+#pragma omp simd reduction(+ : sig_s, sig_a, sig_f)
+    for (int i = 0; i < n_poles; ++i) {
+      double dr = pole_re[i] - sqrtE;
+      double di = pole_im[i];
+      double norm = invE / (dr * dr + di * di);
+      double c_re = -di * norm;
+      double c_im = -dr * norm;
+      sig_s += rs_re[i] * c_re - rs_im[i] * c_im;
+      sig_a += ra_re[i] * c_re - ra_im[i] * c_im;
+      sig_f += rf_re[i] * c_re - rf_im[i] * c_im;
     }
   } else {
-    // At temperature, use Faddeeva function-based form.
+    // At temperature, use Faddeeva function-based form. If the quadrature
+    // approximation is on, poles that are far from the energy relative to the
+    // Doppler width are evaluated with it in SIMD lanes.
     double dopp = sqrt_awr_ / sqrtkT;
-    for (int i_pole = window.index_start; i_pole <= window.index_end;
-         ++i_pole) {
-      std::complex<double> z = (sqrtE - data_(i_pole, MP_EA)) * dopp;
-      std::complex<double> w_val = faddeeva(z) * dopp * invE * SQRT_PI;
-      sig_s += (data_(i_pole, MP_RS) * w_val).real();
-      sig_a += (data_(i_pole, MP_RA) * w_val).real();
-      if (fissionable_) {
-        sig_f += (data_(i_pole, MP_RF) * w_val).real();
+    double scale = dopp * invE * SQRT_PI;
+    double z2_max =
+      settings::temperature_multipole_quadrature ? W_ASYMPTOTIC_Z2 : INFTY;
+    if (settings::temperature_multipole_quadrature) {
+#pragma omp simd reduction(+ : sig_s, sig_a, sig_f)
+      for (int i = 0; i < n_poles; ++i) {
+        double z_re = (sqrtE - pole_re[i]) * dopp;
+        double z_im = -pole_im[i] * dopp;
+        double w_re, w_im;
+        faddeeva_asymptotic(z_re, z_im, w_re, w_im);
+
+        // Leave out poles that need the full function
+        double f = (z_re * z_re + z_im * z_im >= z2_max) ? scale : 0.0;
+        w_re *= f;
+        w_im *= f;
+        sig_s += rs_re[i] * w_re - rs_im[i] * w_im;
+        sig_a += ra_re[i] * w_re - ra_im[i] * w_im;
+        sig_f += rf_re[i] * w_re - rf_im[i] * w_im;
       }
     }
+
+    // Poles close to the energy are evaluated with the full Faddeeva function
+    for (int i = 0; i < n_poles; ++i) {
+      double z_re = (sqrtE - pole_re[i]) * dopp;
+      double z_im = -pole_im[i] * dopp;
+      if (z_re * z_re + z_im * z_im >= z2_max)
+        continue;
+      std::complex<double> w_val = faddeeva({z_re, z_im}) * scale;
+      sig_s += rs_re[i] * w_val.real() - rs_im[i] * w_val.imag();
+      sig_a += ra_re[i] * w_val.real() - ra_im[i] * w_val.imag();
+      sig_f += rf_re[i] * w_val.real() - rf_im[i] * w_val.imag();
+    }
   }
 
   return std::make_tuple(sig_s, sig_a, sig_f);
 }
 
+void WindowedMultipole::evaluate(gsl::span<const double> E,
+  gsl::span<const double> sqrtkT, gsl::span<array<double, 3>> xs) const
+{
+  // Order energies by window so that the poles of each window are read once
+  // for every energy that falls within it
+  size_t n = E.size();
+  vector<int> i_window(n);
+  vector<size_t> order(n);
+  for (size_t k = 0; k < n; ++k) {
+    i_window[k] = this->window_index(std::sqrt(E[k]));
+    order[k] = k;
+  }
+  std::stable_sort(order.begin(), order.end(),
+    [&](size_t a, size_t b) { return i_window[a] < i_window[b]; });
+
+  vector<size_t> group;
+  vector<double> sqrtE, dopp, scale, sig_s, sig_a, sig_f;
+  for (size_t start = 0; start < n;) {
+    // Find energies in the same window. Those at 0K are rare enough that they
+    // are simply evaluated one at a time.
+    int w = i_window[order[start]];
+    group.clear();
+    for (; start < n && i_window[order[start]] == w; ++start) {
+      size_t k = order[start];
+      if (sqrtkT[k] == 0.0) {
+        std::tie(xs[k][0], xs[k][1], xs[k][2]) = this->evaluate(E[k], 0.0);
+      } else {
+        group.push_back(k);
+      }
+    }
+    size_t m = group.size();
+    if (m == 0)
+      continue;
+
+    // Add the contribution from the curvefit polynomial
+    sqrtE.resize(m);
+    dopp.resize(m);
+    scale.resize(m);
+    sig_s.resize(m);
+    sig_a.resize(m);
+    sig_f.resize(m);
+    for (size_t j = 0; j < m; ++j) {
+      size_t k = group[j];
+      sqrtE[j] = std::sqrt(E[k]);
+      dopp[j] = sqrt_awr_ / sqrtkT[k];
+      scale[j] = dopp[j] / E[k] * SQRT_PI;
+      auto curvefit = this->evaluate_curvefit(w, E[k], sqrtkT[k]);
+      sig_s[j] = curvefit[FIT_S];
+      sig_a[j] = curvefit[FIT_A];
+      sig_f[j] = curvefit[FIT_F];
+    }
+
+    // Add the contribution from each pole, evaluating it for all energies in
+    // the group at once
+    const auto& window {window_info_[w]};
+    double z2_max =
+      settings::temperature_multipole_quadrature ? W_ASYMPTOTIC_Z2 : INFTY;
+    for (int i = window.index_start; i <= window.index_end; ++i) {
+      double pole_re = data_re_(MP_EA, i);
+      double pole_im = data_im_(MP_EA, i);
+      double rs_re = data_re_(MP_RS, i);
+      double rs_im = data_im_(MP_RS, i);
+      double ra_re = data_re_(MP_RA, i);
+      double ra_im = data_im_(MP_RA, i);
+      double rf_re = data_re_(MP_RF, i);
+      double rf_im = data_im_(MP_RF, i);
+
+      if (settings::temperature_multipole_quadrature) {
+#pragma omp simd
+        for (size_t j = 0; j < m; ++j) {
+          double z_re = (sqrtE[j] - pole_re) * dopp[j];
+          double z_im = -pole_im * dopp[j];
+          double w_re, w_im;
+          faddeeva_asymptotic(z_re, z_im, w_re, w_im);
+
+          double f = (z_re * z_re + z_im * z_im >= z2_max) ? scale[j] : 0.0;
+          w_re *= f;
+          w_im *= f;
+          sig_s[j] += rs_re * w_re - rs_im * w_im;
+          sig_a[j] += ra_re * w_re - ra_im * w_im;
+          sig_f[j] += rf_re * w_re - rf_im * w_im;
+        }
+      }
+
+      for (size_t j = 0; j < m; ++j) {
+        double z_re = (sqrtE[j] - pole_re) * dopp[j];
+        double z_im = -pole_im * dopp[j];
+        if (z_re * z_re + z_im * z_im >= z2_max)
+          continue;
+        std::complex<double> w_val = faddeeva({z_re, z_im}) * scale[j];
+        sig_s[j] += rs_re * w_val.real() - rs_im * w_val.imag();
+        sig_a[j] += ra_re * w_val.real() - ra_im * w_val.imag();
+        sig_f[j] += rf_re * w_val.real() - rf_im * w_val.imag();
+      }
+    }
+
+    for (size_t j = 0; j < m; ++j) {
+      xs[group[j]] = {sig_s[j], sig_a[j], sig_f[j]};
+    }
+  }
+}
+
 std::tuple<double, double, double> WindowedMultipole::evaluate_deriv(
   double E, double sqrtkT) const
 {
@@ -201,13 +397,16 @@ std::tuple<double, double, double> WindowedMultipole::evaluate_deriv(
 
   double dopp = sqrt_awr_ / sqrtkT;
   for (int i_pole = window.index_start; i_pole <= window.index_end; ++i_pole) {
-    std::complex<double> z = (sqrtE - data_(i_pole, MP_EA)) * dopp;
+    std::complex<double> pole {
+      data_re_(MP_EA, i_pole), data_im_(MP_EA, i_pole)};
+    std::complex<double> z = (sqrtE - pole) * dopp;
     std::complex<double> w_val = -invE * SQRT_PI * 0.5 * w_derivative(z, 2);
-    sig_s += (data_(i_pole, MP_RS) * w_val).real();
-    sig_a += (data_(i_pole, MP_RA) * w_val).real();
-    if (fissionable_) {
-      sig_f += (data_(i_pole, MP_RF) * w_val).real();
-    }
+    sig_s += data_re_(MP_RS, i_pole) * w_val.real() -
+             data_im_(MP_RS, i_pole) * w_val.imag();
+    sig_a += data_re_(MP_RA, i_pole) * w_val.real() -
+             data_im_(MP_RA, i_pole) * w_val.imag();
+    sig_f += data_re_(MP_RF, i_pole) * w_val.real() -
+             data_im_(MP_RF, i_pole) * w_val.imag();
   }
   double norm = -0.5 * sqrt_awr_ / std::sqrt(K_BOLTZMANN) * std::pow(T, -1.5);
   sig_s *= norm;
@@ -0,0 +1,181 @@
+//! \file bench_geometry.cpp
+//! \brief Microbenchmarks of surface distances and lattice traversal
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "openmc/lattice.h"
+#include "openmc/surface.h"
+
+#include "helpers.h"
+
+namespace openmc {
+namespace bench {
+namespace {
+
+//==============================================================================
+// Surface distances
+//==============================================================================
+
+//! Distance to a surface from points in a 10 cm cube around it
+template<typename T>
+void BM_SurfaceDistance(benchmark::State& state, const char* coeffs)
+{
+  pugi::xml_document doc;
+  auto node = doc.append_child("surface");
+  node.append_attribute("id") = 1;
+  node.append_attribute("coeffs") = coeffs;
+  T surf {node};
+
+  auto points = sample_points(5.0);
+  int i = 0;
+  for (auto _ : state) {
+    const auto& p = points[i];
+    benchmark::DoNotOptimize(surf.distance(p.r, p.u, false));
+    i = (i + 1) % N_SAMPLES;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_CAPTURE(BM_SurfaceDistance<SurfaceXPlane>, x_plane, "0.5");
+BENCHMARK_CAPTURE(BM_SurfaceDistance<SurfaceYPlane>, y_plane, "0.5");
+BENCHMARK_CAPTURE(BM_SurfaceDistance<SurfaceZPlane>, z_plane, "0.5");
+BENCHMARK_CAPTURE(BM_SurfaceDistance<SurfacePlane>, plane, "1.0 1.0 1.0 0.5");
+BENCHMARK_CAPTURE(
+  BM_SurfaceDistance<SurfaceXCylinder>, x_cylinder, "0.0 0.0 0.4");
+BENCHMARK_CAPTURE(
+  BM_SurfaceDistance<SurfaceYCylinder>, y_cylinder, "0.0 0.0 0.4");
+BENCHMARK_CAPTURE(
+  BM_SurfaceDistance<SurfaceZCylinder>, z_cylinder, "0.0 0.0 0.4");
+BENCHMARK_CAPTURE(BM_SurfaceDistance<SurfaceSphere>, sphere, "0.0 0.0 0.0 4.0");
+BENCHMARK_CAPTURE(BM_SurfaceDistance<SurfaceXCone>, x_cone, "0.0 0.0 0.0 0.5");
+BENCHMARK_CAPTURE(BM_SurfaceDistance<SurfaceYCone>, y_cone, "0.0 0.0 0.0 0.5");
+BENCHMARK_CAPTURE(BM_SurfaceDistance<SurfaceZCone>, z_cone, "0.0 0.0 0.0 0.5");
+BENCHMARK_CAPTURE(BM_SurfaceDistance<SurfaceQuadric>, quadric,
+  "1.0 1.0 0.5 0.0 0.0 0.0 0.0 0.0 0.0 -16.0");
+BENCHMARK_CAPTURE(
+  BM_SurfaceDistance<SurfaceXTorus>, x_torus, "0.0 0.0 0.0 3.0 1.0 1.0");
+BENCHMARK_CAPTURE(
+  BM_SurfaceDistance<SurfaceYTorus>, y_torus, "0.0 0.0 0.0 3.0 1.0 1.0");
+BENCHMARK_CAPTURE(
+  BM_SurfaceDistance<SurfaceZTorus>, z_torus, "0.0 0.0 0.0 3.0 1.0 1.0");
+// Most rays miss a torus that lies outside of the cube of sampled points
+BENCHMARK_CAPTURE(BM_SurfaceDistance<SurfaceZTorus>, z_torus_distant,
+  "0.0 0.0 20.0 3.0 1.0 1.0");
+
+template<typename T>
+unique_ptr<Surface> make_surface(const char* coeffs)
+{
+  pugi::xml_document doc;
+  auto node = doc.append_child("surface");
+  node.append_attribute("id") = 1;
+  node.append_attribute("coeffs") = coeffs;
+  return make_unique<T>(node);
+}
+
+//! Distances to a mix of surface types, either through the virtual Surface
+//! interface or through the packed surface store
+void BM_SurfaceMixDistance(benchmark::State& state, bool use_store)
+{
+  model::surfaces.push_back(make_surface<SurfaceXPlane>("0.5"));
+  model::surfaces.push_back(make_surface<SurfaceZCylinder>("0.0 0.0 0.4"));
+  model::surfaces.push_back(make_surface<SurfacePlane>("1.0 1.0 1.0 0.5"));
+  model::surfaces.push_back(make_surface<SurfaceSphere>("0.0 0.0 0.0 4.0"));
+  model::surfaces.push_back(make_surface<SurfaceYPlane>("-0.5"));
+  model::surfaces.push_back(make_surface<SurfaceXCone>("0.0 0.0 0.0 0.5"));
+  model::surface_store.build();
+  int n_surf = model::surfaces.size();
+
+  auto points = sample_points(5.0);
+  int i = 0;
+  for (auto _ : state) {
+    const auto& p = points[i];
+    for (int j = 0; j < n_surf; ++j) {
+      double d = use_store
+                   ? model::surface_store.distance(j, p.r, p.u, false)
+                   : model::surfaces[j]->distance(p.r, p.u, false);
+      benchmark::DoNotOptimize(d);
+    }
+    i = (i + 1) % N_SAMPLES;
+  }
+  state.SetItemsProcessed(state.iterations() * n_surf);
+
+  model::surface_store.clear();
+  model::surfaces.clear();
+}
+
+BENCHMARK_CAPTURE(BM_SurfaceMixDistance, virtual_call, false);
+BENCHMARK_CAPTURE(BM_SurfaceMixDistance, store, true);
+
+//==============================================================================
+// Lattice traversal
+//==============================================================================
+
+//! Follow straight tracks through a lattice from tile to tile the same way as
+//! distance_to_boundary() and cross_lattice(), until they leave the lattice
+template<typename T>
+void traverse_lattice(
+  benchmark::State& state, const char* xml, double half_width)
+{
+  pugi::xml_document doc;
+  T lat {parse_node(doc, xml)};
+
+  // Limit on the number of crossings in case a track runs along a tile edge
+  constexpr int MAX_CROSSINGS {1000};
+
+  auto points = sample_points(half_width);
+  int i = 0;
+  int64_t n_crossings = 0;
+  for (auto _ : state) {
+    const auto& p = points[i];
+    Position r = p.r;
+    array<int, 3> i_xyz;
+    lat.get_indices(r, p.u, i_xyz);
+    for (int n = 0; n < MAX_CROSSINGS && lat.are_valid_indices(i_xyz); ++n) {
+      Position r_local = lat.get_local_position(r, i_xyz);
+      auto crossing = lat.distance(r_local, p.u, i_xyz);
+      r += crossing.first * p.u;
+      for (int j = 0; j < 3; ++j) {
+        i_xyz[j] += crossing.second[j];
+      }
+      ++n_crossings;
+    }
+    i = (i + 1) % N_SAMPLES;
+  }
+  state.SetItemsProcessed(n_crossings);
+}
+
+//! A 17 x 17 PWR assembly with 20 axial levels
+void BM_RectLatticeTraversal(benchmark::State& state)
+{
+  std::string universes;
+  for (int i = 0; i < 17 * 17 * 20; ++i) {
+    universes += "1 ";
+  }
+  std::string xml = "<lattice id=\"1\" dimension=\"17 17 20\" "
+                    "lower_left=\"-10.71 -10.71 -100.0\" "
+                    "pitch=\"1.26 1.26 10.0\" universes=\"" +
+                    universes + "\"/>";
+  traverse_lattice<RectLattice>(state, xml.c_str(), 10.71);
+}
+BENCHMARK(BM_RectLatticeTraversal);
+
+//! A hexagonal assembly with 10 rings and 20 axial levels
+void BM_HexLatticeTraversal(benchmark::State& state)
+{
+  std::string universes;
+  for (int i = 0; i < (3 * 10 * 10 - 3 * 10 + 1) * 20; ++i) {
+    universes += "1 ";
+  }
+  std::string xml = "<lattice id=\"1\" n_rings=\"10\" n_axial=\"20\" "
+                    "center=\"0.0 0.0 0.0\" pitch=\"1.26 10.0\" "
+                    "universes=\"" +
+                    universes + "\"/>";
+  traverse_lattice<HexLattice>(state, xml.c_str(), 10.0);
+}
+BENCHMARK(BM_HexLatticeTraversal);
+
+} // namespace
+} // namespace bench
+} // namespace openmc
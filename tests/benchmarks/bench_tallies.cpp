@@ -0,0 +1,169 @@
+//! \file bench_tallies.cpp
+//! \brief Microbenchmarks of mesh tracking and iteration over filter bins
+
+#include <algorithm> // for max
+#include <cmath>
+
+#include <benchmark/benchmark.h>
+
+#include "openmc/geometry.h"
+#include "openmc/mesh.h"
+#include "openmc/particle.h"
+#include "openmc/tallies/filter.h"
+#include "openmc/tallies/tally.h"
+#include "openmc/tallies/tally_scoring.h"
+
+#include "helpers.h"
+
+namespace openmc {
+namespace bench {
+namespace {
+
+// Mean length of the sampled track segments in [cm]
+constexpr double MEAN_TRACK_LENGTH {2.0};
+
+//! Sample track segments in a 17 x 17 assembly with exponentially distributed
+//! lengths
+vector<std::pair<Position, Position>> sample_tracks(Direction* u)
+{
+  auto points = sample_points(10.71);
+  vector<std::pair<Position, Position>> tracks;
+  uint64_t seed = 2;
+  for (int i = 0; i < N_SAMPLES; ++i) {
+    double d = -MEAN_TRACK_LENGTH * std::log(prn(&seed));
+    tracks.emplace_back(points[i].r, points[i].r + d * points[i].u);
+    u[i] = points[i].u;
+  }
+  return tracks;
+}
+
+//==============================================================================
+// StructuredMesh::bins_crossed
+//==============================================================================
+
+template<typename T>
+void bins_crossed(benchmark::State& state, const char* xml)
+{
+  pugi::xml_document doc;
+  T mesh {parse_node(doc, xml)};
+
+  vector<Direction> u(N_SAMPLES);
+  auto tracks = sample_tracks(u.data());
+  vector<int> bins;
+  vector<double> lengths;
+  int i = 0;
+  int64_t n_bins = 0;
+  for (auto _ : state) {
+    bins.clear();
+    lengths.clear();
+    mesh.bins_crossed(tracks[i].first, tracks[i].second, u[i], bins, lengths);
+    n_bins += bins.size();
+    i = (i + 1) % N_SAMPLES;
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["bins"] =
+    benchmark::Counter(n_bins, benchmark::Counter::kAvgIterations);
+}
+
+//! A pin-by-pin mesh over a 17 x 17 assembly
+void BM_RegularMeshBinsCrossed(benchmark::State& state)
+{
+  bins_crossed<RegularMesh>(state,
+    "<mesh id=\"1\" dimension=\"17 17 20\" lower_left=\"-10.71 -10.71 -10.71\" "
+    "upper_right=\"10.71 10.71 10.71\"/>");
+}
+BENCHMARK(BM_RegularMeshBinsCrossed);
+
+//! A mesh over the same assembly that is refined toward its center
+void BM_RectilinearMeshBinsCrossed(benchmark::State& state)
+{
+  bins_crossed<RectilinearMesh>(state,
+    "<mesh id=\"1\" type=\"rectilinear\" "
+    "x_grid=\"-10.71 -8.0 -6.0 -4.0 -3.0 -2.0 -1.0 -0.5 0.0 0.5 1.0 2.0 3.0 "
+    "4.0 6.0 8.0 10.71\" "
+    "y_grid=\"-10.71 -8.0 -6.0 -4.0 -3.0 -2.0 -1.0 -0.5 0.0 0.5 1.0 2.0 3.0 "
+    "4.0 6.0 8.0 10.71\" "
+    "z_grid=\"-10.71 -5.0 -2.0 0.0 2.0 5.0 10.71\"/>");
+}
+BENCHMARK(BM_RectilinearMeshBinsCrossed);
+
+//==============================================================================
+// FilterBinIter
+//==============================================================================
+
+//! A tracklength tally with energy, polar, azimuthal, and mesh filters, like a
+//! tally of angular flux moments on a pin-by-pin mesh
+const Tally& filter_tally()
+{
+  static Tally* tally = nullptr;
+  if (tally)
+    return *tally;
+
+  pugi::xml_document doc;
+  doc.load_string(
+    "<tallies>"
+    "<mesh id=\"9001\" dimension=\"17 17 1\" "
+    "lower_left=\"-10.71 -10.71 -10.71\" upper_right=\"10.71 10.71 10.71\"/>"
+    "<filter id=\"9001\" type=\"energy\" bins=\"1.0e-5 0.0253 0.625 5.53e3 "
+    "8.21e5 2.0e7\"/>"
+    "<filter id=\"9002\" type=\"polar\" bins=\"0.0 0.785 1.571 2.356 "
+    "3.1416\"/>"
+    "<filter id=\"9003\" type=\"azimuthal\" bins=\"-3.1416 -1.571 0.0 1.571 "
+    "3.1416\"/>"
+    "<filter id=\"9004\" type=\"mesh\" bins=\"9001\"/>"
+    "</tallies>");
+  auto root = doc.document_element();
+  read_meshes(root);
+  vector<Filter*> filters;
+  for (auto node : root.children("filter")) {
+    filters.push_back(Filter::create(node));
+  }
+
+  tally = Tally::create(9001);
+  tally->estimator_ = TallyEstimator::TRACKLENGTH;
+  tally->set_filters(filters);
+  return *tally;
+}
+
+void BM_FilterBinIter(benchmark::State& state)
+{
+  const auto& tally = filter_tally();
+
+  // Particles need at least one coordinate level to have a position
+  model::n_coord_levels = std::max(model::n_coord_levels, 1);
+  Particle p;
+  p.filter_matches().resize(model::tally_filters.size());
+
+  vector<Direction> u(N_SAMPLES);
+  auto tracks = sample_tracks(u.data());
+  auto energies = sample_energies(1.0e-5, 2.0e7);
+  int i = 0;
+  int64_t n_combinations = 0;
+  for (auto _ : state) {
+    // Each event finds the bins of every filter again
+    for (auto& match : p.filter_matches()) {
+      match.bins_present_ = false;
+    }
+    p.r_last() = tracks[i].first;
+    p.r() = tracks[i].second;
+    p.u() = u[i];
+    p.E_last() = energies[i];
+
+    double total = 0.0;
+    auto end = FilterBinIter(tally, true, &p.filter_matches());
+    for (auto it = FilterBinIter(tally, p); it != end; ++it) {
+      total += it.weight_;
+      ++n_combinations;
+    }
+    benchmark::DoNotOptimize(total);
+    i = (i + 1) % N_SAMPLES;
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["combinations"] =
+    benchmark::Counter(n_combinations, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_FilterBinIter);
+
+} // namespace
+} // namespace bench
+} // namespace openmc
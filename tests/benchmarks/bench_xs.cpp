@@ -0,0 +1,196 @@
+//! \file bench_xs.cpp
+//! \brief Microbenchmarks of cross section lookups
+//!
+//! Evaluated nuclear data cannot be made up without losing what makes lookups
+//! expensive, so these benchmarks read a few nuclides from the library given
+//! by the OPENMC_CROSS_SECTIONS environment variable and are skipped when it
+//! is not set. Multipole data is used when the library includes it.
+
+#include <cmath>
+#include <cstdlib> // for getenv, mkdtemp, atexit
+#include <fstream>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "openmc/capi.h"
+#include "openmc/constants.h"
+#include "openmc/material.h"
+#include "openmc/nuclide.h"
+#include "openmc/particle.h"
+#include "openmc/simulation.h"
+#include "openmc/wmp.h"
+
+#include "helpers.h"
+
+namespace openmc {
+namespace bench {
+namespace {
+
+// Temperature of the sampled lookups in [K]
+constexpr double TEMPERATURE {293.6};
+
+//! Write a model of a UO2 sphere in water to a temporary directory and
+//! initialize OpenMC with it
+//
+//! \return Whether the model was initialized
+bool init_model()
+{
+  static int status = -1;
+  if (status >= 0)
+    return status == 0;
+
+  status = 1;
+  if (!std::getenv("OPENMC_CROSS_SECTIONS"))
+    return false;
+
+  char dir[] = "/tmp/openmc_benchmarks_XXXXXX";
+  if (!mkdtemp(dir))
+    return false;
+  std::string path {dir};
+
+  std::ofstream {path + "/materials.xml"}
+    << "<materials>"
+       "<material id=\"1\"><density value=\"10.3\" units=\"g/cm3\"/>"
+       "<nuclide name=\"U235\" ao=\"0.04\"/>"
+       "<nuclide name=\"U238\" ao=\"0.96\"/>"
+       "<nuclide name=\"O16\" ao=\"2.0\"/></material>"
+       "<material id=\"2\"><density value=\"1.0\" units=\"g/cm3\"/>"
+       "<nuclide name=\"H1\" ao=\"2.0\"/>"
+       "<nuclide name=\"O16\" ao=\"1.0\"/></material>"
+       "</materials>";
+  std::ofstream {path + "/geometry.xml"}
+    << "<geometry>"
+       "<surface id=\"1\" type=\"sphere\" coeffs=\"0 0 0 10\"/>"
+       "<surface id=\"2\" type=\"sphere\" coeffs=\"0 0 0 20\" "
+       "boundary=\"vacuum\"/>"
+       "<cell id=\"1\" material=\"1\" region=\"-1\"/>"
+       "<cell id=\"2\" material=\"2\" region=\"1 -2\"/>"
+       "</geometry>";
+  std::ofstream {path + "/settings.xml"}
+    << "<settings>"
+       "<run_mode>fixed source</run_mode>"
+       "<particles>100</particles>"
+       "<batches>1</batches>"
+       "<temperature_multipole>true</temperature_multipole>"
+       "<verbosity>1</verbosity>"
+       "</settings>";
+
+  std::string name {"openmc"};
+  char* argv[] {&name[0], &path[0]};
+  status = openmc_init(2, argv, nullptr);
+  if (status == 0)
+    std::atexit([] { openmc_finalize(); });
+  return status == 0;
+}
+
+//! A neutron at room temperature in the given material
+void init_particle(Particle& p, int i_material)
+{
+  p.type() = ParticleType::neutron;
+  p.material() = i_material;
+  p.sqrtkT() = std::sqrt(K_BOLTZMANN * TEMPERATURE);
+}
+
+//==============================================================================
+// Nuclide::calculate_xs
+//==============================================================================
+
+void BM_NuclideCalculateXS(benchmark::State& state)
+{
+  if (!init_model()) {
+    state.SkipWithError("OPENMC_CROSS_SECTIONS is not set");
+    return;
+  }
+
+  auto& nuc = *data::nuclides[data::nuclide_map.at("U238")];
+  Particle p;
+  init_particle(p, 0);
+
+  int neutron = static_cast<int>(ParticleType::neutron);
+  auto energies = sample_energies(1.0e-5, 2.0e7);
+  int i = 0;
+  for (auto _ : state) {
+    p.E() = energies[i];
+    int i_log_union =
+      std::log(p.E() / data::energy_min[neutron]) / simulation::log_spacing;
+    nuc.calculate_xs(C_NONE, i_log_union, 0.0, p);
+    benchmark::DoNotOptimize(p.neutron_xs(nuc.index_).total);
+    i = (i + 1) % N_SAMPLES;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_NuclideCalculateXS);
+
+//==============================================================================
+// Material::calculate_neutron_xs
+//==============================================================================
+
+//! Macroscopic cross sections of a material without precomputed tables
+void calculate_material_xs(benchmark::State& state, int i_material)
+{
+  if (!init_model()) {
+    state.SkipWithError("OPENMC_CROSS_SECTIONS is not set");
+    return;
+  }
+
+  const auto& mat = *model::materials[i_material];
+  Particle p;
+  init_particle(p, i_material);
+
+  auto energies = sample_energies(1.0e-5, 2.0e7);
+  int i = 0;
+  for (auto _ : state) {
+    p.E() = energies[i];
+    mat.calculate_xs(p, false);
+    benchmark::DoNotOptimize(p.macro_xs().total);
+    i = (i + 1) % N_SAMPLES;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_MaterialCalculateXSFuel(benchmark::State& state)
+{
+  calculate_material_xs(state, 0);
+}
+BENCHMARK(BM_MaterialCalculateXSFuel);
+
+void BM_MaterialCalculateXSWater(benchmark::State& state)
+{
+  calculate_material_xs(state, 1);
+}
+BENCHMARK(BM_MaterialCalculateXSWater);
+
+//==============================================================================
+// WindowedMultipole::evaluate
+//==============================================================================
+
+void BM_WindowedMultipoleEvaluate(benchmark::State& state)
+{
+  if (!init_model()) {
+    state.SkipWithError("OPENMC_CROSS_SECTIONS is not set");
+    return;
+  }
+
+  const auto& nuc = *data::nuclides[data::nuclide_map.at("U238")];
+  if (!nuc.multipole_) {
+    state.SkipWithError("Library has no multipole data for U238");
+    return;
+  }
+  const auto& wmp = *nuc.multipole_;
+
+  // Energies across the resolved resonance range covered by the poles
+  auto energies = sample_energies(wmp.E_min_, wmp.E_max_);
+  double sqrtkT = std::sqrt(K_BOLTZMANN * TEMPERATURE);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(wmp.evaluate(energies[i], sqrtkT));
+    i = (i + 1) % N_SAMPLES;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_WindowedMultipoleEvaluate);
+
+} // namespace
+} // namespace bench
+} // namespace openmc
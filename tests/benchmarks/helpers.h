@@ -0,0 +1,75 @@
+#ifndef OPENMC_BENCHMARKS_HELPERS_H
+#define OPENMC_BENCHMARKS_HELPERS_H
+
+//! \file helpers.h
+//! \brief Synthetic inputs shared by the microbenchmarks
+
+#include <cmath>
+#include <cstdint>
+
+#include "pugixml.hpp"
+
+#include "openmc/distribution_multi.h"
+#include "openmc/position.h"
+#include "openmc/random_lcg.h"
+#include "openmc/vector.h"
+
+namespace openmc {
+namespace bench {
+
+// Number of sampled inputs that each benchmark cycles through. Inputs are
+// sampled up front so that sampling does not count toward the timings, and
+// there are enough of them that branches cannot be learned.
+constexpr int N_SAMPLES {4096};
+
+// A point on a particle track
+struct TrackPoint {
+  Position r;
+  Direction u;
+};
+
+//! Sample points uniformly in a cube centered on the origin with isotropic
+//! directions
+//
+//! \param[in] half_width  Half of the width of the cube in [cm]
+//! \param[in] seed        Seed of the random number stream
+inline vector<TrackPoint> sample_points(double half_width, uint64_t seed = 1)
+{
+  vector<TrackPoint> points(N_SAMPLES);
+  for (auto& p : points) {
+    p.r.x = half_width * (2.0 * prn(&seed) - 1.0);
+    p.r.y = half_width * (2.0 * prn(&seed) - 1.0);
+    p.r.z = half_width * (2.0 * prn(&seed) - 1.0);
+    p.u = isotropic_direction(&seed);
+  }
+  return points;
+}
+
+//! Sample energies from a log-uniform distribution
+//
+//! \param[in] E_min  Lowest energy in [eV]
+//! \param[in] E_max  Highest energy in [eV]
+//! \param[in] seed   Seed of the random number stream
+inline vector<double> sample_energies(
+  double E_min, double E_max, uint64_t seed = 1)
+{
+  vector<double> energies(N_SAMPLES);
+  double log_ratio = std::log(E_max / E_min);
+  for (auto& E : energies) {
+    E = E_min * std::exp(log_ratio * prn(&seed));
+  }
+  return energies;
+}
+
+//! Parse an XML element given as a string. The document must outlive the
+//! returned node.
+inline pugi::xml_node parse_node(pugi::xml_document& doc, const char* xml)
+{
+  doc.load_string(xml);
+  return doc.document_element();
+}
+
+} // namespace bench
+} // namespace openmc
+
+#endif // OPENMC_BENCHMARKS_HELPERS_H
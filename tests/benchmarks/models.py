@@ -0,0 +1,207 @@
+"""Models used to measure the end-to-end performance of OpenMC
+
+Each function returns an :class:`openmc.Model` that stresses a different part
+of transport. The models are meant to be run with
+:file:`run_models.py` and need a continuous-energy library with photon data,
+given by the OPENMC_CROSS_SECTIONS environment variable.
+
+"""
+
+import numpy as np
+
+import openmc
+import openmc.examples
+
+
+def pin_cell():
+    """PWR pin cell with reflective boundaries, which spends most of its time
+    on cross section lookups"""
+    model = openmc.examples.pwr_pin_cell()
+    model.settings.batches = 60
+    model.settings.inactive = 20
+    model.settings.particles = 10000
+    return model
+
+
+def pwr_core():
+    """Full PWR core of 17x17 assembly lattices, which spends much of its time
+    on lattice crossings and cell searches"""
+    model = openmc.examples.pwr_core()
+    model.settings.batches = 30
+    model.settings.inactive = 10
+    model.settings.particles = 20000
+    return model
+
+
+def hex_fast_core():
+    """Sodium-cooled fast core of hexagonal assemblies of MOX pins, which has
+    a hard spectrum and nested hexagonal lattices"""
+    fuel = openmc.Material(name='MOX')
+    fuel.set_density('g/cm3', 10.5)
+    fuel.add_nuclide('U238', 0.8)
+    fuel.add_nuclide('Pu239', 0.2)
+    fuel.add_nuclide('O16', 2.0)
+
+    clad = openmc.Material(name='HT9')
+    clad.set_density('g/cm3', 7.87)
+    clad.add_nuclide('Fe56', 0.85)
+    clad.add_nuclide('Cr52', 0.12)
+    clad.add_nuclide('Mo98', 0.01)
+    clad.add_nuclide('Ni58', 0.02)
+
+    sodium = openmc.Material(name='Sodium')
+    sodium.set_density('g/cm3', 0.85)
+    sodium.add_nuclide('Na23', 1.0)
+
+    # Fuel pin
+    fuel_or = openmc.ZCylinder(r=0.3)
+    clad_or = openmc.ZCylinder(r=0.35)
+    pin = openmc.Universe(cells=[
+        openmc.Cell(fill=fuel, region=-fuel_or),
+        openmc.Cell(fill=clad, region=+fuel_or & -clad_or),
+        openmc.Cell(fill=sodium, region=+clad_or)
+    ])
+    coolant = openmc.Universe(cells=[openmc.Cell(fill=sodium)])
+
+    # Assembly of 9 rings of pins in a duct
+    pins = openmc.HexLattice()
+    pins.center = (0., 0.)
+    pins.pitch = (0.9,)
+    pins.orientation = 'x'
+    pins.outer = coolant
+    pins.universes = [[pin]*(6*(8 - i)) for i in range(8)] + [[pin]]
+    duct_inner = openmc.model.hexagonal_prism(edge_length=8.8)
+    duct_outer = openmc.model.hexagonal_prism(edge_length=9.1)
+    assembly = openmc.Universe(cells=[
+        openmc.Cell(fill=pins, region=duct_inner),
+        openmc.Cell(fill=clad, region=~duct_inner & duct_outer),
+        openmc.Cell(fill=sodium, region=~duct_outer)
+    ])
+
+    # Core of 5 rings of assemblies
+    core = openmc.HexLattice()
+    core.center = (0., 0.)
+    core.pitch = (15.9,)
+    core.outer = coolant
+    core.universes = [[assembly]*(6*(4 - i)) for i in range(4)] + [[assembly]]
+    boundary = openmc.model.hexagonal_prism(
+        edge_length=80., orientation='x', boundary_type='vacuum')
+    bottom = openmc.ZPlane(z0=-50., boundary_type='vacuum')
+    top = openmc.ZPlane(z0=50., boundary_type='vacuum')
+
+    model = openmc.Model()
+    model.geometry = openmc.Geometry([
+        openmc.Cell(fill=core, region=boundary & +bottom & -top)])
+    model.settings.batches = 30
+    model.settings.inactive = 10
+    model.settings.particles = 20000
+    model.settings.source = openmc.Source(space=openmc.stats.Box(
+        [-60., -60., -40.], [60., 60., 40.], only_fissionable=True))
+    return model
+
+
+def shielding():
+    """Fixed source 14.1 MeV neutrons in spherical shells of steel, water, and
+    concrete, with weight windows that split particles as they go deeper"""
+    steel = openmc.Material(name='Steel')
+    steel.set_density('g/cm3', 7.9)
+    steel.add_nuclide('Fe56', 0.7)
+    steel.add_nuclide('Cr52', 0.18)
+    steel.add_nuclide('Ni58', 0.12)
+
+    water = openmc.Material(name='Water')
+    water.set_density('g/cm3', 1.0)
+    water.add_nuclide('H1', 2.0)
+    water.add_nuclide('O16', 1.0)
+
+    concrete = openmc.Material(name='Concrete')
+    concrete.set_density('g/cm3', 2.3)
+    concrete.add_nuclide('H1', 0.17)
+    concrete.add_nuclide('O16', 0.56)
+    concrete.add_nuclide('Si28', 0.2)
+    concrete.add_nuclide('Ca40', 0.07)
+
+    radii = [10., 30., 60., 100.]
+    spheres = [openmc.Sphere(r=r) for r in radii]
+    spheres[-1].boundary_type = 'vacuum'
+    cells = [openmc.Cell(region=-spheres[0])]
+    for mat, inner, outer in zip([steel, water, concrete], spheres, spheres[1:]):
+        cells.append(openmc.Cell(fill=mat, region=+inner & -outer))
+
+    model = openmc.Model()
+    model.geometry = openmc.Geometry(cells)
+    model.settings.run_mode = 'fixed source'
+    model.settings.batches = 20
+    model.settings.particles = 20000
+    model.settings.source = openmc.Source(
+        space=openmc.stats.Point(), angle=openmc.stats.Isotropic(),
+        energy=openmc.stats.Discrete([14.1e6], [1.0]))
+
+    # Lower weight window bounds fall off exponentially with the distance from
+    # the source, which splits particles every few centimeters
+    mesh = openmc.RegularMesh()
+    mesh.lower_left = (-100., -100., -100.)
+    mesh.upper_right = (100., 100., 100.)
+    mesh.dimension = (20, 20, 20)
+    centers = np.linspace(-95., 95., 20)
+    x, y, z = np.meshgrid(centers, centers, centers, indexing='ij')
+    r = np.sqrt(x**2 + y**2 + z**2)
+    lower_bounds = 0.5*np.exp(-np.maximum(r - radii[0], 0.)/8.)
+    model.settings.weight_windows = openmc.WeightWindows(
+        mesh, lower_bounds.ravel(), upper_bound_ratio=5.0)
+
+    flux = openmc.Tally(name='flux')
+    flux.filters = [
+        openmc.MeshFilter(mesh),
+        openmc.EnergyFilter([1.0e-5, 0.625, 1.0e5, 2.0e7])
+    ]
+    flux.scores = ['flux']
+    model.tallies = [flux]
+    return model
+
+
+def photon_coupled():
+    """Fixed source fission neutrons in water and lead with coupled photon
+    transport and heating tallies"""
+    water = openmc.Material(name='Water')
+    water.set_density('g/cm3', 1.0)
+    water.add_nuclide('H1', 2.0)
+    water.add_nuclide('O16', 1.0)
+
+    lead = openmc.Material(name='Lead')
+    lead.set_density('g/cm3', 11.35)
+    lead.add_element('Pb', 1.0)
+
+    inner = openmc.Sphere(r=20.)
+    outer = openmc.Sphere(r=30., boundary_type='vacuum')
+    water_cell = openmc.Cell(fill=water, region=-inner)
+    lead_cell = openmc.Cell(fill=lead, region=+inner & -outer)
+
+    model = openmc.Model()
+    model.geometry = openmc.Geometry([water_cell, lead_cell])
+    model.settings.run_mode = 'fixed source'
+    model.settings.batches = 20
+    model.settings.particles = 20000
+    model.settings.photon_transport = True
+    model.settings.electron_treatment = 'ttb'
+    model.settings.source = openmc.Source(
+        space=openmc.stats.Point(), angle=openmc.stats.Isotropic(),
+        energy=openmc.stats.Watt())
+
+    heating = openmc.Tally(name='heating')
+    heating.filters = [
+        openmc.CellFilter([water_cell, lead_cell]),
+        openmc.ParticleFilter(['neutron', 'photon'])
+    ]
+    heating.scores = ['heating']
+    model.tallies = [heating]
+    return model
+
+
+MODELS = {
+    'pin_cell': pin_cell,
+    'pwr_core': pwr_core,
+    'hex_fast_core': hex_fast_core,
+    'shielding': shielding,
+    'photon_coupled': photon_coupled,
+}
@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+
+"""Run the benchmark models and report their performance as JSON.
+
+Each model is run once for every combination of the requested numbers of MPI
+processes and OpenMP threads. For each run, the report gives the startup time,
+the rates of particles in inactive and active batches, the wall time, and the
+memory high-water mark, along with the speedup and parallel efficiency relative
+to the run of the same model with the fewest threads and processes.
+
+"""
+
+import argparse
+from datetime import datetime
+import glob
+import json
+import os
+import platform
+import subprocess
+import tempfile
+import time
+
+import openmc
+
+from models import MODELS
+
+
+def run_model(name, model, threads, processes, args):
+    """Run a model in a temporary directory and return its measurements."""
+    with tempfile.TemporaryDirectory() as cwd:
+        model.export_to_xml(cwd)
+
+        command = [args.openmc_exec, '-s', str(threads)]
+        if processes > 1:
+            command = [args.mpi_exec, '-n', str(processes)] + command
+
+        start = time.perf_counter()
+        proc = subprocess.Popen(command, cwd=cwd, stdout=subprocess.DEVNULL)
+        # The resource usage of a child includes the descendants it waited
+        # for, so the high-water mark covers each MPI process
+        _, status, usage = os.wait4(proc.pid, 0)
+        wall_time = time.perf_counter() - start
+        if status != 0:
+            raise RuntimeError(f'Model {name} failed with {threads} threads '
+                               f'and {processes} processes')
+
+        statepoint = sorted(glob.glob(os.path.join(cwd, 'statepoint.*.h5')))[-1]
+        with openmc.StatePoint(statepoint) as sp:
+            runtime = sp.runtime
+
+    settings = model.settings
+    inactive = settings.inactive if settings.run_mode == 'eigenvalue' else 0
+    active = settings.batches - inactive
+    result = {
+        'model': name,
+        'threads': threads,
+        'processes': processes,
+        'particles': settings.particles,
+        'startup_time': runtime['total initialization'],
+        'reading_cross_sections': runtime['reading cross sections'],
+        'inactive_rate': None,
+        'active_rate': settings.particles*active/runtime['active batches'],
+        'wall_time': wall_time,
+        # ru_maxrss is in kilobytes on Linux
+        'max_rss_mb': usage.ru_maxrss/1024.,
+    }
+    if inactive > 0:
+        result['inactive_rate'] = (settings.particles*inactive /
+                                   runtime['inactive batches'])
+    return result
+
+
+def add_scaling(results):
+    """Add the speedup and parallel efficiency of each run relative to the run
+    of the same model with the fewest threads and processes."""
+    for name in {r['model'] for r in results}:
+        runs = [r for r in results if r['model'] == name]
+        base = min(runs, key=lambda r: r['threads']*r['processes'])
+        base_units = base['threads']*base['processes']
+        for r in runs:
+            units = r['threads']*r['processes']
+            r['speedup'] = r['active_rate']/base['active_rate']
+            r['efficiency'] = r['speedup']*base_units/units
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Run the benchmark models and report their performance.')
+    parser.add_argument('models', nargs='*',
+                        help='Models to run (default: all of {})'.format(
+                            ', '.join(MODELS)))
+    parser.add_argument('-t', '--threads', type=int, nargs='+', default=[1],
+                        help='Numbers of OpenMP threads to run with')
+    parser.add_argument('-n', '--processes', type=int, nargs='+', default=[1],
+                        help='Numbers of MPI processes to run with')
+    parser.add_argument('-p', '--particles', type=int,
+                        help='Number of particles per batch for all models')
+    parser.add_argument('--openmc-exec', default='openmc',
+                        help='OpenMC executable')
+    parser.add_argument('--mpi-exec', default='mpiexec',
+                        help='MPI launcher used with more than one process')
+    parser.add_argument('-o', '--output', default='benchmarks.json',
+                        help='JSON file to write the results to')
+    args = parser.parse_args()
+    for name in args.models:
+        if name not in MODELS:
+            parser.error(f'Unknown model: {name}')
+
+    results = []
+    for name in args.models or MODELS:
+        model = MODELS[name]()
+        if args.particles is not None:
+            model.settings.particles = args.particles
+        for processes in args.processes:
+            for threads in args.threads:
+                print(f'Running {name} with {threads} threads and '
+                      f'{processes} processes')
+                results.append(run_model(name, model, threads, processes, args))
+    add_scaling(results)
+
+    report = {
+        'openmc_version': openmc.__version__,
+        'host': platform.node(),
+        'date': datetime.now().isoformat(),
+        'results': results
+    }
+    with open(args.output, 'w') as fh:
+        json.dump(report, fh, indent=2)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,54 @@
+import openmc
+import pytest
+
+from tests.testing_harness import PyAPITestHarness
+
+
+@pytest.fixture
+def model():
+    # 3x3 lattice of fuel pins in water with reflective boundaries
+    model = openmc.Model()
+    fuel = openmc.Material()
+    fuel.add_nuclide('U235', 0.05)
+    fuel.add_nuclide('U238', 0.95)
+    fuel.add_nuclide('O16', 2.0)
+    fuel.set_density('g/cm3', 10.0)
+    water = openmc.Material()
+    water.add_nuclide('H1', 2.0)
+    water.add_nuclide('O16', 1.0)
+    water.set_density('g/cm3', 1.0)
+    water.add_s_alpha_beta('c_H_in_H2O')
+    model.materials.extend([fuel, water])
+
+    cyl = openmc.ZCylinder(r=0.4)
+    fuel_cell = openmc.Cell(fill=fuel, region=-cyl)
+    water_cell = openmc.Cell(fill=water, region=+cyl)
+    pin = openmc.Universe(universe_id=10, cells=[fuel_cell, water_cell])
+
+    lattice = openmc.RectLattice()
+    lattice.lower_left = (-1.89, -1.89)
+    lattice.pitch = (1.26, 1.26)
+    lattice.universes = [[pin]*3]*3
+
+    box = openmc.model.RectangularParallelepiped(
+        -1.89, 1.89, -1.89, 1.89, -10.0, 10.0, boundary_type='reflective')
+    model.geometry = openmc.Geometry([openmc.Cell(fill=lattice, region=-box)])
+
+    model.settings.particles = 1000
+    model.settings.inactive = 5
+    model.settings.batches = 10
+    model.settings.delta_tracking = {'universes': [10]}
+
+    # The estimator is left at its default so that the tally switches to the
+    # collision estimator in the delta-tracked universe
+    tally = openmc.Tally()
+    tally.filters = [openmc.CellFilter([fuel_cell, water_cell])]
+    tally.scores = ['flux', 'absorption', 'fission']
+    model.tallies.append(tally)
+
+    return model
+
+
+def test_delta_tracking(model):
+    harness = PyAPITestHarness('statepoint.10.h5', model)
+    harness.main()
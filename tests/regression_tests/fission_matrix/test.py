@@ -0,0 +1,73 @@
+import numpy as np
+import openmc
+import pytest
+
+from tests.testing_harness import PyAPITestHarness
+
+
+@pytest.fixture
+def model():
+    # Slab of fuel along x, reflected in y and z, whose fundamental mode is
+    # peaked in the middle
+    model = openmc.Model()
+    fuel = openmc.Material()
+    fuel.add_nuclide('U235', 0.05)
+    fuel.add_nuclide('U238', 0.95)
+    fuel.add_nuclide('O16', 2.0)
+    fuel.add_nuclide('H1', 20.0)
+    fuel.set_density('g/cm3', 3.0)
+    model.materials.append(fuel)
+
+    box = openmc.model.RectangularParallelepiped(
+        0.0, 80.0, 0.0, 5.0, 0.0, 5.0)
+    box.xmin.boundary_type = box.xmax.boundary_type = 'vacuum'
+    for surf in (box.ymin, box.ymax, box.zmin, box.zmax):
+        surf.boundary_type = 'reflective'
+    model.geometry = openmc.Geometry([openmc.Cell(fill=fuel, region=-box)])
+
+    # Start the source at one end so that it has to converge
+    model.settings.particles = 2000
+    model.settings.inactive = 10
+    model.settings.batches = 30
+    model.settings.source = openmc.Source(
+        space=openmc.stats.Box((0.0, 0.0, 0.0), (10.0, 5.0, 5.0)))
+
+    mesh = openmc.RegularMesh()
+    mesh.lower_left = (0.0, 0.0, 0.0)
+    mesh.upper_right = (80.0, 5.0, 5.0)
+    mesh.dimension = (8, 1, 1)
+    model.settings.entropy_mesh = mesh
+
+    # Correct the source with the dominant eigenvector every other batch
+    model.settings.fission_matrix = {'interval': 2}
+
+    return model
+
+
+class FissionMatrixTestHarness(PyAPITestHarness):
+    def _get_results(self):
+        """Digest k-effective and the fission matrix and its source."""
+        outstr = super()._get_results()
+        with openmc.StatePoint(self._sp_name) as sp:
+            keff = sp.keff
+            matrix = sp.fission_matrix
+            source = sp.fission_matrix_source
+
+        # Every bin was sampled, and the dominant eigenvalue of the matrix is
+        # an estimate of k-effective
+        assert matrix.shape == (8, 8)
+        assert (matrix >= 0.0).all()
+        assert (source > 0.0).all()
+        k_matrix = np.max(np.abs(np.linalg.eigvals(matrix)))
+        assert k_matrix == pytest.approx(keff.n, rel=0.05)
+
+        outstr += 'fission matrix:\n'
+        outstr += '\n'.join('{0:12.6E}'.format(x) for x in matrix.ravel())
+        outstr += '\nfission matrix source:\n'
+        outstr += '\n'.join('{0:12.6E}'.format(x) for x in source)
+        return outstr + '\n'
+
+
+def test_fission_matrix(model):
+    harness = FissionMatrixTestHarness('statepoint.30.h5', model)
+    harness.main()
@@ -0,0 +1,104 @@
+import numpy as np
+import openmc
+import openmc.lib
+import pytest
+
+from tests.testing_harness import PyAPITestHarness, config
+
+N_GROUPS = 100
+ENERGY_MIN = 1.0e-5
+ENERGY_MAX = 20.0e6
+
+
+@pytest.fixture
+def model():
+    # Fuel sphere in water, with a tally of the flux in the same groups as the
+    # spectrum for comparison
+    model = openmc.Model()
+    fuel = openmc.Material()
+    fuel.add_nuclide('U235', 0.05)
+    fuel.add_nuclide('U238', 0.95)
+    fuel.add_nuclide('O16', 2.0)
+    fuel.set_density('g/cm3', 10.0)
+    water = openmc.Material()
+    water.add_nuclide('H1', 2.0)
+    water.add_nuclide('O16', 1.0)
+    water.set_density('g/cm3', 1.0)
+    model.materials.extend([fuel, water])
+
+    inner = openmc.Sphere(r=20.0)
+    outer = openmc.Sphere(r=30.0, boundary_type='vacuum')
+    model.geometry = openmc.Geometry([
+        openmc.Cell(fill=fuel, region=-inner),
+        openmc.Cell(fill=water, region=+inner & -outer)
+    ])
+    model.settings.particles = 1000
+    model.settings.inactive = 2
+    model.settings.batches = 7
+
+    energy = np.logspace(np.log10(ENERGY_MIN), np.log10(ENERGY_MAX),
+                         N_GROUPS + 1)
+    tally = openmc.Tally()
+    tally.filters = [openmc.MaterialFilter([fuel, water]),
+                     openmc.EnergyFilter(energy)]
+    tally.scores = ['flux']
+    tally.estimator = 'tracklength'
+    model.tallies.append(tally)
+
+    return model
+
+
+class FluxSpectrumTestHarness(PyAPITestHarness):
+    def _run_openmc(self):
+        intracomm = None
+        if config['mpi']:
+            from mpi4py import MPI
+            intracomm = MPI.COMM_WORLD
+
+        openmc.lib.init(intracomm=intracomm)
+        try:
+            materials = [openmc.lib.materials[m.id]
+                         for m in self._model.materials]
+            openmc.lib.set_flux_spectrum(
+                materials, N_GROUPS, ENERGY_MIN, ENERGY_MAX)
+            openmc.lib.run()
+
+            self._energy, self._flux = openmc.lib.flux_spectrum()
+            self._rates = openmc.lib.flux_spectrum_collapse_rates(
+                ['U235'], [18], [294.0, 294.0])
+
+            # Rates collapsed with the stored spectra match those collapsed
+            # with copies of them
+            expected = openmc.lib.collapse_rates(
+                ['U235'], [18], [294.0, 294.0], self._energy, self._flux)
+            assert self._rates.ravel() == pytest.approx(
+                expected.ravel(), rel=1e-6)
+        finally:
+            openmc.lib.finalize()
+
+    def _get_results(self):
+        """Digest the tally results, the spectra and the collapsed rates."""
+        outstr = super()._get_results()
+        assert self._flux.shape == (2, N_GROUPS)
+
+        # The spectrum scores the same tracks as the tally, so they only
+        # differ by the single precision of the spectrum
+        with openmc.StatePoint(self._sp_name) as sp:
+            tally = sp.tallies[self._model.tallies[0].id]
+            mean = tally.mean.reshape(2, N_GROUPS)
+        assert self._energy == pytest.approx(
+            self._model.tallies[0].filters[1].values, rel=1e-8)
+        assert self._flux == pytest.approx(mean, rel=1e-4, abs=1e-12)
+
+        outstr += 'flux spectrum:\n'
+        outstr += '\n'.join('{0:12.6E}'.format(x)
+                             for x in self._flux.ravel())
+        outstr += '\ncollapsed rates:\n'
+        outstr += '\n'.join('{0:12.6E}'.format(x)
+                             for x in self._rates.ravel())
+        return outstr + '\n'
+
+
+def test_flux_spectrum(model):
+    harness = FluxSpectrumTestHarness('statepoint.7.h5', model)
+    harness.main()
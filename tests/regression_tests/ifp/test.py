@@ -0,0 +1,105 @@
+import math
+import os
+
+import openmc
+import pytest
+
+from tests.testing_harness import PyAPITestHarness
+
+# One-group infinite medium with a single delayed group. The adjoint flux is
+# flat, so the adjoint-weighted delayed neutron fraction is the fraction of
+# neutrons born delayed, and the adjoint-weighted generation time is the mean
+# time until absorption divided by k-effective.
+TOTAL = 1.0
+ABSORPTION = 0.5
+NU_FISSION = 0.6
+BETA = 0.1
+GROUP_EDGES = [0.0, 2.0e6]
+
+# More generations than the ancestors of a source site used to have room for
+N_GENERATION = 20
+
+
+def neutron_speed():
+    # Multigroup neutrons move at the speed of the middle of their group
+    mass = 939.56542052e6
+    energy = 0.5*(GROUP_EDGES[0] + GROUP_EDGES[1])
+    inv_gamma = mass / (energy + mass)
+    return 2.99792458e10 * math.sqrt(1.0 - inv_gamma**2)
+
+
+def create_library():
+    groups = openmc.mgxs.EnergyGroups(group_edges=GROUP_EDGES)
+    library = openmc.MGXSLibrary(groups, num_delayed_groups=1)
+    xs = openmc.XSdata('fuel', groups, num_delayed_groups=1)
+    xs.order = 0
+    xs.set_total([TOTAL])
+    xs.set_absorption([ABSORPTION])
+    xs.set_scatter_matrix([[[TOTAL - ABSORPTION]]])
+    xs.set_fission([NU_FISSION / 2.5])
+    xs.set_nu_fission([NU_FISSION])
+    xs.set_chi([1.0])
+    xs.set_beta([BETA])
+    library.add_xsdata(xs)
+    library.export_to_hdf5('mgxs.h5')
+
+
+@pytest.fixture
+def model():
+    model = openmc.Model()
+    fuel = openmc.Material()
+    fuel.add_macroscopic('fuel')
+    model.materials.append(fuel)
+    model.materials.cross_sections = 'mgxs.h5'
+
+    box = openmc.model.RectangularParallelepiped(
+        -5.0, 5.0, -5.0, 5.0, -5.0, 5.0, boundary_type='reflective')
+    model.geometry = openmc.Geometry([openmc.Cell(fill=fuel, region=-box)])
+
+    model.settings.energy_mode = 'multi-group'
+    model.settings.particles = 5000
+    model.settings.inactive = N_GENERATION
+    model.settings.batches = N_GENERATION + 20
+    model.settings.ifp_n_generation = N_GENERATION
+
+    tally = openmc.Tally()
+    tally.scores = ['ifp-time-numerator', 'ifp-beta-numerator',
+                    'ifp-denominator']
+    model.tallies.append(tally)
+
+    return model
+
+
+class IfpTestHarness(PyAPITestHarness):
+    def _get_results(self):
+        """Digest k-effective and the IFP tally, checking the kinetics."""
+        with openmc.StatePoint(self._sp_name) as sp:
+            keff = sp.keff
+            tally = sp.tallies[self._model.tallies[0].id]
+            time_num, beta_num, denom = tally.mean.ravel()
+
+        k_inf = NU_FISSION / ABSORPTION
+        assert abs(keff.n - k_inf) <= 3*keff.s + 1e-3*k_inf
+
+        # Every fission is scored once ancestors are known for all
+        # generations, and the kinetics parameters are within a few percent
+        # of the exact ones
+        assert denom > 0.0
+        beta_eff = beta_num / denom
+        assert beta_eff == pytest.approx(BETA, rel=0.05)
+        generation_time = time_num / denom / keff.n
+        lifetime = 1.0 / (neutron_speed() * ABSORPTION)
+        assert generation_time == pytest.approx(lifetime / k_inf, rel=0.05)
+
+        return super()._get_results()
+
+    def _cleanup(self):
+        super()._cleanup()
+        if os.path.exists('mgxs.h5'):
+            os.remove('mgxs.h5')
+
+
+def test_ifp(model):
+    create_library()
+    harness = IfpTestHarness('statepoint.40.h5', model)
+    harness.main()
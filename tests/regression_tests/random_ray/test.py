@@ -0,0 +1,89 @@
+import os
+
+import h5py
+import numpy as np
+import openmc
+import pytest
+
+from tests.testing_harness import PyAPITestHarness
+
+# Two-group isotropic data for a single material, with little enough
+# scattering that source iteration converges within the inactive batches
+TOTAL = np.array([0.3, 0.8])
+SCATTER = np.array([[0.1, 0.02], [0.0, 0.2]])
+NU_FISSION = np.array([0.1, 0.9])
+CHI = np.array([1.0, 0.0])
+
+
+def create_library():
+    groups = openmc.mgxs.EnergyGroups(group_edges=[0.0, 0.625, 20.0e6])
+    library = openmc.MGXSLibrary(groups)
+    xs = openmc.XSdata('fuel', groups)
+    xs.order = 0
+    xs.set_total(TOTAL)
+    xs.set_absorption(TOTAL - SCATTER.sum(axis=1))
+    xs.set_scatter_matrix(SCATTER[..., np.newaxis])
+    xs.set_nu_fission(NU_FISSION)
+    xs.set_chi(CHI)
+    library.add_xsdata(xs)
+    library.export_to_hdf5('mgxs.h5')
+
+
+@pytest.fixture
+def model():
+    # Reflected cube of one material divided into slabs, which is an infinite
+    # medium whose flat sources are exact
+    model = openmc.Model()
+    fuel = openmc.Material()
+    fuel.add_macroscopic('fuel')
+    model.materials.append(fuel)
+    model.materials.cross_sections = 'mgxs.h5'
+
+    box = openmc.model.RectangularParallelepiped(
+        0.0, 8.0, 0.0, 8.0, 0.0, 8.0, boundary_type='reflective')
+    planes = [openmc.XPlane(x) for x in (2.0, 4.0, 6.0)]
+    regions = [-planes[0], +planes[0] & -planes[1], +planes[1] & -planes[2],
+               +planes[2]]
+    model.geometry = openmc.Geometry(
+        [openmc.Cell(fill=fuel, region=-box & r) for r in regions])
+
+    model.settings.energy_mode = 'multi-group'
+    model.settings.particles = 1000
+    model.settings.inactive = 30
+    model.settings.batches = 50
+    model.settings.random_ray = {
+        'distance_inactive': 10.0,
+        'distance_active': 50.0,
+        'lower_left': (0.0, 0.0, 0.0),
+        'upper_right': (8.0, 8.0, 8.0)
+    }
+    return model
+
+
+class RandomRayTestHarness(PyAPITestHarness):
+    def _get_results(self):
+        """Digest the eigenvalue and source region fluxes as a string."""
+        with h5py.File(self._sp_name, 'r') as f:
+            k_combined = f['k_combined'][()]
+            flux = f['flux'][()]
+            volumes = f['volumes'][()]
+
+        outstr = 'k-combined:\n'
+        outstr += '{0:12.6E} {1:12.6E}\n'.format(*k_combined)
+        outstr += 'volumes:\n'
+        outstr += '\n'.join('{0:12.6E}'.format(x) for x in volumes) + '\n'
+        outstr += 'flux:\n'
+        outstr += '\n'.join('{0:12.6E}'.format(x) for x in flux.ravel())
+        return outstr + '\n'
+
+    def _cleanup(self):
+        super()._cleanup()
+        for f in ('mgxs.h5', self._sp_name):
+            if os.path.exists(f):
+                os.remove(f)
+
+
+def test_random_ray(model):
+    create_library()
+    harness = RandomRayTestHarness('random_ray.h5', model)
+    harness.main()
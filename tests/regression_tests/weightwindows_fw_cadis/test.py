@@ -0,0 +1,114 @@
+import os
+
+import h5py
+import numpy as np
+import openmc
+import pytest
+
+from tests.testing_harness import PyAPITestHarness
+
+GROUP_EDGES = [0.0, 0.625, 20.0e6]
+
+
+def create_library():
+    # Two-group shield that mostly scatters neutrons down and absorbs them
+    groups = openmc.mgxs.EnergyGroups(group_edges=GROUP_EDGES)
+    library = openmc.MGXSLibrary(groups)
+    xs = openmc.XSdata('shield', groups)
+    xs.order = 0
+    total = np.array([0.2, 0.4])
+    scatter = np.array([[0.15, 0.03], [0.0, 0.3]])
+    xs.set_total(total)
+    xs.set_absorption(total - scatter.sum(axis=1))
+    xs.set_scatter_matrix(scatter[..., np.newaxis])
+    library.add_xsdata(xs)
+    library.export_to_hdf5('mgxs.h5')
+
+
+@pytest.fixture
+def model():
+    # Slab shield along x with a fast source at one end, reflected in y and z
+    model = openmc.Model()
+    shield = openmc.Material()
+    shield.add_macroscopic('shield')
+    model.materials.append(shield)
+    model.materials.cross_sections = 'mgxs.h5'
+
+    box = openmc.model.RectangularParallelepiped(
+        0.0, 40.0, 0.0, 4.0, 0.0, 4.0)
+    box.xmin.boundary_type = box.xmax.boundary_type = 'vacuum'
+    for surf in (box.ymin, box.ymax, box.zmin, box.zmax):
+        surf.boundary_type = 'reflective'
+    planes = [openmc.XPlane(x) for x in np.linspace(4.0, 36.0, 9)]
+    bounds = [None] + planes + [None]
+    cells = []
+    for lower, upper in zip(bounds[:-1], bounds[1:]):
+        region = -box
+        if lower is not None:
+            region &= +lower
+        if upper is not None:
+            region &= -upper
+        cells.append(openmc.Cell(fill=shield, region=region))
+    model.geometry = openmc.Geometry(cells)
+
+    model.settings.energy_mode = 'multi-group'
+    model.settings.run_mode = 'fixed source'
+    model.settings.particles = 2000
+    model.settings.batches = 10
+    model.settings.source = openmc.Source(
+        space=openmc.stats.Box((0.0, 0.0, 0.0), (4.0, 4.0, 4.0)),
+        energy=openmc.stats.Discrete([1.0e6], [1.0]))
+
+    mesh = openmc.RegularMesh()
+    mesh.lower_left = (0.0, 0.0, 0.0)
+    mesh.upper_right = (40.0, 4.0, 4.0)
+    mesh.dimension = (10, 1, 1)
+    tally = openmc.Tally()
+    tally.filters = [openmc.MeshFilter(mesh)]
+    tally.scores = ['flux']
+    model.tallies.append(tally)
+
+    # Weight windows and source biasing from the random ray adjoint flux
+    model.settings.weight_window_generators = openmc.WeightWindowGenerator(
+        mesh, energy_bounds=GROUP_EDGES, method='fw_cadis')
+    model.settings.random_ray = {
+        'distance_inactive': 10.0,
+        'distance_active': 100.0,
+        'lower_left': (0.0, 0.0, 0.0),
+        'upper_right': (40.0, 4.0, 4.0)
+    }
+
+    return model
+
+
+class FwCadisTestHarness(PyAPITestHarness):
+    def _get_results(self):
+        """Digest the tally results and the generated weight windows."""
+        outstr = super()._get_results()
+        with h5py.File('random_ray.h5', 'r') as f:
+            groups = [g for g in f.values() if 'lower_ww_bounds' in g]
+            assert len(groups) == 1
+            lower = groups[0]['lower_ww_bounds'][()]
+            upper = groups[0]['upper_ww_bounds'][()]
+
+        # The adjoint flux reaches every part of the shield, so each mesh bin
+        # and energy group has a window
+        assert (lower > 0.0).all()
+        assert (upper > lower).all()
+
+        outstr += 'weight windows:\n'
+        outstr += '\n'.join('{0:12.6E} {1:12.6E}'.format(*b)
+                             for b in zip(lower, upper))
+        return outstr + '\n'
+
+    def _cleanup(self):
+        super()._cleanup()
+        for f in ('mgxs.h5', 'random_ray.h5'):
+            if os.path.exists(f):
+                os.remove(f)
+
+
+def test_fw_cadis(model):
+    create_library()
+    harness = FwCadisTestHarness('statepoint.10.h5', model)
+    harness.main()
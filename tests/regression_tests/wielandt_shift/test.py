@@ -0,0 +1,44 @@
+import openmc
+import pytest
+
+from tests.testing_harness import PyAPITestHarness
+
+
+@pytest.fixture
+def model():
+    # Reflected pin cell with tallies in the fuel and the water
+    model = openmc.Model()
+    fuel = openmc.Material()
+    fuel.add_nuclide('U235', 0.05)
+    fuel.add_nuclide('U238', 0.95)
+    fuel.add_nuclide('O16', 2.0)
+    fuel.set_density('g/cm3', 10.0)
+    water = openmc.Material()
+    water.add_nuclide('H1', 2.0)
+    water.add_nuclide('O16', 1.0)
+    water.set_density('g/cm3', 1.0)
+    model.materials.extend([fuel, water])
+
+    cyl = openmc.ZCylinder(r=0.4)
+    box = openmc.model.RectangularParallelepiped(
+        -0.63, 0.63, -0.63, 0.63, -10.0, 10.0, boundary_type='reflective')
+    fuel_cell = openmc.Cell(fill=fuel, region=-cyl & -box)
+    water_cell = openmc.Cell(fill=water, region=+cyl & -box)
+    model.geometry = openmc.Geometry([fuel_cell, water_cell])
+
+    model.settings.particles = 2000
+    model.settings.inactive = 5
+    model.settings.batches = 25
+    model.settings.wielandt_shift = 0.5
+
+    tally = openmc.Tally()
+    tally.filters = [openmc.CellFilter([fuel_cell, water_cell])]
+    tally.scores = ['flux', 'absorption', 'nu-fission']
+    model.tallies.append(tally)
+
+    return model
+
+
+def test_wielandt_shift(model):
+    harness = PyAPITestHarness('statepoint.25.h5', model)
+    harness.main()
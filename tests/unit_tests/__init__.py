@@ -1,6 +1,7 @@
 import shutil
 
 import numpy as np
+import openmc
 import pytest
 
 
@@ -14,3 +15,10 @@ def assert_unbounded(obj):
     ll, ur = obj.bounding_box
     assert ll == pytest.approx((-np.inf, -np.inf, -np.inf))
     assert ur == pytest.approx((np.inf, np.inf, np.inf))
+
+
+def tally_results(sp_path, tally_id):
+    """Flattened mean and standard deviation of a tally in a statepoint."""
+    with openmc.StatePoint(sp_path) as sp:
+        tally = sp.tallies[tally_id]
+        return tally.mean.ravel(), tally.std_dev.ravel()
@@ -13,6 +13,18 @@ def mpi_intracomm():
         return None
 
 
+@pytest.fixture(scope='module')
+def run_model():
+    """Function running a model with the executable and MPI settings of the
+    test configuration, returning the path to its last statepoint"""
+    def run(model, **kwargs):
+        kwargs.setdefault('openmc_exec', config['exe'])
+        if config['mpi']:
+            kwargs['mpi_args'] = [config['mpiexec'], '-n', config['mpi_np']]
+        return model.run(**kwargs)
+    return run
+
+
 @pytest.fixture(scope='module')
 def uo2():
     m = openmc.Material(material_id=100, name='UO2')
@@ -52,6 +64,33 @@ def sphere_model():
     return model
 
 
+@pytest.fixture
+def fuel_sphere_model():
+    """Eigenvalue model of a sphere of fuel in a water reflector"""
+    model = openmc.Model()
+    fuel = openmc.Material()
+    fuel.add_nuclide('U235', 0.05)
+    fuel.add_nuclide('U238', 0.95)
+    fuel.add_nuclide('O16', 2.0)
+    fuel.set_density('g/cm3', 10.0)
+    water = openmc.Material()
+    water.add_nuclide('H1', 2.0)
+    water.add_nuclide('O16', 1.0)
+    water.set_density('g/cm3', 1.0)
+    model.materials.extend([fuel, water])
+
+    inner = openmc.Sphere(r=20.0)
+    outer = openmc.Sphere(r=30.0, boundary_type='vacuum')
+    model.geometry = openmc.Geometry([
+        openmc.Cell(fill=fuel, region=-inner),
+        openmc.Cell(fill=water, region=+inner & -outer)
+    ])
+    model.settings.particles = 1000
+    model.settings.inactive = 2
+    model.settings.batches = 8
+    return model
+
+
 @pytest.fixture
 def cell_with_lattice():
     m_inside = [openmc.Material(), openmc.Material(), None, openmc.Material()]
@@ -0,0 +1,67 @@
+import numpy as np
+import openmc
+import pytest
+
+from tests.testing_harness import config
+
+# One-group infinite medium whose multiplication factor is NU_FISSION divided
+# by ABSORPTION
+TOTAL = 1.0
+ABSORPTION = 0.5
+NU_FISSION = 4.0
+
+
+@pytest.fixture
+def model():
+    groups = openmc.mgxs.EnergyGroups(group_edges=[0.0, 20.0e6])
+    library = openmc.MGXSLibrary(groups)
+    xs = openmc.XSdata('fuel', groups)
+    xs.order = 0
+    xs.set_total([TOTAL])
+    xs.set_absorption([ABSORPTION])
+    xs.set_scatter_matrix([[[TOTAL - ABSORPTION]]])
+    xs.set_fission([ABSORPTION])
+    xs.set_nu_fission([NU_FISSION])
+    xs.set_chi([1.0])
+    library.add_xsdata(xs)
+    library.export_to_hdf5('mgxs.h5')
+
+    model = openmc.Model()
+    fuel = openmc.Material()
+    fuel.add_macroscopic('fuel')
+    model.materials.append(fuel)
+    model.materials.cross_sections = 'mgxs.h5'
+
+    box = openmc.model.RectangularParallelepiped(
+        -5.0, 5.0, -5.0, 5.0, -5.0, 5.0, boundary_type='reflective')
+    model.geometry = openmc.Geometry([openmc.Cell(fill=fuel, region=-box)])
+
+    model.settings.energy_mode = 'multi-group'
+    model.settings.particles = 1000
+    model.settings.inactive = 5
+    model.settings.batches = 15
+    return model
+
+
+def test_fission_bank_overflow(model, run_in_tmpdir, capsys):
+    # Sites are banked for a multiplication factor of one in the first
+    # generation, so each thread produces about eight sites per source
+    # particle and overflows the bank, which holds three
+    kwargs = {'openmc_exec': config['exe'], 'threads': 4}
+    if config['mpi']:
+        kwargs['mpi_args'] = [config['mpiexec'], '-n', config['mpi_np']]
+    sp_path = model.run(**kwargs)
+
+    # None of the sites that overflowed were dropped
+    assert 'fission bank is full' not in capsys.readouterr().out
+
+    with openmc.StatePoint(sp_path) as sp:
+        keff = sp.keff
+        k_generation = sp.k_generation
+
+    # The bank is back to its capacity after the first generation and the
+    # multiplication is unaffected by the overflow
+    k_inf = NU_FISSION / ABSORPTION
+    assert k_generation[0] == pytest.approx(k_inf, rel=0.05)
+    assert abs(keff.n - k_inf) <= 3*keff.s + 1e-3*k_inf
+    assert np.all(np.isfinite(k_generation))
@@ -140,6 +140,13 @@ def test_cell_temperature(lib_init):
     cell.set_temperature(200)
     assert cell.get_temperature() == pytest.approx(200.0)
 
+    openmc.lib.set_cell_temperatures([cell], [150.0], [0])
+    assert cell.get_temperature(0) == pytest.approx(150.0)
+    with pytest.raises(exc.OutOfBoundsError):
+        openmc.lib.set_cell_temperatures([cell], [150.0], [1000])
+    openmc.lib.set_cell_temperatures([cell], [200.0])
+    assert cell.get_temperature() == pytest.approx(200.0)
+
 
 def test_properties_temperature(lib_init):
     # Cell temperature should be 200 from above test
@@ -232,6 +239,25 @@ def test_material_add_nuclide(lib_init):
     assert m.densities[-1] == 1e-12
 
 
+def test_set_material_densities(lib_init):
+    m = openmc.lib.materials[3]
+    nuclides = m.nuclides
+
+    # A subset of the nuclides is updated in place
+    openmc.lib.set_material_densities([m], ['O16', 'H1'], [[3.0e-2, 6.0e-2]])
+    assert m.nuclides == nuclides
+    assert m.densities == pytest.approx([6.0e-2, 3.0e-2] + [0.0]*3)
+
+    # A nuclide that isn't in the material yet replaces the nuclide list
+    openmc.lib.set_material_densities(
+        [m], ['H1', 'O16', 'U235'], [[6.0e-2, 3.0e-2, 1.0e-4]])
+    assert m.nuclides == ['H1', 'O16', 'U235']
+    assert m.densities == pytest.approx([6.0e-2, 3.0e-2, 1.0e-4])
+
+    openmc.lib.set_material_densities([m], nuclides, [[1.0e-1]*5])
+    assert m.nuclides == nuclides
+
+
 def test_new_material(lib_init):
     with pytest.raises(exc.AllocationError):
         openmc.lib.Material(1)
@@ -360,8 +386,10 @@ def test_tally_results(lib_run):
     t = openmc.lib.tallies[1]
     assert t.num_realizations == 10  # t was made active in test_tally_active
     assert np.all(t.mean >= 0)
+    assert t.mean == pytest.approx(t.results[:, :, 1] / 10)
     nonzero = (t.mean > 0.0)
     assert np.all(t.std_dev[nonzero] >= 0)
+    assert np.all(np.isinf(t.std_dev[~nonzero]))
     assert np.all(t.ci_width()[nonzero] >= 1.95*t.std_dev[nonzero])
 
     t2 = openmc.lib.tallies[2]
@@ -413,6 +441,49 @@ def test_by_batch(lib_run):
         openmc.lib.simulation_finalize()
 
 
+def test_majorant_xs(lib_run):
+    for E in (0.0253, 1.0e3, 1.0e6):
+        xs = openmc.lib.majorant_xs(E)
+        assert xs > 0.0
+    with pytest.raises(exc.InvalidIDError):
+        openmc.lib.majorant_xs(1.0, universe=-2)
+
+
+def test_performance_counters(lib_run):
+    openmc.lib.hard_reset()
+    openmc.lib.simulation_init()
+    try:
+        counts, time = openmc.lib.performance_counters()
+        assert all(n == 0 for n in counts.values())
+
+        openmc.lib.next_batch()
+        counts, time = openmc.lib.performance_counters()
+        assert counts['collisions'] > 0
+        assert counts['xs_lookups'] > 0
+        assert counts['surface_crossings'] > 0
+        assert time > 0.0
+    finally:
+        openmc.lib.simulation_finalize()
+
+
+def test_memory_usage(lib_run):
+    openmc.lib.hard_reset()
+    openmc.lib.simulation_init()
+    try:
+        openmc.lib.next_batch()
+        current, peak, resident = openmc.lib.memory_usage()
+        assert current['nuclides'] > 0
+        assert current['geometry'] > 0
+        assert current['banks'] > 0
+        assert all(peak[key] >= current[key] for key in current)
+        assert resident >= 0
+
+        u235 = openmc.lib.nuclides['U235']
+        assert 0 < u235.memory_usage <= current['nuclides']
+    finally:
+        openmc.lib.simulation_finalize()
+
+
 def test_set_n_batches(lib_run):
     # Run simulation_init so that current_batch reset to 0
     openmc.lib.hard_reset()
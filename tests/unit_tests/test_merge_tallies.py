@@ -0,0 +1,52 @@
+from pathlib import Path
+from subprocess import check_call
+import sys
+
+import openmc
+import pytest
+
+from tests.testing_harness import config
+from tests.unit_tests import tally_results
+
+MERGE_TALLIES = Path(__file__).parents[2] / 'scripts' / 'openmc-merge-tallies'
+
+
+@pytest.fixture
+def model(fuel_sphere_model):
+    # Mesh tally over the fuel sphere model with many bins
+    mesh = openmc.RegularMesh()
+    mesh.lower_left = (-30.0, -30.0, -30.0)
+    mesh.upper_right = (30.0, 30.0, 30.0)
+    mesh.dimension = (4, 4, 4)
+    tally = openmc.Tally()
+    tally.filters = [openmc.MeshFilter(mesh)]
+    tally.scores = ['flux', 'fission']
+    fuel_sphere_model.tallies.append(tally)
+    return fuel_sphere_model
+
+
+def test_merge_tallies(model, run_model, run_in_tmpdir):
+    tally_id = model.tallies[0].id
+
+    # Results reduced onto the master process as usual
+    sp_path = run_model(model)
+    mean, std_dev = tally_results(sp_path, tally_id)
+
+    # Results written to a file by each process and merged afterwards
+    model.settings.no_reduce = True
+    model.settings.tally_rank_files = True
+    sp_path = run_model(model)
+    n_files = int(config['mpi_np']) if config['mpi'] else 1
+    for rank in range(n_files):
+        assert sp_path.with_suffix(f'.rank{rank}.h5').is_file()
+
+    merged = Path('merged.h5')
+    check_call([sys.executable, str(MERGE_TALLIES), str(sp_path),
+                '-o', str(merged)])
+    mean_merged, std_dev_merged = tally_results(merged, tally_id)
+
+    # Without reduction, every process contributes its own realizations, so
+    # the estimates differ between the runs only within statistics
+    assert (std_dev_merged > 0.0).any()
+    tolerance = 3*(std_dev**2 + std_dev_merged**2)**0.5
+    assert (abs(mean - mean_merged) <= tolerance).all()
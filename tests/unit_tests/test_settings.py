@@ -16,13 +16,16 @@ def test_export_to_xml(run_in_tmpdir):
     s.max_order = 5
     s.max_tracks = 1234
     s.source = openmc.Source(space=openmc.stats.Point())
-    s.output = {'summary': True, 'tallies': False, 'path': 'here'}
+    s.output = {'summary': True, 'summary_compact': True,
+                'summary_reuse': False, 'tallies': False,
+                'tallies_max_bins': 100000, 'path': 'here'}
     s.verbosity = 7
     s.sourcepoint = {'batches': [50, 150, 500, 1000], 'separate': True,
                      'write': True, 'overwrite': True}
     s.statepoint = {'batches': [50, 150, 500, 1000]}
     s.surf_source_read = {'path': 'surface_source_1.h5'}
-    s.surf_source_write = {'surface_ids': [2], 'max_particles': 200}
+    s.surf_source_write = {'surface_ids': [2], 'max_particles': 200,
+                           'stream': True}
     s.confidence_intervals = True
     s.ptables = True
     s.seed = 17
@@ -41,7 +44,8 @@ def test_export_to_xml(run_in_tmpdir):
     s.no_reduce = False
     s.tabular_legendre = {'enable': True, 'num_points': 50}
     s.temperature = {'default': 293.6, 'method': 'interpolation',
-                     'multipole': True, 'range': (200., 1000.)}
+                     'multipole': True, 'multipole_quadrature': True,
+                     'range': (200., 1000.), 'lazy': True}
     s.trace = (10, 1, 20)
     s.track = [(1, 1, 1), (2, 1, 1)]
     s.ufs_mesh = mesh
@@ -51,11 +55,69 @@ def test_export_to_xml(run_in_tmpdir):
     s.volume_calculations = openmc.VolumeCalculation(
         domains=[openmc.Cell()], samples=1000, lower_left=(-10., -10., -10.),
         upper_right = (10., 10., 10.))
+    s.volume_calculations[0].estimator = 'ray'
     s.create_fission_neutrons = True
+    s.crossing_recovery = {'enable': True, 'distance': 1.0e-4}
+    s.delta_tracking = {'enable': True, 'universes': [2, 3], 'max_ratio': 5.0}
+    s.fission_matrix = {'enable': True, 'interval': 10}
+    s.overlap_checks = {'enable': True, 'fraction': 0.1,
+                        'crossings_only': True}
+    s.random_ray = {'distance_active': 100.0, 'distance_inactive': 10.0,
+                    'lower_left': [-1.0, -1.0, -1.0],
+                    'upper_right': [1.0, 1.0, 1.0]}
     s.log_grid_bins = 2000
     s.photon_transport = False
+    s.photon_scattering_tables = True
     s.electron_treatment = 'led'
+    s.electron_step_fraction = 0.1
     s.write_initial_source = True
+    s.union_grid = True
+    s.event_xs_batch_size = 64
+    s.hash_grid_points_per_bin = 4
+    s.shared_cross_sections = True
+    s.numa_first_touch = True
+    s.huge_pages = True
+    s.cross_sections_cache = 'xs_cache'
+    s.census_times = [1e-6, 1e-3]
+    s.compact_bank = True
+    s.compact_micro_xs = True
+    s.xs_cdf = True
+    s.condense_relaxation = True
+    s.pipelined_bank = True
+    s.precompute_neighbors = True
+    s.profile = True
+    s.profile_domains = True
+    s.lattice_dda = True
+    s.tally_reduce_interval = 5
+    s.tally_rank_files = True
+    s.tally_stream = {'path': '/dev/shm/tallies.bin', 'tallies': [1, 3]}
+    s.io_stripe_size = 1048576
+    s.async_statepoint = True
+    s.auto_tune = True
+    s.source_compression = 4
+    s.source_precision = 'single'
+    s.partition_source_files = True
+    s.mmap_source_files = True
+    s.mpi_progress_thread = True
+    s.weight_window_mesh_crossings = True
+    s.weight_window_generators = openmc.WeightWindowGenerator(
+        mesh, energy_bounds=[0.0, 1.0, 20.0e6], update_interval=2, ratio=4.0)
+    s.secondary_bank_capacity = 500
+    s.event_secondary_queue = True
+    s.event_schedule = 'ordered'
+    s.event_min_queue_size = 256
+    s.event_refill_threshold = 0.5
+    s.event_sort_threshold = 1000
+    s.history_schedule = 'work_stealing'
+    s.work_chunk_size = 100
+    s.track_writer_thread = True
+    s.track_fraction = 0.25
+    s.track_region = ((-1.0, -2.0, -3.0), (1.0, 2.0, 3.0))
+    s.track_compression = 4
+    s.track_precision = 'single'
+    s.track_delta_positions = True
+    s.wielandt_shift = 0.1
+    s.ifp_n_generation = 5
 
     # Make sure exporting XML works
     s.export_to_xml()
@@ -75,13 +137,16 @@ def test_export_to_xml(run_in_tmpdir):
     assert s.max_tracks == 1234
     assert isinstance(s.source[0], openmc.Source)
     assert isinstance(s.source[0].space, openmc.stats.Point)
-    assert s.output == {'summary': True, 'tallies': False, 'path': 'here'}
+    assert s.output == {'summary': True, 'summary_compact': True,
+                        'summary_reuse': False, 'tallies': False,
+                        'tallies_max_bins': 100000, 'path': 'here'}
     assert s.verbosity == 7
     assert s.sourcepoint == {'batches': [50, 150, 500, 1000], 'separate': True,
                              'write': True, 'overwrite': True}
     assert s.statepoint == {'batches': [50, 150, 500, 1000]}
     assert s.surf_source_read == {'path': 'surface_source_1.h5'}
-    assert s.surf_source_write == {'surface_ids': [2], 'max_particles': 200}
+    assert s.surf_source_write == {'surface_ids': [2], 'max_particles': 200,
+                                   'stream': True}
     assert s.confidence_intervals
     assert s.ptables
     assert s.seed == 17
@@ -99,7 +164,8 @@ def test_export_to_xml(run_in_tmpdir):
     assert not s.no_reduce
     assert s.tabular_legendre == {'enable': True, 'num_points': 50}
     assert s.temperature == {'default': 293.6, 'method': 'interpolation',
-                             'multipole': True, 'range': [200., 1000.]}
+                             'multipole': True, 'multipole_quadrature': True,
+                             'range': [200., 1000.], 'lazy': True}
     assert s.trace == [10, 1, 20]
     assert s.track == [(1, 1, 1), (2, 1, 1)]
     assert isinstance(s.ufs_mesh, openmc.RegularMesh)
@@ -110,10 +176,74 @@ def test_export_to_xml(run_in_tmpdir):
                                       'energy_min': 1.0, 'energy_max': 1000.0,
                                       'nuclides': ['U235', 'U238', 'Pu239']}
     assert s.create_fission_neutrons
+    assert s.crossing_recovery == {'enable': True, 'distance': 1.0e-4}
+    assert s.delta_tracking == {'enable': True, 'universes': [2, 3],
+                                'max_ratio': 5.0}
+    assert s.fission_matrix == {'enable': True, 'interval': 10}
+    assert s.overlap_checks == {'enable': True, 'fraction': 0.1,
+                                'crossings_only': True}
+    assert s.random_ray == {'distance_active': 100.0, 'distance_inactive': 10.0,
+                            'lower_left': [-1.0, -1.0, -1.0],
+                            'upper_right': [1.0, 1.0, 1.0]}
     assert s.log_grid_bins == 2000
     assert not s.photon_transport
+    assert s.photon_scattering_tables
     assert s.electron_treatment == 'led'
+    assert s.electron_step_fraction == 0.1
     assert s.write_initial_source == True
+    assert s.union_grid
+    assert s.event_xs_batch_size == 64
+    assert s.hash_grid_points_per_bin == 4
+    assert s.shared_cross_sections
+    assert s.numa_first_touch
+    assert s.huge_pages
+    assert s.cross_sections_cache == 'xs_cache'
+    assert s.census_times == [1e-6, 1e-3]
+    assert s.compact_bank
+    assert s.compact_micro_xs
+    assert s.xs_cdf
+    assert s.condense_relaxation
+    assert s.pipelined_bank
+    assert s.precompute_neighbors
+    assert s.profile
+    assert s.profile_domains
+    assert s.lattice_dda
+    assert s.tally_reduce_interval == 5
+    assert s.tally_rank_files
+    assert s.tally_stream == {'path': '/dev/shm/tallies.bin', 'tallies': [1, 3]}
+    assert s.io_stripe_size == 1048576
+    assert s.async_statepoint
+    assert s.auto_tune
+    assert s.source_compression == 4
+    assert s.source_precision == 'single'
+    assert s.partition_source_files
+    assert s.mmap_source_files
+    assert s.mpi_progress_thread
+    assert s.weight_window_mesh_crossings
+    assert len(s.weight_window_generators) == 1
+    wwg = s.weight_window_generators[0]
+    assert wwg.mesh.id == mesh.id
+    assert list(wwg.energy_bounds) == [0.0, 1.0, 20.0e6]
+    assert wwg.particle_type == 'neutron'
+    assert wwg.update_interval == 2
+    assert wwg.ratio == 4.0
+    assert wwg.method == 'magic'
+    assert s.secondary_bank_capacity == 500
+    assert s.event_secondary_queue
+    assert s.event_schedule == 'ordered'
+    assert s.event_min_queue_size == 256
+    assert s.event_refill_threshold == 0.5
+    assert s.event_sort_threshold == 1000
+    assert s.history_schedule == 'work_stealing'
+    assert s.work_chunk_size == 100
+    assert s.track_writer_thread
+    assert s.track_fraction == 0.25
+    assert s.track_region == ((-1.0, -2.0, -3.0), (1.0, 2.0, 3.0))
+    assert s.track_compression == 4
+    assert s.track_precision == 'single'
+    assert s.track_delta_positions
+    assert s.wielandt_shift == 0.1
+    assert s.ifp_n_generation == 5
     assert len(s.volume_calculations) == 1
     vol = s.volume_calculations[0]
     assert vol.domain_type == 'cell'
@@ -121,3 +251,4 @@ def test_export_to_xml(run_in_tmpdir):
     assert vol.samples == 1000
     assert vol.lower_left == (-10., -10., -10.)
     assert vol.upper_right == (10., 10., 10.)
+    assert vol.estimator == 'ray'
@@ -346,6 +346,28 @@ def test_point():
     assert d.xyz == pytest.approx(p)
 
 
+def test_mesh_spatial():
+    mesh = openmc.RegularMesh()
+    mesh.lower_left = (-1., -1., -1.)
+    mesh.upper_right = (1., 1., 1.)
+    mesh.dimension = (2, 1, 1)
+    energy = [openmc.stats.Discrete([1.0e6], [1.0]),
+              openmc.stats.Discrete([2.0e6], [1.0])]
+    d = openmc.stats.MeshSpatial(mesh, [1.0, 3.0], energy)
+
+    elem = d.to_xml_element()
+    assert elem.tag == 'space'
+    assert elem.attrib['type'] == 'mesh'
+    assert elem.attrib['mesh_id'] == str(mesh.id)
+    assert len(elem.findall('energy')) == 2
+
+    d = openmc.stats.Spatial.from_xml_element(elem, {mesh.id: mesh})
+    assert isinstance(d, openmc.stats.MeshSpatial)
+    assert d.mesh is mesh
+    assert d.strengths == pytest.approx([1.0, 3.0])
+    assert len(d.energy) == 2
+
+
 def test_normal():
     mean = 10.0
     std_dev = 2.0
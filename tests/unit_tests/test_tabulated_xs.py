@@ -0,0 +1,38 @@
+import openmc
+import pytest
+
+from tests.unit_tests import tally_results
+
+
+@pytest.fixture
+def model(fuel_sphere_model):
+    # Track-length tallies bypass the tables, so score with collisions. The
+    # nuclide scores rely on microscopic cross sections.
+    fuel, water = fuel_sphere_model.materials
+    tally = openmc.Tally()
+    tally.filters = [openmc.MaterialFilter([fuel, water])]
+    tally.nuclides = ['U235', 'U238', 'H1', 'total']
+    tally.scores = ['total', 'absorption', 'fission']
+    tally.estimator = 'collision'
+    fuel_sphere_model.tallies.append(tally)
+    return fuel_sphere_model
+
+
+def run(model, run_model, tabulate_xs):
+    for mat in model.materials:
+        mat.tabulate_xs = tabulate_xs
+    sp_path = run_model(model)
+    with openmc.StatePoint(sp_path) as sp:
+        keff = sp.keff
+    return (keff,) + tally_results(sp_path, model.tallies[0].id)
+
+
+def test_tabulated_xs(model, run_model, run_in_tmpdir):
+    # Both runs sample the same histories up to roundoff in the summation of
+    # cross sections, so their results must agree within statistics
+    keff, mean, std_dev = run(model, run_model, False)
+    keff_tab, mean_tab, std_dev_tab = run(model, run_model, True)
+
+    assert abs(keff.n - keff_tab.n) <= 3*(keff.s**2 + keff_tab.s**2)**0.5
+    tolerance = 3*(std_dev**2 + std_dev_tab**2)**0.5
+    assert (abs(mean - mean_tab) <= tolerance).all()
@@ -19,6 +19,8 @@ def test_xml_roundtrip(run_in_tmpdir):
     )
     tally.triggers = [openmc.Trigger('rel_err', 0.025)]
     tally.triggers[0].scores = ['total', 'fission']
+    tally.thread_buffers = True
+    tally.sparse_results = True
     tallies = openmc.Tallies([tally])
 
     # Roundtrip through XML and make sure we get what we started with
@@ -39,3 +41,5 @@ def test_xml_roundtrip(run_in_tmpdir):
     assert new_tally.triggers[0].trigger_type == tally.triggers[0].trigger_type
     assert new_tally.triggers[0].threshold == tally.triggers[0].threshold
     assert new_tally.triggers[0].scores == tally.triggers[0].scores
+    assert new_tally.thread_buffers
+    assert new_tally.sparse_results
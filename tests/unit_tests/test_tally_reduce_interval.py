@@ -0,0 +1,51 @@
+import openmc
+import openmc.lib
+import pytest
+
+from tests import cdtemp
+from tests.unit_tests import tally_results
+
+
+@pytest.fixture
+def model(fuel_sphere_model):
+    # Flux and fission rates in a few energy groups
+    tally = openmc.Tally()
+    tally.filters = [openmc.EnergyFilter([0.0, 1.0e3, 1.0e5, 20.0e6])]
+    tally.scores = ['flux', 'fission']
+    fuel_sphere_model.tallies.append(tally)
+    return fuel_sphere_model
+
+
+def test_reduce_interval(model, run_model, run_in_tmpdir):
+    # Results reduced every few batches must agree with reducing every batch
+    tally_id = model.tallies[0].id
+    model.settings.tally_reduce_interval = 1
+    mean, std_dev = tally_results(run_model(model), tally_id)
+    model.settings.tally_reduce_interval = 3
+    mean_3, std_dev_3 = tally_results(run_model(model), tally_id)
+
+    assert (std_dev_3 > 0.0).all()
+    tolerance = 3*(std_dev**2 + std_dev_3**2)**0.5
+    assert (abs(mean - mean_3) <= tolerance).all()
+
+
+def test_results_current_between_batches(model, mpi_intracomm):
+    # Results may be read after any batch run through the C API, so they are
+    # accumulated in every batch regardless of the interval
+    model.settings.tally_reduce_interval = 3
+    tally_id = model.tallies[0].id
+    with cdtemp():
+        model.export_to_xml()
+        openmc.lib.init(intracomm=mpi_intracomm)
+        try:
+            openmc.lib.simulation_init()
+            tally = openmc.lib.tallies[tally_id]
+            for i in range(model.settings.batches):
+                openmc.lib.next_batch()
+                n_active = max(i + 1 - model.settings.inactive, 0)
+                assert tally.num_realizations == n_active
+                if n_active > 0 and openmc.lib.master():
+                    assert tally.mean.sum() > 0.0
+            openmc.lib.simulation_finalize()
+        finally:
+            openmc.lib.finalize()
@@ -0,0 +1,50 @@
+import openmc
+import openmc.lib
+import pytest
+
+from tests import cdtemp
+
+
+@pytest.fixture(scope='module')
+def slab_model():
+    """Universe of slabs along x, enough of them that its cells are searched
+    with a bounding volume hierarchy, closed by half-space cells at both ends
+    whose bounding boxes are unbounded on one side"""
+    openmc.reset_auto_ids()
+    model = openmc.Model()
+    mat = openmc.Material()
+    mat.add_nuclide('H1', 1.0)
+    mat.set_density('g/cm3', 1.0)
+    model.materials.append(mat)
+
+    planes = [openmc.XPlane(float(x)) for x in range(11)]
+    cells = [openmc.Cell(fill=mat, region=-planes[0])]
+    for left, right in zip(planes[:-1], planes[1:]):
+        cells.append(openmc.Cell(fill=mat, region=+left & -right))
+    cells.append(openmc.Cell(fill=mat, region=+planes[-1]))
+    model.geometry = openmc.Geometry(cells)
+
+    model.settings.batches = 10
+    model.settings.particles = 100
+    model.settings.run_mode = 'fixed source'
+
+    with cdtemp():
+        model.export_to_xml()
+        openmc.lib.init()
+        yield cells
+        openmc.lib.finalize()
+
+
+def test_half_space_cells(slab_model):
+    cells = slab_model
+    assert openmc.lib.find_cell((-0.5, 0., 0.))[0].id == cells[0].id
+    assert openmc.lib.find_cell((-1.0e6, 3., -2.))[0].id == cells[0].id
+    assert openmc.lib.find_cell((10.5, 0., 0.))[0].id == cells[-1].id
+    assert openmc.lib.find_cell((1.0e6, -4., 7.))[0].id == cells[-1].id
+
+
+@pytest.mark.parametrize('i', range(10))
+def test_slab_cells(slab_model, i):
+    cells = slab_model
+    r = (i + 0.5, 1.0e3, -1.0e3)
+    assert openmc.lib.find_cell(r)[0].id == cells[i + 1].id
@@ -0,0 +1,79 @@
+"""Compare reaction rates collapsed from cross sections stored in single
+precision against a double-precision evaluation of the same library data."""
+
+import numpy as np
+import openmc
+import openmc.data
+import openmc.lib
+import pytest
+
+from tests import cdtemp
+
+pytestmark = pytest.mark.skipif(
+    not openmc.lib._xs_single_precision(),
+    reason="Single-precision cross sections are not enabled.")
+
+NUCLIDES = ['U235', 'H1', 'O16']
+MTS = [2, 18, 102]
+
+# Energy group boundaries in [eV] spanning thermal, resonance, and fast ranges
+ENERGY = [1.0e-5, 0.625, 10.0, 1.0e3, 1.0e5, 20.0e6]
+
+# Rounding a value to single precision changes it by at most 2**-24 (about
+# 6e-8) relative. Each group rate averages many rounded values, so a relative
+# tolerance of 1e-5 leaves ample margin while catching lost precision.
+RTOL = 1.0e-5
+
+
+@pytest.fixture(scope='module')
+def lib_init():
+    # Small dedicated model that loads the nuclides to compare
+    model = openmc.Model()
+    mat = openmc.Material()
+    for name in NUCLIDES:
+        mat.add_nuclide(name, 1.0)
+    mat.set_density('g/cm3', 1.0)
+    sph = openmc.Sphere(r=10.0, boundary_type='vacuum')
+    model.geometry = openmc.Geometry([openmc.Cell(fill=mat, region=-sph)])
+    model.settings.particles = 100
+    model.settings.batches = 1
+
+    with cdtemp():
+        model.export_to_xml()
+        openmc.lib.init()
+        yield
+        openmc.lib.finalize()
+
+
+def double_precision_rates(xs):
+    """Average cross section in each group from linear-linear integration of
+    the pointwise data in double precision"""
+    rates = []
+    for E_low, E_high in zip(ENERGY[:-1], ENERGY[1:]):
+        inside = (xs.x > E_low) & (xs.x < E_high)
+        E = np.concatenate(([E_low], xs.x[inside], [E_high]))
+        y = np.interp(E, xs.x, xs.y, left=0.0, right=0.0)
+        rates.append(np.trapz(y, E) / (E_high - E_low))
+    return np.array(rates)
+
+
+@pytest.mark.parametrize('nuclide', NUCLIDES)
+def test_collapse_rate(lib_init, nuclide):
+    library = openmc.data.DataLibrary.from_xml()
+    path = library.get_by_material(nuclide)['path']
+    data = openmc.data.IncidentNeutron.from_hdf5(path)
+    nuc = openmc.lib.nuclides[nuclide]
+
+    for MT in MTS:
+        if MT not in data.reactions:
+            continue
+        expected = double_precision_rates(data[MT].xs['294K'])
+
+        # Flux of one in a single group gives the group's average cross section
+        rates = []
+        for g in range(len(ENERGY) - 1):
+            flux = np.zeros(len(ENERGY) - 1)
+            flux[g] = 1.0
+            rates.append(nuc.collapse_rate(MT, 294.0, ENERGY, flux))
+
+        assert rates == pytest.approx(expected, rel=RTOL)